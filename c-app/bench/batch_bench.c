@@ -0,0 +1,206 @@
+// 여러 KV 경로 조회 벤치마크
+// 기동 시 KV 문서 N개를 읽는 상황을 가정하여 세 가지 방식의 소요 시간과 요청 수를 비교합니다.
+//   serial: vault_get_secret을 경로마다 순서대로 호출 (왕복 N번)
+//   batch:  vault_get_secrets, 동시 요청 수(max_in_flight)별
+//   warm:   batch 직후 같은 경로를 다시 조회 (경로 캐시에서 반환, 요청 0)
+//
+// 사용법: ./batch-bench [-n paths] [-l latency_us] [-c max_in_flight,...]
+#define _POSIX_C_SOURCE 200809L
+#include "../src/vault_client.h"
+#include "mock_vault.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+
+#define MAX_LIMITS 8
+
+typedef struct {
+    int paths;
+    int latency_us;
+    int limits[MAX_LIMITS];
+    int limit_len;
+} batch_options_t;
+
+typedef struct {
+    char name[32];
+    double elapsed_ms;
+    long requests;
+    long connections;
+    int failed;
+    int cached;
+} batch_result_t;
+
+static void mock_config(app_config_t *config, int port) {
+    memset(config, 0, sizeof(*config));
+    snprintf(config->vault_url, sizeof(config->vault_url), "http://127.0.0.1:%d", port);
+    snprintf(config->entity, sizeof(config->entity), "batch-bench");
+    snprintf(config->token_type, sizeof(config->token_type), "service");
+    config->secret_kv.refresh_interval = DEFAULT_KV_REFRESH_INTERVAL;
+    config->http_timeout = 10;
+    config->max_response_size = DEFAULT_MAX_RESPONSE_SIZE;
+    config->max_in_flight = DEFAULT_MAX_IN_FLIGHT;
+    config->schedule.renew_window_min = DEFAULT_RENEW_WINDOW_MIN;
+    config->schedule.renew_window_max = DEFAULT_RENEW_WINDOW_MAX;
+    config->schedule.refresh_jitter = DEFAULT_REFRESH_JITTER;
+    strncpy(config->trace.format, DEFAULT_TRACE_FORMAT, sizeof(config->trace.format) - 1);
+}
+
+// 측정 1회: 새 대역 서버와 클라이언트 (연결/캐시가 비어 있는 기동 직후 상태)
+// limit: 0이면 serial, 그 외 batch (warm이면 batch를 한 번 실행한 뒤 두 번째 호출을 측정)
+static int run_case(const batch_options_t *opt, char **paths, int limit, int warm, batch_result_t *result) {
+    mock_vault_options_t server_options;
+    mock_vault_default_options(&server_options);
+    server_options.latency_us = opt->latency_us;
+    mock_vault_t *server = mock_vault_start(&server_options);
+    if (!server) return -1;
+
+    app_config_t config;
+    mock_config(&config, mock_vault_port(server));
+    if (limit > 0) config.max_in_flight = limit;
+
+    vault_transport_t transport;
+    vault_client_t client;
+    vault_transport_init(&transport);
+    vault_client_init(&client, &config);
+    vault_client_set_transport(&client, &transport);
+    if (vault_login(&client, "role", "secret") != 0) {
+        vault_client_cleanup(&client);
+        vault_client_thread_cleanup();
+        vault_transport_destroy(&transport);
+        mock_vault_stop(server);
+        return -1;
+    }
+
+    vault_secret_result_t *results = calloc((size_t)opt->paths, sizeof(vault_secret_result_t));
+    if (!results) return -1;
+    if (warm) {
+        vault_get_secrets(&client, (const char *const *)paths, (size_t)opt->paths, results);
+        for (int i = 0; i < opt->paths; i++) vault_cleanup_secret(results[i].data);
+    }
+
+    mock_vault_stats_t before, after;
+    mock_vault_get_stats(server, &before);
+    uint64_t start = vault_metrics_now_ns();
+
+    result->failed = 0;
+    result->cached = 0;
+    if (limit == 0) {
+        for (int i = 0; i < opt->paths; i++) {
+            json_object *data = NULL;
+            if (vault_get_secret(&client, paths[i], &data) != 0) result->failed++;
+            vault_cleanup_secret(data);
+        }
+    } else {
+        result->failed = vault_get_secrets(&client, (const char *const *)paths, (size_t)opt->paths, results);
+        for (int i = 0; i < opt->paths; i++) {
+            result->cached += results[i].cached;
+            vault_cleanup_secret(results[i].data);
+        }
+    }
+
+    result->elapsed_ms = (double)(vault_metrics_now_ns() - start) / 1e6;
+    mock_vault_get_stats(server, &after);
+    result->requests = after.requests - before.requests;
+    result->connections = after.connections - before.connections;
+
+    free(results);
+    vault_client_cleanup(&client);
+    vault_client_thread_cleanup();
+    vault_transport_destroy(&transport);
+    mock_vault_stop(server);
+    return 0;
+}
+
+static int parse_limits(const char *arg, batch_options_t *opt) {
+    char buffer[128];
+    snprintf(buffer, sizeof(buffer), "%s", arg);
+    opt->limit_len = 0;
+    for (char *tok = strtok(buffer, ","); tok && opt->limit_len < MAX_LIMITS; tok = strtok(NULL, ",")) {
+        int n = atoi(tok);
+        if (n <= 0) return -1;
+        opt->limits[opt->limit_len++] = n;
+    }
+    return opt->limit_len > 0 ? 0 : -1;
+}
+
+int main(int argc, char *argv[]) {
+    batch_options_t opt = {200, 2000, {1, 4, 16, 64}, 4};
+    int c;
+    while ((c = getopt(argc, argv, "n:l:c:")) != -1) {
+        switch (c) {
+            case 'n': opt.paths = atoi(optarg); break;
+            case 'l': opt.latency_us = atoi(optarg); break;
+            case 'c':
+                if (parse_limits(optarg, &opt) != 0) {
+                    fprintf(stderr, "Invalid max_in_flight list: %s\n", optarg);
+                    return 1;
+                }
+                break;
+            default:
+                fprintf(stderr, "Usage: %s [-n paths] [-l latency_us] [-c max_in_flight,...]\n", argv[0]);
+                return 1;
+        }
+    }
+    if (opt.paths <= 0 || opt.latency_us < 0) {
+        fprintf(stderr, "Invalid options\n");
+        return 1;
+    }
+
+    char **paths = calloc((size_t)opt.paths, sizeof(char *));
+    if (!paths) return 1;
+    for (int i = 0; i < opt.paths; i++) {
+        paths[i] = malloc(64);
+        if (!paths[i]) return 1;
+        snprintf(paths[i], 64, "batch-bench-kv/data/service/key-%d", i);
+    }
+
+    curl_global_init(CURL_GLOBAL_DEFAULT);
+
+    // 클라이언트 로그 출력은 결과 집계에 방해되므로 실행 중에는 버림
+    fflush(stdout);
+    int saved_stdout = dup(STDOUT_FILENO);
+    int devnull = open("/dev/null", O_WRONLY);
+
+    batch_result_t results[MAX_LIMITS + 2];
+    int result_count = 0;
+    for (int i = -1; i <= opt.limit_len; i++) {
+        int limit = i < 0 ? 0 : i < opt.limit_len ? opt.limits[i] : opt.limits[opt.limit_len - 1];
+        int warm = i == opt.limit_len;
+        batch_result_t *r = &results[result_count++];
+        if (limit == 0) {
+            snprintf(r->name, sizeof(r->name), "serial");
+        } else {
+            snprintf(r->name, sizeof(r->name), "%s (in_flight=%d)", warm ? "warm" : "batch", limit);
+        }
+        fprintf(stderr, "Running %s...\n", r->name);
+        dup2(devnull, STDOUT_FILENO);
+        int rc = run_case(&opt, paths, limit, warm, r);
+        fflush(stdout);
+        dup2(saved_stdout, STDOUT_FILENO);
+        if (rc != 0) {
+            fprintf(stderr, "Failed to run benchmark\n");
+            return 1;
+        }
+    }
+    close(devnull);
+
+    printf("=== Batch KV Read Benchmark ===\n");
+    printf("paths=%d mock latency=%dus\n\n", opt.paths, opt.latency_us);
+    printf("%-22s %12s %9s %9s %9s %8s %8s\n", "mode", "elapsed(ms)", "speedup", "requests", "conns",
+           "cached", "failed");
+    int failed = 0;
+    for (int i = 0; i < result_count; i++) {
+        batch_result_t *r = &results[i];
+        printf("%-22s %12.1f %8.1fx %9ld %9ld %8d %8d\n", r->name, r->elapsed_ms,
+               r->elapsed_ms > 0 ? results[0].elapsed_ms / r->elapsed_ms : 0, r->requests, r->connections,
+               r->cached, r->failed);
+        failed += r->failed;
+    }
+
+    for (int i = 0; i < opt.paths; i++) free(paths[i]);
+    free(paths);
+    curl_global_cleanup();
+    return failed == 0 ? 0 : 1;
+}
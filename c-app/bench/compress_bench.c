@@ -0,0 +1,191 @@
+// KV 응답 압축 벤치마크
+// payload 크기별로 압축 없음(identity), gzip, zstd 응답을 vault_get_secret으로 반복 조회하여
+// 전송 바이트, 클라이언트 CPU(압축 해제 + 스트리밍 파싱 포함), 서버 압축 CPU, 지연 시간을 비교합니다.
+// loopback에서는 전송 시간이 거의 0이므로, 지정한 대역폭에서 줄어드는 전송 시간과 늘어나는 CPU 시간을 비교해
+// 압축이 이득이 되는 크기(손익 분기)를 표시합니다.
+//   text:   반복 문자열 payload (설정/JSON 문서처럼 압축이 잘 되는 값)
+//   random: 무작위 base64 payload (키/인증서처럼 압축이 잘 안 되는 값)
+//
+// 사용법: ./compress-bench [-B bandwidth_mbps] [-n min_fetches] [-M max_kb]
+#define _POSIX_C_SOURCE 200809L
+#include "../src/vault_client.h"
+#include "mock_vault.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+
+#define FETCH_BYTES (64L * 1024 * 1024)  // 조합마다 대략 이만큼 받을 때까지 반복 (최소 min_fetches번)
+
+static const char *encodings[] = {"identity", "gzip", "zstd"};
+#define ENCODING_COUNT 3
+
+typedef struct {
+    double wire;         // 조회당 응답 본문 전송 바이트
+    double raw;          // 조회당 압축 전 응답 본문 바이트
+    double client_us;    // 조회당 클라이언트 CPU (요청 스레드)
+    double server_us;    // 조회당 서버 압축 CPU
+    double latency_us;   // 조회당 평균 지연 시간 (loopback)
+    int compressed;      // 서버가 실제로 압축해서 보냈는지
+} compress_result_t;
+
+static double thread_cpu_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return (double)ts.tv_sec * 1e6 + (double)ts.tv_nsec / 1e3;
+}
+
+static void make_config(app_config_t *config, int port, const char *accept_encoding) {
+    memset(config, 0, sizeof(*config));
+    snprintf(config->vault_url, sizeof(config->vault_url), "http://127.0.0.1:%d", port);
+    snprintf(config->entity, sizeof(config->entity), "compress-bench");
+    snprintf(config->token_type, sizeof(config->token_type), "service");
+    snprintf(config->accept_encoding, sizeof(config->accept_encoding), "%s", accept_encoding);
+    config->http_timeout = 30;
+    config->max_response_size = DEFAULT_MAX_RESPONSE_SIZE;
+    config->max_in_flight = DEFAULT_MAX_IN_FLIGHT;
+    config->schedule.renew_window_min = DEFAULT_RENEW_WINDOW_MIN;
+    config->schedule.renew_window_max = DEFAULT_RENEW_WINDOW_MAX;
+    config->schedule.refresh_jitter = DEFAULT_REFRESH_JITTER;
+    strncpy(config->trace.format, DEFAULT_TRACE_FORMAT, sizeof(config->trace.format) - 1);
+}
+
+static int run_case(int payload_size, int random, int encoding, int min_fetches, compress_result_t *result) {
+    mock_vault_options_t server_options;
+    mock_vault_default_options(&server_options);
+    server_options.token_ttl = 3600;
+    server_options.payload_size = payload_size;
+    server_options.payload_random = random;
+    server_options.compress_min = 1;  // 허용하면 크기와 관계없이 압축 (손익 분기를 보기 위해)
+    mock_vault_t *server = mock_vault_start(&server_options);
+    if (!server) return -1;
+
+    app_config_t config;
+    make_config(&config, mock_vault_port(server), encoding == 0 ? "" : encodings[encoding]);
+    vault_transport_t transport;
+    vault_client_t client;
+    vault_transport_init(&transport);
+    vault_transport_configure(&transport, &config);
+    vault_client_init(&client, &config);
+    vault_client_set_transport(&client, &transport);
+    int rc = -1;
+    if (vault_login(&client, "role", "secret") != 0) goto out;
+
+    // 연결과 버퍼를 데운 뒤 측정
+    json_object *secret = NULL;
+    if (vault_get_secret(&client, "compress-bench-kv/data/app", &secret) != 0) goto out;
+    json_object *payload = NULL;
+    if (!json_object_object_get_ex(secret, "payload", &payload) ||
+        json_object_get_string_len(payload) != payload_size) {
+        fprintf(stderr, "Unexpected payload (%s, %d bytes)\n", encodings[encoding], payload_size);
+        vault_cleanup_secret(secret);
+        goto out;
+    }
+    vault_cleanup_secret(secret);
+
+    long fetches = FETCH_BYTES / (payload_size + 512);
+    if (fetches < min_fetches) fetches = min_fetches;
+    mock_vault_stats_t before, after;
+    mock_vault_get_stats(server, &before);
+    double cpu_start = thread_cpu_us();
+    uint64_t start = vault_metrics_now_ns();
+    for (long i = 0; i < fetches; i++) {
+        if (vault_get_secret(&client, "compress-bench-kv/data/app", &secret) != 0) goto out;
+        vault_cleanup_secret(secret);
+    }
+    uint64_t elapsed = vault_metrics_now_ns() - start;
+    double cpu = thread_cpu_us() - cpu_start;
+    mock_vault_get_stats(server, &after);
+
+    result->wire = (double)(after.bytes_sent - before.bytes_sent) / fetches;
+    result->raw = (double)(after.bytes_raw - before.bytes_raw) / fetches;
+    result->server_us = (double)(after.compress_us - before.compress_us) / fetches;
+    result->client_us = cpu / fetches;
+    result->latency_us = (double)elapsed / 1e3 / fetches;
+    result->compressed = after.compressed > before.compressed;
+    rc = 0;
+
+out:
+    vault_client_cleanup(&client);
+    vault_client_thread_cleanup();
+    vault_transport_destroy(&transport);
+    mock_vault_stop(server);
+    return rc;
+}
+
+int main(int argc, char *argv[]) {
+    int bandwidth_mbps = 100;
+    int min_fetches = 200;
+    int max_kb = 512;
+    int c;
+    while ((c = getopt(argc, argv, "B:n:M:")) != -1) {
+        switch (c) {
+            case 'B': bandwidth_mbps = atoi(optarg); break;
+            case 'n': min_fetches = atoi(optarg); break;
+            case 'M': max_kb = atoi(optarg); break;
+            default:
+                fprintf(stderr, "Usage: %s [-B bandwidth_mbps] [-n min_fetches] [-M max_kb]\n", argv[0]);
+                return 1;
+        }
+    }
+    if (bandwidth_mbps <= 0 || min_fetches <= 0 || max_kb <= 0) {
+        fprintf(stderr, "Invalid options\n");
+        return 1;
+    }
+
+    curl_global_init(CURL_GLOBAL_DEFAULT);
+    const curl_version_info_data *info = curl_version_info(CURLVERSION_NOW);
+
+    // 클라이언트 로그 출력은 결과 집계에 방해되므로 실행 중에는 버림
+    fflush(stdout);
+    int saved_stdout = dup(STDOUT_FILENO);
+    int devnull = open("/dev/null", O_WRONLY);
+
+    printf("=== KV Response Compression Benchmark ===\n");
+    printf("libcurl %s, break-even at %d Mbps (saved transfer time vs added client + server CPU)\n",
+           info->version, bandwidth_mbps);
+    double bytes_per_us = (double)bandwidth_mbps / 8.0;  // Mbps -> 바이트/us
+
+    for (int random = 0; random <= 1; random++) {
+        printf("\n[%s payload]\n", random ? "random" : "text");
+        printf("%8s %-8s %10s %7s %10s %10s %10s %10s %8s\n", "payload", "encoding", "wire", "ratio",
+               "client", "server", "latency", "transfer", "net");
+        for (int kb = 1; kb <= max_kb; kb *= 4) {
+            int payload_size = kb * 1024;
+            compress_result_t results[ENCODING_COUNT];
+            for (int e = 0; e < ENCODING_COUNT; e++) {
+                memset(&results[e], 0, sizeof(results[e]));
+                fflush(stdout);
+                dup2(devnull, STDOUT_FILENO);
+                int rc = run_case(payload_size, random, e, min_fetches, &results[e]);
+                fflush(stdout);
+                dup2(saved_stdout, STDOUT_FILENO);
+                if (rc != 0) {
+                    fprintf(stderr, "Failed to run %s with %d KB payload\n", encodings[e], kb);
+                    return 1;
+                }
+            }
+            for (int e = 0; e < ENCODING_COUNT; e++) {
+                compress_result_t *r = &results[e];
+                compress_result_t *base = &results[0];
+                // 순이득 = 줄어든 전송 시간 - (클라이언트 CPU 증가 + 서버 압축 CPU)
+                double transfer_us = r->wire / bytes_per_us;
+                double net_us = (base->wire - r->wire) / bytes_per_us - (r->client_us - base->client_us) - r->server_us;
+                char size[16];
+                snprintf(size, sizeof(size), "%dKB", kb);
+                printf("%8s %-8s %9.0fB %6.2fx %8.1fus %8.1fus %8.1fus %8.1fus %+7.0fus%s\n",
+                       e == 0 ? size : "", encodings[e], r->wire, r->wire > 0 ? r->raw / r->wire : 0.0,
+                       r->client_us, r->server_us, r->latency_us, transfer_us, e == 0 ? 0.0 : net_us,
+                       e > 0 && !r->compressed ? " (not compressed)" : "");
+            }
+        }
+    }
+    close(devnull);
+    printf("\nwire: response body bytes per fetch, client: requesting thread CPU per fetch (decompress + parse),\n"
+           "server: mock compression CPU per fetch, transfer: wire bytes at %d Mbps, net: time saved vs identity\n",
+           bandwidth_mbps);
+
+    curl_global_cleanup();
+    return 0;
+}
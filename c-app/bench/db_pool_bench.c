@@ -0,0 +1,307 @@
+// Database Dynamic 자격증명 풀 벤치마크
+// 연결 풀 작업자 W개가 짧은 lease TTL 아래에서 주기적으로 쿼리를 보낸다고 가정하고 두 방식을 비교합니다.
+//   single: 기존 방식. 쿼리마다 vault_get_db_dynamic_secret으로 자격증명을 확인하고, 바뀌면 재연결
+//           (TTL이 10초 이하가 되면 자격증명 하나를 한꺼번에 교체)
+//   pool:   pool_size개 자격증명 풀. 연결할 때 vault_db_checkout으로 빌리고,
+//           쿼리마다 vault_db_is_retired로 교체 여부만 확인 (유지 작업은 별도 스레드)
+// 초당 최대 재연결 수(동시 재연결 폭주)와 자격증명 확인에 걸린 시간(p99/max)을 비교합니다.
+//
+// 사용법: ./dbpool-bench [-w workers] [-n pool_size] [-g drain_grace] [-L lease_ttl] [-d seconds] [-l latency_us]
+#define _POSIX_C_SOURCE 200809L
+#include "../src/vault_client.h"
+#include "mock_vault.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <time.h>
+
+#define QUERY_INTERVAL_MS 100
+#define MAX_SECONDS 600
+
+typedef struct {
+    int workers;
+    int pool_size;
+    int drain_grace;
+    int lease_ttl;
+    int duration;
+    int latency_us;
+} pool_options_t;
+
+typedef struct {
+    vault_client_t *client;
+    int pool;
+    uint64_t *lookup_ns;   // 쿼리마다 자격증명 확인에 걸린 시간
+    size_t lookups;
+    size_t capacity;
+    long errors;
+} pool_worker_t;
+
+typedef struct {
+    const char *name;
+    long reconnects;
+    long peak_reconnects;  // 1초 구간 최대 재연결 수
+    double p99_ms;
+    double max_ms;
+    long creds;            // database/creds 요청
+    long lookups;          // sys/leases/lookup 요청
+    long revocations;
+    long errors;
+} pool_result_t;
+
+static int stop_flag = 0;
+static time_t bench_start;
+static long reconnects_per_second[MAX_SECONDS];
+
+static void count_reconnect(void) {
+    long slot = (long)(time(NULL) - bench_start);
+    if (slot >= 0 && slot < MAX_SECONDS) __atomic_add_fetch(&reconnects_per_second[slot], 1, __ATOMIC_RELAXED);
+}
+
+static const char *username_of(json_object *secret) {
+    json_object *data, *username;
+    if (secret && json_object_object_get_ex(secret, "data", &data) &&
+        json_object_object_get_ex(data, "username", &username)) {
+        return json_object_get_string(username);
+    }
+    return NULL;
+}
+
+static void record_lookup(pool_worker_t *worker, uint64_t ns) {
+    if (worker->lookups < worker->capacity) worker->lookup_ns[worker->lookups++] = ns;
+}
+
+static void *worker_thread(void *arg) {
+    pool_worker_t *worker = (pool_worker_t *)arg;
+    struct timespec interval = {0, QUERY_INTERVAL_MS * 1000000L};
+    char connected_as[128] = "";
+    unsigned long id = 0;
+
+    while (!__atomic_load_n(&stop_flag, __ATOMIC_ACQUIRE)) {
+        json_object *secret = NULL;
+        uint64_t start = vault_metrics_now_ns();
+        if (!worker->pool) {
+            // 쿼리마다 현재 자격증명 확인, 바뀌었으면 재연결
+            if (vault_get_db_dynamic_secret(worker->client, &secret) == 0) {
+                record_lookup(worker, vault_metrics_now_ns() - start);
+                const char *username = username_of(secret);
+                if (username && strcmp(username, connected_as) != 0) {
+                    if (connected_as[0]) count_reconnect();
+                    snprintf(connected_as, sizeof(connected_as), "%s", username);
+                }
+            } else {
+                worker->errors++;
+            }
+        } else if (id == 0 || vault_db_is_retired(worker->client, id)) {
+            // 연결이 없거나 자격증명이 교체됨: 새로 빌려 재연결한 뒤 이전 것 반납
+            unsigned long next_id = 0;
+            if (vault_db_checkout(worker->client, &secret, &next_id) == 0) {
+                record_lookup(worker, vault_metrics_now_ns() - start);
+                if (id) {
+                    count_reconnect();
+                    vault_db_checkin(worker->client, id);
+                }
+                id = next_id;
+            } else {
+                worker->errors++;
+            }
+        } else {
+            record_lookup(worker, vault_metrics_now_ns() - start);
+        }
+        vault_cleanup_secret(secret);
+        nanosleep(&interval, NULL);
+    }
+    if (id) vault_db_checkin(worker->client, id);
+    vault_client_thread_cleanup();
+    return NULL;
+}
+
+// 풀 유지 스레드 (vault-app의 Database Dynamic 갱신 스레드처럼 다음 교체/폐기 시각에 맞춰 실행)
+static void *maintain_thread(void *arg) {
+    vault_client_t *client = (vault_client_t *)arg;
+    while (!__atomic_load_n(&stop_flag, __ATOMIC_ACQUIRE)) {
+        time_t next_event = vault_db_pool_next_event(&client->db_pool);
+        if (next_event == 0 || next_event <= time(NULL)) {
+            vault_refresh_db_dynamic_secret(client);
+        }
+        sleep(1);
+    }
+    vault_client_thread_cleanup();
+    return NULL;
+}
+
+static int compare_u64(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+    return x < y ? -1 : x > y;
+}
+
+static void make_config(app_config_t *config, int port, const pool_options_t *opt, int pool) {
+    memset(config, 0, sizeof(*config));
+    snprintf(config->vault_url, sizeof(config->vault_url), "http://127.0.0.1:%d", port);
+    snprintf(config->entity, sizeof(config->entity), "dbpool-bench");
+    snprintf(config->token_type, sizeof(config->token_type), "service");
+    config->secret_kv.refresh_interval = DEFAULT_KV_REFRESH_INTERVAL;
+    config->secret_database_dynamic.enabled = 1;
+    snprintf(config->secret_database_dynamic.role_id, sizeof(config->secret_database_dynamic.role_id), "app");
+    config->secret_database_dynamic.pool_size = pool ? opt->pool_size : 0;
+    config->secret_database_dynamic.pool_drain_grace = opt->drain_grace;
+    config->http_timeout = 10;
+    config->max_response_size = DEFAULT_MAX_RESPONSE_SIZE;
+    config->max_in_flight = DEFAULT_MAX_IN_FLIGHT;
+    config->schedule.renew_window_min = DEFAULT_RENEW_WINDOW_MIN;
+    config->schedule.renew_window_max = DEFAULT_RENEW_WINDOW_MAX;
+    config->schedule.refresh_jitter = DEFAULT_REFRESH_JITTER;
+    strncpy(config->trace.format, DEFAULT_TRACE_FORMAT, sizeof(config->trace.format) - 1);
+}
+
+static int run_mode(const pool_options_t *opt, int pool, pool_result_t *result) {
+    mock_vault_options_t server_options;
+    mock_vault_default_options(&server_options);
+    server_options.latency_us = opt->latency_us;
+    server_options.lease_ttl = opt->lease_ttl;
+    server_options.token_ttl = opt->duration * 10;
+    mock_vault_t *server = mock_vault_start(&server_options);
+    if (!server) return -1;
+
+    app_config_t config;
+    make_config(&config, mock_vault_port(server), opt, pool);
+    vault_transport_t transport;
+    vault_client_t client;
+    vault_transport_init(&transport);
+    vault_client_init(&client, &config);
+    vault_client_set_transport(&client, &transport);
+    if (vault_login(&client, "role", "secret") != 0) {
+        vault_client_cleanup(&client);
+        vault_transport_destroy(&transport);
+        mock_vault_stop(server);
+        return -1;
+    }
+
+    // 기동 시 첫 발급 (풀은 pool_size개를 엇갈린 교체 시각으로 채움)
+    vault_refresh_db_dynamic_secret(&client);
+
+    memset(reconnects_per_second, 0, sizeof(reconnects_per_second));
+    __atomic_store_n(&stop_flag, 0, __ATOMIC_RELEASE);
+    bench_start = time(NULL);
+    mock_vault_stats_t before, after;
+    mock_vault_get_stats(server, &before);
+
+    pool_worker_t *workers = calloc((size_t)opt->workers, sizeof(pool_worker_t));
+    pthread_t *threads = calloc((size_t)opt->workers, sizeof(pthread_t));
+    size_t capacity = (size_t)opt->duration * (1000 / QUERY_INTERVAL_MS) + 16;
+    if (!workers || !threads) return -1;
+    for (int i = 0; i < opt->workers; i++) {
+        workers[i].client = &client;
+        workers[i].pool = pool;
+        workers[i].capacity = capacity;
+        workers[i].lookup_ns = calloc(capacity, sizeof(uint64_t));
+        if (!workers[i].lookup_ns) return -1;
+        pthread_create(&threads[i], NULL, worker_thread, &workers[i]);
+    }
+    pthread_t maintainer;
+    if (pool) pthread_create(&maintainer, NULL, maintain_thread, &client);
+
+    sleep((unsigned)opt->duration);
+    __atomic_store_n(&stop_flag, 1, __ATOMIC_RELEASE);
+    for (int i = 0; i < opt->workers; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    if (pool) pthread_join(maintainer, NULL);
+    mock_vault_get_stats(server, &after);
+
+    size_t total = 0;
+    for (int i = 0; i < opt->workers; i++) total += workers[i].lookups;
+    uint64_t *all = calloc(total ? total : 1, sizeof(uint64_t));
+    if (!all) return -1;
+    size_t n = 0;
+    memset(result, 0, sizeof(*result));
+    result->name = pool ? "pool" : "single";
+    for (int i = 0; i < opt->workers; i++) {
+        memcpy(all + n, workers[i].lookup_ns, workers[i].lookups * sizeof(uint64_t));
+        n += workers[i].lookups;
+        result->errors += workers[i].errors;
+        free(workers[i].lookup_ns);
+    }
+    qsort(all, n, sizeof(uint64_t), compare_u64);
+    result->p99_ms = n ? (double)all[(n * 99) / 100] / 1e6 : 0;
+    result->max_ms = n ? (double)all[n - 1] / 1e6 : 0;
+    for (int s = 0; s < MAX_SECONDS; s++) {
+        result->reconnects += reconnects_per_second[s];
+        if (reconnects_per_second[s] > result->peak_reconnects) result->peak_reconnects = reconnects_per_second[s];
+    }
+    result->creds = after.db_creds - before.db_creds;
+    result->lookups = after.lease_lookups - before.lease_lookups;
+    result->revocations = after.lease_revocations - before.lease_revocations;
+
+    free(all);
+    free(workers);
+    free(threads);
+    vault_client_cleanup(&client);
+    vault_client_thread_cleanup();
+    vault_transport_destroy(&transport);
+    mock_vault_stop(server);
+    return 0;
+}
+
+int main(int argc, char *argv[]) {
+    pool_options_t opt = {32, 4, 3, 20, 24, 2000};
+    int c;
+    while ((c = getopt(argc, argv, "w:n:g:L:d:l:")) != -1) {
+        switch (c) {
+            case 'w': opt.workers = atoi(optarg); break;
+            case 'n': opt.pool_size = atoi(optarg); break;
+            case 'g': opt.drain_grace = atoi(optarg); break;
+            case 'L': opt.lease_ttl = atoi(optarg); break;
+            case 'd': opt.duration = atoi(optarg); break;
+            case 'l': opt.latency_us = atoi(optarg); break;
+            default:
+                fprintf(stderr, "Usage: %s [-w workers] [-n pool_size] [-g drain_grace] [-L lease_ttl] "
+                                "[-d seconds] [-l latency_us]\n", argv[0]);
+                return 1;
+        }
+    }
+    if (opt.workers <= 0 || opt.pool_size <= 0 || opt.pool_size > VAULT_DB_POOL_MAX_SIZE || opt.drain_grace < 0 ||
+        opt.lease_ttl <= 10 || opt.duration <= 0 || opt.duration > MAX_SECONDS) {
+        fprintf(stderr, "Invalid options (lease_ttl > 10, pool_size 1..%d)\n", VAULT_DB_POOL_MAX_SIZE);
+        return 1;
+    }
+
+    curl_global_init(CURL_GLOBAL_DEFAULT);
+
+    // 클라이언트 로그 출력은 결과 집계에 방해되므로 실행 중에는 버림
+    fflush(stdout);
+    int saved_stdout = dup(STDOUT_FILENO);
+    int devnull = open("/dev/null", O_WRONLY);
+
+    pool_result_t results[2];
+    for (int pool = 0; pool <= 1; pool++) {
+        fprintf(stderr, "Running %s mode (%d workers, %ds)...\n", pool ? "pool" : "single", opt.workers, opt.duration);
+        dup2(devnull, STDOUT_FILENO);
+        int rc = run_mode(&opt, pool, &results[pool]);
+        fflush(stdout);
+        dup2(saved_stdout, STDOUT_FILENO);
+        if (rc != 0) {
+            fprintf(stderr, "Failed to run benchmark\n");
+            return 1;
+        }
+    }
+    close(devnull);
+
+    printf("=== Database Dynamic Credential Pool Benchmark ===\n");
+    printf("workers=%d lease_ttl=%ds pool_size=%d drain_grace=%ds duration=%ds mock latency=%dus\n\n",
+           opt.workers, opt.lease_ttl, opt.pool_size, opt.drain_grace, opt.duration, opt.latency_us);
+    printf("%-8s %11s %14s %12s %12s %7s %9s %8s %7s\n", "mode", "reconnects", "peak(per sec)", "lookup p99",
+           "lookup max", "creds", "lookups", "revoked", "errors");
+    long errors = 0;
+    for (int i = 0; i < 2; i++) {
+        pool_result_t *r = &results[i];
+        printf("%-8s %11ld %14ld %10.2fms %10.2fms %7ld %9ld %8ld %7ld\n", r->name, r->reconnects,
+               r->peak_reconnects, r->p99_ms, r->max_ms, r->creds, r->lookups, r->revocations, r->errors);
+        errors += r->errors;
+    }
+    printf("\nlookup: time a worker spent getting/validating its credential before a query\n");
+
+    curl_global_cleanup();
+    return errors == 0 ? 0 : 1;
+}
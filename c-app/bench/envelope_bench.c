@@ -0,0 +1,353 @@
+// envelope 암호화 벤치마크
+// 같은 크기의 레코드를 Transit batch 암호화와 로컬 envelope 암호화(AES-256-GCM)로 처리하여
+// 처리량과 레코드당 Vault 요청 수를 비교합니다.
+//   transit:   작업자 W개가 vault_transit_encrypt_batch를 레코드 하나씩 호출 (batch_size 64, pipeline 4)
+//   encrypt:   스레드 T개가 vault_envelope_encrypt 호출 (데이터 키를 max_uses 레코드마다 새로 받음)
+//   decrypt:   새 envelope(빈 캐시)로 encrypt 단계의 레코드를 복호화 (감싼 데이터 키를 한 번 풀고 캐시)
+// 대역 서버는 요청마다 latency_us, Transit 항목마다 item_us를 더해 응답합니다.
+// 복호화 결과는 원래 평문과 비교하며, 다르면 failed로 집계합니다.
+//
+// 사용법: ./envelope-bench [-t threads] [-w transit_workers] [-d seconds] [-l latency_us] [-T item_us] [-u max_uses]
+#define _POSIX_C_SOURCE 200809L
+#include "../src/vault_transit.h"
+#include "../src/vault_envelope.h"
+#include "mock_vault.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+
+#define BENCH_KEY "pii"
+
+typedef struct {
+    int threads;
+    int transit_workers;
+    int duration;
+    int latency_us;
+    int item_us;
+    long max_uses;
+} envelope_options_t;
+
+typedef struct {
+    vault_transit_t *transit;
+    vault_envelope_t *envelope;
+    const unsigned char *plaintext;
+    size_t size;
+    unsigned char *record;       // encrypt 단계의 마지막 레코드 (decrypt 단계 입력)
+    size_t record_len;
+    long records;
+    long failed;
+} envelope_worker_t;
+
+typedef struct {
+    char name[16];
+    size_t size;
+    int threads;
+    double records_per_sec;
+    double mb_per_sec;
+    long requests;               // 대역 서버가 받은 Transit 요청 (encrypt/decrypt/datakey)
+    double requests_per_record;
+    long failed;
+} envelope_result_t;
+
+static int stop_flag = 0;
+
+static void *transit_worker(void *arg) {
+    envelope_worker_t *worker = (envelope_worker_t *)arg;
+    const char *inputs[1] = { (const char *)worker->plaintext };
+    while (!__atomic_load_n(&stop_flag, __ATOMIC_ACQUIRE)) {
+        char *outputs[1] = { NULL };
+        if (vault_transit_encrypt_batch(worker->transit, BENCH_KEY, inputs, 1, outputs) != 0) worker->failed++;
+        vault_transit_free(outputs[0]);
+        worker->records++;
+    }
+    vault_client_thread_cleanup();
+    return NULL;
+}
+
+static void *encrypt_worker(void *arg) {
+    envelope_worker_t *worker = (envelope_worker_t *)arg;
+    while (!__atomic_load_n(&stop_flag, __ATOMIC_ACQUIRE)) {
+        unsigned char *record = NULL;
+        size_t record_len = 0;
+        if (vault_envelope_encrypt(worker->envelope, BENCH_KEY, worker->plaintext, worker->size, &record,
+                                   &record_len) != 0) {
+            worker->failed++;
+            continue;
+        }
+        free(worker->record);
+        worker->record = record;
+        worker->record_len = record_len;
+        worker->records++;
+    }
+    vault_client_thread_cleanup();
+    return NULL;
+}
+
+static void *decrypt_worker(void *arg) {
+    envelope_worker_t *worker = (envelope_worker_t *)arg;
+    while (!__atomic_load_n(&stop_flag, __ATOMIC_ACQUIRE)) {
+        unsigned char *plaintext = NULL;
+        size_t len = 0;
+        if (!worker->record ||
+            vault_envelope_decrypt(worker->envelope, BENCH_KEY, worker->record, worker->record_len, &plaintext,
+                                   &len) != 0 ||
+            len != worker->size || memcmp(plaintext, worker->plaintext, len) != 0) {
+            worker->failed++;
+        }
+        vault_envelope_free(plaintext, len + 1);
+        worker->records++;
+    }
+    vault_client_thread_cleanup();
+    return NULL;
+}
+
+static void make_config(app_config_t *config, int port, const envelope_options_t *opt) {
+    memset(config, 0, sizeof(*config));
+    snprintf(config->vault_url, sizeof(config->vault_url), "http://127.0.0.1:%d", port);
+    snprintf(config->entity, sizeof(config->entity), "envelope-bench");
+    snprintf(config->token_type, sizeof(config->token_type), "service");
+    config->secret_kv.refresh_interval = DEFAULT_KV_REFRESH_INTERVAL;
+    config->http_timeout = 10;
+    config->max_response_size = DEFAULT_MAX_RESPONSE_SIZE;
+    config->max_in_flight = DEFAULT_MAX_IN_FLIGHT;
+    config->schedule.renew_window_min = DEFAULT_RENEW_WINDOW_MIN;
+    config->schedule.renew_window_max = DEFAULT_RENEW_WINDOW_MAX;
+    config->schedule.refresh_jitter = DEFAULT_REFRESH_JITTER;
+    strncpy(config->trace.format, DEFAULT_TRACE_FORMAT, sizeof(config->trace.format) - 1);
+    config->transit.enabled = 1;
+    config->transit.batch_size = DEFAULT_TRANSIT_BATCH_SIZE;
+    config->transit.batch_window_ms = DEFAULT_TRANSIT_BATCH_WINDOW_MS;
+    config->transit.pipeline = DEFAULT_TRANSIT_PIPELINE;
+    config->transit.envelope_max_uses = opt->max_uses;
+    config->transit.envelope_max_age = DEFAULT_TRANSIT_ENVELOPE_MAX_AGE;
+    config->transit.envelope_cache = DEFAULT_TRANSIT_ENVELOPE_CACHE;
+}
+
+static long transit_requests(mock_vault_t *server) {
+    mock_vault_stats_t stats;
+    mock_vault_get_stats(server, &stats);
+    return stats.transit_requests + stats.transit_datakeys;
+}
+
+// 작업자 count개를 duration초 동안 실행하고 결과 집계
+static void run_workers(const envelope_options_t *opt, mock_vault_t *server, void *(*fn)(void *),
+                        envelope_worker_t *workers, int count, envelope_result_t *result) {
+    pthread_t *threads = calloc((size_t)count, sizeof(pthread_t));
+    if (!threads) return;
+    __atomic_store_n(&stop_flag, 0, __ATOMIC_RELEASE);
+    long before = transit_requests(server);
+    uint64_t start = vault_metrics_now_ns();
+    for (int i = 0; i < count; i++) {
+        workers[i].records = 0;
+        workers[i].failed = 0;
+        pthread_create(&threads[i], NULL, fn, &workers[i]);
+    }
+    sleep((unsigned)opt->duration);
+    __atomic_store_n(&stop_flag, 1, __ATOMIC_RELEASE);
+    for (int i = 0; i < count; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    double elapsed = (double)(vault_metrics_now_ns() - start) / 1e9;
+
+    long records = 0;
+    for (int i = 0; i < count; i++) {
+        records += workers[i].records;
+        result->failed += workers[i].failed;
+    }
+    result->threads = count;
+    result->records_per_sec = (double)records / elapsed;
+    result->mb_per_sec = result->records_per_sec * (double)result->size / (1024.0 * 1024.0);
+    result->requests = transit_requests(server) - before;
+    result->requests_per_record = records ? (double)result->requests / (double)records : 0;
+    free(threads);
+}
+
+typedef struct {
+    mock_vault_t *server;
+    app_config_t config;
+    vault_transport_t transport;
+    vault_client_t client;
+} bench_env_t;
+
+static int bench_env_start(bench_env_t *env, const envelope_options_t *opt) {
+    mock_vault_options_t server_options;
+    mock_vault_default_options(&server_options);
+    server_options.latency_us = opt->latency_us;
+    server_options.transit_item_us = opt->item_us;
+    env->server = mock_vault_start(&server_options);
+    if (!env->server) return -1;
+    make_config(&env->config, mock_vault_port(env->server), opt);
+    vault_transport_init(&env->transport);
+    vault_client_init(&env->client, &env->config);
+    vault_client_set_transport(&env->client, &env->transport);
+    return vault_login(&env->client, "role", "secret");
+}
+
+static void bench_env_stop(bench_env_t *env) {
+    vault_client_cleanup(&env->client);
+    vault_client_thread_cleanup();
+    vault_transport_destroy(&env->transport);
+    mock_vault_stop(env->server);
+}
+
+static unsigned char *make_plaintext(size_t size) {
+    unsigned char *plaintext = malloc(size + 1);
+    if (!plaintext) return NULL;
+    for (size_t i = 0; i < size; i++) plaintext[i] = (unsigned char)('a' + i % 26);
+    plaintext[size] = '\0';
+    return plaintext;
+}
+
+static int run_transit(const envelope_options_t *opt, size_t size, envelope_result_t *result) {
+    bench_env_t env;
+    vault_transit_t transit;
+    unsigned char *plaintext = make_plaintext(size);
+    envelope_worker_t *workers = calloc((size_t)opt->transit_workers, sizeof(envelope_worker_t));
+    if (!plaintext || !workers || bench_env_start(&env, opt) != 0 || vault_transit_init(&transit, &env.client) != 0) {
+        return -1;
+    }
+    for (int i = 0; i < opt->transit_workers; i++) {
+        workers[i].transit = &transit;
+        workers[i].plaintext = plaintext;
+        workers[i].size = size;
+    }
+    memset(result, 0, sizeof(*result));
+    snprintf(result->name, sizeof(result->name), "transit");
+    result->size = size;
+    run_workers(opt, env.server, transit_worker, workers, opt->transit_workers, result);
+
+    vault_transit_destroy(&transit);
+    bench_env_stop(&env);
+    free(workers);
+    free(plaintext);
+    return 0;
+}
+
+// encrypt 단계 후 새 envelope로 decrypt 단계 (results[0]: encrypt, results[1]: decrypt)
+static int run_envelope(const envelope_options_t *opt, size_t size, int threads, envelope_result_t results[2]) {
+    bench_env_t env;
+    vault_envelope_t writer, reader;
+    unsigned char *plaintext = make_plaintext(size);
+    envelope_worker_t *workers = calloc((size_t)threads, sizeof(envelope_worker_t));
+    if (!plaintext || !workers || bench_env_start(&env, opt) != 0 || vault_envelope_init(&writer, &env.client) != 0 ||
+        vault_envelope_init(&reader, &env.client) != 0) {
+        return -1;
+    }
+    for (int i = 0; i < threads; i++) {
+        workers[i].envelope = &writer;
+        workers[i].plaintext = plaintext;
+        workers[i].size = size;
+    }
+    memset(results, 0, 2 * sizeof(envelope_result_t));
+    snprintf(results[0].name, sizeof(results[0].name), "encrypt");
+    results[0].size = size;
+    run_workers(opt, env.server, encrypt_worker, workers, threads, &results[0]);
+
+    for (int i = 0; i < threads; i++) workers[i].envelope = &reader;
+    snprintf(results[1].name, sizeof(results[1].name), "decrypt");
+    results[1].size = size;
+    run_workers(opt, env.server, decrypt_worker, workers, threads, &results[1]);
+
+    for (int i = 0; i < threads; i++) free(workers[i].record);
+    vault_envelope_destroy(&reader);
+    vault_envelope_destroy(&writer);
+    bench_env_stop(&env);
+    free(workers);
+    free(plaintext);
+    return 0;
+}
+
+// speedup은 transit과 같은 크기의 레코드에만 표시
+static void print_result(const envelope_result_t *r, double baseline) {
+    char speedup[16] = "-";
+    if (baseline > 0) snprintf(speedup, sizeof(speedup), "%.1fx", r->records_per_sec / baseline);
+    printf("%-8s %7zu %7d %12.0f %10.1f %9s %9ld %12.2e %7ld\n", r->name, r->size, r->threads,
+           r->records_per_sec, r->mb_per_sec, speedup, r->requests, r->requests_per_record, r->failed);
+}
+
+int main(int argc, char *argv[]) {
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    envelope_options_t opt = {cpus > 1 ? (int)(cpus < 8 ? cpus : 8) : 1, 64, 1, 2000, 20,
+                              DEFAULT_TRANSIT_ENVELOPE_MAX_USES};
+    int c;
+    while ((c = getopt(argc, argv, "t:w:d:l:T:u:")) != -1) {
+        switch (c) {
+            case 't': opt.threads = atoi(optarg); break;
+            case 'w': opt.transit_workers = atoi(optarg); break;
+            case 'd': opt.duration = atoi(optarg); break;
+            case 'l': opt.latency_us = atoi(optarg); break;
+            case 'T': opt.item_us = atoi(optarg); break;
+            case 'u': opt.max_uses = atol(optarg); break;
+            default:
+                fprintf(stderr, "Usage: %s [-t threads] [-w transit_workers] [-d seconds] [-l latency_us] "
+                                "[-T item_us] [-u max_uses]\n", argv[0]);
+                return 1;
+        }
+    }
+    if (opt.threads <= 0 || opt.threads > 256 || opt.transit_workers <= 0 ||
+        opt.transit_workers > VAULT_TRANSIT_MAX_PIPELINE || opt.duration <= 0 || opt.latency_us < 0 ||
+        opt.item_us < 0 || opt.max_uses <= 0) {
+        fprintf(stderr, "Invalid options (transit_workers 1..%d)\n", VAULT_TRANSIT_MAX_PIPELINE);
+        return 1;
+    }
+
+    curl_global_init(CURL_GLOBAL_DEFAULT);
+
+    // 클라이언트 로그 출력은 결과 집계에 방해되므로 실행 중에는 버림
+    fflush(stdout);
+    int saved_stdout = dup(STDOUT_FILENO);
+    int devnull = open("/dev/null", O_WRONLY);
+
+    static const size_t sizes[] = { 256, 1024, 16384, 65536 };
+    enum { SIZES = sizeof(sizes) / sizeof(sizes[0]) };
+    envelope_result_t transit_result;
+    envelope_result_t results[SIZES][2][2];  // [크기][1 스레드, T 스레드][encrypt, decrypt]
+    int thread_counts[2] = { 1, opt.threads };
+    int thread_runs = opt.threads > 1 ? 2 : 1;
+    int rc = 0;
+
+    fprintf(stderr, "Running transit (1024 bytes, %d workers, %ds)...\n", opt.transit_workers, opt.duration);
+    dup2(devnull, STDOUT_FILENO);
+    rc = run_transit(&opt, 1024, &transit_result);
+    for (int s = 0; s < SIZES && rc == 0; s++) {
+        for (int t = 0; t < thread_runs && rc == 0; t++) {
+            fflush(stdout);
+            dup2(saved_stdout, STDOUT_FILENO);
+            fprintf(stderr, "Running envelope (%zu bytes, %d threads, %ds x 2)...\n", sizes[s], thread_counts[t],
+                    opt.duration);
+            dup2(devnull, STDOUT_FILENO);
+            rc = run_envelope(&opt, sizes[s], thread_counts[t], results[s][t]);
+        }
+    }
+    fflush(stdout);
+    dup2(saved_stdout, STDOUT_FILENO);
+    close(devnull);
+    if (rc != 0) {
+        fprintf(stderr, "Failed to run benchmark\n");
+        return 1;
+    }
+
+    printf("=== Envelope Encryption Benchmark ===\n");
+    printf("duration=%ds mock latency=%dus + %dus/transit item, data key per %ld records\n\n", opt.duration,
+           opt.latency_us, opt.item_us, opt.max_uses);
+    printf("%-8s %7s %7s %12s %10s %9s %9s %12s %7s\n", "mode", "bytes", "threads", "records/sec", "MB/s",
+           "speedup", "requests", "req/record", "failed");
+    long failed = transit_result.failed;
+    print_result(&transit_result, transit_result.records_per_sec);
+    for (int s = 0; s < SIZES; s++) {
+        for (int t = 0; t < thread_runs; t++) {
+            for (int m = 0; m < 2; m++) {
+                print_result(&results[s][t][m], sizes[s] == 1024 ? transit_result.records_per_sec : 0);
+                failed += results[s][t][m].failed;
+            }
+        }
+    }
+    printf("\ntransit sends every record to Vault (batch_size %d, %d batches in flight, %d workers);\n"
+           "encrypt/decrypt run AES-256-GCM locally and only call Vault for a new or unwrapped data key\n",
+           DEFAULT_TRANSIT_BATCH_SIZE, DEFAULT_TRANSIT_PIPELINE, opt.transit_workers);
+
+    curl_global_cleanup();
+    return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,237 @@
+// KV 변경 전파 지연 벤치마크 (폴링 vs 이벤트 구독)
+// 내장 Vault 대역 서버(mock_vault)에서 KV를 무작위 간격으로 갱신(쓰기)하고, 쓰기 시각부터
+// 클라이언트의 변경 구독 콜백(vault_subscribe)이 새 버전을 받기까지의 시간을 측정합니다.
+// 갱신 스레드는 vault-app의 KV 갱신 스레드와 같은 방식으로 대기합니다
+// (이벤트 스트림이 연결되어 있으면 이벤트를 기다리고, 끊기면 refresh_interval 폴링).
+//
+// 시나리오:
+//   polling      : 이벤트 구독 없이 refresh_interval 폴링
+//   events       : sys/events/subscribe (kv-v2/data-write) 구독
+//   events+drop  : 쓰기 절반 시점에 대역 서버가 스트림을 끊음 (폴링 전환 후 재연결)
+//
+// 사용법: ./event-bench [-n writes] [-i refresh_interval_ms] [-g write_gap_ms] [-l latency_us] [-c]
+#define _POSIX_C_SOURCE 200809L
+#include "../src/vault_client.h"
+#include "../src/vault_events.h"
+#include "mock_vault.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+
+#define MAX_WRITES 1000
+
+typedef struct {
+    const char *name;
+    int use_events;
+    int drop_midway;
+} scenario_t;
+
+static const scenario_t scenarios[] = {
+    {"polling", 0, 0},
+    {"events", 1, 0},
+    {"events+drop", 1, 1},
+};
+
+// 측정 상태 (버전 번호로 색인, 대역 서버 KV 버전은 1부터 시작)
+static pthread_mutex_t observe_lock = PTHREAD_MUTEX_INITIALIZER;
+static uint64_t write_ns[MAX_WRITES + 2];
+static uint64_t seen_ns[MAX_WRITES + 2];
+
+static vault_client_t client;
+static vault_events_t events;
+static int stopping = 0;  // 갱신 스레드 종료 요청 (원자적 접근)
+static int refresh_interval_ms = 2000;
+
+static void sleep_ms(int ms) {
+    struct timespec ts = {ms / 1000, (long)(ms % 1000) * 1000000L};
+    nanosleep(&ts, NULL);
+}
+
+// 변경 구독 콜백: 새 버전까지의 모든 쓰기가 반영된 것으로 기록
+static void on_kv_change(const vault_secret_change_t *change, void *ctx) {
+    (void)ctx;
+    uint64_t now = vault_metrics_now_ns();
+    pthread_mutex_lock(&observe_lock);
+    for (long v = change->old_version + 1; v <= change->new_version && v <= MAX_WRITES + 1; v++) {
+        if (v > 0 && seen_ns[v] == 0) seen_ns[v] = now;
+    }
+    pthread_mutex_unlock(&observe_lock);
+}
+
+// vault-app의 KV 갱신 스레드와 같은 대기 방식 (폴링 간격만 ms 단위)
+static void *refresh_thread(void *arg) {
+    (void)arg;
+    while (!__atomic_load_n(&stopping, __ATOMIC_ACQUIRE)) {
+        for (int waited = 0; !__atomic_load_n(&stopping, __ATOMIC_ACQUIRE); waited += 100) {
+            if (waited >= refresh_interval_ms && !vault_events_connected(&events)) break;
+            if (vault_events_wait(&events, 100)) break;
+        }
+        if (__atomic_load_n(&stopping, __ATOMIC_ACQUIRE)) break;
+        vault_refresh_kv_secret(&client);
+    }
+    return NULL;
+}
+
+static int compare_u64(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+    return x < y ? -1 : x > y;
+}
+
+static void bench_config(app_config_t *config, int port) {
+    memset(config, 0, sizeof(*config));
+    snprintf(config->vault_url, sizeof(config->vault_url), "http://127.0.0.1:%d", port);
+    snprintf(config->entity, sizeof(config->entity), "bench");
+    snprintf(config->token_type, sizeof(config->token_type), "service");
+    snprintf(config->vault_role_id, sizeof(config->vault_role_id), "role");
+    snprintf(config->vault_secret_id, sizeof(config->vault_secret_id), "secret");
+    config->secret_kv.enabled = 1;
+    snprintf(config->secret_kv.kv_path, sizeof(config->secret_kv.kv_path), "database");
+    config->secret_kv.refresh_interval = 1;
+    config->http_timeout = 5;
+    config->max_response_size = DEFAULT_MAX_RESPONSE_SIZE;
+    config->schedule.renew_window_min = DEFAULT_RENEW_WINDOW_MIN;
+    config->schedule.renew_window_max = DEFAULT_RENEW_WINDOW_MAX;
+    strncpy(config->trace.format, DEFAULT_TRACE_FORMAT, sizeof(config->trace.format) - 1);
+}
+
+static int run_scenario(const scenario_t *scenario, int writes, int gap_ms, int latency_us, int csv) {
+    mock_vault_options_t options;
+    mock_vault_default_options(&options);
+    options.token_ttl = 3600;
+    options.latency_us = latency_us;
+    mock_vault_t *server = mock_vault_start(&options);
+    if (!server) return -1;
+
+    app_config_t config;
+    bench_config(&config, mock_vault_port(server));
+    vault_client_init(&client, &config);
+    if (vault_login(&client, config.vault_role_id, config.vault_secret_id) != 0 ||
+        vault_refresh_kv_secret(&client) != 0) {
+        fprintf(stderr, "%s: initial login/KV read failed\n", scenario->name);
+        vault_client_cleanup(&client);
+        mock_vault_stop(server);
+        return -1;
+    }
+    vault_subscribe(&client, "kv", on_kv_change, NULL);
+
+    memset(write_ns, 0, sizeof(write_ns));
+    memset(seen_ns, 0, sizeof(seen_ns));
+    vault_events_init(&events);
+    __atomic_store_n(&stopping, 0, __ATOMIC_RELEASE);
+
+    if (scenario->use_events) {
+        vault_events_start(&events, &client);
+        for (int i = 0; i < 50 && !vault_events_connected(&events); i++) {
+            sleep_ms(100);
+        }
+    }
+    pthread_t thread;
+    pthread_create(&thread, NULL, refresh_thread, NULL);
+
+    mock_vault_stats_t before;
+    mock_vault_get_stats(server, &before);
+
+    // 무작위 간격(gap의 0.5 ~ 1.5배)으로 KV 쓰기
+    unsigned long seed = 12345;
+    for (int i = 0; i < writes; i++) {
+        seed = seed * 6364136223846793005UL + 1442695040888963407UL;
+        sleep_ms(gap_ms / 2 + (int)((seed >> 33) % (unsigned long)(gap_ms + 1)));
+        if (scenario->drop_midway && i == writes / 2) {
+            mock_vault_drop_event_streams(server);
+        }
+        uint64_t now = vault_metrics_now_ns();
+        int version = mock_vault_bump_kv_version(server);
+        if (version > 0 && version <= MAX_WRITES + 1) write_ns[version] = now;
+    }
+
+    // 마지막 쓰기가 반영될 때까지 대기 (최대 폴링 간격 + 5초)
+    for (int waited = 0; waited < refresh_interval_ms + 5000; waited += 50) {
+        pthread_mutex_lock(&observe_lock);
+        int done = seen_ns[writes + 1] != 0;
+        pthread_mutex_unlock(&observe_lock);
+        if (done) break;
+        sleep_ms(50);
+    }
+    __atomic_store_n(&stopping, 1, __ATOMIC_RELEASE);
+    pthread_join(thread, NULL);
+
+    vault_events_stats_t event_stats;
+    vault_events_get_stats(&events, &event_stats);
+    vault_events_destroy(&events);
+
+    mock_vault_stats_t after;
+    mock_vault_get_stats(server, &after);
+
+    uint64_t latencies[MAX_WRITES];
+    int observed = 0;
+    pthread_mutex_lock(&observe_lock);
+    for (int v = 2; v <= writes + 1; v++) {
+        if (write_ns[v] && seen_ns[v]) latencies[observed++] = seen_ns[v] - write_ns[v];
+    }
+    pthread_mutex_unlock(&observe_lock);
+    qsort(latencies, (size_t)observed, sizeof(uint64_t), compare_u64);
+
+    double p50 = observed ? latencies[observed / 2] / 1e6 : 0;
+    double p99 = observed ? latencies[(observed * 99) / 100 < observed ? (observed * 99) / 100 : observed - 1] / 1e6 : 0;
+    double max = observed ? latencies[observed - 1] / 1e6 : 0;
+    long kv_reads = after.kv_reads - before.kv_reads;
+
+    if (csv) {
+        printf("%s,%d,%d,%.3f,%.3f,%.3f,%ld,%ld,%lu,%lu\n", scenario->name, writes, writes - observed, p50, p99,
+               max, kv_reads, after.events_sent - before.events_sent,
+               (unsigned long)event_stats.connects, (unsigned long)event_stats.disconnects);
+    } else {
+        printf("%-14s %7d %7d %10.2f %10.2f %10.2f %9ld %8ld %9lu/%lu\n", scenario->name, writes, writes - observed,
+               p50, p99, max, kv_reads, after.events_sent - before.events_sent,
+               (unsigned long)event_stats.connects, (unsigned long)event_stats.disconnects);
+    }
+    fflush(stdout);
+
+    vault_client_cleanup(&client);
+    mock_vault_stop(server);
+    return 0;
+}
+
+int main(int argc, char *argv[]) {
+    int writes = 10;
+    int gap_ms = 1500;
+    int latency_us = 0;
+    int csv = 0;
+    int c;
+    while ((c = getopt(argc, argv, "n:i:g:l:c")) != -1) {
+        switch (c) {
+            case 'n': writes = atoi(optarg); break;
+            case 'i': refresh_interval_ms = atoi(optarg); break;
+            case 'g': gap_ms = atoi(optarg); break;
+            case 'l': latency_us = atoi(optarg); break;
+            case 'c': csv = 1; break;
+            default:
+                fprintf(stderr, "Usage: %s [-n writes] [-i refresh_interval_ms] [-g write_gap_ms] "
+                                "[-l latency_us] [-c]\n", argv[0]);
+                return 1;
+        }
+    }
+    if (writes < 1 || writes > MAX_WRITES || refresh_interval_ms < 100 || gap_ms < 10) {
+        fprintf(stderr, "writes: 1 ~ %d, refresh_interval_ms >= 100, write_gap_ms >= 10\n", MAX_WRITES);
+        return 1;
+    }
+
+    curl_global_init(CURL_GLOBAL_DEFAULT);
+    if (csv) {
+        printf("scenario,writes,missed,p50_ms,p99_ms,max_ms,kv_reads,events_sent,connects,disconnects\n");
+    } else {
+        printf("=== KV Change Propagation (write -> subscriber callback) ===\n");
+        printf("writes=%d gap=%d~%dms refresh_interval=%dms latency=%dus\n\n", writes, gap_ms / 2,
+               gap_ms / 2 + gap_ms, refresh_interval_ms, latency_us);
+        printf("%-14s %7s %7s %10s %10s %10s %9s %8s %11s\n", "scenario", "writes", "missed", "p50_ms",
+               "p99_ms", "max_ms", "kv_reads", "events", "conn/drop");
+    }
+    for (size_t s = 0; s < sizeof(scenarios) / sizeof(scenarios[0]); s++) {
+        run_scenario(&scenarios[s], writes, gap_ms, latency_us, csv);
+    }
+    curl_global_cleanup();
+    return 0;
+}
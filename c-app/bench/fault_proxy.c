@@ -0,0 +1,525 @@
+#define _POSIX_C_SOURCE 200809L
+#include "fault_proxy.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <strings.h>
+#include <unistd.h>
+#include <signal.h>
+#include <pthread.h>
+#include <time.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+
+#define PROXY_MAX_MESSAGE (16 * 1024 * 1024)
+
+struct fault_proxy {
+    fault_scenario_t scenario;
+    int listen_fd;
+    int port;
+    int upstream_port;
+    volatile int stopping;
+    pthread_t accept_thread;
+    pthread_mutex_t lock;
+
+    struct timespec begin;  // 시나리오 시작 시각 (begun == 0이면 시작 전)
+    int begun;
+    fault_phase_stats_t stats[FAULT_MAX_PHASES];
+};
+
+typedef struct {
+    fault_proxy_t *proxy;
+    int fd;
+} proxy_connection_t;
+
+// HTTP 메시지 버퍼 (헤더 + 본문)
+typedef struct {
+    char *data;
+    size_t used;
+    size_t capacity;
+} message_buffer_t;
+
+static const char *kind_names[] = {"pass", "delay", "error", "truncate", "drop", "refuse", "flap"};
+
+const char *fault_kind_name(fault_kind_t kind) {
+    return kind_names[kind];
+}
+
+// ---------------------------------------------------------------------------
+// 시나리오
+// ---------------------------------------------------------------------------
+
+static int parse_phase(char *line, fault_phase_t *phase) {
+    char kind[16];
+    int consumed = 0;
+    memset(phase, 0, sizeof(*phase));
+
+    if (sscanf(line, "%31s %d %15s%n", phase->name, &phase->duration, kind, &consumed) != 3) return -1;
+    char *args = line + consumed;
+
+    // path=<prefix> 분리
+    char *path = strstr(args, "path=");
+    if (path) {
+        sscanf(path + 5, "%127s", phase->path_prefix);
+        *path = '\0';
+    }
+
+    int kinds = (int)(sizeof(kind_names) / sizeof(kind_names[0]));
+    int k;
+    for (k = 0; k < kinds && strcmp(kind, kind_names[k]) != 0; k++) {
+    }
+    if (k == kinds) return -1;
+    phase->kind = (fault_kind_t)k;
+
+    switch (phase->kind) {
+        case FAULT_DELAY:
+            if (sscanf(args, "%d %d", &phase->delay_ms, &phase->jitter_ms) < 1) return -1;
+            break;
+        case FAULT_ERROR:
+            if (sscanf(args, "%d %lf", &phase->status, &phase->probability) != 2) return -1;
+            break;
+        case FAULT_TRUNCATE:
+        case FAULT_DROP:
+        case FAULT_REFUSE:
+            if (sscanf(args, "%lf", &phase->probability) != 1) return -1;
+            break;
+        case FAULT_FLAP:
+            if (sscanf(args, "%d", &phase->flap_period) != 1 || phase->flap_period <= 0) return -1;
+            break;
+        case FAULT_PASS:
+            break;
+    }
+    return phase->duration > 0 ? 0 : -1;
+}
+
+int fault_scenario_load(const char *path, fault_scenario_t *scenario) {
+    FILE *file = fopen(path, "r");
+    if (!file) {
+        perror("fault_scenario_load");
+        return -1;
+    }
+
+    char line[512];
+    int line_no = 0;
+    scenario->count = 0;
+    while (fgets(line, sizeof(line), file)) {
+        line_no++;
+        char *p = line;
+        while (*p == ' ' || *p == '\t') p++;
+        if (*p == '#' || *p == '\n' || *p == '\0') continue;
+        char *comment = strchr(p, '#');
+        if (comment) *comment = '\0';
+
+        if (scenario->count == FAULT_MAX_PHASES ||
+            parse_phase(p, &scenario->phases[scenario->count]) != 0) {
+            fprintf(stderr, "%s:%d: invalid scenario line\n", path, line_no);
+            fclose(file);
+            return -1;
+        }
+        scenario->count++;
+    }
+    fclose(file);
+    return scenario->count > 0 ? 0 : -1;
+}
+
+// 기본 시나리오 (각 5초)
+void fault_scenario_default(fault_scenario_t *scenario) {
+    static const char *lines[] = {
+        "baseline 5 pass",
+        "slow 5 delay 300 200",
+        "very-slow 5 delay 2500 0",
+        "5xx-50pct 5 error 503 0.5",
+        "429-all 5 error 429 1.0",
+        "truncate-30pct 5 truncate 0.3",
+        "drop-30pct 5 drop 0.3",
+        "down 5 refuse 1.0",
+        "flap-1s 6 flap 1",
+        "recovery 5 pass",
+    };
+    scenario->count = 0;
+    for (size_t i = 0; i < sizeof(lines) / sizeof(lines[0]); i++) {
+        char line[128];
+        snprintf(line, sizeof(line), "%s", lines[i]);
+        if (parse_phase(line, &scenario->phases[scenario->count]) == 0) {
+            scenario->count++;
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// 입출력
+// ---------------------------------------------------------------------------
+
+static int send_all(int fd, const char *data, size_t len) {
+    while (len > 0) {
+        ssize_t n = send(fd, data, len, 0);
+        if (n <= 0) return -1;
+        data += n;
+        len -= (size_t)n;
+    }
+    return 0;
+}
+
+static int buffer_reserve(message_buffer_t *buffer, size_t extra) {
+    if (buffer->used + extra + 1 <= buffer->capacity) return 0;
+    size_t capacity = buffer->capacity ? buffer->capacity : 8192;
+    while (capacity < buffer->used + extra + 1) capacity *= 2;
+    if (capacity > PROXY_MAX_MESSAGE) return -1;
+    char *grown = realloc(buffer->data, capacity);
+    if (!grown) return -1;
+    buffer->data = grown;
+    buffer->capacity = capacity;
+    return 0;
+}
+
+static ssize_t buffer_recv(int fd, message_buffer_t *buffer) {
+    if (buffer_reserve(buffer, 16384) != 0) return -1;
+    ssize_t n = recv(fd, buffer->data + buffer->used, buffer->capacity - buffer->used - 1, 0);
+    if (n > 0) {
+        buffer->used += (size_t)n;
+        buffer->data[buffer->used] = '\0';
+    }
+    return n;
+}
+
+// Content-Length 값 (없으면 -1)
+static long content_length(const char *head, size_t head_len) {
+    const char *p = head;
+    while (p && p < head + head_len) {
+        const char *line = strstr(p, "\r\n");
+        if (!line) break;
+        line += 2;
+        if (strncasecmp(line, "Content-Length:", 15) == 0) {
+            return atol(line + 15);
+        }
+        p = line;
+    }
+    return -1;
+}
+
+// 완전한 HTTP 메시지 하나를 읽음 (메시지 길이 반환, 연결 종료/오류 시 -1)
+// until_close: Content-Length가 없으면 연결 종료까지 읽음 (응답용)
+static long read_message(int fd, message_buffer_t *buffer, int until_close) {
+    char *head_end;
+    while (!buffer->data || !(head_end = strstr(buffer->data, "\r\n\r\n"))) {
+        if (buffer_recv(fd, buffer) <= 0) return -1;
+    }
+
+    size_t head_len = (size_t)(head_end - buffer->data) + 4;
+    long length = content_length(buffer->data, head_len);
+    if (length < 0 && until_close) {
+        while (buffer_recv(fd, buffer) > 0) {
+        }
+        return (long)buffer->used;
+    }
+    if (length < 0) length = 0;
+
+    size_t total = head_len + (size_t)length;
+    if (total > PROXY_MAX_MESSAGE) return -1;
+    while (buffer->used < total) {
+        if (buffer_recv(fd, buffer) <= 0) return -1;
+    }
+    return (long)total;
+}
+
+static void buffer_consume(message_buffer_t *buffer, size_t len) {
+    memmove(buffer->data, buffer->data + len, buffer->used - len);
+    buffer->used -= len;
+    buffer->data[buffer->used] = '\0';
+}
+
+static int connect_upstream(int port) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) return -1;
+
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = htons((unsigned short)port);
+    if (connect(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0) {
+        close(fd);
+        return -1;
+    }
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    return fd;
+}
+
+// ---------------------------------------------------------------------------
+// 장애 결정
+// ---------------------------------------------------------------------------
+
+static uint64_t next_random(uint64_t *state) {
+    uint64_t x = (*state += 0x9e3779b97f4a7c15ULL);
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+static double random_unit(uint64_t *state) {
+    return (double)(next_random(state) >> 11) / 9007199254740992.0;
+}
+
+static double elapsed_seconds(const struct timespec *since) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)(now.tv_sec - since->tv_sec) + (double)(now.tv_nsec - since->tv_nsec) / 1e9;
+}
+
+// 현재 단계와 단계 내 경과 시간
+static int current_phase(fault_proxy_t *proxy, double *phase_elapsed) {
+    pthread_mutex_lock(&proxy->lock);
+    int begun = proxy->begun;
+    struct timespec begin = proxy->begin;
+    pthread_mutex_unlock(&proxy->lock);
+    if (!begun) return -1;
+
+    double t = elapsed_seconds(&begin);
+    for (int i = 0; i < proxy->scenario.count; i++) {
+        if (t < proxy->scenario.phases[i].duration) {
+            if (phase_elapsed) *phase_elapsed = t;
+            return i;
+        }
+        t -= proxy->scenario.phases[i].duration;
+    }
+    return proxy->scenario.count;
+}
+
+// 요청 경로 (요청 라인의 두 번째 토큰)
+static void request_path(const char *request, char *path, size_t size) {
+    path[0] = '\0';
+    const char *start = strchr(request, ' ');
+    if (!start) return;
+    start++;
+    size_t len = strcspn(start, " \r\n");
+    if (len >= size) len = size - 1;
+    memcpy(path, start, len);
+    path[len] = '\0';
+}
+
+// 이번 요청에 적용할 장애 (FAULT_FLAP은 PASS/REFUSE로 변환)
+static fault_kind_t decide_fault(fault_proxy_t *proxy, const char *request, uint64_t *rng,
+                                 const fault_phase_t **applied) {
+    double phase_elapsed = 0;
+    int index = current_phase(proxy, &phase_elapsed);
+    *applied = NULL;
+    if (index < 0 || index >= proxy->scenario.count) return FAULT_PASS;
+
+    const fault_phase_t *phase = &proxy->scenario.phases[index];
+    fault_kind_t kind = phase->kind;
+
+    char path[256];
+    request_path(request, path, sizeof(path));
+    if (phase->path_prefix[0] && strncmp(path, phase->path_prefix, strlen(phase->path_prefix)) != 0) {
+        kind = FAULT_PASS;
+    }
+
+    switch (kind) {
+        case FAULT_ERROR:
+        case FAULT_TRUNCATE:
+        case FAULT_DROP:
+        case FAULT_REFUSE:
+            if (random_unit(rng) >= phase->probability) kind = FAULT_PASS;
+            break;
+        case FAULT_FLAP:
+            kind = ((int)(phase_elapsed / phase->flap_period) % 2) ? FAULT_REFUSE : FAULT_PASS;
+            break;
+        default:
+            break;
+    }
+
+    pthread_mutex_lock(&proxy->lock);
+    proxy->stats[index].requests++;
+    if (kind != FAULT_PASS) proxy->stats[index].injected++;
+    pthread_mutex_unlock(&proxy->lock);
+
+    *applied = phase;
+    return kind;
+}
+
+// ---------------------------------------------------------------------------
+// 연결 처리
+// ---------------------------------------------------------------------------
+
+static void *connection_thread(void *arg) {
+    proxy_connection_t *connection = (proxy_connection_t *)arg;
+    fault_proxy_t *proxy = connection->proxy;
+    int fd = connection->fd;
+    free(connection);
+
+    message_buffer_t request = {0};
+    message_buffer_t response = {0};
+    int upstream = -1;
+    uint64_t rng = (uint64_t)time(NULL) ^ ((uint64_t)fd << 32) ^ (uint64_t)(uintptr_t)&rng;
+
+    while (!proxy->stopping) {
+        long request_len = read_message(fd, &request, 0);
+        if (request_len < 0) break;
+
+        const fault_phase_t *phase = NULL;
+        fault_kind_t fault = decide_fault(proxy, request.data, &rng, &phase);
+
+        if (fault == FAULT_REFUSE) break;
+
+        if (fault == FAULT_ERROR) {
+            char reply[256];
+            const char *body = "{\"errors\":[\"injected fault\"]}";
+            int n = snprintf(reply, sizeof(reply),
+                             "HTTP/1.1 %d Injected\r\nContent-Type: application/json\r\n"
+                             "Content-Length: %zu\r\n\r\n%s", phase->status, strlen(body), body);
+            if (send_all(fd, reply, (size_t)n) != 0) break;
+            buffer_consume(&request, (size_t)request_len);
+            continue;
+        }
+
+        if (fault == FAULT_DELAY) {
+            long delay_ms = phase->delay_ms;
+            if (phase->jitter_ms > 0) delay_ms += (long)(next_random(&rng) % (uint64_t)(phase->jitter_ms + 1));
+            struct timespec ts = {delay_ms / 1000, (delay_ms % 1000) * 1000000L};
+            nanosleep(&ts, NULL);
+        }
+
+        // 업스트림 전달 (유휴 연결이 끊겼으면 한 번 재연결)
+        long response_len = -1;
+        for (int attempt = 0; attempt < 2 && response_len < 0; attempt++) {
+            if (upstream < 0) upstream = connect_upstream(proxy->upstream_port);
+            if (upstream < 0) break;
+            response.used = 0;
+            if (response.data) response.data[0] = '\0';
+            if (send_all(upstream, request.data, (size_t)request_len) == 0) {
+                response_len = read_message(upstream, &response, 1);
+            }
+            if (response_len < 0) {
+                close(upstream);
+                upstream = -1;
+            }
+        }
+        if (response_len < 0) break;  // 업스트림 장애는 연결 종료로 전달
+
+        if (fault == FAULT_TRUNCATE || fault == FAULT_DROP) {
+            // truncate: 헤더 + 본문 절반, drop: 헤더 절반
+            char *head_end = strstr(response.data, "\r\n\r\n");
+            size_t head_len = head_end ? (size_t)(head_end - response.data) + 4 : (size_t)response_len;
+            size_t partial = fault == FAULT_TRUNCATE ? head_len + ((size_t)response_len - head_len) / 2 : head_len / 2;
+            send_all(fd, response.data, partial);
+            break;
+        }
+
+        if (send_all(fd, response.data, (size_t)response_len) != 0) break;
+        buffer_consume(&request, (size_t)request_len);
+        if (upstream >= 0 && strstr(response.data, "Connection: close")) {
+            close(upstream);
+            upstream = -1;
+        }
+    }
+
+    if (upstream >= 0) close(upstream);
+    free(request.data);
+    free(response.data);
+    close(fd);
+    return NULL;
+}
+
+static void *accept_thread(void *arg) {
+    fault_proxy_t *proxy = (fault_proxy_t *)arg;
+
+    while (!proxy->stopping) {
+        int fd = accept(proxy->listen_fd, NULL, NULL);
+        if (fd < 0) {
+            if (proxy->stopping) break;
+            continue;
+        }
+        int one = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+        proxy_connection_t *connection = malloc(sizeof(proxy_connection_t));
+        pthread_t thread;
+        if (!connection) {
+            close(fd);
+            continue;
+        }
+        connection->proxy = proxy;
+        connection->fd = fd;
+        if (pthread_create(&thread, NULL, connection_thread, connection) != 0) {
+            free(connection);
+            close(fd);
+            continue;
+        }
+        pthread_detach(thread);
+    }
+    return NULL;
+}
+
+fault_proxy_t *fault_proxy_start(int listen_port, int upstream_port, const fault_scenario_t *scenario) {
+    signal(SIGPIPE, SIG_IGN);
+
+    fault_proxy_t *proxy = calloc(1, sizeof(fault_proxy_t));
+    if (!proxy) return NULL;
+    proxy->scenario = *scenario;
+    proxy->upstream_port = upstream_port;
+    pthread_mutex_init(&proxy->lock, NULL);
+
+    proxy->listen_fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (proxy->listen_fd < 0) goto fail;
+
+    int one = 1;
+    setsockopt(proxy->listen_fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = htons((unsigned short)listen_port);
+    if (bind(proxy->listen_fd, (struct sockaddr *)&addr, sizeof(addr)) != 0) goto fail;
+    if (listen(proxy->listen_fd, 512) != 0) goto fail;
+
+    socklen_t len = sizeof(addr);
+    getsockname(proxy->listen_fd, (struct sockaddr *)&addr, &len);
+    proxy->port = ntohs(addr.sin_port);
+
+    if (pthread_create(&proxy->accept_thread, NULL, accept_thread, proxy) != 0) goto fail;
+    return proxy;
+
+fail:
+    perror("fault_proxy_start");
+    if (proxy->listen_fd >= 0) close(proxy->listen_fd);
+    pthread_mutex_destroy(&proxy->lock);
+    free(proxy);
+    return NULL;
+}
+
+int fault_proxy_port(const fault_proxy_t *proxy) {
+    return proxy ? proxy->port : -1;
+}
+
+void fault_proxy_begin(fault_proxy_t *proxy) {
+    pthread_mutex_lock(&proxy->lock);
+    clock_gettime(CLOCK_MONOTONIC, &proxy->begin);
+    proxy->begun = 1;
+    pthread_mutex_unlock(&proxy->lock);
+}
+
+int fault_proxy_phase(fault_proxy_t *proxy) {
+    return current_phase(proxy, NULL);
+}
+
+void fault_proxy_get_stats(fault_proxy_t *proxy, fault_phase_stats_t *stats) {
+    pthread_mutex_lock(&proxy->lock);
+    memcpy(stats, proxy->stats, sizeof(fault_phase_stats_t) * proxy->scenario.count);
+    pthread_mutex_unlock(&proxy->lock);
+}
+
+void fault_proxy_stop(fault_proxy_t *proxy) {
+    if (!proxy) return;
+
+    proxy->stopping = 1;
+    shutdown(proxy->listen_fd, SHUT_RDWR);
+    close(proxy->listen_fd);
+    pthread_join(proxy->accept_thread, NULL);
+    // 연결 스레드는 분리되어 있으므로 구조체는 해제하지 않음 (mock_vault_stop과 동일)
+}
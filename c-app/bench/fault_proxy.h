@@ -0,0 +1,69 @@
+#ifndef FAULT_PROXY_H
+#define FAULT_PROXY_H
+
+// 장애 주입 HTTP 프록시
+// 클라이언트와 Vault(또는 mock_vault) 사이에서 요청을 중계하며, 시나리오의 단계(phase)에 따라
+// 지연, 5xx/429 응답, 본문 잘림, 응답 중 연결 끊김, 연결 거부, 가용/불가 반복(flap)을 주입합니다.
+//
+// 시나리오 파일 형식 (한 줄에 한 단계, # 주석):
+//   <name> <seconds> pass
+//   <name> <seconds> delay <ms> [jitter_ms]
+//   <name> <seconds> error <status> <probability>
+//   <name> <seconds> truncate <probability>     응답 본문 절반만 보내고 연결 종료
+//   <name> <seconds> drop <probability>         응답 헤더 일부만 보내고 연결 종료
+//   <name> <seconds> refuse <probability>       응답 없이 연결 종료
+//   <name> <seconds> flap <period_seconds>      period마다 refuse/pass 전환
+// 각 줄 끝에 path=<prefix>를 붙이면 해당 경로로 시작하는 요청에만 적용합니다.
+
+#define FAULT_MAX_PHASES 32
+
+typedef enum {
+    FAULT_PASS,
+    FAULT_DELAY,
+    FAULT_ERROR,
+    FAULT_TRUNCATE,
+    FAULT_DROP,
+    FAULT_REFUSE,
+    FAULT_FLAP
+} fault_kind_t;
+
+// 시나리오 단계
+typedef struct {
+    char name[32];
+    int duration;         // 단계 지속 시간 (초)
+    fault_kind_t kind;
+    int delay_ms;         // delay: 지연 시간
+    int jitter_ms;        // delay: 추가 변동폭 (0 ~ jitter_ms)
+    int status;           // error: HTTP 상태 코드
+    double probability;   // error/truncate/drop/refuse: 적용 확률 (0~1)
+    int flap_period;      // flap: 전환 주기 (초)
+    char path_prefix[128];
+} fault_phase_t;
+
+typedef struct {
+    fault_phase_t phases[FAULT_MAX_PHASES];
+    int count;
+} fault_scenario_t;
+
+// 단계별 프록시 통계
+typedef struct {
+    long requests;  // 프록시가 받은 요청
+    long injected;  // 장애가 주입된 요청
+} fault_phase_stats_t;
+
+typedef struct fault_proxy fault_proxy_t;
+
+// 시나리오
+int fault_scenario_load(const char *path, fault_scenario_t *scenario);
+void fault_scenario_default(fault_scenario_t *scenario);
+const char *fault_kind_name(fault_kind_t kind);
+
+// 프록시 (127.0.0.1, listen_port 0이면 임의 포트)
+fault_proxy_t *fault_proxy_start(int listen_port, int upstream_port, const fault_scenario_t *scenario);
+int fault_proxy_port(const fault_proxy_t *proxy);
+void fault_proxy_begin(fault_proxy_t *proxy);  // 시나리오 시계 시작 (호출 전에는 pass)
+int fault_proxy_phase(fault_proxy_t *proxy);   // 현재 단계 (시작 전 -1, 종료 후 count)
+void fault_proxy_get_stats(fault_proxy_t *proxy, fault_phase_stats_t *stats);  // stats[count]
+void fault_proxy_stop(fault_proxy_t *proxy);
+
+#endif
@@ -0,0 +1,74 @@
+// 단독 실행용 장애 주입 프록시
+// vault-app 또는 다른 클라이언트를 Vault(또는 mock-vault) 대신 이 프록시에 연결해 장애 상황을 재현합니다.
+// 시작과 동시에 시나리오 시계가 흐르며, 시나리오가 끝나면 모든 요청을 그대로 전달합니다.
+//
+// 사용법: ./fault-proxy -u upstream_port [-p listen_port] [-s scenario_file]
+#define _POSIX_C_SOURCE 200809L
+#include "fault_proxy.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <signal.h>
+
+static volatile sig_atomic_t should_exit = 0;
+
+static void signal_handler(int sig) {
+    (void)sig;
+    should_exit = 1;
+}
+
+int main(int argc, char *argv[]) {
+    int listen_port = 8201, upstream_port = 0;
+    const char *scenario_file = NULL;
+    int c;
+    while ((c = getopt(argc, argv, "u:p:s:")) != -1) {
+        switch (c) {
+            case 'u': upstream_port = atoi(optarg); break;
+            case 'p': listen_port = atoi(optarg); break;
+            case 's': scenario_file = optarg; break;
+            default:
+                fprintf(stderr, "Usage: %s -u upstream_port [-p listen_port] [-s scenario_file]\n", argv[0]);
+                return 1;
+        }
+    }
+    if (upstream_port <= 0) {
+        fprintf(stderr, "Usage: %s -u upstream_port [-p listen_port] [-s scenario_file]\n", argv[0]);
+        return 1;
+    }
+
+    fault_scenario_t scenario;
+    if (scenario_file) {
+        if (fault_scenario_load(scenario_file, &scenario) != 0) return 1;
+    } else {
+        fault_scenario_default(&scenario);
+    }
+
+    signal(SIGINT, signal_handler);
+    signal(SIGTERM, signal_handler);
+
+    fault_proxy_t *proxy = fault_proxy_start(listen_port, upstream_port, &scenario);
+    if (!proxy) return 1;
+    printf("Fault proxy listening on http://127.0.0.1:%d -> 127.0.0.1:%d (%d phases)\n",
+           fault_proxy_port(proxy), upstream_port, scenario.count);
+    fflush(stdout);
+    fault_proxy_begin(proxy);
+
+    int last_phase = -1;
+    while (!should_exit) {
+        int phase = fault_proxy_phase(proxy);
+        if (phase != last_phase) {
+            if (phase < scenario.count) {
+                printf("[phase %d] %s (%s, %ds)\n", phase, scenario.phases[phase].name,
+                       fault_kind_name(scenario.phases[phase].kind), scenario.phases[phase].duration);
+            } else {
+                printf("[done] scenario finished, passing all requests through\n");
+            }
+            fflush(stdout);
+            last_phase = phase;
+        }
+        sleep(1);
+    }
+
+    fault_proxy_stop(proxy);
+    return 0;
+}
@@ -0,0 +1,315 @@
+// 적응형 동시 요청 제한 벤치마크
+// 한 번에 capacity개만 처리하는 Vault 대역 서버(요청당 latency_us)에 대량 갱신을 흉내 낸 부하를 걸고
+// 제한 없음(unlimited)과 적응형 한도(adaptive)를 비교합니다.
+//   bulk:     스레드 B개가 vault_get_secrets로 경로 P개씩 계속 조회 (max_in_flight개 동시)
+//   normal:   스레드 N개가 vault_get_secret으로 단일 경로 조회
+//   critical: 스레드 하나가 100ms마다 vault_renew_token
+// 서버 처리량(초당 요청, 초 단위 최소/최대), 서버 대기열 최대 길이, 우선순위별 지연 시간을 집계합니다.
+//
+// 사용법: ./limit-bench [-b bulk_threads] [-n normal_threads] [-p paths] [-m max_in_flight]
+//                       [-K capacity] [-l latency_us] [-Q overload_queue] [-d seconds]
+#define _POSIX_C_SOURCE 200809L
+#include "../src/vault_client.h"
+#include "mock_vault.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+
+#define SAMPLE_CAPACITY 65536  // 스레드당 지연 시간 표본 수
+#define WARMUP_SECONDS 2       // 처리량 최소/최대에서 제외하는 시작 구간
+
+typedef struct {
+    int bulk_threads;
+    int normal_threads;
+    int paths;
+    int max_in_flight;
+    int capacity;
+    int latency_us;
+    int overload_queue;
+    int duration;
+} limit_options_t;
+
+typedef enum { CLASS_CRITICAL, CLASS_NORMAL, CLASS_BULK, CLASS_COUNT } load_class_t;
+
+typedef struct {
+    vault_client_t *client;
+    load_class_t kind;
+    const char *const *paths;
+    int path_count;
+    uint64_t *samples;        // 호출당 지연 시간 (ns)
+    size_t sample_count;
+    long calls;
+    long failures;            // 실패한 호출 (bulk는 실패한 경로 수)
+} load_worker_t;
+
+typedef struct {
+    char name[16];
+    double rps;               // 서버가 처리한 초당 요청 (시작 구간 제외 평균)
+    double rps_min;
+    double rps_max;
+    long peak_queued;
+    long overloaded;
+    double p50_ms[CLASS_COUNT];
+    double p99_ms[CLASS_COUNT];
+    double max_ms[CLASS_COUNT];
+    long failures[CLASS_COUNT];
+    vault_limiter_stats_t limit;
+} limit_result_t;
+
+static int stop_flag = 0;
+static const char *class_names[CLASS_COUNT] = {"critical", "normal", "bulk"};
+
+static void *load_thread(void *arg) {
+    load_worker_t *worker = (load_worker_t *)arg;
+    vault_secret_result_t *results = NULL;
+    if (worker->kind == CLASS_BULK) {
+        results = calloc((size_t)worker->path_count, sizeof(vault_secret_result_t));
+        if (!results) return NULL;
+    }
+    while (!__atomic_load_n(&stop_flag, __ATOMIC_ACQUIRE)) {
+        uint64_t start = vault_metrics_now_ns();
+        if (worker->kind == CLASS_CRITICAL) {
+            if (vault_renew_token(worker->client) != 0) worker->failures++;
+        } else if (worker->kind == CLASS_NORMAL) {
+            json_object *secret = NULL;
+            if (vault_get_secret(worker->client, worker->paths[0], &secret) != 0) worker->failures++;
+            vault_cleanup_secret(secret);
+        } else {
+            int failed = vault_get_secrets(worker->client, worker->paths, (size_t)worker->path_count, results);
+            worker->failures += failed > 0 ? failed : 0;
+            for (int i = 0; i < worker->path_count; i++) {
+                vault_cleanup_secret(results[i].data);
+            }
+        }
+        uint64_t elapsed = vault_metrics_now_ns() - start;
+        if (worker->sample_count < SAMPLE_CAPACITY) worker->samples[worker->sample_count++] = elapsed;
+        worker->calls++;
+
+        if (worker->kind == CLASS_CRITICAL) {
+            struct timespec ts = {0, 100000000};
+            nanosleep(&ts, NULL);
+        }
+    }
+    free(results);
+    vault_client_thread_cleanup();
+    return NULL;
+}
+
+static int compare_u64(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+    return x < y ? -1 : x > y;
+}
+
+static void make_config(app_config_t *config, int port, const limit_options_t *opt, int adaptive) {
+    memset(config, 0, sizeof(*config));
+    snprintf(config->vault_url, sizeof(config->vault_url), "http://127.0.0.1:%d", port);
+    snprintf(config->entity, sizeof(config->entity), "limit-bench");
+    snprintf(config->token_type, sizeof(config->token_type), "service");
+    config->secret_kv.refresh_interval = 0;  // 경로 캐시 없이 매번 요청 (대량 갱신)
+    config->http_timeout = 30;
+    config->max_response_size = DEFAULT_MAX_RESPONSE_SIZE;
+    config->max_in_flight = opt->max_in_flight;
+    config->adaptive_limit = adaptive;
+    config->limit_min = DEFAULT_LIMIT_MIN;
+    config->limit_max = DEFAULT_LIMIT_MAX;
+    config->schedule.renew_window_min = DEFAULT_RENEW_WINDOW_MIN;
+    config->schedule.renew_window_max = DEFAULT_RENEW_WINDOW_MAX;
+    config->schedule.refresh_jitter = DEFAULT_REFRESH_JITTER;
+    strncpy(config->trace.format, DEFAULT_TRACE_FORMAT, sizeof(config->trace.format) - 1);
+}
+
+static int run_mode(const limit_options_t *opt, const char *const *paths, int adaptive, limit_result_t *result) {
+    mock_vault_options_t server_options;
+    mock_vault_default_options(&server_options);
+    server_options.token_ttl = 3600;
+    server_options.token_max_ttl = 86400;
+    server_options.latency_us = opt->latency_us;
+    server_options.capacity = opt->capacity;
+    server_options.overload_queue = opt->overload_queue;
+    mock_vault_t *server = mock_vault_start(&server_options);
+    if (!server) return -1;
+
+    app_config_t config;
+    make_config(&config, mock_vault_port(server), opt, adaptive);
+    vault_transport_t transport;
+    vault_client_t client;
+    vault_transport_init(&transport);
+    vault_transport_configure(&transport, &config);
+    vault_client_init(&client, &config);
+    vault_client_set_transport(&client, &transport);
+    if (vault_login(&client, "role", "secret") != 0) {
+        vault_client_cleanup(&client);
+        vault_transport_destroy(&transport);
+        mock_vault_stop(server);
+        return -1;
+    }
+
+    int total = 1 + opt->normal_threads + opt->bulk_threads;
+    load_worker_t *workers = calloc((size_t)total, sizeof(load_worker_t));
+    pthread_t *threads = calloc((size_t)total, sizeof(pthread_t));
+    int rc = -1;
+    if (!workers || !threads) goto out;
+    for (int i = 0; i < total; i++) {
+        load_worker_t *worker = &workers[i];
+        worker->client = &client;
+        worker->kind = i == 0 ? CLASS_CRITICAL : i <= opt->normal_threads ? CLASS_NORMAL : CLASS_BULK;
+        worker->paths = worker->kind == CLASS_BULK ? paths + 1 : paths;
+        worker->path_count = worker->kind == CLASS_BULK ? opt->paths : 1;
+        worker->samples = calloc(SAMPLE_CAPACITY, sizeof(uint64_t));
+        if (!worker->samples) goto out;
+    }
+
+    __atomic_store_n(&stop_flag, 0, __ATOMIC_RELEASE);
+    for (int i = 0; i < total; i++) {
+        pthread_create(&threads[i], NULL, load_thread, &workers[i]);
+    }
+
+    // 초 단위 서버 처리량
+    memset(result, 0, sizeof(*result));
+    snprintf(result->name, sizeof(result->name), "%s", adaptive ? "adaptive" : "unlimited");
+    mock_vault_stats_t stats;
+    mock_vault_get_stats(server, &stats);
+    long previous = stats.requests, steady_start = 0;
+    result->rps_min = -1;
+    for (int second = 1; second <= opt->duration; second++) {
+        sleep(1);
+        mock_vault_get_stats(server, &stats);
+        double rps = (double)(stats.requests - previous);
+        previous = stats.requests;
+        if (second == WARMUP_SECONDS) steady_start = stats.requests;
+        if (second <= WARMUP_SECONDS) continue;
+        if (result->rps_min < 0 || rps < result->rps_min) result->rps_min = rps;
+        if (rps > result->rps_max) result->rps_max = rps;
+    }
+    int steady = opt->duration > WARMUP_SECONDS ? opt->duration - WARMUP_SECONDS : 1;
+    result->rps = (double)(stats.requests - steady_start) / steady;
+    result->peak_queued = stats.peak_queued;
+    result->overloaded = stats.overloaded;
+    __atomic_store_n(&stop_flag, 1, __ATOMIC_RELEASE);
+    for (int i = 0; i < total; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    for (int k = 0; k < CLASS_COUNT; k++) {
+        size_t n = 0;
+        for (int i = 0; i < total; i++) {
+            if ((int)workers[i].kind == k) n += workers[i].sample_count;
+        }
+        uint64_t *all = calloc(n ? n : 1, sizeof(uint64_t));
+        if (!all) goto out;
+        size_t at = 0;
+        for (int i = 0; i < total; i++) {
+            if ((int)workers[i].kind != k) continue;
+            memcpy(all + at, workers[i].samples, workers[i].sample_count * sizeof(uint64_t));
+            at += workers[i].sample_count;
+            result->failures[k] += workers[i].failures;
+        }
+        qsort(all, n, sizeof(uint64_t), compare_u64);
+        result->p50_ms[k] = n ? (double)all[n / 2] / 1e6 : 0;
+        result->p99_ms[k] = n ? (double)all[(n * 99) / 100] / 1e6 : 0;
+        result->max_ms[k] = n ? (double)all[n - 1] / 1e6 : 0;
+        free(all);
+    }
+    vault_limiter_get_stats(&transport.limiter, &result->limit);
+    rc = 0;
+
+out:
+    if (workers) {
+        for (int i = 0; i < total; i++) free(workers[i].samples);
+    }
+    free(workers);
+    free(threads);
+    vault_client_cleanup(&client);
+    vault_client_thread_cleanup();
+    vault_transport_destroy(&transport);
+    mock_vault_stop(server);
+    return rc;
+}
+
+int main(int argc, char *argv[]) {
+    limit_options_t opt = {4, 8, 64, 32, 8, 20000, 0, 10};
+    int c;
+    while ((c = getopt(argc, argv, "b:n:p:m:K:l:Q:d:")) != -1) {
+        switch (c) {
+            case 'b': opt.bulk_threads = atoi(optarg); break;
+            case 'n': opt.normal_threads = atoi(optarg); break;
+            case 'p': opt.paths = atoi(optarg); break;
+            case 'm': opt.max_in_flight = atoi(optarg); break;
+            case 'K': opt.capacity = atoi(optarg); break;
+            case 'l': opt.latency_us = atoi(optarg); break;
+            case 'Q': opt.overload_queue = atoi(optarg); break;
+            case 'd': opt.duration = atoi(optarg); break;
+            default:
+                fprintf(stderr, "Usage: %s [-b bulk_threads] [-n normal_threads] [-p paths] [-m max_in_flight] "
+                                "[-K capacity] [-l latency_us] [-Q overload_queue] [-d seconds]\n", argv[0]);
+                return 1;
+        }
+    }
+    if (opt.bulk_threads < 0 || opt.normal_threads < 0 || opt.paths <= 0 || opt.max_in_flight <= 0 ||
+        opt.capacity <= 0 || opt.latency_us < 0 || opt.overload_queue < 0 || opt.duration <= WARMUP_SECONDS) {
+        fprintf(stderr, "Invalid options (duration must be above %d seconds)\n", WARMUP_SECONDS);
+        return 1;
+    }
+
+    // paths[0]은 normal 조회 경로, 나머지는 bulk 경로
+    char **paths = calloc((size_t)opt.paths + 1, sizeof(char *));
+    if (!paths) return 1;
+    for (int i = 0; i <= opt.paths; i++) {
+        paths[i] = malloc(64);
+        if (!paths[i]) return 1;
+        if (i == 0) snprintf(paths[i], 64, "limit-bench-kv/data/app");
+        else snprintf(paths[i], 64, "limit-bench-kv/data/bulk/%d", i);
+    }
+
+    curl_global_init(CURL_GLOBAL_DEFAULT);
+
+    // 클라이언트 로그 출력은 결과 집계에 방해되므로 실행 중에는 버림
+    fflush(stdout);
+    int saved_stdout = dup(STDOUT_FILENO);
+    int devnull = open("/dev/null", O_WRONLY);
+
+    limit_result_t results[2];
+    for (int adaptive = 0; adaptive <= 1; adaptive++) {
+        fprintf(stderr, "Running %s (%d bulk x %d paths, %d normal, capacity %d)...\n",
+                adaptive ? "adaptive" : "unlimited", opt.bulk_threads, opt.paths, opt.normal_threads, opt.capacity);
+        dup2(devnull, STDOUT_FILENO);
+        int rc = run_mode(&opt, (const char *const *)paths, adaptive, &results[adaptive]);
+        fflush(stdout);
+        dup2(saved_stdout, STDOUT_FILENO);
+        if (rc != 0) {
+            fprintf(stderr, "Failed to run benchmark\n");
+            return 1;
+        }
+    }
+    close(devnull);
+
+    printf("=== Adaptive Concurrency Limit Benchmark ===\n");
+    printf("server capacity=%d latency=%dus overload_queue=%d | bulk %dx%d paths (max_in_flight %d), "
+           "normal %d, critical 1 (every 100ms), %ds\n\n",
+           opt.capacity, opt.latency_us, opt.overload_queue, opt.bulk_threads, opt.paths, opt.max_in_flight,
+           opt.normal_threads, opt.duration);
+    printf("%-10s %7s %7s %7s %7s %6s %6s %6s\n", "mode", "req/s", "min", "max", "queue", "503", "limit", "shed");
+    for (int m = 0; m < 2; m++) {
+        limit_result_t *r = &results[m];
+        uint64_t shed = r->limit.shed[0] + r->limit.shed[1] + r->limit.shed[2];
+        printf("%-10s %7.0f %7.0f %7.0f %7ld %6ld %6.1f %6llu\n", r->name, r->rps, r->rps_min, r->rps_max,
+               r->peak_queued, r->overloaded, r->limit.enabled ? r->limit.limit : 0.0, (unsigned long long)shed);
+    }
+    printf("\n%-10s %-9s %9s %9s %9s %8s\n", "mode", "class", "p50", "p99", "max", "failed");
+    for (int m = 0; m < 2; m++) {
+        limit_result_t *r = &results[m];
+        for (int k = 0; k < CLASS_COUNT; k++) {
+            printf("%-10s %-9s %7.1fms %7.1fms %7.1fms %8ld\n", r->name, class_names[k], r->p50_ms[k], r->p99_ms[k],
+                   r->max_ms[k], r->failures[k]);
+        }
+    }
+    printf("\nqueue: peak requests waiting inside the server, bulk latency is per vault_get_secrets call (%d paths)\n",
+           opt.paths);
+
+    curl_global_cleanup();
+    for (int i = 0; i <= opt.paths; i++) free(paths[i]);
+    free(paths);
+    return 0;
+}
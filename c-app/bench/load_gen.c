@@ -0,0 +1,328 @@
+// Vault 클라이언트 부하 생성기
+// N개의 스레드가 각자 vault_client를 갖고 시크릿 조회(캐시 경로) 또는 갱신 경로를 반복 호출하여
+// 처리량, 조회 지연 시간(p50/p99/p999), 조회 1회당 Vault 요청 수를 측정합니다.
+//
+// 기본은 내장 Vault 대역 서버(mock_vault)를 대상으로 하며, -f로 설정 파일을 주면
+// 해당 설정의 Vault 서버(실제 Vault 포함)를 대상으로 실행합니다.
+//
+// 사용법: ./load-gen [-n threads] [-d seconds] [-m mode] [-l latency_us] [-j jitter_us]
+//                    [-s payload_bytes] [-f config.ini]
+// mode: kv, kv-refresh, db-dynamic, db-dynamic-refresh, db-static, db-static-refresh, mixed
+#define _POSIX_C_SOURCE 200809L
+#include "../src/vault_client.h"
+#include "mock_vault.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <pthread.h>
+
+typedef enum {
+    MODE_KV,
+    MODE_KV_REFRESH,
+    MODE_DB_DYNAMIC,
+    MODE_DB_DYNAMIC_REFRESH,
+    MODE_DB_STATIC,
+    MODE_DB_STATIC_REFRESH,
+    MODE_MIXED,
+    MODE_COUNT
+} load_mode_t;
+
+static const char *mode_names[MODE_COUNT] = {
+    "kv", "kv-refresh", "db-dynamic", "db-dynamic-refresh", "db-static", "db-static-refresh", "mixed"
+};
+
+typedef struct {
+    int threads;
+    int duration;
+    load_mode_t mode;
+    int latency_us;
+    int jitter_us;
+    int payload_size;
+    const char *config_file;
+} load_options_t;
+
+typedef struct {
+    app_config_t config;
+    vault_client_t client;
+    load_mode_t mode;
+    int ready;
+
+    // 조회 지연 시간 기록 (us)
+    uint32_t *latencies;
+    size_t count;
+    size_t capacity;
+    long errors;
+} load_worker_t;
+
+static int start_flag = 0;
+static int stop_flag = 0;
+
+static int run_operation(vault_client_t *client, load_mode_t mode) {
+    json_object *secret = NULL;
+    int rc;
+    switch (mode) {
+        case MODE_KV: rc = vault_get_kv_secret(client, &secret); break;
+        case MODE_KV_REFRESH: rc = vault_refresh_kv_secret(client); break;
+        case MODE_DB_DYNAMIC: rc = vault_get_db_dynamic_secret(client, &secret); break;
+        case MODE_DB_DYNAMIC_REFRESH: rc = vault_refresh_db_dynamic_secret(client); break;
+        case MODE_DB_STATIC: rc = vault_get_db_static_secret(client, &secret); break;
+        case MODE_DB_STATIC_REFRESH: rc = vault_refresh_db_static_secret(client); break;
+        default: rc = -1; break;
+    }
+    if (secret) {
+        vault_cleanup_secret(secret);
+    }
+    return rc;
+}
+
+static void record_latency(load_worker_t *worker, uint64_t ns) {
+    if (worker->count == worker->capacity) {
+        size_t capacity = worker->capacity ? worker->capacity * 2 : 4096;
+        uint32_t *grown = realloc(worker->latencies, capacity * sizeof(uint32_t));
+        if (!grown) return;
+        worker->latencies = grown;
+        worker->capacity = capacity;
+    }
+    uint64_t us = ns / 1000;
+    worker->latencies[worker->count++] = us > UINT32_MAX ? UINT32_MAX : (uint32_t)us;
+}
+
+static void *worker_thread(void *arg) {
+    load_worker_t *worker = (load_worker_t *)arg;
+    vault_client_t *client = &worker->client;
+
+    int logged_in = vault_login(client, worker->config.vault_role_id, worker->config.vault_secret_id) == 0;
+    __atomic_store_n(&worker->ready, logged_in ? 1 : -1, __ATOMIC_RELEASE);
+    if (!logged_in) return NULL;
+
+    struct timespec wait = {0, 1000 * 1000};
+    while (!__atomic_load_n(&start_flag, __ATOMIC_ACQUIRE)) {
+        nanosleep(&wait, NULL);
+    }
+
+    // mixed: 조회 경로를 순환
+    load_mode_t mixed[] = {MODE_KV, MODE_DB_DYNAMIC, MODE_DB_STATIC};
+    unsigned long iteration = 0;
+    while (!__atomic_load_n(&stop_flag, __ATOMIC_ACQUIRE)) {
+        load_mode_t mode = worker->mode == MODE_MIXED ? mixed[iteration++ % 3] : worker->mode;
+        uint64_t start = vault_metrics_now_ns();
+        int rc = run_operation(client, mode);
+        record_latency(worker, vault_metrics_now_ns() - start);
+        if (rc != 0) {
+            worker->errors++;
+        }
+    }
+    return NULL;
+}
+
+static int compare_u32(const void *a, const void *b) {
+    uint32_t x = *(const uint32_t *)a;
+    uint32_t y = *(const uint32_t *)b;
+    return x < y ? -1 : x > y;
+}
+
+static uint32_t percentile(const uint32_t *sorted, size_t count, double p) {
+    if (count == 0) return 0;
+    size_t index = (size_t)(p * (double)(count - 1) + 0.5);
+    return sorted[index];
+}
+
+// 내장 대역 서버용 설정
+static void mock_config(app_config_t *config, int port, int index) {
+    memset(config, 0, sizeof(*config));
+    snprintf(config->vault_url, sizeof(config->vault_url), "http://127.0.0.1:%d", port);
+    snprintf(config->entity, sizeof(config->entity), "bench-%d", index);
+    snprintf(config->token_type, sizeof(config->token_type), "service");
+    snprintf(config->vault_role_id, sizeof(config->vault_role_id), "role");
+    snprintf(config->vault_secret_id, sizeof(config->vault_secret_id), "secret");
+    config->secret_kv.enabled = 1;
+    snprintf(config->secret_kv.kv_path, sizeof(config->secret_kv.kv_path), "database");
+    config->secret_kv.refresh_interval = DEFAULT_KV_REFRESH_INTERVAL;
+    config->secret_database_dynamic.enabled = 1;
+    snprintf(config->secret_database_dynamic.role_id, sizeof(config->secret_database_dynamic.role_id), "db-demo-dynamic");
+    config->secret_database_static.enabled = 1;
+    snprintf(config->secret_database_static.role_id, sizeof(config->secret_database_static.role_id), "db-demo-static");
+    config->http_timeout = 5;
+    config->max_response_size = DEFAULT_MAX_RESPONSE_SIZE;
+    config->schedule.renew_window_min = DEFAULT_RENEW_WINDOW_MIN;
+    config->schedule.renew_window_max = DEFAULT_RENEW_WINDOW_MAX;
+    config->schedule.refresh_jitter = DEFAULT_REFRESH_JITTER;
+    config->schedule.host_phase = 1;
+    strncpy(config->trace.format, DEFAULT_TRACE_FORMAT, sizeof(config->trace.format) - 1);
+}
+
+static void usage(const char *program) {
+    fprintf(stderr, "Usage: %s [-n threads] [-d seconds] [-m mode] [-l latency_us] [-j jitter_us] "
+                    "[-s payload_bytes] [-f config.ini]\n", program);
+    fprintf(stderr, "  mode: kv, kv-refresh, db-dynamic, db-dynamic-refresh, db-static, db-static-refresh, mixed\n");
+}
+
+int main(int argc, char *argv[]) {
+    load_options_t opt = {8, 10, MODE_KV, 0, 0, 64, NULL};
+    int c;
+    while ((c = getopt(argc, argv, "n:d:m:l:j:s:f:")) != -1) {
+        switch (c) {
+            case 'n': opt.threads = atoi(optarg); break;
+            case 'd': opt.duration = atoi(optarg); break;
+            case 'm':
+                opt.mode = MODE_COUNT;
+                for (int i = 0; i < MODE_COUNT; i++) {
+                    if (strcmp(optarg, mode_names[i]) == 0) opt.mode = (load_mode_t)i;
+                }
+                if (opt.mode == MODE_COUNT) {
+                    usage(argv[0]);
+                    return 1;
+                }
+                break;
+            case 'l': opt.latency_us = atoi(optarg); break;
+            case 'j': opt.jitter_us = atoi(optarg); break;
+            case 's': opt.payload_size = atoi(optarg); break;
+            case 'f': opt.config_file = optarg; break;
+            default:
+                usage(argv[0]);
+                return 1;
+        }
+    }
+    if (opt.threads <= 0 || opt.duration <= 0) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    curl_global_init(CURL_GLOBAL_DEFAULT);
+
+    app_config_t file_config;
+    mock_vault_t *server = NULL;
+    if (opt.config_file) {
+        if (load_config(opt.config_file, &file_config) != 0) return 1;
+    } else {
+        mock_vault_options_t server_options;
+        mock_vault_default_options(&server_options);
+        server_options.token_ttl = 3600;
+        server_options.latency_us = opt.latency_us;
+        server_options.latency_jitter_us = opt.jitter_us;
+        server_options.payload_size = opt.payload_size;
+        server = mock_vault_start(&server_options);
+        if (!server) return 1;
+    }
+
+    load_worker_t *workers = calloc(opt.threads, sizeof(load_worker_t));
+    pthread_t *threads = calloc(opt.threads, sizeof(pthread_t));
+    if (!workers || !threads) return 1;
+
+    // 클라이언트 로그 출력은 측정에 방해되므로 실행 중에는 버림
+    fflush(stdout);
+    int saved_stdout = dup(STDOUT_FILENO);
+    int devnull = open("/dev/null", O_WRONLY);
+    dup2(devnull, STDOUT_FILENO);
+
+    for (int i = 0; i < opt.threads; i++) {
+        if (opt.config_file) {
+            workers[i].config = file_config;
+        } else {
+            mock_config(&workers[i].config, mock_vault_port(server), i);
+        }
+        workers[i].mode = opt.mode;
+        vault_client_init(&workers[i].client, &workers[i].config);
+        pthread_create(&threads[i], NULL, worker_thread, &workers[i]);
+    }
+
+    // 모든 스레드 로그인 완료 후 측정 시작
+    struct timespec wait = {0, 10 * 1000 * 1000};
+    for (int i = 0; i < opt.threads; i++) {
+        while (__atomic_load_n(&workers[i].ready, __ATOMIC_ACQUIRE) == 0) {
+            nanosleep(&wait, NULL);
+        }
+    }
+
+    vault_metrics_snapshot_t *before = malloc(sizeof(vault_metrics_snapshot_t));
+    vault_metrics_snapshot_t *after = malloc(sizeof(vault_metrics_snapshot_t));
+    if (!before || !after) return 1;
+    vault_metrics_snapshot(before);
+    uint64_t started = vault_metrics_now_ns();
+    __atomic_store_n(&start_flag, 1, __ATOMIC_RELEASE);
+
+    sleep((unsigned int)opt.duration);
+    __atomic_store_n(&stop_flag, 1, __ATOMIC_RELEASE);
+
+    int failed_logins = 0;
+    size_t total = 0;
+    long errors = 0;
+    for (int i = 0; i < opt.threads; i++) {
+        pthread_join(threads[i], NULL);
+        if (workers[i].ready < 0) failed_logins++;
+        total += workers[i].count;
+        errors += workers[i].errors;
+    }
+    double elapsed = (double)(vault_metrics_now_ns() - started) / 1e9;
+    vault_metrics_snapshot(after);
+
+    fflush(stdout);
+    dup2(saved_stdout, STDOUT_FILENO);
+    close(devnull);
+
+    // 지연 시간 합치기
+    uint32_t *all = malloc((total ? total : 1) * sizeof(uint32_t));
+    if (!all) return 1;
+    size_t offset = 0;
+    for (int i = 0; i < opt.threads; i++) {
+        memcpy(all + offset, workers[i].latencies, workers[i].count * sizeof(uint32_t));
+        offset += workers[i].count;
+    }
+    qsort(all, total, sizeof(uint32_t), compare_u32);
+
+    // 측정 구간의 Vault 요청 수 (로그인 제외)
+    uint64_t vault_requests = 0;
+    for (int e = 0; e < VAULT_ENDPOINT_COUNT; e++) {
+        if (e == VAULT_ENDPOINT_LOGIN) continue;
+        vault_requests += after->endpoints[e].requests - before->endpoints[e].requests;
+    }
+
+    printf("=== Vault Client Load Generator ===\n");
+    if (opt.config_file) {
+        printf("target=%s mode=%s threads=%d duration=%ds\n", file_config.vault_url,
+               mode_names[opt.mode], opt.threads, opt.duration);
+    } else {
+        printf("target=mock (latency %dus +0~%dus, payload %dB) mode=%s threads=%d duration=%ds\n",
+               opt.latency_us, opt.jitter_us, opt.payload_size, mode_names[opt.mode], opt.threads, opt.duration);
+    }
+    if (failed_logins > 0) {
+        printf("WARNING: %d threads failed to log in\n", failed_logins);
+    }
+    printf("\n%10s %8s %12s %9s %9s %9s %9s %10s\n", "reads", "errors", "reads/s",
+           "p50_us", "p99_us", "p999_us", "max_us", "req/read");
+    printf("%10zu %8ld %12.1f %9u %9u %9u %9u %10.3f\n", total, errors, total / elapsed,
+           percentile(all, total, 0.50), percentile(all, total, 0.99), percentile(all, total, 0.999),
+           total ? all[total - 1] : 0, total ? (double)vault_requests / total : 0.0);
+
+    printf("\nVault requests by endpoint:\n");
+    for (int e = 0; e < VAULT_ENDPOINT_COUNT; e++) {
+        uint64_t requests = after->endpoints[e].requests - before->endpoints[e].requests;
+        if (requests == 0) continue;
+        printf("  %-14s %10llu (p50 %lluus, p99 %lluus)\n", vault_metrics_endpoint_name((vault_endpoint_t)e),
+               (unsigned long long)requests, (unsigned long long)after->endpoints[e].p50_us,
+               (unsigned long long)after->endpoints[e].p99_us);
+    }
+
+    if (server) {
+        mock_vault_stats_t stats;
+        mock_vault_get_stats(server, &stats);
+        printf("\nMock server: requests=%ld kv_reads=%ld db_creds=%ld db_static_reads=%ld "
+               "lease_lookups=%ld bytes_sent=%ld\n", stats.requests, stats.kv_reads, stats.db_creds,
+               stats.db_static_reads, stats.lease_lookups, stats.bytes_sent);
+    }
+
+    for (int i = 0; i < opt.threads; i++) {
+        vault_client_cleanup(&workers[i].client);
+        free(workers[i].latencies);
+    }
+    mock_vault_stop(server);
+    free(all);
+    free(before);
+    free(after);
+    free(workers);
+    free(threads);
+    curl_global_cleanup();
+    return 0;
+}
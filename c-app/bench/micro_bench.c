@@ -0,0 +1,399 @@
+// vault_client.c 핫 패스 마이크로벤치마크
+// - write_callback: 응답 본문 누적 (curl 기본 청크 16KB 단위)
+// - json_parse: json_tokener_parse + json_object_object_get_ex 추출 (KV v2 문서 1KB ~ 1MB)
+// - stream_parse: 스트리밍 모드 write_callback (청크를 바로 파서에 넣음, 본문 버퍼 없음) + 추출
+// - cache_read: 캐시 조회 경로 (vault_get_kv_secret, vault_get_db_static_secret)
+// - header: X-Vault-Token 헤더 구성 (토큰 획득 + snprintf + curl_slist)
+// - request: 요청 준비 비용 (매 요청 URL/헤더 구성 vs 시크릿별 템플릿 + 토큰별 헤더 목록)
+// - log: 비동기 로거 호출 비용 (비활성 레벨, 활성 레벨) 및 printf 비교
+//
+// 각 항목은 ns/op, allocs/op, bytes/op를 출력합니다. -f json은 한 줄에 하나의 JSON 객체를 출력하여
+// 릴리스 간 결과를 diff 할 수 있습니다.
+// 할당 집계는 glibc에서만 지원합니다 (그 외 플랫폼은 -1로 표시).
+//
+// 사용법: ./micro-bench [-t seconds_per_bench] [-f text|json] [-b name_filter]
+#define _POSIX_C_SOURCE 200809L
+
+// static 함수(write_callback 등)에 접근하기 위해 구현 파일을 직접 포함
+#include "../src/vault_client.c"
+#include "mock_vault.h"
+#include <fcntl.h>
+
+// ---------------------------------------------------------------------------
+// 할당 집계 (malloc 계열 함수 가로채기)
+// ---------------------------------------------------------------------------
+static __thread uint64_t alloc_count = 0;
+static __thread uint64_t alloc_bytes = 0;
+
+#ifdef __GLIBC__
+#define ALLOC_COUNTING 1
+extern void *__libc_malloc(size_t size);
+extern void *__libc_calloc(size_t nmemb, size_t size);
+extern void *__libc_realloc(void *ptr, size_t size);
+extern void __libc_free(void *ptr);
+
+void *malloc(size_t size) {
+    alloc_count++;
+    alloc_bytes += size;
+    return __libc_malloc(size);
+}
+
+void *calloc(size_t nmemb, size_t size) {
+    alloc_count++;
+    alloc_bytes += nmemb * size;
+    return __libc_calloc(nmemb, size);
+}
+
+void *realloc(void *ptr, size_t size) {
+    alloc_count++;
+    alloc_bytes += size;
+    return __libc_realloc(ptr, size);
+}
+
+void free(void *ptr) {
+    __libc_free(ptr);
+}
+#else
+#define ALLOC_COUNTING 0
+#endif
+
+// ---------------------------------------------------------------------------
+// 측정 프레임워크
+// ---------------------------------------------------------------------------
+typedef void (*bench_fn_t)(void *arg, uint64_t iterations);
+
+typedef struct {
+    double min_seconds;
+    int json_output;
+    const char *filter;
+} bench_options_t;
+
+static bench_options_t options = {0.5, 0, NULL};
+static FILE *report = NULL;  // 측정 중 stdout은 /dev/null로 돌리므로 결과는 별도 스트림에 출력
+
+// 반복 횟수를 늘려가며 최소 측정 시간을 채운 뒤 결과 출력
+static void run_bench(const char *name, bench_fn_t fn, void *arg) {
+    if (options.filter && !strstr(name, options.filter)) return;
+
+    fn(arg, 1);  // 예열
+
+    uint64_t iterations = 1;
+    uint64_t elapsed = 0, allocs = 0, bytes = 0;
+    for (;;) {
+        uint64_t count_before = alloc_count, bytes_before = alloc_bytes;
+        uint64_t start = vault_metrics_now_ns();
+        fn(arg, iterations);
+        elapsed = vault_metrics_now_ns() - start;
+        allocs = alloc_count - count_before;
+        bytes = alloc_bytes - bytes_before;
+
+        if (elapsed >= options.min_seconds * 1e9 || iterations >= (1ULL << 40)) break;
+        // 목표 시간에 맞게 반복 횟수 추정 (최대 100배씩 증가)
+        double scale = elapsed > 0 ? options.min_seconds * 1e9 * 1.2 / elapsed : 100.0;
+        if (scale > 100.0) scale = 100.0;
+        if (scale < 2.0) scale = 2.0;
+        iterations = (uint64_t)(iterations * scale);
+    }
+
+    double ns_per_op = (double)elapsed / iterations;
+    double allocs_per_op = ALLOC_COUNTING ? (double)allocs / iterations : -1.0;
+    double bytes_per_op = ALLOC_COUNTING ? (double)bytes / iterations : -1.0;
+
+    if (options.json_output) {
+        fprintf(report, "{\"name\":\"%s\",\"iterations\":%llu,\"ns_per_op\":%.1f,"
+                        "\"allocs_per_op\":%.2f,\"bytes_per_op\":%.1f}\n",
+                name, (unsigned long long)iterations, ns_per_op, allocs_per_op, bytes_per_op);
+    } else {
+        fprintf(report, "%-36s %12llu %14.1f %12.2f %14.1f\n", name, (unsigned long long)iterations,
+                ns_per_op, allocs_per_op, bytes_per_op);
+    }
+    fflush(report);
+}
+
+// ---------------------------------------------------------------------------
+// 테스트 데이터
+// ---------------------------------------------------------------------------
+
+// 대략 target 바이트 크기의 KV v2 읽기 응답 생성
+static char *make_kv_document(size_t target) {
+    char *doc = malloc(target + 1024);
+    if (!doc) return NULL;
+
+    size_t len = (size_t)sprintf(doc, "{\"request_id\":\"8c4f3e0a-6b2d-4a52-9d0e-0f5b7c1e2a11\","
+                                      "\"lease_id\":\"\",\"renewable\":false,\"lease_duration\":0,"
+                                      "\"data\":{\"data\":{");
+    for (int i = 0; len + 160 < target; i++) {
+        len += (size_t)sprintf(doc + len, "%s\"key_%04d\":\"%064d\"", i ? "," : "", i, i);
+    }
+    len += (size_t)sprintf(doc + len, "},\"metadata\":{\"created_time\":\"2024-01-01T00:00:00.000000Z\","
+                                      "\"custom_metadata\":null,\"deletion_time\":\"\",\"destroyed\":false,"
+                                      "\"version\":7}},\"wrap_info\":null,\"warnings\":null,\"auth\":null}");
+    doc[len] = '\0';
+    return doc;
+}
+
+// ---------------------------------------------------------------------------
+// 벤치마크 항목
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    const char *body;
+    size_t size;
+} body_arg_t;
+
+// 응답 본문을 16KB 청크로 받아 누적 (CURL_MAX_WRITE_SIZE 기본값)
+static void bench_write_callback(void *arg, uint64_t iterations) {
+    body_arg_t *body = (body_arg_t *)arg;
+    const size_t chunk = 16384;
+    for (uint64_t i = 0; i < iterations; i++) {
+        struct http_response response = {0};
+        for (size_t offset = 0; offset < body->size; offset += chunk) {
+            size_t n = body->size - offset < chunk ? body->size - offset : chunk;
+            write_callback((void *)(body->body + offset), 1, n, &response);
+        }
+        free(response.data);
+    }
+}
+
+// KV 응답 파싱 후 vault_refresh_kv_secret / vault_get_secret과 같은 추출 체인 수행
+static void bench_json_parse(void *arg, uint64_t iterations) {
+    body_arg_t *body = (body_arg_t *)arg;
+    volatile int sink = 0;
+    for (uint64_t i = 0; i < iterations; i++) {
+        json_object *json_response = json_tokener_parse(body->body);
+        json_object *data, *data_obj, *metadata, *version_obj;
+        if (json_object_object_get_ex(json_response, "data", &data) &&
+            json_object_object_get_ex(data, "data", &data_obj) &&
+            json_object_object_get_ex(data, "metadata", &metadata) &&
+            json_object_object_get_ex(metadata, "version", &version_obj)) {
+            sink += json_object_get_int(version_obj);
+        }
+        json_object_put(json_response);
+    }
+    (void)sink;
+}
+
+// KV 조회 경로의 스트리밍 파싱: 16KB 청크를 누적 없이 파서에 넣고 같은 추출 체인 수행
+// (write_callback + json_parse_extract 합계와 비교)
+static void bench_stream_parse(void *arg, uint64_t iterations) {
+    body_arg_t *body = (body_arg_t *)arg;
+    const size_t chunk = 16384;
+    volatile int sink = 0;
+    struct http_response response = {0};
+    response.tokener = json_tokener_new();
+    for (uint64_t i = 0; i < iterations; i++) {
+        json_tokener_reset(response.tokener);
+        response.streaming = 1;
+        for (size_t offset = 0; offset < body->size; offset += chunk) {
+            size_t n = body->size - offset < chunk ? body->size - offset : chunk;
+            write_callback((void *)(body->body + offset), 1, n, &response);
+        }
+        json_object *json_response = vault_response_json(&response);
+        json_object *data, *data_obj, *metadata, *version_obj;
+        if (json_object_object_get_ex(json_response, "data", &data) &&
+            json_object_object_get_ex(data, "data", &data_obj) &&
+            json_object_object_get_ex(data, "metadata", &metadata) &&
+            json_object_object_get_ex(metadata, "version", &version_obj)) {
+            sink += json_object_get_int(version_obj);
+        }
+        json_object_put(json_response);
+    }
+    vault_response_free(&response);
+    (void)sink;
+}
+
+static void bench_kv_cache_read(void *arg, uint64_t iterations) {
+    vault_client_t *client = (vault_client_t *)arg;
+    for (uint64_t i = 0; i < iterations; i++) {
+        json_object *secret = NULL;
+        if (vault_get_kv_secret(client, &secret) == 0) {
+            vault_cleanup_secret(secret);
+        }
+    }
+}
+
+static void bench_db_static_cache_read(void *arg, uint64_t iterations) {
+    vault_client_t *client = (vault_client_t *)arg;
+    for (uint64_t i = 0; i < iterations; i++) {
+        json_object *secret = NULL;
+        if (vault_get_db_static_secret(client, &secret) == 0) {
+            vault_cleanup_secret(secret);
+        }
+    }
+}
+
+// 각 *_direct 함수의 헤더 구성 부분과 동일
+static void bench_header(void *arg, uint64_t iterations) {
+    vault_client_t *client = (vault_client_t *)arg;
+    for (uint64_t i = 0; i < iterations; i++) {
+        vault_token_t *token = vault_token_acquire(client);
+        if (!token) return;
+        char auth_header[1024];
+        snprintf(auth_header, sizeof(auth_header), "X-Vault-Token: %s", token->token);
+        struct curl_slist *headers = NULL;
+        headers = curl_slist_append(headers, auth_header);
+        headers = curl_slist_append(headers, "Content-Type: application/json");
+        curl_slist_free_all(headers);
+        vault_token_release(token);
+    }
+}
+
+// 요청 준비: 매 요청 URL/헤더 구성 (템플릿 도입 전 *_direct 함수와 동일, 요청 실행 제외)
+static void bench_request_legacy(void *arg, uint64_t iterations) {
+    vault_client_t *client = (vault_client_t *)arg;
+    for (uint64_t i = 0; i < iterations; i++) {
+        vault_token_t *token = vault_token_acquire(client);
+        if (!token) return;
+        struct http_response *response = NULL;
+        CURL *curl = vault_request_begin(client, &response);
+        if (!curl) {
+            vault_token_release(token);
+            return;
+        }
+        curl_easy_setopt(curl, CURLOPT_HTTPGET, 1L);
+        vault_request_stream(client, curl, response);
+        char url[sizeof(client->kv_request.url)];
+        snprintf(url, sizeof(url), "%s/v1/%s", client->vault_url, client->kv_path);
+        curl_easy_setopt(curl, CURLOPT_URL, url);
+        struct curl_slist *headers = vault_request_headers(client, token->token);
+        curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
+        curl_easy_setopt(curl, CURLOPT_HTTPHEADER, NULL);
+        curl_slist_free_all(headers);
+        vault_token_release(token);
+    }
+}
+
+// 요청 준비: 시크릿별 템플릿 + 토큰 레코드의 헤더 목록 (현재 vault_get_kv_secret_direct)
+static void bench_request_template(void *arg, uint64_t iterations) {
+    vault_client_t *client = (vault_client_t *)arg;
+    for (uint64_t i = 0; i < iterations; i++) {
+        vault_token_t *token = vault_token_acquire(client);
+        if (!token) return;
+        struct http_response *response = NULL;
+        CURL *curl = vault_request_begin_template(client, &client->kv_request, token, &response);
+        vault_token_release(token);
+        if (!curl) return;
+    }
+}
+
+static void bench_token_acquire(void *arg, uint64_t iterations) {
+    vault_client_t *client = (vault_client_t *)arg;
+    for (uint64_t i = 0; i < iterations; i++) {
+        vault_token_release(vault_token_acquire(client));
+    }
+}
+
+// 로거 (출력 스레드가 따라오지 못하면 버리므로 포화 시 버림 비용 포함)
+static void bench_log_disabled(void *arg, uint64_t iterations) {
+    (void)arg;
+    for (uint64_t i = 0; i < iterations; i++) {
+        VAULT_LOG_DEBUG("Token renewed successfully. New expiry: %d seconds (next renewal in %ld seconds)", 3600, (long)i);
+    }
+}
+
+static void bench_log_enabled(void *arg, uint64_t iterations) {
+    (void)arg;
+    for (uint64_t i = 0; i < iterations; i++) {
+        VAULT_LOG_INFO("Token renewed successfully. New expiry: %d seconds (next renewal in %ld seconds)", 3600, (long)i);
+    }
+}
+
+static void bench_log_printf(void *arg, uint64_t iterations) {
+    (void)arg;
+    for (uint64_t i = 0; i < iterations; i++) {
+        printf("Token renewed successfully. New expiry: %d seconds (next renewal in %ld seconds)\n", 3600, (long)i);
+    }
+}
+
+int main(int argc, char *argv[]) {
+    int c;
+    while ((c = getopt(argc, argv, "t:f:b:")) != -1) {
+        switch (c) {
+            case 't': options.min_seconds = atof(optarg); break;
+            case 'f': options.json_output = strcmp(optarg, "json") == 0; break;
+            case 'b': options.filter = optarg; break;
+            default:
+                fprintf(stderr, "Usage: %s [-t seconds_per_bench] [-f text|json] [-b name_filter]\n", argv[0]);
+                return 1;
+        }
+    }
+
+    curl_global_init(CURL_GLOBAL_DEFAULT);
+
+    // 클라이언트 로그는 버리고 결과만 원래 stdout으로 출력
+    fflush(stdout);
+    report = fdopen(dup(STDOUT_FILENO), "w");
+    int devnull = open("/dev/null", O_WRONLY);
+    dup2(devnull, STDOUT_FILENO);
+    close(devnull);
+
+    if (!options.json_output) {
+        fprintf(report, "%-36s %12s %14s %12s %14s\n", "benchmark", "iterations", "ns/op", "allocs/op", "bytes/op");
+    }
+
+    const size_t sizes[] = {1024, 16 * 1024, 256 * 1024, 1024 * 1024};
+    const char *size_names[] = {"1KB", "16KB", "256KB", "1MB"};
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        char *doc = make_kv_document(sizes[i]);
+        if (!doc) return 1;
+        body_arg_t body = {doc, strlen(doc)};
+        char name[64];
+
+        snprintf(name, sizeof(name), "write_callback/%s", size_names[i]);
+        run_bench(name, bench_write_callback, &body);
+        snprintf(name, sizeof(name), "json_parse_extract/%s", size_names[i]);
+        run_bench(name, bench_json_parse, &body);
+        snprintf(name, sizeof(name), "stream_parse/%s", size_names[i]);
+        run_bench(name, bench_stream_parse, &body);
+        free(doc);
+    }
+
+    // 캐시/헤더 경로는 내장 Vault 대역 서버에 로그인한 클라이언트로 측정
+    mock_vault_options_t server_options;
+    mock_vault_default_options(&server_options);
+    server_options.token_ttl = 3600;
+    server_options.payload_size = 1024;
+    mock_vault_t *server = mock_vault_start(&server_options);
+    if (!server) return 1;
+
+    app_config_t config;
+    memset(&config, 0, sizeof(config));
+    snprintf(config.vault_url, sizeof(config.vault_url), "http://127.0.0.1:%d", mock_vault_port(server));
+    snprintf(config.entity, sizeof(config.entity), "bench");
+    snprintf(config.token_type, sizeof(config.token_type), "service");
+    config.secret_kv.enabled = 1;
+    snprintf(config.secret_kv.kv_path, sizeof(config.secret_kv.kv_path), "database");
+    config.secret_kv.refresh_interval = DEFAULT_KV_REFRESH_INTERVAL;
+    config.secret_database_static.enabled = 1;
+    snprintf(config.secret_database_static.role_id, sizeof(config.secret_database_static.role_id), "db-demo-static");
+    config.http_timeout = 5;
+    config.schedule.renew_window_min = DEFAULT_RENEW_WINDOW_MIN;
+    config.schedule.renew_window_max = DEFAULT_RENEW_WINDOW_MAX;
+
+    vault_client_t client;
+    vault_client_init(&client, &config);
+    if (vault_login(&client, "role", "secret") != 0) {
+        fprintf(stderr, "Login to mock Vault failed\n");
+        return 1;
+    }
+
+    // KV는 현재 항상 버전을 재확인하므로 캐시가 있어도 Vault 요청이 발생 (대역 서버 왕복 포함)
+    run_bench("cache_read/kv_warm", bench_kv_cache_read, &client);
+    run_bench("cache_read/db_static_warm", bench_db_static_cache_read, &client);
+    run_bench("header/x_vault_token", bench_header, &client);
+    run_bench("token/acquire_release", bench_token_acquire, &client);
+    run_bench("request/legacy", bench_request_legacy, &client);
+    run_bench("request/template", bench_request_template, &client);
+
+    vault_log_start(VAULT_LOG_INFO, "/dev/null");
+    run_bench("log/disabled_level", bench_log_disabled, NULL);
+    run_bench("log/enabled", bench_log_enabled, NULL);
+    run_bench("log/printf_baseline", bench_log_printf, NULL);
+    vault_log_stop();
+
+    vault_client_cleanup(&client);
+    mock_vault_stop(server);
+    curl_global_cleanup();
+    fclose(report);
+    return 0;
+}
@@ -0,0 +1,1153 @@
+#define _POSIX_C_SOURCE 200809L
+#include "mock_vault.h"
+#include "../src/vault_ws.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <unistd.h>
+#include <signal.h>
+#include <pthread.h>
+#include <time.h>
+#include <openssl/evp.h>
+#include <openssl/pem.h>
+#include <openssl/x509.h>
+#include <zlib.h>
+#include <zstd.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+
+#define MOCK_MAX_REQUEST (256 * 1024)  // Transit batch_input 본문 포함
+#define MOCK_MAX_EVENT_STREAMS 64
+#define MOCK_MAX_KV_PATHS 8
+#define MOCK_MAX_KEY_BUMPS 64
+#define MOCK_EVENT_TYPE "kv-v2/data-write"
+#define MOCK_ZSTD_LEVEL 3  // zstd 기본 압축 수준
+
+// 응답 압축 방식 (요청의 Accept-Encoding에서 고름)
+enum { MOCK_ENCODING_IDENTITY, MOCK_ENCODING_GZIP, MOCK_ENCODING_ZSTD };
+
+// 처리 중인 요청이 허용한 압축 방식 (연결마다 스레드 하나이므로 스레드별로 둠)
+static __thread int response_encoding;
+
+struct mock_vault {
+    mock_vault_options_t options;
+    int listen_fd;
+    int port;
+    int stopping;  // 원자적 접근
+    pthread_t accept_thread;
+    pthread_mutex_t lock;
+    pthread_cond_t slot_free;  // capacity 자리 반납 (lock과 함께 사용)
+    int active;                // 처리 중인 요청 수 (capacity 제한)
+    int queued;                // capacity 대기열 길이
+
+    // service 토큰 저장소 (토큰 번호 -> 최초 발급 시각)
+    time_t *service_tokens;
+    long service_token_count;
+    long service_token_capacity;
+
+    time_t started;
+    int kv_version_bumps;  // mock_vault_bump_kv_version() 호출 수
+    long lease_seq;        // 발급한 Database Dynamic lease 수
+    char *payload;         // 시크릿 응답에 넣을 payload 문자열
+
+    // 이벤트 구독 (WebSocket 연결, 이벤트를 보낼 KV 경로)
+    int event_fds[MOCK_MAX_EVENT_STREAMS];
+    int event_fd_count;
+    char kv_paths[MOCK_MAX_KV_PATHS][256];
+    int kv_path_count;
+    int published_version;  // 마지막으로 이벤트를 보낸 KV 버전
+    char key_bumps[MOCK_MAX_KEY_BUMPS][256];  // mock_vault_bump_kv_key()로 버전을 올린 키 (마운트 이후 경로)
+    int key_bump_count;
+    pthread_t event_thread;
+    int event_thread_started;
+
+    mock_vault_stats_t stats;
+};
+
+// 요청 정보
+typedef struct {
+    char method[16];
+    char path[1024];
+    char query[256];
+    char token[512];
+    char ws_key[64];  // Sec-WebSocket-Key (업그레이드 요청)
+    char ns[128];     // X-Vault-Namespace
+    int encoding;     // Accept-Encoding에서 고른 압축 방식
+    char *body;
+    size_t body_len;
+} mock_request_t;
+
+typedef struct {
+    mock_vault_t *server;
+    int fd;
+} mock_connection_t;
+
+void mock_vault_default_options(mock_vault_options_t *options) {
+    options->port = 0;
+    options->token_ttl = 60;
+    options->token_max_ttl = 3600;
+    options->batch_tokens = 0;
+    options->latency_us = 0;
+    options->latency_jitter_us = 0;
+    options->payload_size = 64;
+    options->kv_update_interval = 0;
+    options->lease_ttl = 3600;
+    options->rotation_period = 86400;
+    options->events = 1;
+    options->kv_list_fanout = 4;
+    options->kv_list_depth = 2;
+    options->transit_item_us = 0;
+    options->pki_max_ttl = 3600;
+    options->pki_issue_us = 0;
+    options->capacity = 0;
+    options->overload_queue = 0;
+    options->compress_min = 0;
+    options->payload_random = 0;
+}
+
+static int send_all(int fd, const char *data, size_t len) {
+    while (len > 0) {
+        ssize_t n = send(fd, data, len, 0);
+        if (n <= 0) return -1;
+        data += n;
+        len -= (size_t)n;
+    }
+    return 0;
+}
+
+// 응답 본문 압축 (성공하면 *out에 할당한 버퍼와 압축된 길이, 실패하면 0)
+static size_t compress_body(int encoding, const char *body, size_t len, char **out) {
+    char *buffer = NULL;
+    size_t n = 0;
+    if (encoding == MOCK_ENCODING_ZSTD) {
+        size_t bound = ZSTD_compressBound(len);
+        buffer = malloc(bound);
+        if (!buffer) return 0;
+        n = ZSTD_compress(buffer, bound, body, len, MOCK_ZSTD_LEVEL);
+        if (ZSTD_isError(n)) n = 0;
+    } else {
+        z_stream stream;
+        memset(&stream, 0, sizeof(stream));
+        // windowBits 15 + 16: gzip 헤더/트레일러
+        if (deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK) return 0;
+        size_t bound = deflateBound(&stream, (uLong)len);
+        buffer = malloc(bound);
+        if (buffer) {
+            stream.next_in = (Bytef *)body;
+            stream.avail_in = (uInt)len;
+            stream.next_out = (Bytef *)buffer;
+            stream.avail_out = (uInt)bound;
+            if (deflate(&stream, Z_FINISH) == Z_STREAM_END) n = stream.total_out;
+        }
+        deflateEnd(&stream);
+    }
+    if (n == 0) {
+        free(buffer);
+        return 0;
+    }
+    *out = buffer;
+    return n;
+}
+
+static int send_response(mock_vault_t *server, int fd, int status, const char *body) {
+    const char *reason = status == 200 ? "OK" : status == 204 ? "No Content" : status == 400 ? "Bad Request" :
+                         status == 403 ? "Forbidden" : status == 404 ? "Not Found" : status == 503 ? "Service Unavailable" : "Error";
+    char header[256];
+    size_t raw_len = strlen(body);
+    size_t body_len = raw_len;
+    char *compressed = NULL;
+    long compress_us = 0;
+
+    int encoding = response_encoding;
+    if (encoding != MOCK_ENCODING_IDENTITY && server->options.compress_min > 0 &&
+        raw_len >= (size_t)server->options.compress_min) {
+        struct timespec start, end;
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &start);
+        size_t n = compress_body(encoding, body, raw_len, &compressed);
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &end);
+        compress_us = (end.tv_sec - start.tv_sec) * 1000000L + (end.tv_nsec - start.tv_nsec) / 1000;
+        if (n > 0) {
+            body = compressed;
+            body_len = n;
+        }
+    }
+    const char *content_encoding = !compressed ? "" : encoding == MOCK_ENCODING_ZSTD ?
+                                   "Content-Encoding: zstd\r\n" : "Content-Encoding: gzip\r\n";
+    int n = snprintf(header, sizeof(header),
+                     "HTTP/1.1 %d %s\r\nContent-Type: application/json\r\n%sContent-Length: %zu\r\n\r\n",
+                     status, reason, content_encoding, body_len);
+
+    pthread_mutex_lock(&server->lock);
+    server->stats.bytes_sent += (long)body_len;
+    server->stats.bytes_raw += (long)raw_len;
+    if (compressed) server->stats.compressed++;
+    server->stats.compress_us += compress_us;
+    pthread_mutex_unlock(&server->lock);
+
+    int rc = send_all(fd, header, (size_t)n) == 0 ? send_all(fd, body, body_len) : -1;
+    free(compressed);
+    return rc;
+}
+
+static void format_time(time_t t, char *buffer, size_t size) {
+    struct tm tm;
+    gmtime_r(&t, &tm);
+    strftime(buffer, size, "%Y-%m-%dT%H:%M:%SZ", &tm);
+}
+
+// 현재 KV 버전 (자동 증가 간격 + 수동 증가)
+static int current_kv_version(mock_vault_t *server, time_t now) {
+    int version = 1 + server->kv_version_bumps;
+    if (server->options.kv_update_interval > 0) {
+        version += (int)((now - server->started) / server->options.kv_update_interval);
+    }
+    return version;
+}
+
+// 키별 KV 버전 (전체 버전 + 해당 키만 올린 횟수, 잠금 상태에서 호출)
+// path: /v1/<mount>/data/<key> 또는 /v1/<mount>/metadata/<key>
+static int key_kv_version(mock_vault_t *server, time_t now, const char *path) {
+    int version = current_kv_version(server, now);
+    const char *key = strstr(path, "/data/");
+    key = key ? key + 6 : (key = strstr(path, "/metadata/")) ? key + 10 : NULL;
+    for (int i = 0; key && i < server->key_bump_count; i++) {
+        if (strcmp(server->key_bumps[i], key) == 0) version++;
+    }
+    return version;
+}
+
+// 이벤트를 보낼 KV 경로 기록 (잠금 상태에서 호출)
+static void remember_kv_path(mock_vault_t *server, const char *path) {
+    for (int i = 0; i < server->kv_path_count; i++) {
+        if (strcmp(server->kv_paths[i], path) == 0) return;
+    }
+    if (server->kv_path_count < MOCK_MAX_KV_PATHS && strlen(path) < sizeof(server->kv_paths[0])) {
+        strcpy(server->kv_paths[server->kv_path_count++], path);
+    }
+}
+
+// <mount>/data/<name>
+static int handle_kv_data(mock_vault_t *server, const mock_request_t *request, int fd) {
+    time_t now = time(NULL);
+    char created[32];
+
+    pthread_mutex_lock(&server->lock);
+    server->stats.kv_reads++;
+    int version = key_kv_version(server, now, request->path);
+    remember_kv_path(server, request->path + 4);
+    pthread_mutex_unlock(&server->lock);
+
+    format_time(server->started, created, sizeof(created));
+    size_t size = strlen(server->payload) + 512;
+    char *body = malloc(size);
+    if (!body) return send_response(server, fd, 500, "{\"errors\":[\"out of memory\"]}");
+    snprintf(body, size,
+             "{\"request_id\":\"mock\",\"lease_id\":\"\",\"renewable\":false,\"lease_duration\":0,"
+             "\"data\":{\"data\":{\"api_key\":\"key-v%d\",\"payload\":\"%s\"},"
+             "\"metadata\":{\"created_time\":\"%s\",\"custom_metadata\":null,\"deletion_time\":\"\","
+             "\"destroyed\":false,\"version\":%d}},\"wrap_info\":null,\"warnings\":null,\"auth\":null}",
+             version, server->payload, created, version);
+    int rc = send_response(server, fd, 200, body);
+    free(body);
+    return rc;
+}
+
+// <mount>/metadata/<name>
+static int handle_kv_metadata(mock_vault_t *server, const mock_request_t *request, int fd) {
+    time_t now = time(NULL);
+    char created[32];
+    char body[1024];
+
+    pthread_mutex_lock(&server->lock);
+    server->stats.metadata_reads++;
+    int version = key_kv_version(server, now, request->path);
+    pthread_mutex_unlock(&server->lock);
+
+    format_time(server->started, created, sizeof(created));
+    snprintf(body, sizeof(body),
+             "{\"data\":{\"cas_required\":false,\"created_time\":\"%s\",\"current_version\":%d,"
+             "\"max_versions\":0,\"oldest_version\":1,\"updated_time\":\"%s\","
+             "\"versions\":{\"%d\":{\"created_time\":\"%s\",\"deletion_time\":\"\",\"destroyed\":false}}}}",
+             created, version, created, version, created);
+    return send_response(server, fd, 200, body);
+}
+
+// LIST <mount>/metadata/<folder>/: 폴더마다 key-0..N-1 키와, kv_list_depth보다 얕으면 dir-0..N-1/ 하위 폴더
+static int handle_kv_list(mock_vault_t *server, const mock_request_t *request, int fd) {
+    pthread_mutex_lock(&server->lock);
+    server->stats.lists++;
+    pthread_mutex_unlock(&server->lock);
+
+    // 폴더 깊이 = metadata/ 뒤의 경로 구간 수 (끝의 '/' 제외)
+    const char *folder = strstr(request->path, "/metadata/") + 10;
+    int depth = 0;
+    for (const char *p = folder; *p; p++) {
+        if (*p == '/' && p[1]) depth++;
+    }
+    if (*folder) depth++;
+
+    int fanout = server->options.kv_list_fanout;
+    size_t size = (size_t)fanout * 32 + 64;
+    char *body = malloc(size);
+    if (!body) return send_response(server, fd, 500, "{\"errors\":[\"out of memory\"]}");
+    size_t len = (size_t)snprintf(body, size, "{\"data\":{\"keys\":[");
+    for (int i = 0; i < fanout; i++) {
+        len += (size_t)snprintf(body + len, size - len, "%s\"key-%d\"", i ? "," : "", i);
+    }
+    for (int i = 0; depth < server->options.kv_list_depth && i < fanout; i++) {
+        len += (size_t)snprintf(body + len, size - len, ",\"dir-%d/\"", i);
+    }
+    snprintf(body + len, size - len, "]}}");
+    int rc = send_response(server, fd, 200, body);
+    free(body);
+    return rc;
+}
+
+// <mount>/creds/<role>: 요청마다 새 자격증명과 lease 발급
+static int handle_db_creds(mock_vault_t *server, const mock_request_t *request, int fd) {
+    time_t now = time(NULL);
+
+    pthread_mutex_lock(&server->lock);
+    server->stats.db_creds++;
+    server->stats.storage_writes += 2;  // 사용자 생성 + lease 엔트리
+    long seq = ++server->lease_seq;
+    pthread_mutex_unlock(&server->lock);
+
+    size_t size = strlen(server->payload) + strlen(request->path) + 512;
+    char *body = malloc(size);
+    if (!body) return send_response(server, fd, 500, "{\"errors\":[\"out of memory\"]}");
+    // lease ID 끝에 발급 시각을 넣어 lookup 시 저장소 없이 TTL 계산
+    snprintf(body, size,
+             "{\"request_id\":\"mock\",\"lease_id\":\"%s/%ld.%ld\",\"renewable\":true,\"lease_duration\":%d,"
+             "\"data\":{\"username\":\"v-approle-mock-%ld\",\"password\":\"pw-%ld\",\"payload\":\"%s\"},"
+             "\"wrap_info\":null,\"warnings\":null,\"auth\":null}",
+             request->path + 4, (long)now, seq, server->options.lease_ttl, seq, seq, server->payload);
+    int rc = send_response(server, fd, 200, body);
+    free(body);
+    return rc;
+}
+
+// <mount>/static-creds/<role>: rotation_period마다 비밀번호가 바뀜
+static int handle_db_static_creds(mock_vault_t *server, int fd) {
+    time_t now = time(NULL);
+    long period = server->options.rotation_period > 0 ? server->options.rotation_period : 86400;
+    long elapsed = (long)(now - server->started);
+    long rotation = elapsed / period;
+    long ttl = period - elapsed % period;
+    char rotated[32];
+
+    pthread_mutex_lock(&server->lock);
+    server->stats.db_static_reads++;
+    pthread_mutex_unlock(&server->lock);
+
+    format_time(server->started + rotation * period, rotated, sizeof(rotated));
+    size_t size = strlen(server->payload) + 512;
+    char *body = malloc(size);
+    if (!body) return send_response(server, fd, 500, "{\"errors\":[\"out of memory\"]}");
+    snprintf(body, size,
+             "{\"request_id\":\"mock\",\"lease_id\":\"\",\"renewable\":false,\"lease_duration\":0,"
+             "\"data\":{\"last_vault_rotation\":\"%s\",\"password\":\"static-pw-%ld\",\"rotation_period\":%ld,"
+             "\"ttl\":%ld,\"username\":\"static-user\",\"payload\":\"%s\"},"
+             "\"wrap_info\":null,\"warnings\":null,\"auth\":null}",
+             rotated, rotation, period, ttl, server->payload);
+    int rc = send_response(server, fd, 200, body);
+    free(body);
+    return rc;
+}
+
+// sys/leases/revoke: 폐기 수만 집계 (lookup은 lease ID의 발급 시각으로 계산하므로 영향 없음)
+static int handle_lease_revoke(mock_vault_t *server, const mock_request_t *request, int fd) {
+    if (!request->body || !strstr(request->body, "\"lease_id\"")) {
+        return send_response(server, fd, 400, "{\"errors\":[\"missing lease_id\"]}");
+    }
+    pthread_mutex_lock(&server->lock);
+    server->stats.lease_revocations++;
+    server->stats.storage_writes += 2;  // 사용자 삭제 + lease 엔트리 삭제
+    pthread_mutex_unlock(&server->lock);
+    return send_response(server, fd, 204, "");
+}
+
+// <mount>/encrypt/<key>, <mount>/decrypt/<key>
+// batch_input의 항목마다 암호화는 "vault:v1:" + base64 평문, 복호화는 접두사를 떼어 돌려줌
+// (항목 하나라도 실패하면 Vault처럼 400과 함께 항목별 결과)
+static int handle_transit(mock_vault_t *server, const mock_request_t *request, int fd, int encrypt) {
+    const char *field = encrypt ? "\"plaintext\":\"" : "\"ciphertext\":\"";
+    const char *body = request->body ? request->body : "";
+    int batch = strstr(body, "\"batch_input\"") != NULL;
+
+    size_t size = request->body_len * 4 + 256;  // 항목당 응답은 본문 항목(최소 16바이트 + 입력)의 4배를 넘지 않음
+    char *out = malloc(size);
+    if (!out) return send_response(server, fd, 500, "{\"errors\":[\"out of memory\"]}");
+    size_t used = (size_t)snprintf(out, size, batch ? "{\"data\":{\"batch_results\":[" : "{\"data\":");
+
+    long items = 0;
+    int failed = 0;
+    for (const char *p = strstr(body, field); p; p = strstr(p, field)) {
+        p += strlen(field);
+        const char *end = strchr(p, '"');
+        if (!end) break;
+        int len = (int)(end - p);
+        const char *sep = items++ ? "," : "";
+        if (encrypt) {
+            used += (size_t)snprintf(out + used, size - used, "%s{\"ciphertext\":\"vault:v1:%.*s\",\"key_version\":1}",
+                                     sep, len, p);
+        } else if (len > 9 && strncmp(p, "vault:v1:", 9) == 0) {
+            used += (size_t)snprintf(out + used, size - used, "%s{\"plaintext\":\"%.*s\"}", sep, len - 9, p + 9);
+        } else {
+            used += (size_t)snprintf(out + used, size - used, "%s{\"error\":\"invalid ciphertext\"}", sep);
+            failed++;
+        }
+        p = end;
+    }
+    snprintf(out + used, size - used, batch ? "]}}" : "}");
+
+    pthread_mutex_lock(&server->lock);
+    server->stats.transit_requests++;
+    server->stats.transit_items += items;
+    pthread_mutex_unlock(&server->lock);
+
+    // 항목 수에 비례하는 서버 처리 시간
+    long delay_us = (long)server->options.transit_item_us * items;
+    if (delay_us > 0) {
+        struct timespec ts = {delay_us / 1000000, (delay_us % 1000000) * 1000};
+        nanosleep(&ts, NULL);
+    }
+
+    int rc = items == 0 ? send_response(server, fd, 400, "{\"errors\":[\"missing input\"]}")
+                        : send_response(server, fd, failed ? 400 : 200, out);
+    free(out);
+    return rc;
+}
+
+// <mount>/datakey/plaintext/<key>
+// 요청마다 다른 32바이트 데이터 키를 만들어 base64 평문과 "vault:v1:" + 같은 base64 (감싼 키)로 돌려줌
+// (감싼 키는 handle_transit의 복호화로 다시 평문이 됨)
+static int handle_transit_datakey(mock_vault_t *server, int fd) {
+    static const char chars[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+    pthread_mutex_lock(&server->lock);
+    uint64_t seed = (uint64_t)++server->stats.transit_datakeys;
+    pthread_mutex_unlock(&server->lock);
+
+    unsigned char key[32];
+    for (size_t i = 0; i < sizeof(key); i += 8) {
+        // splitmix64
+        uint64_t z = (seed += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        z ^= z >> 31;
+        memcpy(key + i, &z, 8);
+    }
+    char encoded[48];
+    char *p = encoded;
+    for (size_t i = 0; i < sizeof(key); i += 3) {
+        uint32_t v = (uint32_t)key[i] << 16;
+        if (i + 1 < sizeof(key)) v |= (uint32_t)key[i + 1] << 8;
+        if (i + 2 < sizeof(key)) v |= key[i + 2];
+        *p++ = chars[(v >> 18) & 0x3F];
+        *p++ = chars[(v >> 12) & 0x3F];
+        *p++ = i + 1 < sizeof(key) ? chars[(v >> 6) & 0x3F] : '=';
+        *p++ = i + 2 < sizeof(key) ? chars[v & 0x3F] : '=';
+    }
+    *p = '\0';
+
+    char body[256];
+    snprintf(body, sizeof(body), "{\"data\":{\"plaintext\":\"%s\",\"ciphertext\":\"vault:v1:%s\",\"key_version\":1}}",
+             encoded, encoded);
+    return send_response(server, fd, 200, body);
+}
+
+// PEM 문자열을 JSON 문자열 값으로 이어 붙임 (줄바꿈 이스케이프)
+static size_t append_json_pem(char *out, size_t size, size_t used, const char *pem, size_t len) {
+    for (size_t i = 0; i < len && used + 3 < size; i++) {
+        if (pem[i] == '\n') {
+            out[used++] = '\\';
+            out[used++] = 'n';
+        } else {
+            out[used++] = pem[i];
+        }
+    }
+    out[used] = '\0';
+    return used;
+}
+
+// 요청 본문의 "ttl":"30s"/"5m"/"24h"/"3600" (없거나 해석할 수 없으면 0)
+static long parse_request_ttl(const char *body) {
+    const char *p = body ? strstr(body, "\"ttl\":\"") : NULL;
+    if (!p) return 0;
+    char *end;
+    long value = strtol(p + 7, &end, 10);
+    if (end == p + 7 || value <= 0) return 0;
+    if (*end == 'm') value *= 60;
+    else if (*end == 'h') value *= 3600;
+    return value;
+}
+
+// <mount>/issue/<role>
+// 요청마다 EC P-256 키를 만들어 자체 서명한 인증서를 돌려줌 (issuing_ca/ca_chain은 같은 인증서)
+// 유효 기간은 요청 ttl과 pki_max_ttl 중 짧은 값, NotBefore는 발급 시각
+static int handle_pki_issue(mock_vault_t *server, const mock_request_t *request, int fd) {
+    long ttl = parse_request_ttl(request->body);
+    if (ttl <= 0 || ttl > server->options.pki_max_ttl) ttl = server->options.pki_max_ttl;
+
+    pthread_mutex_lock(&server->lock);
+    long serial = ++server->stats.pki_issued;
+    pthread_mutex_unlock(&server->lock);
+
+    // 키 생성 시간 흉내
+    long delay_us = server->options.pki_issue_us;
+    if (delay_us > 0) {
+        struct timespec ts = {delay_us / 1000000, (delay_us % 1000000) * 1000};
+        nanosleep(&ts, NULL);
+    }
+
+    EVP_PKEY *pkey = NULL;
+    EVP_PKEY_CTX *kctx = EVP_PKEY_CTX_new_id(EVP_PKEY_EC, NULL);
+    X509 *cert = X509_new();
+    BIO *cert_bio = BIO_new(BIO_s_mem());
+    BIO *key_bio = BIO_new(BIO_s_mem());
+    char *out = NULL;
+    int ok = kctx && cert && cert_bio && key_bio && EVP_PKEY_keygen_init(kctx) == 1 &&
+             EVP_PKEY_CTX_set_ec_paramgen_curve_nid(kctx, NID_X9_62_prime256v1) == 1 &&
+             EVP_PKEY_keygen(kctx, &pkey) == 1;
+    if (ok) {
+        X509_set_version(cert, 2);
+        ASN1_INTEGER_set(X509_get_serialNumber(cert), serial);
+        X509_gmtime_adj(X509_getm_notBefore(cert), 0);
+        X509_gmtime_adj(X509_getm_notAfter(cert), ttl);
+        X509_NAME *name = X509_get_subject_name(cert);
+        X509_NAME_add_entry_by_txt(name, "CN", MBSTRING_ASC, (const unsigned char *)"mock.example.com", -1, -1, 0);
+        X509_set_issuer_name(cert, name);
+        ok = X509_set_pubkey(cert, pkey) == 1 && X509_sign(cert, pkey, EVP_sha256()) > 0 &&
+             PEM_write_bio_X509(cert_bio, cert) == 1 &&
+             PEM_write_bio_PrivateKey(key_bio, pkey, NULL, NULL, 0, NULL, NULL) == 1;
+    }
+
+    int rc;
+    char *cert_pem = NULL, *key_pem = NULL;
+    long cert_len = ok ? BIO_get_mem_data(cert_bio, &cert_pem) : 0;
+    long key_len = ok ? BIO_get_mem_data(key_bio, &key_pem) : 0;
+    size_t size = (size_t)(cert_len * 3 + key_len) * 2 + 512;
+    if (ok && (out = malloc(size)) != NULL) {
+        size_t used = (size_t)snprintf(out, size, "{\"data\":{\"certificate\":\"");
+        used = append_json_pem(out, size, used, cert_pem, (size_t)cert_len);
+        used += (size_t)snprintf(out + used, size - used, "\",\"issuing_ca\":\"");
+        used = append_json_pem(out, size, used, cert_pem, (size_t)cert_len);
+        used += (size_t)snprintf(out + used, size - used, "\",\"ca_chain\":[\"");
+        used = append_json_pem(out, size, used, cert_pem, (size_t)cert_len);
+        used += (size_t)snprintf(out + used, size - used, "\"],\"private_key\":\"");
+        used = append_json_pem(out, size, used, key_pem, (size_t)key_len);
+        snprintf(out + used, size - used,
+                 "\",\"private_key_type\":\"ec\",\"serial_number\":\"%02lx:%02lx\",\"expiration\":%ld}}",
+                 (serial >> 8) & 0xFF, serial & 0xFF, (long)time(NULL) + ttl);
+        rc = send_response(server, fd, 200, out);
+        memset(out, 0, size);
+        free(out);
+    } else {
+        rc = send_response(server, fd, 500, "{\"errors\":[\"certificate generation failed\"]}");
+    }
+    BIO_free(cert_bio);
+    BIO_free(key_bio);
+    X509_free(cert);
+    EVP_PKEY_free(pkey);
+    EVP_PKEY_CTX_free(kctx);
+    return rc;
+}
+
+// sys/leases/lookup
+static int handle_lease_lookup(mock_vault_t *server, const mock_request_t *request, int fd) {
+    char body[1024];
+    char lease_id[512] = "";
+    time_t now = time(NULL);
+
+    pthread_mutex_lock(&server->lock);
+    server->stats.lease_lookups++;
+    pthread_mutex_unlock(&server->lock);
+
+    // 요청 본문에서 lease_id 추출 ({"lease_id":"..."})
+    char *start = request->body ? strstr(request->body, "\"lease_id\"") : NULL;
+    start = start ? strchr(start + 10, '"') : NULL;
+    char *end = start ? strchr(start + 1, '"') : NULL;
+    if (!end || (size_t)(end - start - 1) >= sizeof(lease_id)) {
+        return send_response(server, fd, 400, "{\"errors\":[\"missing lease_id\"]}");
+    }
+    memcpy(lease_id, start + 1, (size_t)(end - start - 1));
+    lease_id[end - start - 1] = '\0';
+
+    char *issued_part = strrchr(lease_id, '/');
+    if (!issued_part) {
+        return send_response(server, fd, 400, "{\"errors\":[\"invalid lease id\"]}");
+    }
+    long ttl = atol(issued_part + 1) + server->options.lease_ttl - (long)now;
+    if (ttl <= 0) {
+        return send_response(server, fd, 400, "{\"errors\":[\"invalid lease\"]}");
+    }
+
+    snprintf(body, sizeof(body),
+             "{\"data\":{\"id\":\"%s\",\"renewable\":true,\"ttl\":%ld}}", lease_id, ttl);
+    return send_response(server, fd, 200, body);
+}
+
+// auth/approle/login
+static int handle_login(mock_vault_t *server, int fd) {
+    char body[512];
+    time_t now = time(NULL);
+    int ttl = server->options.token_ttl;
+
+    pthread_mutex_lock(&server->lock);
+    server->stats.logins++;
+    if (server->options.batch_tokens) {
+        // batch 토큰: 만료 시각을 토큰 자체에 담고 저장하지 않음
+        pthread_mutex_unlock(&server->lock);
+        snprintf(body, sizeof(body),
+                 "{\"auth\":{\"client_token\":\"b.%ld\",\"lease_duration\":%d,"
+                 "\"renewable\":false,\"token_type\":\"batch\"}}", (long)(now + ttl), ttl);
+        return send_response(server, fd, 200, body);
+    }
+
+    // service 토큰: 토큰 엔트리 + lease 엔트리 저장
+    if (server->service_token_count == server->service_token_capacity) {
+        long capacity = server->service_token_capacity ? server->service_token_capacity * 2 : 64;
+        time_t *grown = realloc(server->service_tokens, sizeof(time_t) * capacity);
+        if (!grown) {
+            pthread_mutex_unlock(&server->lock);
+            return send_response(server, fd, 500, "{\"errors\":[\"out of memory\"]}");
+        }
+        server->service_tokens = grown;
+        server->service_token_capacity = capacity;
+    }
+    long id = server->service_token_count++;
+    server->service_tokens[id] = now;
+    server->stats.storage_writes += 2;
+    pthread_mutex_unlock(&server->lock);
+
+    snprintf(body, sizeof(body),
+             "{\"auth\":{\"client_token\":\"s.%ld\",\"lease_duration\":%d,"
+             "\"renewable\":true,\"token_type\":\"service\"}}", id, ttl);
+    return send_response(server, fd, 200, body);
+}
+
+// auth/token/renew-self
+static int handle_renew_self(mock_vault_t *server, const mock_request_t *request, int fd) {
+    char body[768];
+    time_t now = time(NULL);
+
+    pthread_mutex_lock(&server->lock);
+    if (request->token[0] == 'b') {
+        server->stats.renew_failures++;
+        pthread_mutex_unlock(&server->lock);
+        return send_response(server, fd, 400, "{\"errors\":[\"batch tokens cannot be renewed\"]}");
+    }
+
+    long id = request->token[0] == 's' ? atol(request->token + 2) : -1;
+    if (id < 0 || id >= server->service_token_count) {
+        server->stats.renew_failures++;
+        pthread_mutex_unlock(&server->lock);
+        return send_response(server, fd, 403, "{\"errors\":[\"permission denied\"]}");
+    }
+
+    // 최대 TTL을 넘겨 연장할 수 없음
+    long remaining_max = (long)(server->service_tokens[id] + server->options.token_max_ttl - now);
+    long lease = server->options.token_ttl < remaining_max ? server->options.token_ttl : remaining_max;
+    if (lease <= 0) {
+        server->stats.renew_failures++;
+        pthread_mutex_unlock(&server->lock);
+        return send_response(server, fd, 403, "{\"errors\":[\"token reached max TTL\"]}");
+    }
+    server->stats.renewals++;
+    server->stats.storage_writes += 1;  // lease 만료 시각 갱신
+    pthread_mutex_unlock(&server->lock);
+
+    snprintf(body, sizeof(body),
+             "{\"auth\":{\"client_token\":\"%s\",\"lease_duration\":%ld,"
+             "\"renewable\":true,\"token_type\":\"service\"}}", request->token, lease);
+    return send_response(server, fd, 200, body);
+}
+
+// 이벤트 스트림에 kv-v2/data-write 이벤트 전송 (잠금 상태에서 호출, 읽힌 KV 경로마다 1건)
+static void publish_kv_events(mock_vault_t *server, int version) {
+    struct timespec now;
+    clock_gettime(CLOCK_REALTIME, &now);
+    char timestamp[32];
+    format_time(now.tv_sec, timestamp, sizeof(timestamp));
+    timestamp[strlen(timestamp) - 1] = '\0';  // 'Z' 제거 후 나노초 추가
+
+    for (int p = 0; p < server->kv_path_count; p++) {
+        const char *path = server->kv_paths[p];
+        const char *data = strstr(path, "/data/");
+        int mount_len = data ? (int)(data - path) : 0;
+
+        char body[2048];
+        int len = snprintf(body, sizeof(body),
+                           "{\"id\":\"mock-%ld\",\"source\":\"vault://mock\",\"specversion\":\"1.0\","
+                           "\"type\":\"*\",\"data\":{\"event\":{\"id\":\"mock-%ld\",\"metadata\":{"
+                           "\"current_version\":\"%d\",\"data_path\":\"%s\",\"modified\":\"true\","
+                           "\"oldest_version\":\"0\",\"operation\":\"data-write\",\"path\":\"%s\"}},"
+                           "\"event_type\":\"" MOCK_EVENT_TYPE "\",\"plugin_info\":{\"mount_class\":\"secret\","
+                           "\"mount_path\":\"%.*s/\",\"plugin\":\"kv\",\"version\":\"2\"}},"
+                           "\"datacontentype\":\"application/cloudevents\",\"time\":\"%s.%09ldZ\"}",
+                           server->stats.events_sent + 1, server->stats.events_sent + 1, version, path, path,
+                           mount_len, path, timestamp, (long)now.tv_nsec);
+        if (len < 0 || (size_t)len >= sizeof(body)) continue;
+
+        uint8_t header[VAULT_WS_MAX_HEADER];
+        size_t header_len = vault_ws_encode_header(header, VAULT_WS_OP_TEXT, (uint64_t)len, NULL);
+        for (int i = 0; i < server->event_fd_count; i++) {
+            int fd = server->event_fds[i];
+            if (send_all(fd, (const char *)header, header_len) != 0 || send_all(fd, body, (size_t)len) != 0) {
+                shutdown(fd, SHUT_RDWR);  // 연결 스레드가 정리
+                continue;
+            }
+            server->stats.events_sent++;
+        }
+    }
+    server->published_version = version;
+}
+
+// kv_update_interval에 따른 자동 버전 증가를 이벤트로 전송
+static void *event_thread(void *arg) {
+    mock_vault_t *server = (mock_vault_t *)arg;
+    while (!__atomic_load_n(&server->stopping, __ATOMIC_ACQUIRE)) {
+        struct timespec ts = {0, 20 * 1000000L};
+        nanosleep(&ts, NULL);
+
+        pthread_mutex_lock(&server->lock);
+        int version = current_kv_version(server, time(NULL));
+        if (version != server->published_version) {
+            publish_kv_events(server, version);
+        }
+        pthread_mutex_unlock(&server->lock);
+    }
+    return NULL;
+}
+
+// sys/events/subscribe/kv-v2/data-write: WebSocket 업그레이드 후 연결이 끊길 때까지 유지
+static int handle_event_stream(mock_vault_t *server, const mock_request_t *request, int fd) {
+    char accept[VAULT_WS_ACCEPT_SIZE];
+    char response[256];
+    vault_ws_accept_key(request->ws_key, accept);
+    int n = snprintf(response, sizeof(response),
+                     "HTTP/1.1 101 Switching Protocols\r\nUpgrade: websocket\r\nConnection: Upgrade\r\n"
+                     "Sec-WebSocket-Accept: %s\r\n\r\n", accept);
+
+    pthread_mutex_lock(&server->lock);
+    if (server->event_fd_count >= MOCK_MAX_EVENT_STREAMS || send_all(fd, response, (size_t)n) != 0) {
+        pthread_mutex_unlock(&server->lock);
+        return -1;
+    }
+    server->event_fds[server->event_fd_count++] = fd;
+    server->stats.event_streams++;
+    if (server->published_version == 0) {
+        server->published_version = current_kv_version(server, time(NULL));
+    }
+    pthread_mutex_unlock(&server->lock);
+
+    // 클라이언트 프레임 처리 (close에 응답, 나머지는 무시)
+    uint8_t buffer[256];
+    size_t used = 0;
+    while (!__atomic_load_n(&server->stopping, __ATOMIC_ACQUIRE)) {
+        ssize_t got = recv(fd, buffer + used, sizeof(buffer) - used, 0);
+        if (got <= 0) break;
+        used += (size_t)got;
+
+        vault_ws_frame_t frame;
+        int header = vault_ws_decode_header(buffer, used, &frame);
+        if (header < 0 || (size_t)header + frame.length > sizeof(buffer)) break;
+        if (header == 0 || used < (size_t)header + frame.length) continue;
+        if (frame.opcode == VAULT_WS_OP_CLOSE) {
+            uint8_t close_frame[VAULT_WS_MAX_HEADER];
+            size_t close_len = vault_ws_encode_header(close_frame, VAULT_WS_OP_CLOSE, 0, NULL);
+            pthread_mutex_lock(&server->lock);
+            send_all(fd, (const char *)close_frame, close_len);
+            pthread_mutex_unlock(&server->lock);
+            break;
+        }
+        size_t consumed = (size_t)header + frame.length;
+        memmove(buffer, buffer + consumed, used - consumed);
+        used -= consumed;
+    }
+
+    pthread_mutex_lock(&server->lock);
+    for (int i = 0; i < server->event_fd_count; i++) {
+        if (server->event_fds[i] == fd) {
+            server->event_fds[i] = server->event_fds[--server->event_fd_count];
+            break;
+        }
+    }
+    pthread_mutex_unlock(&server->lock);
+    return -1;  // 연결 종료
+}
+
+// 설정된 지연 시간 적용 (서버 처리 시간 흉내)
+static void apply_latency(mock_vault_t *server, long seq) {
+    long delay_us = server->options.latency_us;
+    if (server->options.latency_jitter_us > 0) {
+        unsigned long x = (unsigned long)seq * 2654435761UL;
+        delay_us += (long)((x >> 8) % (unsigned long)(server->options.latency_jitter_us + 1));
+    }
+    if (delay_us > 0) {
+        struct timespec ts = {delay_us / 1000000, (delay_us % 1000000) * 1000};
+        nanosleep(&ts, NULL);
+    }
+}
+
+// 메서드와 무관하게 경로로 분기 (클라이언트가 CUSTOMREQUEST를 재사용하는 경우가 있음)
+static int route_request(mock_vault_t *server, const mock_request_t *request, int fd) {
+    pthread_mutex_lock(&server->lock);
+    long seq = ++server->stats.requests;
+    if (request->ns[0]) server->stats.namespaced++;
+    if (server->options.capacity <= 0) {
+        pthread_mutex_unlock(&server->lock);
+        apply_latency(server, seq);
+    } else {
+        // 처리 자리가 capacity개뿐인 Vault 흉내 (자리를 기다리는 시간이 응답 지연 시간에 더해짐)
+        if (server->options.overload_queue > 0 && server->queued >= server->options.overload_queue) {
+            server->stats.overloaded++;
+            pthread_mutex_unlock(&server->lock);
+            return send_response(server, fd, 503, "{\"errors\":[\"overloaded\"]}");
+        }
+        server->queued++;
+        if (server->queued > server->stats.peak_queued) server->stats.peak_queued = server->queued;
+        while (server->active >= server->options.capacity) {
+            pthread_cond_wait(&server->slot_free, &server->lock);
+        }
+        server->queued--;
+        server->active++;
+        pthread_mutex_unlock(&server->lock);
+
+        apply_latency(server, seq);
+
+        pthread_mutex_lock(&server->lock);
+        server->active--;
+        pthread_cond_signal(&server->slot_free);
+        pthread_mutex_unlock(&server->lock);
+    }
+
+    if (strcmp(request->path, "/v1/auth/approle/login") == 0) {
+        return handle_login(server, fd);
+    }
+    if (strcmp(request->path, "/v1/auth/token/renew-self") == 0) {
+        return handle_renew_self(server, request, fd);
+    }
+
+    // 이하 경로는 토큰 필요
+    if (!request->token[0]) {
+        return send_response(server, fd, 403, "{\"errors\":[\"permission denied\"]}");
+    }
+    if (strcmp(request->path, "/v1/sys/leases/lookup") == 0) {
+        return handle_lease_lookup(server, request, fd);
+    }
+    if (strcmp(request->path, "/v1/sys/leases/revoke") == 0) {
+        return handle_lease_revoke(server, request, fd);
+    }
+    if (strcmp(request->path, "/v1/sys/events/subscribe/" MOCK_EVENT_TYPE) == 0) {
+        if (!server->options.events || !request->ws_key[0]) {
+            return send_response(server, fd, 404, "{\"errors\":[]}");
+        }
+        return handle_event_stream(server, request, fd);
+    }
+    if (strncmp(request->path, "/v1/", 4) == 0) {
+        if (strstr(request->path, "/data/")) {
+            return handle_kv_data(server, request, fd);
+        }
+        if (strstr(request->path, "/metadata/")) {
+            if (strcmp(request->method, "LIST") == 0 || strstr(request->query, "list=true")) {
+                return handle_kv_list(server, request, fd);
+            }
+            return handle_kv_metadata(server, request, fd);
+        }
+        if (strstr(request->path, "-transit/encrypt/")) {
+            return handle_transit(server, request, fd, 1);
+        }
+        if (strstr(request->path, "-transit/decrypt/")) {
+            return handle_transit(server, request, fd, 0);
+        }
+        if (strstr(request->path, "-transit/datakey/plaintext/")) {
+            return handle_transit_datakey(server, fd);
+        }
+        if (strstr(request->path, "-pki/issue/")) {
+            return handle_pki_issue(server, request, fd);
+        }
+        if (strstr(request->path, "/static-creds/")) {
+            return handle_db_static_creds(server, fd);
+        }
+        if (strstr(request->path, "/creds/")) {
+            return handle_db_creds(server, request, fd);
+        }
+    }
+    return send_response(server, fd, 404, "{\"errors\":[]}");
+}
+
+// 요청 헤더 파싱 (요청 라인, Content-Length, X-Vault-Token, X-Vault-Namespace, Accept-Encoding)
+static int parse_request(char *head, mock_request_t *request, size_t *content_length) {
+    *content_length = 0;
+    request->token[0] = '\0';
+    request->ws_key[0] = '\0';
+    request->ns[0] = '\0';
+    request->encoding = MOCK_ENCODING_IDENTITY;
+
+    char *line_end = strstr(head, "\r\n");
+    if (!line_end) return -1;
+    *line_end = '\0';
+    if (sscanf(head, "%15s %1023s", request->method, request->path) != 2) return -1;
+
+    // 쿼리 문자열 분리
+    request->query[0] = '\0';
+    char *query = strchr(request->path, '?');
+    if (query) {
+        *query = '\0';
+        strncpy(request->query, query + 1, sizeof(request->query) - 1);
+        request->query[sizeof(request->query) - 1] = '\0';
+    }
+
+    char *line = line_end + 2;
+    while (*line) {
+        line_end = strstr(line, "\r\n");
+        if (!line_end) break;
+        *line_end = '\0';
+
+        char *colon = strchr(line, ':');
+        if (colon) {
+            *colon = '\0';
+            char *value = colon + 1;
+            while (*value == ' ') value++;
+            if (strcasecmp(line, "Content-Length") == 0) {
+                *content_length = (size_t)atol(value);
+            } else if (strcasecmp(line, "X-Vault-Token") == 0) {
+                strncpy(request->token, value, sizeof(request->token) - 1);
+                request->token[sizeof(request->token) - 1] = '\0';
+            } else if (strcasecmp(line, "X-Vault-Namespace") == 0) {
+                strncpy(request->ns, value, sizeof(request->ns) - 1);
+                request->ns[sizeof(request->ns) - 1] = '\0';
+            } else if (strcasecmp(line, "Accept-Encoding") == 0) {
+                // zstd를 gzip보다 먼저 고름 (q 값은 무시)
+                request->encoding = strstr(value, "zstd") ? MOCK_ENCODING_ZSTD :
+                                    strstr(value, "gzip") ? MOCK_ENCODING_GZIP : MOCK_ENCODING_IDENTITY;
+            } else if (strcasecmp(line, "Sec-WebSocket-Key") == 0) {
+                strncpy(request->ws_key, value, sizeof(request->ws_key) - 1);
+                request->ws_key[sizeof(request->ws_key) - 1] = '\0';
+            }
+        }
+        line = line_end + 2;
+    }
+    return 0;
+}
+
+// 연결 처리 (keep-alive로 여러 요청 처리)
+static void *connection_thread(void *arg) {
+    mock_connection_t *connection = (mock_connection_t *)arg;
+    mock_vault_t *server = connection->server;
+    int fd = connection->fd;
+    free(connection);
+
+    char *buffer = malloc(MOCK_MAX_REQUEST + 1);
+    size_t used = 0;
+    if (buffer) buffer[0] = '\0';
+
+    while (buffer && !__atomic_load_n(&server->stopping, __ATOMIC_ACQUIRE)) {
+        char *head_end = NULL;
+        while (!(head_end = strstr(buffer, "\r\n\r\n"))) {
+            if (used >= MOCK_MAX_REQUEST) goto done;
+            ssize_t n = recv(fd, buffer + used, MOCK_MAX_REQUEST - used, 0);
+            if (n <= 0) goto done;
+            used += (size_t)n;
+            buffer[used] = '\0';
+        }
+
+        size_t head_len = (size_t)(head_end - buffer) + 4;
+        size_t content_length = 0;
+        mock_request_t request;
+        head_end[2] = '\0';
+        if (parse_request(buffer, &request, &content_length) != 0) goto done;
+        if (head_len + content_length > MOCK_MAX_REQUEST) goto done;
+
+        while (used < head_len + content_length) {
+            ssize_t n = recv(fd, buffer + used, MOCK_MAX_REQUEST - used, 0);
+            if (n <= 0) goto done;
+            used += (size_t)n;
+        }
+        request.body = buffer + head_len;
+        request.body_len = content_length;
+
+        // 본문을 문자열로 다룰 수 있도록 잠시 종료 문자를 넣음 (뒤따르는 요청 데이터 보존)
+        char saved = buffer[head_len + content_length];
+        buffer[head_len + content_length] = '\0';
+        response_encoding = request.encoding;
+        int rc = route_request(server, &request, fd);
+        buffer[head_len + content_length] = saved;
+        if (rc != 0) goto done;
+
+        // 다음 요청을 버퍼 앞으로 이동
+        size_t consumed = head_len + content_length;
+        memmove(buffer, buffer + consumed, used - consumed);
+        used -= consumed;
+        buffer[used] = '\0';
+    }
+
+done:
+    free(buffer);
+    close(fd);
+    return NULL;
+}
+
+static void *accept_thread(void *arg) {
+    mock_vault_t *server = (mock_vault_t *)arg;
+
+    while (!__atomic_load_n(&server->stopping, __ATOMIC_ACQUIRE)) {
+        int fd = accept(server->listen_fd, NULL, NULL);
+        if (fd < 0) {
+            if (__atomic_load_n(&server->stopping, __ATOMIC_ACQUIRE)) break;
+            continue;
+        }
+        int one = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+        pthread_mutex_lock(&server->lock);
+        server->stats.connections++;
+        pthread_mutex_unlock(&server->lock);
+
+        mock_connection_t *connection = malloc(sizeof(mock_connection_t));
+        pthread_t thread;
+        if (!connection) {
+            close(fd);
+            continue;
+        }
+        connection->server = server;
+        connection->fd = fd;
+        if (pthread_create(&thread, NULL, connection_thread, connection) != 0) {
+            free(connection);
+            close(fd);
+            continue;
+        }
+        pthread_detach(thread);
+    }
+    return NULL;
+}
+
+mock_vault_t *mock_vault_start(const mock_vault_options_t *options) {
+    signal(SIGPIPE, SIG_IGN);
+
+    mock_vault_t *server = calloc(1, sizeof(mock_vault_t));
+    if (!server) return NULL;
+    server->options = *options;
+    server->started = time(NULL);
+    pthread_mutex_init(&server->lock, NULL);
+    pthread_cond_init(&server->slot_free, NULL);
+
+    // payload는 JSON 이스케이프가 필요 없는 문자로 채움
+    int payload_size = options->payload_size > 0 ? options->payload_size : 0;
+    server->payload = malloc((size_t)payload_size + 1);
+    if (!server->payload) {
+        free(server);
+        return NULL;
+    }
+    // payload_random이면 키/인증서처럼 base64 문자를 무작위로 (고정 시드, 압축률 6비트/문자 수준)
+    static const char base64[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    unsigned int seed = 12345;
+    for (int i = 0; i < payload_size; i++) {
+        if (options->payload_random) {
+            seed = seed * 1103515245u + 12345u;
+            server->payload[i] = base64[(seed >> 16) & 63];
+        } else {
+            server->payload[i] = "abcdefghijklmnopqrstuvwxyz0123456789"[i % 36];
+        }
+    }
+    server->payload[payload_size] = '\0';
+
+    server->listen_fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (server->listen_fd < 0) goto fail;
+
+    int one = 1;
+    setsockopt(server->listen_fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = htons((unsigned short)options->port);
+    if (bind(server->listen_fd, (struct sockaddr *)&addr, sizeof(addr)) != 0) goto fail;
+    if (listen(server->listen_fd, 512) != 0) goto fail;
+
+    socklen_t len = sizeof(addr);
+    getsockname(server->listen_fd, (struct sockaddr *)&addr, &len);
+    server->port = ntohs(addr.sin_port);
+
+    if (pthread_create(&server->accept_thread, NULL, accept_thread, server) != 0) goto fail;
+    if (options->events && options->kv_update_interval > 0 &&
+        pthread_create(&server->event_thread, NULL, event_thread, server) == 0) {
+        server->event_thread_started = 1;
+    }
+    return server;
+
+fail:
+    perror("mock_vault_start");
+    if (server->listen_fd >= 0) close(server->listen_fd);
+    pthread_cond_destroy(&server->slot_free);
+    pthread_mutex_destroy(&server->lock);
+    free(server->payload);
+    free(server);
+    return NULL;
+}
+
+int mock_vault_port(const mock_vault_t *server) {
+    return server ? server->port : -1;
+}
+
+void mock_vault_get_stats(mock_vault_t *server, mock_vault_stats_t *stats) {
+    pthread_mutex_lock(&server->lock);
+    *stats = server->stats;
+    pthread_mutex_unlock(&server->lock);
+}
+
+// KV를 새 버전으로 갱신 (쓰기 흉내)
+int mock_vault_bump_kv_version(mock_vault_t *server) {
+    pthread_mutex_lock(&server->lock);
+    server->kv_version_bumps++;
+    server->stats.storage_writes++;
+    int version = current_kv_version(server, time(NULL));
+    publish_kv_events(server, version);
+    pthread_mutex_unlock(&server->lock);
+    return version;
+}
+
+// 키 하나의 버전만 올림 (key: 마운트 이후 경로, 예: "app/key-0")
+int mock_vault_bump_kv_key(mock_vault_t *server, const char *key) {
+    pthread_mutex_lock(&server->lock);
+    int rc = -1;
+    if (server->key_bump_count < MOCK_MAX_KEY_BUMPS) {
+        snprintf(server->key_bumps[server->key_bump_count++], sizeof(server->key_bumps[0]), "%s", key);
+        server->stats.storage_writes++;
+        rc = 0;
+    }
+    pthread_mutex_unlock(&server->lock);
+    return rc;
+}
+
+// 이벤트 스트림 연결을 모두 끊음 (클라이언트의 폴링 전환/재연결 확인용)
+void mock_vault_drop_event_streams(mock_vault_t *server) {
+    pthread_mutex_lock(&server->lock);
+    for (int i = 0; i < server->event_fd_count; i++) {
+        shutdown(server->event_fds[i], SHUT_RDWR);
+    }
+    pthread_mutex_unlock(&server->lock);
+}
+
+void mock_vault_stop(mock_vault_t *server) {
+    if (!server) return;
+
+    __atomic_store_n(&server->stopping, 1, __ATOMIC_RELEASE);
+    shutdown(server->listen_fd, SHUT_RDWR);
+    close(server->listen_fd);
+    pthread_join(server->accept_thread, NULL);
+    if (server->event_thread_started) {
+        pthread_join(server->event_thread, NULL);
+    }
+    mock_vault_drop_event_streams(server);
+
+    // 연결 스레드는 분리(detach)되어 있어 클라이언트가 연결을 닫으면 스스로 종료됨
+    // 서버 구조체는 연결 스레드가 참조할 수 있으므로 해제하지 않음 (벤치마크 프로세스 종료 시 정리)
+}
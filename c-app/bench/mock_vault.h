@@ -0,0 +1,83 @@
+#ifndef MOCK_VAULT_H
+#define MOCK_VAULT_H
+
+// 벤치마크용 Vault 대역(stand-in) HTTP 서버
+// 127.0.0.1에서 동작하며 클라이언트가 사용하는 Vault API 일부를 흉내 내고
+// 요청 수와 Vault 스토리지 쓰기 횟수(추정)를 집계합니다.
+//
+// 지원 경로:
+//   auth/approle/login, auth/token/renew-self, sys/leases/lookup, sys/leases/revoke
+//   <mount>/data/<name>, <mount>/metadata/<name> (KV v2)
+//   LIST <mount>/metadata/<folder>/ (KV v2, 폴더마다 kv_list_fanout개 키와 kv_list_depth 깊이까지 하위 폴더)
+//   <mount>/creds/<role>, <mount>/static-creds/<role> (Database)
+//   <mount>/encrypt/<key>, <mount>/decrypt/<key> (Transit, batch_input 지원, 실제로 암호화하지 않고 접두사만 붙임)
+//   sys/events/subscribe/kv-v2/data-write (WebSocket, KV 버전이 바뀔 때마다 읽힌 KV 경로별 이벤트 전송)
+// compress_min 이상인 응답은 Accept-Encoding에 zstd가 있으면 zstd, gzip이 있으면 gzip으로 압축합니다.
+
+// 서버 옵션
+typedef struct {
+    int port;               // 0이면 임의 포트
+    int token_ttl;          // 발급 토큰 TTL (초)
+    int token_max_ttl;      // service 토큰 최대 TTL (초, renew-self 상한)
+    int batch_tokens;       // 1이면 batch 토큰 발급 (저장/갱신 불가)
+    int latency_us;         // 응답 전 지연 시간 (us)
+    int latency_jitter_us;  // 지연 시간 변동폭 (0 ~ 지정값 us 추가)
+    int payload_size;       // 시크릿 응답에 포함할 payload 필드 크기 (바이트)
+    int kv_update_interval; // KV 버전 자동 증가 간격 (초, 0이면 고정)
+    int lease_ttl;          // Database Dynamic 자격증명 lease TTL (초)
+    int rotation_period;    // Database Static 자격증명 교체 주기 (초)
+    int events;             // 1이면 이벤트 구독 지원 (0이면 404, 이벤트 미지원 Vault 흉내)
+    int kv_list_fanout;     // KV LIST 응답의 폴더당 키/하위 폴더 수
+    int kv_list_depth;      // KV LIST 하위 폴더를 만드는 최대 깊이
+    int transit_item_us;    // Transit 항목당 처리 시간 (us, 요청 지연 시간에 더해짐)
+    int pki_max_ttl;        // PKI 발급 인증서 최대 유효 기간 (초, 요청 ttl이 없거나 더 길면 이 값)
+    int pki_issue_us;       // PKI 발급 처리 시간 (us, 키 생성 흉내, 요청 지연 시간에 더해짐)
+    int capacity;           // 동시에 처리하는 요청 수 (0이면 무제한, 넘치면 대기열에서 기다림)
+    int overload_queue;     // 대기열이 이만큼 차면 503 응답 (0이면 거부하지 않음, capacity가 있을 때만)
+    int compress_min;       // 이 크기 이상 응답을 Accept-Encoding에 따라 zstd/gzip 압축 (바이트, 0이면 압축 안 함)
+    int payload_random;     // 1이면 payload를 무작위 base64 문자로 채움 (키/인증서처럼 압축이 잘 안 되는 값)
+} mock_vault_options_t;
+
+// 요청 통계
+typedef struct {
+    long requests;        // 전체 요청 수
+    long logins;          // auth/approle/login
+    long renewals;        // auth/token/renew-self
+    long renew_failures;  // renew-self 거부 (batch 토큰, 최대 TTL 초과)
+    long storage_writes;  // 토큰/lease 저장 쓰기 추정치
+    long kv_reads;        // KV v2 data
+    long metadata_reads;  // KV v2 metadata
+    long lists;           // KV v2 metadata LIST
+    long db_creds;        // database/creds (자격증명 발급)
+    long db_static_reads; // database/static-creds
+    long lease_lookups;   // sys/leases/lookup
+    long lease_revocations; // sys/leases/revoke
+    long transit_requests;  // transit encrypt/decrypt 요청
+    long transit_items;     // transit 요청에 담긴 항목 수 (batch_input 합계)
+    long transit_datakeys;  // transit datakey/plaintext (데이터 키 발급)
+    long pki_issued;        // pki/issue (인증서 발급)
+    long overloaded;        // 대기열이 가득 차 503으로 거부한 요청
+    long peak_queued;       // capacity 대기열 최대 길이
+    long bytes_sent;      // 응답 본문 바이트 (압축했으면 압축된 크기)
+    long bytes_raw;       // 압축 전 응답 본문 바이트
+    long compressed;      // 압축해서 보낸 응답
+    long compress_us;     // 응답 압축에 쓴 시간 (us)
+    long event_streams;   // 수락한 이벤트 구독 (WebSocket) 연결
+    long events_sent;     // 전송한 kv-v2/data-write 이벤트
+    long connections;     // 수락한 TCP 연결 (keep-alive 재사용 확인)
+    long namespaced;      // X-Vault-Namespace 헤더가 있는 요청
+} mock_vault_stats_t;
+
+typedef struct mock_vault mock_vault_t;
+
+// 함수 선언
+void mock_vault_default_options(mock_vault_options_t *options);
+mock_vault_t *mock_vault_start(const mock_vault_options_t *options);
+int mock_vault_port(const mock_vault_t *server);
+void mock_vault_get_stats(mock_vault_t *server, mock_vault_stats_t *stats);
+int mock_vault_bump_kv_version(mock_vault_t *server);
+int mock_vault_bump_kv_key(mock_vault_t *server, const char *key);  // 키 하나만 버전 증가
+void mock_vault_drop_event_streams(mock_vault_t *server);  // 이벤트 스트림 강제 종료 (폴백 테스트)
+void mock_vault_stop(mock_vault_t *server);
+
+#endif
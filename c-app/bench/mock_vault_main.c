@@ -0,0 +1,94 @@
+// 단독 실행용 Vault 대역 서버
+// 애플리케이션(vault-app)이나 외부 부하 도구를 실제 Vault 없이 실행할 때 사용합니다.
+//
+// 사용법: ./mock-vault [-p port] [-t token_ttl] [-m token_max_ttl] [-b]
+//                      [-l latency_us] [-j jitter_us] [-s payload_bytes]
+//                      [-k kv_update_interval] [-L lease_ttl] [-r rotation_period] [-E]
+//                      [-F list_fanout] [-D list_depth] [-T transit_item_us]
+//                      [-C pki_max_ttl] [-I pki_issue_us] [-K capacity] [-Q overload_queue]
+//                      [-Z compress_min] [-R]
+//   -E: 이벤트 구독(sys/events/subscribe) 미지원 Vault 흉내 (404)
+//   -R: payload를 무작위 base64 문자로 채움 (압축 효과가 작은 값)
+#define _POSIX_C_SOURCE 200809L
+#include "mock_vault.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <signal.h>
+
+static volatile sig_atomic_t should_exit = 0;
+
+static void signal_handler(int sig) {
+    (void)sig;
+    should_exit = 1;
+}
+
+int main(int argc, char *argv[]) {
+    mock_vault_options_t options;
+    mock_vault_default_options(&options);
+    options.port = 8200;
+
+    int c;
+    while ((c = getopt(argc, argv, "p:t:m:bl:j:s:k:L:r:EF:D:T:C:I:K:Q:Z:R")) != -1) {
+        switch (c) {
+            case 'p': options.port = atoi(optarg); break;
+            case 't': options.token_ttl = atoi(optarg); break;
+            case 'm': options.token_max_ttl = atoi(optarg); break;
+            case 'b': options.batch_tokens = 1; break;
+            case 'l': options.latency_us = atoi(optarg); break;
+            case 'j': options.latency_jitter_us = atoi(optarg); break;
+            case 's': options.payload_size = atoi(optarg); break;
+            case 'k': options.kv_update_interval = atoi(optarg); break;
+            case 'L': options.lease_ttl = atoi(optarg); break;
+            case 'r': options.rotation_period = atoi(optarg); break;
+            case 'E': options.events = 0; break;
+            case 'F': options.kv_list_fanout = atoi(optarg); break;
+            case 'D': options.kv_list_depth = atoi(optarg); break;
+            case 'T': options.transit_item_us = atoi(optarg); break;
+            case 'C': options.pki_max_ttl = atoi(optarg); break;
+            case 'I': options.pki_issue_us = atoi(optarg); break;
+            case 'K': options.capacity = atoi(optarg); break;
+            case 'Q': options.overload_queue = atoi(optarg); break;
+            case 'Z': options.compress_min = atoi(optarg); break;
+            case 'R': options.payload_random = 1; break;
+            default:
+                fprintf(stderr, "Usage: %s [-p port] [-t token_ttl] [-m token_max_ttl] [-b] "
+                                "[-l latency_us] [-j jitter_us] [-s payload_bytes] "
+                                "[-k kv_update_interval] [-L lease_ttl] [-r rotation_period] [-E] "
+                                "[-F list_fanout] [-D list_depth] [-T transit_item_us] "
+                                "[-C pki_max_ttl] [-I pki_issue_us] [-K capacity] [-Q overload_queue] "
+                                "[-Z compress_min] [-R]\n", argv[0]);
+                return 1;
+        }
+    }
+
+    signal(SIGINT, signal_handler);
+    signal(SIGTERM, signal_handler);
+
+    mock_vault_t *server = mock_vault_start(&options);
+    if (!server) return 1;
+
+    printf("Mock Vault listening on http://127.0.0.1:%d (latency %dus +0~%dus, payload %d bytes)\n",
+           mock_vault_port(server), options.latency_us, options.latency_jitter_us, options.payload_size);
+    fflush(stdout);
+
+    while (!should_exit) {
+        sleep(1);
+    }
+
+    mock_vault_stats_t stats;
+    mock_vault_get_stats(server, &stats);
+    printf("\nrequests=%ld logins=%ld renewals=%ld kv_reads=%ld metadata_reads=%ld lists=%ld "
+           "db_creds=%ld db_static_reads=%ld lease_lookups=%ld lease_revocations=%ld "
+           "transit_requests=%ld transit_items=%ld transit_datakeys=%ld pki_issued=%ld overloaded=%ld peak_queued=%ld "
+           "storage_writes=%ld bytes_sent=%ld bytes_raw=%ld compressed=%ld event_streams=%ld events_sent=%ld "
+           "connections=%ld namespaced=%ld\n",
+           stats.requests, stats.logins, stats.renewals, stats.kv_reads, stats.metadata_reads, stats.lists,
+           stats.db_creds, stats.db_static_reads, stats.lease_lookups, stats.lease_revocations,
+           stats.transit_requests, stats.transit_items, stats.transit_datakeys, stats.pki_issued,
+           stats.overloaded, stats.peak_queued,
+           stats.storage_writes, stats.bytes_sent, stats.bytes_raw, stats.compressed, stats.event_streams, stats.events_sent, stats.connections,
+           stats.namespaced);
+    mock_vault_stop(server);
+    return 0;
+}
@@ -0,0 +1,272 @@
+// PKI 인증서 미리 발급 벤치마크
+// TLS 핸드셰이크 스레드 W개가 vault_pki_acquire로 현재 인증서를 계속 가져가는 동안
+// 만료 시점에 발급(renew_at 100)과 유효 기간의 renew_at% 시점에 미리 발급을 비교합니다.
+// 대역 서버는 발급마다 issue_us(키 생성 시간)를 더하고, 인증서 유효 기간은 cert_ttl초입니다.
+// 만료된 인증서를 받은 핸드셰이크 비율과 가장 긴 만료 구간, acquire 지연 시간을 집계합니다.
+//
+// 사용법: ./pki-bench [-w workers] [-d seconds] [-c cert_ttl] [-I issue_us] [-r renew_at]
+#define _POSIX_C_SOURCE 200809L
+#include "../src/vault_pki.h"
+#include "mock_vault.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+
+#define SAMPLE_CAPACITY 65536  // 작업자당 지연 시간 표본 수
+
+typedef struct {
+    int workers;
+    int duration;
+    int cert_ttl;
+    int issue_us;
+    int renew_at;
+} pki_options_t;
+
+typedef struct {
+    vault_pki_t *pki;
+    uint64_t *acquire_ns;
+    size_t samples;
+    long handshakes;
+    long expired;            // NotAfter가 지난 인증서를 받은 핸드셰이크
+    long missing;            // 인증서가 없었던 핸드셰이크
+    uint64_t expired_since;  // 현재 만료 구간 시작 (0이면 유효)
+    uint64_t longest_gap;    // 가장 긴 만료 구간 (ns)
+} pki_worker_t;
+
+typedef struct {
+    char name[32];
+    double handshakes_per_sec;
+    double expired_pct;
+    double longest_gap_ms;
+    double p99_us;
+    double max_us;
+    long issued;
+    double issue_ms;
+    long callbacks;
+    long missing;
+} pki_result_t;
+
+static int stop_flag = 0;
+
+static uint64_t realtime_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static void *worker_thread(void *arg) {
+    pki_worker_t *worker = (pki_worker_t *)arg;
+    while (!__atomic_load_n(&stop_flag, __ATOMIC_ACQUIRE)) {
+        uint64_t start = vault_metrics_now_ns();
+        const vault_pki_cert_t *cert = vault_pki_acquire(worker->pki);
+        uint64_t elapsed = vault_metrics_now_ns() - start;
+        if (worker->samples < SAMPLE_CAPACITY) worker->acquire_ns[worker->samples++] = elapsed;
+        worker->handshakes++;
+
+        uint64_t now = realtime_ns();
+        if (!cert) {
+            worker->missing++;
+        } else if (now >= (uint64_t)cert->not_after * 1000000000ULL) {
+            worker->expired++;
+            if (!worker->expired_since) worker->expired_since = now;
+            if (now - worker->expired_since > worker->longest_gap) worker->longest_gap = now - worker->expired_since;
+        } else {
+            worker->expired_since = 0;
+        }
+        vault_pki_release(worker->pki, cert);
+
+        // 핸드셰이크 처리 시간
+        struct timespec ts = {0, 1000000};
+        nanosleep(&ts, NULL);
+    }
+    return NULL;
+}
+
+static void count_reload(const vault_pki_cert_t *cert, void *ctx) {
+    (void)cert;
+    __atomic_add_fetch((long *)ctx, 1, __ATOMIC_RELAXED);
+}
+
+static int compare_u64(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+    return x < y ? -1 : x > y;
+}
+
+static void make_config(app_config_t *config, int port, const pki_options_t *opt, int renew_at) {
+    memset(config, 0, sizeof(*config));
+    snprintf(config->vault_url, sizeof(config->vault_url), "http://127.0.0.1:%d", port);
+    snprintf(config->entity, sizeof(config->entity), "pki-bench");
+    snprintf(config->token_type, sizeof(config->token_type), "service");
+    config->secret_kv.refresh_interval = DEFAULT_KV_REFRESH_INTERVAL;
+    config->http_timeout = 10;
+    config->max_response_size = DEFAULT_MAX_RESPONSE_SIZE;
+    config->max_in_flight = DEFAULT_MAX_IN_FLIGHT;
+    config->schedule.renew_window_min = DEFAULT_RENEW_WINDOW_MIN;
+    config->schedule.renew_window_max = DEFAULT_RENEW_WINDOW_MAX;
+    config->schedule.refresh_jitter = DEFAULT_REFRESH_JITTER;
+    strncpy(config->trace.format, DEFAULT_TRACE_FORMAT, sizeof(config->trace.format) - 1);
+    config->pki.enabled = 1;
+    snprintf(config->pki.role, sizeof(config->pki.role), "web");
+    snprintf(config->pki.common_name, sizeof(config->pki.common_name), "bench.example.com");
+    snprintf(config->pki.ttl, sizeof(config->pki.ttl), "%ds", opt->cert_ttl);
+    config->pki.renew_at = renew_at;
+}
+
+static int run_mode(const pki_options_t *opt, int renew_at, pki_result_t *result) {
+    mock_vault_options_t server_options;
+    mock_vault_default_options(&server_options);
+    server_options.pki_max_ttl = opt->cert_ttl;
+    server_options.pki_issue_us = opt->issue_us;
+    mock_vault_t *server = mock_vault_start(&server_options);
+    if (!server) return -1;
+
+    app_config_t config;
+    make_config(&config, mock_vault_port(server), opt, renew_at);
+    vault_transport_t transport;
+    vault_client_t client;
+    vault_pki_t pki;
+    vault_transport_init(&transport);
+    vault_client_init(&client, &config);
+    vault_client_set_transport(&client, &transport);
+    int rc = -1;
+    long reloads = 0;
+    if (vault_login(&client, "role", "secret") != 0 || vault_pki_init(&pki, &client) != 0) {
+        vault_client_cleanup(&client);
+        vault_transport_destroy(&transport);
+        mock_vault_stop(server);
+        return -1;
+    }
+    vault_pki_on_reload(&pki, count_reload, &reloads);
+    vault_pki_start(&pki);
+
+    pki_worker_t *workers = calloc((size_t)opt->workers, sizeof(pki_worker_t));
+    pthread_t *threads = calloc((size_t)opt->workers, sizeof(pthread_t));
+    if (!workers || !threads) goto out;
+    __atomic_store_n(&stop_flag, 0, __ATOMIC_RELEASE);
+    uint64_t start = vault_metrics_now_ns();
+    for (int i = 0; i < opt->workers; i++) {
+        workers[i].pki = &pki;
+        workers[i].acquire_ns = calloc(SAMPLE_CAPACITY, sizeof(uint64_t));
+        if (!workers[i].acquire_ns) goto out;
+        pthread_create(&threads[i], NULL, worker_thread, &workers[i]);
+    }
+
+    sleep((unsigned)opt->duration);
+    __atomic_store_n(&stop_flag, 1, __ATOMIC_RELEASE);
+    for (int i = 0; i < opt->workers; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    double elapsed = (double)(vault_metrics_now_ns() - start) / 1e9;
+
+    memset(result, 0, sizeof(*result));
+    if (renew_at >= 100) snprintf(result->name, sizeof(result->name), "on-expiry");
+    else snprintf(result->name, sizeof(result->name), "pre-%d%%", renew_at);
+    size_t total = 0;
+    long handshakes = 0, expired = 0;
+    uint64_t longest = 0;
+    for (int i = 0; i < opt->workers; i++) {
+        total += workers[i].samples;
+        handshakes += workers[i].handshakes;
+        expired += workers[i].expired;
+        result->missing += workers[i].missing;
+        if (workers[i].longest_gap > longest) longest = workers[i].longest_gap;
+    }
+    uint64_t *all = calloc(total ? total : 1, sizeof(uint64_t));
+    if (!all) goto out;
+    size_t n = 0;
+    for (int i = 0; i < opt->workers; i++) {
+        memcpy(all + n, workers[i].acquire_ns, workers[i].samples * sizeof(uint64_t));
+        n += workers[i].samples;
+    }
+    qsort(all, n, sizeof(uint64_t), compare_u64);
+    result->handshakes_per_sec = (double)handshakes / elapsed;
+    result->expired_pct = handshakes ? 100.0 * (double)expired / (double)handshakes : 0;
+    result->longest_gap_ms = (double)longest / 1e6;
+    result->p99_us = n ? (double)all[(n * 99) / 100] / 1e3 : 0;
+    result->max_us = n ? (double)all[n - 1] / 1e3 : 0;
+    free(all);
+
+    vault_pki_stats_t stats;
+    vault_pki_get_stats(&pki, &stats);
+    result->issued = (long)stats.issued;
+    result->issue_ms = stats.max_issue_ms;
+    result->callbacks = __atomic_load_n(&reloads, __ATOMIC_RELAXED);
+    rc = 0;
+
+out:
+    vault_pki_destroy(&pki);
+    if (workers) {
+        for (int i = 0; i < opt->workers; i++) free(workers[i].acquire_ns);
+    }
+    free(workers);
+    free(threads);
+    vault_client_cleanup(&client);
+    vault_client_thread_cleanup();
+    vault_transport_destroy(&transport);
+    mock_vault_stop(server);
+    return rc;
+}
+
+int main(int argc, char *argv[]) {
+    pki_options_t opt = {8, 12, 4, 400000, DEFAULT_PKI_RENEW_AT};
+    int c;
+    while ((c = getopt(argc, argv, "w:d:c:I:r:")) != -1) {
+        switch (c) {
+            case 'w': opt.workers = atoi(optarg); break;
+            case 'd': opt.duration = atoi(optarg); break;
+            case 'c': opt.cert_ttl = atoi(optarg); break;
+            case 'I': opt.issue_us = atoi(optarg); break;
+            case 'r': opt.renew_at = atoi(optarg); break;
+            default:
+                fprintf(stderr, "Usage: %s [-w workers] [-d seconds] [-c cert_ttl] [-I issue_us] [-r renew_at]\n",
+                        argv[0]);
+                return 1;
+        }
+    }
+    if (opt.workers <= 0 || opt.duration <= 0 || opt.cert_ttl <= 0 || opt.issue_us < 0 || opt.renew_at < 1 ||
+        opt.renew_at > 99) {
+        fprintf(stderr, "Invalid options (renew_at 1..99)\n");
+        return 1;
+    }
+
+    curl_global_init(CURL_GLOBAL_DEFAULT);
+
+    // 클라이언트 로그 출력은 결과 집계에 방해되므로 실행 중에는 버림
+    fflush(stdout);
+    int saved_stdout = dup(STDOUT_FILENO);
+    int devnull = open("/dev/null", O_WRONLY);
+
+    const int modes[] = { 100, opt.renew_at };
+    enum { MODES = 2 };
+    pki_result_t results[MODES];
+    for (int m = 0; m < MODES; m++) {
+        fprintf(stderr, "Running renew_at=%d (%d workers, %ds)...\n", modes[m], opt.workers, opt.duration);
+        dup2(devnull, STDOUT_FILENO);
+        int rc = run_mode(&opt, modes[m], &results[m]);
+        fflush(stdout);
+        dup2(saved_stdout, STDOUT_FILENO);
+        if (rc != 0) {
+            fprintf(stderr, "Failed to run benchmark\n");
+            return 1;
+        }
+    }
+    close(devnull);
+
+    printf("=== PKI Pre-issuance Benchmark ===\n");
+    printf("workers=%d duration=%ds cert_ttl=%ds issue time=%dus\n\n", opt.workers, opt.duration, opt.cert_ttl,
+           opt.issue_us);
+    printf("%-10s %12s %9s %11s %9s %9s %7s %9s %9s\n", "mode", "handshake/s", "expired", "longest gap", "p99",
+           "max", "issued", "issue", "reloads");
+    for (int m = 0; m < MODES; m++) {
+        pki_result_t *r = &results[m];
+        printf("%-10s %12.0f %8.2f%% %9.1fms %7.1fus %7.1fus %7ld %7.1fms %9ld\n", r->name, r->handshakes_per_sec,
+               r->expired_pct, r->longest_gap_ms, r->p99_us, r->max_us, r->issued, r->issue_ms, r->callbacks);
+    }
+    printf("\non-expiry issues the next certificate at NotAfter, so handshakes get an expired certificate until the\n"
+           "issue completes; pre-N%% issues it at N%% of the lifetime while the current one stays valid\n");
+
+    curl_global_cleanup();
+    return results[1].expired_pct == 0 && results[1].missing == 0 ? 0 : 1;
+}
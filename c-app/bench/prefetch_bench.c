@@ -0,0 +1,234 @@
+// KV 하위 경로 미리 읽기(prefetch) 벤치마크
+// 대역 서버의 LIST 트리(폴더당 fanout개 키, depth 깊이)를 대상으로 세 단계의 소요 시간과 요청 수를 비교합니다.
+//   lazy:     키가 처음 필요할 때마다 vault_get_secret 호출 (키마다 왕복 1번)
+//   prefetch: vault_prefetch_kv 한 번 후 vault_get_secrets로 전체 조회 (모두 경로 캐시에서 반환)
+//   repoll:   키 일부의 버전을 올린 뒤 다시 prefetch + 전체 조회 (metadata 확인 후 바뀐 키만 다시 받음)
+//
+// 사용법: ./prefetch-bench [-f fanout] [-d depth] [-l latency_us] [-b bumped_keys]
+#define _POSIX_C_SOURCE 200809L
+#include "../src/vault_client.h"
+#include "mock_vault.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+
+#define BENCH_MOUNT "prefetch-bench-kv"
+#define BENCH_PREFIX "app"
+
+typedef struct {
+    int fanout;
+    int depth;
+    int latency_us;
+    int bumped;
+} prefetch_options_t;
+
+typedef struct {
+    const char *name;
+    double elapsed_ms;
+    long requests;
+    long lists;
+    long metadata_reads;
+    long kv_reads;
+    int failed;
+} prefetch_result_t;
+
+static void mock_config(app_config_t *config, int port) {
+    memset(config, 0, sizeof(*config));
+    snprintf(config->vault_url, sizeof(config->vault_url), "http://127.0.0.1:%d", port);
+    snprintf(config->entity, sizeof(config->entity), "prefetch-bench");
+    snprintf(config->token_type, sizeof(config->token_type), "service");
+    config->secret_kv.refresh_interval = DEFAULT_KV_REFRESH_INTERVAL;
+    config->http_timeout = 10;
+    config->max_response_size = DEFAULT_MAX_RESPONSE_SIZE;
+    config->max_in_flight = DEFAULT_MAX_IN_FLIGHT;
+    config->schedule.renew_window_min = DEFAULT_RENEW_WINDOW_MIN;
+    config->schedule.renew_window_max = DEFAULT_RENEW_WINDOW_MAX;
+    config->schedule.refresh_jitter = DEFAULT_REFRESH_JITTER;
+    strncpy(config->trace.format, DEFAULT_TRACE_FORMAT, sizeof(config->trace.format) - 1);
+}
+
+// 대역 서버 LIST 트리의 리프 (마운트 이후 경로, 예: app/dir-0/key-1)
+static int collect_keys(const char *folder, int level, const prefetch_options_t *opt, char ***keys, int *count) {
+    for (int i = 0; i < opt->fanout; i++) {
+        char **grown = realloc(*keys, (size_t)(*count + 1) * sizeof(char *));
+        if (!grown) return -1;
+        *keys = grown;
+        (*keys)[*count] = malloc(256);
+        if (!(*keys)[*count]) return -1;
+        snprintf((*keys)[(*count)++], 256, "%s/key-%d", folder, i);
+    }
+    for (int i = 0; level < opt->depth && i < opt->fanout; i++) {
+        char child[256];
+        snprintf(child, sizeof(child), "%s/dir-%d", folder, i);
+        if (collect_keys(child, level + 1, opt, keys, count) != 0) return -1;
+    }
+    return 0;
+}
+
+static int read_all(vault_client_t *client, char **paths, int count) {
+    vault_secret_result_t *results = calloc((size_t)count, sizeof(vault_secret_result_t));
+    if (!results) return count;
+    int failed = vault_get_secrets(client, (const char *const *)paths, (size_t)count, results);
+    for (int i = 0; i < count; i++) {
+        if (!results[i].cached) failed++;  // prefetch 이후에는 모두 캐시에서 반환되어야 함
+        vault_cleanup_secret(results[i].data);
+    }
+    free(results);
+    return failed;
+}
+
+static void finish(mock_vault_t *server, const mock_vault_stats_t *before, uint64_t start, prefetch_result_t *r) {
+    mock_vault_stats_t after;
+    r->elapsed_ms = (double)(vault_metrics_now_ns() - start) / 1e6;
+    mock_vault_get_stats(server, &after);
+    r->requests = after.requests - before->requests;
+    r->lists = after.lists - before->lists;
+    r->metadata_reads = after.metadata_reads - before->metadata_reads;
+    r->kv_reads = after.kv_reads - before->kv_reads;
+}
+
+static int run(const prefetch_options_t *opt, char **keys, char **paths, int count, prefetch_result_t results[3]) {
+    mock_vault_options_t server_options;
+    mock_vault_default_options(&server_options);
+    server_options.latency_us = opt->latency_us;
+    server_options.kv_list_fanout = opt->fanout;
+    server_options.kv_list_depth = opt->depth;
+    mock_vault_t *server = mock_vault_start(&server_options);
+    if (!server) return -1;
+
+    app_config_t config;
+    mock_config(&config, mock_vault_port(server));
+    vault_transport_t transport;
+    vault_client_t lazy, client;
+    vault_transport_init(&transport);
+    vault_client_init(&lazy, &config);
+    vault_client_init(&client, &config);
+    vault_client_set_transport(&lazy, &transport);
+    vault_client_set_transport(&client, &transport);
+    int rc = -1;
+    if (vault_login(&lazy, "role", "secret") != 0 || vault_login(&client, "role", "secret") != 0) goto out;
+
+    mock_vault_stats_t before;
+    uint64_t start;
+
+    // lazy: 키마다 순서대로 조회
+    results[0].name = "lazy";
+    mock_vault_get_stats(server, &before);
+    start = vault_metrics_now_ns();
+    for (int i = 0; i < count; i++) {
+        json_object *data = NULL;
+        if (vault_get_secret(&lazy, paths[i], &data) != 0) results[0].failed++;
+        vault_cleanup_secret(data);
+    }
+    finish(server, &before, start, &results[0]);
+
+    // prefetch: 트리 전체를 한 번에 읽고 이후 조회는 캐시에서
+    results[1].name = "prefetch";
+    mock_vault_get_stats(server, &before);
+    start = vault_metrics_now_ns();
+    vault_prefetch_stats_t stats;
+    if (vault_prefetch_kv(&client, BENCH_MOUNT, BENCH_PREFIX, opt->depth, (size_t)count, &stats) != 0) {
+        results[1].failed += (int)stats.failed + 1;
+    }
+    results[1].failed += read_all(&client, paths, count);
+    finish(server, &before, start, &results[1]);
+
+    // repoll: 일부 키만 버전을 올리고 다시 prefetch
+    for (int i = 0; i < opt->bumped && i < count; i++) {
+        mock_vault_bump_kv_key(server, keys[i * count / opt->bumped]);
+    }
+    results[2].name = "repoll";
+    mock_vault_get_stats(server, &before);
+    start = vault_metrics_now_ns();
+    if (vault_prefetch_kv(&client, BENCH_MOUNT, BENCH_PREFIX, opt->depth, (size_t)count, &stats) != 0 ||
+        stats.fetched != (size_t)(opt->bumped < count ? opt->bumped : count)) {
+        results[2].failed += (int)stats.failed + 1;
+    }
+    results[2].failed += read_all(&client, paths, count);
+    finish(server, &before, start, &results[2]);
+    rc = 0;
+
+out:
+    vault_client_cleanup(&lazy);
+    vault_client_cleanup(&client);
+    vault_client_thread_cleanup();
+    vault_transport_destroy(&transport);
+    mock_vault_stop(server);
+    return rc;
+}
+
+int main(int argc, char *argv[]) {
+    prefetch_options_t opt = {8, 2, 2000, 4};
+    int c;
+    while ((c = getopt(argc, argv, "f:d:l:b:")) != -1) {
+        switch (c) {
+            case 'f': opt.fanout = atoi(optarg); break;
+            case 'd': opt.depth = atoi(optarg); break;
+            case 'l': opt.latency_us = atoi(optarg); break;
+            case 'b': opt.bumped = atoi(optarg); break;
+            default:
+                fprintf(stderr, "Usage: %s [-f fanout] [-d depth] [-l latency_us] [-b bumped_keys]\n", argv[0]);
+                return 1;
+        }
+    }
+    if (opt.fanout <= 0 || opt.depth <= 0 || opt.latency_us < 0 || opt.bumped <= 0) {
+        fprintf(stderr, "Invalid options\n");
+        return 1;
+    }
+
+    char **keys = NULL;
+    int count = 0;
+    if (collect_keys(BENCH_PREFIX, 1, &opt, &keys, &count) != 0) return 1;
+    char **paths = calloc((size_t)count, sizeof(char *));
+    if (!paths) return 1;
+    for (int i = 0; i < count; i++) {
+        paths[i] = malloc(512);
+        if (!paths[i]) return 1;
+        snprintf(paths[i], 512, BENCH_MOUNT "/data/%s", keys[i]);
+    }
+
+    curl_global_init(CURL_GLOBAL_DEFAULT);
+
+    // 클라이언트 로그 출력은 결과 집계에 방해되므로 실행 중에는 버림
+    fflush(stdout);
+    int saved_stdout = dup(STDOUT_FILENO);
+    int devnull = open("/dev/null", O_WRONLY);
+    fprintf(stderr, "Running %d keys...\n", count);
+    dup2(devnull, STDOUT_FILENO);
+    prefetch_result_t results[3];
+    memset(results, 0, sizeof(results));
+    int rc = run(&opt, keys, paths, count, results);
+    fflush(stdout);
+    dup2(saved_stdout, STDOUT_FILENO);
+    close(devnull);
+    if (rc != 0) {
+        fprintf(stderr, "Failed to run benchmark\n");
+        return 1;
+    }
+
+    printf("=== KV Prefetch Benchmark ===\n");
+    printf("keys=%d (fanout=%d depth=%d) mock latency=%dus bumped=%d\n\n", count, opt.fanout, opt.depth,
+           opt.latency_us, opt.bumped);
+    printf("%-10s %12s %9s %9s %7s %9s %9s %8s\n", "mode", "elapsed(ms)", "speedup", "requests", "lists",
+           "metadata", "kv_reads", "failed");
+    int failed = 0;
+    for (int i = 0; i < 3; i++) {
+        prefetch_result_t *r = &results[i];
+        printf("%-10s %12.1f %8.1fx %9ld %7ld %9ld %9ld %8d\n", r->name, r->elapsed_ms,
+               r->elapsed_ms > 0 ? results[0].elapsed_ms / r->elapsed_ms : 0, r->requests, r->lists,
+               r->metadata_reads, r->kv_reads, r->failed);
+        failed += r->failed;
+    }
+    printf("\nprefetch/repoll include a full vault_get_secrets pass afterwards (served from the path cache)\n");
+
+    for (int i = 0; i < count; i++) {
+        free(keys[i]);
+        free(paths[i]);
+    }
+    free(keys);
+    free(paths);
+    curl_global_cleanup();
+    return failed == 0 ? 0 : 1;
+}
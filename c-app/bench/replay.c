@@ -0,0 +1,440 @@
+// 트래픽 기록 재생기
+// vault-app을 [trace] record 설정으로 실행해 남긴 기록 파일을 읽어, 기록된 공개 API 호출
+// (main 루프의 조회, 갱신 스레드의 갱신, 토큰 갱신)을 기록 스레드별로 같은 시각 간격에 맞춰
+// 내장 Vault 대역 서버(mock_vault)와 현재 빌드의 클라이언트에 재생합니다.
+// 재생 중에도 같은 형식으로 기록한 뒤 기록/재생 양쪽의 엔드포인트별 Vault 요청 수와 지연 시간,
+// API 호출별 소요 시간을 나란히 비교합니다.
+//
+// 대역 서버 설정은 기록에서 추정합니다 (토큰/lease TTL, 교체 주기, KV 버전 변경 시각, 응답 크기).
+// 배속(-x)을 높이면 호출 간격과 TTL을 같은 비율로 줄입니다.
+//
+// 사용법: ./replay [-x speed] [-l latency_us] [-o replay.vrec] <record.vrec>
+#define _POSIX_C_SOURCE 200809L
+#include "../src/vault_client.h"
+#include "mock_vault.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <pthread.h>
+
+#define MAX_THREADS 64
+#define MAX_KV_VERSIONS 4096
+#define MOCK_KV_OVERHEAD 300  // 대역 서버 KV 응답에서 payload를 제외한 크기 (대략)
+
+typedef struct {
+    uint32_t *values;
+    size_t count;
+    size_t capacity;
+} sample_list_t;
+
+// 기록 파일 요약
+typedef struct {
+    long requests[VAULT_ENDPOINT_COUNT];
+    long request_errors[VAULT_ENDPOINT_COUNT];
+    uint64_t request_bytes[VAULT_ENDPOINT_COUNT];
+    sample_list_t request_us[VAULT_ENDPOINT_COUNT];
+    long calls[VAULT_CALL_COUNT];
+    long call_errors[VAULT_CALL_COUNT];
+    sample_list_t call_us[VAULT_CALL_COUNT];
+    uint64_t duration_us;
+
+    // 재생에 필요한 정보 (원본 기록에서만 사용)
+    vault_record_event_t *call_events;
+    size_t call_count;
+    size_t call_capacity;
+    uint64_t kv_change_us[MAX_KV_VERSIONS];  // KV 버전이 바뀐 응답이 관측된 시각
+    size_t kv_changes;
+    int token_ttl;
+    int lease_ttl;
+    int rotation_period;
+} record_summary_t;
+
+// 재생 스레드 (기록 스레드 1개에 대응)
+typedef struct {
+    uint16_t thread;
+    vault_record_event_t *events;
+    size_t count;
+    size_t capacity;
+    long errors;
+} replay_worker_t;
+
+static vault_client_t client;
+static pthread_mutex_t client_mutex = PTHREAD_MUTEX_INITIALIZER;
+static uint64_t replay_start_ns = 0;
+static double speed = 1.0;
+
+static int add_sample(sample_list_t *list, uint32_t value) {
+    if (list->count == list->capacity) {
+        size_t capacity = list->capacity ? list->capacity * 2 : 256;
+        uint32_t *grown = realloc(list->values, capacity * sizeof(uint32_t));
+        if (!grown) return -1;
+        list->values = grown;
+        list->capacity = capacity;
+    }
+    list->values[list->count++] = value;
+    return 0;
+}
+
+static int compare_u32(const void *a, const void *b) {
+    uint32_t x = *(const uint32_t *)a;
+    uint32_t y = *(const uint32_t *)b;
+    return x < y ? -1 : x > y;
+}
+
+static uint32_t percentile(const sample_list_t *list, double p) {
+    if (list->count == 0) return 0;
+    size_t index = (size_t)(p * (double)(list->count - 1) + 0.5);
+    return list->values[index];
+}
+
+// 비식별화된 본문에서 숫자 필드 값 (없으면 -1)
+static long find_number(const char *body, const char *key) {
+    char pattern[64];
+    snprintf(pattern, sizeof(pattern), "\"%s\":", key);
+    const char *p = strstr(body, pattern);
+    if (!p) return -1;
+    p += strlen(pattern);
+    while (*p == ' ') p++;
+    return (*p >= '0' && *p <= '9') ? strtol(p, NULL, 10) : -1;
+}
+
+static int load_record(const char *path, record_summary_t *summary, int keep_calls) {
+    vault_record_reader_t reader;
+    vault_record_event_t event;
+    long kv_version = -1;
+    int rc;
+
+    memset(summary, 0, sizeof(*summary));
+    if (vault_record_reader_open(&reader, path) != 0) {
+        fprintf(stderr, "Failed to open record file: %s\n", path);
+        return -1;
+    }
+
+    while ((rc = vault_record_next(&reader, &event)) == 1) {
+        uint64_t end_us = event.offset_us + event.duration_us;
+        if (end_us > summary->duration_us) summary->duration_us = end_us;
+
+        if (event.type == VAULT_RECORD_REQUEST && event.kind < VAULT_ENDPOINT_COUNT) {
+            vault_endpoint_t endpoint = (vault_endpoint_t)event.kind;
+            summary->requests[endpoint]++;
+            summary->request_bytes[endpoint] += event.response_size;
+            if (event.status <= 0 || event.status >= 400) summary->request_errors[endpoint]++;
+            add_sample(&summary->request_us[endpoint], event.duration_us);
+
+            if (!keep_calls || event.status != 200) continue;
+            long value;
+            if (endpoint == VAULT_ENDPOINT_LOGIN && summary->token_ttl == 0 &&
+                (value = find_number(reader.body, "lease_duration")) > 0) {
+                summary->token_ttl = (int)value;
+            } else if (endpoint == VAULT_ENDPOINT_DB_CREDS && summary->lease_ttl == 0 &&
+                       (value = find_number(reader.body, "lease_duration")) > 0) {
+                summary->lease_ttl = (int)value;
+            } else if (endpoint == VAULT_ENDPOINT_DB_STATIC_CREDS && summary->rotation_period == 0 &&
+                       (value = find_number(reader.body, "rotation_period")) > 0) {
+                summary->rotation_period = (int)value;
+            } else if (endpoint == VAULT_ENDPOINT_KV_DATA && (value = find_number(reader.body, "version")) > 0) {
+                if (kv_version >= 0 && value > kv_version && summary->kv_changes < MAX_KV_VERSIONS) {
+                    summary->kv_change_us[summary->kv_changes++] = event.offset_us;
+                }
+                if (value > kv_version) kv_version = value;
+            }
+        } else if (event.type == VAULT_RECORD_CALL && event.kind < VAULT_CALL_COUNT) {
+            summary->calls[event.kind]++;
+            if (event.status != 0) summary->call_errors[event.kind]++;
+            add_sample(&summary->call_us[event.kind], event.duration_us);
+
+            if (!keep_calls) continue;
+            if (summary->call_count == summary->call_capacity) {
+                size_t capacity = summary->call_capacity ? summary->call_capacity * 2 : 256;
+                vault_record_event_t *grown = realloc(summary->call_events, capacity * sizeof(event));
+                if (!grown) break;
+                summary->call_events = grown;
+                summary->call_capacity = capacity;
+            }
+            summary->call_events[summary->call_count++] = event;
+        }
+    }
+    vault_record_reader_close(&reader);
+
+    if (rc < 0) {
+        fprintf(stderr, "Warning: %s is truncated, using events read so far\n", path);
+    }
+    for (int e = 0; e < VAULT_ENDPOINT_COUNT; e++) {
+        qsort(summary->request_us[e].values, summary->request_us[e].count, sizeof(uint32_t), compare_u32);
+    }
+    for (int c = 0; c < VAULT_CALL_COUNT; c++) {
+        qsort(summary->call_us[c].values, summary->call_us[c].count, sizeof(uint32_t), compare_u32);
+    }
+    return 0;
+}
+
+static void free_summary(record_summary_t *summary) {
+    for (int e = 0; e < VAULT_ENDPOINT_COUNT; e++) free(summary->request_us[e].values);
+    for (int c = 0; c < VAULT_CALL_COUNT; c++) free(summary->call_us[c].values);
+    free(summary->call_events);
+}
+
+// 기록 시각(us)을 배속을 적용한 재생 시각까지 대기
+static void sleep_until(uint64_t offset_us) {
+    uint64_t target = replay_start_ns + (uint64_t)((double)offset_us * 1000.0 / speed);
+    uint64_t now = vault_metrics_now_ns();
+    if (target <= now) return;
+    struct timespec wait;
+    wait.tv_sec = (time_t)((target - now) / 1000000000ULL);
+    wait.tv_nsec = (long)((target - now) % 1000000000ULL);
+    nanosleep(&wait, NULL);
+}
+
+static int replay_call(vault_call_t call) {
+    json_object *secret = NULL;
+    int rc;
+    switch (call) {
+        case VAULT_CALL_LOGIN:
+            rc = vault_login(&client, client.config->vault_role_id, client.config->vault_secret_id);
+            break;
+        case VAULT_CALL_REFRESH_TOKEN: rc = vault_refresh_token(&client); break;
+        case VAULT_CALL_GET_KV: rc = vault_get_kv_secret(&client, &secret); break;
+        case VAULT_CALL_GET_DB_DYNAMIC: rc = vault_get_db_dynamic_secret(&client, &secret); break;
+        case VAULT_CALL_GET_DB_STATIC: rc = vault_get_db_static_secret(&client, &secret); break;
+        case VAULT_CALL_REFRESH_KV: rc = vault_refresh_kv_secret(&client); break;
+        case VAULT_CALL_REFRESH_DB_DYNAMIC: rc = vault_refresh_db_dynamic_secret(&client); break;
+        case VAULT_CALL_REFRESH_DB_STATIC: rc = vault_refresh_db_static_secret(&client); break;
+        default: rc = -1; break;
+    }
+    if (secret) {
+        vault_cleanup_secret(secret);
+    }
+    return rc;
+}
+
+static void *replay_thread(void *arg) {
+    replay_worker_t *worker = (replay_worker_t *)arg;
+    for (size_t i = 0; i < worker->count; i++) {
+        sleep_until(worker->events[i].offset_us);
+        // vault_client_t는 스레드 간 동시 호출을 보장하지 않으므로 호출 단위로 직렬화
+        pthread_mutex_lock(&client_mutex);
+        int rc = replay_call((vault_call_t)worker->events[i].kind);
+        pthread_mutex_unlock(&client_mutex);
+        if (rc != 0) worker->errors++;
+    }
+    return NULL;
+}
+
+static int scaled(int seconds, int fallback) {
+    int value = (int)((seconds > 0 ? seconds : fallback) / speed);
+    return value < 2 ? 2 : value;
+}
+
+static void replay_config(app_config_t *config, int port, const record_summary_t *summary) {
+    memset(config, 0, sizeof(*config));
+    snprintf(config->vault_url, sizeof(config->vault_url), "http://127.0.0.1:%d", port);
+    snprintf(config->entity, sizeof(config->entity), "replay");
+    snprintf(config->token_type, sizeof(config->token_type), "service");
+    snprintf(config->vault_role_id, sizeof(config->vault_role_id), "role");
+    snprintf(config->vault_secret_id, sizeof(config->vault_secret_id), "secret");
+    config->secret_kv.enabled = summary->calls[VAULT_CALL_GET_KV] + summary->calls[VAULT_CALL_REFRESH_KV] > 0;
+    snprintf(config->secret_kv.kv_path, sizeof(config->secret_kv.kv_path), "database");
+    config->secret_kv.refresh_interval = DEFAULT_KV_REFRESH_INTERVAL;
+    config->secret_database_dynamic.enabled =
+        summary->calls[VAULT_CALL_GET_DB_DYNAMIC] + summary->calls[VAULT_CALL_REFRESH_DB_DYNAMIC] > 0;
+    snprintf(config->secret_database_dynamic.role_id, sizeof(config->secret_database_dynamic.role_id), "db-demo-dynamic");
+    config->secret_database_static.enabled =
+        summary->calls[VAULT_CALL_GET_DB_STATIC] + summary->calls[VAULT_CALL_REFRESH_DB_STATIC] > 0;
+    snprintf(config->secret_database_static.role_id, sizeof(config->secret_database_static.role_id), "db-demo-static");
+    config->http_timeout = 5;
+    config->max_response_size = DEFAULT_MAX_RESPONSE_SIZE;
+    config->schedule.renew_window_min = DEFAULT_RENEW_WINDOW_MIN;
+    config->schedule.renew_window_max = DEFAULT_RENEW_WINDOW_MAX;
+    config->schedule.refresh_jitter = DEFAULT_REFRESH_JITTER;
+    config->schedule.host_phase = 1;
+    strncpy(config->trace.format, DEFAULT_TRACE_FORMAT, sizeof(config->trace.format) - 1);
+}
+
+static void print_row(const char *name, long recorded, long replayed, const sample_list_t *rec_us,
+                      const sample_list_t *rep_us, long rec_errors, long rep_errors) {
+    printf("  %-20s %9ld %9ld %+8ld %10.2f %10.2f %10.2f %10.2f %6ld %6ld\n", name, recorded, replayed,
+           replayed - recorded, percentile(rec_us, 0.50) / 1000.0, percentile(rec_us, 0.99) / 1000.0,
+           percentile(rep_us, 0.50) / 1000.0, percentile(rep_us, 0.99) / 1000.0, rec_errors, rep_errors);
+}
+
+static void usage(const char *program) {
+    fprintf(stderr, "Usage: %s [-x speed] [-l latency_us] [-o replay.vrec] <record.vrec>\n", program);
+    fprintf(stderr, "  speed: 1 ~ 100 (default 1)\n");
+}
+
+int main(int argc, char *argv[]) {
+    int latency_us = 0;
+    const char *output = NULL;
+    int c;
+    while ((c = getopt(argc, argv, "x:l:o:")) != -1) {
+        switch (c) {
+            case 'x': speed = atof(optarg); break;
+            case 'l': latency_us = atoi(optarg); break;
+            case 'o': output = optarg; break;
+            default:
+                usage(argv[0]);
+                return 1;
+        }
+    }
+    if (optind >= argc || speed < 1.0 || speed > 100.0) {
+        usage(argv[0]);
+        return 1;
+    }
+    const char *input = argv[optind];
+
+    record_summary_t *recorded = malloc(sizeof(record_summary_t));
+    record_summary_t *replayed = malloc(sizeof(record_summary_t));
+    if (!recorded || !replayed) return 1;
+    if (load_record(input, recorded, 1) != 0) return 1;
+    if (recorded->call_count == 0) {
+        fprintf(stderr, "No API calls in %s\n", input);
+        return 1;
+    }
+
+    // 기록 스레드별 호출 목록 (기록은 호출 종료 순서이므로 시작 시각으로 정렬된 상태가 아닐 수 있음)
+    replay_worker_t workers[MAX_THREADS];
+    int worker_count = 0;
+    memset(workers, 0, sizeof(workers));
+    for (size_t i = 0; i < recorded->call_count; i++) {
+        vault_record_event_t *event = &recorded->call_events[i];
+        int w;
+        for (w = 0; w < worker_count && workers[w].thread != event->thread; w++) {
+        }
+        if (w == worker_count) {
+            if (worker_count == MAX_THREADS) continue;
+            workers[worker_count++].thread = event->thread;
+        }
+        replay_worker_t *worker = &workers[w];
+        if (worker->count == worker->capacity) {
+            size_t capacity = worker->capacity ? worker->capacity * 2 : 64;
+            vault_record_event_t *grown = realloc(worker->events, capacity * sizeof(*grown));
+            if (!grown) return 1;
+            worker->events = grown;
+            worker->capacity = capacity;
+        }
+        // 삽입 정렬 (스레드 내 호출은 대부분 이미 순서대로임)
+        size_t pos = worker->count++;
+        while (pos > 0 && worker->events[pos - 1].offset_us > event->offset_us) {
+            worker->events[pos] = worker->events[pos - 1];
+            pos--;
+        }
+        worker->events[pos] = *event;
+    }
+
+    // 기록에서 추정한 대역 서버 설정 (TTL은 배속만큼 줄임)
+    mock_vault_options_t server_options;
+    mock_vault_default_options(&server_options);
+    server_options.token_ttl = scaled(recorded->token_ttl, 3600);
+    server_options.token_max_ttl = server_options.token_ttl * 24;
+    server_options.lease_ttl = scaled(recorded->lease_ttl, server_options.lease_ttl);
+    server_options.rotation_period = scaled(recorded->rotation_period, server_options.rotation_period);
+    server_options.latency_us = latency_us;
+    if (recorded->requests[VAULT_ENDPOINT_KV_DATA] > 0) {
+        long average = (long)(recorded->request_bytes[VAULT_ENDPOINT_KV_DATA] / recorded->requests[VAULT_ENDPOINT_KV_DATA]);
+        server_options.payload_size = average > MOCK_KV_OVERHEAD + 16 ? (int)(average - MOCK_KV_OVERHEAD) : 16;
+    }
+
+    curl_global_init(CURL_GLOBAL_DEFAULT);
+    mock_vault_t *server = mock_vault_start(&server_options);
+    if (!server) return 1;
+
+    app_config_t config;
+    replay_config(&config, mock_vault_port(server), recorded);
+
+    char default_output[64];
+    if (!output) {
+        snprintf(default_output, sizeof(default_output), "/tmp/vault-replay-%ld.vrec", (long)getpid());
+    }
+    const char *replay_path = output ? output : default_output;
+
+    printf("=== Vault Traffic Replay ===\n");
+    printf("record=%s duration=%.1fs calls=%zu threads=%d speed=%.0fx (replay ~%.1fs)\n", input,
+           recorded->duration_us / 1e6, recorded->call_count, worker_count, speed,
+           recorded->duration_us / 1e6 / speed);
+    printf("mock: token_ttl=%ds lease_ttl=%ds rotation_period=%ds payload=%dB latency=%dus kv_updates=%zu\n",
+           server_options.token_ttl, server_options.lease_ttl, server_options.rotation_period,
+           server_options.payload_size, latency_us, recorded->kv_changes);
+    fflush(stdout);
+
+    // 클라이언트 로그 출력은 측정에 방해되므로 실행 중에는 버림
+    int saved_stdout = dup(STDOUT_FILENO);
+    int devnull = open("/dev/null", O_WRONLY);
+    dup2(devnull, STDOUT_FILENO);
+
+    vault_client_init(&client, &config);
+    if (recorded->calls[VAULT_CALL_LOGIN] == 0) {
+        vault_login(&client, config.vault_role_id, config.vault_secret_id);
+    }
+    vault_record_open(replay_path);
+
+    pthread_t threads[MAX_THREADS];
+    replay_start_ns = vault_metrics_now_ns();
+    for (int w = 0; w < worker_count; w++) {
+        pthread_create(&threads[w], NULL, replay_thread, &workers[w]);
+    }
+
+    // KV 버전 변경을 기록된 시각에 맞춰 재현
+    for (size_t i = 0; i < recorded->kv_changes; i++) {
+        sleep_until(recorded->kv_change_us[i]);
+        mock_vault_bump_kv_version(server);
+    }
+
+    long replay_errors = 0;
+    for (int w = 0; w < worker_count; w++) {
+        pthread_join(threads[w], NULL);
+        replay_errors += workers[w].errors;
+        free(workers[w].events);
+    }
+    double elapsed = (double)(vault_metrics_now_ns() - replay_start_ns) / 1e9;
+    vault_record_close();
+
+    fflush(stdout);
+    dup2(saved_stdout, STDOUT_FILENO);
+    close(devnull);
+
+    if (load_record(replay_path, replayed, 0) != 0) return 1;
+
+    printf("replayed in %.2fs, %ld call errors\n", elapsed, replay_errors);
+    printf("\n%-22s %9s %9s %8s %10s %10s %10s %10s %6s %6s\n", "Vault requests", "recorded", "replayed", "diff",
+           "rec_p50ms", "rec_p99ms", "rep_p50ms", "rep_p99ms", "r_err", "p_err");
+    long total_recorded = 0, total_replayed = 0;
+    for (int e = 0; e < VAULT_ENDPOINT_COUNT; e++) {
+        if (recorded->requests[e] == 0 && replayed->requests[e] == 0) continue;
+        print_row(vault_metrics_endpoint_name((vault_endpoint_t)e), recorded->requests[e], replayed->requests[e],
+                  &recorded->request_us[e], &replayed->request_us[e],
+                  recorded->request_errors[e], replayed->request_errors[e]);
+        total_recorded += recorded->requests[e];
+        total_replayed += replayed->requests[e];
+    }
+    printf("  %-20s %9ld %9ld %+8ld\n", "total", total_recorded, total_replayed, total_replayed - total_recorded);
+
+    printf("\n%-22s %9s %9s %8s %10s %10s %10s %10s %6s %6s\n", "API calls", "recorded", "replayed", "diff",
+           "rec_p50ms", "rec_p99ms", "rep_p50ms", "rep_p99ms", "r_err", "p_err");
+    for (int k = 0; k < VAULT_CALL_COUNT; k++) {
+        if (recorded->calls[k] == 0 && replayed->calls[k] == 0) continue;
+        print_row(vault_record_call_name((vault_call_t)k), recorded->calls[k], replayed->calls[k],
+                  &recorded->call_us[k], &replayed->call_us[k], recorded->call_errors[k], replayed->call_errors[k]);
+    }
+
+    mock_vault_stats_t stats;
+    mock_vault_get_stats(server, &stats);
+    printf("\nMock server: requests=%ld logins=%ld renewals=%ld kv_reads=%ld db_creds=%ld "
+           "db_static_reads=%ld lease_lookups=%ld bytes_sent=%ld\n", stats.requests, stats.logins, stats.renewals,
+           stats.kv_reads, stats.db_creds, stats.db_static_reads, stats.lease_lookups, stats.bytes_sent);
+    if (output) {
+        printf("Replay record written to %s\n", output);
+    } else {
+        unlink(replay_path);
+    }
+
+    vault_client_cleanup(&client);
+    mock_vault_stop(server);
+    free_summary(recorded);
+    free_summary(replayed);
+    free(recorded);
+    free(replayed);
+    curl_global_cleanup();
+    return 0;
+}
@@ -0,0 +1,289 @@
+// 장애 시나리오별 클라이언트 복원력 벤치마크
+// mock_vault 앞에 장애 주입 프록시(fault_proxy)를 두고, N개의 클라이언트가 main.c와 같은 방식으로
+// 토큰을 갱신하면서 KV / Database Static 시크릿을 주기적으로 조회합니다.
+// 시나리오 단계별로 시크릿 가용성(조회 성공률), 반환된 데이터의 최대 경과 시간(staleness),
+// 조회 지연 시간 분포, 토큰 갱신 실패 수를 출력합니다.
+//
+// 사용법: ./resilience-bench [-n clients] [-s scenario_file] [-i read_interval_ms]
+//                            [-t http_timeout] [-T token_ttl] [-c]
+#define _POSIX_C_SOURCE 200809L
+#include "../src/vault_client.h"
+#include "mock_vault.h"
+#include "fault_proxy.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <pthread.h>
+
+// 단계별 집계 (스레드별)
+typedef struct {
+    long reads;
+    long successes;
+    long max_staleness;  // 성공한 조회가 반환한 데이터의 최대 경과 시간 (초)
+    long token_failures;
+    uint32_t *latencies;  // 조회 지연 시간 (us)
+    size_t count;
+    size_t capacity;
+} phase_result_t;
+
+typedef struct {
+    app_config_t config;
+    vault_client_t client;
+    fault_proxy_t *proxy;
+    int phases;
+    int interval_ms;
+    int logged_in;
+    phase_result_t results[FAULT_MAX_PHASES];
+} bench_worker_t;
+
+static int start_flag = 0;
+
+static void record(phase_result_t *result, uint64_t latency_ns, int success, long staleness) {
+    result->reads++;
+    if (success) {
+        result->successes++;
+        if (staleness > result->max_staleness) result->max_staleness = staleness;
+    }
+    if (result->count == result->capacity) {
+        size_t capacity = result->capacity ? result->capacity * 2 : 256;
+        uint32_t *grown = realloc(result->latencies, capacity * sizeof(uint32_t));
+        if (!grown) return;
+        result->latencies = grown;
+        result->capacity = capacity;
+    }
+    uint64_t us = latency_ns / 1000;
+    result->latencies[result->count++] = us > UINT32_MAX ? UINT32_MAX : (uint32_t)us;
+}
+
+static void *worker_thread(void *arg) {
+    bench_worker_t *worker = (bench_worker_t *)arg;
+    vault_client_t *client = &worker->client;
+    struct timespec interval = {worker->interval_ms / 1000, (worker->interval_ms % 1000) * 1000000L};
+    time_t retry_at = 0;
+
+    worker->logged_in = vault_login(client, worker->config.vault_role_id, worker->config.vault_secret_id) == 0;
+    while (!__atomic_load_n(&start_flag, __ATOMIC_ACQUIRE)) {
+        nanosleep(&interval, NULL);
+    }
+    if (!worker->logged_in) return NULL;
+
+    unsigned long iteration = 0;
+    for (;;) {
+        int phase = fault_proxy_phase(worker->proxy);
+        if (phase < 0 || phase >= worker->phases) break;
+        phase_result_t *result = &worker->results[phase];
+
+        // 토큰 갱신 (main.c의 token_renewal_thread와 같은 규칙)
+        vault_token_t *token = vault_token_acquire(client);
+        time_t now = time(NULL);
+        if (token && now >= token->renewal_at && now >= retry_at) {
+            if (vault_refresh_token(client) != 0) {
+                result->token_failures++;
+                retry_at = now + 1;
+            }
+        }
+        vault_token_release(token);
+
+        // KV와 Database Static을 번갈아 조회
+        json_object *secret = NULL;
+        int kv = iteration++ % 2 == 0;
+        uint64_t start = vault_metrics_now_ns();
+        int rc = kv ? vault_get_kv_secret(client, &secret) : vault_get_db_static_secret(client, &secret);
+        uint64_t elapsed = vault_metrics_now_ns() - start;
+        time_t refreshed = kv ? client->kv_last_refresh : client->db_static_last_refresh;
+        record(result, elapsed, rc == 0 && secret != NULL, (long)(time(NULL) - refreshed));
+        if (secret) {
+            vault_cleanup_secret(secret);
+        }
+
+        nanosleep(&interval, NULL);
+    }
+    return NULL;
+}
+
+static int compare_u32(const void *a, const void *b) {
+    uint32_t x = *(const uint32_t *)a;
+    uint32_t y = *(const uint32_t *)b;
+    return x < y ? -1 : x > y;
+}
+
+static double percentile_ms(const uint32_t *sorted, size_t count, double p) {
+    if (count == 0) return 0.0;
+    return sorted[(size_t)(p * (double)(count - 1) + 0.5)] / 1000.0;
+}
+
+static void describe_phase(const fault_phase_t *phase, char *buffer, size_t size) {
+    switch (phase->kind) {
+        case FAULT_DELAY: snprintf(buffer, size, "delay %d+%dms", phase->delay_ms, phase->jitter_ms); break;
+        case FAULT_ERROR: snprintf(buffer, size, "%d x%.0f%%", phase->status, phase->probability * 100); break;
+        case FAULT_TRUNCATE:
+        case FAULT_DROP:
+        case FAULT_REFUSE:
+            snprintf(buffer, size, "%s x%.0f%%", fault_kind_name(phase->kind), phase->probability * 100);
+            break;
+        case FAULT_FLAP: snprintf(buffer, size, "flap %ds", phase->flap_period); break;
+        default: snprintf(buffer, size, "pass"); break;
+    }
+}
+
+int main(int argc, char *argv[]) {
+    int clients = 4, interval_ms = 100, http_timeout = 2, token_ttl = 20, csv = 0;
+    const char *scenario_file = NULL;
+    int c;
+    while ((c = getopt(argc, argv, "n:s:i:t:T:c")) != -1) {
+        switch (c) {
+            case 'n': clients = atoi(optarg); break;
+            case 's': scenario_file = optarg; break;
+            case 'i': interval_ms = atoi(optarg); break;
+            case 't': http_timeout = atoi(optarg); break;
+            case 'T': token_ttl = atoi(optarg); break;
+            case 'c': csv = 1; break;
+            default:
+                fprintf(stderr, "Usage: %s [-n clients] [-s scenario_file] [-i read_interval_ms] "
+                                "[-t http_timeout] [-T token_ttl] [-c]\n", argv[0]);
+                return 1;
+        }
+    }
+    if (clients <= 0 || interval_ms <= 0 || http_timeout <= 0 || token_ttl < 4) {
+        fprintf(stderr, "Invalid options\n");
+        return 1;
+    }
+
+    fault_scenario_t scenario;
+    if (scenario_file) {
+        if (fault_scenario_load(scenario_file, &scenario) != 0) return 1;
+    } else {
+        fault_scenario_default(&scenario);
+    }
+
+    curl_global_init(CURL_GLOBAL_DEFAULT);
+
+    mock_vault_options_t server_options;
+    mock_vault_default_options(&server_options);
+    server_options.token_ttl = token_ttl;
+    server_options.token_max_ttl = token_ttl * 100;
+    server_options.kv_update_interval = 10;
+    mock_vault_t *server = mock_vault_start(&server_options);
+    fault_proxy_t *proxy = server ? fault_proxy_start(0, mock_vault_port(server), &scenario) : NULL;
+    if (!proxy) return 1;
+
+    bench_worker_t *workers = calloc(clients, sizeof(bench_worker_t));
+    pthread_t *threads = calloc(clients, sizeof(pthread_t));
+    if (!workers || !threads) return 1;
+
+    int total_seconds = 0;
+    for (int p = 0; p < scenario.count; p++) total_seconds += scenario.phases[p].duration;
+    fprintf(stderr, "Running %d phases (%ds) with %d clients...\n", scenario.count, total_seconds, clients);
+
+    // 클라이언트 로그 출력은 결과 집계에 방해되므로 실행 중에는 버림
+    fflush(stdout);
+    int saved_stdout = dup(STDOUT_FILENO);
+    int devnull = open("/dev/null", O_WRONLY);
+    dup2(devnull, STDOUT_FILENO);
+    int saved_stderr = dup(STDERR_FILENO);
+    dup2(devnull, STDERR_FILENO);
+
+    for (int i = 0; i < clients; i++) {
+        app_config_t *config = &workers[i].config;
+        snprintf(config->vault_url, sizeof(config->vault_url), "http://127.0.0.1:%d", fault_proxy_port(proxy));
+        snprintf(config->entity, sizeof(config->entity), "bench-%d", i);
+        snprintf(config->token_type, sizeof(config->token_type), "service");
+        snprintf(config->vault_role_id, sizeof(config->vault_role_id), "role");
+        snprintf(config->vault_secret_id, sizeof(config->vault_secret_id), "secret");
+        config->secret_kv.enabled = 1;
+        snprintf(config->secret_kv.kv_path, sizeof(config->secret_kv.kv_path), "database");
+        config->secret_kv.refresh_interval = DEFAULT_KV_REFRESH_INTERVAL;
+        config->secret_database_static.enabled = 1;
+        snprintf(config->secret_database_static.role_id, sizeof(config->secret_database_static.role_id), "db-demo-static");
+        config->http_timeout = http_timeout;
+        config->max_response_size = DEFAULT_MAX_RESPONSE_SIZE;
+        config->schedule.renew_window_min = DEFAULT_RENEW_WINDOW_MIN;
+        config->schedule.renew_window_max = DEFAULT_RENEW_WINDOW_MAX;
+        config->schedule.refresh_jitter = DEFAULT_REFRESH_JITTER;
+
+        workers[i].proxy = proxy;
+        workers[i].phases = scenario.count;
+        workers[i].interval_ms = interval_ms;
+        vault_client_init(&workers[i].client, config);
+        pthread_create(&threads[i], NULL, worker_thread, &workers[i]);
+    }
+
+    // 로그인은 장애 주입 전에 끝냄
+    sleep(1);
+    fault_proxy_begin(proxy);
+    __atomic_store_n(&start_flag, 1, __ATOMIC_RELEASE);
+
+    int failed_logins = 0;
+    for (int i = 0; i < clients; i++) {
+        pthread_join(threads[i], NULL);
+        if (!workers[i].logged_in) failed_logins++;
+    }
+
+    fflush(stdout);
+    dup2(saved_stdout, STDOUT_FILENO);
+    dup2(saved_stderr, STDERR_FILENO);
+    close(devnull);
+
+    fault_phase_stats_t proxy_stats[FAULT_MAX_PHASES];
+    fault_proxy_get_stats(proxy, proxy_stats);
+
+    if (csv) {
+        printf("phase,fault,proxy_requests,injected,reads,availability,p50_ms,p99_ms,max_ms,max_staleness_s,token_failures\n");
+    } else {
+        printf("=== Resilience Benchmark ===\n");
+        printf("clients=%d read_interval=%dms http_timeout=%ds token_ttl=%ds\n", clients, interval_ms,
+               http_timeout, token_ttl);
+        if (failed_logins > 0) printf("WARNING: %d clients failed to log in\n", failed_logins);
+        printf("\n%-16s %-16s %8s %8s %7s %7s %9s %9s %9s %7s %6s\n", "phase", "fault", "px.req", "injected",
+               "reads", "avail%", "p50_ms", "p99_ms", "max_ms", "stale_s", "tok.f");
+    }
+
+    for (int p = 0; p < scenario.count; p++) {
+        phase_result_t merged = {0};
+        for (int i = 0; i < clients; i++) {
+            phase_result_t *r = &workers[i].results[p];
+            merged.reads += r->reads;
+            merged.successes += r->successes;
+            merged.token_failures += r->token_failures;
+            if (r->max_staleness > merged.max_staleness) merged.max_staleness = r->max_staleness;
+            merged.count += r->count;
+        }
+        uint32_t *all = malloc((merged.count ? merged.count : 1) * sizeof(uint32_t));
+        if (!all) return 1;
+        size_t offset = 0;
+        for (int i = 0; i < clients; i++) {
+            phase_result_t *r = &workers[i].results[p];
+            memcpy(all + offset, r->latencies, r->count * sizeof(uint32_t));
+            offset += r->count;
+        }
+        qsort(all, merged.count, sizeof(uint32_t), compare_u32);
+
+        char fault[32];
+        describe_phase(&scenario.phases[p], fault, sizeof(fault));
+        double availability = merged.reads ? 100.0 * merged.successes / merged.reads : 0.0;
+        printf(csv ? "%s,%s,%ld,%ld,%ld,%.2f,%.2f,%.2f,%.2f,%ld,%ld\n"
+                   : "%-16s %-16s %8ld %8ld %7ld %7.2f %9.2f %9.2f %9.2f %7ld %6ld\n",
+               scenario.phases[p].name, fault, proxy_stats[p].requests, proxy_stats[p].injected,
+               merged.reads, availability, percentile_ms(all, merged.count, 0.50),
+               percentile_ms(all, merged.count, 0.99), merged.count ? all[merged.count - 1] / 1000.0 : 0.0,
+               merged.max_staleness, merged.token_failures);
+        free(all);
+    }
+
+    if (!csv) {
+        printf("\navail%%: reads that returned a secret, stale_s: max age of returned data (since last successful refresh)\n");
+    }
+
+    for (int i = 0; i < clients; i++) {
+        vault_client_cleanup(&workers[i].client);
+        for (int p = 0; p < scenario.count; p++) free(workers[i].results[p].latencies);
+    }
+    fault_proxy_stop(proxy);
+    mock_vault_stop(server);
+    free(workers);
+    free(threads);
+    curl_global_cleanup();
+    return 0;
+}
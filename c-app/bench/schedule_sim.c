@@ -0,0 +1,203 @@
+// 주기 작업 분산 시뮬레이션 벤치마크
+// N개의 클라이언트가 동시에 기동되었을 때 초당 Vault 요청 수 분포를
+// 기존 방식(고정 4/5 갱신, 고정 간격)과 jitter 정책 적용 시로 비교합니다.
+//
+// 사용법: ./schedule-sim [-n clients] [-d seconds] [-t token_ttl] [-i refresh_interval]
+//                        [-r rollout_seconds] [-b bucket_seconds] [-c]
+#define _POSIX_C_SOURCE 200809L
+#include "../src/vault_schedule.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+// 시뮬레이션 대상 주기 작업
+enum { TASK_TOKEN, TASK_KV, TASK_DB_DYNAMIC, TASK_DB_STATIC, TASK_COUNT };
+
+typedef struct {
+    int clients;
+    int duration;
+    int token_ttl;
+    int refresh_interval;
+    int rollout;
+    int bucket;
+    int csv;
+} sim_options_t;
+
+typedef struct {
+    long total;
+    int peak;
+    int p99;
+    double mean;
+} sim_summary_t;
+
+static int compare_int(const void *a, const void *b) {
+    return *(const int *)a - *(const int *)b;
+}
+
+// 기존 방식: 모든 작업이 기동 시점 기준 고정 간격, 토큰은 10초 주기 확인 후 4/5 지점에서 갱신
+static void simulate_lockstep(const sim_options_t *opt, int *rate) {
+    for (int c = 0; c < opt->clients; c++) {
+        int start = opt->rollout > 0 ? (int)((long)c * opt->rollout / opt->clients) : 0;
+        int issued = start;
+        int intervals[TASK_COUNT] = {10, opt->refresh_interval, opt->refresh_interval, opt->refresh_interval * 2};
+
+        if (start < opt->duration) rate[start]++;  // 로그인
+        for (int t = start + 1; t < opt->duration; t++) {
+            int since = t - start;
+            if (since % intervals[TASK_TOKEN] == 0 && t - issued >= opt->token_ttl * 4 / 5) {
+                rate[t]++;
+                issued = t;
+            }
+            for (int k = TASK_KV; k < TASK_COUNT; k++) {
+                if (since % intervals[k] == 0) rate[t]++;
+            }
+        }
+    }
+}
+
+// jitter 정책: 갱신 구간 내 무작위 갱신 + 호스트 해시 위상 + 간격 변동
+static void simulate_jittered(const sim_options_t *opt, const app_config_t *config, int *rate) {
+    static const char *task_names[TASK_COUNT] = {"token", "kv", "database-dynamic", "database-static"};
+
+    for (int c = 0; c < opt->clients; c++) {
+        char host[64];
+        snprintf(host, sizeof(host), "vault-app-%d", c);
+
+        vault_schedule_t schedule;
+        vault_schedule_init_with_host(&schedule, config, host);
+        schedule.rng_state ^= (uint64_t)c * 0x2545F4914F6CDD1DULL;
+
+        int start = opt->rollout > 0 ? (int)((long)c * opt->rollout / opt->clients) : 0;
+        int intervals[TASK_COUNT] = {0, opt->refresh_interval, opt->refresh_interval, opt->refresh_interval * 2};
+        int next[TASK_COUNT];
+
+        if (start < opt->duration) rate[start]++;  // 로그인
+        next[TASK_TOKEN] = start + (int)vault_schedule_renewal_offset(&schedule, opt->token_ttl);
+        for (int k = TASK_KV; k < TASK_COUNT; k++) {
+            next[k] = start + vault_schedule_phase_offset(&schedule, task_names[k], intervals[k]) +
+                      vault_schedule_next_interval(&schedule, intervals[k]);
+        }
+
+        for (int t = start + 1; t < opt->duration; t++) {
+            if (t >= next[TASK_TOKEN]) {
+                rate[t]++;
+                next[TASK_TOKEN] = t + (int)vault_schedule_renewal_offset(&schedule, opt->token_ttl);
+            }
+            for (int k = TASK_KV; k < TASK_COUNT; k++) {
+                if (t >= next[k]) {
+                    rate[t]++;
+                    next[k] = t + vault_schedule_next_interval(&schedule, intervals[k]);
+                }
+            }
+        }
+    }
+}
+
+// 초당 요청 수 요약 (기동 구간 이후의 정상 상태 기준)
+static sim_summary_t summarize(const sim_options_t *opt, const int *rate) {
+    sim_summary_t summary = {0, 0, 0, 0.0};
+    int from = opt->rollout + opt->refresh_interval * 2;
+    if (from >= opt->duration) from = 0;
+
+    int n = opt->duration - from;
+    int *sorted = malloc(sizeof(int) * n);
+    for (int t = from; t < opt->duration; t++) {
+        summary.total += rate[t];
+        if (rate[t] > summary.peak) summary.peak = rate[t];
+        sorted[t - from] = rate[t];
+    }
+    qsort(sorted, n, sizeof(int), compare_int);
+    summary.p99 = sorted[(int)(n * 0.99)];
+    summary.mean = (double)summary.total / n;
+    free(sorted);
+    return summary;
+}
+
+static void print_profile(const char *label, const sim_options_t *opt, const int *rate, int scale) {
+    printf("\n--- %s: per-%ds peak req/s ---\n", label, opt->bucket);
+    for (int from = 0; from < opt->duration; from += opt->bucket) {
+        int peak = 0;
+        for (int t = from; t < from + opt->bucket && t < opt->duration; t++) {
+            if (rate[t] > peak) peak = rate[t];
+        }
+        int width = scale > 0 ? peak * 60 / scale : 0;
+        printf("%6ds %7d |", from, peak);
+        for (int i = 0; i < width; i++) putchar('#');
+        putchar('\n');
+    }
+}
+
+int main(int argc, char *argv[]) {
+    sim_options_t opt = {2000, 7200, 3600, 300, 0, 300, 0};
+    int c;
+    while ((c = getopt(argc, argv, "n:d:t:i:r:b:c")) != -1) {
+        switch (c) {
+            case 'n': opt.clients = atoi(optarg); break;
+            case 'd': opt.duration = atoi(optarg); break;
+            case 't': opt.token_ttl = atoi(optarg); break;
+            case 'i': opt.refresh_interval = atoi(optarg); break;
+            case 'r': opt.rollout = atoi(optarg); break;
+            case 'b': opt.bucket = atoi(optarg); break;
+            case 'c': opt.csv = 1; break;
+            default:
+                fprintf(stderr, "Usage: %s [-n clients] [-d seconds] [-t token_ttl] [-i refresh_interval] "
+                        "[-r rollout_seconds] [-b bucket_seconds] [-c]\n", argv[0]);
+                return 1;
+        }
+    }
+    if (opt.clients <= 0 || opt.duration <= 0 || opt.token_ttl <= 0 ||
+        opt.refresh_interval <= 0 || opt.bucket <= 0) {
+        fprintf(stderr, "All options must be positive\n");
+        return 1;
+    }
+
+    // 기본 jitter 정책 (config.ini 기본값과 동일)
+    app_config_t config;
+    memset(&config, 0, sizeof(config));
+    strncpy(config.entity, DEFAULT_ENTITY, sizeof(config.entity) - 1);
+    config.schedule.renew_window_min = DEFAULT_RENEW_WINDOW_MIN;
+    config.schedule.renew_window_max = DEFAULT_RENEW_WINDOW_MAX;
+    config.schedule.refresh_jitter = DEFAULT_REFRESH_JITTER;
+    config.schedule.host_phase = 1;
+
+    int *lockstep = calloc(opt.duration, sizeof(int));
+    int *jittered = calloc(opt.duration, sizeof(int));
+    if (!lockstep || !jittered) {
+        fprintf(stderr, "Out of memory\n");
+        return 1;
+    }
+
+    simulate_lockstep(&opt, lockstep);
+    simulate_jittered(&opt, &config, jittered);
+
+    if (opt.csv) {
+        printf("second,lockstep,jittered\n");
+        for (int t = 0; t < opt.duration; t++) {
+            printf("%d,%d,%d\n", t, lockstep[t], jittered[t]);
+        }
+    } else {
+        sim_summary_t a = summarize(&opt, lockstep);
+        sim_summary_t b = summarize(&opt, jittered);
+
+        printf("=== Schedule Simulation ===\n");
+        printf("clients=%d duration=%ds token_ttl=%ds refresh_interval=%ds rollout=%ds\n",
+               opt.clients, opt.duration, opt.token_ttl, opt.refresh_interval, opt.rollout);
+        printf("jitter policy: renew %d%%~%d%% of TTL, interval +/-%d%%, host phase\n\n",
+               config.schedule.renew_window_min, config.schedule.renew_window_max,
+               config.schedule.refresh_jitter);
+        printf("%-10s %10s %10s %8s %8s %10s\n", "mode", "requests", "mean r/s", "p99 r/s", "peak r/s", "peak/mean");
+        printf("%-10s %10ld %10.1f %8d %8d %10.1f\n", "lockstep", a.total, a.mean, a.p99, a.peak,
+               a.mean > 0 ? a.peak / a.mean : 0.0);
+        printf("%-10s %10ld %10.1f %8d %8d %10.1f\n", "jittered", b.total, b.mean, b.p99, b.peak,
+               b.mean > 0 ? b.peak / b.mean : 0.0);
+
+        int scale = a.peak > b.peak ? a.peak : b.peak;
+        print_profile("lockstep", &opt, lockstep, scale);
+        print_profile("jittered", &opt, jittered, scale);
+    }
+
+    free(lockstep);
+    free(jittered);
+    return 0;
+}
@@ -0,0 +1,199 @@
+// 멀티 테넌트 벤치마크
+// 테넌트 수를 늘려 가며 두 가지 운영 방식의 스레드 수, 메모리(RSS), Vault 연결 수를 비교합니다.
+//   isolated: 테넌트마다 프로세스를 띄우던 방식 흉내 (테넌트당 작업 스레드 4개, 연결 풀 없음)
+//   shared:   vault_tenants 풀 (공유 연결 풀 + 작업 스레드 W개)
+//
+// 각 테넌트는 KV / Database Dynamic / Database Static을 모두 사용하며, 짧은 TTL과 갱신 간격으로
+// 지정 시간 동안 실제 토큰 수명주기와 시크릿 갱신을 실행합니다.
+//
+// 사용법: ./tenant-bench [-n tenants,...] [-w workers] [-d seconds] [-t token_ttl]
+#define _POSIX_C_SOURCE 200809L
+#include "../src/vault_tenants.h"
+#include "mock_vault.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+
+#define MAX_TENANT_COUNTS 8
+
+typedef struct {
+    int counts[MAX_TENANT_COUNTS];
+    int count_len;
+    int workers;
+    int duration;
+    int token_ttl;
+} bench_options_t;
+
+typedef struct {
+    int threads;        // 클라이언트 작업 스레드 수
+    long rss_kb;        // 실행 중 RSS 증가분
+    long logins;
+    long requests;
+    long connections;
+    long namespaced;
+    int ready;
+} bench_result_t;
+
+static long current_rss_kb(void) {
+    FILE *fp = fopen("/proc/self/statm", "r");
+    if (!fp) return -1;
+    long size = 0, resident = 0;
+    if (fscanf(fp, "%ld %ld", &size, &resident) != 2) resident = -1;
+    fclose(fp);
+    return resident < 0 ? -1 : resident * (sysconf(_SC_PAGESIZE) / 1024);
+}
+
+static void make_tenant_config(app_config_t *config, int port, int index) {
+    memset(config, 0, sizeof(*config));
+    snprintf(config->vault_url, sizeof(config->vault_url), "http://127.0.0.1:%d", port);
+    snprintf(config->vault_namespace, sizeof(config->vault_namespace), "team-%d", index);
+    snprintf(config->entity, sizeof(config->entity), "tenant-%d", index);
+    snprintf(config->token_type, sizeof(config->token_type), "service");
+    snprintf(config->vault_role_id, sizeof(config->vault_role_id), "role-%d", index);
+    snprintf(config->vault_secret_id, sizeof(config->vault_secret_id), "secret-%d", index);
+    config->secret_kv.enabled = 1;
+    snprintf(config->secret_kv.kv_path, sizeof(config->secret_kv.kv_path), "database");
+    config->secret_kv.refresh_interval = 1;
+    config->secret_database_dynamic.enabled = 1;
+    snprintf(config->secret_database_dynamic.role_id, sizeof(config->secret_database_dynamic.role_id), "db-dynamic");
+    config->secret_database_static.enabled = 1;
+    snprintf(config->secret_database_static.role_id, sizeof(config->secret_database_static.role_id), "db-static");
+    config->schedule.renew_window_min = DEFAULT_RENEW_WINDOW_MIN;
+    config->schedule.renew_window_max = DEFAULT_RENEW_WINDOW_MAX;
+    config->schedule.refresh_jitter = DEFAULT_REFRESH_JITTER;
+    config->schedule.host_phase = 1;
+    config->http_timeout = 2;
+    config->max_response_size = DEFAULT_MAX_RESPONSE_SIZE;
+}
+
+static int run_mode(const bench_options_t *opt, int tenants, int shared, bench_result_t *result) {
+    mock_vault_options_t server_options;
+    mock_vault_default_options(&server_options);
+    server_options.token_ttl = opt->token_ttl;
+    server_options.token_max_ttl = opt->token_ttl * 10;
+
+    mock_vault_t *server = mock_vault_start(&server_options);
+    if (!server) return -1;
+
+    app_config_t *configs = calloc((size_t)tenants, sizeof(app_config_t));
+    if (!configs) return -1;
+    for (int i = 0; i < tenants; i++) {
+        make_tenant_config(&configs[i], mock_vault_port(server), i);
+    }
+
+    long base_rss = current_rss_kb();
+
+    vault_tenants_t pool;
+    int workers = shared ? opt->workers : tenants * VAULT_TENANT_TASK_COUNT;
+    if (vault_tenants_init(&pool, configs, (size_t)tenants, workers, shared) != 0 ||
+        vault_tenants_start(&pool) != 0) {
+        mock_vault_stop(server);
+        free(configs);
+        return -1;
+    }
+    free(configs);
+
+    for (int i = 0; i < opt->duration; i++) {
+        sleep(1);
+    }
+
+    mock_vault_stats_t stats;
+    mock_vault_get_stats(server, &stats);
+    vault_tenants_stats_t tenant_stats;
+    vault_tenants_get_stats(&pool, &tenant_stats);
+
+    result->threads = pool.worker_count;
+    result->rss_kb = current_rss_kb() - base_rss;
+    result->logins = stats.logins;
+    result->requests = stats.requests;
+    result->connections = stats.connections;
+    result->namespaced = stats.namespaced;
+    result->ready = (int)tenant_stats.ready;
+
+    vault_tenants_destroy(&pool);
+    mock_vault_stop(server);
+    return 0;
+}
+
+static int parse_counts(const char *arg, bench_options_t *opt) {
+    char buffer[128];
+    snprintf(buffer, sizeof(buffer), "%s", arg);
+    opt->count_len = 0;
+    for (char *tok = strtok(buffer, ","); tok && opt->count_len < MAX_TENANT_COUNTS; tok = strtok(NULL, ",")) {
+        int n = atoi(tok);
+        if (n <= 0) return -1;
+        opt->counts[opt->count_len++] = n;
+    }
+    return opt->count_len > 0 ? 0 : -1;
+}
+
+int main(int argc, char *argv[]) {
+    bench_options_t opt = {{1, 10, 50, 100}, 4, 4, 10, 6};
+    int c;
+    while ((c = getopt(argc, argv, "n:w:d:t:")) != -1) {
+        switch (c) {
+            case 'n':
+                if (parse_counts(optarg, &opt) != 0) {
+                    fprintf(stderr, "Invalid tenant counts: %s\n", optarg);
+                    return 1;
+                }
+                break;
+            case 'w': opt.workers = atoi(optarg); break;
+            case 'd': opt.duration = atoi(optarg); break;
+            case 't': opt.token_ttl = atoi(optarg); break;
+            default:
+                fprintf(stderr, "Usage: %s [-n tenants,...] [-w workers] [-d seconds] [-t token_ttl]\n", argv[0]);
+                return 1;
+        }
+    }
+    if (opt.workers <= 0 || opt.duration <= 0 || opt.token_ttl < 4) {
+        fprintf(stderr, "Invalid options (workers >= 1, token_ttl >= 4)\n");
+        return 1;
+    }
+
+    curl_global_init(CURL_GLOBAL_DEFAULT);
+
+    // 클라이언트 로그 출력은 결과 집계에 방해되므로 실행 중에는 버림
+    fflush(stdout);
+    int saved_stdout = dup(STDOUT_FILENO);
+    int devnull = open("/dev/null", O_WRONLY);
+
+    bench_result_t results[MAX_TENANT_COUNTS][2];
+    for (int i = 0; i < opt.count_len; i++) {
+        for (int shared = 0; shared <= 1; shared++) {
+            fprintf(stderr, "Running %s mode (%d tenants, %ds)...\n", shared ? "shared" : "isolated",
+                    opt.counts[i], opt.duration);
+            fflush(stdout);
+            dup2(devnull, STDOUT_FILENO);
+            int rc = run_mode(&opt, opt.counts[i], shared, &results[i][shared]);
+            fflush(stdout);
+            dup2(saved_stdout, STDOUT_FILENO);
+            if (rc != 0) {
+                fprintf(stderr, "Failed to run benchmark\n");
+                return 1;
+            }
+        }
+    }
+    close(devnull);
+
+    printf("=== Multi-Tenant Benchmark ===\n");
+    printf("workers=%d duration=%ds token_ttl=%ds refresh_interval=1s (KV, DB dynamic, DB static)\n\n",
+           opt.workers, opt.duration, opt.token_ttl);
+    printf("%8s %-9s %8s %8s %10s %8s %8s %11s %8s\n", "tenants", "mode", "ready", "threads",
+           "rss(KB)", "conns", "logins", "requests", "ns-ok");
+    for (int i = 0; i < opt.count_len; i++) {
+        for (int shared = 0; shared <= 1; shared++) {
+            bench_result_t *r = &results[i][shared];
+            printf("%8d %-9s %8d %8d %10ld %8ld %8ld %11ld %8s\n", opt.counts[i],
+                   shared ? "shared" : "isolated", r->ready, r->threads, r->rss_kb, r->connections,
+                   r->logins, r->requests, r->namespaced == r->requests ? "yes" : "no");
+        }
+    }
+    printf("\nthreads: client worker threads, rss: growth while running (includes in-process mock server)\n");
+    printf("ns-ok: every request carried its tenant's X-Vault-Namespace header\n");
+
+    curl_global_cleanup();
+    return 0;
+}
@@ -0,0 +1,296 @@
+// 멀티 스레드 스트레스 벤치마크
+// 하나의 vault_client_t를 스레드 1, 2, 4, ... 최대 -t개가 동시에 사용하면서 읽기 처리량을 측정합니다.
+// 백그라운드 스레드가 토큰 갱신과 KV / Database Dynamic / Database Static 캐시 교체를 계속 일으키므로
+// 읽기와 교체가 겹치는 경로가 모두 실행됩니다. ThreadSanitizer 빌드로 돌리면 경합 검사도 겸합니다.
+//   cached: vault_get_db_static_secret (캐시 복사본 반환, HTTP 없음)
+//   remote: vault_get_kv_secret_direct (호출마다 HTTP, 스레드별 요청 컨텍스트 사용)
+//
+// 사용법: ./thread-bench [-t max_threads] [-d seconds] [-l latency_us]
+#define _POSIX_C_SOURCE 200809L
+#include "../src/vault_client.h"
+#include "mock_vault.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <time.h>
+
+#define MAX_STEPS 16
+
+typedef enum {
+    WORKLOAD_CACHED,
+    WORKLOAD_REMOTE,
+    WORKLOAD_COUNT
+} workload_t;
+
+static const char *workload_names[WORKLOAD_COUNT] = {"cached", "remote"};
+
+typedef struct {
+    int max_threads;
+    int duration;
+    int latency_us;
+} stress_options_t;
+
+typedef struct {
+    vault_client_t *client;
+    workload_t workload;
+    long ops;
+    long errors;
+} stress_worker_t;
+
+typedef struct {
+    int threads;
+    double ops_per_sec[WORKLOAD_COUNT];
+    long errors[WORKLOAD_COUNT];
+} stress_result_t;
+
+static int start_flag = 0;
+static int stop_flag = 0;
+static int churn_stop = 0;
+static long churn_rounds = 0;
+static long churn_errors = 0;
+
+// 반환된 복사본이 온전한지 확인 (교체 중 해제된 객체를 읽으면 여기서 깨지거나 TSAN이 잡음)
+static int validate(json_object *secret, const char *field) {
+    json_object *value = NULL;
+    if (!secret || !json_object_object_get_ex(secret, field, &value)) return -1;
+    const char *text = json_object_get_string(value);
+    return text && text[0] ? 0 : -1;
+}
+
+static void *reader_thread(void *arg) {
+    stress_worker_t *worker = (stress_worker_t *)arg;
+    struct timespec wait = {0, 1000 * 1000};
+    while (!__atomic_load_n(&start_flag, __ATOMIC_ACQUIRE)) {
+        nanosleep(&wait, NULL);
+    }
+
+    while (!__atomic_load_n(&stop_flag, __ATOMIC_ACQUIRE)) {
+        json_object *secret = NULL;
+        int rc;
+        if (worker->workload == WORKLOAD_CACHED) {
+            rc = vault_get_db_static_secret(worker->client, &secret);
+            if (rc == 0) rc = validate(secret, "password");
+        } else {
+            rc = vault_get_kv_secret_direct(worker->client, &secret);
+            json_object *data = NULL, *fields = NULL;
+            if (rc == 0) {
+                // direct 조회는 전체 응답을 반환 (data.data 아래에 필드)
+                rc = json_object_object_get_ex(secret, "data", &data) &&
+                     json_object_object_get_ex(data, "data", &fields) ? validate(fields, "api_key") : -1;
+            }
+        }
+        if (secret) vault_cleanup_secret(secret);
+        if (rc == 0) {
+            worker->ops++;
+        } else {
+            worker->errors++;
+        }
+    }
+    return NULL;
+}
+
+// 읽기와 동시에 토큰과 모든 캐시를 계속 교체
+static void *churn_thread(void *arg) {
+    vault_client_t *client = (vault_client_t *)arg;
+    struct timespec wait = {0, 5 * 1000 * 1000};
+    while (!__atomic_load_n(&churn_stop, __ATOMIC_ACQUIRE)) {
+        int failed = 0;
+        failed |= vault_refresh_kv_secret(client) != 0;
+        failed |= vault_refresh_db_dynamic_secret(client) != 0;
+        failed |= vault_refresh_db_static_secret(client) != 0;
+        failed |= vault_refresh_token(client) != 0;
+        __atomic_add_fetch(&churn_rounds, 1, __ATOMIC_RELAXED);
+        if (failed) __atomic_add_fetch(&churn_errors, 1, __ATOMIC_RELAXED);
+        nanosleep(&wait, NULL);
+    }
+    return NULL;
+}
+
+static int run_step(vault_client_t *client, workload_t workload, int threads, int duration,
+                    double *ops_per_sec, long *errors) {
+    stress_worker_t *workers = calloc((size_t)threads, sizeof(stress_worker_t));
+    pthread_t *handles = calloc((size_t)threads, sizeof(pthread_t));
+    if (!workers || !handles) {
+        free(workers);
+        free(handles);
+        return -1;
+    }
+
+    __atomic_store_n(&start_flag, 0, __ATOMIC_RELEASE);
+    __atomic_store_n(&stop_flag, 0, __ATOMIC_RELEASE);
+    int started = 0;
+    for (int i = 0; i < threads; i++) {
+        workers[i].client = client;
+        workers[i].workload = workload;
+        if (pthread_create(&handles[i], NULL, reader_thread, &workers[i]) != 0) break;
+        started++;
+    }
+
+    uint64_t begin = vault_metrics_now_ns();
+    __atomic_store_n(&start_flag, 1, __ATOMIC_RELEASE);
+    sleep((unsigned)duration);
+    __atomic_store_n(&stop_flag, 1, __ATOMIC_RELEASE);
+
+    long ops = 0;
+    *errors = 0;
+    for (int i = 0; i < started; i++) {
+        pthread_join(handles[i], NULL);
+        ops += workers[i].ops;
+        *errors += workers[i].errors;
+    }
+    double elapsed = (double)(vault_metrics_now_ns() - begin) / 1e9;
+    *ops_per_sec = elapsed > 0 ? (double)ops / elapsed : 0;
+
+    free(workers);
+    free(handles);
+    return started == threads ? 0 : -1;
+}
+
+static void mock_config(app_config_t *config, int port) {
+    memset(config, 0, sizeof(*config));
+    snprintf(config->vault_url, sizeof(config->vault_url), "http://127.0.0.1:%d", port);
+    snprintf(config->entity, sizeof(config->entity), "thread-bench");
+    snprintf(config->token_type, sizeof(config->token_type), "service");
+    snprintf(config->vault_role_id, sizeof(config->vault_role_id), "role");
+    snprintf(config->vault_secret_id, sizeof(config->vault_secret_id), "secret");
+    config->secret_kv.enabled = 1;
+    snprintf(config->secret_kv.kv_path, sizeof(config->secret_kv.kv_path), "database");
+    config->secret_kv.refresh_interval = DEFAULT_KV_REFRESH_INTERVAL;
+    config->secret_database_dynamic.enabled = 1;
+    snprintf(config->secret_database_dynamic.role_id, sizeof(config->secret_database_dynamic.role_id), "db-demo-dynamic");
+    config->secret_database_static.enabled = 1;
+    snprintf(config->secret_database_static.role_id, sizeof(config->secret_database_static.role_id), "db-demo-static");
+    config->http_timeout = 10;
+    config->max_response_size = DEFAULT_MAX_RESPONSE_SIZE;
+    config->schedule.renew_window_min = DEFAULT_RENEW_WINDOW_MIN;
+    config->schedule.renew_window_max = DEFAULT_RENEW_WINDOW_MAX;
+    config->schedule.refresh_jitter = DEFAULT_REFRESH_JITTER;
+    config->schedule.host_phase = 1;
+    strncpy(config->trace.format, DEFAULT_TRACE_FORMAT, sizeof(config->trace.format) - 1);
+}
+
+int main(int argc, char *argv[]) {
+    stress_options_t opt = {64, 2, 1000};
+    int c;
+    while ((c = getopt(argc, argv, "t:d:l:")) != -1) {
+        switch (c) {
+            case 't': opt.max_threads = atoi(optarg); break;
+            case 'd': opt.duration = atoi(optarg); break;
+            case 'l': opt.latency_us = atoi(optarg); break;
+            default:
+                fprintf(stderr, "Usage: %s [-t max_threads] [-d seconds] [-l latency_us]\n", argv[0]);
+                return 1;
+        }
+    }
+    if (opt.max_threads <= 0 || opt.duration <= 0 || opt.latency_us < 0) {
+        fprintf(stderr, "Invalid options\n");
+        return 1;
+    }
+
+    curl_global_init(CURL_GLOBAL_DEFAULT);
+
+    mock_vault_options_t server_options;
+    mock_vault_default_options(&server_options);
+    server_options.latency_us = opt.latency_us;
+    server_options.rotation_period = 3600;
+    mock_vault_t *server = mock_vault_start(&server_options);
+    if (!server) {
+        fprintf(stderr, "Failed to start mock Vault server\n");
+        return 1;
+    }
+
+    app_config_t config;
+    mock_config(&config, mock_vault_port(server));
+
+    // 클라이언트 로그 출력은 결과 집계에 방해되므로 실행 중에는 버림
+    fflush(stdout);
+    int saved_stdout = dup(STDOUT_FILENO);
+    int devnull = open("/dev/null", O_WRONLY);
+    dup2(devnull, STDOUT_FILENO);
+
+    vault_transport_t transport;
+    vault_client_t client;
+    if (vault_transport_init(&transport) != 0 || vault_client_init(&client, &config) != 0) {
+        dup2(saved_stdout, STDOUT_FILENO);
+        fprintf(stderr, "Failed to initialize client\n");
+        return 1;
+    }
+    vault_client_set_transport(&client, &transport);
+    if (vault_login(&client, config.vault_role_id, config.vault_secret_id) != 0 ||
+        vault_refresh_db_static_secret(&client) != 0) {
+        dup2(saved_stdout, STDOUT_FILENO);
+        fprintf(stderr, "Failed to log in to mock Vault server\n");
+        return 1;
+    }
+
+    pthread_t churn;
+    int churn_started = pthread_create(&churn, NULL, churn_thread, &client) == 0;
+
+    stress_result_t results[MAX_STEPS];
+    int steps = 0;
+    int failed = 0;
+    for (int threads = 1; steps < MAX_STEPS; threads *= 2) {
+        if (threads > opt.max_threads) threads = opt.max_threads;
+        results[steps].threads = threads;
+        for (int w = 0; w < WORKLOAD_COUNT && !failed; w++) {
+            fflush(stdout);
+            dup2(saved_stdout, STDOUT_FILENO);
+            fprintf(stderr, "Running %s workload (%d threads, %ds)...\n", workload_names[w], threads, opt.duration);
+            dup2(devnull, STDOUT_FILENO);
+            if (run_step(&client, (workload_t)w, threads, opt.duration,
+                         &results[steps].ops_per_sec[w], &results[steps].errors[w]) != 0) {
+                failed = 1;
+            }
+        }
+        steps++;
+        if (failed || threads == opt.max_threads) break;
+    }
+
+    __atomic_store_n(&churn_stop, 1, __ATOMIC_RELEASE);
+    if (churn_started) pthread_join(churn, NULL);
+
+    mock_vault_stats_t stats;
+    mock_vault_get_stats(server, &stats);
+
+    vault_client_cleanup(&client);
+    vault_client_thread_cleanup();
+    vault_transport_destroy(&transport);
+    mock_vault_stop(server);
+
+    fflush(stdout);
+    dup2(saved_stdout, STDOUT_FILENO);
+    close(devnull);
+
+    if (failed) {
+        fprintf(stderr, "Failed to run benchmark\n");
+        return 1;
+    }
+
+    printf("=== Thread Stress Benchmark ===\n");
+    printf("one shared client, duration=%ds per step, mock latency=%dus, cpus=%ld\n\n",
+           opt.duration, opt.latency_us, sysconf(_SC_NPROCESSORS_ONLN));
+    printf("%8s %14s %8s %8s %14s %8s %8s\n", "threads", "cached(op/s)", "speedup", "errors",
+           "remote(op/s)", "speedup", "errors");
+    long total_errors = 0;
+    for (int i = 0; i < steps; i++) {
+        stress_result_t *r = &results[i];
+        printf("%8d %14.0f %7.2fx %8ld %14.0f %7.2fx %8ld\n", r->threads,
+               r->ops_per_sec[WORKLOAD_CACHED],
+               results[0].ops_per_sec[WORKLOAD_CACHED] > 0 ?
+                   r->ops_per_sec[WORKLOAD_CACHED] / results[0].ops_per_sec[WORKLOAD_CACHED] : 0,
+               r->errors[WORKLOAD_CACHED],
+               r->ops_per_sec[WORKLOAD_REMOTE],
+               results[0].ops_per_sec[WORKLOAD_REMOTE] > 0 ?
+                   r->ops_per_sec[WORKLOAD_REMOTE] / results[0].ops_per_sec[WORKLOAD_REMOTE] : 0,
+               r->errors[WORKLOAD_REMOTE]);
+        total_errors += r->errors[WORKLOAD_CACHED] + r->errors[WORKLOAD_REMOTE];
+    }
+    printf("\nchurn: %ld rounds of token + KV/DB dynamic/DB static refresh during reads (%ld failed)\n",
+           churn_rounds, churn_errors);
+    printf("connections: %ld (shared pool), requests: %ld\n", stats.connections, stats.requests);
+
+    curl_global_cleanup();
+    return total_errors == 0 && churn_errors == 0 ? 0 : 1;
+}
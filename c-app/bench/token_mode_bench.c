@@ -0,0 +1,167 @@
+// service 토큰 vs batch 토큰 벤치마크
+// Vault 대역 서버(mock_vault)에 N개의 클라이언트를 붙여 실제 vault_client 토큰 수명주기
+// (vault_login, vault_refresh_token)를 실행하고, 모드별 요청 수와 스토리지 쓰기 수를 비교합니다.
+//
+// 짧은 TTL로 실행한 결과를 TTL 1시간 기준의 클라이언트당 시간당 수치로 환산해 출력합니다.
+//
+// 사용법: ./token-bench [-n clients] [-d seconds] [-t token_ttl] [-m token_max_ttl]
+#define _POSIX_C_SOURCE 200809L
+#include "../src/vault_client.h"
+#include "mock_vault.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <pthread.h>
+
+typedef struct {
+    int clients;
+    int duration;
+    int token_ttl;
+    int token_max_ttl;
+} bench_options_t;
+
+typedef struct {
+    app_config_t config;
+    vault_client_t client;
+    time_t deadline;
+    int failures;
+} bench_worker_t;
+
+static void *worker_thread(void *arg) {
+    bench_worker_t *worker = (bench_worker_t *)arg;
+    vault_client_t *client = &worker->client;
+    struct timespec tick = {0, 100 * 1000 * 1000};  // 100ms
+
+    if (vault_login(client, worker->config.vault_role_id, worker->config.vault_secret_id) != 0) {
+        worker->failures++;
+        return NULL;
+    }
+
+    // main.c의 token_renewal_thread와 같은 규칙: 갱신 예정 시각이 지나면 갱신(또는 재로그인)
+    while (time(NULL) < worker->deadline) {
+        nanosleep(&tick, NULL);
+
+        vault_token_t *token = vault_token_acquire(client);
+        int due = token && time(NULL) >= token->renewal_at;
+        vault_token_release(token);
+
+        if (due && vault_refresh_token(client) != 0) {
+            worker->failures++;
+        }
+    }
+    return NULL;
+}
+
+static int run_mode(const bench_options_t *opt, int batch, mock_vault_stats_t *stats, int *failures) {
+    mock_vault_options_t server_options;
+    mock_vault_default_options(&server_options);
+    server_options.token_ttl = opt->token_ttl;
+    server_options.token_max_ttl = opt->token_max_ttl;
+    server_options.batch_tokens = batch;
+
+    mock_vault_t *server = mock_vault_start(&server_options);
+    if (!server) return -1;
+
+    bench_worker_t *workers = calloc(opt->clients, sizeof(bench_worker_t));
+    pthread_t *threads = calloc(opt->clients, sizeof(pthread_t));
+    if (!workers || !threads) return -1;
+
+    time_t deadline = time(NULL) + opt->duration;
+    for (int i = 0; i < opt->clients; i++) {
+        app_config_t *config = &workers[i].config;
+        snprintf(config->vault_url, sizeof(config->vault_url), "http://127.0.0.1:%d", mock_vault_port(server));
+        snprintf(config->entity, sizeof(config->entity), "bench-%d", i);
+        snprintf(config->token_type, sizeof(config->token_type), "%s", batch ? "batch" : "service");
+        snprintf(config->vault_role_id, sizeof(config->vault_role_id), "role");
+        snprintf(config->vault_secret_id, sizeof(config->vault_secret_id), "secret");
+        config->http_timeout = 2;
+        config->max_response_size = DEFAULT_MAX_RESPONSE_SIZE;
+        config->schedule.renew_window_min = DEFAULT_RENEW_WINDOW_MIN;
+        config->schedule.renew_window_max = DEFAULT_RENEW_WINDOW_MAX;
+        config->schedule.refresh_jitter = DEFAULT_REFRESH_JITTER;
+        config->schedule.host_phase = 1;
+
+        workers[i].deadline = deadline;
+        vault_client_init(&workers[i].client, config);
+        pthread_create(&threads[i], NULL, worker_thread, &workers[i]);
+    }
+
+    *failures = 0;
+    for (int i = 0; i < opt->clients; i++) {
+        pthread_join(threads[i], NULL);
+        *failures += workers[i].failures;
+        vault_client_cleanup(&workers[i].client);
+    }
+
+    mock_vault_get_stats(server, stats);
+    mock_vault_stop(server);
+    free(workers);
+    free(threads);
+    return 0;
+}
+
+int main(int argc, char *argv[]) {
+    bench_options_t opt = {8, 30, 10, 60};
+    int c;
+    while ((c = getopt(argc, argv, "n:d:t:m:")) != -1) {
+        switch (c) {
+            case 'n': opt.clients = atoi(optarg); break;
+            case 'd': opt.duration = atoi(optarg); break;
+            case 't': opt.token_ttl = atoi(optarg); break;
+            case 'm': opt.token_max_ttl = atoi(optarg); break;
+            default:
+                fprintf(stderr, "Usage: %s [-n clients] [-d seconds] [-t token_ttl] [-m token_max_ttl]\n", argv[0]);
+                return 1;
+        }
+    }
+    if (opt.clients <= 0 || opt.duration <= 0 || opt.token_ttl < 4 || opt.token_max_ttl < opt.token_ttl) {
+        fprintf(stderr, "Invalid options (token_ttl >= 4, token_max_ttl >= token_ttl)\n");
+        return 1;
+    }
+
+    curl_global_init(CURL_GLOBAL_DEFAULT);
+
+    // 클라이언트 로그 출력은 결과 집계에 방해되므로 실행 중에는 버림
+    fflush(stdout);
+    int saved_stdout = dup(STDOUT_FILENO);
+    int devnull = open("/dev/null", O_WRONLY);
+
+    mock_vault_stats_t results[2];
+    int failures[2];
+    for (int batch = 0; batch <= 1; batch++) {
+        fprintf(stderr, "Running %s mode (%d clients, %ds)...\n", batch ? "batch" : "service",
+                opt.clients, opt.duration);
+        fflush(stdout);
+        dup2(devnull, STDOUT_FILENO);
+        int rc = run_mode(&opt, batch, &results[batch], &failures[batch]);
+        fflush(stdout);
+        dup2(saved_stdout, STDOUT_FILENO);
+        if (rc != 0) {
+            fprintf(stderr, "Failed to run benchmark\n");
+            return 1;
+        }
+    }
+    close(devnull);
+
+    // TTL 1시간 기준 클라이언트당 시간당 수치로 환산 (요청 수는 TTL에 반비례)
+    double scale = (double)opt.token_ttl / opt.clients / opt.duration;
+
+    printf("=== Token Mode Benchmark ===\n");
+    printf("clients=%d duration=%ds token_ttl=%ds token_max_ttl=%ds\n\n",
+           opt.clients, opt.duration, opt.token_ttl, opt.token_max_ttl);
+    printf("%-8s %8s %8s %8s %10s %8s | %14s %14s\n", "mode", "logins", "renews", "requests",
+           "st.writes", "failures", "req/client-h*", "writes/client-h*");
+    for (int batch = 0; batch <= 1; batch++) {
+        mock_vault_stats_t *s = &results[batch];
+        printf("%-8s %8ld %8ld %8ld %10ld %8d | %14.2f %14.2f\n", batch ? "batch" : "service",
+               s->logins, s->renewals, s->requests, s->storage_writes, failures[batch],
+               s->requests * scale, s->storage_writes * scale);
+    }
+    printf("\n* normalized to token_ttl=3600s (token_max_ttl scaled proportionally)\n");
+    printf("  storage writes: service login = token + lease entry (2), renew-self = lease update (1), batch = 0\n");
+
+    curl_global_cleanup();
+    return 0;
+}
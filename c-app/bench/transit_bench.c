@@ -0,0 +1,283 @@
+// Transit batch 암호화 벤치마크
+// 요청 처리 스레드 W개가 값 하나씩 vault_transit_encrypt_batch를 호출한다고 가정하고, batch 크기별 처리량을 비교합니다.
+//   per-call: batch_size 1, 대기 없음, 송신 스레드 W개 (값마다 HTTP 요청 하나 - 기존 방식과 같은 요청 수)
+//   batch-N:  batch_size N, batch_window_ms, 송신 스레드 pipeline개 (여러 호출을 batch_input 하나로 모아 보냄)
+// 대역 서버는 요청마다 latency_us, 항목마다 item_us를 더해 응답합니다.
+// 각 단계가 끝나면 작업자마다 마지막 암호문을 한 번에 복호화하여 원래 값과 같은지 확인합니다.
+//
+// 사용법: ./transit-bench [-w workers] [-d seconds] [-l latency_us] [-T item_us] [-p pipeline] [-W window_ms]
+#define _POSIX_C_SOURCE 200809L
+#include "../src/vault_transit.h"
+#include "mock_vault.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+
+#define BENCH_KEY "pii"
+#define SAMPLE_CAPACITY 65536  // 작업자당 지연 시간 표본 수
+
+typedef struct {
+    int workers;
+    int duration;
+    int latency_us;
+    int item_us;
+    int pipeline;
+    int window_ms;
+} transit_options_t;
+
+typedef struct {
+    vault_transit_t *transit;
+    int index;
+    uint64_t *call_ns;
+    size_t samples;
+    long calls;
+    long failed;
+    char plaintext[64];      // 마지막으로 암호화한 값
+    char *ciphertext;        // 그 암호문
+} transit_worker_t;
+
+typedef struct {
+    char name[32];
+    double ops_per_sec;
+    double p50_ms;
+    double p99_ms;
+    long requests;
+    double items_per_request;
+    int max_in_flight;
+    long failed;
+} transit_result_t;
+
+static int stop_flag = 0;
+
+static void *worker_thread(void *arg) {
+    transit_worker_t *worker = (transit_worker_t *)arg;
+    long seq = 0;
+
+    while (!__atomic_load_n(&stop_flag, __ATOMIC_ACQUIRE)) {
+        char value[64];
+        snprintf(value, sizeof(value), "user-%d-%ld@example.com", worker->index, seq++);
+        const char *inputs[1] = { value };
+        char *outputs[1] = { NULL };
+
+        uint64_t start = vault_metrics_now_ns();
+        int failed = vault_transit_encrypt_batch(worker->transit, BENCH_KEY, inputs, 1, outputs);
+        uint64_t elapsed = vault_metrics_now_ns() - start;
+        if (worker->samples < SAMPLE_CAPACITY) worker->call_ns[worker->samples++] = elapsed;
+        worker->calls++;
+        if (failed != 0) {
+            worker->failed++;
+            continue;
+        }
+        vault_transit_free(worker->ciphertext);
+        worker->ciphertext = outputs[0];
+        memcpy(worker->plaintext, value, sizeof(worker->plaintext));
+    }
+    vault_client_thread_cleanup();
+    return NULL;
+}
+
+static int compare_u64(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+    return x < y ? -1 : x > y;
+}
+
+static void make_config(app_config_t *config, int port) {
+    memset(config, 0, sizeof(*config));
+    snprintf(config->vault_url, sizeof(config->vault_url), "http://127.0.0.1:%d", port);
+    snprintf(config->entity, sizeof(config->entity), "transit-bench");
+    snprintf(config->token_type, sizeof(config->token_type), "service");
+    config->secret_kv.refresh_interval = DEFAULT_KV_REFRESH_INTERVAL;
+    config->http_timeout = 10;
+    config->max_response_size = DEFAULT_MAX_RESPONSE_SIZE;
+    config->max_in_flight = DEFAULT_MAX_IN_FLIGHT;
+    config->schedule.renew_window_min = DEFAULT_RENEW_WINDOW_MIN;
+    config->schedule.renew_window_max = DEFAULT_RENEW_WINDOW_MAX;
+    config->schedule.refresh_jitter = DEFAULT_REFRESH_JITTER;
+    strncpy(config->trace.format, DEFAULT_TRACE_FORMAT, sizeof(config->trace.format) - 1);
+}
+
+// 작업자마다 마지막 암호문을 한 번의 호출로 복호화하여 확인 (불일치 수 반환)
+static long verify_round_trip(vault_transit_t *transit, transit_worker_t *workers, int count) {
+    const char **ciphertexts = calloc((size_t)count, sizeof(char *));
+    char **plaintexts = calloc((size_t)count, sizeof(char *));
+    if (!ciphertexts || !plaintexts) return count;
+
+    for (int i = 0; i < count; i++) ciphertexts[i] = workers[i].ciphertext;
+    vault_transit_decrypt_batch(transit, BENCH_KEY, ciphertexts, (size_t)count, plaintexts);
+    long mismatched = 0;
+    for (int i = 0; i < count; i++) {
+        if (!plaintexts[i] || strcmp(plaintexts[i], workers[i].plaintext) != 0) mismatched++;
+        vault_transit_free(plaintexts[i]);
+    }
+    free(ciphertexts);
+    free(plaintexts);
+    return mismatched;
+}
+
+static int run_mode(const transit_options_t *opt, int batch_size, transit_result_t *result) {
+    mock_vault_options_t server_options;
+    mock_vault_default_options(&server_options);
+    server_options.latency_us = opt->latency_us;
+    server_options.transit_item_us = opt->item_us;
+    mock_vault_t *server = mock_vault_start(&server_options);
+    if (!server) return -1;
+
+    app_config_t config;
+    make_config(&config, mock_vault_port(server));
+    config.transit.enabled = 1;
+    config.transit.batch_size = batch_size;
+    config.transit.batch_window_ms = batch_size > 1 ? opt->window_ms : 0;
+    config.transit.pipeline = batch_size > 1 ? opt->pipeline : opt->workers;
+    vault_transport_t transport;
+    vault_client_t client;
+    vault_transit_t transit;
+    vault_transport_init(&transport);
+    vault_client_init(&client, &config);
+    vault_client_set_transport(&client, &transport);
+    int rc = -1;
+    if (vault_login(&client, "role", "secret") != 0 || vault_transit_init(&transit, &client) != 0) {
+        vault_client_cleanup(&client);
+        vault_transport_destroy(&transport);
+        mock_vault_stop(server);
+        return -1;
+    }
+
+    transit_worker_t *workers = calloc((size_t)opt->workers, sizeof(transit_worker_t));
+    pthread_t *threads = calloc((size_t)opt->workers, sizeof(pthread_t));
+    if (!workers || !threads) goto out;
+    __atomic_store_n(&stop_flag, 0, __ATOMIC_RELEASE);
+    mock_vault_stats_t before, after;
+    mock_vault_get_stats(server, &before);
+    uint64_t start = vault_metrics_now_ns();
+    for (int i = 0; i < opt->workers; i++) {
+        workers[i].transit = &transit;
+        workers[i].index = i;
+        workers[i].call_ns = calloc(SAMPLE_CAPACITY, sizeof(uint64_t));
+        if (!workers[i].call_ns) goto out;
+        pthread_create(&threads[i], NULL, worker_thread, &workers[i]);
+    }
+
+    sleep((unsigned)opt->duration);
+    __atomic_store_n(&stop_flag, 1, __ATOMIC_RELEASE);
+    for (int i = 0; i < opt->workers; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    double elapsed = (double)(vault_metrics_now_ns() - start) / 1e9;
+    mock_vault_get_stats(server, &after);
+
+    memset(result, 0, sizeof(*result));
+    if (batch_size > 1) snprintf(result->name, sizeof(result->name), "batch-%d", batch_size);
+    else snprintf(result->name, sizeof(result->name), "per-call");
+    size_t total = 0;
+    long calls = 0;
+    for (int i = 0; i < opt->workers; i++) {
+        total += workers[i].samples;
+        calls += workers[i].calls;
+        result->failed += workers[i].failed;
+    }
+    uint64_t *all = calloc(total ? total : 1, sizeof(uint64_t));
+    if (!all) goto out;
+    size_t n = 0;
+    for (int i = 0; i < opt->workers; i++) {
+        memcpy(all + n, workers[i].call_ns, workers[i].samples * sizeof(uint64_t));
+        n += workers[i].samples;
+    }
+    qsort(all, n, sizeof(uint64_t), compare_u64);
+    result->ops_per_sec = (double)calls / elapsed;
+    result->p50_ms = n ? (double)all[n / 2] / 1e6 : 0;
+    result->p99_ms = n ? (double)all[(n * 99) / 100] / 1e6 : 0;
+    result->requests = after.transit_requests - before.transit_requests;
+    result->items_per_request = result->requests ? (double)(after.transit_items - before.transit_items) /
+                                                   (double)result->requests : 0;
+    vault_transit_stats_t stats;
+    vault_transit_get_stats(&transit, &stats);
+    result->max_in_flight = stats.max_in_flight;
+    free(all);
+
+    result->failed += verify_round_trip(&transit, workers, opt->workers);
+    rc = 0;
+
+out:
+    vault_transit_destroy(&transit);
+    if (workers) {
+        for (int i = 0; i < opt->workers; i++) {
+            free(workers[i].call_ns);
+            vault_transit_free(workers[i].ciphertext);
+        }
+    }
+    free(workers);
+    free(threads);
+    vault_client_cleanup(&client);
+    vault_client_thread_cleanup();
+    vault_transport_destroy(&transport);
+    mock_vault_stop(server);
+    return rc;
+}
+
+int main(int argc, char *argv[]) {
+    transit_options_t opt = {64, 3, 2000, 20, 4, 2};
+    int c;
+    while ((c = getopt(argc, argv, "w:d:l:T:p:W:")) != -1) {
+        switch (c) {
+            case 'w': opt.workers = atoi(optarg); break;
+            case 'd': opt.duration = atoi(optarg); break;
+            case 'l': opt.latency_us = atoi(optarg); break;
+            case 'T': opt.item_us = atoi(optarg); break;
+            case 'p': opt.pipeline = atoi(optarg); break;
+            case 'W': opt.window_ms = atoi(optarg); break;
+            default:
+                fprintf(stderr, "Usage: %s [-w workers] [-d seconds] [-l latency_us] [-T item_us] [-p pipeline] "
+                                "[-W window_ms]\n", argv[0]);
+                return 1;
+        }
+    }
+    if (opt.workers <= 0 || opt.workers > VAULT_TRANSIT_MAX_PIPELINE || opt.duration <= 0 || opt.latency_us < 0 ||
+        opt.item_us < 0 || opt.pipeline <= 0 || opt.window_ms < 0) {
+        fprintf(stderr, "Invalid options (workers 1..%d)\n", VAULT_TRANSIT_MAX_PIPELINE);
+        return 1;
+    }
+
+    curl_global_init(CURL_GLOBAL_DEFAULT);
+
+    // 클라이언트 로그 출력은 결과 집계에 방해되므로 실행 중에는 버림
+    fflush(stdout);
+    int saved_stdout = dup(STDOUT_FILENO);
+    int devnull = open("/dev/null", O_WRONLY);
+
+    static const int batch_sizes[] = { 1, 4, 16, 64, 256 };
+    enum { MODES = sizeof(batch_sizes) / sizeof(batch_sizes[0]) };
+    transit_result_t results[MODES];
+    for (int m = 0; m < MODES; m++) {
+        fprintf(stderr, "Running batch_size=%d (%d workers, %ds)...\n", batch_sizes[m], opt.workers, opt.duration);
+        dup2(devnull, STDOUT_FILENO);
+        int rc = run_mode(&opt, batch_sizes[m], &results[m]);
+        fflush(stdout);
+        dup2(saved_stdout, STDOUT_FILENO);
+        if (rc != 0) {
+            fprintf(stderr, "Failed to run benchmark\n");
+            return 1;
+        }
+    }
+    close(devnull);
+
+    printf("=== Transit Batch Benchmark ===\n");
+    printf("workers=%d duration=%ds mock latency=%dus + %dus/item, pipeline=%d window=%dms\n\n", opt.workers,
+           opt.duration, opt.latency_us, opt.item_us, opt.pipeline, opt.window_ms);
+    printf("%-10s %10s %8s %9s %9s %10s %10s %8s %7s\n", "mode", "ops/sec", "speedup", "p50", "p99", "requests",
+           "items/req", "in-flight", "failed");
+    long failed = 0;
+    for (int m = 0; m < MODES; m++) {
+        transit_result_t *r = &results[m];
+        printf("%-10s %10.0f %7.1fx %7.2fms %7.2fms %10ld %10.1f %8d %7ld\n", r->name, r->ops_per_sec,
+               results[0].ops_per_sec > 0 ? r->ops_per_sec / results[0].ops_per_sec : 0, r->p50_ms, r->p99_ms,
+               r->requests, r->items_per_request, r->max_in_flight, r->failed);
+        failed += r->failed;
+    }
+    printf("\nper-call sends one request per value with one sender per worker; batch-N coalesces calls into\n"
+           "batch_input requests of up to N items with %d batches in flight\n", opt.pipeline);
+
+    curl_global_cleanup();
+    return failed == 0 ? 0 : 1;
+}
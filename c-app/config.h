@@ -13,39 +13,144 @@ typedef struct {
     char vault_role_id[128];
     char vault_secret_id[128];
     char entity[64];
+    char token_type[16];   // 토큰 유형: service (기본) 또는 batch
     
     // 시크릿 엔진 설정
     struct {
         int enabled;
         char kv_path[128];
         int refresh_interval;  // KV 갱신 간격 (초)
+        int events;            // Vault 이벤트 구독으로 변경 시 즉시 갱신 (스트림이 끊기면 폴링)
+        char prefetch[128];    // 기동 시 미리 읽을 하위 경로 (<entity>-kv 기준, 비어 있으면 비활성화)
+        int prefetch_depth;    // 하위 폴더 탐색 깊이
+        int prefetch_max_keys; // 미리 읽을 최대 키 수
     } secret_kv;
     
     struct {
         int enabled;
         char role_id[128];
+        int pool_size;         // 미리 발급해 둘 자격증명 수 (0이면 자격증명 하나를 만료 직전에 교체)
+        int pool_drain_grace;  // 교체된 자격증명을 폐기하기 전 유예 시간 (초)
     } secret_database_dynamic;
     
     struct {
         int enabled;
         char role_id[128];
+        int rotation_skew;     // 교체 예정 시각 이후 다시 읽기까지 여유 시간 (초)
     } secret_database_static;
     
+    // Transit 암호화 ({entity}-transit, 여러 스레드의 호출을 batch_input 요청으로 모아 보냄)
+    struct {
+        int enabled;
+        char key[128];         // 암호화 키 이름 (기동 시 왕복 확인에 사용)
+        int batch_size;        // 요청 하나에 담을 최대 항목 수
+        int batch_window_ms;   // 첫 항목이 들어온 뒤 batch_size가 찰 때까지 기다리는 최대 시간 (ms)
+        int pipeline;          // 동시에 보내는 batch 요청 수
+        long envelope_max_uses; // envelope 암호화: 데이터 키 하나로 암호화할 최대 레코드 수
+        int envelope_max_age;   // envelope 암호화: 데이터 키 하나를 암호화에 쓸 최대 시간 (초)
+        int envelope_cache;     // envelope 복호화: 풀어 둔 데이터 키를 캐시할 개수
+    } transit;
+    
+    // PKI 인증서 발급 ({entity}-pki/issue/{role}, 만료 전에 미리 다음 인증서 발급)
+    struct {
+        int enabled;
+        char role[128];
+        char common_name[256];
+        char alt_names[512];   // 쉼표로 구분한 SAN (비어 있으면 생략)
+        char ttl[32];          // 요청 유효 기간 (예: 24h, 비어 있으면 Role 기본값)
+        int renew_at;          // 다음 인증서 발급 시점 (유효 기간 대비 %, NotBefore 기준)
+        char cert_file[512];   // 인증서 + 체인 PEM 파일 (비어 있으면 쓰지 않음)
+        char key_file[512];    // 개인 키 PEM 파일 (0600, 비어 있으면 쓰지 않음)
+    } pki;
+    
+    // 주기 작업 분산 설정
+    struct {
+        int renew_window_min;  // 토큰 갱신 구간 시작 (TTL 대비 %)
+        int renew_window_max;  // 토큰 갱신 구간 끝 (TTL 대비 %)
+        int refresh_jitter;    // 폴링 간격 변동폭 (± %)
+        int host_phase;        // 호스트 해시 기반 위상 오프셋
+    } schedule;
+    
     // HTTP 설정
     int http_timeout;
     int max_response_size;
+    int max_in_flight;     // vault_get_secrets 동시 요청 수
+    int adaptive_limit;    // Vault 동시 요청 수 적응형 제한 (지연 시간 기반, 전송 계층 공유)
+    int limit_min;         // 적응형 한도 하한
+    int limit_max;         // 적응형 한도 상한 (시작 한도는 max_in_flight)
+    char accept_encoding[64];  // KV 조회 응답에 허용할 압축 (예: "gzip, zstd", 비어 있으면 압축 안 함)
+    
+    // 메트릭 설정
+    int metrics_port;  // Prometheus /metrics 포트 (0이면 비활성화)
+    char metrics_address[64];  // 엔드포인트를 바인드할 IPv4 주소 (기본 루프백)
+    
+    // 요청 추적 덤프 설정 (SIGUSR1 수신 시 덤프)
+    struct {
+        char format[16];   // text 또는 otel
+        char output[256];  // 덤프 파일 경로 (비어 있으면 stderr)
+        char record[256];  // 트래픽 기록 파일 경로 (비어 있으면 기록하지 않음, bench/replay로 재생)
+    } trace;
+    
+    // 멀티 테넌트 설정 ([tenant:<name>] 섹션이 있을 때)
+    struct {
+        int workers;  // 모든 테넌트가 공유하는 스케줄러 작업 스레드 수
+    } tenants;
+    
+    // 로그 설정 (비동기 로거)
+    struct {
+        char level[16];    // debug, info, warn, error, off
+        char output[256];  // 로그 파일 경로 (비어 있으면 stdout)
+    } log;
 } app_config_t;
 
 // 기본값 정의
 #define DEFAULT_VAULT_URL "http://127.0.0.1:8200"
 #define DEFAULT_VAULT_NAMESPACE ""
 #define DEFAULT_ENTITY "my-vault-app"
+#define DEFAULT_TOKEN_TYPE "service"
 #define DEFAULT_HTTP_TIMEOUT 30
-#define DEFAULT_MAX_RESPONSE_SIZE 4096
+#define DEFAULT_MAX_RESPONSE_SIZE 1048576
+#define DEFAULT_MAX_IN_FLIGHT 16
+#define DEFAULT_LIMIT_MIN 2
+#define DEFAULT_LIMIT_MAX 64
+#define DEFAULT_ACCEPT_ENCODING "gzip, zstd"
 #define DEFAULT_KV_REFRESH_INTERVAL 300  // 5분 기본값
+#define DEFAULT_PREFETCH_DEPTH 3
+#define DEFAULT_PREFETCH_MAX_KEYS 256
+#define DEFAULT_DB_POOL_DRAIN_GRACE 30
+#define DEFAULT_DB_STATIC_ROTATION_SKEW 5
+#define DEFAULT_TRANSIT_BATCH_SIZE 64
+#define DEFAULT_TRANSIT_BATCH_WINDOW_MS 2
+#define DEFAULT_TRANSIT_PIPELINE 4
+#define DEFAULT_TRANSIT_ENVELOPE_MAX_USES 1000000
+#define DEFAULT_TRANSIT_ENVELOPE_MAX_AGE 300
+#define DEFAULT_TRANSIT_ENVELOPE_CACHE 64
+#define DEFAULT_PKI_RENEW_AT 70
+#define DEFAULT_RENEW_WINDOW_MIN 60      // TTL 60% 지점부터
+#define DEFAULT_RENEW_WINDOW_MAX 85      // TTL 85% 지점까지
+#define DEFAULT_REFRESH_JITTER 10        // 폴링 간격 ±10%
+#define DEFAULT_METRICS_PORT 0           // 메트릭 엔드포인트 비활성화
+#define DEFAULT_METRICS_ADDRESS "127.0.0.1"  // 로컬 스크레이프만 허용
+#define DEFAULT_TRACE_FORMAT "text"
+#define DEFAULT_LOG_LEVEL "info"
+#define DEFAULT_TENANT_WORKERS 4
+
+// 설정 변경 항목 (config_diff 결과 비트, 핫 리로드용)
+#define CONFIG_CHANGED_KV          0x01  // [secret-kv] enabled, kv_path
+#define CONFIG_CHANGED_KV_EVENTS   0x02  // [secret-kv] events
+#define CONFIG_CHANGED_DB_DYNAMIC  0x04  // [secret-database-dynamic]
+#define CONFIG_CHANGED_DB_STATIC   0x08  // [secret-database-static]
+#define CONFIG_CHANGED_INTERVAL    0x10  // [secret-kv] refresh_interval (모든 갱신 스레드 공통)
+#define CONFIG_CHANGED_SCHEDULE    0x20  // [schedule]
+#define CONFIG_CHANGED_LOG_LEVEL   0x40  // [log] level
+#define CONFIG_CHANGED_RESTART     0x80  // 재시작이 필요한 항목 ([vault], [http], [metrics], [trace], [tenants], [log] output)
+#define CONFIG_CHANGED_KV_PREFETCH 0x100 // [secret-kv] prefetch, prefetch_depth, prefetch_max_keys
 
 // 함수 선언
 int load_config(const char *config_file, app_config_t *config);
 void print_config(const app_config_t *config);
+unsigned config_diff(const app_config_t *running, const app_config_t *next);
+void config_apply_reload(app_config_t *running, const app_config_t *next, unsigned changes);
+int load_tenant_configs(const char *config_file, const app_config_t *base, app_config_t **tenants);
 
 #endif
\ No newline at end of file
@@ -3,6 +3,60 @@
 #include <stdlib.h>
 #include <string.h>
 
+// INI 파일에서 다음 키=값 항목 읽기 (섹션 이름은 section에 갱신, 항목이 없으면 0 반환)
+static int ini_next(FILE *file, char *section, size_t section_size, char *line, size_t line_size,
+                    char **key_out, char **value_out) {
+    while (fgets(line, (int)line_size, file)) {
+        // 공백과 개행 문자 제거
+        line[strcspn(line, "\r\n")] = '\0';
+        
+        // 빈 줄이나 주석 줄 건너뛰기
+        if (line[0] == '\0' || line[0] == ';' || line[0] == '#') {
+            continue;
+        }
+        
+        // 섹션 처리 [section]
+        if (line[0] == '[' && strchr(line, ']') != NULL) {
+            char *end_bracket = strchr(line, ']');
+            *end_bracket = '\0';
+            strncpy(section, line + 1, section_size - 1);
+            section[section_size - 1] = '\0';
+            continue;
+        }
+        
+        // 키=값 처리
+        char *equals = strchr(line, '=');
+        if (equals == NULL) {
+            continue;
+        }
+        *equals = '\0';
+        char *key = line;
+        char *value = equals + 1;
+        
+        // 앞뒤 공백 제거
+        while (*key == ' ' || *key == '\t') key++;
+        while (*value == ' ' || *value == '\t') value++;
+        
+        char *key_end = key + strlen(key) - 1;
+        char *value_end = value + strlen(value) - 1;
+        
+        while (key_end > key && (*key_end == ' ' || *key_end == '\t')) {
+            *key_end = '\0';
+            key_end--;
+        }
+        
+        while (value_end > value && (*value_end == ' ' || *value_end == '\t')) {
+            *value_end = '\0';
+            value_end--;
+        }
+        
+        *key_out = key;
+        *value_out = value;
+        return 1;
+    }
+    return 0;
+}
+
 // INI 파일 파싱 함수
 int load_config(const char *config_file, app_config_t *config) {
     if (!config_file || !config) {
@@ -19,6 +73,9 @@ int load_config(const char *config_file, app_config_t *config) {
     strncpy(config->entity, DEFAULT_ENTITY, sizeof(config->entity) - 1);
     config->entity[sizeof(config->entity) - 1] = '\0';
     
+    strncpy(config->token_type, DEFAULT_TOKEN_TYPE, sizeof(config->token_type) - 1);
+    config->token_type[sizeof(config->token_type) - 1] = '\0';
+    
     config->vault_role_id[0] = '\0';
     config->vault_secret_id[0] = '\0';
     
@@ -26,15 +83,62 @@ int load_config(const char *config_file, app_config_t *config) {
     config->secret_kv.enabled = 0;
     config->secret_kv.kv_path[0] = '\0';
     config->secret_kv.refresh_interval = DEFAULT_KV_REFRESH_INTERVAL;
+    config->secret_kv.events = 0;
+    config->secret_kv.prefetch[0] = '\0';
+    config->secret_kv.prefetch_depth = DEFAULT_PREFETCH_DEPTH;
+    config->secret_kv.prefetch_max_keys = DEFAULT_PREFETCH_MAX_KEYS;
     
     config->secret_database_dynamic.enabled = 0;
     config->secret_database_dynamic.role_id[0] = '\0';
+    config->secret_database_dynamic.pool_size = 0;
+    config->secret_database_dynamic.pool_drain_grace = DEFAULT_DB_POOL_DRAIN_GRACE;
     
     config->secret_database_static.enabled = 0;
     config->secret_database_static.role_id[0] = '\0';
+    config->secret_database_static.rotation_skew = DEFAULT_DB_STATIC_ROTATION_SKEW;
+    
+    config->transit.enabled = 0;
+    config->transit.key[0] = '\0';
+    config->transit.batch_size = DEFAULT_TRANSIT_BATCH_SIZE;
+    config->transit.batch_window_ms = DEFAULT_TRANSIT_BATCH_WINDOW_MS;
+    config->transit.pipeline = DEFAULT_TRANSIT_PIPELINE;
+    config->transit.envelope_max_uses = DEFAULT_TRANSIT_ENVELOPE_MAX_USES;
+    config->transit.envelope_max_age = DEFAULT_TRANSIT_ENVELOPE_MAX_AGE;
+    config->transit.envelope_cache = DEFAULT_TRANSIT_ENVELOPE_CACHE;
+    
+    config->pki.enabled = 0;
+    config->pki.role[0] = '\0';
+    config->pki.common_name[0] = '\0';
+    config->pki.alt_names[0] = '\0';
+    config->pki.ttl[0] = '\0';
+    config->pki.renew_at = DEFAULT_PKI_RENEW_AT;
+    config->pki.cert_file[0] = '\0';
+    config->pki.key_file[0] = '\0';
+    
+    config->schedule.renew_window_min = DEFAULT_RENEW_WINDOW_MIN;
+    config->schedule.renew_window_max = DEFAULT_RENEW_WINDOW_MAX;
+    config->schedule.refresh_jitter = DEFAULT_REFRESH_JITTER;
+    config->schedule.host_phase = 1;
     
     config->http_timeout = DEFAULT_HTTP_TIMEOUT;
     config->max_response_size = DEFAULT_MAX_RESPONSE_SIZE;
+    config->max_in_flight = DEFAULT_MAX_IN_FLIGHT;
+    config->adaptive_limit = 1;
+    config->limit_min = DEFAULT_LIMIT_MIN;
+    config->limit_max = DEFAULT_LIMIT_MAX;
+    strncpy(config->accept_encoding, DEFAULT_ACCEPT_ENCODING, sizeof(config->accept_encoding) - 1);
+    config->accept_encoding[sizeof(config->accept_encoding) - 1] = '\0';
+    config->metrics_port = DEFAULT_METRICS_PORT;
+    strncpy(config->metrics_address, DEFAULT_METRICS_ADDRESS, sizeof(config->metrics_address) - 1);
+    config->metrics_address[sizeof(config->metrics_address) - 1] = '\0';
+    strncpy(config->trace.format, DEFAULT_TRACE_FORMAT, sizeof(config->trace.format) - 1);
+    config->trace.format[sizeof(config->trace.format) - 1] = '\0';
+    config->trace.output[0] = '\0';
+    config->trace.record[0] = '\0';
+    strncpy(config->log.level, DEFAULT_LOG_LEVEL, sizeof(config->log.level) - 1);
+    config->log.level[sizeof(config->log.level) - 1] = '\0';
+    config->log.output[0] = '\0';
+    config->tenants.workers = DEFAULT_TENANT_WORKERS;
     
     // INI 파일 열기
     FILE *file = fopen(config_file, "r");
@@ -45,96 +149,160 @@ int load_config(const char *config_file, app_config_t *config) {
     
     char line[512];
     char current_section[64] = "";
+    char *key, *value;
     
-    while (fgets(line, sizeof(line), file)) {
-        // 공백과 개행 문자 제거
-        line[strcspn(line, "\r\n")] = '\0';
-        
-        // 빈 줄이나 주석 줄 건너뛰기
-        if (line[0] == '\0' || line[0] == ';' || line[0] == '#') {
-            continue;
-        }
-        
-        // 섹션 처리 [section]
-        if (line[0] == '[' && strchr(line, ']') != NULL) {
-            char *end_bracket = strchr(line, ']');
-            *end_bracket = '\0';
-            strncpy(current_section, line + 1, sizeof(current_section) - 1);
-            current_section[sizeof(current_section) - 1] = '\0';
-            continue;
-        }
-        
-        // 키=값 처리
-        char *equals = strchr(line, '=');
-        if (equals != NULL) {
-            *equals = '\0';
-            char *key = line;
-            char *value = equals + 1;
-            
-            // 앞뒤 공백 제거
-            while (*key == ' ' || *key == '\t') key++;
-            while (*value == ' ' || *value == '\t') value++;
-            
-            char *key_end = key + strlen(key) - 1;
-            char *value_end = value + strlen(value) - 1;
-            
-            while (key_end > key && (*key_end == ' ' || *key_end == '\t')) {
-                *key_end = '\0';
-                key_end--;
+    while (ini_next(file, current_section, sizeof(current_section), line, sizeof(line), &key, &value)) {
+        // 설정값 적용
+        if (strcmp(current_section, "vault") == 0) {
+            if (strcmp(key, "entity") == 0) {
+                strncpy(config->entity, value, sizeof(config->entity) - 1);
+                config->entity[sizeof(config->entity) - 1] = '\0';
+            } else if (strcmp(key, "url") == 0) {
+                strncpy(config->vault_url, value, sizeof(config->vault_url) - 1);
+                config->vault_url[sizeof(config->vault_url) - 1] = '\0';
+            } else if (strcmp(key, "namespace") == 0) {
+                strncpy(config->vault_namespace, value, sizeof(config->vault_namespace) - 1);
+                config->vault_namespace[sizeof(config->vault_namespace) - 1] = '\0';
+            } else if (strcmp(key, "role_id") == 0) {
+                strncpy(config->vault_role_id, value, sizeof(config->vault_role_id) - 1);
+                config->vault_role_id[sizeof(config->vault_role_id) - 1] = '\0';
+            } else if (strcmp(key, "secret_id") == 0) {
+                strncpy(config->vault_secret_id, value, sizeof(config->vault_secret_id) - 1);
+                config->vault_secret_id[sizeof(config->vault_secret_id) - 1] = '\0';
+            } else if (strcmp(key, "token_type") == 0) {
+                strncpy(config->token_type, value, sizeof(config->token_type) - 1);
+                config->token_type[sizeof(config->token_type) - 1] = '\0';
             }
-            
-            while (value_end > value && (*value_end == ' ' || *value_end == '\t')) {
-                *value_end = '\0';
-                value_end--;
+        } else if (strcmp(current_section, "secret-kv") == 0) {
+            if (strcmp(key, "enabled") == 0) {
+                config->secret_kv.enabled = (strcmp(value, "true") == 0) ? 1 : 0;
+            } else if (strcmp(key, "kv_path") == 0) {
+                strncpy(config->secret_kv.kv_path, value, sizeof(config->secret_kv.kv_path) - 1);
+                config->secret_kv.kv_path[sizeof(config->secret_kv.kv_path) - 1] = '\0';
+            } else if (strcmp(key, "refresh_interval") == 0) {
+                config->secret_kv.refresh_interval = atoi(value);
+            } else if (strcmp(key, "events") == 0) {
+                config->secret_kv.events = (strcmp(value, "true") == 0) ? 1 : 0;
+            } else if (strcmp(key, "prefetch") == 0) {
+                strncpy(config->secret_kv.prefetch, value, sizeof(config->secret_kv.prefetch) - 1);
+                config->secret_kv.prefetch[sizeof(config->secret_kv.prefetch) - 1] = '\0';
+            } else if (strcmp(key, "prefetch_depth") == 0) {
+                config->secret_kv.prefetch_depth = atoi(value);
+            } else if (strcmp(key, "prefetch_max_keys") == 0) {
+                config->secret_kv.prefetch_max_keys = atoi(value);
             }
-            
-            // 설정값 적용
-            if (strcmp(current_section, "vault") == 0) {
-                if (strcmp(key, "entity") == 0) {
-                    strncpy(config->entity, value, sizeof(config->entity) - 1);
-                    config->entity[sizeof(config->entity) - 1] = '\0';
-                } else if (strcmp(key, "url") == 0) {
-                    strncpy(config->vault_url, value, sizeof(config->vault_url) - 1);
-                    config->vault_url[sizeof(config->vault_url) - 1] = '\0';
-                } else if (strcmp(key, "namespace") == 0) {
-                    strncpy(config->vault_namespace, value, sizeof(config->vault_namespace) - 1);
-                    config->vault_namespace[sizeof(config->vault_namespace) - 1] = '\0';
-                } else if (strcmp(key, "role_id") == 0) {
-                    strncpy(config->vault_role_id, value, sizeof(config->vault_role_id) - 1);
-                    config->vault_role_id[sizeof(config->vault_role_id) - 1] = '\0';
-                } else if (strcmp(key, "secret_id") == 0) {
-                    strncpy(config->vault_secret_id, value, sizeof(config->vault_secret_id) - 1);
-                    config->vault_secret_id[sizeof(config->vault_secret_id) - 1] = '\0';
-                }
-            } else if (strcmp(current_section, "secret-kv") == 0) {
-                if (strcmp(key, "enabled") == 0) {
-                    config->secret_kv.enabled = (strcmp(value, "true") == 0) ? 1 : 0;
-                } else if (strcmp(key, "kv_path") == 0) {
-                    strncpy(config->secret_kv.kv_path, value, sizeof(config->secret_kv.kv_path) - 1);
-                    config->secret_kv.kv_path[sizeof(config->secret_kv.kv_path) - 1] = '\0';
-                } else if (strcmp(key, "refresh_interval") == 0) {
-                    config->secret_kv.refresh_interval = atoi(value);
-                }
-            } else if (strcmp(current_section, "secret-database-dynamic") == 0) {
-                if (strcmp(key, "enabled") == 0) {
-                    config->secret_database_dynamic.enabled = (strcmp(value, "true") == 0) ? 1 : 0;
-                } else if (strcmp(key, "role_id") == 0) {
-                    strncpy(config->secret_database_dynamic.role_id, value, sizeof(config->secret_database_dynamic.role_id) - 1);
-                    config->secret_database_dynamic.role_id[sizeof(config->secret_database_dynamic.role_id) - 1] = '\0';
-                }
-            } else if (strcmp(current_section, "secret-database-static") == 0) {
-                if (strcmp(key, "enabled") == 0) {
-                    config->secret_database_static.enabled = (strcmp(value, "true") == 0) ? 1 : 0;
-                } else if (strcmp(key, "role_id") == 0) {
-                    strncpy(config->secret_database_static.role_id, value, sizeof(config->secret_database_static.role_id) - 1);
-                    config->secret_database_static.role_id[sizeof(config->secret_database_static.role_id) - 1] = '\0';
-                }
-            } else if (strcmp(current_section, "http") == 0) {
-                if (strcmp(key, "timeout") == 0) {
-                    config->http_timeout = atoi(value);
-                } else if (strcmp(key, "max_response_size") == 0) {
-                    config->max_response_size = atoi(value);
-                }
+        } else if (strcmp(current_section, "secret-database-dynamic") == 0) {
+            if (strcmp(key, "enabled") == 0) {
+                config->secret_database_dynamic.enabled = (strcmp(value, "true") == 0) ? 1 : 0;
+            } else if (strcmp(key, "role_id") == 0) {
+                strncpy(config->secret_database_dynamic.role_id, value, sizeof(config->secret_database_dynamic.role_id) - 1);
+                config->secret_database_dynamic.role_id[sizeof(config->secret_database_dynamic.role_id) - 1] = '\0';
+            } else if (strcmp(key, "pool_size") == 0) {
+                config->secret_database_dynamic.pool_size = atoi(value);
+            } else if (strcmp(key, "pool_drain_grace") == 0) {
+                config->secret_database_dynamic.pool_drain_grace = atoi(value);
+            }
+        } else if (strcmp(current_section, "secret-database-static") == 0) {
+            if (strcmp(key, "enabled") == 0) {
+                config->secret_database_static.enabled = (strcmp(value, "true") == 0) ? 1 : 0;
+            } else if (strcmp(key, "role_id") == 0) {
+                strncpy(config->secret_database_static.role_id, value, sizeof(config->secret_database_static.role_id) - 1);
+                config->secret_database_static.role_id[sizeof(config->secret_database_static.role_id) - 1] = '\0';
+            } else if (strcmp(key, "rotation_skew") == 0) {
+                config->secret_database_static.rotation_skew = atoi(value);
+            }
+        } else if (strcmp(current_section, "transit") == 0) {
+            if (strcmp(key, "enabled") == 0) {
+                config->transit.enabled = (strcmp(value, "true") == 0) ? 1 : 0;
+            } else if (strcmp(key, "key") == 0) {
+                snprintf(config->transit.key, sizeof(config->transit.key), "%s", value);
+            } else if (strcmp(key, "batch_size") == 0) {
+                config->transit.batch_size = atoi(value);
+            } else if (strcmp(key, "batch_window_ms") == 0) {
+                config->transit.batch_window_ms = atoi(value);
+            } else if (strcmp(key, "pipeline") == 0) {
+                config->transit.pipeline = atoi(value);
+            } else if (strcmp(key, "envelope_max_uses") == 0) {
+                config->transit.envelope_max_uses = atol(value);
+            } else if (strcmp(key, "envelope_max_age") == 0) {
+                config->transit.envelope_max_age = atoi(value);
+            } else if (strcmp(key, "envelope_cache") == 0) {
+                config->transit.envelope_cache = atoi(value);
+            }
+        } else if (strcmp(current_section, "pki") == 0) {
+            if (strcmp(key, "enabled") == 0) {
+                config->pki.enabled = (strcmp(value, "true") == 0) ? 1 : 0;
+            } else if (strcmp(key, "role") == 0) {
+                snprintf(config->pki.role, sizeof(config->pki.role), "%s", value);
+            } else if (strcmp(key, "common_name") == 0) {
+                snprintf(config->pki.common_name, sizeof(config->pki.common_name), "%s", value);
+            } else if (strcmp(key, "alt_names") == 0) {
+                snprintf(config->pki.alt_names, sizeof(config->pki.alt_names), "%s", value);
+            } else if (strcmp(key, "ttl") == 0) {
+                snprintf(config->pki.ttl, sizeof(config->pki.ttl), "%s", value);
+            } else if (strcmp(key, "renew_at") == 0) {
+                config->pki.renew_at = atoi(value);
+            } else if (strcmp(key, "cert_file") == 0) {
+                snprintf(config->pki.cert_file, sizeof(config->pki.cert_file), "%s", value);
+            } else if (strcmp(key, "key_file") == 0) {
+                snprintf(config->pki.key_file, sizeof(config->pki.key_file), "%s", value);
+            }
+        } else if (strcmp(current_section, "schedule") == 0) {
+            if (strcmp(key, "renew_window_min") == 0) {
+                config->schedule.renew_window_min = atoi(value);
+            } else if (strcmp(key, "renew_window_max") == 0) {
+                config->schedule.renew_window_max = atoi(value);
+            } else if (strcmp(key, "refresh_jitter") == 0) {
+                config->schedule.refresh_jitter = atoi(value);
+            } else if (strcmp(key, "host_phase") == 0) {
+                config->schedule.host_phase = (strcmp(value, "true") == 0) ? 1 : 0;
+            }
+        } else if (strcmp(current_section, "http") == 0) {
+            if (strcmp(key, "timeout") == 0) {
+                config->http_timeout = atoi(value);
+            } else if (strcmp(key, "max_response_size") == 0) {
+                config->max_response_size = atoi(value);
+            } else if (strcmp(key, "max_in_flight") == 0) {
+                config->max_in_flight = atoi(value);
+            } else if (strcmp(key, "adaptive_limit") == 0) {
+                config->adaptive_limit = (strcmp(value, "true") == 0) ? 1 : 0;
+            } else if (strcmp(key, "limit_min") == 0) {
+                config->limit_min = atoi(value);
+            } else if (strcmp(key, "limit_max") == 0) {
+                config->limit_max = atoi(value);
+            } else if (strcmp(key, "accept_encoding") == 0) {
+                strncpy(config->accept_encoding, value, sizeof(config->accept_encoding) - 1);
+                config->accept_encoding[sizeof(config->accept_encoding) - 1] = '\0';
+            }
+        } else if (strcmp(current_section, "metrics") == 0) {
+            if (strcmp(key, "port") == 0) {
+                config->metrics_port = atoi(value);
+            } else if (strcmp(key, "address") == 0) {
+                strncpy(config->metrics_address, value, sizeof(config->metrics_address) - 1);
+                config->metrics_address[sizeof(config->metrics_address) - 1] = '\0';
+            }
+        } else if (strcmp(current_section, "trace") == 0) {
+            if (strcmp(key, "format") == 0) {
+                strncpy(config->trace.format, value, sizeof(config->trace.format) - 1);
+                config->trace.format[sizeof(config->trace.format) - 1] = '\0';
+            } else if (strcmp(key, "output") == 0) {
+                strncpy(config->trace.output, value, sizeof(config->trace.output) - 1);
+                config->trace.output[sizeof(config->trace.output) - 1] = '\0';
+            } else if (strcmp(key, "record") == 0) {
+                strncpy(config->trace.record, value, sizeof(config->trace.record) - 1);
+                config->trace.record[sizeof(config->trace.record) - 1] = '\0';
+            }
+        } else if (strcmp(current_section, "tenants") == 0) {
+            if (strcmp(key, "workers") == 0) {
+                config->tenants.workers = atoi(value);
+            }
+        } else if (strcmp(current_section, "log") == 0) {
+            if (strcmp(key, "level") == 0) {
+                strncpy(config->log.level, value, sizeof(config->log.level) - 1);
+                config->log.level[sizeof(config->log.level) - 1] = '\0';
+            } else if (strcmp(key, "output") == 0) {
+                strncpy(config->log.output, value, sizeof(config->log.output) - 1);
+                config->log.output[sizeof(config->log.output) - 1] = '\0';
             }
         }
     }
@@ -152,6 +320,49 @@ int load_config(const char *config_file, app_config_t *config) {
         return -1;
     }
     
+    if (strcmp(config->token_type, "service") != 0 && strcmp(config->token_type, "batch") != 0) {
+        fprintf(stderr, "Error: vault.token_type must be 'service' or 'batch' (got '%s')\n", config->token_type);
+        return -1;
+    }
+    
+    if (strcmp(config->trace.format, "text") != 0 && strcmp(config->trace.format, "otel") != 0) {
+        fprintf(stderr, "Error: trace.format must be 'text' or 'otel' (got '%s')\n", config->trace.format);
+        return -1;
+    }
+    
+    if (config->tenants.workers < 1) {
+        fprintf(stderr, "Error: tenants.workers must be at least 1 (got %d)\n", config->tenants.workers);
+        return -1;
+    }
+    
+    if (strcmp(config->log.level, "debug") != 0 && strcmp(config->log.level, "info") != 0 &&
+        strcmp(config->log.level, "warn") != 0 && strcmp(config->log.level, "error") != 0 &&
+        strcmp(config->log.level, "off") != 0) {
+        fprintf(stderr, "Error: log.level must be debug, info, warn, error or off (got '%s')\n", config->log.level);
+        return -1;
+    }
+    
+    if (config->adaptive_limit && (config->limit_min < 1 || config->limit_max < config->limit_min)) {
+        fprintf(stderr, "Error: http.limit_min must be at least 1 and not above http.limit_max (got %d, %d)\n",
+                config->limit_min, config->limit_max);
+        return -1;
+    }
+    
+    if (config->pki.enabled && (!config->pki.role[0] || !config->pki.common_name[0])) {
+        fprintf(stderr, "Error: pki.role and pki.common_name are required when pki is enabled\n");
+        return -1;
+    }
+    
+    if (config->pki.renew_at < 1 || config->pki.renew_at > 100) {
+        fprintf(stderr, "Error: pki.renew_at must be between 1 and 100 (got %d)\n", config->pki.renew_at);
+        return -1;
+    }
+    
+    if (!config->pki.cert_file[0] != !config->pki.key_file[0]) {
+        fprintf(stderr, "Error: pki.cert_file and pki.key_file must be set together\n");
+        return -1;
+    }
+    
     return 0;
 }
 
@@ -165,26 +376,275 @@ void print_config(const app_config_t *config) {
     printf("Entity: %s\n", config->entity);
     printf("Vault Role ID: %s\n", config->vault_role_id);
     printf("Vault Secret ID: %s\n", config->vault_secret_id);
+    printf("Token Type: %s\n", config->token_type);
     
     printf("\n--- Secret Engines ---\n");
     printf("KV Engine: %s\n", config->secret_kv.enabled ? "enabled" : "disabled");
     if (config->secret_kv.enabled) {
         printf("  KV Path: %s\n", config->secret_kv.kv_path);
         printf("  Refresh Interval: %d seconds\n", config->secret_kv.refresh_interval);
+        printf("  Change Events: %s\n", config->secret_kv.events ? "enabled (polling fallback)" : "disabled");
+        if (config->secret_kv.prefetch[0]) {
+            printf("  Prefetch: %s (depth %d, max %d keys)\n", config->secret_kv.prefetch,
+                   config->secret_kv.prefetch_depth, config->secret_kv.prefetch_max_keys);
+        }
     }
     
     printf("Database Dynamic: %s\n", config->secret_database_dynamic.enabled ? "enabled" : "disabled");
     if (config->secret_database_dynamic.enabled) {
         printf("  Role ID: %s\n", config->secret_database_dynamic.role_id);
+        if (config->secret_database_dynamic.pool_size > 0) {
+            printf("  Credential Pool: %d (drain grace %d seconds)\n", config->secret_database_dynamic.pool_size,
+                   config->secret_database_dynamic.pool_drain_grace);
+        }
     }
     
     printf("Database Static: %s\n", config->secret_database_static.enabled ? "enabled" : "disabled");
     if (config->secret_database_static.enabled) {
         printf("  Role ID: %s\n", config->secret_database_static.role_id);
+        printf("  Rotation Skew: %d seconds\n", config->secret_database_static.rotation_skew);
+    }
+    
+    printf("Transit: %s\n", config->transit.enabled ? "enabled" : "disabled");
+    if (config->transit.enabled) {
+        printf("  Key: %s\n", config->transit.key);
+        printf("  Batch: %d items / %d ms window, %d in flight\n", config->transit.batch_size,
+               config->transit.batch_window_ms, config->transit.pipeline);
+        printf("  Envelope: data key per %ld records / %d seconds, %d keys cached\n",
+               config->transit.envelope_max_uses, config->transit.envelope_max_age, config->transit.envelope_cache);
     }
     
+    printf("PKI: %s\n", config->pki.enabled ? "enabled" : "disabled");
+    if (config->pki.enabled) {
+        printf("  Role: %s (CN: %s%s%s, TTL: %s)\n", config->pki.role, config->pki.common_name,
+               config->pki.alt_names[0] ? ", SAN: " : "", config->pki.alt_names,
+               config->pki.ttl[0] ? config->pki.ttl : "role default");
+        printf("  Renew At: %d%% of lifetime\n", config->pki.renew_at);
+        if (config->pki.cert_file[0]) printf("  Files: %s, %s\n", config->pki.cert_file, config->pki.key_file);
+    }
+    
+    printf("\n--- Schedule Settings ---\n");
+    printf("Renewal Window: %d%% ~ %d%% of TTL\n", config->schedule.renew_window_min, config->schedule.renew_window_max);
+    printf("Refresh Jitter: +/-%d%%\n", config->schedule.refresh_jitter);
+    printf("Host Phase Offset: %s\n", config->schedule.host_phase ? "enabled" : "disabled");
+    
     printf("\n--- HTTP Settings ---\n");
     printf("HTTP Timeout: %d seconds\n", config->http_timeout);
     printf("Max Response Size: %d bytes\n", config->max_response_size);
+    printf("Max In-Flight Requests: %d\n", config->max_in_flight);
+    if (config->adaptive_limit) {
+        printf("Adaptive Concurrency Limit: %d ~ %d\n", config->limit_min, config->limit_max);
+    } else {
+        printf("Adaptive Concurrency Limit: disabled\n");
+    }
+    printf("Accept-Encoding: %s\n", config->accept_encoding[0] ? config->accept_encoding : "(none)");
+    
+    printf("\n--- Metrics Settings ---\n");
+    if (config->metrics_port > 0) {
+        printf("Prometheus Endpoint: http://%s:%d/metrics\n", config->metrics_address, config->metrics_port);
+    } else {
+        printf("Prometheus Endpoint: disabled\n");
+    }
+    printf("Trace Dump (SIGUSR1): %s -> %s\n", config->trace.format,
+           config->trace.output[0] ? config->trace.output : "stderr");
+    printf("Traffic Record: %s\n", config->trace.record[0] ? config->trace.record : "disabled");
+    printf("Log: %s -> %s\n", config->log.level, config->log.output[0] ? config->log.output : "stdout");
+    printf("Tenant Workers: %d (used when [tenant:<name>] sections exist)\n", config->tenants.workers);
     printf("=====================================\n");
 }
+
+
+// 설정 비교 (핫 리로드): 실행 중인 설정과 새 설정의 차이를 CONFIG_CHANGED_* 비트로 반환
+unsigned config_diff(const app_config_t *running, const app_config_t *next) {
+    unsigned changes = 0;
+    if (!running || !next) return 0;
+    
+    if (running->secret_kv.enabled != next->secret_kv.enabled ||
+        strcmp(running->secret_kv.kv_path, next->secret_kv.kv_path) != 0) {
+        changes |= CONFIG_CHANGED_KV;
+    }
+    if (running->secret_kv.events != next->secret_kv.events) {
+        changes |= CONFIG_CHANGED_KV_EVENTS;
+    }
+    if (running->secret_kv.refresh_interval != next->secret_kv.refresh_interval) {
+        changes |= CONFIG_CHANGED_INTERVAL;
+    }
+    if (strcmp(running->secret_kv.prefetch, next->secret_kv.prefetch) != 0 ||
+        running->secret_kv.prefetch_depth != next->secret_kv.prefetch_depth ||
+        running->secret_kv.prefetch_max_keys != next->secret_kv.prefetch_max_keys) {
+        changes |= CONFIG_CHANGED_KV_PREFETCH;
+    }
+    if (running->secret_database_dynamic.enabled != next->secret_database_dynamic.enabled ||
+        strcmp(running->secret_database_dynamic.role_id, next->secret_database_dynamic.role_id) != 0 ||
+        running->secret_database_dynamic.pool_size != next->secret_database_dynamic.pool_size ||
+        running->secret_database_dynamic.pool_drain_grace != next->secret_database_dynamic.pool_drain_grace) {
+        changes |= CONFIG_CHANGED_DB_DYNAMIC;
+    }
+    if (running->secret_database_static.enabled != next->secret_database_static.enabled ||
+        strcmp(running->secret_database_static.role_id, next->secret_database_static.role_id) != 0 ||
+        running->secret_database_static.rotation_skew != next->secret_database_static.rotation_skew) {
+        changes |= CONFIG_CHANGED_DB_STATIC;
+    }
+    if (memcmp(&running->schedule, &next->schedule, sizeof(running->schedule)) != 0) {
+        changes |= CONFIG_CHANGED_SCHEDULE;
+    }
+    if (strcmp(running->log.level, next->log.level) != 0) {
+        changes |= CONFIG_CHANGED_LOG_LEVEL;
+    }
+    
+    // 토큰/연결/엔드포인트에 묶인 항목은 재시작해야 반영됨
+    if (strcmp(running->vault_url, next->vault_url) != 0 ||
+        strcmp(running->vault_namespace, next->vault_namespace) != 0 ||
+        strcmp(running->vault_role_id, next->vault_role_id) != 0 ||
+        strcmp(running->vault_secret_id, next->vault_secret_id) != 0 ||
+        strcmp(running->entity, next->entity) != 0 ||
+        strcmp(running->token_type, next->token_type) != 0 ||
+        running->http_timeout != next->http_timeout ||
+        running->max_response_size != next->max_response_size ||
+        running->max_in_flight != next->max_in_flight ||
+        running->adaptive_limit != next->adaptive_limit ||
+        running->limit_min != next->limit_min ||
+        running->limit_max != next->limit_max ||
+        strcmp(running->accept_encoding, next->accept_encoding) != 0 ||
+        running->metrics_port != next->metrics_port ||
+        strcmp(running->metrics_address, next->metrics_address) != 0 ||
+        running->tenants.workers != next->tenants.workers ||
+        running->transit.enabled != next->transit.enabled ||
+        strcmp(running->transit.key, next->transit.key) != 0 ||
+        running->transit.batch_size != next->transit.batch_size ||
+        running->transit.batch_window_ms != next->transit.batch_window_ms ||
+        running->transit.pipeline != next->transit.pipeline ||
+        running->transit.envelope_max_uses != next->transit.envelope_max_uses ||
+        running->transit.envelope_max_age != next->transit.envelope_max_age ||
+        running->transit.envelope_cache != next->transit.envelope_cache ||
+        running->pki.enabled != next->pki.enabled ||
+        strcmp(running->pki.role, next->pki.role) != 0 ||
+        strcmp(running->pki.common_name, next->pki.common_name) != 0 ||
+        strcmp(running->pki.alt_names, next->pki.alt_names) != 0 ||
+        strcmp(running->pki.ttl, next->pki.ttl) != 0 ||
+        running->pki.renew_at != next->pki.renew_at ||
+        strcmp(running->pki.cert_file, next->pki.cert_file) != 0 ||
+        strcmp(running->pki.key_file, next->pki.key_file) != 0 ||
+        strcmp(running->trace.format, next->trace.format) != 0 ||
+        strcmp(running->trace.output, next->trace.output) != 0 ||
+        strcmp(running->trace.record, next->trace.record) != 0 ||
+        strcmp(running->log.output, next->log.output) != 0) {
+        changes |= CONFIG_CHANGED_RESTART;
+    }
+    
+    return changes;
+}
+
+// 새 설정 중 리로드 가능한 항목만 반영 (재시작이 필요한 항목은 기존 값 유지)
+// 경로/활성화 항목은 해당 갱신 스레드가 중지된 상태에서 호출해야 합니다.
+// refresh_interval은 실행 중인 갱신 스레드가 읽으므로 원자적으로 기록합니다.
+void config_apply_reload(app_config_t *running, const app_config_t *next, unsigned changes) {
+    if (!running || !next) return;
+    
+    if (changes & CONFIG_CHANGED_KV) {
+        running->secret_kv.enabled = next->secret_kv.enabled;
+        memcpy(running->secret_kv.kv_path, next->secret_kv.kv_path, sizeof(running->secret_kv.kv_path));
+    }
+    if (changes & CONFIG_CHANGED_KV_EVENTS) {
+        running->secret_kv.events = next->secret_kv.events;
+    }
+    if (changes & CONFIG_CHANGED_KV_PREFETCH) {
+        memcpy(running->secret_kv.prefetch, next->secret_kv.prefetch, sizeof(running->secret_kv.prefetch));
+        running->secret_kv.prefetch_depth = next->secret_kv.prefetch_depth;
+        running->secret_kv.prefetch_max_keys = next->secret_kv.prefetch_max_keys;
+    }
+    if (changes & CONFIG_CHANGED_INTERVAL) {
+        __atomic_store_n(&running->secret_kv.refresh_interval, next->secret_kv.refresh_interval, __ATOMIC_RELAXED);
+    }
+    if (changes & CONFIG_CHANGED_DB_DYNAMIC) {
+        running->secret_database_dynamic = next->secret_database_dynamic;
+    }
+    if (changes & CONFIG_CHANGED_DB_STATIC) {
+        running->secret_database_static = next->secret_database_static;
+    }
+    if (changes & CONFIG_CHANGED_SCHEDULE) {
+        running->schedule = next->schedule;
+    }
+    if (changes & CONFIG_CHANGED_LOG_LEVEL) {
+        memcpy(running->log.level, next->log.level, sizeof(running->log.level));
+    }
+}
+
+
+// 테넌트 설정 로드 ([tenant:<name>] 섹션)
+// 각 테넌트는 기본 설정(base)을 복사한 뒤 테넌트 항목만 덮어씁니다.
+// 성공 시 테넌트 수를 반환하고 *tenants는 호출자가 free, 테넌트 섹션이 없으면 0
+int load_tenant_configs(const char *config_file, const app_config_t *base, app_config_t **tenants) {
+    if (!config_file || !base || !tenants) return -1;
+    *tenants = NULL;
+    
+    FILE *file = fopen(config_file, "r");
+    if (!file) return 0;
+    
+    char line[512];
+    char current_section[64] = "";
+    char tenant_section[64] = "";
+    char *key, *value;
+    app_config_t *list = NULL;
+    int count = 0, capacity = 0;
+    
+    while (ini_next(file, current_section, sizeof(current_section), line, sizeof(line), &key, &value)) {
+        if (strncmp(current_section, "tenant:", 7) != 0 || !current_section[7]) continue;
+        
+        // 새 테넌트 섹션 시작 (Entity 기본값은 섹션 이름)
+        if (count == 0 || strcmp(tenant_section, current_section) != 0) {
+            if (count == capacity) {
+                capacity = capacity ? capacity * 2 : 16;
+                app_config_t *grown = realloc(list, (size_t)capacity * sizeof(app_config_t));
+                if (!grown) {
+                    fprintf(stderr, "Error: out of memory loading tenants\n");
+                    free(list);
+                    fclose(file);
+                    return -1;
+                }
+                list = grown;
+            }
+            list[count] = *base;
+            snprintf(list[count].entity, sizeof(list[count].entity), "%s", current_section + 7);
+            memcpy(tenant_section, current_section, sizeof(tenant_section));
+            count++;
+        }
+        
+        app_config_t *tenant = &list[count - 1];
+        if (strcmp(key, "entity") == 0) {
+            snprintf(tenant->entity, sizeof(tenant->entity), "%s", value);
+        } else if (strcmp(key, "namespace") == 0) {
+            snprintf(tenant->vault_namespace, sizeof(tenant->vault_namespace), "%s", value);
+        } else if (strcmp(key, "role_id") == 0) {
+            snprintf(tenant->vault_role_id, sizeof(tenant->vault_role_id), "%s", value);
+        } else if (strcmp(key, "secret_id") == 0) {
+            snprintf(tenant->vault_secret_id, sizeof(tenant->vault_secret_id), "%s", value);
+        } else if (strcmp(key, "kv_path") == 0) {
+            snprintf(tenant->secret_kv.kv_path, sizeof(tenant->secret_kv.kv_path), "%s", value);
+            tenant->secret_kv.enabled = value[0] != '\0';
+        } else if (strcmp(key, "db_dynamic_role") == 0) {
+            snprintf(tenant->secret_database_dynamic.role_id, sizeof(tenant->secret_database_dynamic.role_id), "%s", value);
+            tenant->secret_database_dynamic.enabled = value[0] != '\0';
+        } else if (strcmp(key, "db_static_role") == 0) {
+            snprintf(tenant->secret_database_static.role_id, sizeof(tenant->secret_database_static.role_id), "%s", value);
+            tenant->secret_database_static.enabled = value[0] != '\0';
+        }
+    }
+    fclose(file);
+    
+    // 같은 Entity가 두 번 나오면 캐시/경로가 겹치므로 거부
+    for (int i = 0; i < count; i++) {
+        for (int j = i + 1; j < count; j++) {
+            if (strcmp(list[i].entity, list[j].entity) == 0 &&
+                strcmp(list[i].vault_namespace, list[j].vault_namespace) == 0) {
+                fprintf(stderr, "Error: duplicate tenant entity '%s' in namespace '%s'\n",
+                        list[i].entity, list[i].vault_namespace);
+                free(list);
+                return -1;
+            }
+        }
+    }
+    
+    *tenants = list;
+    return count;
+}
@@ -0,0 +1,147 @@
+#define _POSIX_C_SOURCE 200809L
+#include "config_watch.h"
+#include "vault_log.h"
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <poll.h>
+#include <sys/stat.h>
+#ifdef __linux__
+#include <sys/inotify.h>
+#endif
+
+#ifdef __APPLE__
+#define STAT_MTIME_NSEC(st) ((st).st_mtimespec.tv_nsec)
+#else
+#define STAT_MTIME_NSEC(st) ((st).st_mtim.tv_nsec)
+#endif
+
+static long monotonic_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+static void sleep_ms(int ms) {
+    struct timespec ts = {ms / 1000, (long)(ms % 1000) * 1000000L};
+    nanosleep(&ts, NULL);
+}
+
+// 파일 상태가 마지막 확인 이후 달라졌는지 확인하고 갱신 (심볼릭 링크는 따라감)
+// 교체 도중이라 파일이 잠시 없으면 변경 없음으로 보고 다음 이벤트를 기다림
+static int file_changed(config_watch_t *watch) {
+    struct stat st;
+    if (stat(watch->path, &st) != 0) return 0;
+
+    int changed = st.st_mtime != watch->mtime || STAT_MTIME_NSEC(st) != watch->mtime_nsec ||
+                  st.st_size != watch->size || st.st_ino != watch->ino;
+    watch->mtime = st.st_mtime;
+    watch->mtime_nsec = STAT_MTIME_NSEC(st);
+    watch->size = st.st_size;
+    watch->ino = st.st_ino;
+    return changed;
+}
+
+#ifdef __linux__
+// 설정 파일(또는 ConfigMap의 ..data 링크)에 대한 이벤트를 timeout_ms 동안 대기
+static int wait_inotify(config_watch_t *watch, int timeout_ms) {
+    char buffer[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+    long deadline = monotonic_ms() + timeout_ms;
+
+    for (;;) {
+        long remaining = deadline - monotonic_ms();
+        if (remaining < 0) remaining = 0;
+
+        struct pollfd pfd = {watch->fd, POLLIN, 0};
+        int ready = poll(&pfd, 1, (int)remaining);
+        if (ready < 0 && errno != EINTR) return 0;
+        if (ready <= 0) {
+            if (remaining == 0) return 0;
+            continue;
+        }
+
+        int relevant = 0;
+        ssize_t n;
+        while ((n = read(watch->fd, buffer, sizeof(buffer))) > 0) {
+            for (char *p = buffer; p < buffer + n;) {
+                const struct inotify_event *event = (const struct inotify_event *)p;
+                if (event->len > 0 &&
+                    (strcmp(event->name, watch->name) == 0 || strncmp(event->name, "..", 2) == 0)) {
+                    relevant = 1;
+                }
+                p += sizeof(struct inotify_event) + event->len;
+            }
+        }
+        if (relevant) return 1;
+    }
+}
+#endif
+
+int config_watch_open(config_watch_t *watch, const char *path) {
+    if (!watch || !path || !path[0]) return -1;
+
+    memset(watch, 0, sizeof(*watch));
+    watch->fd = -1;
+    watch->wd = -1;
+    snprintf(watch->path, sizeof(watch->path), "%s", path);
+
+    // 경로를 디렉터리와 파일 이름으로 분리
+    const char *slash = strrchr(path, '/');
+    if (slash) {
+        int dir_len = slash == path ? 1 : (int)(slash - path);
+        snprintf(watch->dir, sizeof(watch->dir), "%.*s", dir_len, path);
+        snprintf(watch->name, sizeof(watch->name), "%s", slash + 1);
+    } else {
+        snprintf(watch->dir, sizeof(watch->dir), ".");
+        snprintf(watch->name, sizeof(watch->name), "%s", path);
+    }
+    file_changed(watch);
+
+#ifdef __linux__
+    watch->fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (watch->fd >= 0) {
+        watch->wd = inotify_add_watch(watch->fd, watch->dir,
+                                      IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_DELETE);
+        if (watch->wd < 0) {
+            close(watch->fd);
+            watch->fd = -1;
+        }
+    }
+    if (watch->fd < 0) {
+        VAULT_LOG_WARN("⚠️ inotify unavailable for %s (%s), polling config file instead", watch->dir, strerror(errno));
+    }
+#endif
+    return 0;
+}
+
+void config_watch_close(config_watch_t *watch) {
+    if (!watch) return;
+#ifdef __linux__
+    if (watch->fd >= 0) {
+        close(watch->fd);
+    }
+#endif
+    watch->fd = -1;
+    watch->wd = -1;
+}
+
+int config_watch_wait(config_watch_t *watch, int timeout_ms) {
+#ifdef __linux__
+    if (watch->fd >= 0) {
+        if (!wait_inotify(watch, timeout_ms)) return 0;
+
+        // 저장이 여러 이벤트로 나뉘어 오므로 조용해질 때까지 모은 뒤 실제 변경 여부 확인
+        while (wait_inotify(watch, CONFIG_WATCH_SETTLE_MS)) {
+        }
+        return file_changed(watch);
+    }
+#endif
+    sleep_ms(timeout_ms);
+    if (!file_changed(watch)) return 0;
+
+    // 쓰는 도중일 수 있으므로 잠시 기다린 뒤 최신 상태로 맞춤
+    sleep_ms(CONFIG_WATCH_SETTLE_MS);
+    file_changed(watch);
+    return 1;
+}
@@ -0,0 +1,34 @@
+#ifndef CONFIG_WATCH_H
+#define CONFIG_WATCH_H
+
+#include <time.h>
+#include <sys/types.h>
+
+// 설정 파일 변경 감시 (핫 리로드)
+// Linux에서는 inotify로 설정 파일이 있는 디렉터리를 감시하여 편집기의 저장(임시 파일 후 rename)과
+// Kubernetes ConfigMap 갱신(..data 심볼릭 링크 교체)도 감지하고, 그 외 환경에서는 파일 상태
+// (mtime/크기/inode)를 주기적으로 비교합니다. 연속된 쓰기는 잠시 조용해질 때까지 모아서 한 번만 알립니다.
+
+#define CONFIG_WATCH_SETTLE_MS 200  // 마지막 이벤트 후 이 시간 동안 변화가 없으면 변경으로 판단
+
+typedef struct {
+    char dir[512];    // 감시 디렉터리
+    char name[256];   // 설정 파일 이름
+    char path[768];   // 설정 파일 경로
+    int fd;           // inotify fd (-1이면 파일 상태 폴링)
+    int wd;           // inotify 감시 디스크립터
+
+    // 마지막으로 확인한 파일 상태 (실제 내용 변경 여부 판단)
+    time_t mtime;
+    long mtime_nsec;
+    off_t size;
+    ino_t ino;
+} config_watch_t;
+
+int config_watch_open(config_watch_t *watch, const char *path);
+void config_watch_close(config_watch_t *watch);
+
+// 설정 파일 변경 대기: 변경되었으면 1, timeout_ms 동안 변경이 없으면 0 반환
+int config_watch_wait(config_watch_t *watch, int timeout_ms);
+
+#endif
@@ -1,4 +1,11 @@
+#define _POSIX_C_SOURCE 200809L
 #include "vault_client.h"
+#include "vault_events.h"
+#include "vault_tenants.h"
+#include "vault_transit.h"
+#include "vault_envelope.h"
+#include "vault_pki.h"
+#include "config_watch.h"
 #include "config.h"
 #include <stdio.h>
 #include <stdlib.h>
@@ -9,8 +16,19 @@
 
 // 전역 변수
 vault_client_t vault_client;
+vault_transport_t vault_transport;  // 요청 간 연결 재사용 (연결 풀)
 app_config_t app_config;
+vault_events_t kv_events;  // KV 변경 이벤트 구독 ([secret-kv] events = true)
+vault_transit_t transit;  // Transit batch 암호화 ([transit] enabled = true)
+int transit_started = 0;
+vault_envelope_t envelope;  // Transit 데이터 키를 이용한 로컬 envelope 암호화 (Transit과 함께 시작)
+int envelope_started = 0;
+vault_pki_t pki;  // PKI 인증서 발급 및 만료 전 미리 발급 ([pki] enabled = true)
+int pki_started = 0;
+config_watch_t config_watch;  // 설정 파일 변경 감시 (핫 리로드)
+const char *config_path = "config.ini";
 volatile int should_exit = 0;
+volatile sig_atomic_t reload_requested = 0;  // SIGHUP 수신 (설정 다시 읽기)
 
 // 시그널 처리
 void signal_handler(int sig) {
@@ -23,146 +41,540 @@ void signal_handler(int sig) {
     }
 }
 
+// SIGHUP: 설정 다시 읽기 요청 (실제 리로드는 메인 루프에서 수행)
+void reload_signal_handler(int sig) {
+    (void)sig;
+    reload_requested = 1;
+}
+
+// SIGUSR1: 요청 추적 덤프 요청 (실제 덤프는 토큰 갱신 스레드에서 수행)
+void trace_signal_handler(int sig) {
+    (void)sig;
+    vault_trace_request_dump();
+}
+
+// 요청이 있으면 요청 추적 링 버퍼를 설정된 형식/경로로 덤프
+static void dump_trace_if_requested(void) {
+    if (!vault_trace_take_dump_request()) return;
+    
+    vault_trace_format_t format = VAULT_TRACE_TEXT;
+    vault_trace_parse_format(app_config.trace.format, &format);
+    
+    FILE *out = stderr;
+    if (app_config.trace.output[0]) {
+        out = fopen(app_config.trace.output, "a");
+        if (!out) {
+            perror("Failed to open trace output");
+            out = stderr;
+        }
+    }
+    vault_trace_dump(out, format, app_config.entity);
+    if (out != stderr) {
+        fclose(out);
+    }
+}
+
+// 시크릿 갱신 스레드 상태 (설정 리로드 시 스레드별로 중지/시작/재스케줄)
+typedef struct {
+    const char *name;        // 로그 표시 이름
+    const char *task;        // 위상 분산 작업 이름 (vault_schedule_phase_offset)
+    void *(*run)(void *);    // 스레드 함수 (인자: refresher_t *)
+    const int *enabled;      // 시크릿 엔진 활성화 설정
+    int interval_scale;      // refresh_interval 배수
+    pthread_t thread;
+    int running;
+    int stop;                // 중지 요청 (원자적 접근)
+    int reschedule;          // 대기 간격 재계산 요청 (원자적 접근)
+} refresher_t;
+
+// 갱신 스레드가 계속 실행되어야 하는지 확인
+static int refresher_active(refresher_t *self) {
+    return !should_exit && !__atomic_load_n(&self->stop, __ATOMIC_ACQUIRE);
+}
+
+// 대기 중단 여부 (종료/중지 요청 또는 간격 변경)
+static int refresher_interrupted(refresher_t *self) {
+    return !refresher_active(self) || __atomic_load_n(&self->reschedule, __ATOMIC_ACQUIRE);
+}
+
+// 현재 갱신 간격 (설정 리로드로 바뀔 수 있으므로 매번 읽음)
+static int refresher_interval(refresher_t *self) {
+    return __atomic_load_n(&app_config.secret_kv.refresh_interval, __ATOMIC_RELAXED) * self->interval_scale;
+}
+
+// KV 갱신 대기: 이벤트 스트림이 연결되어 있으면 폴링 없이 변경 이벤트를 기다리고,
+// 끊기면 지정한 시간(초)이 지난 시점에 폴링으로 갱신
+static void wait_kv_refresh(refresher_t *self, int seconds) {
+    for (int i = 0; !refresher_interrupted(self); i++) {
+        if (i >= seconds && !vault_events_connected(&kv_events)) return;
+        if (vault_events_wait(&kv_events, 1000)) return;
+    }
+}
+
+// Database Dynamic 갱신 대기: 자격증명 풀을 쓰면 다음 교체/폐기 시각이 먼저 오는 경우 그때 반환
+// (풀은 메인 루프의 첫 조회로 채워질 수 있으므로 매초 다시 확인)
+static void wait_db_dynamic_refresh(refresher_t *self, int seconds) {
+    for (int i = 0; i < seconds && !refresher_interrupted(self); i++) {
+        if (app_config.secret_database_dynamic.pool_size > 0) {
+            time_t next_event = vault_db_pool_next_event(&vault_client.db_pool);
+            if (next_event > 0 && next_event <= time(NULL)) return;
+        }
+        sleep(1);
+    }
+}
+
+// Database Static 갱신 대기: 비밀번호 교체 시각을 알면 그 시각(+ rotation_skew)까지 요청 없이 기다리고,
+// 모르면 지정한 시간(초)이 지난 시점에 반환 (캐시는 메인 루프의 첫 조회로 채워질 수 있으므로 매초 다시 확인)
+static void wait_db_static_refresh(refresher_t *self, int seconds) {
+    for (int i = 0; !refresher_interrupted(self); i++) {
+        time_t next_refresh = vault_db_static_next_refresh(&vault_client);
+        if (next_refresh > 0 ? next_refresh <= time(NULL) : i >= seconds) return;
+        sleep(1);
+    }
+}
+
+// 간격 변경 요청 소비: 요청이 있었으면 1 (갱신하지 않고 새 간격으로 다시 대기)
+static int refresher_take_reschedule(refresher_t *self) {
+    return __atomic_exchange_n(&self->reschedule, 0, __ATOMIC_ACQ_REL);
+}
+
+// 시크릿 변경 알림 (값은 출력하지 않고 변경된 필드 이름만 기록)
+static void on_secret_change(const vault_secret_change_t *change, void *ctx) {
+    (void)ctx;
+    static const char *const kind_names[] = { "added", "removed", "changed" };
+    
+    if (change->new_version >= 0) {
+        VAULT_LOG_INFO("🔔 %s secret changed (version %ld -> %ld, %zu fields)", change->secret_name,
+                       change->old_version, change->new_version, change->change_count);
+    } else {
+        VAULT_LOG_INFO("🔔 %s secret changed (%zu fields)", change->secret_name, change->change_count);
+    }
+    for (size_t i = 0; i < change->change_count; i++) {
+        VAULT_LOG_INFO("   %s: %s", kind_names[change->changes[i].kind], change->changes[i].field);
+    }
+}
+
+// KV 하위 경로 미리 읽기 ([secret-kv] prefetch)
+// 처음에는 모든 키를 동시에 읽고, 이후에는 metadata 버전만 확인하여 바뀐 키만 다시 읽습니다.
+static void prefetch_kv(vault_client_t *client) {
+    const app_config_t *config = client->config;
+    if (!config->secret_kv.enabled || !config->secret_kv.prefetch[0] || config->secret_kv.prefetch_max_keys <= 0) {
+        return;
+    }
+    
+    char mount[128];
+    snprintf(mount, sizeof(mount), "%s-kv", config->entity);
+    vault_prefetch_kv(client, mount, config->secret_kv.prefetch, config->secret_kv.prefetch_depth,
+                      (size_t)config->secret_kv.prefetch_max_keys, NULL);
+}
+
+// Transit 시작 및 왕복 확인 (키 권한/마운트 설정 오류를 기동 시 바로 드러냄)
+static void start_transit(vault_client_t *client) {
+    if (!app_config.transit.enabled) return;
+    if (vault_transit_init(&transit, client) != 0) {
+        VAULT_LOG_ERROR("Failed to start Transit batcher");
+        return;
+    }
+    transit_started = 1;
+    
+    const char *sample[] = { "vault-app transit check" };
+    char *ciphertext[1] = { NULL };
+    char *plaintext[1] = { NULL };
+    if (vault_transit_encrypt_batch(&transit, app_config.transit.key, sample, 1, ciphertext) == 0 &&
+        vault_transit_decrypt_batch(&transit, app_config.transit.key, (const char *const *)ciphertext, 1,
+                                    plaintext) == 0 &&
+        strcmp(plaintext[0], sample[0]) == 0) {
+        VAULT_LOG_INFO("🔐 Transit round trip ok (key: %s, batch %d items / %d ms, %d in flight)",
+                       app_config.transit.key, transit.batch_size, transit.batch_window_ms, transit.sender_count);
+    } else {
+        VAULT_LOG_ERROR("Transit round trip failed (key: %s)", app_config.transit.key);
+    }
+    vault_transit_free(ciphertext[0]);
+    vault_transit_free(plaintext[0]);
+    
+    if (vault_envelope_init(&envelope, client) != 0) {
+        VAULT_LOG_ERROR("Failed to start envelope encryption");
+        return;
+    }
+    envelope_started = 1;
+    
+    unsigned char *record = NULL;
+    unsigned char *opened = NULL;
+    size_t record_len = 0, opened_len = 0;
+    if (vault_envelope_encrypt(&envelope, app_config.transit.key, sample[0], strlen(sample[0]), &record,
+                               &record_len) == 0 &&
+        vault_envelope_decrypt(&envelope, app_config.transit.key, record, record_len, &opened, &opened_len) == 0 &&
+        opened_len == strlen(sample[0]) && memcmp(opened, sample[0], opened_len) == 0) {
+        VAULT_LOG_INFO("🔐 Envelope round trip ok (data key per %ld records / %d seconds%s)",
+                       app_config.transit.envelope_max_uses, app_config.transit.envelope_max_age,
+                       envelope.arena.locked ? "" : ", key memory not locked");
+    } else {
+        VAULT_LOG_ERROR("Envelope round trip failed (key: %s)", app_config.transit.key);
+    }
+    free(record);
+    vault_envelope_free(opened, opened_len + 1);
+}
+
+// 인증서 교체 알림 (TLS 서버라면 여기서 SSL_CTX에 새 인증서/키를 적재)
+static void on_certificate_reload(const vault_pki_cert_t *cert, void *ctx) {
+    (void)ctx;
+    VAULT_LOG_INFO("📜 Certificate #%lu ready for TLS reload (serial: %s, valid until %ld)", cert->generation,
+                   cert->serial, (long)cert->not_after);
+}
+
+// PKI 시작 (첫 인증서는 기동 중에 발급, 이후 갱신 스레드가 만료 전에 미리 발급)
+static void start_pki(vault_client_t *client) {
+    if (!app_config.pki.enabled) return;
+    if (vault_pki_init(&pki, client) != 0) {
+        VAULT_LOG_ERROR("Failed to start PKI issuer");
+        return;
+    }
+    pki_started = 1;
+    if (vault_pki_start(&pki) != 0) {
+        VAULT_LOG_ERROR("Initial certificate issue failed, retrying in background (role: %s)", app_config.pki.role);
+    }
+    vault_pki_on_reload(&pki, on_certificate_reload, NULL);
+}
+
 // KV 시크릿 갱신 스레드
 void* kv_refresh_thread(void* arg) {
-    vault_client_t *client = (vault_client_t*)arg;
+    refresher_t *self = (refresher_t*)arg;
+    vault_client_t *client = &vault_client;
     
-    while (!should_exit) {
-        // 설정된 간격만큼 대기
-        int refresh_interval = client->config->secret_kv.refresh_interval;
-        for (int i = 0; i < refresh_interval && !should_exit; i++) {
-            sleep(1);
-        }
+    // 첫 실행 위상 분산 (여러 Pod가 동시에 기동되어도 요청이 몰리지 않도록)
+    wait_kv_refresh(self, vault_schedule_phase_offset(&client->schedule, self->task, refresher_interval(self)));
+    
+    while (refresher_active(self)) {
+        // 설정된 간격만큼 대기 (± jitter)
+        // (이벤트 구독 중에는 변경 이벤트가 올 때까지)
+        wait_kv_refresh(self, vault_schedule_next_interval(&client->schedule, refresher_interval(self)));
         
-        if (should_exit) break;
+        if (!refresher_active(self)) break;
+        if (refresher_take_reschedule(self)) continue;
         
         // KV 시크릿 갱신
         if (client->config->secret_kv.enabled) {
-            printf("\n=== KV Secret Refresh ===\n");
+            VAULT_LOG_INFO("=== KV Secret Refresh ===");
             vault_refresh_kv_secret(client);
+            prefetch_kv(client);
         }
     }
     
-    printf("KV refresh thread terminated\n");
+    VAULT_LOG_INFO("KV refresh thread terminated");
     return NULL;
 }
 
 // Database Dynamic 시크릿 갱신 스레드
 void* db_dynamic_refresh_thread(void* arg) {
-    vault_client_t *client = (vault_client_t*)arg;
+    refresher_t *self = (refresher_t*)arg;
+    vault_client_t *client = &vault_client;
     
-    while (!should_exit) {
-        // 설정된 간격만큼 대기
-        int refresh_interval = client->config->secret_kv.refresh_interval;
-        for (int i = 0; i < refresh_interval && !should_exit; i++) {
-            sleep(1);
-        }
+    // 첫 실행 위상 분산
+    wait_db_dynamic_refresh(self, vault_schedule_phase_offset(&client->schedule, self->task, refresher_interval(self)));
+    
+    while (refresher_active(self)) {
+        // 설정된 간격만큼 대기 (± jitter)
+        wait_db_dynamic_refresh(self, vault_schedule_next_interval(&client->schedule, refresher_interval(self)));
         
-        if (should_exit) break;
+        if (!refresher_active(self)) break;
+        if (refresher_take_reschedule(self)) continue;
         
         // Database Dynamic 시크릿 갱신
         if (client->config->secret_database_dynamic.enabled) {
-            printf("\n=== Database Dynamic Secret Refresh ===\n");
+            VAULT_LOG_INFO("=== Database Dynamic Secret Refresh ===");
             vault_refresh_db_dynamic_secret(client);
         }
     }
     
-    printf("Database Dynamic refresh thread terminated\n");
+    VAULT_LOG_INFO("Database Dynamic refresh thread terminated");
     return NULL;
 }
 
 // Database Static 시크릿 갱신 스레드
 void* db_static_refresh_thread(void* arg) {
-    vault_client_t *client = (vault_client_t*)arg;
+    refresher_t *self = (refresher_t*)arg;
+    vault_client_t *client = &vault_client;
     
-    while (!should_exit) {
-        // 설정된 간격만큼 대기 (Database Static은 자주 변경되지 않으므로 더 긴 간격)
-        int refresh_interval = client->config->secret_kv.refresh_interval * 2; // 2배 간격
-        for (int i = 0; i < refresh_interval && !should_exit; i++) {
-            sleep(1);
-        }
+    // 첫 실행 위상 분산
+    wait_db_static_refresh(self, vault_schedule_phase_offset(&client->schedule, self->task, refresher_interval(self)));
+    
+    while (refresher_active(self)) {
+        // 비밀번호 교체 시각까지 대기
+        // (교체 정보가 없으면 설정된 간격, Database Static은 자주 변경되지 않으므로 더 긴 간격, ± jitter)
+        wait_db_static_refresh(self, vault_schedule_next_interval(&client->schedule, refresher_interval(self)));
         
-        if (should_exit) break;
+        if (!refresher_active(self)) break;
+        if (refresher_take_reschedule(self)) continue;
         
-        // Database Static 시크릿 갱신
-        if (client->config->secret_database_static.enabled) {
-            printf("\n=== Database Static Secret Refresh ===\n");
+        // Database Static 시크릿 갱신 (교체 시각을 아는데 아직 오지 않았으면 건너뜀 - 메인 루프가 먼저 갱신한 경우)
+        if (client->config->secret_database_static.enabled &&
+            (vault_db_static_next_refresh(client) == 0 || vault_is_db_static_secret_stale(client))) {
+            VAULT_LOG_INFO("=== Database Static Secret Refresh ===");
             vault_refresh_db_static_secret(client);
         }
     }
     
-    printf("Database Static refresh thread terminated\n");
+    VAULT_LOG_INFO("Database Static refresh thread terminated");
     return NULL;
 }
 
+enum { REFRESHER_KV, REFRESHER_DB_DYNAMIC, REFRESHER_DB_STATIC, REFRESHER_COUNT };
+
+static refresher_t refreshers[REFRESHER_COUNT] = {
+    { "KV", "kv", kv_refresh_thread, &app_config.secret_kv.enabled, 1, 0, 0, 0, 0 },
+    { "Database Dynamic", "database-dynamic", db_dynamic_refresh_thread,
+      &app_config.secret_database_dynamic.enabled, 1, 0, 0, 0, 0 },
+    { "Database Static", "database-static", db_static_refresh_thread,
+      &app_config.secret_database_static.enabled, 2, 0, 0, 0, 0 },  // 2배 간격
+};
+
+static int refresher_start(refresher_t *r) {
+    if (r->running) return 0;
+    
+    __atomic_store_n(&r->stop, 0, __ATOMIC_RELEASE);
+    __atomic_store_n(&r->reschedule, 0, __ATOMIC_RELEASE);
+    if (pthread_create(&r->thread, NULL, r->run, r) != 0) {
+        VAULT_LOG_ERROR("Failed to create %s refresh thread", r->name);
+        return -1;
+    }
+    r->running = 1;
+    VAULT_LOG_INFO("✅ %s refresh thread started (interval: %d seconds)", r->name, refresher_interval(r));
+    return 0;
+}
+
+static void refresher_stop(refresher_t *r) {
+    if (!r->running) return;
+    
+    __atomic_store_n(&r->stop, 1, __ATOMIC_RELEASE);
+    pthread_join(r->thread, NULL);
+    r->running = 0;
+}
+
+// KV 변경 이벤트 구독 시작 (연결되면 폴링 중단, 끊기면 폴링으로 복귀)
+static void start_kv_events(void) {
+    if (!app_config.secret_kv.enabled || !app_config.secret_kv.events || kv_events.running) return;
+    
+    if (vault_events_start(&kv_events, &vault_client) != 0) {
+        VAULT_LOG_WARN("⚠️ Failed to start KV event subscription, using polling only");
+    }
+}
+
+// 설정 핫 리로드: 새 설정을 읽어 실행 중인 설정과 비교한 뒤 영향받는 갱신 스레드만
+// 중지/시작/재스케줄 (토큰과 변경되지 않은 시크릿 캐시는 유지)
+static void reload_config(void) {
+    static const struct { unsigned bit; const char *name; } change_names[] = {
+        { CONFIG_CHANGED_KV, "secret-kv" },
+        { CONFIG_CHANGED_KV_EVENTS, "secret-kv.events" },
+        { CONFIG_CHANGED_KV_PREFETCH, "secret-kv.prefetch" },
+        { CONFIG_CHANGED_DB_DYNAMIC, "secret-database-dynamic" },
+        { CONFIG_CHANGED_DB_STATIC, "secret-database-static" },
+        { CONFIG_CHANGED_INTERVAL, "refresh_interval" },
+        { CONFIG_CHANGED_SCHEDULE, "schedule" },
+        { CONFIG_CHANGED_LOG_LEVEL, "log.level" },
+    };
+    
+    app_config_t next;
+    if (load_config(config_path, &next) != 0) {
+        VAULT_LOG_WARN("⚠️ Config reload failed (%s), keeping current configuration", config_path);
+        return;
+    }
+    
+    unsigned changes = config_diff(&app_config, &next);
+    if (changes & CONFIG_CHANGED_RESTART) {
+        VAULT_LOG_WARN("⚠️ Changes to [vault], [http], [metrics], [trace], [tenants] or log output require a restart (ignored)");
+        changes &= ~CONFIG_CHANGED_RESTART;
+    }
+    if (changes == 0) {
+        VAULT_LOG_INFO("Config reloaded: no applicable changes");
+        return;
+    }
+    
+    char names[256] = "";
+    size_t names_len = 0;
+    for (size_t i = 0; i < sizeof(change_names) / sizeof(change_names[0]); i++) {
+        if (!(changes & change_names[i].bit)) continue;
+        int written = snprintf(names + names_len, sizeof(names) - names_len, "%s%s",
+                               names_len ? ", " : "", change_names[i].name);
+        if (written < 0 || (size_t)written >= sizeof(names) - names_len) break;
+        names_len += (size_t)written;
+    }
+    VAULT_LOG_INFO("🔁 Reloading configuration from %s: %s", config_path, names);
+    
+    // 1. 경로/활성화가 바뀐 시크릿의 갱신 스레드 중지
+    if (changes & (CONFIG_CHANGED_KV | CONFIG_CHANGED_KV_EVENTS)) {
+        vault_events_stop(&kv_events);
+    }
+    if (changes & (CONFIG_CHANGED_KV | CONFIG_CHANGED_KV_PREFETCH)) refresher_stop(&refreshers[REFRESHER_KV]);
+    if (changes & CONFIG_CHANGED_DB_DYNAMIC) refresher_stop(&refreshers[REFRESHER_DB_DYNAMIC]);
+    if (changes & CONFIG_CHANGED_DB_STATIC) refresher_stop(&refreshers[REFRESHER_DB_STATIC]);
+    
+    // 2. 새 설정 반영 (바뀐 시크릿의 경로 재구성 및 캐시 폐기)
+    config_apply_reload(&app_config, &next, changes);
+    vault_client_apply_config(&vault_client, changes);
+    if (changes & CONFIG_CHANGED_LOG_LEVEL) {
+        vault_log_level_t log_level = VAULT_LOG_INFO;
+        vault_log_parse_level(app_config.log.level, &log_level);
+        vault_log_set_level(log_level);
+    }
+    
+    // 3. 활성화된 갱신 스레드 시작, 실행 중인 스레드는 간격/분산 정책 변경 시 재스케줄
+    for (int i = 0; i < REFRESHER_COUNT; i++) {
+        refresher_t *r = &refreshers[i];
+        if (!*r->enabled) {
+            refresher_stop(r);
+        } else if (!r->running) {
+            refresher_start(r);
+        } else if (changes & (CONFIG_CHANGED_INTERVAL | CONFIG_CHANGED_SCHEDULE)) {
+            __atomic_store_n(&r->reschedule, 1, __ATOMIC_RELEASE);
+            VAULT_LOG_INFO("%s refresh rescheduled (interval: %d seconds)", r->name, refresher_interval(r));
+        }
+    }
+    start_kv_events();
+    
+    // 새 prefetch 경로는 다음 갱신 주기를 기다리지 않고 바로 읽음
+    if (changes & CONFIG_CHANGED_KV_PREFETCH) {
+        prefetch_kv(&vault_client);
+    }
+}
+
+// 메인 루프 대기: 설정 파일이 바뀌거나 SIGHUP을 받으면 즉시 다시 읽어 반영
+static void wait_main_loop(int seconds) {
+    for (int i = 0; i < seconds && !should_exit; i++) {
+        int changed = config_watch_wait(&config_watch, 1000);
+        if (reload_requested) {
+            reload_requested = 0;
+            changed = 1;
+        }
+        if (changed && !should_exit) {
+            reload_config();
+        }
+    }
+}
+
 // 토큰 갱신 스레드 (안전한 갱신 로직)
+// 갱신/재로그인은 이 스레드에서만 수행되며, 새 토큰이 발행될 때까지
+// 다른 스레드의 시크릿 요청은 기존 토큰으로 계속 처리됩니다.
 void* token_renewal_thread(void* arg) {
     vault_client_t *client = (vault_client_t*)arg;
+    int ticks = 0;
+    time_t retry_at = 0;  // 갱신 실패 후 재시도 시각
     
     while (!should_exit) {
-        // 10초마다 토큰 상태 확인 (짧은 TTL에 대응)
-        for (int i = 0; i < 10 && !should_exit; i++) {
-            sleep(1);
-        }
-        
+        sleep(1);
         if (should_exit) break;
         
-        // 토큰 상태 출력
-        printf("\n=== Token Status Check ===\n");
-        vault_print_token_status(client);
+        dump_trace_if_requested();
+        
+        vault_token_t *token = vault_token_acquire(client);
+        if (!token) {
+            VAULT_LOG_ERROR("❌ No token available. Exiting...");
+            should_exit = 1;
+            break;
+        }
         
-        // 갱신 필요 여부 확인 (4/5 지점에서 갱신)
+        // 갱신 예정 시각 전에는 10초마다 상태만 확인 (짧은 TTL에 대응)
         time_t now = time(NULL);
-        time_t remaining = client->token_expiry - now;
-        time_t total_ttl = client->token_expiry - client->token_issued;
-        time_t elapsed = now - client->token_issued;
-        time_t renewal_point = total_ttl * 4 / 5;  // 4/5 지점
+        if (now < token->renewal_at || now < retry_at) {
+            time_t due = token->renewal_at > retry_at ? token->renewal_at : retry_at;
+            vault_token_release(token);
+            if (++ticks % 10 == 0) {
+                VAULT_LOG_INFO("=== Token Status Check ===");
+                vault_print_token_status(client);
+                VAULT_LOG_INFO("✅ Token is still healthy, renewal scheduled in %ld seconds", due - now);
+            }
+            continue;
+        }
+        ticks = 0;
         
-        printf("Token check: elapsed=%ld, total_ttl=%ld, remaining=%ld, renewal_point=%ld\n", 
-               elapsed, total_ttl, remaining, renewal_point);
+        // 갱신 구간(renew_window_min ~ max) 내 무작위 시점 도달
+        time_t expiry = token->expiry;
+        time_t remaining = token->expiry - now;
+        time_t total_ttl = token->expiry - token->issued;
+        time_t elapsed = now - token->issued;
+        time_t renewal_point = token->renewal_at - token->issued;
+        vault_token_release(token);
         
-        if (elapsed >= renewal_point) {  // 4/5 지점에서만 갱신
-            printf("🔄 Token renewal triggered (at %ld%% of TTL, %ld seconds remaining)\n", 
-                   (elapsed * 100) / total_ttl, remaining);
-            
-            if (vault_renew_token(client) != 0) {
-                printf("❌ Token renewal failed. Attempting re-login...\n");
-                if (vault_login(client, client->config->vault_role_id, client->config->vault_secret_id) != 0) {
-                    fprintf(stderr, "❌ Re-login failed. Exiting...\n");
-                    should_exit = 1;
-                    break;
-                } else {
-                    printf("✅ Re-login successful\n");
-                    vault_print_token_status(client);
-                }
-            } else {
-                printf("✅ Token renewed successfully\n");
-                vault_print_token_status(client);
+        VAULT_LOG_INFO("=== Token Status Check ===");
+        VAULT_LOG_INFO("Token check: elapsed=%ld, total_ttl=%ld, remaining=%ld, renewal_point=%ld", 
+                       elapsed, total_ttl, remaining, renewal_point);
+        VAULT_LOG_INFO("🔄 Token renewal triggered (at %ld%% of TTL, %ld seconds remaining)", 
+                       total_ttl > 0 ? (elapsed * 100) / total_ttl : 0, remaining);
+        
+        // 갱신 실패 시 재로그인 (백그라운드에서 새 토큰 발행)
+        if (vault_refresh_token(client) != 0) {
+            now = time(NULL);
+            if (now < expiry) {
+                // 기존 토큰이 아직 유효하므로 요청은 계속 처리됨 - 만료 전까지 재시도
+                int retry_delay = (expiry - now) > 10 ? 5 : 1;
+                retry_at = now + retry_delay;
+                VAULT_LOG_WARN("⚠️ Token refresh failed. Keeping current token (%ld seconds left), retrying in %d seconds",
+                               expiry - now, retry_delay);
+                continue;
             }
-        } else {
-            printf("✅ Token is still healthy, no renewal needed\n");
+            VAULT_LOG_ERROR("❌ Re-login failed and token has expired. Exiting...");
+            should_exit = 1;
+            break;
         }
+        
+        retry_at = 0;
+        VAULT_LOG_INFO("✅ Token refreshed successfully");
+        vault_print_token_status(client);
     }
     
     return NULL;
 }
 
+// 게이트웨이 모드: [tenant:<name>] 섹션마다 테넌트를 만들어 하나의 연결 풀과 스케줄러로 운영
+// 시크릿은 테넌트별 캐시에 유지되며, 이 프로세스는 상태만 주기적으로 출력합니다.
+static int run_tenants(app_config_t *tenant_configs, int count) {
+    vault_tenants_t pool;
+    if (vault_tenants_init(&pool, tenant_configs, (size_t)count, app_config.tenants.workers, 1) != 0) {
+        VAULT_LOG_ERROR("Failed to initialize tenant pool");
+        return 1;
+    }
+    if (vault_tenants_start(&pool) != 0) {
+        vault_tenants_destroy(&pool);
+        return 1;
+    }
+    VAULT_LOG_INFO("🏢 Serving %d tenants with %d workers over a shared connection pool",
+                   count, app_config.tenants.workers);
+
+    while (!should_exit) {
+        for (int i = 0; i < 10 && !should_exit; i++) {
+            sleep(1);
+            dump_trace_if_requested();
+        }
+        vault_tenants_stats_t stats;
+        vault_tenants_get_stats(&pool, &stats);
+        VAULT_LOG_INFO("🏢 Tenants: %zu/%zu ready, %llu tasks run, %llu logins (%llu failed), "
+                       "%llu refresh failures, %zu queued, max lag %lds",
+                       stats.ready, stats.tenants, (unsigned long long)stats.runs,
+                       (unsigned long long)stats.logins, (unsigned long long)stats.login_failures,
+                       (unsigned long long)stats.refresh_failures, stats.queued, stats.max_lag);
+    }
+
+    VAULT_LOG_INFO("Cleaning up...");
+    vault_tenants_destroy(&pool);
+    return 0;
+}
+
 int main(int argc, char *argv[]) {
     // 시그널 처리 설정
     signal(SIGINT, signal_handler);
     signal(SIGTERM, signal_handler);
+    signal(SIGUSR1, trace_signal_handler);
+    signal(SIGHUP, reload_signal_handler);
     
     printf("=== Vault C Client Application ===\n");
     
     // 설정 파일 경로 결정
-    const char *config_file = "config.ini";
     if (argc > 1) {
-        config_file = argv[1];
+        config_path = argv[1];
     }
     
     // 설정 파일 로드
-    printf("Loading configuration from: %s\n", config_file);
-    if (load_config(config_file, &app_config) != 0) {
+    printf("Loading configuration from: %s\n", config_path);
+    if (load_config(config_path, &app_config) != 0) {
         fprintf(stderr, "Failed to load configuration\n");
         return 1;
     }
@@ -170,67 +582,119 @@ int main(int argc, char *argv[]) {
     // 설정 출력
     print_config(&app_config);
     
-    // Vault 클라이언트 초기화
-    if (vault_client_init(&vault_client, &app_config) != 0) {
-        fprintf(stderr, "Failed to initialize Vault client\n");
+    // 비동기 로거 시작 (이후 런타임 출력은 모두 로거를 거침)
+    vault_log_level_t log_level = VAULT_LOG_INFO;
+    vault_log_parse_level(app_config.log.level, &log_level);
+    if (vault_log_start(log_level, app_config.log.output) != 0) {
+        fprintf(stderr, "Failed to start logger\n");
+        return 1;
+    }
+    
+    // 테넌트 섹션이 있으면 게이트웨이 모드로 실행 (설정 핫 리로드 미지원)
+    app_config_t *tenant_configs = NULL;
+    int tenant_count = load_tenant_configs(config_path, &app_config, &tenant_configs);
+    if (tenant_count < 0) {
+        VAULT_LOG_ERROR("Failed to load tenant configuration");
+        vault_log_stop();
+        return 1;
+    }
+    if (tenant_count > 0) {
+        if (app_config.metrics_port > 0 &&
+            vault_metrics_server_start(app_config.metrics_address, app_config.metrics_port) != 0) {
+            VAULT_LOG_ERROR("Failed to start metrics endpoint on %s:%d", app_config.metrics_address,
+                            app_config.metrics_port);
+        }
+        if (app_config.trace.record[0] && vault_record_open(app_config.trace.record) != 0) {
+            VAULT_LOG_ERROR("Failed to start traffic recording to %s", app_config.trace.record);
+        }
+        int rc = run_tenants(tenant_configs, tenant_count);
+        free(tenant_configs);
+        vault_metrics_server_stop();
+        vault_record_close();
+        vault_log_stop();
+        printf("Application terminated\n");
+        return rc;
+    }
+    
+    // Vault 클라이언트 초기화 (연결 풀을 함께 사용)
+    if (vault_transport_init(&vault_transport) != 0 ||
+        vault_client_init(&vault_client, &app_config) != 0) {
+        VAULT_LOG_ERROR("Failed to initialize Vault client");
+        vault_log_stop();
         return 1;
     }
     
+    vault_client_set_transport(&vault_client, &vault_transport);
+    vault_transport_configure(&vault_transport, &app_config);
+    vault_events_init(&kv_events);
+    
+    // 시크릿 변경 구독 (설정 리로드로 나중에 활성화될 수 있으므로 모두 구독)
+    for (int i = 0; i < REFRESHER_COUNT; i++) {
+        vault_subscribe(&vault_client, refreshers[i].task, on_secret_change, NULL);
+    }
+    
+    // Prometheus 메트릭 엔드포인트 (설정 시)
+    if (app_config.metrics_port > 0 &&
+        vault_metrics_server_start(app_config.metrics_address, app_config.metrics_port) != 0) {
+        VAULT_LOG_ERROR("Failed to start metrics endpoint on %s:%d", app_config.metrics_address,
+                        app_config.metrics_port);
+    }
+    
+    // 트래픽 기록 (설정 시, 로그인부터 기록)
+    if (app_config.trace.record[0] && vault_record_open(app_config.trace.record) != 0) {
+        VAULT_LOG_ERROR("Failed to start traffic recording to %s", app_config.trace.record);
+    }
+    
     // AppRole 로그인
-    printf("Logging in to Vault...\n");
+    VAULT_LOG_INFO("Logging in to Vault...");
     if (vault_login(&vault_client, app_config.vault_role_id, app_config.vault_secret_id) != 0) {
-        fprintf(stderr, "Login failed\n");
+        VAULT_LOG_ERROR("Login failed");
         vault_client_cleanup(&vault_client);
+        vault_log_stop();
         return 1;
     }
     
     // 토큰 상태 출력
     vault_print_token_status(&vault_client);
     
+    // KV 하위 경로 미리 읽기 (기동 시 한 번에)
+    prefetch_kv(&vault_client);
+    start_transit(&vault_client);
+    start_pki(&vault_client);
+    
     // 토큰 갱신 스레드 시작
     pthread_t renewal_thread;
     if (pthread_create(&renewal_thread, NULL, token_renewal_thread, &vault_client) != 0) {
-        fprintf(stderr, "Failed to create renewal thread\n");
+        VAULT_LOG_ERROR("Failed to create renewal thread");
         vault_client_cleanup(&vault_client);
+        vault_log_stop();
         return 1;
     }
     
-    // KV 갱신 스레드 시작 (KV 엔진이 활성화된 경우)
-    pthread_t kv_refresh_thread_handle = 0;
-    if (app_config.secret_kv.enabled) {
-        if (pthread_create(&kv_refresh_thread_handle, NULL, kv_refresh_thread, &vault_client) != 0) {
-            fprintf(stderr, "Failed to create KV refresh thread\n");
-            vault_client_cleanup(&vault_client);
-            return 1;
+    // 활성화된 시크릿 갱신 스레드 시작
+    for (int i = 0; i < REFRESHER_COUNT; i++) {
+        if (*refreshers[i].enabled && refresher_start(&refreshers[i]) != 0) {
+            should_exit = 1;
+            break;
         }
-        printf("✅ KV refresh thread started (interval: %d seconds)\n", app_config.secret_kv.refresh_interval);
     }
-    
-    // Database Dynamic 갱신 스레드 시작 (Database Dynamic 엔진이 활성화된 경우)
-    pthread_t db_dynamic_refresh_thread_handle = 0;
-    if (app_config.secret_database_dynamic.enabled) {
-        if (pthread_create(&db_dynamic_refresh_thread_handle, NULL, db_dynamic_refresh_thread, &vault_client) != 0) {
-            fprintf(stderr, "Failed to create Database Dynamic refresh thread\n");
-            vault_client_cleanup(&vault_client);
-            return 1;
+    if (should_exit) {
+        pthread_join(renewal_thread, NULL);
+        for (int i = 0; i < REFRESHER_COUNT; i++) {
+            refresher_stop(&refreshers[i]);
         }
-        printf("✅ Database Dynamic refresh thread started (interval: %d seconds)\n", app_config.secret_kv.refresh_interval);
+        vault_client_cleanup(&vault_client);
+        vault_log_stop();
+        return 1;
     }
+    start_kv_events();
     
-    // Database Static 갱신 스레드 시작 (Database Static 엔진이 활성화된 경우)
-    pthread_t db_static_refresh_thread_handle = 0;
-    if (app_config.secret_database_static.enabled) {
-        if (pthread_create(&db_static_refresh_thread_handle, NULL, db_static_refresh_thread, &vault_client) != 0) {
-            fprintf(stderr, "Failed to create Database Static refresh thread\n");
-            vault_client_cleanup(&vault_client);
-            return 1;
-        }
-        printf("✅ Database Static refresh thread started (interval: %d seconds)\n", app_config.secret_kv.refresh_interval * 2);
-    }
+    // 설정 파일 변경 감시 (변경 시 영향받는 갱신 스레드만 재구성)
+    config_watch_open(&config_watch, config_path);
     
     // 메인 루프
     while (!should_exit) {
-        printf("\n=== Fetching Secret ===\n");
+        VAULT_LOG_INFO("=== Fetching Secret ===");
         
         // KV 시크릿 가져오기 (캐시 확인)
         if (app_config.secret_kv.enabled) {
@@ -240,11 +704,24 @@ int main(int argc, char *argv[]) {
                 json_object *data_obj, *data_data;
                 if (json_object_object_get_ex(kv_secret, "data", &data_obj) &&
                     json_object_object_get_ex(data_obj, "data", &data_data)) {
-                    printf("📦 KV Secret Data (version: %d):\n%s\n", vault_client.kv_version, json_object_to_json_string(data_data));
+                    // 값은 출력하지 않고 키 이름만 출력
+                    char keys[256] = "";
+                    size_t keys_len = 0;
+                    struct json_object_iterator it = json_object_iter_begin(data_data);
+                    struct json_object_iterator end = json_object_iter_end(data_data);
+                    for (; !json_object_iter_equal(&it, &end); json_object_iter_next(&it)) {
+                        int written = snprintf(keys + keys_len, sizeof(keys) - keys_len, "%s%s",
+                                               keys_len ? ", " : "", json_object_iter_peek_name(&it));
+                        if (written < 0 || (size_t)written >= sizeof(keys) - keys_len) break;
+                        keys_len += (size_t)written;
+                    }
+                    vault_client_stats_t stats;
+                    vault_client_get_stats(&vault_client, &stats);
+                    VAULT_LOG_INFO("📦 KV Secret Data (version: %d): keys=[%s]", stats.kv_version, keys);
                 }
                 vault_cleanup_secret(kv_secret);
             } else {
-                fprintf(stderr, "Failed to retrieve KV secret\n");
+                VAULT_LOG_ERROR("Failed to retrieve KV secret");
             }
         }
         
@@ -252,13 +729,17 @@ int main(int argc, char *argv[]) {
         if (app_config.secret_database_dynamic.enabled) {
             json_object *db_dynamic_secret = NULL;
             if (vault_get_db_dynamic_secret(&vault_client, &db_dynamic_secret) == 0) {
-                // TTL 정보 가져오기
-                time_t expire_time;
-                int ttl = 0;
-                if (vault_check_lease_status(&vault_client, vault_client.lease_id, &expire_time, &ttl) == 0) {
-                    printf("🗄️ Database Dynamic Secret (TTL: %d seconds):\n", ttl);
+                // TTL 정보 (캐시된 lease 만료 시각 기준, 캐시는 갱신 스레드가 교체하므로 스냅샷으로 읽음)
+                vault_client_stats_t stats;
+                vault_client_get_stats(&vault_client, &stats);
+                if (app_config.secret_database_dynamic.pool_size > 0) {
+                    VAULT_LOG_INFO("🗄️ Database Dynamic Secret (pool: %zu active, %zu draining, next rotation in %ld seconds):",
+                                   stats.db_pool.active, stats.db_pool.draining,
+                                   stats.db_pool.next_rotation ? (long)(stats.db_pool.next_rotation - time(NULL)) : 0L);
+                } else if (stats.lease_expiry > 0) {
+                    VAULT_LOG_INFO("🗄️ Database Dynamic Secret (TTL: %ld seconds):", (long)(stats.lease_expiry - time(NULL)));
                 } else {
-                    printf("🗄️ Database Dynamic Secret:\n");
+                    VAULT_LOG_INFO("🗄️ Database Dynamic Secret:");
                 }
                 
                 // data 섹션에서 username과 password만 추출
@@ -267,14 +748,14 @@ int main(int argc, char *argv[]) {
                     json_object *username_obj, *password_obj;
                     if (json_object_object_get_ex(data_obj, "username", &username_obj) &&
                         json_object_object_get_ex(data_obj, "password", &password_obj)) {
-                        printf("  username: %s\n", json_object_get_string(username_obj));
-                        printf("  password: %s\n", json_object_get_string(password_obj));
+                        VAULT_LOG_INFO("  username: %s", json_object_get_string(username_obj));
+                        VAULT_LOG_INFO("  password: %s", json_object_get_string(password_obj));
                     }
                 }
                 
                 vault_cleanup_secret(db_dynamic_secret);
             } else {
-                fprintf(stderr, "Failed to retrieve Database Dynamic secret\n");
+                VAULT_LOG_ERROR("Failed to retrieve Database Dynamic secret");
             }
         }
         
@@ -289,56 +770,70 @@ int main(int argc, char *argv[]) {
                     ttl = json_object_get_int(ttl_obj);
                 }
                 
-                if (ttl > 0) {
-                    printf("🔒 Database Static Secret (TTL: %d seconds):\n", ttl);
+                time_t next_refresh = vault_db_static_next_refresh(&vault_client);
+                if (ttl > 0 && next_refresh > 0) {
+                    VAULT_LOG_INFO("🔒 Database Static Secret (TTL: %d seconds, next fetch in %ld seconds):", ttl,
+                                   (long)(next_refresh - time(NULL)));
+                } else if (ttl > 0) {
+                    VAULT_LOG_INFO("🔒 Database Static Secret (TTL: %d seconds):", ttl);
                 } else {
-                    printf("🔒 Database Static Secret:\n");
+                    VAULT_LOG_INFO("🔒 Database Static Secret:");
                 }
                 
                 // data 섹션에서 username과 password만 추출
                 json_object *username_obj, *password_obj;
                 if (json_object_object_get_ex(db_static_secret, "username", &username_obj) &&
                     json_object_object_get_ex(db_static_secret, "password", &password_obj)) {
-                    printf("  username: %s\n", json_object_get_string(username_obj));
-                    printf("  password: %s\n", json_object_get_string(password_obj));
+                    VAULT_LOG_INFO("  username: %s", json_object_get_string(username_obj));
+                    VAULT_LOG_INFO("  password: %s", json_object_get_string(password_obj));
                 }
                 
                 vault_cleanup_secret(db_static_secret);
             } else {
-                fprintf(stderr, "Failed to retrieve Database Static secret\n");
+                VAULT_LOG_ERROR("Failed to retrieve Database Static secret");
             }
         }
         
         // 토큰 상태 간단 출력
-        printf("\n--- Token Status ---\n");
+        VAULT_LOG_INFO("--- Token Status ---");
         vault_print_token_status(&vault_client);
         
-        // 10초 대기
-        for (int i = 0; i < 10 && !should_exit; i++) {
-            sleep(1);
-        }
+        // 10초 대기 (± jitter, 대기 중 설정 변경 반영)
+        wait_main_loop(vault_schedule_next_interval(&vault_client.schedule, 10));
     }
     
     // 정리
-    printf("Cleaning up...\n");
+    VAULT_LOG_INFO("Cleaning up...");
     pthread_join(renewal_thread, NULL);
     
-    // KV 갱신 스레드 정리
-    if (kv_refresh_thread_handle != 0) {
-        pthread_join(kv_refresh_thread_handle, NULL);
+    // 시크릿 갱신 스레드 정리
+    for (int i = 0; i < REFRESHER_COUNT; i++) {
+        refresher_stop(&refreshers[i]);
     }
+    vault_events_destroy(&kv_events);
+    config_watch_close(&config_watch);
     
-    // Database Dynamic 갱신 스레드 정리
-    if (db_dynamic_refresh_thread_handle != 0) {
-        pthread_join(db_dynamic_refresh_thread_handle, NULL);
-    }
+    if (pki_started) vault_pki_destroy(&pki);
+    if (envelope_started) vault_envelope_destroy(&envelope);
+    if (transit_started) vault_transit_destroy(&transit);
     
-    // Database Static 갱신 스레드 정리
-    if (db_static_refresh_thread_handle != 0) {
-        pthread_join(db_static_refresh_thread_handle, NULL);
+    if (app_config.adaptive_limit) {
+        vault_limiter_stats_t limit;
+        vault_limiter_get_stats(&vault_transport.limiter, &limit);
+        VAULT_LOG_INFO("🚦 Concurrency limit %.1f (peak %d in flight, min RTT %.1f ms), %llu delayed, %llu shed, "
+                       "%llu overloads",
+                       limit.limit, limit.peak_in_flight, limit.min_rtt_ms,
+                       (unsigned long long)(limit.delayed[0] + limit.delayed[1] + limit.delayed[2]),
+                       (unsigned long long)(limit.shed[0] + limit.shed[1] + limit.shed[2]),
+                       (unsigned long long)limit.overloads);
     }
     
+    vault_metrics_server_stop();
+    vault_record_close();
     vault_client_cleanup(&vault_client);
+    vault_client_thread_cleanup();
+    vault_transport_destroy(&vault_transport);
+    vault_log_stop();
     
     printf("Application terminated\n");
     return 0;
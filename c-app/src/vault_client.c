@@ -1,3 +1,4 @@
+#define _POSIX_C_SOURCE 200809L
 #include "vault_client.h"
 #include "config.h"
 #include <stdio.h>
@@ -5,26 +6,604 @@
 #include <string.h>
 #include <unistd.h>
 
-// HTTP 응답을 저장할 구조체
+// HTTP 응답을 저장할 구조체 (스레드별 요청 컨텍스트에서 재사용)
+// 스트리밍 모드(KV 조회)에서는 본문을 모으지 않고 받는(압축을 푼) 조각을 바로 JSON 파서에 넣으므로
+// 압축된 응답이어도 본문 전체 크기의 버퍼가 생기지 않습니다. 트래픽 기록 중에는 본문도 함께 모읍니다.
 struct http_response {
     char *data;
     size_t size;
+    size_t capacity;
+    json_tokener *tokener;  // 스트리밍 파서 (요청 간 재사용)
+    json_object *json;      // 스트리밍 파싱 결과 (vault_response_json으로 넘겨받음)
+    size_t decoded;         // 받은 본문 바이트 (압축을 푼 크기)
+    size_t limit;           // 본문 최대 크기 (max_response_size, 0이면 제한 없음)
+    int streaming;
+    int keep_body;          // 스트리밍 중에도 본문을 모음 (트래픽 기록)
+    int parse_failed;       // 스트리밍 파싱 오류 (나머지 조각은 버림)
+    int sensitive;          // 평문 키가 담긴 응답 (버퍼를 늘릴 때 이전 버퍼를 지우고, 파싱 후 본문을 지움)
 };
 
-// libcurl 콜백 함수
+static void secure_zero(void *ptr, size_t len);
+
+// libcurl 콜백 함수 (버퍼는 요청 간에 재사용되므로 부족할 때만 2배로 늘림)
 static size_t write_callback(void *contents, size_t size, size_t nmemb, struct http_response *response) {
     size_t total_size = size * nmemb;
-    response->data = realloc(response->data, response->size + total_size + 1);
+    response->decoded += total_size;
+    // 압축을 푼 크기 기준 (작은 압축 응답이 큰 본문으로 풀리는 경우도 막음)
+    if (response->limit && response->decoded > response->limit) {
+        VAULT_LOG_ERROR("Response exceeds max_response_size (%zu bytes), aborting transfer", response->limit);
+        return 0;
+    }
     
-    if (response->data) {
-        memcpy(&(response->data[response->size]), contents, total_size);
-        response->size += total_size;
-        response->data[response->size] = 0;
+    if (response->streaming) {
+        if (!response->json && !response->parse_failed) {
+            response->json = json_tokener_parse_ex(response->tokener, contents, (int)total_size);
+            if (!response->json && json_tokener_get_error(response->tokener) != json_tokener_continue) {
+                response->parse_failed = 1;
+            }
+        }
+        if (!response->keep_body) return total_size;
+    }
+    
+    size_t needed = response->size + total_size + 1;
+    if (needed > response->capacity) {
+        size_t capacity = response->capacity ? response->capacity * 2 : 4096;
+        while (capacity < needed) capacity *= 2;
+        char *grown;
+        if (response->sensitive) {
+            // realloc은 이전 버퍼를 지우지 않고 반납하므로 직접 옮긴 뒤 지움
+            grown = malloc(capacity);
+            if (!grown) return 0;
+            if (response->data) {
+                memcpy(grown, response->data, response->size);
+                secure_zero(response->data, response->capacity);
+                free(response->data);
+            }
+        } else {
+            grown = realloc(response->data, capacity);
+            if (!grown) return 0;  // 전송 중단 (기존 버퍼는 유지)
+        }
+        response->data = grown;
+        response->capacity = capacity;
     }
+    memcpy(&(response->data[response->size]), contents, total_size);
+    response->size += total_size;
+    response->data[response->size] = 0;
     
     return total_size;
 }
 
+// 응답 JSON (스트리밍 파싱 결과를 넘겨받거나 모은 본문을 파싱, 호출자가 put)
+// 빈 응답(연결 끊김 등)이나 잘린 본문은 NULL
+static json_object *vault_response_json(struct http_response *response) {
+    if (response->streaming) {
+        json_object *json = response->json;
+        response->json = NULL;
+        return json;
+    }
+    return response->data && response->size ? json_tokener_parse(response->data) : NULL;
+}
+
+// 로그용 응답 본문 (스트리밍 모드에서는 모으지 않았을 수 있음)
+static const char *vault_response_text(const struct http_response *response) {
+    return response->data && response->size ? response->data : "(not buffered)";
+}
+
+static void vault_response_free(struct http_response *response) {
+    free(response->data);
+    if (response->tokener) json_tokener_free(response->tokener);
+    json_object_put(response->json);
+    memset(response, 0, sizeof(*response));
+}
+
+// 받은 본문 지우기 (평문 키 응답을 파싱한 뒤, 재사용 버퍼에 사본이 남지 않도록)
+static void vault_response_wipe(struct http_response *response) {
+    if (response->data) secure_zero(response->data, response->size);
+    response->size = 0;
+}
+
+// 요청 경로만 추출 (호스트, 쿼리 제외, 길면 잘림)
+static void vault_effective_path(CURL *curl, char *path, size_t path_size) {
+    char *url = NULL;
+    curl_easy_getinfo(curl, CURLINFO_EFFECTIVE_URL, &url);
+    
+    path[0] = '\0';
+    const char *start = url ? strstr(url, "://") : NULL;
+    start = start ? strchr(start + 3, '/') : NULL;
+    if (start) {
+        size_t len = strcspn(start, "?");
+        if (len >= path_size) len = path_size - 1;
+        memcpy(path, start, len);
+        path[len] = '\0';
+    }
+}
+
+// 단계별 소요 시간을 추적 링 버퍼에 기록 (스택 레코드만 사용, 할당 없음)
+static void vault_trace_perform(CURL *curl, vault_endpoint_t endpoint, CURLcode res, long http_code, curl_off_t bytes) {
+    vault_trace_record_t record;
+    curl_off_t namelookup = 0, connect = 0, appconnect = 0, starttransfer = 0, total = 0;
+    
+    curl_easy_getinfo(curl, CURLINFO_NAMELOOKUP_TIME_T, &namelookup);
+    curl_easy_getinfo(curl, CURLINFO_CONNECT_TIME_T, &connect);
+    curl_easy_getinfo(curl, CURLINFO_APPCONNECT_TIME_T, &appconnect);
+    curl_easy_getinfo(curl, CURLINFO_STARTTRANSFER_TIME_T, &starttransfer);
+    curl_easy_getinfo(curl, CURLINFO_TOTAL_TIME_T, &total);
+    
+    memset(&record, 0, sizeof(record));
+    record.namelookup_us = namelookup;
+    record.connect_us = connect;
+    record.appconnect_us = appconnect;
+    record.starttransfer_us = starttransfer;
+    record.total_us = total;
+    record.bytes = (uint64_t)bytes;
+    record.http_code = (int32_t)http_code;
+    record.curl_code = (int32_t)res;
+    record.endpoint = (int32_t)endpoint;
+    vault_effective_path(curl, record.path, sizeof(record.path));
+    
+    vault_trace_record(&record);
+}
+
+// 요청 실행 및 기록 (엔드포인트별 메트릭 + 요청 추적 링 버퍼 + 기록 모드 시 트래픽 기록)
+static void vault_perform_done(CURL *curl, vault_endpoint_t endpoint, CURLcode res, uint64_t elapsed,
+                               const struct http_response *response) {
+    long http_code = 0;
+    curl_off_t bytes = 0;
+    if (res == CURLE_OK) {
+        curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &http_code);
+        curl_easy_getinfo(curl, CURLINFO_SIZE_DOWNLOAD_T, &bytes);
+    }
+    vault_metrics_record_request(endpoint, elapsed, (uint64_t)bytes, res != CURLE_OK || http_code >= 400);
+    vault_trace_perform(curl, endpoint, res, http_code, bytes);
+    
+    if (vault_record_enabled()) {
+        char path[VAULT_RECORD_PATH_MAX];
+        vault_effective_path(curl, path, sizeof(path));
+        vault_record_request(endpoint, path, res == CURLE_OK ? (int)http_code : -(int)res, elapsed,
+                             response->data, response->size);
+    }
+}
+
+// 동시 요청 제한 우선순위 (토큰/lease 유지가 막히면 모든 요청이 실패하므로 가장 먼저)
+static vault_priority_t vault_endpoint_priority(vault_endpoint_t endpoint) {
+    switch (endpoint) {
+        case VAULT_ENDPOINT_LOGIN:
+        case VAULT_ENDPOINT_RENEW_SELF:
+        case VAULT_ENDPOINT_LEASE_LOOKUP:
+            return VAULT_PRIORITY_CRITICAL;
+        default:
+            return VAULT_PRIORITY_NORMAL;
+    }
+}
+
+// 요청 결과를 한도 조정 입력으로 분류 (429/503/타임아웃은 과부하, 연결 실패는 지연 시간 표본에서 제외)
+static vault_limit_outcome_t vault_limit_outcome(CURL *curl, CURLcode res) {
+    if (res == CURLE_OPERATION_TIMEDOUT) return VAULT_LIMIT_OVERLOAD;
+    if (res != CURLE_OK) return VAULT_LIMIT_IGNORE;
+    long http_code = 0;
+    curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &http_code);
+    return http_code == 429 || http_code == 503 ? VAULT_LIMIT_OVERLOAD : VAULT_LIMIT_OK;
+}
+
+static vault_limiter_t *vault_client_limiter(vault_client_t *client) {
+    return client->transport ? &client->transport->limiter : NULL;
+}
+
+// 요청 실행 (적응형 한도 안에서, HTTP 타임아웃 동안 자리가 나지 않으면 보내지 않고 타임아웃으로 실패)
+static CURLcode vault_perform(vault_client_t *client, CURL *curl, vault_endpoint_t endpoint,
+                              const struct http_response *response) {
+    vault_limiter_t *limiter = vault_client_limiter(client);
+    if (vault_limiter_acquire(limiter, vault_endpoint_priority(endpoint), client->config->http_timeout * 1000) != 0) {
+        VAULT_LOG_WARN("Vault concurrency limit reached, request not sent");
+        return CURLE_OPERATION_TIMEDOUT;
+    }
+    uint64_t start = vault_metrics_now_ns();
+    CURLcode res = curl_easy_perform(curl);
+    uint64_t elapsed = vault_metrics_now_ns() - start;
+    vault_limiter_release(limiter, elapsed, vault_limit_outcome(curl, res));
+    vault_perform_done(curl, endpoint, res, elapsed, response);
+    return res;
+}
+
+// 컴파일러 최적화로 제거되지 않는 메모리 정리
+static void secure_zero(void *ptr, size_t len) {
+    volatile unsigned char *p = (volatile unsigned char *)ptr;
+    while (len--) {
+        *p++ = 0;
+    }
+}
+
+// 스레드별 요청 컨텍스트
+// CURL easy 핸들은 동시에 두 스레드에서 사용할 수 없으므로 스레드마다 핸들과 응답 버퍼를 하나씩 두고
+// 요청마다 옵션만 초기화하여 재사용합니다. 클라이언트(vault_client_t)는 요청 중 변경되지 않는 공유 코어로,
+// 가변 상태는 토큰 레코드(token_lock)와 시크릿 캐시(cache_lock)뿐입니다.
+typedef struct {
+    CURL *curl;
+    struct http_response response;
+    unsigned long template_id;  // 핸들에 옵션이 적용된 요청 템플릿 (0이면 일반 요청)
+} vault_request_ctx_t;
+
+#define VAULT_REQUEST_BUFFER_KEEP (256 * 1024)  // 이보다 큰 응답 버퍼는 다음 요청 전에 반환
+#define VAULT_TRANSPORT_MAX_IDLE 128            // 연결 풀에 남겨 둘 유휴 연결 수 (기본 4개면 동시 요청이 많을 때 매번 재연결)
+
+static pthread_key_t request_ctx_key;
+static pthread_once_t request_ctx_once = PTHREAD_ONCE_INIT;
+
+static void vault_request_ctx_free(void *ptr) {
+    vault_request_ctx_t *ctx = (vault_request_ctx_t *)ptr;
+    if (!ctx) return;
+    curl_easy_cleanup(ctx->curl);
+    vault_response_free(&ctx->response);
+    free(ctx);
+}
+
+static void vault_request_ctx_key_init(void) {
+    pthread_key_create(&request_ctx_key, vault_request_ctx_free);
+}
+
+// 응답 버퍼를 비우고 버퍼 모드로 되돌림
+static void vault_response_reset(struct http_response *response) {
+    response->size = 0;
+    if (response->data) response->data[0] = '\0';
+    json_object_put(response->json);
+    response->json = NULL;
+    response->decoded = 0;
+    response->streaming = 0;
+    response->keep_body = 0;
+    response->parse_failed = 0;
+    response->sensitive = 0;
+}
+
+// 스트리밍 파싱 시작 (파서를 만들 수 없으면 버퍼 모드로 남음)
+static void vault_response_stream(struct http_response *response) {
+    if (!response->tokener) response->tokener = json_tokener_new();
+    if (!response->tokener) return;
+    json_tokener_reset(response->tokener);
+    response->streaming = 1;
+    response->keep_body = vault_record_enabled();
+}
+
+// 요청 공통 옵션 (응답 버퍼는 비움)
+static void vault_request_setup(vault_client_t *client, CURL *curl, struct http_response *response) {
+    vault_response_reset(response);
+    response->limit = client->config->max_response_size > 0 ? (size_t)client->config->max_response_size : 0;
+    
+    curl_easy_setopt(curl, CURLOPT_TIMEOUT, client->config->http_timeout);
+    curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
+    curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 0L);
+    curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, 0L);
+    curl_easy_setopt(curl, CURLOPT_SHARE, client->transport ? client->transport->share : NULL);
+    curl_easy_setopt(curl, CURLOPT_MAXCONNECTS, (long)VAULT_TRANSPORT_MAX_IDLE);
+    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, write_callback);
+    curl_easy_setopt(curl, CURLOPT_WRITEDATA, response);
+}
+
+// KV 조회 요청: 압축 응답 허용 + 스트리밍 파싱 (vault_request_setup 이후 호출)
+// 파서를 만들 수 없으면 버퍼 모드로 남으며, vault_response_json은 어느 모드든 같은 결과를 돌려줍니다.
+static void vault_request_stream(vault_client_t *client, CURL *curl, struct http_response *response) {
+    if (client->transport && client->transport->accept_encoding[0]) {
+        curl_easy_setopt(curl, CURLOPT_ACCEPT_ENCODING, client->transport->accept_encoding);
+    }
+    vault_response_stream(response);
+}
+
+// 현재 스레드의 요청 컨텍스트 (처음이면 핸들을 만듦)
+static vault_request_ctx_t *vault_request_ctx(void) {
+    pthread_once(&request_ctx_once, vault_request_ctx_key_init);
+    
+    vault_request_ctx_t *ctx = pthread_getspecific(request_ctx_key);
+    if (!ctx) {
+        ctx = calloc(1, sizeof(vault_request_ctx_t));
+        if (!ctx) return NULL;
+        ctx->curl = curl_easy_init();
+        if (!ctx->curl || pthread_setspecific(request_ctx_key, ctx) != 0) {
+            vault_request_ctx_free(ctx);
+            return NULL;
+        }
+    }
+    if (ctx->response.capacity > VAULT_REQUEST_BUFFER_KEEP) {
+        free(ctx->response.data);
+        ctx->response.data = NULL;
+        ctx->response.capacity = 0;
+    }
+    return ctx;
+}
+
+// 현재 스레드의 요청 핸들 준비 (공통 옵션 적용, 공유 전송 계층이 있으면 연결 풀/DNS/TLS 세션 공유)
+// 반환된 핸들과 *response는 같은 스레드의 다음 요청 전까지만 유효합니다.
+static CURL *vault_request_begin(vault_client_t *client, struct http_response **response) {
+    vault_request_ctx_t *ctx = vault_request_ctx();
+    if (!ctx) return NULL;
+    
+    // 옵션만 초기화 (연결, DNS/TLS 세션 캐시는 유지)
+    curl_easy_reset(ctx->curl);
+    ctx->template_id = 0;
+    vault_request_setup(client, ctx->curl, &ctx->response);
+    *response = &ctx->response;
+    return ctx->curl;
+}
+
+// 템플릿 요청 핸들 준비 (token은 요청이 끝날 때까지 보유)
+// 이 스레드의 직전 요청이 같은 템플릿이면 옵션이 그대로 남아 있으므로 헤더 목록만 바꿔 지정합니다.
+static CURL *vault_request_begin_template(vault_client_t *client, const vault_request_template_t *request,
+                                          const vault_token_t *token, struct http_response **response) {
+    vault_request_ctx_t *ctx = vault_request_ctx();
+    if (!ctx) return NULL;
+    
+    if (ctx->template_id == request->id) {
+        vault_response_reset(&ctx->response);
+        if (request->stream) vault_response_stream(&ctx->response);
+    } else {
+        curl_easy_reset(ctx->curl);
+        vault_request_setup(client, ctx->curl, &ctx->response);
+        curl_easy_setopt(ctx->curl, CURLOPT_HTTPGET, 1L);
+        curl_easy_setopt(ctx->curl, CURLOPT_URL, request->url);
+        if (request->stream) vault_request_stream(client, ctx->curl, &ctx->response);
+        ctx->template_id = request->id;
+    }
+    curl_easy_setopt(ctx->curl, CURLOPT_HTTPHEADER, token->headers);
+    *response = &ctx->response;
+    return ctx->curl;
+}
+
+// 현재 스레드의 요청 컨텍스트 해제
+// 작업 스레드는 종료 시 자동으로 해제되며, 메인 스레드는 공유 전송 계층을 정리하기 전에 호출합니다.
+void vault_client_thread_cleanup(void) {
+    pthread_once(&request_ctx_once, vault_request_ctx_key_init);
+    vault_request_ctx_t *ctx = pthread_getspecific(request_ctx_key);
+    if (ctx) {
+        pthread_setspecific(request_ctx_key, NULL);
+        vault_request_ctx_free(ctx);
+    }
+}
+
+// 공통 요청 헤더 (X-Vault-Token, 네임스페이스가 설정된 경우 X-Vault-Namespace)
+// 같은 연결로 여러 테넌트의 요청이 오가므로 네임스페이스는 모든 요청에 명시합니다.
+static struct curl_slist *vault_request_headers(vault_client_t *client, const char *token) {
+    struct curl_slist *headers = NULL;
+    char header[1024];
+    
+    if (token) {
+        snprintf(header, sizeof(header), "X-Vault-Token: %s", token);
+        headers = curl_slist_append(headers, header);
+    }
+    if (client->config->vault_namespace[0]) {
+        snprintf(header, sizeof(header), "X-Vault-Namespace: %s", client->config->vault_namespace);
+        headers = curl_slist_append(headers, header);
+    }
+    return headers;
+}
+
+// 토큰 레코드 생성 (발행 전이므로 자유롭게 초기화 가능)
+static vault_token_t *vault_token_new(vault_client_t *client, const char *token, time_t issued, int ttl_seconds, int renewable) {
+    vault_token_t *record = calloc(1, sizeof(vault_token_t));
+    if (!record) return NULL;
+    
+    strncpy(record->token, token, sizeof(record->token) - 1);
+    record->token[sizeof(record->token) - 1] = '\0';
+    record->issued = issued;
+    record->expiry = issued + ttl_seconds;
+    
+    // 갱신 시점 결정 (갱신 구간 내 무작위)
+    record->renewal_at = issued + vault_schedule_renewal_offset(&client->schedule, ttl_seconds);
+    record->renewable = renewable;
+    
+    // 갱신 불가 토큰(batch)은 연장이 불가능하므로 만료 전에 재로그인이 끝나야 함
+    // 재로그인 요청이 타임아웃까지 걸려도 만료되지 않도록 HTTP 타임아웃만큼 여유를 둠
+    if (!renewable) {
+        time_t latest = record->expiry - client->config->http_timeout;
+        if (latest < issued + ttl_seconds / 2) {
+            latest = issued + ttl_seconds / 2;
+        }
+        if (record->renewal_at > latest) {
+            record->renewal_at = latest;
+        }
+    }
+    
+    // 요청마다 헤더를 만들지 않도록 이 토큰으로 보낼 헤더 목록을 미리 구성 (발행 후에는 읽기 전용)
+    record->headers = vault_request_headers(client, record->token);
+    record->json_headers = vault_request_headers(client, record->token);
+    if (record->json_headers) {
+        record->json_headers = curl_slist_append(record->json_headers, "Content-Type: application/json");
+    }
+    record->refs = 1;  // 클라이언트(token_state)가 보유하는 참조
+    if (!record->headers || !record->json_headers) {
+        vault_token_release(record);
+        return NULL;
+    }
+    return record;
+}
+
+// 새 토큰 레코드 발행
+// 포인터만 교체하고, 이전 레코드는 진행 중인 요청이 모두 참조를 반환한 뒤 해제됩니다.
+static void vault_token_publish(vault_client_t *client, vault_token_t *record) {
+    pthread_mutex_lock(&client->token_lock);
+    vault_token_t *old = client->token_state;
+    if (record) {
+        record->generation = ++client->token_generation;
+    }
+    client->token_state = record;
+    pthread_mutex_unlock(&client->token_lock);
+    
+    vault_token_release(old);
+}
+
+// 현재 토큰 레코드 획득 (참조 카운트 증가, 사용 후 vault_token_release 필요)
+vault_token_t *vault_token_acquire(vault_client_t *client) {
+    if (!client) return NULL;
+    
+    pthread_mutex_lock(&client->token_lock);
+    vault_token_t *record = client->token_state;
+    if (record) {
+        __atomic_add_fetch(&record->refs, 1, __ATOMIC_RELAXED);
+    }
+    pthread_mutex_unlock(&client->token_lock);
+    return record;
+}
+
+// 토큰이 담긴 헤더 목록을 지우고 해제
+static void vault_headers_free(struct curl_slist *headers) {
+    for (struct curl_slist *item = headers; item; item = item->next) {
+        secure_zero(item->data, strlen(item->data));
+    }
+    curl_slist_free_all(headers);
+}
+
+// 토큰 레코드 참조 반환 (마지막 참조면 토큰 문자열과 헤더 목록을 지우고 해제)
+void vault_token_release(vault_token_t *token) {
+    if (token && __atomic_sub_fetch(&token->refs, 1, __ATOMIC_ACQ_REL) == 0) {
+        vault_headers_free(token->headers);
+        vault_headers_free(token->json_headers);
+        secure_zero(token->token, sizeof(token->token));
+        free(token);
+    }
+}
+
+static void vault_transport_lock(CURL *handle, curl_lock_data data, curl_lock_access access, void *userptr) {
+    (void)handle;
+    (void)access;
+    vault_transport_t *transport = (vault_transport_t *)userptr;
+    pthread_mutex_lock(&transport->locks[data]);
+}
+
+static void vault_transport_unlock(CURL *handle, curl_lock_data data, void *userptr) {
+    (void)handle;
+    vault_transport_t *transport = (vault_transport_t *)userptr;
+    pthread_mutex_unlock(&transport->locks[data]);
+}
+
+// 공유 전송 계층 초기화 (연결 풀, DNS 캐시, TLS 세션 공유)
+int vault_transport_init(vault_transport_t *transport) {
+    if (!transport) return -1;
+    
+    transport->share = curl_share_init();
+    if (!transport->share) {
+        VAULT_LOG_ERROR("Failed to initialize CURL share");
+        return -1;
+    }
+    for (int i = 0; i < CURL_LOCK_DATA_LAST; i++) {
+        pthread_mutex_init(&transport->locks[i], NULL);
+    }
+    vault_limiter_init(&transport->limiter);
+    transport->accept_encoding[0] = '\0';
+    curl_share_setopt(transport->share, CURLSHOPT_LOCKFUNC, vault_transport_lock);
+    curl_share_setopt(transport->share, CURLSHOPT_UNLOCKFUNC, vault_transport_unlock);
+    curl_share_setopt(transport->share, CURLSHOPT_USERDATA, transport);
+    curl_share_setopt(transport->share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+    curl_share_setopt(transport->share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+    if (curl_share_setopt(transport->share, CURLSHOPT_SHARE, CURL_LOCK_DATA_CONNECT) != CURLSHE_OK) {
+        VAULT_LOG_WARN("⚠️ libcurl cannot share connections, only DNS/TLS sessions are shared");
+    }
+    return 0;
+}
+
+// 공유 전송 계층 정리 (이를 사용하는 모든 클라이언트를 정리한 후 호출)
+void vault_transport_destroy(vault_transport_t *transport) {
+    if (!transport || !transport->share) return;
+    
+    curl_share_cleanup(transport->share);
+    transport->share = NULL;
+    for (int i = 0; i < CURL_LOCK_DATA_LAST; i++) {
+        pthread_mutex_destroy(&transport->locks[i]);
+    }
+    vault_limiter_destroy(&transport->limiter);
+}
+
+// 응답 압축 방식을 libcurl이 풀 수 있는 것만 남김 (빌드에 따라 zlib/zstd/brotli 지원이 다름)
+static void vault_transport_encodings(vault_transport_t *transport, const char *list) {
+    const curl_version_info_data *info = curl_version_info(CURLVERSION_NOW);
+    char buffer[sizeof(transport->accept_encoding)];
+    size_t len = 0;
+    
+    snprintf(buffer, sizeof(buffer), "%s", list);
+    transport->accept_encoding[0] = '\0';
+    for (char *saveptr = NULL, *name = strtok_r(buffer, ", ", &saveptr); name; name = strtok_r(NULL, ", ", &saveptr)) {
+        int supported = 0;
+        if (strcmp(name, "gzip") == 0 || strcmp(name, "deflate") == 0) {
+            supported = (info->features & CURL_VERSION_LIBZ) != 0;
+#ifdef CURL_VERSION_ZSTD
+        } else if (strcmp(name, "zstd") == 0) {
+            supported = (info->features & CURL_VERSION_ZSTD) != 0;
+#endif
+        } else if (strcmp(name, "br") == 0) {
+            supported = (info->features & CURL_VERSION_BROTLI) != 0;
+        }
+        if (!supported) {
+            VAULT_LOG_WARN("⚠️ libcurl cannot decode '%s', not advertised in Accept-Encoding", name);
+            continue;
+        }
+        int n = snprintf(transport->accept_encoding + len, sizeof(transport->accept_encoding) - len,
+                         "%s%s", len ? ", " : "", name);
+        if (n < 0 || (size_t)n >= sizeof(transport->accept_encoding) - len) break;
+        len += (size_t)n;
+    }
+}
+
+// 적응형 동시 요청 제한 활성화 (시작 한도는 max_in_flight), KV 조회 응답 압축 방식 설정
+void vault_transport_configure(vault_transport_t *transport, const app_config_t *config) {
+    if (!transport || !transport->share || !config) return;
+    
+    vault_transport_encodings(transport, config->accept_encoding);
+    if (transport->accept_encoding[0]) {
+        VAULT_LOG_INFO("🗜️ Compressed KV responses accepted (%s)", transport->accept_encoding);
+    }
+    if (config->adaptive_limit) {
+        vault_limiter_configure(&transport->limiter, config->limit_min, config->max_in_flight, config->limit_max);
+        VAULT_LOG_INFO("🚦 Adaptive Vault concurrency limit enabled (%d..%d, start %d)", config->limit_min,
+                       config->limit_max, config->max_in_flight);
+    }
+}
+
+// 요청 템플릿 id (스레드별 핸들이 어떤 템플릿으로 설정되어 있는지 구분, 다시 만들 때마다 새 id)
+static unsigned long vault_template_ids;
+
+// 시크릿별 요청 템플릿 구성 (경로가 바뀔 때만, 조회 경로에서는 URL을 다시 만들지 않음)
+static void vault_request_template_build(vault_client_t *client, vault_request_template_t *request,
+                                         const char *path, vault_endpoint_t endpoint, int stream) {
+    request->url[0] = '\0';
+    if (path[0]) {
+        snprintf(request->url, sizeof(request->url), "%s/v1/%s", client->vault_url, path);
+    }
+    request->endpoint = endpoint;
+    request->stream = stream;
+    request->id = __atomic_add_fetch(&vault_template_ids, 1, __ATOMIC_RELAXED);
+}
+
+// 시크릿 경로 구성 (Entity 기반, changes에 해당하는 시크릿만, 비활성화된 시크릿은 빈 경로)
+static void vault_client_build_paths(vault_client_t *client, unsigned changes) {
+    const app_config_t *config = client->config;
+    
+    // KV 경로 설정
+    if (changes & CONFIG_CHANGED_KV) {
+        client->kv_path[0] = '\0';
+        if (config->secret_kv.enabled && config->secret_kv.kv_path[0]) {
+            snprintf(client->kv_path, sizeof(client->kv_path), "%s-kv/data/%s", 
+                    config->entity, config->secret_kv.kv_path);
+        }
+        vault_request_template_build(client, &client->kv_request, client->kv_path, VAULT_ENDPOINT_KV_DATA, 1);
+    }
+    
+    // Database Dynamic 경로 설정
+    if (changes & CONFIG_CHANGED_DB_DYNAMIC) {
+        client->db_dynamic_path[0] = '\0';
+        if (config->secret_database_dynamic.enabled && config->secret_database_dynamic.role_id[0]) {
+            snprintf(client->db_dynamic_path, sizeof(client->db_dynamic_path), "%s-database/creds/%s", 
+                    config->entity, config->secret_database_dynamic.role_id);
+        }
+        vault_request_template_build(client, &client->db_dynamic_request, client->db_dynamic_path, VAULT_ENDPOINT_DB_CREDS, 0);
+    }
+    
+    // Database Static 경로 설정
+    if (changes & CONFIG_CHANGED_DB_STATIC) {
+        client->db_static_path[0] = '\0';
+        if (config->secret_database_static.enabled && config->secret_database_static.role_id[0]) {
+            snprintf(client->db_static_path, sizeof(client->db_static_path), "%s-database/static-creds/%s", 
+                    config->entity, config->secret_database_static.role_id);
+        }
+        vault_request_template_build(client, &client->db_static_request, client->db_static_path, VAULT_ENDPOINT_DB_STATIC_CREDS, 0);
+    }
+}
+
 // Vault 클라이언트 초기화
 int vault_client_init(vault_client_t *client, app_config_t *config) {
     if (!client || !config) return -1;
@@ -36,22 +615,22 @@ int vault_client_init(vault_client_t *client, app_config_t *config) {
     strncpy(client->vault_url, config->vault_url, sizeof(client->vault_url) - 1);
     client->vault_url[sizeof(client->vault_url) - 1] = '\0';
     
-    // CURL 초기화
-    client->curl = curl_easy_init();
-    if (!client->curl) {
-        fprintf(stderr, "Failed to initialize CURL\n");
-        return -1;
-    }
+    // 요청 핸들은 스레드별로 만들어 재사용 (공유 전송 계층은 vault_client_set_transport로 지정)
+    client->transport = NULL;
+    
+    // 토큰 상태 초기화 (로그인 전에는 발행된 레코드 없음)
+    client->token_state = NULL;
+    client->token_generation = 0;
+    pthread_mutex_init(&client->token_lock, NULL);
     
-    // CURL 옵션 설정 (설정에서 가져옴)
-    curl_easy_setopt(client->curl, CURLOPT_TIMEOUT, config->http_timeout);
-    curl_easy_setopt(client->curl, CURLOPT_FOLLOWLOCATION, 1L);
-    curl_easy_setopt(client->curl, CURLOPT_SSL_VERIFYPEER, 0L);
-    curl_easy_setopt(client->curl, CURLOPT_SSL_VERIFYHOST, 0L);
+    // 시크릿 캐시 잠금 (읽기는 공유, 교체는 배타) 및 시크릿별 갱신 직렬화
+    pthread_rwlock_init(&client->cache_lock, NULL);
+    for (int i = 0; i < VAULT_CACHE_COUNT; i++) {
+        pthread_mutex_init(&client->refresh_lock[i], NULL);
+    }
     
-    client->token[0] = '\0';
-    client->token_expiry = 0;
-    client->token_issued = 0;
+    // 주기 작업 분산 정책 초기화
+    vault_schedule_init(&client->schedule, config);
     
     // KV 캐시 초기화
     client->cached_kv_secret = NULL;
@@ -65,41 +644,61 @@ int vault_client_init(vault_client_t *client, app_config_t *config) {
     client->db_dynamic_path[0] = '\0';
     client->lease_id[0] = '\0';
     client->lease_expiry = 0;
+    vault_db_pool_init(&client->db_pool);
     
     // Database Static 캐시 초기화
     client->cached_db_static_secret = NULL;
     client->db_static_last_refresh = 0;
+    client->db_static_rotation_at = 0;
     client->db_static_path[0] = '\0';
     
-    // KV 경로 설정 (Entity 기반)
-    if (config->secret_kv.enabled && config->secret_kv.kv_path[0]) {
-        snprintf(client->kv_path, sizeof(client->kv_path), "%s-kv/data/%s", 
-                config->entity, config->secret_kv.kv_path);
-    }
+    // 경로별 KV 캐시 초기화
+    vault_path_cache_init(&client->kv_paths);
     
-    // Database Dynamic 경로 설정 (Entity 기반)
-    if (config->secret_database_dynamic.enabled && config->secret_database_dynamic.role_id[0]) {
-        snprintf(client->db_dynamic_path, sizeof(client->db_dynamic_path), "%s-database/creds/%s", 
-                config->entity, config->secret_database_dynamic.role_id);
-    }
+    // 변경 구독 목록 초기화
+    vault_subscriptions_init(&client->subscriptions);
     
-    // Database Static 경로 설정 (Entity 기반)
-    if (config->secret_database_static.enabled && config->secret_database_static.role_id[0]) {
-        snprintf(client->db_static_path, sizeof(client->db_static_path), "%s-database/static-creds/%s", 
-                config->entity, config->secret_database_static.role_id);
-    }
+    // 시크릿 경로 설정 (Entity 기반)
+    vault_client_build_paths(client, CONFIG_CHANGED_KV | CONFIG_CHANGED_DB_DYNAMIC | CONFIG_CHANGED_DB_STATIC);
     
     return 0;
 }
 
+// 공유 전송 계층 지정 (이후 요청부터 연결 풀을 공유)
+void vault_client_set_transport(vault_client_t *client, vault_transport_t *transport) {
+    if (!client) return;
+    
+    client->transport = transport;
+}
+
+// 설정 핫 리로드 반영: 바뀐 시크릿의 경로를 다시 만들고 해당 캐시만 비움
+// (토큰과 변경되지 않은 시크릿 캐시는 유지)
+// 경로가 바뀌는 시크릿의 갱신 스레드는 중지된 상태에서 호출해야 합니다.
+void vault_client_apply_config(vault_client_t *client, unsigned changes) {
+    if (!client || !client->config) return;
+    
+    // 이전 경로의 캐시는 새 경로와 무관하므로 폐기 (Dynamic lease는 TTL 만료로 회수됨)
+    if (changes & CONFIG_CHANGED_KV) {
+        vault_cleanup_kv_cache(client);
+    }
+    if (changes & CONFIG_CHANGED_DB_DYNAMIC) {
+        vault_cleanup_db_dynamic_cache(client);
+        // 풀의 자격증명은 유예 시간 동안 기존 연결이 쓰도록 두고 다음 유지 작업에서 폐기
+        vault_db_pool_retire(&client->db_pool, 0, time(NULL) + client->config->secret_database_dynamic.pool_drain_grace);
+    }
+    if (changes & CONFIG_CHANGED_DB_STATIC) {
+        vault_cleanup_db_static_cache(client);
+    }
+    vault_client_build_paths(client, changes);
+    
+    if (changes & CONFIG_CHANGED_SCHEDULE) {
+        vault_schedule_update(&client->schedule, client->config);
+    }
+}
+
 // Vault 클라이언트 정리
 void vault_client_cleanup(vault_client_t *client) {
     if (client) {
-        if (client->curl) {
-            curl_easy_cleanup(client->curl);
-            client->curl = NULL;
-        }
-        
         // KV 캐시 정리
         vault_cleanup_kv_cache(client);
         
@@ -108,17 +707,30 @@ void vault_client_cleanup(vault_client_t *client) {
         
         // Database Static 캐시 정리
         vault_cleanup_db_static_cache(client);
+        
+        // 토큰 레코드 정리
+        vault_token_publish(client, NULL);
+        pthread_mutex_destroy(&client->token_lock);
+        pthread_rwlock_destroy(&client->cache_lock);
+        for (int i = 0; i < VAULT_CACHE_COUNT; i++) {
+            pthread_mutex_destroy(&client->refresh_lock[i]);
+        }
+        
+        vault_path_cache_destroy(&client->kv_paths);
+        vault_db_pool_destroy(&client->db_pool);
+        vault_subscriptions_destroy(&client->subscriptions);
     }
 }
 
 // AppRole 로그인
-int vault_login(vault_client_t *client, const char *role_id, const char *secret_id) {
+static int vault_login_impl(vault_client_t *client, const char *role_id, const char *secret_id) {
     if (!client || !role_id || !secret_id) return -1;
     
-    // 새로운 CURL 핸들 생성
-    CURL *curl = curl_easy_init();
+    // 스레드별 요청 핸들 준비
+    struct http_response *response = NULL;
+    CURL *curl = vault_request_begin(client, &response);
     if (!curl) {
-        fprintf(stderr, "Failed to initialize CURL\n");
+        VAULT_LOG_ERROR("Failed to initialize CURL");
         return -1;
     }
     
@@ -130,43 +742,33 @@ int vault_login(vault_client_t *client, const char *role_id, const char *secret_
     char *json_string = (char*)json_object_to_json_string(request);
     
     // HTTP 요청 설정
-    struct http_response response = {0};
-    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, write_callback);
-    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &response);
     curl_easy_setopt(curl, CURLOPT_POSTFIELDS, json_string);
     curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, strlen(json_string));
-    curl_easy_setopt(curl, CURLOPT_TIMEOUT, client->config->http_timeout);
-    curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
-    curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 0L);
-    curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, 0L);
     
     // URL 설정
     char url[512];
     snprintf(url, sizeof(url), "%s/v1/auth/approle/login", client->vault_url);
     curl_easy_setopt(curl, CURLOPT_URL, url);
     
-    // Content-Type 헤더 설정
-    struct curl_slist *headers = NULL;
+    // Content-Type 헤더 설정 (네임스페이스 로그인 포함)
+    struct curl_slist *headers = vault_request_headers(client, NULL);
     headers = curl_slist_append(headers, "Content-Type: application/json");
     curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
     
     // 요청 실행
-    CURLcode res = curl_easy_perform(curl);
+    CURLcode res = vault_perform(client, curl, VAULT_ENDPOINT_LOGIN, response);
     curl_slist_free_all(headers);
     json_object_put(request);
     
     if (res != CURLE_OK) {
-        fprintf(stderr, "Login request failed: %s\n", curl_easy_strerror(res));
-        free(response.data);
-        curl_easy_cleanup(curl);
+        VAULT_LOG_ERROR("Login request failed: %s", curl_easy_strerror(res));
         return -1;
     }
     
     // 응답 파싱
-    json_object *json_response = json_tokener_parse(response.data);
+    json_object *json_response = response->data ? json_tokener_parse(response->data) : NULL;  // 빈 응답(연결 끊김 등)은 파싱 실패로 처리
     if (!json_response) {
-        fprintf(stderr, "Failed to parse login response\n");
-        free(response.data);
+        VAULT_LOG_ERROR("Failed to parse login response");
         return -1;
     }
     
@@ -176,81 +778,97 @@ int vault_login(vault_client_t *client, const char *role_id, const char *secret_
         json_object_object_get_ex(auth, "client_token", &client_token)) {
         
         const char *token = json_object_get_string(client_token);
-        strncpy(client->token, token, sizeof(client->token) - 1);
-        client->token[sizeof(client->token) - 1] = '\0';
-        
-        // 토큰 발급 시간 기록
-        client->token_issued = time(NULL);
         
         // 토큰 만료 시간 설정 (Vault에서 받은 실제 TTL 사용)
+        int ttl_seconds = 3600;
         json_object *lease_duration;
         if (json_object_object_get_ex(auth, "lease_duration", &lease_duration)) {
-            int ttl_seconds = json_object_get_int(lease_duration);
-            client->token_expiry = client->token_issued + ttl_seconds;
-            printf("Token TTL from Vault: %d seconds\n", ttl_seconds);
+            ttl_seconds = json_object_get_int(lease_duration);
+            VAULT_LOG_INFO("Token TTL from Vault: %d seconds", ttl_seconds);
         } else {
             // TTL 정보가 없으면 기본값 사용 (1시간)
-            client->token_expiry = client->token_issued + 3600;
-            printf("Warning: No TTL info from Vault, using default 1 hour\n");
+            VAULT_LOG_WARN("No TTL info from Vault, using default 1 hour");
+        }
+        
+        // 토큰 유형 확인 (batch 토큰은 저장되지 않으며 갱신 불가)
+        int batch = (strcmp(client->config->token_type, "batch") == 0);
+        json_object *token_type, *renewable_obj;
+        if (json_object_object_get_ex(auth, "token_type", &token_type)) {
+            const char *type = json_object_get_string(token_type);
+            if (batch != (strcmp(type, "batch") == 0)) {
+                VAULT_LOG_WARN("Configured token_type '%s' but Vault issued a '%s' token",
+                               client->config->token_type, type);
+            }
+            batch = (strcmp(type, "batch") == 0);
+        }
+        int renewable = !batch;
+        if (json_object_object_get_ex(auth, "renewable", &renewable_obj)) {
+            renewable = json_object_get_boolean(renewable_obj);
+        }
+        VAULT_LOG_INFO("Token type: %s (%s)", batch ? "batch" : "service", renewable ? "renewable" : "non-renewable");
+        
+        // 새 토큰 레코드 발행 (기존 토큰으로 진행 중인 요청은 그대로 완료됨)
+        vault_token_t *record = vault_token_new(client, token, time(NULL), ttl_seconds, renewable);
+        if (!record) {
+            VAULT_LOG_ERROR("Failed to allocate token record");
+            json_object_put(json_response);
+            return -1;
         }
+        vault_token_publish(client, record);
         
-        printf("Login successful. Token expires in %ld seconds\n", 
-               client->token_expiry - time(NULL));
+        VAULT_LOG_INFO("Login successful. Token expires in %d seconds", ttl_seconds);
     } else {
-        fprintf(stderr, "Failed to extract token from response\n");
+        VAULT_LOG_ERROR("Failed to extract token from response");
         json_object_put(json_response);
-        free(response.data);
         return -1;
     }
     
     json_object_put(json_response);
-    free(response.data);
-    curl_easy_cleanup(curl);
     return 0;
 }
 
 // 토큰 갱신
 int vault_renew_token(vault_client_t *client) {
-    if (!client || !client->token[0]) return -1;
+    if (!client) return -1;
     
-    // 새로운 CURL 핸들 생성
-    CURL *curl = curl_easy_init();
+    // 갱신 대상 토큰 레코드 고정
+    vault_token_t *current = vault_token_acquire(client);
+    if (!current) return -1;
+    
+    // batch 토큰은 renew-self 불가 (재로그인 필요)
+    if (!current->renewable) {
+        VAULT_LOG_INFO("Token is not renewable (batch token), re-login required");
+        vault_token_release(current);
+        return -1;
+    }
+    
+    // 스레드별 요청 핸들 준비
+    struct http_response *response = NULL;
+    CURL *curl = vault_request_begin(client, &response);
     if (!curl) {
-        fprintf(stderr, "Failed to initialize CURL for renewal\n");
+        VAULT_LOG_ERROR("Failed to initialize CURL for renewal");
+        vault_token_release(current);
         return -1;
     }
     
     // HTTP 요청 설정
-    struct http_response response = {0};
-    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, write_callback);
-    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &response);
     curl_easy_setopt(curl, CURLOPT_POSTFIELDS, "");
     curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, 0);
-    curl_easy_setopt(curl, CURLOPT_TIMEOUT, client->config->http_timeout);
-    curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
-    curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 0L);
-    curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, 0L);
     
     // URL 설정
     char url[512];
     snprintf(url, sizeof(url), "%s/v1/auth/token/renew-self", client->vault_url);
     curl_easy_setopt(curl, CURLOPT_URL, url);
     
-    // Authorization 헤더 설정
-    char auth_header[1024];
-    snprintf(auth_header, sizeof(auth_header), "X-Vault-Token: %s", client->token);
-    struct curl_slist *headers = NULL;
-    headers = curl_slist_append(headers, auth_header);
-    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
+    // Authorization 헤더 설정 (토큰 레코드에 미리 만든 목록)
+    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, current->headers);
     
     // 요청 실행
-    CURLcode res = curl_easy_perform(curl);
-    curl_slist_free_all(headers);
+    CURLcode res = vault_perform(client, curl, VAULT_ENDPOINT_RENEW_SELF, response);
     
     if (res != CURLE_OK) {
-        fprintf(stderr, "Token renewal failed: %s\n", curl_easy_strerror(res));
-        free(response.data);
-        curl_easy_cleanup(curl);
+        VAULT_LOG_ERROR("Token renewal failed: %s", curl_easy_strerror(res));
+        vault_token_release(current);
         return -1;
     }
     
@@ -258,63 +876,82 @@ int vault_renew_token(vault_client_t *client) {
     long http_code;
     curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &http_code);
     if (http_code != 200) {
-        fprintf(stderr, "Token renewal failed with HTTP %ld\n", http_code);
-        printf("Response: %s\n", response.data);
-        free(response.data);
-        curl_easy_cleanup(curl);
+        VAULT_LOG_ERROR("Token renewal failed with HTTP %ld", http_code);
+        VAULT_LOG_DEBUG("Response: %s", response->data);
+        vault_token_release(current);
         return -1;
     }
     
     // 응답 파싱
-    json_object *json_response = json_tokener_parse(response.data);
+    json_object *json_response = response->data ? json_tokener_parse(response->data) : NULL;  // 빈 응답(연결 끊김 등)은 파싱 실패로 처리
     if (json_response) {
         json_object *auth, *lease_duration;
         if (json_object_object_get_ex(json_response, "auth", &auth) &&
             json_object_object_get_ex(auth, "lease_duration", &lease_duration)) {
             
             int lease_seconds = json_object_get_int(lease_duration);
-            time_t now = time(NULL);
-            client->token_issued = now;  // 갱신 시간 업데이트
-            client->token_expiry = now + lease_seconds;
             
-            printf("Token renewed successfully. New expiry: %ld seconds\n", 
-                   client->token_expiry - now);
+            // 같은 토큰 문자열로 갱신된 만료 정보를 담은 새 레코드 발행
+            vault_token_t *record = vault_token_new(client, current->token, time(NULL), lease_seconds, 1);
+            if (record) {
+                time_t next_renewal = record->renewal_at - record->issued;
+                vault_token_publish(client, record);
+                VAULT_LOG_INFO("Token renewed successfully. New expiry: %d seconds (next renewal in %ld seconds)", 
+                               lease_seconds, next_renewal);
+            }
         } else {
-            printf("Warning: No lease_duration in renewal response\n");
+            VAULT_LOG_WARN("No lease_duration in renewal response");
             // 응답 내용 출력 (디버깅용)
-            printf("Renewal response: %s\n", response.data);
+            VAULT_LOG_DEBUG("Renewal response: %s", response->data);
         }
         json_object_put(json_response);
     } else {
-        printf("Warning: Failed to parse renewal response\n");
-        printf("Renewal response: %s\n", response.data);
+        VAULT_LOG_WARN("Failed to parse renewal response");
+        VAULT_LOG_DEBUG("Renewal response: %s", response->data);
     }
     
-    free(response.data);
-    curl_easy_cleanup(curl);
+    vault_token_release(current);
     return 0;
 }
 
+// 토큰 갱신 (실패 시 재로그인)
+// 백그라운드 스레드에서 호출되며, 새 토큰이 발행되기 전까지 다른 스레드는 기존 토큰을 계속 사용합니다.
+// batch 토큰은 갱신이 불가능하므로 renew-self 없이 바로 재로그인합니다.
+static int vault_refresh_token_impl(vault_client_t *client) {
+    if (!client || !client->config) return -1;
+    
+    vault_token_t *current = vault_token_acquire(client);
+    int renewable = current ? current->renewable : 0;
+    vault_token_release(current);
+    
+    if (!renewable) {
+        VAULT_LOG_INFO("🔁 Non-renewable token: proactive re-login before expiry");
+        return vault_login(client, client->config->vault_role_id, client->config->vault_secret_id);
+    }
+    
+    if (vault_renew_token(client) == 0) {
+        return 0;
+    }
+    
+    VAULT_LOG_INFO("❌ Token renewal failed. Attempting re-login...");
+    return vault_login(client, client->config->vault_role_id, client->config->vault_secret_id);
+}
+
 // 시크릿 가져오기
 int vault_get_secret(vault_client_t *client, const char *path, json_object **secret_data) {
     if (!client || !path || !secret_data) return -1;
     
-    // 새로운 CURL 핸들 생성
-    CURL *curl = curl_easy_init();
+    // 스레드별 요청 핸들 준비
+    struct http_response *response = NULL;
+    CURL *curl = vault_request_begin(client, &response);
     if (!curl) {
-        fprintf(stderr, "Failed to initialize CURL for secret\n");
+        VAULT_LOG_ERROR("Failed to initialize CURL for secret");
         return -1;
     }
     
-    // HTTP 요청 설정
-    struct http_response response = {0};
-    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, write_callback);
-    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &response);
+    // HTTP 요청 설정 (압축 응답 허용, 받는 대로 파싱)
     curl_easy_setopt(curl, CURLOPT_HTTPGET, 1L);
-    curl_easy_setopt(curl, CURLOPT_TIMEOUT, client->config->http_timeout);
-    curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
-    curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 0L);
-    curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, 0L);
+    vault_request_stream(client, curl, response);
     
     // URL 설정
     char url[512];
@@ -322,28 +959,26 @@ int vault_get_secret(vault_client_t *client, const char *path, json_object **sec
     curl_easy_setopt(curl, CURLOPT_URL, url);
     
     // Authorization 헤더 설정
-    char auth_header[1024];
-    snprintf(auth_header, sizeof(auth_header), "X-Vault-Token: %s", client->token);
-    struct curl_slist *headers = NULL;
-    headers = curl_slist_append(headers, auth_header);
-    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
+    vault_token_t *token = vault_token_acquire(client);
+    if (!token) {
+        VAULT_LOG_ERROR("Not logged in to Vault");
+        return -1;
+    }
+    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, token->headers);
     
     // 요청 실행
-    CURLcode res = curl_easy_perform(curl);
-    curl_slist_free_all(headers);
+    CURLcode res = vault_perform(client, curl, VAULT_ENDPOINT_OTHER, response);
+    vault_token_release(token);
     
     if (res != CURLE_OK) {
-        fprintf(stderr, "Secret request failed: %s\n", curl_easy_strerror(res));
-        free(response.data);
-        curl_easy_cleanup(curl);
+        VAULT_LOG_ERROR("Secret request failed: %s", curl_easy_strerror(res));
         return -1;
     }
     
-    // 응답 파싱
-    json_object *json_response = json_tokener_parse(response.data);
+    // 응답 파싱 (스트리밍 파싱 결과)
+    json_object *json_response = vault_response_json(response);  // 빈 응답(연결 끊김 등)은 파싱 실패로 처리
     if (!json_response) {
-        fprintf(stderr, "Failed to parse secret response\n");
-        free(response.data);
+        VAULT_LOG_ERROR("Failed to parse secret response");
         return -1;
     }
     
@@ -354,63 +989,617 @@ int vault_get_secret(vault_client_t *client, const char *path, json_object **sec
         
         *secret_data = json_object_get(data_obj); // 참조 카운트 증가
         
-        printf("Secret retrieved successfully\n");
+        VAULT_LOG_INFO("Secret retrieved successfully");
     } else {
-        fprintf(stderr, "Failed to extract secret data\n");
+        VAULT_LOG_ERROR("Failed to extract secret data");
         json_object_put(json_response);
-        free(response.data);
         return -1;
     }
     
-    // json_response 해제 (secret_data는 별도 참조이므로 안전)
-    json_object_put(json_response);
-    free(response.data);
-    curl_easy_cleanup(curl);
-    return 0;
+    // json_response 해제 (secret_data는 별도 참조이므로 안전)
+    json_object_put(json_response);
+    return 0;
+}
+
+// 쓰기 요청 (JSON 본문 POST, Transit 등)
+// HTTP 2xx이면 0. 응답 본문을 파싱할 수 있으면 오류 응답이어도 *response에 전체 응답을 넘깁니다
+// (batch 요청은 일부 항목만 실패해도 4xx와 함께 항목별 결과가 오므로, 호출자가 확인 후 put).
+// sensitive이면 파싱 후 스레드별 응답 버퍼의 본문을 지웁니다 (파싱된 JSON의 비밀 값은 호출자가 지움).
+static int vault_write_request(vault_client_t *client, const char *path, const char *body, vault_endpoint_t endpoint,
+                               int sensitive, json_object **response_json) {
+    if (!client || !path || !body) return -1;
+    if (response_json) *response_json = NULL;
+    
+    struct http_response *response = NULL;
+    CURL *curl = vault_request_begin(client, &response);
+    if (!curl) {
+        VAULT_LOG_ERROR("Failed to initialize CURL for write");
+        return -1;
+    }
+    
+    char url[512];
+    snprintf(url, sizeof(url), "%s/v1/%s", client->vault_url, path);
+    curl_easy_setopt(curl, CURLOPT_URL, url);
+    
+    vault_token_t *token = vault_token_acquire(client);
+    if (!token) {
+        VAULT_LOG_ERROR("Not logged in to Vault");
+        return -1;
+    }
+    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, token->json_headers);
+    curl_easy_setopt(curl, CURLOPT_POSTFIELDS, body);
+    curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, (long)strlen(body));
+    response->sensitive = sensitive;
+    
+    CURLcode res = vault_perform(client, curl, endpoint, response);
+    vault_token_release(token);
+    
+    if (res != CURLE_OK) {
+        if (sensitive) vault_response_wipe(response);
+        VAULT_LOG_ERROR("Write request failed: %s", curl_easy_strerror(res));
+        return -1;
+    }
+    long http_code;
+    curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &http_code);
+    if (response_json && response->data && response->size > 0) {
+        *response_json = json_tokener_parse(response->data);
+    }
+    if (sensitive) vault_response_wipe(response);
+    if (http_code < 200 || http_code >= 300) {
+        VAULT_LOG_ERROR("Write request failed with HTTP %ld", http_code);
+        return -1;
+    }
+    return 0;
+}
+
+int vault_write(vault_client_t *client, const char *path, const char *body, vault_endpoint_t endpoint,
+                json_object **response_json) {
+    return vault_write_request(client, path, body, endpoint, 0, response_json);
+}
+
+int vault_write_sensitive(vault_client_t *client, const char *path, const char *body, vault_endpoint_t endpoint,
+                          json_object **response_json) {
+    return vault_write_request(client, path, body, endpoint, 1, response_json);
+}
+
+// 여러 요청 동시 실행
+// multi 핸들 하나에 슬롯 max_in_flight개를 두고, 하나가 끝나면 같은 슬롯으로 다음 경로를 시작합니다.
+// 적응형 한도가 있으면 bulk 우선순위로 자리를 얻은 슬롯만 시작하며, 진행 중인 요청이 하나도 없을 때만 자리를 기다립니다.
+// 완료(또는 시작 실패)마다 done이 호출되며, 시작 실패는 CURLE_FAILED_INIT, 한도 대기 시간 초과는 CURLE_OPERATION_TIMEDOUT으로 전달됩니다.
+// 모두 KV 조회이므로 응답은 스트리밍으로 파싱하며, done에서 vault_response_json으로 넘겨받습니다.
+typedef void (*vault_multi_done_t)(vault_client_t *client, size_t index, CURLcode res, long http_code,
+                                   struct http_response *response, void *ctx);
+
+typedef struct {
+    CURL *curl;
+    struct http_response response;
+    size_t index;    // paths 인덱스
+    uint64_t start;
+    int busy;        // 요청 진행 중 (한도 자리 보유)
+} vault_multi_slot_t;
+
+typedef struct {
+    vault_client_t *client;
+    CURLM *multi;
+    struct curl_slist *headers;
+    const char *method;          // NULL이면 GET
+    vault_endpoint_t endpoint;
+    const char *const *paths;    // /v1/ 이후 경로
+    size_t count;
+    size_t next;
+    vault_multi_done_t done;
+    void *ctx;
+    vault_limiter_t *limiter;
+} vault_multi_t;
+
+static int vault_multi_start(vault_multi_t *m, vault_multi_slot_t *slot) {
+    if (!slot->curl) {
+        slot->curl = curl_easy_init();
+        if (!slot->curl) return -1;
+    } else {
+        curl_easy_reset(slot->curl);
+    }
+    vault_request_setup(m->client, slot->curl, &slot->response);
+    vault_request_stream(m->client, slot->curl, &slot->response);
+    
+    char url[1024];
+    snprintf(url, sizeof(url), "%s/v1/%s", m->client->vault_url, m->paths[slot->index]);
+    curl_easy_setopt(slot->curl, CURLOPT_URL, url);
+    if (m->method) {
+        curl_easy_setopt(slot->curl, CURLOPT_CUSTOMREQUEST, m->method);
+    } else {
+        curl_easy_setopt(slot->curl, CURLOPT_HTTPGET, 1L);
+    }
+    curl_easy_setopt(slot->curl, CURLOPT_HTTPHEADER, m->headers);
+    curl_easy_setopt(slot->curl, CURLOPT_PRIVATE, slot);
+    slot->start = vault_metrics_now_ns();
+    return curl_multi_add_handle(m->multi, slot->curl) == CURLM_OK ? 0 : -1;
+}
+
+// 슬롯에 다음 경로 시작 (시작하면 1, 남은 경로가 없거나 wait가 0이고 한도 자리가 없으면 0)
+static int vault_multi_next(vault_multi_t *m, vault_multi_slot_t *slot, int wait) {
+    while (m->next < m->count) {
+        int timeout_ms = wait ? m->client->config->http_timeout * 1000 : 0;
+        if (vault_limiter_acquire(m->limiter, VAULT_PRIORITY_BULK, timeout_ms) != 0) {
+            if (!wait) return 0;
+            slot->index = m->next++;
+            m->done(m->client, slot->index, CURLE_OPERATION_TIMEDOUT, 0, &slot->response, m->ctx);
+            continue;
+        }
+        slot->index = m->next++;
+        if (vault_multi_start(m, slot) == 0) {
+            slot->busy = 1;
+            return 1;
+        }
+        vault_limiter_release(m->limiter, 0, VAULT_LIMIT_IGNORE);
+        m->done(m->client, slot->index, CURLE_FAILED_INIT, 0, &slot->response, m->ctx);
+    }
+    return 0;
+}
+
+// 경로 count개를 동시에 요청 (토큰이 없거나 자원 부족으로 시작하지 못하면 -1)
+static int vault_multi_run(vault_client_t *client, const char *const paths[], size_t count, const char *method,
+                           vault_endpoint_t endpoint, vault_multi_done_t done, void *ctx) {
+    if (count == 0) return 0;
+    
+    vault_token_t *token = vault_token_acquire(client);
+    if (!token) {
+        VAULT_LOG_ERROR("Not logged in to Vault");
+        return -1;
+    }
+    size_t limit = client->config->max_in_flight > 0 ? (size_t)client->config->max_in_flight : DEFAULT_MAX_IN_FLIGHT;
+    if (limit > count) limit = count;
+    
+    vault_multi_t m = {client, curl_multi_init(), NULL, method, endpoint, paths, count, 0, done, ctx,
+                       vault_client_limiter(client)};
+    vault_multi_slot_t *slots = m.multi ? calloc(limit, sizeof(vault_multi_slot_t)) : NULL;
+    if (!slots) {
+        if (m.multi) curl_multi_cleanup(m.multi);
+        vault_token_release(token);
+        return -1;
+    }
+    m.headers = token->headers;
+    
+    size_t active = 0;
+    while (active > 0 || m.next < m.count) {
+        // 빈 슬롯에 다음 경로 시작 (한도 자리가 없으면 진행 중인 요청이 끝날 때 다시 시도)
+        for (size_t s = 0; s < limit && m.next < m.count; s++) {
+            if (slots[s].busy) continue;
+            if (!vault_multi_next(&m, &slots[s], active == 0)) break;
+            active++;
+        }
+        if (active == 0) continue;
+        
+        int running = 0;
+        curl_multi_perform(m.multi, &running);
+        
+        CURLMsg *msg;
+        int queued;
+        while ((msg = curl_multi_info_read(m.multi, &queued))) {
+            if (msg->msg != CURLMSG_DONE) continue;
+            CURL *easy = msg->easy_handle;
+            CURLcode res = msg->data.result;
+            vault_multi_slot_t *slot = NULL;
+            curl_easy_getinfo(easy, CURLINFO_PRIVATE, (char **)&slot);
+            curl_multi_remove_handle(m.multi, easy);
+            slot->busy = 0;
+            active--;
+            
+            uint64_t elapsed = vault_metrics_now_ns() - slot->start;
+            vault_limiter_release(m.limiter, elapsed, vault_limit_outcome(easy, res));
+            vault_perform_done(easy, endpoint, res, elapsed, &slot->response);
+            long http_code = 0;
+            if (res == CURLE_OK) curl_easy_getinfo(easy, CURLINFO_RESPONSE_CODE, &http_code);
+            done(client, slot->index, res, http_code, &slot->response, ctx);
+        }
+        if (active > 0) {
+            // 한도를 기다리는 경로가 있으면 다른 스레드가 반납한 자리를 보도록 짧게 대기
+            curl_multi_wait(m.multi, NULL, 0, active < limit && m.next < m.count ? 10 : 1000, NULL);
+        }
+    }
+    
+    vault_token_release(token);
+    for (size_t s = 0; s < limit; s++) {
+        if (slots[s].curl) curl_easy_cleanup(slots[s].curl);
+        vault_response_free(&slots[s].response);
+    }
+    free(slots);
+    curl_multi_cleanup(m.multi);
+    return 0;
+}
+
+// KV v2 data 응답에서 data.data 참조와 metadata.version 추출 (성공 시 호출자가 *data를 put)
+static int vault_parse_kv_document(struct http_response *response, json_object **data, long *version) {
+    json_object *json_response = vault_response_json(response);
+    json_object *data_outer, *data_obj, *metadata, *version_obj;
+    if (!json_response || !json_object_object_get_ex(json_response, "data", &data_outer) ||
+        !json_object_object_get_ex(data_outer, "data", &data_obj)) {
+        json_object_put(json_response);
+        return -1;
+    }
+    *version = 0;
+    if (json_object_object_get_ex(data_outer, "metadata", &metadata) &&
+        json_object_object_get_ex(metadata, "version", &version_obj)) {
+        *version = (long)json_object_get_int64(version_obj);
+    }
+    *data = json_object_get(data_obj);
+    json_object_put(json_response);
+    return 0;
+}
+
+static void vault_result_fail(vault_secret_result_t *result, const char *reason) {
+    result->rc = -1;
+    snprintf(result->error, sizeof(result->error), "%s", reason);
+}
+
+// vault_get_secrets 요청 상태
+typedef struct {
+    const size_t *pending;           // 요청 인덱스 -> paths/results 인덱스
+    const char *const *paths;
+    vault_secret_result_t *results;
+} vault_batch_ctx_t;
+
+// 완료된 요청의 응답을 결과와 경로 캐시에 반영
+static void vault_batch_done(vault_client_t *client, size_t index, CURLcode res, long http_code,
+                             struct http_response *response, void *arg) {
+    vault_batch_ctx_t *ctx = (vault_batch_ctx_t *)arg;
+    size_t i = ctx->pending[index];
+    vault_secret_result_t *result = &ctx->results[i];
+    result->http_code = http_code;
+    
+    if (res != CURLE_OK) {
+        vault_result_fail(result, curl_easy_strerror(res));
+        return;
+    }
+    if (http_code != 200) {
+        char reason[32];
+        snprintf(reason, sizeof(reason), "HTTP %ld", http_code);
+        vault_result_fail(result, reason);
+        return;
+    }
+    json_object *data = NULL;
+    long version = 0;
+    if (vault_parse_kv_document(response, &data, &version) != 0) {
+        vault_result_fail(result, "failed to extract secret data");
+        return;
+    }
+    
+    // 호출자에게는 복사본, 캐시에는 원본 참조
+    if (json_object_deep_copy(data, &result->data, NULL) != 0) {
+        result->data = NULL;
+        json_object_put(data);
+        vault_result_fail(result, "out of memory");
+        return;
+    }
+    vault_path_cache_put(&client->kv_paths, ctx->paths[i], data, version);
+    result->rc = 0;
+}
+
+// 여러 KV 경로 동시 조회
+// 경로 캐시에서 refresh_interval 이내에 확인된 경로는 요청 없이 반환하고, 나머지는 multi 핸들 하나로
+// 공유 전송 계층을 통해 [http] max_in_flight개까지 동시에 요청합니다.
+int vault_get_secrets(vault_client_t *client, const char *const paths[], size_t count,
+                      vault_secret_result_t results[]) {
+    if (!client || !client->config || (count > 0 && (!paths || !results))) return -1;
+    
+    memset(results, 0, count * sizeof(vault_secret_result_t));
+    size_t *pending = count ? malloc(count * sizeof(size_t)) : NULL;
+    const char **pending_paths = count ? malloc(count * sizeof(char *)) : NULL;
+    if (count && (!pending || !pending_paths)) {
+        free(pending);
+        free(pending_paths);
+        return -1;
+    }
+    
+    size_t pending_count = 0, cached = 0, failed = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (!paths[i] || !paths[i][0]) {
+            vault_result_fail(&results[i], "empty path");
+        } else if (vault_path_cache_get(&client->kv_paths, paths[i], client->config->secret_kv.refresh_interval,
+                                        &results[i].data) == 0) {
+            results[i].cached = 1;
+            cached++;
+        } else {
+            pending_paths[pending_count] = paths[i];
+            pending[pending_count++] = i;
+        }
+    }
+    
+    vault_batch_ctx_t ctx = {pending, paths, results};
+    if (vault_multi_run(client, pending_paths, pending_count, NULL, VAULT_ENDPOINT_KV_DATA,
+                        vault_batch_done, &ctx) != 0) {
+        for (size_t i = 0; i < pending_count; i++) {
+            vault_result_fail(&results[pending[i]], "failed to start requests");
+        }
+    }
+    for (size_t i = 0; i < count; i++) {
+        if (results[i].rc != 0) failed++;
+    }
+    free(pending);
+    free(pending_paths);
+    
+    if (pending_count > 0) {
+        VAULT_LOG_INFO("📚 Batch read: %zu paths (%zu cached, %zu requested, %zu failed)",
+                       count, cached, pending_count, failed);
+    }
+    return (int)failed;
+}
+
+// 경로 목록 (prefetch용, 문자열은 목록이 소유)
+typedef struct {
+    char **items;
+    size_t count;
+    size_t capacity;
+} vault_path_list_t;
+
+static int vault_path_list_add(vault_path_list_t *list, const char *format, const char *a, const char *b) {
+    if (list->count == list->capacity) {
+        size_t capacity = list->capacity ? list->capacity * 2 : 16;
+        char **grown = realloc(list->items, capacity * sizeof(char *));
+        if (!grown) return -1;
+        list->items = grown;
+        list->capacity = capacity;
+    }
+    int len = snprintf(NULL, 0, format, a, b);
+    char *item = len >= 0 ? malloc((size_t)len + 1) : NULL;
+    if (!item) return -1;
+    snprintf(item, (size_t)len + 1, format, a, b);
+    list->items[list->count++] = item;
+    return 0;
+}
+
+static void vault_path_list_free(vault_path_list_t *list) {
+    for (size_t i = 0; i < list->count; i++) {
+        free(list->items[i]);
+    }
+    free(list->items);
+    memset(list, 0, sizeof(*list));
+}
+
+// prefetch 진행 상태
+typedef struct {
+    const char *mount;
+    const vault_path_list_t *requested;  // 이번 단계 요청 경로 기준 상대 경로 (폴더 또는 리프)
+    vault_path_list_t *folders;          // LIST: 다음 깊이에서 탐색할 폴더
+    vault_path_list_t *leaves;           // LIST: 발견한 리프 / metadata: 데이터를 다시 받을 리프
+    int descend;                         // LIST: 하위 폴더를 다음 단계로 넘길지 (깊이 한도)
+    size_t max_keys;
+    size_t *key_count;
+    vault_prefetch_stats_t *stats;
+} vault_prefetch_ctx_t;
+
+// LIST <mount>/metadata/<folder> 응답: 하위 폴더("/"로 끝나는 키)와 리프 분류
+static void vault_prefetch_list_done(vault_client_t *client, size_t index, CURLcode res, long http_code,
+                                     struct http_response *response, void *arg) {
+    (void)client;
+    vault_prefetch_ctx_t *ctx = (vault_prefetch_ctx_t *)arg;
+    const char *folder = ctx->requested->items[index];
+    
+    if (http_code == 404) return;  // 빈 폴더
+    if (res != CURLE_OK || http_code != 200) {
+        ctx->stats->failed++;
+        return;
+    }
+    json_object *json_response = vault_response_json(response);
+    json_object *data, *keys;
+    if (!json_response || !json_object_object_get_ex(json_response, "data", &data) ||
+        !json_object_object_get_ex(data, "keys", &keys) || !json_object_is_type(keys, json_type_array)) {
+        json_object_put(json_response);
+        ctx->stats->failed++;
+        return;
+    }
+    
+    size_t n = json_object_array_length(keys);
+    for (size_t i = 0; i < n; i++) {
+        const char *key = json_object_get_string(json_object_array_get_idx(keys, i));
+        if (!key || !key[0]) continue;
+        size_t key_len = strlen(key);
+        if (key[key_len - 1] == '/') {
+            if (!ctx->descend) {
+                ctx->stats->truncated = 1;
+            } else if (vault_path_list_add(ctx->folders, "%s%s", folder, key) != 0) {
+                ctx->stats->failed++;
+            }
+        } else if (*ctx->key_count >= ctx->max_keys) {
+            ctx->stats->truncated = 1;
+        } else if (vault_path_list_add(ctx->leaves, "%s%s", folder, key) == 0) {
+            (*ctx->key_count)++;
+        } else {
+            ctx->stats->failed++;
+        }
+    }
+    json_object_put(json_response);
+}
+
+// GET <mount>/metadata/<leaf> 응답: 캐시와 버전이 같으면 확인 시각만 갱신, 다르면 데이터 다시 받기
+static void vault_prefetch_metadata_done(vault_client_t *client, size_t index, CURLcode res, long http_code,
+                                         struct http_response *response, void *arg) {
+    vault_prefetch_ctx_t *ctx = (vault_prefetch_ctx_t *)arg;
+    const char *leaf = ctx->requested->items[index];
+    
+    long current = -1;
+    if (res == CURLE_OK && http_code == 200) {
+        json_object *json_response = vault_response_json(response);
+        json_object *data, *version_obj;
+        if (json_response && json_object_object_get_ex(json_response, "data", &data) &&
+            json_object_object_get_ex(data, "current_version", &version_obj)) {
+            current = (long)json_object_get_int64(version_obj);
+        }
+        json_object_put(json_response);
+    }
+    
+    char path[1024];
+    snprintf(path, sizeof(path), "%s/data/%s", ctx->mount, leaf);
+    if (current >= 0 && vault_path_cache_touch(&client->kv_paths, path, current) == 0) {
+        ctx->stats->unchanged++;
+    } else if (vault_path_list_add(ctx->leaves, "%s%s", leaf, "") != 0) {
+        ctx->stats->failed++;
+    }
+}
+
+// GET <mount>/data/<leaf> 응답: 경로 캐시에 저장
+static void vault_prefetch_data_done(vault_client_t *client, size_t index, CURLcode res, long http_code,
+                                     struct http_response *response, void *arg) {
+    vault_prefetch_ctx_t *ctx = (vault_prefetch_ctx_t *)arg;
+    json_object *data = NULL;
+    long version = 0;
+    if (res != CURLE_OK || http_code != 200 || vault_parse_kv_document(response, &data, &version) != 0) {
+        ctx->stats->failed++;
+        return;
+    }
+    vault_path_cache_put(&client->kv_paths, ctx->requested->items[index], data, version);
+    ctx->stats->fetched++;
+}
+
+static int vault_prefetch_run(vault_client_t *client, const vault_path_list_t *relative, const char *format,
+                              const char *mount, const char *method, vault_endpoint_t endpoint,
+                              vault_multi_done_t done, vault_prefetch_ctx_t *ctx) {
+    vault_path_list_t full = {0};
+    for (size_t i = 0; i < relative->count; i++) {
+        if (vault_path_list_add(&full, format, mount, relative->items[i]) != 0) {
+            vault_path_list_free(&full);
+            return -1;
+        }
+    }
+    int rc = vault_multi_run(client, (const char *const *)full.items, full.count, method, endpoint, done, ctx);
+    vault_path_list_free(&full);
+    return rc;
+}
+
+// KV 하위 경로 미리 읽기
+// LIST <mount>/metadata/<prefix>를 깊이별로 동시에 요청하여 리프를 모으고(최대 max_depth 단계, max_keys개),
+// 캐시에 없는 리프는 데이터를, 이미 있는 리프는 metadata만 동시에 요청하여 버전이 바뀐 리프만 다시 받습니다.
+int vault_prefetch_kv(vault_client_t *client, const char *mount, const char *prefix, int max_depth,
+                      size_t max_keys, vault_prefetch_stats_t *stats) {
+    vault_prefetch_stats_t local;
+    if (!stats) stats = &local;
+    memset(stats, 0, sizeof(*stats));
+    if (!client || !client->config || !mount || !mount[0] || max_depth <= 0 || max_keys == 0) return -1;
+    
+    uint64_t start = vault_metrics_now_ns();
+    vault_path_list_t level = {0}, next_level = {0}, leaves = {0}, missing = {0}, cached = {0}, changed = {0};
+    size_t key_count = 0;
+    int rc = -1;
+    
+    // 시작 폴더 (빈 prefix는 마운트 루트, 그 외에는 "/"로 끝나도록)
+    if (vault_path_list_add(&level, "%s%s", prefix ? prefix : "",
+                            prefix && prefix[0] && prefix[strlen(prefix) - 1] != '/' ? "/" : "") != 0) {
+        goto done;
+    }
+    
+    // 1. 깊이별 LIST (같은 깊이의 폴더는 동시에)
+    for (int depth = 1; depth <= max_depth && level.count > 0; depth++) {
+        vault_prefetch_ctx_t ctx = {mount, &level, &next_level, &leaves, depth < max_depth, max_keys, &key_count, stats};
+        stats->lists += level.count;
+        if (vault_prefetch_run(client, &level, "%s/metadata/%s", mount, "LIST", VAULT_ENDPOINT_OTHER,
+                               vault_prefetch_list_done, &ctx) != 0) {
+            goto done;
+        }
+        vault_path_list_free(&level);
+        level = next_level;
+        memset(&next_level, 0, sizeof(next_level));
+    }
+    stats->keys = leaves.count;
+    
+    // 2. 캐시 여부로 분류 (캐시 경로는 <mount>/data/<leaf>)
+    for (size_t i = 0; i < leaves.count; i++) {
+        char path[1024];
+        snprintf(path, sizeof(path), "%s/data/%s", mount, leaves.items[i]);
+        vault_path_list_t *target = vault_path_cache_version(&client->kv_paths, path, NULL) == 0 ? &cached : &missing;
+        if (vault_path_list_add(target, "%s%s", leaves.items[i], "") != 0) goto done;
+    }
+    
+    // 3. 캐시된 리프는 metadata로 버전만 확인 (바뀐 리프는 missing에 추가)
+    if (cached.count > 0) {
+        vault_prefetch_ctx_t ctx = {mount, &cached, NULL, &changed, 0, max_keys, &key_count, stats};
+        if (vault_prefetch_run(client, &cached, "%s/metadata/%s", mount, NULL, VAULT_ENDPOINT_OTHER,
+                               vault_prefetch_metadata_done, &ctx) != 0) {
+            goto done;
+        }
+        for (size_t i = 0; i < changed.count; i++) {
+            if (vault_path_list_add(&missing, "%s%s", changed.items[i], "") != 0) goto done;
+        }
+    }
+    
+    // 4. 데이터 요청 (새 리프 + 버전이 바뀐 리프)
+    if (missing.count > 0) {
+        vault_path_list_t full = {0};
+        for (size_t i = 0; i < missing.count; i++) {
+            if (vault_path_list_add(&full, "%s/data/%s", mount, missing.items[i]) != 0) {
+                vault_path_list_free(&full);
+                goto done;
+            }
+        }
+        vault_prefetch_ctx_t ctx = {mount, &full, NULL, NULL, 0, max_keys, &key_count, stats};
+        int run = vault_multi_run(client, (const char *const *)full.items, full.count, NULL, VAULT_ENDPOINT_KV_DATA,
+                                  vault_prefetch_data_done, &ctx);
+        vault_path_list_free(&full);
+        if (run != 0) goto done;
+    }
+    rc = stats->failed == 0 ? 0 : -1;
+    
+done:
+    stats->elapsed_ms = (double)(vault_metrics_now_ns() - start) / 1e6;
+    VAULT_LOG_INFO("📥 Prefetch %s/%s: %zu keys (%zu LIST, %zu fetched, %zu unchanged, %zu failed%s) in %.1f ms",
+                   mount, prefix ? prefix : "", stats->keys, stats->lists, stats->fetched, stats->unchanged,
+                   stats->failed, stats->truncated ? ", truncated" : "", stats->elapsed_ms);
+    vault_path_list_free(&level);
+    vault_path_list_free(&next_level);
+    vault_path_list_free(&leaves);
+    vault_path_list_free(&missing);
+    vault_path_list_free(&cached);
+    vault_path_list_free(&changed);
+    return rc;
 }
 
 // 토큰 유효성 확인
 int vault_is_token_valid(vault_client_t *client) {
-    if (!client || !client->token[0]) return 0;
-    
-    time_t now = time(NULL);
-    time_t total_ttl = client->token_expiry - client->token_issued;
-    time_t elapsed = now - client->token_issued;
-    time_t renewal_point = total_ttl * 4 / 5;  // 4/5 지점에서 갱신 필요
-    
-    return (elapsed < renewal_point);
+    vault_token_t *token = vault_token_acquire(client);
+    if (!token) return 0;
+    
+    // 갱신 구간 내에서 정해진 갱신 시각 전까지 유효
+    // batch 토큰의 renewal_at은 재로그인 마감 시각 (만료 - HTTP 타임아웃 이전)이므로
+    // 이 시각이 지나면 연장 수단 없이 만료를 향해 가는 토큰으로 간주
+    int valid = (time(NULL) < token->renewal_at);
+    vault_token_release(token);
+    return valid;
 }
 
 // 토큰 남은 시간 출력
 void vault_print_token_status(vault_client_t *client) {
-    if (!client || !client->token[0] || !client->config) return;
+    if (!client || !client->config) return;
+    
+    vault_token_t *token = vault_token_acquire(client);
+    if (!token) return;
     
     time_t now = time(NULL);
-    time_t remaining = client->token_expiry - now;
+    time_t remaining = token->expiry - now;
     
     if (remaining > 0) {
-        printf("Token status: %ld seconds remaining (expires in %ld minutes)\n", 
-               remaining, remaining / 60);
+        VAULT_LOG_INFO("Token status: %ld seconds remaining (expires in %ld minutes)", 
+                       remaining, remaining / 60);
         
-        // 갱신 권장 시점 계산 (4/5 지점 기준)
-        time_t total_ttl = client->token_expiry - client->token_issued;
-        time_t elapsed = time(NULL) - client->token_issued;
-        time_t renewal_point = total_ttl * 4 / 5;  // 4/5 지점
+        // 갱신 권장 시점 계산 (갱신 구간 내 무작위 시각 기준)
+        time_t total_ttl = token->expiry - token->issued;
+        time_t elapsed = now - token->issued;
+        time_t renewal_point = token->renewal_at - token->issued;
         time_t urgent_point = total_ttl * 9 / 10;  // 9/10 지점
         
         if (elapsed >= urgent_point) {
-            printf("⚠️  URGENT: Token should be renewed soon (at %ld%% of TTL)\n", 
-                   (elapsed * 100) / total_ttl);
+            VAULT_LOG_WARN("⚠️  URGENT: Token should be renewed soon (at %ld%% of TTL)", 
+                           (elapsed * 100) / total_ttl);
         } else if (elapsed >= renewal_point) {
-            printf("🔄 Token renewal recommended (at %ld%% of TTL)\n", 
-                   (elapsed * 100) / total_ttl);
+            VAULT_LOG_INFO("🔄 Token %s recommended (at %ld%% of TTL)", 
+                           token->renewable ? "renewal" : "re-login", (elapsed * 100) / total_ttl);
         } else {
-            printf("✅ Token is healthy (at %ld%% of TTL)\n", 
-                   (elapsed * 100) / total_ttl);
+            VAULT_LOG_INFO("✅ Token is healthy (at %ld%% of TTL)", 
+                           (elapsed * 100) / total_ttl);
         }
     } else {
-        printf("❌ Token has expired!\n");
+        VAULT_LOG_INFO("❌ Token has expired!");
     }
+    
+    vault_token_release(token);
 }
 
 // 시크릿 데이터 정리
@@ -420,20 +1609,55 @@ void vault_cleanup_secret(json_object *secret_data) {
     }
 }
 
+// KV 응답에서 필드 맵(data.data) 추출
+static json_object *vault_kv_fields(json_object *secret) {
+    json_object *data, *fields;
+    if (json_object_object_get_ex(secret, "data", &data) &&
+        json_object_object_get_ex(data, "data", &fields)) {
+        return fields;
+    }
+    return NULL;
+}
+
+// 캐시된 시크릿을 호출자 전용 복사본으로 반환
+// json-c의 참조 카운트는 원자적이지 않으므로 캐시 객체의 참조를 여러 스레드에 나눠 주지 않고,
+// 읽기 잠금 아래에서 깊은 복사하여 호출자가 어느 스레드에서든 해제할 수 있게 합니다.
+static int vault_cache_copy(vault_client_t *client, json_object *const *slot, json_object **secret_data) {
+    int rc = -1;
+    *secret_data = NULL;
+    
+    pthread_rwlock_rdlock(&client->cache_lock);
+    if (*slot && json_object_deep_copy(*slot, secret_data, NULL) == 0) {
+        rc = 0;
+    }
+    pthread_rwlock_unlock(&client->cache_lock);
+    return rc;
+}
+
+// 캐시 존재 여부 (읽기 잠금)
+static int vault_cache_present(vault_client_t *client, json_object *const *slot) {
+    pthread_rwlock_rdlock(&client->cache_lock);
+    int present = *slot != NULL;
+    pthread_rwlock_unlock(&client->cache_lock);
+    return present;
+}
+
 // KV 시크릿 갱신 (버전 기반)
-int vault_refresh_kv_secret(vault_client_t *client) {
+static int vault_refresh_kv_secret_impl(vault_client_t *client) {
     if (!client || !client->config || !client->config->secret_kv.enabled) {
         return -1;
     }
     
     if (!client->kv_path[0]) {
-        fprintf(stderr, "KV path not configured\n");
+        VAULT_LOG_ERROR("KV path not configured");
         return -1;
     }
     
-    printf("🔄 Refreshing KV secret from path: %s\n", client->kv_path);
+    // 같은 시크릿의 갱신은 한 번에 하나만 (메인 루프와 갱신 스레드가 동시에 요청할 수 있음)
+    pthread_mutex_lock(&client->refresh_lock[VAULT_CACHE_KV]);
+    VAULT_LOG_INFO("🔄 Refreshing KV secret from path: %s", client->kv_path);
     
-    // 새로운 시크릿 가져오기 (전체 응답을 위해 직접 HTTP 요청)
+    // 새로운 시크릿 가져오기 (전체 응답을 위해 직접 HTTP 요청, 캐시 잠금 없이)
     json_object *new_secret = NULL;
     int result = vault_get_kv_secret_direct(client, &new_secret);
     
@@ -450,51 +1674,66 @@ int vault_refresh_kv_secret(vault_client_t *client) {
         }
         
         // 버전이 다르거나 캐시가 없는 경우에만 업데이트
+        pthread_rwlock_wrlock(&client->cache_lock);
         if (new_version != client->kv_version) {
-            // 기존 캐시 정리
-            vault_cleanup_kv_cache(client);
+            // 이전 캐시는 변경 알림용 스냅샷으로 넘겨받음 (첫 조회는 알리지 않음)
+            json_object *old_secret = client->cached_kv_secret;
+            int old_version = client->kv_version;
             
             // 캐시 업데이트
             client->cached_kv_secret = json_object_get(new_secret);
             client->kv_last_refresh = time(NULL);
             client->kv_version = new_version;
+            pthread_rwlock_unlock(&client->cache_lock);
+            
+            VAULT_LOG_INFO("✅ KV secret updated (version: %d)", new_version);
+            vault_metrics_record_refresh(VAULT_CACHE_KV, VAULT_REFRESH_UPDATED);
             
-            printf("✅ KV secret updated (version: %d)\n", new_version);
+            if (old_secret) {
+                vault_subscriptions_notify(&client->subscriptions, VAULT_CACHE_KV,
+                                           vault_kv_fields(old_secret), vault_kv_fields(new_secret),
+                                           old_version, new_version, NULL);
+                json_object_put(old_secret);
+            }
         } else {
-            printf("✅ KV secret unchanged (version: %d)\n", new_version);
             client->kv_last_refresh = time(NULL);  // 마지막 확인 시간 업데이트
+            pthread_rwlock_unlock(&client->cache_lock);
+            VAULT_LOG_INFO("✅ KV secret unchanged (version: %d)", new_version);
+            vault_metrics_record_refresh(VAULT_CACHE_KV, VAULT_REFRESH_UNCHANGED);
         }
         
-        // 임시 객체 정리
+        // 임시 참조 정리 (캐시가 참조 하나를 유지)
         json_object_put(new_secret);
+        pthread_mutex_unlock(&client->refresh_lock[VAULT_CACHE_KV]);
         return 0;
     } else {
-        fprintf(stderr, "❌ Failed to refresh KV secret\n");
+        VAULT_LOG_ERROR("❌ Failed to refresh KV secret");
+        vault_metrics_record_refresh(VAULT_CACHE_KV, VAULT_REFRESH_FAILED);
+        pthread_mutex_unlock(&client->refresh_lock[VAULT_CACHE_KV]);
         return -1;
     }
 }
 
 // KV 시크릿 가져오기 (캐시 확인)
-int vault_get_kv_secret(vault_client_t *client, json_object **secret_data) {
+static int vault_get_kv_secret_impl(vault_client_t *client, json_object **secret_data) {
     if (!client || !secret_data || !client->config || !client->config->secret_kv.enabled) {
         return -1;
     }
     
+    vault_cache_result_t lookup = !vault_cache_present(client, &client->cached_kv_secret) ? VAULT_CACHE_MISS :
+                                  vault_is_kv_secret_stale(client) ? VAULT_CACHE_STALE : VAULT_CACHE_HIT;
+    vault_metrics_record_cache(VAULT_CACHE_KV, lookup);
+    
     // 캐시가 없거나 오래된 경우 갱신
-    if (!client->cached_kv_secret || vault_is_kv_secret_stale(client)) {
-        printf("🔄 KV cache is stale, refreshing...\n");
+    if (lookup != VAULT_CACHE_HIT) {
+        VAULT_LOG_INFO("🔄 KV cache is stale, refreshing...");
         if (vault_refresh_kv_secret(client) != 0) {
             return -1;
         }
     }
     
-    // 캐시된 데이터 반환
-    if (client->cached_kv_secret) {
-        *secret_data = json_object_get(client->cached_kv_secret);
-        return 0;
-    }
-    
-    return -1;
+    // 캐시된 데이터 반환 (호출자 전용 복사본)
+    return vault_cache_copy(client, &client->cached_kv_secret, secret_data);
 }
 
 // KV 시크릿이 오래되었는지 확인 (버전 기반)
@@ -504,7 +1743,7 @@ int vault_is_kv_secret_stale(vault_client_t *client) {
     }
     
     // 캐시가 없으면 항상 갱신 필요
-    if (!client->cached_kv_secret) {
+    if (!vault_cache_present(client, &client->cached_kv_secret)) {
         return 1;
     }
     
@@ -515,114 +1754,298 @@ int vault_is_kv_secret_stale(vault_client_t *client) {
 
 // KV 캐시 정리
 void vault_cleanup_kv_cache(vault_client_t *client) {
-    if (client && client->cached_kv_secret) {
-        json_object_put(client->cached_kv_secret);
-        client->cached_kv_secret = NULL;
-        client->kv_last_refresh = 0;
-        client->kv_version = -1;  // 버전도 초기화
+    if (!client) return;
+    
+    pthread_rwlock_wrlock(&client->cache_lock);
+    json_object *old_secret = client->cached_kv_secret;
+    client->cached_kv_secret = NULL;
+    client->kv_last_refresh = 0;
+    client->kv_version = -1;  // 버전도 초기화
+    pthread_rwlock_unlock(&client->cache_lock);
+    
+    if (old_secret) {
+        json_object_put(old_secret);
+    }
+}
+
+// Database Dynamic 캐시를 비우고 이전 객체를 반환 (호출자가 해제)
+static json_object *vault_take_db_dynamic_cache(vault_client_t *client) {
+    pthread_rwlock_wrlock(&client->cache_lock);
+    json_object *old_secret = client->cached_db_dynamic_secret;
+    client->cached_db_dynamic_secret = NULL;
+    client->db_dynamic_last_refresh = 0;
+    client->lease_id[0] = '\0';
+    client->lease_expiry = 0;
+    pthread_rwlock_unlock(&client->cache_lock);
+    return old_secret;
+}
+
+// 자격증명 풀 크기 (0이면 풀 미사용)
+static int vault_db_pool_size(const vault_client_t *client) {
+    int size = client->config->secret_database_dynamic.pool_size;
+    if (size <= 0) return 0;
+    return size > VAULT_DB_POOL_MAX_SIZE ? VAULT_DB_POOL_MAX_SIZE : size;
+}
+
+// 풀 자격증명 하나 발급
+// 교체 시각은 lease 수명에서 유예 시간을 뺀 구간의 rotate_num/rotate_den 지점
+// (처음 채울 때 1/N, 2/N, ... N/N으로 엇갈리게 두면 이후 교체도 같은 간격으로 유지됨)
+static int vault_db_pool_mint(vault_client_t *client, int rotate_num, int rotate_den) {
+    json_object *secret = NULL;
+    if (vault_get_db_dynamic_secret_direct(client, &secret) != 0) return -1;
+    
+    json_object *lease_id_obj, *duration_obj;
+    const char *lease_id = json_object_object_get_ex(secret, "lease_id", &lease_id_obj) ?
+                           json_object_get_string(lease_id_obj) : NULL;
+    long ttl = json_object_object_get_ex(secret, "lease_duration", &duration_obj) ?
+               (long)json_object_get_int64(duration_obj) : 0;
+    if (!lease_id || !lease_id[0] || ttl <= 0) {
+        VAULT_LOG_ERROR("Database Dynamic response has no lease (lease_duration: %ld)", ttl);
+        json_object_put(secret);
+        return -1;
+    }
+    
+    // 유예 시간이 lease 수명의 절반을 넘으면 절반으로 줄임
+    long grace = client->config->secret_database_dynamic.pool_drain_grace;
+    if (grace < 0) grace = 0;
+    if (grace > ttl / 2) grace = ttl / 2;
+    time_t now = time(NULL);
+    time_t rotate_at = now + (ttl - grace) * rotate_num / rotate_den;
+    if (vault_db_pool_add(&client->db_pool, lease_id, secret, now, now + ttl, rotate_at) == 0) return -1;
+    
+    VAULT_LOG_DEBUG("Pooled Database Dynamic credential minted (TTL: %ld seconds, rotation in %ld seconds)",
+                    ttl, (long)(rotate_at - now));
+    return 0;
+}
+
+// 자격증명 풀 유지: 유예 시간이 지난 자격증명 폐기 → 교체 시각이 된 자격증명 교체 → 부족분 채우기
+// 교체는 새 자격증명을 먼저 발급하므로 발급에 실패해도 이전 자격증명이 만료 전까지 계속 배정됩니다.
+static int vault_db_pool_maintain(vault_client_t *client) {
+    int size = vault_db_pool_size(client);
+    int grace = client->config->secret_database_dynamic.pool_drain_grace;
+    int minted = 0, failed = 0;
+    
+    pthread_mutex_lock(&client->refresh_lock[VAULT_CACHE_DB_DYNAMIC]);
+    
+    // 1. 폐기 (폐기 요청이 실패해도 lease는 TTL 만료로 회수됨)
+    char lease_id[512];
+    int revoke = 0;
+    size_t revoked = 0;
+    while (vault_db_pool_take_drained(&client->db_pool, time(NULL), lease_id, sizeof(lease_id), &revoke) == 0) {
+        if (!revoke) continue;
+        if (vault_revoke_lease(client, lease_id) != 0) {
+            VAULT_LOG_WARN("⚠️ Failed to revoke drained Database Dynamic lease, leaving it to expire");
+        } else {
+            revoked++;
+        }
+    }
+    
+    // 2. 교체
+    unsigned long due;
+    while ((due = vault_db_pool_due(&client->db_pool, time(NULL))) != 0) {
+        if (vault_db_pool_mint(client, 1, 1) != 0) {
+            failed++;
+            break;
+        }
+        minted++;
+        vault_db_pool_retire(&client->db_pool, due, time(NULL) + grace);
+    }
+    
+    // 3. 부족분 채우기 (기동, 풀 크기 변경, 발급 실패 후)
+    for (size_t active = vault_db_pool_active(&client->db_pool); !failed && active < (size_t)size; active++) {
+        if (vault_db_pool_mint(client, (int)active + 1, size) != 0) {
+            failed++;
+            break;
+        }
+        minted++;
     }
+    
+    pthread_mutex_unlock(&client->refresh_lock[VAULT_CACHE_DB_DYNAMIC]);
+    
+    if (minted > 0 || revoked > 0 || failed > 0) {
+        vault_db_pool_stats_t stats;
+        vault_db_pool_get_stats(&client->db_pool, &stats);
+        VAULT_LOG_INFO("🔁 Database Dynamic pool: %zu active, %zu draining (%d minted, %zu revoked%s)",
+                       stats.active, stats.draining, minted, revoked, failed ? ", issuance failed" : "");
+    }
+    vault_metrics_record_refresh(VAULT_CACHE_DB_DYNAMIC, failed ? VAULT_REFRESH_FAILED :
+                                 minted > 0 ? VAULT_REFRESH_UPDATED : VAULT_REFRESH_UNCHANGED);
+    return failed ? -1 : 0;
+}
+
+int vault_db_checkout(vault_client_t *client, json_object **secret_data, unsigned long *id) {
+    if (!client || !secret_data) return -1;
+    return vault_db_pool_checkout(&client->db_pool, secret_data, id);
+}
+
+void vault_db_checkin(vault_client_t *client, unsigned long id) {
+    if (client) vault_db_pool_checkin(&client->db_pool, id);
+}
+
+int vault_db_is_retired(vault_client_t *client, unsigned long id) {
+    return client ? vault_db_pool_is_retired(&client->db_pool, id) : 1;
 }
 
 // Database Dynamic 시크릿 갱신
-int vault_refresh_db_dynamic_secret(vault_client_t *client) {
+static int vault_refresh_db_dynamic_secret_impl(vault_client_t *client) {
     if (!client || !client->config || !client->config->secret_database_dynamic.enabled) {
         return -1;
     }
     
+    if (vault_db_pool_size(client) > 0) {
+        return vault_db_pool_maintain(client);
+    }
+    
     if (!client->db_dynamic_path[0]) {
-        fprintf(stderr, "Database Dynamic path not configured\n");
+        VAULT_LOG_ERROR("Database Dynamic path not configured");
         return -1;
     }
     
-    printf("🔄 Refreshing Database Dynamic secret from path: %s\n", client->db_dynamic_path);
+    // 같은 시크릿의 갱신은 한 번에 하나만 (동시에 갱신하면 자격증명이 중복 발급됨)
+    pthread_mutex_lock(&client->refresh_lock[VAULT_CACHE_DB_DYNAMIC]);
+    VAULT_LOG_INFO("🔄 Refreshing Database Dynamic secret from path: %s", client->db_dynamic_path);
     
     // 기존 캐시가 있는 경우 TTL 확인
-    if (client->cached_db_dynamic_secret && strlen(client->lease_id) > 0) {
+    char lease_id[sizeof(client->lease_id)];
+    pthread_rwlock_rdlock(&client->cache_lock);
+    int cached = client->cached_db_dynamic_secret != NULL;
+    memcpy(lease_id, client->lease_id, sizeof(lease_id));
+    pthread_rwlock_unlock(&client->cache_lock);
+    
+    if (cached && lease_id[0]) {
         time_t expire_time;
         int ttl;
-        if (vault_check_lease_status(client, client->lease_id, &expire_time, &ttl) == 0) {
+        if (vault_check_lease_status(client, lease_id, &expire_time, &ttl) == 0) {
             // TTL이 충분히 남아있으면 갱신하지 않음
             if (ttl > 10) {  // 10초 이상 남아있으면 갱신하지 않음
-                printf("✅ Database Dynamic secret is still valid (TTL: %d seconds)\n", ttl);
+                VAULT_LOG_INFO("✅ Database Dynamic secret is still valid (TTL: %d seconds)", ttl);
+                pthread_rwlock_wrlock(&client->cache_lock);
                 client->db_dynamic_last_refresh = time(NULL);
+                pthread_rwlock_unlock(&client->cache_lock);
+                vault_metrics_record_refresh(VAULT_CACHE_DB_DYNAMIC, VAULT_REFRESH_UNCHANGED);
+                pthread_mutex_unlock(&client->refresh_lock[VAULT_CACHE_DB_DYNAMIC]);
                 return 0;
             } else {
-                printf("⚠️ Database Dynamic secret expiring soon (TTL: %d seconds), creating new credentials\n", ttl);
+                VAULT_LOG_WARN("⚠️ Database Dynamic secret expiring soon (TTL: %d seconds), creating new credentials", ttl);
             }
         }
     }
     
-    // 기존 캐시 정리
-    vault_cleanup_db_dynamic_cache(client);
-    
     // 새로운 Database Dynamic 시크릿 생성
     json_object *new_secret = NULL;
     int result = vault_get_db_dynamic_secret_direct(client, &new_secret);
     
     if (result == 0 && new_secret) {
-        // lease_id 추출
+        // lease_id 추출 및 만료 시간 확인
+        lease_id[0] = '\0';
         json_object *lease_id_obj;
         if (json_object_object_get_ex(new_secret, "lease_id", &lease_id_obj)) {
-            const char *lease_id = json_object_get_string(lease_id_obj);
-            strncpy(client->lease_id, lease_id, sizeof(client->lease_id) - 1);
-            client->lease_id[sizeof(client->lease_id) - 1] = '\0';
+            snprintf(lease_id, sizeof(lease_id), "%s", json_object_get_string(lease_id_obj));
+        }
+        time_t expire_time = 0;
+        int ttl = 0;
+        if (lease_id[0] && vault_check_lease_status(client, lease_id, &expire_time, &ttl) != 0) {
+            expire_time = 0;
         }
         
-        // 캐시 업데이트
+        // 캐시 교체 (이전 캐시는 변경 알림용 스냅샷으로 넘겨받음)
+        pthread_rwlock_wrlock(&client->cache_lock);
+        json_object *old_secret = client->cached_db_dynamic_secret;
         client->cached_db_dynamic_secret = json_object_get(new_secret);
         client->db_dynamic_last_refresh = time(NULL);
+        memcpy(client->lease_id, lease_id, sizeof(client->lease_id));
+        client->lease_expiry = expire_time;
+        pthread_rwlock_unlock(&client->cache_lock);
         
-        // lease 만료 시간 확인
-        time_t expire_time;
-        int ttl = 0;
-        if (strlen(client->lease_id) > 0 && vault_check_lease_status(client, client->lease_id, &expire_time, &ttl) == 0) {
-            client->lease_expiry = expire_time;
-        }
+        VAULT_LOG_INFO("✅ Database Dynamic secret created successfully (TTL: %d seconds)", ttl);
+        vault_metrics_record_refresh(VAULT_CACHE_DB_DYNAMIC, VAULT_REFRESH_UPDATED);
         
-        printf("✅ Database Dynamic secret created successfully (TTL: %d seconds)\n", ttl);
+        // 새 lease 알림
+        if (old_secret) {
+            json_object *old_data = NULL, *new_data = NULL;
+            json_object_object_get_ex(old_secret, "data", &old_data);
+            json_object_object_get_ex(new_secret, "data", &new_data);
+            vault_subscriptions_notify(&client->subscriptions, VAULT_CACHE_DB_DYNAMIC,
+                                       old_data, new_data, -1, -1, NULL);
+            json_object_put(old_secret);
+        }
         
-        // 임시 객체 정리
+        // 임시 참조 정리 (캐시가 참조 하나를 유지)
         json_object_put(new_secret);
+        pthread_mutex_unlock(&client->refresh_lock[VAULT_CACHE_DB_DYNAMIC]);
         return 0;
     } else {
-        fprintf(stderr, "❌ Failed to refresh Database Dynamic secret\n");
+        // 만료 직전이거나 확인할 수 없는 이전 자격증명은 더 이상 제공하지 않음
+        json_object *old_secret = vault_take_db_dynamic_cache(client);
+        if (old_secret) {
+            json_object_put(old_secret);
+        }
+        VAULT_LOG_ERROR("❌ Failed to refresh Database Dynamic secret");
+        vault_metrics_record_refresh(VAULT_CACHE_DB_DYNAMIC, VAULT_REFRESH_FAILED);
+        pthread_mutex_unlock(&client->refresh_lock[VAULT_CACHE_DB_DYNAMIC]);
         return -1;
     }
 }
 
 // Database Dynamic 시크릿 가져오기 (캐시 확인)
-int vault_get_db_dynamic_secret(vault_client_t *client, json_object **secret_data) {
+static int vault_get_db_dynamic_secret_impl(vault_client_t *client, json_object **secret_data) {
     if (!client || !secret_data || !client->config || !client->config->secret_database_dynamic.enabled) {
         return -1;
     }
     
-    // 캐시가 없거나 오래된 경우 갱신
-    if (!client->cached_db_dynamic_secret || vault_is_db_dynamic_secret_stale(client)) {
-        printf("🔄 Database Dynamic cache is stale, refreshing...\n");
-        if (vault_refresh_db_dynamic_secret(client) != 0) {
+    // 풀 모드: 가장 최근에 발급된 자격증명 (풀이 비어 있을 때만 발급을 기다림)
+    if (vault_db_pool_size(client) > 0) {
+        if (vault_db_pool_peek(&client->db_pool, secret_data) == 0) {
+            vault_metrics_record_cache(VAULT_CACHE_DB_DYNAMIC, VAULT_CACHE_HIT);
+            return 0;
+        }
+        vault_metrics_record_cache(VAULT_CACHE_DB_DYNAMIC, VAULT_CACHE_MISS);
+        if (vault_refresh_db_dynamic_secret(client) != 0 && vault_db_pool_active(&client->db_pool) == 0) {
             return -1;
         }
+        return vault_db_pool_peek(&client->db_pool, secret_data);
     }
     
-    // 캐시된 데이터 반환
-    if (client->cached_db_dynamic_secret) {
-        *secret_data = json_object_get(client->cached_db_dynamic_secret);
-        return 0;
+    vault_cache_result_t lookup = !vault_cache_present(client, &client->cached_db_dynamic_secret) ? VAULT_CACHE_MISS :
+                                  vault_is_db_dynamic_secret_stale(client) ? VAULT_CACHE_STALE : VAULT_CACHE_HIT;
+    vault_metrics_record_cache(VAULT_CACHE_DB_DYNAMIC, lookup);
+    
+    // 캐시가 없거나 오래된 경우 갱신
+    if (lookup != VAULT_CACHE_HIT) {
+        VAULT_LOG_INFO("🔄 Database Dynamic cache is stale, refreshing...");
+        if (vault_refresh_db_dynamic_secret(client) != 0) {
+            return -1;
+        }
     }
     
-    return -1;
+    // 캐시된 데이터 반환 (호출자 전용 복사본)
+    return vault_cache_copy(client, &client->cached_db_dynamic_secret, secret_data);
 }
 
 // Database Dynamic 시크릿이 오래되었는지 확인
 int vault_is_db_dynamic_secret_stale(vault_client_t *client) {
-    if (!client || !client->config || !client->cached_db_dynamic_secret) {
+    if (!client || !client->config) {
+        return 1;
+    }
+    if (vault_db_pool_size(client) > 0) {
+        return vault_db_pool_active(&client->db_pool) == 0;
+    }
+    
+    char lease_id[sizeof(client->lease_id)];
+    pthread_rwlock_rdlock(&client->cache_lock);
+    int cached = client->cached_db_dynamic_secret != NULL;
+    memcpy(lease_id, client->lease_id, sizeof(lease_id));
+    time_t last_refresh = client->db_dynamic_last_refresh;
+    pthread_rwlock_unlock(&client->cache_lock);
+    
+    if (!cached) {
         return 1;  // 캐시가 없으면 오래된 것으로 간주
     }
     
     // lease 상태 확인
     time_t expire_time;
     int ttl;
-    if (vault_check_lease_status(client, client->lease_id, &expire_time, &ttl) == 0) {
+    if (vault_check_lease_status(client, lease_id, &expire_time, &ttl) == 0) {
         // Database Dynamic Secret은 TTL이 거의 만료될 때만 갱신 (10초 이하)
         int renewal_threshold = 10;  // 10초 이하일 때 갱신
         return (ttl <= renewal_threshold);
@@ -630,59 +2053,106 @@ int vault_is_db_dynamic_secret_stale(vault_client_t *client) {
     
     // lease 상태 확인 실패 시 기본 갱신 간격 사용
     time_t now = time(NULL);
-    time_t elapsed = now - client->db_dynamic_last_refresh;
+    time_t elapsed = now - last_refresh;
     int refresh_interval = client->config->secret_kv.refresh_interval; // KV와 동일한 간격 사용
     
     return (elapsed >= refresh_interval);
 }
 
+// Lease 폐기 (sys/leases/revoke, 풀에서 유예 시간이 지난 자격증명 정리용)
+int vault_revoke_lease(vault_client_t *client, const char *lease_id) {
+    if (!client || !lease_id || !lease_id[0]) {
+        return -1;
+    }
+    
+    struct http_response *response = NULL;
+    CURL *curl = vault_request_begin(client, &response);
+    if (!curl) {
+        VAULT_LOG_ERROR("Failed to initialize CURL for lease revocation");
+        return -1;
+    }
+    
+    char url[512];
+    snprintf(url, sizeof(url), "%s/v1/sys/leases/revoke", client->vault_url);
+    curl_easy_setopt(curl, CURLOPT_URL, url);
+    
+    vault_token_t *token = vault_token_acquire(client);
+    if (!token) {
+        VAULT_LOG_ERROR("Not logged in to Vault");
+        return -1;
+    }
+    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, token->json_headers);
+    
+    char post_data[1024];
+    snprintf(post_data, sizeof(post_data), "{\"lease_id\":\"%s\"}", lease_id);
+    curl_easy_setopt(curl, CURLOPT_POSTFIELDS, post_data);
+    curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, strlen(post_data));
+    curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, "PUT");
+    
+    CURLcode res = vault_perform(client, curl, VAULT_ENDPOINT_OTHER, response);
+    vault_token_release(token);
+    
+    if (res != CURLE_OK) {
+        VAULT_LOG_ERROR("Lease revocation failed: %s", curl_easy_strerror(res));
+        return -1;
+    }
+    long http_code;
+    curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &http_code);
+    if (http_code != 204 && http_code != 200) {
+        VAULT_LOG_ERROR("Lease revocation failed with HTTP %ld", http_code);
+        return -1;
+    }
+    return 0;
+}
+
 // Lease 상태 확인
 int vault_check_lease_status(vault_client_t *client, const char *lease_id, time_t *expire_time, int *ttl) {
     if (!client || !lease_id || !expire_time || !ttl) {
         return -1;
     }
     
-    // HTTP 요청 설정
-    struct http_response response = {0};
-    curl_easy_setopt(client->curl, CURLOPT_WRITEFUNCTION, write_callback);
-    curl_easy_setopt(client->curl, CURLOPT_WRITEDATA, &response);
-    curl_easy_setopt(client->curl, CURLOPT_HTTPGET, 1L);
+    // 스레드별 요청 핸들 준비 (lease 조회는 메인 루프와 갱신 스레드에서 동시에 호출됨)
+    struct http_response *response = NULL;
+    CURL *curl = vault_request_begin(client, &response);
+    if (!curl) {
+        VAULT_LOG_ERROR("Failed to initialize CURL for lease lookup");
+        return -1;
+    }
+    curl_easy_setopt(curl, CURLOPT_HTTPGET, 1L);
     
     // URL 설정
     char url[512];
     snprintf(url, sizeof(url), "%s/v1/sys/leases/lookup", client->vault_url);
-    curl_easy_setopt(client->curl, CURLOPT_URL, url);
+    curl_easy_setopt(curl, CURLOPT_URL, url);
     
     // Authorization 헤더 설정
-    char auth_header[1024];
-    snprintf(auth_header, sizeof(auth_header), "X-Vault-Token: %s", client->token);
-    struct curl_slist *headers = NULL;
-    headers = curl_slist_append(headers, auth_header);
-    headers = curl_slist_append(headers, "Content-Type: application/json");
-    curl_easy_setopt(client->curl, CURLOPT_HTTPHEADER, headers);
+    vault_token_t *token = vault_token_acquire(client);
+    if (!token) {
+        VAULT_LOG_ERROR("Not logged in to Vault");
+        return -1;
+    }
+    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, token->json_headers);
     
     // POST 데이터 설정
     char post_data[1024];
     snprintf(post_data, sizeof(post_data), "{\"lease_id\":\"%s\"}", lease_id);
-    curl_easy_setopt(client->curl, CURLOPT_POSTFIELDS, post_data);
-    curl_easy_setopt(client->curl, CURLOPT_POSTFIELDSIZE, strlen(post_data));
-    curl_easy_setopt(client->curl, CURLOPT_CUSTOMREQUEST, "POST");
+    curl_easy_setopt(curl, CURLOPT_POSTFIELDS, post_data);
+    curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, strlen(post_data));
+    curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, "POST");
     
     // 요청 실행
-    CURLcode res = curl_easy_perform(client->curl);
-    curl_slist_free_all(headers);
+    CURLcode res = vault_perform(client, curl, VAULT_ENDPOINT_LEASE_LOOKUP, response);
+    vault_token_release(token);
     
     if (res != CURLE_OK) {
-        fprintf(stderr, "Lease status check failed: %s\n", curl_easy_strerror(res));
-        free(response.data);
+        VAULT_LOG_ERROR("Lease status check failed: %s", curl_easy_strerror(res));
         return -1;
     }
     
     // 응답 파싱
-    json_object *json_response = json_tokener_parse(response.data);
+    json_object *json_response = response->data ? json_tokener_parse(response->data) : NULL;  // 빈 응답(연결 끊김 등)은 파싱 실패로 처리
     if (!json_response) {
-        fprintf(stderr, "Failed to parse lease status response\n");
-        free(response.data);
+        VAULT_LOG_ERROR("Failed to parse lease status response");
         return -1;
     }
     
@@ -697,11 +2167,9 @@ int vault_check_lease_status(vault_client_t *client, const char *lease_id, time_
         *expire_time = time(NULL) + *ttl;
         
         json_object_put(json_response);
-        free(response.data);
         return 0;
     }
     json_object_put(json_response);
-    free(response.data);
     return -1;
 }
 
@@ -709,70 +2177,62 @@ int vault_check_lease_status(vault_client_t *client, const char *lease_id, time_
 int vault_get_db_dynamic_secret_direct(vault_client_t *client, json_object **secret_data) {
     if (!client || !secret_data) return -1;
     
-    // HTTP 요청 설정 (Database Dynamic Secret은 GET 요청)
-    struct http_response response = {0};
-    curl_easy_setopt(client->curl, CURLOPT_WRITEFUNCTION, write_callback);
-    curl_easy_setopt(client->curl, CURLOPT_WRITEDATA, &response);
-    curl_easy_setopt(client->curl, CURLOPT_HTTPGET, 1L);
-    
-    // URL 설정
-    char url[512];
-    snprintf(url, sizeof(url), "%s/v1/%s", client->vault_url, client->db_dynamic_path);
-    curl_easy_setopt(client->curl, CURLOPT_URL, url);
+    vault_token_t *token = vault_token_acquire(client);
+    if (!token) {
+        VAULT_LOG_ERROR("Not logged in to Vault");
+        return -1;
+    }
     
-    // Authorization 헤더 설정
-    char auth_header[1024];
-    snprintf(auth_header, sizeof(auth_header), "X-Vault-Token: %s", client->token);
-    struct curl_slist *headers = NULL;
-    headers = curl_slist_append(headers, auth_header);
-    curl_easy_setopt(client->curl, CURLOPT_HTTPHEADER, headers);
+    // 스레드별 요청 핸들 준비 (Database Dynamic Secret은 GET 요청, URL/헤더는 템플릿과 토큰 레코드에 미리 구성)
+    struct http_response *response = NULL;
+    CURL *curl = vault_request_begin_template(client, &client->db_dynamic_request, token, &response);
+    if (!curl) {
+        VAULT_LOG_ERROR("Failed to initialize CURL for Database Dynamic secret");
+        vault_token_release(token);
+        return -1;
+    }
     
     // 요청 실행
-    CURLcode res = curl_easy_perform(client->curl);
-    curl_slist_free_all(headers);
+    CURLcode res = vault_perform(client, curl, client->db_dynamic_request.endpoint, response);
+    vault_token_release(token);
     
     if (res != CURLE_OK) {
-        fprintf(stderr, "Database Dynamic secret request failed: %s\n", curl_easy_strerror(res));
-        free(response.data);
+        VAULT_LOG_ERROR("Database Dynamic secret request failed: %s", curl_easy_strerror(res));
         return -1;
     }
     
     // HTTP 상태 코드 확인
     long http_code;
-    curl_easy_getinfo(client->curl, CURLINFO_RESPONSE_CODE, &http_code);
+    curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &http_code);
     
     // 응답 파싱
-    json_object *json_response = json_tokener_parse(response.data);
+    json_object *json_response = response->data ? json_tokener_parse(response->data) : NULL;  // 빈 응답(연결 끊김 등)은 파싱 실패로 처리
     if (!json_response) {
-        fprintf(stderr, "Failed to parse Database Dynamic secret response\n");
-        printf("Raw response: %s\n", response.data);
-        free(response.data);
+        VAULT_LOG_ERROR("Failed to parse Database Dynamic secret response");
+        VAULT_LOG_DEBUG("Raw response: %s", response->data);
         return -1;
     }
     
     // 오류 확인
     json_object *errors;
     if (json_object_object_get_ex(json_response, "errors", &errors)) {
-        printf("🔍 Debug: Vault returned errors:\n");
-        printf("   %s\n", json_object_to_json_string(errors));
+        VAULT_LOG_DEBUG("🔍 Debug: Vault returned errors:");
+        VAULT_LOG_DEBUG("   %s", json_object_to_json_string(errors));
     }
     
     if (http_code != 200) {
-        fprintf(stderr, "Database Dynamic secret request failed with HTTP %ld\n", http_code);
-        printf("Response: %s\n", response.data);
+        VAULT_LOG_ERROR("Database Dynamic secret request failed with HTTP %ld", http_code);
+        VAULT_LOG_DEBUG("Response: %s", response->data);
         json_object_put(json_response);
-        free(response.data);
         return -1;
     }
     
     // Database Dynamic 시크릿은 전체 응답을 반환 (KV와 달리 data.data 구조가 아님)
     *secret_data = json_object_get(json_response);
-    json_object_get(*secret_data); // 참조 카운트 증가
     
-    printf("Database Dynamic secret retrieved successfully\n");
+    VAULT_LOG_INFO("Database Dynamic secret retrieved successfully");
     
     json_object_put(json_response);
-    free(response.data);
     return 0;
 }
 
@@ -781,43 +2241,27 @@ int vault_get_db_dynamic_secret_direct(vault_client_t *client, json_object **sec
 int vault_get_kv_secret_direct(vault_client_t *client, json_object **secret_data) {
     if (!client || !secret_data) return -1;
     
-    // 새로운 CURL 핸들 생성
-    CURL *curl = curl_easy_init();
-    if (!curl) {
-        fprintf(stderr, "Failed to initialize CURL for KV secret\n");
+    vault_token_t *token = vault_token_acquire(client);
+    if (!token) {
+        VAULT_LOG_ERROR("Not logged in to Vault");
         return -1;
     }
     
-    // HTTP 요청 설정
-    struct http_response response = {0};
-    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, write_callback);
-    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &response);
-    curl_easy_setopt(curl, CURLOPT_HTTPGET, 1L);
-    curl_easy_setopt(curl, CURLOPT_TIMEOUT, client->config->http_timeout);
-    curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
-    curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 0L);
-    curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, 0L);
-    
-    // URL 설정
-    char url[512];
-    snprintf(url, sizeof(url), "%s/v1/%s", client->vault_url, client->kv_path);
-    curl_easy_setopt(curl, CURLOPT_URL, url);
-    
-    // Authorization 헤더 설정
-    char auth_header[1024];
-    snprintf(auth_header, sizeof(auth_header), "X-Vault-Token: %s", client->token);
-    struct curl_slist *headers = NULL;
-    headers = curl_slist_append(headers, auth_header);
-    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
+    // 스레드별 요청 핸들 준비 (URL/헤더는 템플릿과 토큰 레코드에 미리 구성, 압축 응답 허용, 받는 대로 파싱)
+    struct http_response *response = NULL;
+    CURL *curl = vault_request_begin_template(client, &client->kv_request, token, &response);
+    if (!curl) {
+        VAULT_LOG_ERROR("Failed to initialize CURL for KV secret");
+        vault_token_release(token);
+        return -1;
+    }
     
     // 요청 실행
-    CURLcode res = curl_easy_perform(curl);
-    curl_slist_free_all(headers);
+    CURLcode res = vault_perform(client, curl, client->kv_request.endpoint, response);
+    vault_token_release(token);
     
     if (res != CURLE_OK) {
-        fprintf(stderr, "KV secret request failed: %s\n", curl_easy_strerror(res));
-        free(response.data);
-        curl_easy_cleanup(curl);
+        VAULT_LOG_ERROR("KV secret request failed: %s", curl_easy_strerror(res));
         return -1;
     }
     
@@ -825,112 +2269,158 @@ int vault_get_kv_secret_direct(vault_client_t *client, json_object **secret_data
     long http_code;
     curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &http_code);
     if (http_code != 200) {
-        fprintf(stderr, "KV secret request failed with HTTP %ld\n", http_code);
-        printf("Response: %s\n", response.data);
-        free(response.data);
-        curl_easy_cleanup(curl);
+        VAULT_LOG_ERROR("KV secret request failed with HTTP %ld", http_code);
+        VAULT_LOG_DEBUG("Response: %s", vault_response_text(response));
         return -1;
     }
     
-    // 응답 파싱
-    json_object *json_response = json_tokener_parse(response.data);
+    // 응답 파싱 (스트리밍 파싱 결과)
+    json_object *json_response = vault_response_json(response);  // 빈 응답(연결 끊김 등)은 파싱 실패로 처리
     if (!json_response) {
-        fprintf(stderr, "Failed to parse KV secret response\n");
-        free(response.data);
-        curl_easy_cleanup(curl);
+        VAULT_LOG_ERROR("Failed to parse KV secret response");
         return -1;
     }
     
     // 오류 확인
     json_object *errors;
     if (json_object_object_get_ex(json_response, "errors", &errors)) {
-        printf("🔍 Debug: Vault returned errors:\n");
-        printf("   %s\n", json_object_to_json_string(errors));
+        VAULT_LOG_DEBUG("🔍 Debug: Vault returned errors:");
+        VAULT_LOG_DEBUG("   %s", json_object_to_json_string(errors));
         json_object_put(json_response);
-        free(response.data);
-        curl_easy_cleanup(curl);
         return -1;
     }
     
     // 전체 응답 반환 (메타데이터 포함)
     *secret_data = json_object_get(json_response);
-    json_object_get(*secret_data); // 참조 카운트 증가
     
-    printf("KV secret retrieved successfully\n");
+    VAULT_LOG_INFO("KV secret retrieved successfully");
     
     json_object_put(json_response);
-    free(response.data);
-    curl_easy_cleanup(curl);
     return 0;
 }
 
 // Database Dynamic 캐시 정리
 void vault_cleanup_db_dynamic_cache(vault_client_t *client) {
-    if (client && client->cached_db_dynamic_secret) {
-        json_object_put(client->cached_db_dynamic_secret);
-        client->cached_db_dynamic_secret = NULL;
-        client->db_dynamic_last_refresh = 0;
-        client->lease_id[0] = '\0';
-        client->lease_expiry = 0;
+    if (!client) return;
+    
+    json_object *old_secret = vault_take_db_dynamic_cache(client);
+    if (old_secret) {
+        json_object_put(old_secret);
     }
 }
 
+// Database Static 비밀번호 교체 예정 시각
+// last_vault_rotation + rotation_period를 쓰되, Vault와 시계가 어긋나 응답의 ttl(남은 초)과
+// rotation_skew 이상 차이 나면 ttl 기준으로 계산합니다. 교체 정보가 없으면 0 (고정 간격으로 확인).
+static time_t vault_db_static_rotation_at(const vault_client_t *client, json_object *secret, time_t fetched_at) {
+    json_object *obj;
+    long ttl = -1;
+    long period = 0;
+    time_t last_rotation = 0;
+    if (json_object_object_get_ex(secret, "ttl", &obj)) ttl = json_object_get_int64(obj);
+    if (json_object_object_get_ex(secret, "rotation_period", &obj)) period = json_object_get_int64(obj);
+    if (json_object_object_get_ex(secret, "last_vault_rotation", &obj)) {
+        last_rotation = vault_schedule_parse_time(json_object_get_string(obj));
+    }
+    
+    time_t by_ttl = ttl > 0 ? fetched_at + ttl : 0;
+    time_t by_period = last_rotation > 0 && period > 0 ? last_rotation + period : 0;
+    if (by_period == 0) return by_ttl;
+    if (by_ttl == 0) return by_period;
+    
+    time_t drift = by_period > by_ttl ? by_period - by_ttl : by_ttl - by_period;
+    if (drift > client->config->secret_database_static.rotation_skew) {
+        VAULT_LOG_DEBUG("Database Static rotation time differs from ttl by %ld seconds, using ttl", (long)drift);
+        return by_ttl;
+    }
+    return by_period;
+}
+
 // Database Static 시크릿 갱신
-int vault_refresh_db_static_secret(vault_client_t *client) {
+static int vault_refresh_db_static_secret_impl(vault_client_t *client) {
     if (!client || !client->config || !client->config->secret_database_static.enabled) {
         return -1;
     }
     
     if (!client->db_static_path[0]) {
-        fprintf(stderr, "Database Static path not configured\n");
+        VAULT_LOG_ERROR("Database Static path not configured");
         return -1;
     }
     
-    printf("🔄 Refreshing Database Static secret from path: %s\n", client->db_static_path);
+    // 같은 시크릿의 갱신은 한 번에 하나만
+    pthread_mutex_lock(&client->refresh_lock[VAULT_CACHE_DB_STATIC]);
+    VAULT_LOG_INFO("🔄 Refreshing Database Static secret from path: %s", client->db_static_path);
     
     // 새로운 시크릿 가져오기
     json_object *new_secret = NULL;
     int result = vault_get_db_static_secret_direct(client, &new_secret);
     
     if (result == 0 && new_secret) {
-        // 기존 캐시 정리
-        vault_cleanup_db_static_cache(client);
+        // 다음 교체 시각 (이미 지났으면 Vault가 아직 교체하지 않은 것이므로 rotation_skew 후 다시 확인)
+        time_t now = time(NULL);
+        time_t rotation_at = vault_db_static_rotation_at(client, new_secret, now);
+        if (rotation_at > 0 && rotation_at <= now) rotation_at = now;
         
-        // 캐시 업데이트
+        // 캐시 교체 (이전 캐시는 변경 알림용 스냅샷으로 넘겨받음)
+        pthread_rwlock_wrlock(&client->cache_lock);
+        json_object *old_secret = client->cached_db_static_secret;
         client->cached_db_static_secret = json_object_get(new_secret);
-        client->db_static_last_refresh = time(NULL);
+        client->db_static_last_refresh = now;
+        client->db_static_rotation_at = rotation_at;
+        pthread_rwlock_unlock(&client->cache_lock);
+        if (rotation_at > 0) {
+            VAULT_LOG_INFO("📅 Database Static next rotation in %ld seconds", (long)(rotation_at - now));
+        }
+        
+        // 비밀번호 교체 여부 판단 (매번 줄어드는 ttl은 비교에서 제외)
+        if (old_secret) {
+            static const char *const ignore[] = { "ttl", NULL };
+            size_t changed = vault_subscriptions_notify(&client->subscriptions, VAULT_CACHE_DB_STATIC,
+                                                        old_secret, new_secret, -1, -1, ignore);
+            json_object_put(old_secret);
+            if (changed == 0) {
+                VAULT_LOG_INFO("✅ Database Static secret unchanged");
+                vault_metrics_record_refresh(VAULT_CACHE_DB_STATIC, VAULT_REFRESH_UNCHANGED);
+                json_object_put(new_secret);
+                pthread_mutex_unlock(&client->refresh_lock[VAULT_CACHE_DB_STATIC]);
+                return 0;
+            }
+        }
         
-        printf("✅ Database Static secret updated\n");
+        VAULT_LOG_INFO("✅ Database Static secret updated");
+        vault_metrics_record_refresh(VAULT_CACHE_DB_STATIC, VAULT_REFRESH_UPDATED);
         
         json_object_put(new_secret);
+        pthread_mutex_unlock(&client->refresh_lock[VAULT_CACHE_DB_STATIC]);
         return 0;
     } else {
-        fprintf(stderr, "❌ Failed to refresh Database Static secret\n");
+        VAULT_LOG_ERROR("❌ Failed to refresh Database Static secret");
+        vault_metrics_record_refresh(VAULT_CACHE_DB_STATIC, VAULT_REFRESH_FAILED);
+        pthread_mutex_unlock(&client->refresh_lock[VAULT_CACHE_DB_STATIC]);
         return -1;
     }
 }
 
 // Database Static 시크릿 가져오기 (캐시 확인)
-int vault_get_db_static_secret(vault_client_t *client, json_object **secret_data) {
+static int vault_get_db_static_secret_impl(vault_client_t *client, json_object **secret_data) {
     if (!client || !secret_data) {
         return -1;
     }
     
+    vault_cache_result_t lookup = !vault_cache_present(client, &client->cached_db_static_secret) ? VAULT_CACHE_MISS :
+                                  vault_is_db_static_secret_stale(client) ? VAULT_CACHE_STALE : VAULT_CACHE_HIT;
+    vault_metrics_record_cache(VAULT_CACHE_DB_STATIC, lookup);
+    
     // 캐시가 오래되었는지 확인
-    if (vault_is_db_static_secret_stale(client)) {
-        printf("🔄 Database Static cache is stale, refreshing...\n");
+    if (lookup != VAULT_CACHE_HIT) {
+        VAULT_LOG_INFO("🔄 Database Static cache is stale, refreshing...");
         if (vault_refresh_db_static_secret(client) != 0) {
             return -1;
         }
     }
     
-    // 캐시된 시크릿 반환
-    if (client->cached_db_static_secret) {
-        *secret_data = json_object_get(client->cached_db_static_secret);
-        return 0;
-    }
-    
-    return -1;
+    // 캐시된 시크릿 반환 (호출자 전용 복사본)
+    return vault_cache_copy(client, &client->cached_db_static_secret, secret_data);
 }
 
 // Database Static 시크릿 직접 가져오기 (HTTP 요청)
@@ -939,82 +2429,55 @@ int vault_get_db_static_secret_direct(vault_client_t *client, json_object **secr
         return -1;
     }
     
-    // 별도의 CURL 핸들 생성
-    CURL *curl = curl_easy_init();
-    if (!curl) {
-        fprintf(stderr, "Failed to initialize CURL for Database Static secret\n");
+    vault_token_t *token = vault_token_acquire(client);
+    if (!token) {
+        VAULT_LOG_ERROR("Not logged in to Vault");
         return -1;
     }
     
-    // URL 구성
-    char url[512];
-    snprintf(url, sizeof(url), "%s/v1/%s", client->vault_url, client->db_static_path);
-    
-    // HTTP 요청 설정
-    struct http_response response = {0};
-    curl_easy_setopt(curl, CURLOPT_URL, url);
-    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, write_callback);
-    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &response);
-    curl_easy_setopt(curl, CURLOPT_HTTPGET, 1L);
-    curl_easy_setopt(curl, CURLOPT_TIMEOUT, client->config->http_timeout);
-    curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
-    curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 0L);
-    curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, 0L);
-    
-    // 헤더 설정
-    struct curl_slist *headers = NULL;
-    char auth_header[1024];
-    snprintf(auth_header, sizeof(auth_header), "X-Vault-Token: %s", client->token);
-    headers = curl_slist_append(headers, auth_header);
-    
-    if (client->config->vault_namespace[0]) {
-        char ns_header[256];
-        snprintf(ns_header, sizeof(ns_header), "X-Vault-Namespace: %s", client->config->vault_namespace);
-        headers = curl_slist_append(headers, ns_header);
+    // 스레드별 요청 핸들 준비 (URL/헤더는 템플릿과 토큰 레코드에 미리 구성)
+    struct http_response *response = NULL;
+    CURL *curl = vault_request_begin_template(client, &client->db_static_request, token, &response);
+    if (!curl) {
+        VAULT_LOG_ERROR("Failed to initialize CURL for Database Static secret");
+        vault_token_release(token);
+        return -1;
     }
     
-    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
-    
     // HTTP 요청 실행
-    CURLcode res = curl_easy_perform(curl);
+    CURLcode res = vault_perform(client, curl, client->db_static_request.endpoint, response);
     long http_code;
     curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &http_code);
     
-    curl_slist_free_all(headers);
+    vault_token_release(token);
     
     if (res != CURLE_OK) {
-        fprintf(stderr, "Database Static secret request failed: %s\n", curl_easy_strerror(res));
-        free(response.data);
-        curl_easy_cleanup(curl);
+        VAULT_LOG_ERROR("Database Static secret request failed: %s", curl_easy_strerror(res));
         return -1;
     }
     
     // JSON 파싱
-    json_object *json_response = json_tokener_parse(response.data);
+    json_object *json_response = response->data ? json_tokener_parse(response->data) : NULL;  // 빈 응답(연결 끊김 등)은 파싱 실패로 처리
     if (!json_response) {
-        fprintf(stderr, "Failed to parse Database Static secret response\n");
-        free(response.data);
-        curl_easy_cleanup(curl);
+        VAULT_LOG_ERROR("Failed to parse Database Static secret response");
         return -1;
     }
     
     // 오류 확인
     json_object *errors;
     if (json_object_object_get_ex(json_response, "errors", &errors)) {
-        printf("🔍 Debug: Vault returned errors:\n");
-        printf("   %s\n", json_object_to_json_string(errors));
+        VAULT_LOG_DEBUG("🔍 Debug: Vault returned errors:");
+        VAULT_LOG_DEBUG("   %s", json_object_to_json_string(errors));
     }
     
     if (http_code != 200) {
-        fprintf(stderr, "Database Static secret request failed with HTTP %ld\n", http_code);
-        printf("Response: %s\n", response.data);
+        VAULT_LOG_ERROR("Database Static secret request failed with HTTP %ld", http_code);
+        VAULT_LOG_DEBUG("Response: %s", response->data);
         json_object_put(json_response);
-        free(response.data);
-        curl_easy_cleanup(curl);
         return -1;
     }
     
-    printf("Database Static secret retrieved successfully\n");
+    VAULT_LOG_INFO("Database Static secret retrieved successfully");
     
     // data 섹션만 반환
     json_object *data;
@@ -1025,29 +2488,166 @@ int vault_get_db_static_secret_direct(vault_client_t *client, json_object **secr
     }
     
     json_object_put(json_response);
-    free(response.data);
-    curl_easy_cleanup(curl);
     return 0;
 }
 
 // Database Static 시크릿이 오래되었는지 확인
 int vault_is_db_static_secret_stale(vault_client_t *client) {
-    if (!client || !client->cached_db_static_secret) {
+    if (!client) {
+        return 1;
+    }
+    
+    pthread_rwlock_rdlock(&client->cache_lock);
+    int cached = client->cached_db_static_secret != NULL;
+    time_t last_refresh = client->db_static_last_refresh;
+    pthread_rwlock_unlock(&client->cache_lock);
+    
+    if (!cached) {
         return 1; // 캐시가 없으면 stale
     }
     
     time_t now = time(NULL);
-    time_t elapsed = now - client->db_static_last_refresh;
     
-    // 5분마다 갱신 (Database Static은 자주 변경되지 않음)
+    // 교체 시각을 알면 그 시각(+ rotation_skew)까지는 요청 없이 캐시 사용
+    time_t next_refresh = vault_db_static_next_refresh(client);
+    if (next_refresh > 0) {
+        return now >= next_refresh;
+    }
+    
+    // 교체 정보가 없으면 5분마다 갱신 (Database Static은 자주 변경되지 않음)
+    time_t elapsed = now - last_refresh;
     return (elapsed >= 300);
 }
 
+// Database Static 다음 갱신 시각 (교체 예정 시각 + rotation_skew, 교체 정보가 없거나 캐시가 없으면 0)
+time_t vault_db_static_next_refresh(vault_client_t *client) {
+    if (!client) return 0;
+    
+    pthread_rwlock_rdlock(&client->cache_lock);
+    time_t rotation_at = client->cached_db_static_secret ? client->db_static_rotation_at : 0;
+    pthread_rwlock_unlock(&client->cache_lock);
+    
+    if (rotation_at == 0) return 0;
+    int skew = client->config->secret_database_static.rotation_skew;
+    return rotation_at + (skew > 1 ? skew : 1);  // 교체가 늦어질 때 매초 이상 다시 읽지 않도록 최소 1초
+}
+
 // Database Static 캐시 정리
 void vault_cleanup_db_static_cache(vault_client_t *client) {
-    if (client && client->cached_db_static_secret) {
-        json_object_put(client->cached_db_static_secret);
-        client->cached_db_static_secret = NULL;
-        client->db_static_last_refresh = 0;
+    if (!client) return;
+    
+    pthread_rwlock_wrlock(&client->cache_lock);
+    json_object *old_secret = client->cached_db_static_secret;
+    client->cached_db_static_secret = NULL;
+    client->db_static_last_refresh = 0;
+    client->db_static_rotation_at = 0;
+    pthread_rwlock_unlock(&client->cache_lock);
+    
+    if (old_secret) {
+        json_object_put(old_secret);
+    }
+}
+
+// 공개 API 호출 기록
+// 기록 모드에서는 main 루프와 갱신 스레드가 호출한 최상위 API를 시각과 함께 기록하여
+// bench/replay가 같은 호출 패턴을 재생할 수 있게 합니다. (내부 중첩 호출은 기록하지 않음)
+
+int vault_login(vault_client_t *client, const char *role_id, const char *secret_id) {
+    vault_record_scope_t scope = vault_record_call_begin(VAULT_CALL_LOGIN);
+    int rc = vault_login_impl(client, role_id, secret_id);
+    vault_record_call_end(&scope, rc);
+    return rc;
+}
+
+int vault_refresh_token(vault_client_t *client) {
+    vault_record_scope_t scope = vault_record_call_begin(VAULT_CALL_REFRESH_TOKEN);
+    int rc = vault_refresh_token_impl(client);
+    vault_record_call_end(&scope, rc);
+    return rc;
+}
+
+int vault_get_kv_secret(vault_client_t *client, json_object **secret_data) {
+    vault_record_scope_t scope = vault_record_call_begin(VAULT_CALL_GET_KV);
+    int rc = vault_get_kv_secret_impl(client, secret_data);
+    vault_record_call_end(&scope, rc);
+    return rc;
+}
+
+int vault_get_db_dynamic_secret(vault_client_t *client, json_object **secret_data) {
+    vault_record_scope_t scope = vault_record_call_begin(VAULT_CALL_GET_DB_DYNAMIC);
+    int rc = vault_get_db_dynamic_secret_impl(client, secret_data);
+    vault_record_call_end(&scope, rc);
+    return rc;
+}
+
+int vault_get_db_static_secret(vault_client_t *client, json_object **secret_data) {
+    vault_record_scope_t scope = vault_record_call_begin(VAULT_CALL_GET_DB_STATIC);
+    int rc = vault_get_db_static_secret_impl(client, secret_data);
+    vault_record_call_end(&scope, rc);
+    return rc;
+}
+
+int vault_refresh_kv_secret(vault_client_t *client) {
+    vault_record_scope_t scope = vault_record_call_begin(VAULT_CALL_REFRESH_KV);
+    int rc = vault_refresh_kv_secret_impl(client);
+    vault_record_call_end(&scope, rc);
+    return rc;
+}
+
+int vault_refresh_db_dynamic_secret(vault_client_t *client) {
+    vault_record_scope_t scope = vault_record_call_begin(VAULT_CALL_REFRESH_DB_DYNAMIC);
+    int rc = vault_refresh_db_dynamic_secret_impl(client);
+    vault_record_call_end(&scope, rc);
+    return rc;
+}
+
+int vault_refresh_db_static_secret(vault_client_t *client) {
+    vault_record_scope_t scope = vault_record_call_begin(VAULT_CALL_REFRESH_DB_STATIC);
+    int rc = vault_refresh_db_static_secret_impl(client);
+    vault_record_call_end(&scope, rc);
+    return rc;
+}
+
+// 시크릿 변경 구독
+int vault_subscribe(vault_client_t *client, const char *secret_name,
+                    vault_change_callback_t callback, void *ctx) {
+    vault_cache_kind_t secret;
+    if (!client || vault_secret_parse_name(secret_name, &secret) != 0) {
+        VAULT_LOG_ERROR("Unknown secret for subscription: %s", secret_name ? secret_name : "(null)");
+        return -1;
+    }
+
+    int id = vault_subscriptions_add(&client->subscriptions, secret, callback, ctx);
+    if (id < 0) {
+        VAULT_LOG_ERROR("Subscription limit reached (%d)", VAULT_MAX_SUBSCRIPTIONS);
     }
-}
\ No newline at end of file
+    return id;
+}
+
+// 시크릿 변경 구독 해지
+int vault_unsubscribe(vault_client_t *client, int subscription_id) {
+    if (!client) {
+        return -1;
+    }
+    return vault_subscriptions_remove(&client->subscriptions, subscription_id);
+}
+
+// 클라이언트 통계 스냅샷 (프로세스 전체 메트릭 레지스트리 + 이 클라이언트의 토큰/캐시 상태)
+int vault_client_get_stats(vault_client_t *client, vault_client_stats_t *stats) {
+    if (!client || !stats) return -1;
+    
+    vault_metrics_snapshot(&stats->process_metrics);
+    
+    vault_token_t *token = vault_token_acquire(client);
+    stats->token_generation = token ? token->generation : 0;
+    stats->token_ttl_remaining = token ? (long)(token->expiry - time(NULL)) : 0;
+    stats->token_renewable = token ? token->renewable : 0;
+    vault_token_release(token);
+    
+    pthread_rwlock_rdlock(&client->cache_lock);
+    stats->kv_version = client->kv_version;
+    stats->lease_expiry = client->lease_expiry;
+    pthread_rwlock_unlock(&client->cache_lock);
+    vault_db_pool_get_stats(&client->db_pool, &stats->db_pool);
+    return 0;
+}
@@ -4,45 +4,171 @@
 #include <curl/curl.h>
 #include <json.h>
 #include <time.h>
+#include <pthread.h>
 #include "config.h"
+#include "vault_schedule.h"
+#include "vault_metrics.h"
+#include "vault_trace.h"
+#include "vault_record.h"
+#include "vault_log.h"
+#include "vault_subscribe.h"
+#include "vault_path_cache.h"
+#include "vault_db_pool.h"
+#include "vault_limit.h"
+
+// 토큰 상태 레코드
+// 발행(publish) 이후에는 변경되지 않으며, 로그인/갱신 시 새 레코드로 통째로 교체됩니다.
+// 요청은 시작 시점의 레코드를 참조 카운트로 고정하므로 교체 중에도 토큰이 깨지지 않습니다.
+typedef struct {
+    char token[512];
+    time_t issued;            // 토큰 발급(갱신) 시간
+    time_t expiry;            // 토큰 만료 시간
+    time_t renewal_at;        // 갱신(batch 토큰은 재로그인) 예정 시각
+    int renewable;            // renew-self 가능 여부 (batch 토큰은 0)
+    unsigned long generation; // 발행 세대 (교체될 때마다 증가)
+    int refs;                 // 참조 카운트 (원자적 증감)
+    struct curl_slist *headers;       // X-Vault-Token(, X-Vault-Namespace) 요청 헤더 (여러 핸들이 읽기 전용으로 공유)
+    struct curl_slist *json_headers;  // headers + Content-Type: application/json (쓰기 요청)
+} vault_token_t;
+
+// 요청 템플릿 (시크릿별 GET 요청, 경로가 바뀔 때만 다시 만듦)
+// 스레드별 요청 핸들은 마지막으로 적용한 템플릿 id를 기억하여, 같은 템플릿을 연달아 보내면 옵션을
+// 초기화하거나 다시 설정하지 않고 토큰 레코드의 헤더 목록만 지정해 보냅니다 (문자열 구성, 할당 없음).
+typedef struct {
+    char url[768];              // {vault_url}/v1/{경로}
+    vault_endpoint_t endpoint;
+    int stream;                 // KV 조회 (압축 응답 허용 + 스트리밍 파싱)
+    unsigned long id;           // 만들 때마다 받는 전역 고유 번호
+} vault_request_template_t;
+
+// 공유 전송 계층
+// 여러 클라이언트(테넌트)가 하나의 연결 풀, DNS 캐시, TLS 세션 캐시를 공유합니다.
+// 스레드별 요청 핸들이 끝낸 연결은 풀에 남아 다른 스레드의 요청이 keep-alive로 재사용합니다.
+// 적응형 동시 요청 제한도 전송 계층에 두어 모든 클라이언트(테넌트)의 요청이 한 한도를 나눠 씁니다.
+typedef struct {
+    CURLSH *share;
+    pthread_mutex_t locks[CURL_LOCK_DATA_LAST];  // 공유 데이터 종류별 잠금
+    vault_limiter_t limiter;                     // [http] adaptive_limit (설정 전에는 제한 없음)
+    char accept_encoding[64];                    // [http] accept_encoding 중 libcurl이 풀 수 있는 방식 (비어 있으면 압축 안 함)
+} vault_transport_t;
 
 // Vault 클라이언트 구조체
+// 스레드 모델: 클라이언트는 여러 스레드가 공유하는 코어이며 요청 중에는 변경되지 않습니다
+// (URL, 경로, 설정 참조, 전송 계층). 요청 핸들과 응답 버퍼는 스레드별 요청 컨텍스트에 두고,
+// 가변 상태는 토큰 레코드(token_lock)와 시크릿 캐시(cache_lock)로 보호합니다.
+// 조회 API가 반환하는 시크릿은 호출자 전용 복사본이므로 어느 스레드에서든 vault_cleanup_secret()으로 해제합니다.
 typedef struct {
     char vault_url[256];
-    char token[512];
-    time_t token_expiry;
-    time_t token_issued;  // 토큰 발급 시간 추가
-    CURL *curl;
+    vault_token_t *token_state;     // 현재 발행된 토큰 레코드
+    pthread_mutex_t token_lock;     // token_state 포인터 교체/획득 보호
+    unsigned long token_generation; // 마지막 발행 세대
+    vault_schedule_t schedule;  // 주기 작업 분산 정책
+    vault_transport_t *transport;  // 공유 전송 계층 (NULL이면 요청마다 새 연결)
     app_config_t *config;  // 설정 참조 추가
     
+    // 시크릿 캐시 잠금 (조회는 읽기 잠금에서 복사, 갱신은 쓰기 잠금에서 포인터만 교체)
+    pthread_rwlock_t cache_lock;
+    pthread_mutex_t refresh_lock[VAULT_CACHE_COUNT];  // 같은 시크릿의 갱신 직렬화 (HTTP 요청 동안 유지)
+    
     // KV 시크릿 캐시
     json_object *cached_kv_secret;
     time_t kv_last_refresh;
     char kv_path[256];
+    vault_request_template_t kv_request;
     int kv_version;  // KV 시크릿 버전 추적
     
     // Database Dynamic 시크릿 캐시
     json_object *cached_db_dynamic_secret;
     time_t db_dynamic_last_refresh;
     char db_dynamic_path[256];
+    vault_request_template_t db_dynamic_request;
     char lease_id[512];
     time_t lease_expiry;
+    vault_db_pool_t db_pool;  // [secret-database-dynamic] pool_size > 0일 때 사용
     
     // Database Static 시크릿 캐시
     json_object *cached_db_static_secret;
     time_t db_static_last_refresh;
+    time_t db_static_rotation_at;  // 다음 비밀번호 교체 예정 시각 (응답에 교체 정보가 없으면 0)
     char db_static_path[256];
+    vault_request_template_t db_static_request;
+    
+    // 경로별 KV 캐시 (vault_get_secrets, vault_prefetch_kv)
+    vault_path_cache_t kv_paths;
+    
+    // 시크릿 변경 구독자
+    vault_subscriptions_t subscriptions;
 } vault_client_t;
 
+// vault_get_secrets 경로별 결과
+typedef struct {
+    json_object *data;  // 성공 시 data.data 복사본 (호출자가 vault_cleanup_secret으로 해제)
+    int rc;             // 0 성공, -1 실패
+    int cached;         // 1이면 요청 없이 경로 캐시에서 반환
+    long http_code;     // 응답 코드 (캐시 반환 또는 전송 실패 시 0)
+    char error[128];    // 실패 사유
+} vault_secret_result_t;
+
+// vault_prefetch_kv 결과
+typedef struct {
+    size_t lists;       // LIST 요청 수 (탐색한 폴더 수)
+    size_t keys;        // 발견한 리프 수
+    size_t fetched;     // 데이터를 새로 받은 리프 수
+    size_t unchanged;   // metadata 버전이 같아 데이터 요청을 생략한 리프 수
+    size_t failed;      // 실패한 요청 수
+    int truncated;      // 깊이/개수 한도로 탐색을 중단한 폴더나 키가 있음
+    double elapsed_ms;
+} vault_prefetch_stats_t;
+
+// 클라이언트 통계 스냅샷 (vault_client_get_stats)
+// 토큰/캐시/풀 상태는 이 클라이언트의 값이고, 메트릭 레지스트리는 프로세스에 하나이므로 process_metrics는 전체 합산입니다.
+typedef struct {
+    vault_metrics_snapshot_t process_metrics;  // 엔드포인트별 요청/지연 시간, 캐시/갱신 카운터 (프로세스 전체, 모든 클라이언트/테넌트 합산)
+    unsigned long token_generation;    // 현재 토큰 발행 세대
+    long token_ttl_remaining;          // 토큰 남은 TTL (초)
+    int token_renewable;               // 현재 토큰 갱신 가능 여부
+    int kv_version;                    // 캐시된 KV 버전
+    time_t lease_expiry;               // Database Dynamic lease 만료 시각
+    vault_db_pool_stats_t db_pool;     // Database Dynamic 자격증명 풀 (풀 모드)
+} vault_client_stats_t;
+
 // 함수 선언
+int vault_transport_init(vault_transport_t *transport);
+void vault_transport_destroy(vault_transport_t *transport);
+void vault_transport_configure(vault_transport_t *transport, const app_config_t *config);  // 적응형 한도, 응답 압축 (요청 전에 호출)
+
 int vault_client_init(vault_client_t *client, app_config_t *config);
+void vault_client_set_transport(vault_client_t *client, vault_transport_t *transport);  // 로그인 전에 호출
 void vault_client_cleanup(vault_client_t *client);
+void vault_client_thread_cleanup(void);  // 현재 스레드의 요청 컨텍스트 해제 (작업 스레드는 종료 시 자동)
 int vault_login(vault_client_t *client, const char *role_id, const char *secret_id);
 int vault_renew_token(vault_client_t *client);
+int vault_refresh_token(vault_client_t *client);
+vault_token_t *vault_token_acquire(vault_client_t *client);
+void vault_token_release(vault_token_t *token);
 int vault_get_secret(vault_client_t *client, const char *path, json_object **secret_data);
+int vault_write(vault_client_t *client, const char *path, const char *body, vault_endpoint_t endpoint,
+                json_object **response);
+// 평문 키를 받는 쓰기 요청 (Transit datakey/decrypt, PKI 발급): 파싱 후 응답 버퍼를 지움
+int vault_write_sensitive(vault_client_t *client, const char *path, const char *body, vault_endpoint_t endpoint,
+                          json_object **response);
+int vault_get_secrets(vault_client_t *client, const char *const paths[], size_t count,
+                      vault_secret_result_t results[]);  // 실패한 경로 수 (인자 오류 시 -1)
+int vault_prefetch_kv(vault_client_t *client, const char *mount, const char *prefix, int max_depth,
+                      size_t max_keys, vault_prefetch_stats_t *stats);  // 실패가 있으면 -1
 int vault_is_token_valid(vault_client_t *client);
 void vault_print_token_status(vault_client_t *client);
 void vault_cleanup_secret(json_object *secret_data);
+int vault_client_get_stats(vault_client_t *client, vault_client_stats_t *stats);
+
+// 설정 핫 리로드 반영 (changes: config_diff 결과, app_config 갱신 후 호출)
+void vault_client_apply_config(vault_client_t *client, unsigned changes);
+
+// 시크릿 변경 구독 (secret_name: "kv", "database-dynamic", "database-static")
+// 콜백은 갱신 스레드에서 실제 변경 시에만 호출되므로 짧게 처리해야 합니다.
+int vault_subscribe(vault_client_t *client, const char *secret_name,
+                    vault_change_callback_t callback, void *ctx);  // 구독 ID (실패 시 -1)
+int vault_unsubscribe(vault_client_t *client, int subscription_id);
 
 // KV 시크릿 갱신 관련 함수
 int vault_refresh_kv_secret(vault_client_t *client);
@@ -57,13 +183,21 @@ int vault_get_db_dynamic_secret(vault_client_t *client, json_object **secret_dat
 int vault_get_db_dynamic_secret_direct(vault_client_t *client, json_object **secret_data);
 int vault_is_db_dynamic_secret_stale(vault_client_t *client);
 int vault_check_lease_status(vault_client_t *client, const char *lease_id, time_t *expire_time, int *ttl);
+int vault_revoke_lease(vault_client_t *client, const char *lease_id);
 void vault_cleanup_db_dynamic_cache(vault_client_t *client);
 
+// Database Dynamic 자격증명 풀 (pool_size > 0, 갱신은 vault_refresh_db_dynamic_secret이 풀 유지 작업으로 처리)
+// 연결 풀 작업자는 연결을 만들 때 빌리고, vault_db_is_retired()가 1이 되면 새로 빌려 재연결한 뒤 이전 것을 반납합니다.
+int vault_db_checkout(vault_client_t *client, json_object **secret_data, unsigned long *id);  // 요청 없음
+void vault_db_checkin(vault_client_t *client, unsigned long id);
+int vault_db_is_retired(vault_client_t *client, unsigned long id);
+
 // Database Static 시크릿 관련 함수
 int vault_refresh_db_static_secret(vault_client_t *client);
 int vault_get_db_static_secret(vault_client_t *client, json_object **secret_data);
 int vault_get_db_static_secret_direct(vault_client_t *client, json_object **secret_data);
 int vault_is_db_static_secret_stale(vault_client_t *client);
+time_t vault_db_static_next_refresh(vault_client_t *client);  // 교체 예정 시각 + rotation_skew (모르면 0)
 void vault_cleanup_db_static_cache(vault_client_t *client);
 
 #endif
\ No newline at end of file
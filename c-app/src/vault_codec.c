@@ -0,0 +1,69 @@
+#define _POSIX_C_SOURCE 200809L
+#include "vault_codec.h"
+
+static const char base64_chars[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+size_t vault_base64_encode(const void *data, size_t len, char *out) {
+    const unsigned char *in = data;
+    size_t o = 0;
+    for (size_t i = 0; i < len; i += 3) {
+        uint32_t v = (uint32_t)in[i] << 16;
+        if (i + 1 < len) v |= (uint32_t)in[i + 1] << 8;
+        if (i + 2 < len) v |= in[i + 2];
+        out[o++] = base64_chars[(v >> 18) & 0x3F];
+        out[o++] = base64_chars[(v >> 12) & 0x3F];
+        out[o++] = i + 1 < len ? base64_chars[(v >> 6) & 0x3F] : '=';
+        out[o++] = i + 2 < len ? base64_chars[v & 0x3F] : '=';
+    }
+    out[o] = '\0';
+    return o;
+}
+
+static int base64_value(char c) {
+    if (c >= 'A' && c <= 'Z') return c - 'A';
+    if (c >= 'a' && c <= 'z') return c - 'a' + 26;
+    if (c >= '0' && c <= '9') return c - '0' + 52;
+    if (c == '+') return 62;
+    if (c == '/') return 63;
+    return -1;
+}
+
+int vault_base64_decode(const char *text, void *out, size_t out_size, size_t *out_len) {
+    unsigned char *dst = out;
+    size_t n = 0;
+    uint32_t v = 0;
+    int bits = 0;
+    for (const char *p = text; *p && *p != '='; p++) {
+        int d = base64_value(*p);
+        if (d < 0) return -1;
+        v = (v << 6) | (uint32_t)d;
+        bits += 6;
+        if (bits >= 8) {
+            bits -= 8;
+            if (n >= out_size) return -1;
+            dst[n++] = (unsigned char)((v >> bits) & 0xFF);
+        }
+    }
+    *out_len = n;
+    return 0;
+}
+
+uint32_t vault_fnv1a32(const char *str) {
+    uint32_t hash = 2166136261u;
+    if (!str) return hash;
+
+    while (*str) {
+        hash ^= (unsigned char)*str++;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+uint64_t vault_fnv1a64(uint64_t hash, const void *data, size_t len) {
+    const unsigned char *p = data;
+    for (size_t i = 0; i < len; i++) {
+        hash ^= p[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
@@ -0,0 +1,22 @@
+#ifndef VAULT_CODEC_H
+#define VAULT_CODEC_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// 모듈 공용 인코딩/해시 (Transit 입력/출력, envelope DEK, WebSocket 키, 스케줄/캐시 해시)
+
+#define VAULT_BASE64_LEN(n) (((n) + 2) / 3 * 4)   // base64 길이 (NUL 제외)
+#define VAULT_FNV1A64_INIT 1469598103934665603ULL
+
+// data len바이트를 out에 base64로 (out은 VAULT_BASE64_LEN(len) + 1바이트 이상, NUL 종료), 쓴 길이 반환
+size_t vault_base64_encode(const void *data, size_t len, char *out);
+// base64 text를 out에 해독 (첫 '='에서 멈춤, 잘못된 문자가 있거나 out_size를 넘으면 -1)
+// 해독한 바이트 수는 *out_len에 (NUL은 붙이지 않음)
+int vault_base64_decode(const char *text, void *out, size_t out_size, size_t *out_len);
+
+// FNV-1a (32비트는 NUL 종료 문자열, 64비트는 이전 해시에 이어서 계산)
+uint32_t vault_fnv1a32(const char *str);
+uint64_t vault_fnv1a64(uint64_t hash, const void *data, size_t len);
+
+#endif
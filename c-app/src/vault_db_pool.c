@@ -0,0 +1,214 @@
+#define _POSIX_C_SOURCE 200809L
+#include "vault_db_pool.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+void vault_db_pool_init(vault_db_pool_t *pool) {
+    memset(pool, 0, sizeof(*pool));
+    pool->next_id = 1;
+    pthread_mutex_init(&pool->lock, NULL);
+}
+
+static void free_cred(vault_db_cred_t *cred) {
+    json_object_put(cred->secret);
+    free(cred);
+}
+
+void vault_db_pool_destroy(vault_db_pool_t *pool) {
+    vault_db_cred_t *cred = pool->creds;
+    while (cred) {
+        vault_db_cred_t *next = cred->next;
+        free_cred(cred);
+        cred = next;
+    }
+    pool->creds = NULL;
+    pthread_mutex_destroy(&pool->lock);
+}
+
+unsigned long vault_db_pool_add(vault_db_pool_t *pool, const char *lease_id, json_object *secret,
+                                time_t issued_at, time_t expire_at, time_t rotate_at) {
+    vault_db_cred_t *cred = calloc(1, sizeof(vault_db_cred_t));
+    if (!cred) {
+        json_object_put(secret);
+        return 0;
+    }
+    snprintf(cred->lease_id, sizeof(cred->lease_id), "%s", lease_id ? lease_id : "");
+    cred->secret = secret;
+    cred->issued_at = issued_at;
+    cred->expire_at = expire_at;
+    cred->rotate_at = rotate_at;
+    cred->state = VAULT_DB_CRED_ACTIVE;
+
+    pthread_mutex_lock(&pool->lock);
+    cred->id = pool->next_id++;
+    vault_db_cred_t **tail = &pool->creds;
+    while (*tail) tail = &(*tail)->next;
+    *tail = cred;
+    pool->minted++;
+    unsigned long id = cred->id;
+    pthread_mutex_unlock(&pool->lock);
+    return id;
+}
+
+unsigned long vault_db_pool_due(vault_db_pool_t *pool, time_t now) {
+    unsigned long id = 0;
+    pthread_mutex_lock(&pool->lock);
+    for (vault_db_cred_t *cred = pool->creds; cred; cred = cred->next) {
+        if (cred->state == VAULT_DB_CRED_ACTIVE && cred->rotate_at <= now) {
+            id = cred->id;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&pool->lock);
+    return id;
+}
+
+size_t vault_db_pool_retire(vault_db_pool_t *pool, unsigned long id, time_t drain_until) {
+    size_t retired = 0;
+    pthread_mutex_lock(&pool->lock);
+    for (vault_db_cred_t *cred = pool->creds; cred; cred = cred->next) {
+        if (cred->state != VAULT_DB_CRED_ACTIVE || (id && cred->id != id)) continue;
+        cred->state = VAULT_DB_CRED_DRAINING;
+        // 유예 시간은 lease 만료를 넘지 않음
+        cred->drain_until = drain_until < cred->expire_at ? drain_until : cred->expire_at;
+        retired++;
+    }
+    pool->retired += retired;
+    pthread_mutex_unlock(&pool->lock);
+    return retired;
+}
+
+int vault_db_pool_take_drained(vault_db_pool_t *pool, time_t now, char *lease_id, size_t lease_id_size,
+                               int *revoke) {
+    vault_db_cred_t *taken = NULL;
+    pthread_mutex_lock(&pool->lock);
+    for (vault_db_cred_t **slot = &pool->creds; *slot; slot = &(*slot)->next) {
+        vault_db_cred_t *cred = *slot;
+        if (cred->state != VAULT_DB_CRED_DRAINING) continue;
+        int expired = cred->expire_at < now;
+        if (expired || (cred->drain_until <= now && cred->checkouts == 0)) {
+            *slot = cred->next;
+            *revoke = !expired;
+            if (!expired) pool->revoked++;
+            taken = cred;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&pool->lock);
+
+    if (!taken) return -1;
+    snprintf(lease_id, lease_id_size, "%s", taken->lease_id);
+    free_cred(taken);
+    return 0;
+}
+
+size_t vault_db_pool_active(vault_db_pool_t *pool) {
+    size_t active = 0;
+    pthread_mutex_lock(&pool->lock);
+    for (vault_db_cred_t *cred = pool->creds; cred; cred = cred->next) {
+        if (cred->state == VAULT_DB_CRED_ACTIVE) active++;
+    }
+    pthread_mutex_unlock(&pool->lock);
+    return active;
+}
+
+time_t vault_db_pool_next_event(vault_db_pool_t *pool) {
+    time_t next = 0;
+    time_t now = time(NULL);
+    pthread_mutex_lock(&pool->lock);
+    for (vault_db_cred_t *cred = pool->creds; cred; cred = cred->next) {
+        // 유예 시간이 지났는데 반납되지 않은 자격증명은 만료 후 정리
+        time_t at = cred->state == VAULT_DB_CRED_ACTIVE ? cred->rotate_at :
+                    cred->drain_until > now || cred->checkouts == 0 ? cred->drain_until : cred->expire_at + 1;
+        if (next == 0 || at < next) next = at;
+    }
+    pthread_mutex_unlock(&pool->lock);
+    return next;
+}
+
+int vault_db_pool_checkout(vault_db_pool_t *pool, json_object **secret, unsigned long *id) {
+    if (!secret) return -1;
+
+    int rc = -1;
+    pthread_mutex_lock(&pool->lock);
+    vault_db_cred_t *best = NULL;
+    for (vault_db_cred_t *cred = pool->creds; cred; cred = cred->next) {
+        if (cred->state == VAULT_DB_CRED_ACTIVE && (!best || cred->checkouts < best->checkouts)) {
+            best = cred;
+        }
+    }
+    if (best) {
+        *secret = NULL;
+        if (json_object_deep_copy(best->secret, secret, NULL) == 0) {
+            best->checkouts++;
+            pool->checkouts++;
+            if (id) *id = best->id;
+            rc = 0;
+        }
+    }
+    pthread_mutex_unlock(&pool->lock);
+    return rc;
+}
+
+void vault_db_pool_checkin(vault_db_pool_t *pool, unsigned long id) {
+    pthread_mutex_lock(&pool->lock);
+    for (vault_db_cred_t *cred = pool->creds; cred; cred = cred->next) {
+        if (cred->id == id) {
+            if (cred->checkouts > 0) cred->checkouts--;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&pool->lock);
+}
+
+int vault_db_pool_is_retired(vault_db_pool_t *pool, unsigned long id) {
+    int retired = 1;
+    pthread_mutex_lock(&pool->lock);
+    for (vault_db_cred_t *cred = pool->creds; cred; cred = cred->next) {
+        if (cred->id == id) {
+            retired = cred->state != VAULT_DB_CRED_ACTIVE;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&pool->lock);
+    return retired;
+}
+
+int vault_db_pool_peek(vault_db_pool_t *pool, json_object **secret) {
+    if (!secret) return -1;
+
+    int rc = -1;
+    pthread_mutex_lock(&pool->lock);
+    vault_db_cred_t *newest = NULL;
+    for (vault_db_cred_t *cred = pool->creds; cred; cred = cred->next) {
+        if (cred->state == VAULT_DB_CRED_ACTIVE) newest = cred;
+    }
+    if (newest) {
+        *secret = NULL;
+        rc = json_object_deep_copy(newest->secret, secret, NULL) == 0 ? 0 : -1;
+    }
+    pthread_mutex_unlock(&pool->lock);
+    return rc;
+}
+
+void vault_db_pool_get_stats(vault_db_pool_t *pool, vault_db_pool_stats_t *stats) {
+    memset(stats, 0, sizeof(*stats));
+    pthread_mutex_lock(&pool->lock);
+    for (vault_db_cred_t *cred = pool->creds; cred; cred = cred->next) {
+        if (cred->state == VAULT_DB_CRED_ACTIVE) {
+            stats->active++;
+            if (stats->next_rotation == 0 || cred->rotate_at < stats->next_rotation) {
+                stats->next_rotation = cred->rotate_at;
+            }
+        } else {
+            stats->draining++;
+        }
+        stats->checked_out += (size_t)cred->checkouts;
+    }
+    stats->minted = pool->minted;
+    stats->retired = pool->retired;
+    stats->revoked = pool->revoked;
+    stats->checkouts = pool->checkouts;
+    pthread_mutex_unlock(&pool->lock);
+}
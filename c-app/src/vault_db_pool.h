@@ -0,0 +1,95 @@
+#ifndef VAULT_DB_POOL_H
+#define VAULT_DB_POOL_H
+
+#include <json.h>
+#include <stddef.h>
+#include <time.h>
+#include <pthread.h>
+
+// Database Dynamic 자격증명 풀
+// [secret-database-dynamic] pool_size개의 자격증명을 만료 시각이 엇갈리도록 유지합니다.
+// 교체 시각(rotate_at)이 된 자격증명은 새 자격증명을 먼저 발급한 뒤 drain 상태로 넘기고,
+// 유예 시간이 지나 빌려 간 작업자가 모두 반납하면 lease를 폐기합니다.
+// 발급/폐기 요청은 vault_db_pool_maintain()(갱신 스레드)만 보내며, 빌리기는 요청 없이 잠금 안에서 끝납니다.
+
+#define VAULT_DB_POOL_MAX_SIZE 32
+
+typedef enum {
+    VAULT_DB_CRED_ACTIVE,    // 새 연결에 배정
+    VAULT_DB_CRED_DRAINING   // 교체됨, 기존 연결은 유예 시간 동안 계속 사용
+} vault_db_cred_state_t;
+
+typedef struct vault_db_cred {
+    unsigned long id;            // 풀 안에서 유일한 번호 (반납/교체 확인용)
+    char lease_id[512];
+    json_object *secret;         // creds 전체 응답 (lease_id, lease_duration, data)
+    time_t issued_at;
+    time_t expire_at;
+    time_t rotate_at;            // ACTIVE: 교체 예정 시각
+    time_t drain_until;          // DRAINING: 폐기 가능 시각
+    vault_db_cred_state_t state;
+    int checkouts;               // 빌려 가서 아직 반납하지 않은 수
+    struct vault_db_cred *next;
+} vault_db_cred_t;
+
+typedef struct {
+    vault_db_cred_t *creds;      // 발급 순서 (오래된 것부터)
+    unsigned long next_id;
+    pthread_mutex_t lock;
+
+    // 누적 통계
+    unsigned long minted;
+    unsigned long retired;
+    unsigned long revoked;
+    unsigned long checkouts;
+} vault_db_pool_t;
+
+typedef struct {
+    size_t active;
+    size_t draining;
+    size_t checked_out;          // 현재 빌려 간 수
+    unsigned long minted;
+    unsigned long retired;
+    unsigned long revoked;
+    unsigned long checkouts;
+    time_t next_rotation;        // 가장 이른 교체 예정 시각 (없으면 0)
+} vault_db_pool_stats_t;
+
+void vault_db_pool_init(vault_db_pool_t *pool);
+void vault_db_pool_destroy(vault_db_pool_t *pool);
+
+// 새 자격증명 추가 (secret 참조는 풀이 가져감, 부여한 id 반환)
+unsigned long vault_db_pool_add(vault_db_pool_t *pool, const char *lease_id, json_object *secret,
+                                time_t issued_at, time_t expire_at, time_t rotate_at);
+
+// 교체 시각이 지난 ACTIVE 자격증명 하나 (없으면 0)
+unsigned long vault_db_pool_due(vault_db_pool_t *pool, time_t now);
+
+// ACTIVE -> DRAINING (drain_until 이후 폐기 대상, id가 0이면 모든 ACTIVE 자격증명), 옮긴 수 반환
+size_t vault_db_pool_retire(vault_db_pool_t *pool, unsigned long id, time_t drain_until);
+
+// 폐기할 자격증명 하나를 풀에서 꺼냄 (유예 시간이 지나고 모두 반납됐거나, 이미 만료된 경우)
+// 꺼냈으면 0 (*revoke가 0이면 이미 만료되어 폐기 요청 불필요), 없으면 -1
+int vault_db_pool_take_drained(vault_db_pool_t *pool, time_t now, char *lease_id, size_t lease_id_size,
+                               int *revoke);
+
+size_t vault_db_pool_active(vault_db_pool_t *pool);
+
+// 다음 유지 작업 시각 (가장 이른 교체/폐기 예정 시각, 없으면 0)
+time_t vault_db_pool_next_event(vault_db_pool_t *pool);
+
+// 자격증명 빌리기: 빌려 간 수가 가장 적은 ACTIVE 자격증명의 복사본 (없으면 -1)
+int vault_db_pool_checkout(vault_db_pool_t *pool, json_object **secret, unsigned long *id);
+
+// 반납
+void vault_db_pool_checkin(vault_db_pool_t *pool, unsigned long id);
+
+// 빌린 자격증명이 교체되었는지 (DRAINING이거나 이미 폐기되었으면 1, 작업자는 새로 빌려 재연결)
+int vault_db_pool_is_retired(vault_db_pool_t *pool, unsigned long id);
+
+// 가장 최근에 발급된 ACTIVE 자격증명의 복사본 (빌리지 않고 조회, 없으면 -1)
+int vault_db_pool_peek(vault_db_pool_t *pool, json_object **secret);
+
+void vault_db_pool_get_stats(vault_db_pool_t *pool, vault_db_pool_stats_t *stats);
+
+#endif
@@ -0,0 +1,512 @@
+#define _POSIX_C_SOURCE 200809L
+#include "vault_envelope.h"
+#include "vault_codec.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <openssl/evp.h>
+#include <openssl/rand.h>
+#include <openssl/crypto.h>
+
+#define RECORD_MAGIC "VEK1"
+#define RECORD_MAGIC_SIZE 4
+#define REFRESH_RETRY_NS 1000000000ULL  // DEK 발급 실패 후 다시 요청하기까지 (1초)
+
+struct vault_envelope_dek {
+    char *wrapped;                  // "vault:v1:..." (Vault가 감싼 DEK, 레코드에 그대로 기록)
+    size_t wrapped_len;
+    char key[128];                  // 이 DEK를 감싼 Transit 키 (캐시는 키와 감싼 DEK가 모두 같아야 사용)
+    uint64_t hash;                  // 키 이름 + wrapped의 FNV-1a (캐시 검색용)
+    unsigned char *plaintext;       // arena 칸 (VAULT_ENVELOPE_KEY_SIZE바이트)
+    unsigned char nonce_prefix[4];
+    uint64_t uses;                  // 암호화에 쓴 횟수 (nonce 카운터)
+    uint64_t created_ns;
+    int refs;                       // 이 DEK로 암호화/복호화 중인 호출 수
+    int current;                    // 키의 현재 암호화용 DEK (캐시에서 내보내지 않음)
+    int evicted;                    // 캐시에서 빠짐, refs가 0이 되면 해제
+    vault_envelope_dek_t *prev;
+    vault_envelope_dek_t *next;
+};
+
+// Transit 키별 암호화 상태
+struct vault_envelope_key {
+    char name[128];
+    vault_envelope_dek_t *current;
+    int refreshing;                 // 한 호출이 새 DEK를 받는 중
+    uint64_t retry_after_ns;        // 발급 실패 후 재요청 가능 시각
+    vault_envelope_key_t *next;
+};
+
+// 스레드별 AES-GCM 컨텍스트 (호출마다 새로 만들지 않도록 재사용, 스레드 종료 시 해제)
+typedef struct {
+    EVP_CIPHER_CTX *encrypt;
+    EVP_CIPHER_CTX *decrypt;
+} cipher_ctx_t;
+
+static pthread_key_t cipher_key;
+static pthread_once_t cipher_key_once = PTHREAD_ONCE_INIT;
+
+static void cipher_ctx_free(void *ptr) {
+    cipher_ctx_t *ctx = ptr;
+    EVP_CIPHER_CTX_free(ctx->encrypt);  // 확장된 키는 OpenSSL이 지운 뒤 해제
+    EVP_CIPHER_CTX_free(ctx->decrypt);
+    free(ctx);
+}
+
+static void cipher_key_create(void) {
+    pthread_key_create(&cipher_key, cipher_ctx_free);
+}
+
+static cipher_ctx_t *cipher_ctx_get(void) {
+    pthread_once(&cipher_key_once, cipher_key_create);
+    cipher_ctx_t *ctx = pthread_getspecific(cipher_key);
+    if (ctx) return ctx;
+
+    ctx = calloc(1, sizeof(cipher_ctx_t));
+    if (!ctx) return NULL;
+    ctx->encrypt = EVP_CIPHER_CTX_new();
+    ctx->decrypt = EVP_CIPHER_CTX_new();
+    // 알고리즘은 한 번만 지정하고 이후에는 키와 nonce만 바꿈
+    if (!ctx->encrypt || !ctx->decrypt ||
+        EVP_EncryptInit_ex(ctx->encrypt, EVP_aes_256_gcm(), NULL, NULL, NULL) != 1 ||
+        EVP_DecryptInit_ex(ctx->decrypt, EVP_aes_256_gcm(), NULL, NULL, NULL) != 1) {
+        cipher_ctx_free(ctx);
+        return NULL;
+    }
+    pthread_setspecific(cipher_key, ctx);
+    return ctx;
+}
+
+// 캐시 검색 해시 (키 이름은 NUL까지 넣어 "a"+"bc"와 "ab"+"c"를 구분)
+static uint64_t dek_hash(const char *key, const char *wrapped, size_t len) {
+    return vault_fnv1a64(vault_fnv1a64(VAULT_FNV1A64_INIT, key, strlen(key) + 1), wrapped, len);
+}
+
+// base64 평문 DEK를 out에 해독 (정확히 VAULT_ENVELOPE_KEY_SIZE바이트가 아니면 -1)
+static int decode_key(const char *text, unsigned char *out) {
+    size_t n = 0;
+    if (vault_base64_decode(text, out, VAULT_ENVELOPE_KEY_SIZE, &n) != 0) return -1;
+    return n == VAULT_ENVELOPE_KEY_SIZE ? 0 : -1;
+}
+
+// 응답의 data.plaintext를 DEK로 해독한 뒤 응답 안의 평문 문자열을 지움
+static int take_plaintext_key(json_object *response, unsigned char *out) {
+    json_object *data, *plaintext;
+    if (!response || !json_object_object_get_ex(response, "data", &data) ||
+        !json_object_object_get_ex(data, "plaintext", &plaintext) || !json_object_is_type(plaintext, json_type_string)) {
+        return -1;
+    }
+    int rc = decode_key(json_object_get_string(plaintext), out);
+    vault_secure_zero((char *)json_object_get_string(plaintext), (size_t)json_object_get_string_len(plaintext));
+    return rc;
+}
+
+static vault_envelope_dek_t *dek_new(vault_envelope_t *envelope, const char *key, const char *wrapped) {
+    vault_envelope_dek_t *dek = calloc(1, sizeof(vault_envelope_dek_t));
+    if (!dek) return NULL;
+    dek->wrapped_len = strlen(wrapped);
+    dek->wrapped = strdup(wrapped);
+    dek->plaintext = vault_secure_alloc(&envelope->arena);
+    if (!dek->wrapped || !dek->plaintext || dek->wrapped_len > VAULT_ENVELOPE_MAX_WRAPPED) {
+        if (dek->plaintext) vault_secure_free(&envelope->arena, dek->plaintext);
+        free(dek->wrapped);
+        free(dek);
+        return NULL;
+    }
+    snprintf(dek->key, sizeof(dek->key), "%s", key);
+    dek->hash = dek_hash(key, wrapped, dek->wrapped_len);
+    dek->created_ns = vault_metrics_now_ns();
+    return dek;
+}
+
+static void dek_free(vault_envelope_t *envelope, vault_envelope_dek_t *dek) {
+    vault_secure_free(&envelope->arena, dek->plaintext);
+    free(dek->wrapped);
+    free(dek);
+}
+
+// 새 DEK 발급 (잠금 밖에서 호출)
+static vault_envelope_dek_t *fetch_datakey(vault_envelope_t *envelope, const char *key) {
+    char path[512];
+    snprintf(path, sizeof(path), "%s/datakey/plaintext/%s", envelope->mount, key);
+    json_object *response = NULL;
+    int rc = vault_write_sensitive(envelope->client, path, "{\"bits\":256}", VAULT_ENDPOINT_TRANSIT, &response);
+
+    vault_envelope_dek_t *dek = NULL;
+    json_object *data, *ciphertext;
+    if (rc == 0 && json_object_object_get_ex(response, "data", &data) &&
+        json_object_object_get_ex(data, "ciphertext", &ciphertext)) {
+        dek = dek_new(envelope, key, json_object_get_string(ciphertext));
+    }
+    if (dek && (take_plaintext_key(response, dek->plaintext) != 0 || RAND_bytes(dek->nonce_prefix, 4) != 1)) {
+        dek_free(envelope, dek);
+        dek = NULL;
+    }
+    if (!dek) {
+        // 실패해도 응답 안의 평문 DEK는 지움
+        unsigned char scratch[VAULT_ENVELOPE_KEY_SIZE];
+        take_plaintext_key(response, scratch);
+        vault_secure_zero(scratch, sizeof(scratch));
+        VAULT_LOG_ERROR("Failed to fetch Transit data key (key: %s)", key);
+    }
+    json_object_put(response);
+    return dek;
+}
+
+// 감싼 DEK를 Transit decrypt로 풀기 (잠금 밖에서 호출)
+static vault_envelope_dek_t *unwrap_datakey(vault_envelope_t *envelope, const char *key, const char *wrapped) {
+    char path[512];
+    snprintf(path, sizeof(path), "%s/decrypt/%s", envelope->mount, key);
+    json_object *body = json_object_new_object();
+    json_object_object_add(body, "ciphertext", json_object_new_string(wrapped));
+    json_object *response = NULL;
+    int rc = vault_write_sensitive(envelope->client, path, json_object_to_json_string_ext(body, JSON_C_TO_STRING_PLAIN),
+                                   VAULT_ENDPOINT_TRANSIT, &response);
+    json_object_put(body);
+
+    vault_envelope_dek_t *dek = rc == 0 ? dek_new(envelope, key, wrapped) : NULL;
+    if (dek && take_plaintext_key(response, dek->plaintext) != 0) {
+        dek_free(envelope, dek);
+        dek = NULL;
+    }
+    if (!dek) {
+        unsigned char scratch[VAULT_ENVELOPE_KEY_SIZE];
+        take_plaintext_key(response, scratch);
+        vault_secure_zero(scratch, sizeof(scratch));
+        VAULT_LOG_ERROR("Failed to unwrap Transit data key (key: %s)", key);
+    }
+    json_object_put(response);
+    return dek;
+}
+
+// 이하 잠금 안에서 호출
+
+static void lru_unlink(vault_envelope_t *envelope, vault_envelope_dek_t *dek) {
+    if (dek->prev) dek->prev->next = dek->next;
+    else envelope->lru_head = dek->next;
+    if (dek->next) dek->next->prev = dek->prev;
+    else envelope->lru_tail = dek->prev;
+    dek->prev = dek->next = NULL;
+}
+
+static void lru_push_front(vault_envelope_t *envelope, vault_envelope_dek_t *dek) {
+    dek->next = envelope->lru_head;
+    if (envelope->lru_head) envelope->lru_head->prev = dek;
+    envelope->lru_head = dek;
+    if (!envelope->lru_tail) envelope->lru_tail = dek;
+}
+
+// 다른 키로 푼 DEK는 쓰지 않음 (키별 decrypt 권한을 캐시가 건너뛰지 않도록)
+static vault_envelope_dek_t *cache_find(vault_envelope_t *envelope, const char *key, const char *wrapped, size_t len) {
+    uint64_t hash = dek_hash(key, wrapped, len);
+    for (vault_envelope_dek_t *dek = envelope->lru_head; dek; dek = dek->next) {
+        if (dek->hash == hash && dek->wrapped_len == len && memcmp(dek->wrapped, wrapped, len) == 0 &&
+            strcmp(dek->key, key) == 0) {
+            return dek;
+        }
+    }
+    return NULL;
+}
+
+// 캐시에 추가하고 cache_size를 넘는 오래된 DEK를 내보냄 (사용 중이면 반납될 때 해제)
+// 키별 현재 DEK는 내보낼 수 없으므로 cache_size에 세지 않음 (키가 많아도 복호화용 DEK 자리가 남도록)
+static void cache_insert(vault_envelope_t *envelope, vault_envelope_dek_t *dek) {
+    lru_push_front(envelope, dek);
+    envelope->stats.cached++;
+    vault_envelope_dek_t *victim = envelope->lru_tail;
+    while (envelope->stats.cached - envelope->current_keys > envelope->cache_size && victim) {
+        vault_envelope_dek_t *prev = victim->prev;
+        if (!victim->current) {
+            lru_unlink(envelope, victim);
+            envelope->stats.cached--;
+            if (victim->refs == 0) dek_free(envelope, victim);
+            else victim->evicted = 1;
+        }
+        victim = prev;
+    }
+}
+
+// DEK 반납과 통계 기록 (dek가 NULL이면 DEK를 얻지 못한 실패)
+static void finish_call(vault_envelope_t *envelope, vault_envelope_dek_t *dek, int encrypt, int rc, size_t len) {
+    pthread_mutex_lock(&envelope->lock);
+    if (dek && --dek->refs == 0 && dek->evicted) dek_free(envelope, dek);
+    if (rc != 0) {
+        envelope->stats.failures++;
+    } else if (encrypt) {
+        envelope->stats.encryptions++;
+        envelope->stats.bytes_encrypted += len;
+    } else {
+        envelope->stats.decryptions++;
+        envelope->stats.bytes_decrypted += len;
+    }
+    pthread_mutex_unlock(&envelope->lock);
+}
+
+static vault_envelope_key_t *key_find(vault_envelope_t *envelope, const char *name) {
+    vault_envelope_key_t **slot = &envelope->keys;
+    for (; *slot; slot = &(*slot)->next) {
+        if (strcmp((*slot)->name, name) == 0) return *slot;
+    }
+    vault_envelope_key_t *key = calloc(1, sizeof(vault_envelope_key_t));
+    if (!key) return NULL;
+    snprintf(key->name, sizeof(key->name), "%s", name);
+    *slot = key;
+    return key;
+}
+
+// 암호화용 DEK 하나와 nonce 카운터 예약
+// 한도를 넘은 DEK는 호출 하나만 새로 받고, 나머지는 사용 횟수가 남았으면 이전 DEK를 계속 쓰고
+// 남지 않았으면 교체를 기다립니다. 발급이 실패하면 1초 동안은 다시 요청하지 않습니다.
+static vault_envelope_dek_t *acquire_encrypt(vault_envelope_t *envelope, const char *name, uint64_t *counter) {
+    pthread_mutex_lock(&envelope->lock);
+    vault_envelope_key_t *key = key_find(envelope, name);
+    vault_envelope_dek_t *dek = NULL;
+    while (key) {
+        dek = key->current;
+        uint64_t now = vault_metrics_now_ns();
+        int usable = dek && dek->uses < envelope->max_uses;
+        int stale = !usable || now - dek->created_ns >= envelope->max_age_ns;
+
+        if (stale && !key->refreshing && now >= key->retry_after_ns) {
+            key->refreshing = 1;
+            pthread_mutex_unlock(&envelope->lock);
+            vault_envelope_dek_t *fresh = fetch_datakey(envelope, name);
+            pthread_mutex_lock(&envelope->lock);
+            envelope->stats.datakey_requests++;
+            key->refreshing = 0;
+            if (fresh) {
+                if (key->current) {
+                    key->current->current = 0;  // 이전 DEK는 복호화용으로 캐시에 남음
+                    envelope->stats.rotations++;
+                } else {
+                    envelope->current_keys++;
+                }
+                fresh->current = 1;
+                key->current = fresh;
+                cache_insert(envelope, fresh);
+            } else {
+                key->retry_after_ns = vault_metrics_now_ns() + REFRESH_RETRY_NS;
+            }
+            pthread_cond_broadcast(&envelope->rotated);
+            continue;
+        }
+        if (usable) break;
+        if (!key->refreshing) {
+            dek = NULL;  // 발급 실패 후 재요청 대기 중
+            break;
+        }
+        pthread_cond_wait(&envelope->rotated, &envelope->lock);
+    }
+    if (dek) {
+        *counter = dek->uses++;
+        dek->refs++;
+    }
+    pthread_mutex_unlock(&envelope->lock);
+    return dek;
+}
+
+void vault_envelope_free(void *buffer, size_t len) {
+    if (!buffer) return;
+    OPENSSL_cleanse(buffer, len);  // 큰 레코드도 바이트 단위 루프보다 빠르게 지움
+    free(buffer);
+}
+
+int vault_envelope_encrypt(vault_envelope_t *envelope, const char *key, const void *plaintext, size_t len,
+                           unsigned char **record, size_t *record_len) {
+    if (!envelope || !key || !key[0] || strlen(key) >= sizeof(((vault_envelope_key_t *)0)->name) ||
+        (!plaintext && len > 0) || !record || !record_len || len > (size_t)INT32_MAX) {
+        return -1;
+    }
+    *record = NULL;
+    *record_len = 0;
+
+    cipher_ctx_t *ctx = cipher_ctx_get();
+    uint64_t counter = 0;
+    vault_envelope_dek_t *dek = ctx ? acquire_encrypt(envelope, key, &counter) : NULL;
+    if (!dek) {
+        finish_call(envelope, NULL, 1, -1, len);
+        return -1;
+    }
+
+    size_t header = RECORD_MAGIC_SIZE + 2 + dek->wrapped_len;
+    size_t total = header + VAULT_ENVELOPE_NONCE_SIZE + len + VAULT_ENVELOPE_TAG_SIZE;
+    unsigned char *out = malloc(total);
+    int rc = -1;
+    if (out) {
+        memcpy(out, RECORD_MAGIC, RECORD_MAGIC_SIZE);
+        out[4] = (unsigned char)(dek->wrapped_len >> 8);
+        out[5] = (unsigned char)(dek->wrapped_len & 0xFF);
+        memcpy(out + 6, dek->wrapped, dek->wrapped_len);
+        unsigned char *nonce = out + header;
+        memcpy(nonce, dek->nonce_prefix, 4);
+        for (int i = 0; i < 8; i++) nonce[4 + i] = (unsigned char)(counter >> (56 - 8 * i));
+
+        unsigned char *ciphertext = nonce + VAULT_ENVELOPE_NONCE_SIZE;
+        int n = 0, final_len = 0;
+        if (EVP_EncryptInit_ex(ctx->encrypt, NULL, NULL, dek->plaintext, nonce) == 1 &&
+            EVP_EncryptUpdate(ctx->encrypt, NULL, &n, out, (int)header) == 1 &&
+            EVP_EncryptUpdate(ctx->encrypt, ciphertext, &n, plaintext, (int)len) == 1 &&
+            EVP_EncryptFinal_ex(ctx->encrypt, ciphertext + n, &final_len) == 1 &&
+            EVP_CIPHER_CTX_ctrl(ctx->encrypt, EVP_CTRL_GCM_GET_TAG, VAULT_ENVELOPE_TAG_SIZE, ciphertext + len) == 1) {
+            rc = 0;
+        }
+    }
+    finish_call(envelope, dek, 1, rc, len);
+
+    if (rc != 0) {
+        free(out);
+        return -1;
+    }
+    *record = out;
+    *record_len = total;
+    return 0;
+}
+
+// 복호화용 DEK 찾기 (캐시에 없으면 잠금 밖에서 풀어 캐시에 추가)
+static vault_envelope_dek_t *acquire_decrypt(vault_envelope_t *envelope, const char *key, const char *wrapped,
+                                             size_t wrapped_len) {
+    pthread_mutex_lock(&envelope->lock);
+    vault_envelope_dek_t *dek = cache_find(envelope, key, wrapped, wrapped_len);
+    if (dek) {
+        envelope->stats.cache_hits++;
+        lru_unlink(envelope, dek);
+        lru_push_front(envelope, dek);
+        dek->refs++;
+        pthread_mutex_unlock(&envelope->lock);
+        return dek;
+    }
+    envelope->stats.unwrap_requests++;
+    pthread_mutex_unlock(&envelope->lock);
+
+    vault_envelope_dek_t *fresh = unwrap_datakey(envelope, key, wrapped);
+    if (!fresh) return NULL;
+
+    pthread_mutex_lock(&envelope->lock);
+    // 같은 DEK를 다른 호출이 먼저 풀었으면 그쪽을 사용 (캐시에서 바로 내보내지지 않도록 먼저 참조)
+    dek = cache_find(envelope, key, wrapped, wrapped_len);
+    if (dek) {
+        dek_free(envelope, fresh);
+        dek->refs++;
+    } else {
+        dek = fresh;
+        dek->refs++;
+        cache_insert(envelope, dek);
+    }
+    pthread_mutex_unlock(&envelope->lock);
+    return dek;
+}
+
+int vault_envelope_decrypt(vault_envelope_t *envelope, const char *key, const unsigned char *record,
+                           size_t record_len, unsigned char **plaintext, size_t *len) {
+    if (!envelope || !key || !key[0] || strlen(key) >= sizeof(((vault_envelope_key_t *)0)->name) || !record ||
+        !plaintext || !len) {
+        return -1;
+    }
+    *plaintext = NULL;
+    *len = 0;
+
+    int rc = -1;
+    vault_envelope_dek_t *dek = NULL;
+    unsigned char *out = NULL;
+    size_t wrapped_len = 0;
+    size_t header = 0;
+    size_t body = 0;
+    char wrapped[VAULT_ENVELOPE_MAX_WRAPPED + 1];
+    cipher_ctx_t *ctx = cipher_ctx_get();
+
+    if (!ctx || record_len < RECORD_MAGIC_SIZE + 2 + VAULT_ENVELOPE_NONCE_SIZE + VAULT_ENVELOPE_TAG_SIZE ||
+        memcmp(record, RECORD_MAGIC, RECORD_MAGIC_SIZE) != 0) {
+        goto done;
+    }
+    wrapped_len = ((size_t)record[4] << 8) | record[5];
+    header = RECORD_MAGIC_SIZE + 2 + wrapped_len;
+    if (wrapped_len == 0 || wrapped_len > VAULT_ENVELOPE_MAX_WRAPPED ||
+        record_len < header + VAULT_ENVELOPE_NONCE_SIZE + VAULT_ENVELOPE_TAG_SIZE) {
+        goto done;
+    }
+    memcpy(wrapped, record + 6, wrapped_len);
+    wrapped[wrapped_len] = '\0';
+    body = record_len - header - VAULT_ENVELOPE_NONCE_SIZE - VAULT_ENVELOPE_TAG_SIZE;
+    if (body > (size_t)INT32_MAX) goto done;
+
+    dek = acquire_decrypt(envelope, key, wrapped, wrapped_len);
+    out = dek ? malloc(body + 1) : NULL;
+    if (out) {
+        const unsigned char *nonce = record + header;
+        const unsigned char *ciphertext = nonce + VAULT_ENVELOPE_NONCE_SIZE;
+        int n = 0, final_len = 0;
+        if (EVP_DecryptInit_ex(ctx->decrypt, NULL, NULL, dek->plaintext, nonce) == 1 &&
+            EVP_DecryptUpdate(ctx->decrypt, NULL, &n, record, (int)header) == 1 &&
+            EVP_DecryptUpdate(ctx->decrypt, out, &n, ciphertext, (int)body) == 1 &&
+            EVP_CIPHER_CTX_ctrl(ctx->decrypt, EVP_CTRL_GCM_SET_TAG, VAULT_ENVELOPE_TAG_SIZE,
+                                (void *)(ciphertext + body)) == 1 &&
+            EVP_DecryptFinal_ex(ctx->decrypt, out + n, &final_len) == 1) {
+            out[body] = '\0';
+            rc = 0;
+        }
+    }
+
+done:
+    finish_call(envelope, dek, 0, rc, body);
+
+    if (rc != 0) {
+        if (out) vault_envelope_free(out, body + 1);
+        VAULT_LOG_DEBUG("Envelope record rejected (%zu bytes)", record_len);
+        return -1;
+    }
+    *plaintext = out;
+    *len = body;
+    return 0;
+}
+
+int vault_envelope_init(vault_envelope_t *envelope, vault_client_t *client) {
+    if (!envelope || !client || !client->config) return -1;
+
+    memset(envelope, 0, sizeof(*envelope));
+    const app_config_t *config = client->config;
+    envelope->client = client;
+    snprintf(envelope->mount, sizeof(envelope->mount), "%s-transit", config->entity);
+    envelope->max_uses = config->transit.envelope_max_uses > 0 ? (uint64_t)config->transit.envelope_max_uses : 1;
+    envelope->max_age_ns = (uint64_t)(config->transit.envelope_max_age > 0 ? config->transit.envelope_max_age : 1) *
+                           1000000000ULL;
+    int cache_size = config->transit.envelope_cache;
+    if (cache_size < 1) cache_size = 1;
+    if (cache_size > VAULT_ENVELOPE_MAX_CACHE) cache_size = VAULT_ENVELOPE_MAX_CACHE;
+    envelope->cache_size = (size_t)cache_size;
+
+    // 캐시에서 내보냈지만 아직 사용 중인 DEK와 키별 현재 DEK, 중복으로 푼 DEK를 위한 여유
+    // (키가 더 많아 칸이 모자라면 영역이 늘어나며, 늘리지 못하면 dek_new가 실패하여 해당 호출만 실패)
+    if (vault_secure_arena_init(&envelope->arena, VAULT_ENVELOPE_KEY_SIZE, envelope->cache_size * 2 + 64) != 0) {
+        VAULT_LOG_ERROR("Failed to allocate envelope key arena");
+        return -1;
+    }
+    envelope->stats.locked = envelope->arena.locked;
+    pthread_mutex_init(&envelope->lock, NULL);
+    pthread_cond_init(&envelope->rotated, NULL);
+    return 0;
+}
+
+void vault_envelope_destroy(vault_envelope_t *envelope) {
+    if (!envelope || !envelope->client) return;
+
+    while (envelope->lru_head) {
+        vault_envelope_dek_t *dek = envelope->lru_head;
+        lru_unlink(envelope, dek);
+        dek_free(envelope, dek);
+    }
+    while (envelope->keys) {
+        vault_envelope_key_t *next = envelope->keys->next;
+        free(envelope->keys);
+        envelope->keys = next;
+    }
+    vault_secure_arena_destroy(&envelope->arena);
+    pthread_cond_destroy(&envelope->rotated);
+    pthread_mutex_destroy(&envelope->lock);
+    envelope->client = NULL;
+}
+
+void vault_envelope_get_stats(vault_envelope_t *envelope, vault_envelope_stats_t *stats) {
+    pthread_mutex_lock(&envelope->lock);
+    *stats = envelope->stats;
+    pthread_mutex_unlock(&envelope->lock);
+}
@@ -0,0 +1,80 @@
+#ifndef VAULT_ENVELOPE_H
+#define VAULT_ENVELOPE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <pthread.h>
+#include "vault_client.h"
+#include "vault_secure.h"
+
+// Transit 데이터 키를 이용한 로컬 envelope 암호화
+// <entity>-transit/datakey/plaintext/<key>로 받은 데이터 키(DEK)를 잠긴 메모리 영역에 두고
+// 레코드를 로컬에서 AES-256-GCM으로 암호화합니다 (Vault 요청은 DEK를 새로 받을 때만).
+// DEK는 envelope_max_uses번 암호화하거나 envelope_max_age초가 지나면 새로 받으며,
+// 이전 DEK는 복호화용으로 캐시에 남습니다.
+// 복호화는 레코드에 담긴 감싼 DEK와 호출자가 지정한 키 이름으로 캐시를 찾고 (다른 키로 푼 DEK는 쓰지 않음),
+// 없으면 <entity>-transit/decrypt/<key>로 한 번 풀어 캐시합니다.
+//
+// 레코드 형식 (AAD는 nonce 앞까지 전체)
+//   "VEK1" | 감싼 DEK 길이 (2바이트, big endian) | 감싼 DEK ("vault:v1:...") | nonce 12바이트 | 암호문 | tag 16바이트
+// nonce는 DEK마다 무작위 4바이트 + 사용 횟수 8바이트이므로 DEK 하나 안에서 겹치지 않습니다.
+
+#define VAULT_ENVELOPE_KEY_SIZE 32
+#define VAULT_ENVELOPE_NONCE_SIZE 12
+#define VAULT_ENVELOPE_TAG_SIZE 16
+#define VAULT_ENVELOPE_MAX_WRAPPED 1024
+#define VAULT_ENVELOPE_MAX_CACHE 4096
+
+typedef struct vault_envelope_dek vault_envelope_dek_t;
+typedef struct vault_envelope_key vault_envelope_key_t;
+
+typedef struct {
+    uint64_t encryptions;
+    uint64_t decryptions;
+    uint64_t bytes_encrypted;     // 평문 바이트
+    uint64_t bytes_decrypted;
+    uint64_t failures;            // 인자 오류, DEK 없음, 인증 실패
+    uint64_t datakey_requests;    // datakey/plaintext 요청 (실패 포함)
+    uint64_t unwrap_requests;     // 복호화 캐시 미스로 보낸 decrypt 요청 (실패 포함)
+    uint64_t cache_hits;          // 캐시에 있던 DEK로 복호화
+    uint64_t rotations;           // 사용 횟수/시간 한도로 DEK 교체
+    size_t cached;                // 캐시에 있는 DEK 수 (현재 암호화용 포함)
+    int locked;                   // DEK 영역 mlock 여부
+} vault_envelope_stats_t;
+
+typedef struct {
+    vault_client_t *client;
+    char mount[192];              // <entity>-transit
+    uint64_t max_uses;            // DEK 하나로 암호화할 최대 레코드 수
+    uint64_t max_age_ns;          // DEK 하나를 암호화에 쓸 최대 시간
+    size_t cache_size;            // 캐시에 남길 DEK 수 (키별 현재 DEK 제외)
+    size_t current_keys;          // 현재 암호화용 DEK가 있는 키 수
+
+    vault_secure_arena_t arena;   // 평문 DEK 보관
+    pthread_mutex_t lock;         // 키/캐시/통계 보호
+    pthread_cond_t rotated;       // DEK 교체 완료 (교체를 기다리는 암호화 호출 깨우기)
+    vault_envelope_key_t *keys;
+    vault_envelope_dek_t *lru_head;   // 최근 사용 순
+    vault_envelope_dek_t *lru_tail;
+    vault_envelope_stats_t stats;
+} vault_envelope_t;
+
+// client->config->transit의 envelope_max_uses/envelope_max_age/envelope_cache로 초기화
+int vault_envelope_init(vault_envelope_t *envelope, vault_client_t *client);
+void vault_envelope_destroy(vault_envelope_t *envelope);
+
+// 평문 len바이트를 레코드로 암호화 (*record는 암호문뿐이므로 free로 해제)
+int vault_envelope_encrypt(vault_envelope_t *envelope, const char *key, const void *plaintext, size_t len,
+                           unsigned char **record, size_t *record_len);
+
+// 레코드 복호화 (*plaintext는 len바이트 뒤에 NUL이 붙어 있음, vault_envelope_free로 해제)
+// 인증 tag가 맞지 않거나 DEK를 풀 수 없으면 -1
+int vault_envelope_decrypt(vault_envelope_t *envelope, const char *key, const unsigned char *record,
+                           size_t record_len, unsigned char **plaintext, size_t *len);
+
+// 복호화 결과 해제 (평문을 지운 뒤 해제)
+void vault_envelope_free(void *buffer, size_t len);
+
+void vault_envelope_get_stats(vault_envelope_t *envelope, vault_envelope_stats_t *stats);
+
+#endif
@@ -0,0 +1,441 @@
+#define _POSIX_C_SOURCE 200809L
+#include "vault_events.h"
+#include "vault_ws.h"
+#include <curl/curl.h>
+#include <errno.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <time.h>
+
+#define EVENTS_POLL_MS 250  // 종료 요청 확인 주기
+
+// 이벤트 스트림 연결 (CONNECT_ONLY 핸들 + 수신 버퍼)
+typedef struct {
+    CURL *curl;
+    curl_socket_t fd;
+    uint8_t *buffer;  // 아직 처리하지 않은 수신 바이트
+    size_t used;
+    size_t capacity;
+} events_conn_t;
+
+static int is_stopping(vault_events_t *events) {
+    return __atomic_load_n(&events->stopping, __ATOMIC_ACQUIRE);
+}
+
+static int wait_socket(curl_socket_t fd, short what, int timeout_ms) {
+    struct pollfd pfd;
+    pfd.fd = fd;
+    pfd.events = what;
+    pfd.revents = 0;
+    return poll(&pfd, 1, timeout_ms);
+}
+
+// 전체 전송 (소켓이 가득 차면 쓰기 가능할 때까지 대기)
+static int conn_send(vault_events_t *events, events_conn_t *conn, const void *data, size_t len) {
+    const uint8_t *p = (const uint8_t *)data;
+    while (len > 0) {
+        size_t sent = 0;
+        CURLcode res = curl_easy_send(conn->curl, p, len, &sent);
+        if (res == CURLE_AGAIN) {
+            if (is_stopping(events)) return -1;
+            wait_socket(conn->fd, POLLOUT, EVENTS_POLL_MS);
+            continue;
+        }
+        if (res != CURLE_OK) return -1;
+        p += sent;
+        len -= sent;
+    }
+    return 0;
+}
+
+// 수신 (받은 바이트 수, 시간 초과 시 0, 연결 종료/오류 시 -1)
+static long conn_recv(events_conn_t *conn, int timeout_ms) {
+    if (conn->used >= conn->capacity) return -1;
+
+    size_t got = 0;
+    CURLcode res = curl_easy_recv(conn->curl, conn->buffer + conn->used, conn->capacity - conn->used, &got);
+    if (res == CURLE_AGAIN) {
+        if (wait_socket(conn->fd, POLLIN, timeout_ms) <= 0) return 0;
+        res = curl_easy_recv(conn->curl, conn->buffer + conn->used, conn->capacity - conn->used, &got);
+        if (res == CURLE_AGAIN) return 0;
+    }
+    if (res != CURLE_OK || got == 0) return -1;
+    conn->used += got;
+    return (long)got;
+}
+
+// 클라이언트 프레임 전송 (클라이언트 → 서버 프레임은 항상 마스킹)
+static int send_frame(vault_events_t *events, events_conn_t *conn, int opcode, const uint8_t *payload, size_t length) {
+    uint8_t frame[VAULT_WS_MAX_HEADER + 125];
+    uint8_t mask[4];
+    uint32_t seed = (uint32_t)vault_metrics_now_ns() * 2654435761u;
+    memcpy(mask, &seed, sizeof(mask));
+
+    if (length > 125) length = 125;  // 제어 프레임만 전송
+    size_t n = vault_ws_encode_header(frame, opcode, length, mask);
+    memcpy(frame + n, payload, length);
+    vault_ws_apply_mask(frame + n, length, mask, 0);
+    return conn_send(events, conn, frame, n + length);
+}
+
+// 응답 헤더 값 찾기 (대소문자 무시)
+static int header_value(const char *head, const char *name, char *value, size_t size) {
+    size_t name_len = strlen(name);
+    const char *line = strstr(head, "\r\n");
+    while (line) {
+        line += 2;
+        if (strncasecmp(line, name, name_len) == 0 && line[name_len] == ':') {
+            const char *v = line + name_len + 1;
+            while (*v == ' ') v++;
+            size_t len = strcspn(v, "\r\n");
+            if (len >= size) len = size - 1;
+            memcpy(value, v, len);
+            value[len] = '\0';
+            return 0;
+        }
+        line = strstr(line, "\r\n");
+    }
+    return -1;
+}
+
+// 연결 및 WebSocket 업그레이드
+static int events_connect(vault_events_t *events, events_conn_t *conn) {
+    vault_client_t *client = events->client;
+
+    conn->curl = curl_easy_init();
+    if (!conn->curl) return -1;
+
+    char url[512];
+    snprintf(url, sizeof(url), "%s/v1/sys/events/subscribe/%s?json=true", client->vault_url, VAULT_EVENTS_TYPE);
+    curl_easy_setopt(conn->curl, CURLOPT_URL, url);
+    curl_easy_setopt(conn->curl, CURLOPT_CONNECT_ONLY, 1L);
+    curl_easy_setopt(conn->curl, CURLOPT_CONNECTTIMEOUT, (long)client->config->http_timeout);
+    curl_easy_setopt(conn->curl, CURLOPT_SSL_VERIFYPEER, 0L);
+    curl_easy_setopt(conn->curl, CURLOPT_SSL_VERIFYHOST, 0L);
+
+    CURLcode res = curl_easy_perform(conn->curl);
+    if (res != CURLE_OK) {
+        VAULT_LOG_DEBUG("Event stream connect failed: %s", curl_easy_strerror(res));
+        return -1;
+    }
+    if (curl_easy_getinfo(conn->curl, CURLINFO_ACTIVESOCKET, &conn->fd) != CURLE_OK ||
+        conn->fd == CURL_SOCKET_BAD) {
+        return -1;
+    }
+
+    // 호스트와 기본 경로 분리 (http://host:port/prefix)
+    const char *host = strstr(client->vault_url, "://");
+    host = host ? host + 3 : client->vault_url;
+    int host_len = (int)strcspn(host, "/");
+    const char *prefix = host + host_len;
+    int prefix_len = (int)strlen(prefix);
+    while (prefix_len > 0 && prefix[prefix_len - 1] == '/') prefix_len--;
+
+    vault_token_t *token = vault_token_acquire(client);
+    if (!token) return -1;
+
+    char key[VAULT_WS_KEY_SIZE];
+    vault_ws_make_key(key);
+
+    // 네임스페이스가 있으면 해당 네임스페이스의 이벤트만 구독
+    const char *ns = client->config->vault_namespace;
+    char request[2048];
+    int n = snprintf(request, sizeof(request),
+                     "GET %.*s/v1/sys/events/subscribe/%s?json=true HTTP/1.1\r\n"
+                     "Host: %.*s\r\n"
+                     "Upgrade: websocket\r\n"
+                     "Connection: Upgrade\r\n"
+                     "Sec-WebSocket-Key: %s\r\n"
+                     "Sec-WebSocket-Version: 13\r\n"
+                     "X-Vault-Token: %s\r\n"
+                     "%s%s%s"
+                     "\r\n",
+                     prefix_len, prefix, VAULT_EVENTS_TYPE, host_len, host, key, token->token,
+                     ns[0] ? "X-Vault-Namespace: " : "", ns, ns[0] ? "\r\n" : "");
+    vault_token_release(token);
+    int sent = (n > 0 && (size_t)n < sizeof(request)) ? conn_send(events, conn, request, (size_t)n) : -1;
+    memset(request, 0, sizeof(request));  // 토큰이 스택에 남지 않도록
+    if (sent != 0) return -1;
+
+    // 응답 헤더 수신 (업그레이드 직후 도착한 프레임은 버퍼에 남김)
+    int waited_ms = 0;
+    char *head_end;
+    for (;;) {
+        conn->buffer[conn->used] = '\0';
+        if ((head_end = strstr((char *)conn->buffer, "\r\n\r\n"))) break;
+        if (is_stopping(events) || waited_ms >= client->config->http_timeout * 1000) return -1;
+        long got = conn_recv(conn, EVENTS_POLL_MS);
+        if (got < 0) return -1;
+        if (got == 0) waited_ms += EVENTS_POLL_MS;
+    }
+    size_t head_len = (size_t)(head_end - (char *)conn->buffer) + 4;
+    char saved = conn->buffer[head_len];
+    conn->buffer[head_len] = '\0';
+
+    int status = 0;
+    char accept[64] = "";
+    char expected[VAULT_WS_ACCEPT_SIZE];
+    sscanf((char *)conn->buffer, "HTTP/1.%*d %d", &status);
+    header_value((char *)conn->buffer, "Sec-WebSocket-Accept", accept, sizeof(accept));
+    vault_ws_accept_key(key, expected);
+
+    conn->buffer[head_len] = saved;
+    memmove(conn->buffer, conn->buffer + head_len, conn->used - head_len);
+    conn->used -= head_len;
+
+    if (status != 101) {
+        VAULT_LOG_WARN("⚠️ Event subscription rejected (HTTP %d)", status);
+        return -1;
+    }
+    if (strcmp(accept, expected) != 0) {
+        VAULT_LOG_WARN("⚠️ Event subscription handshake failed (invalid Sec-WebSocket-Accept)");
+        return -1;
+    }
+    return 0;
+}
+
+// 이벤트 메시지 처리: 클라이언트 KV 경로나 경로 캐시에 있는 경로의 쓰기 이벤트면 갱신 요청
+static void handle_event(vault_events_t *events, const char *message) {
+    json_object *root = json_tokener_parse(message);
+    if (!root) {
+        VAULT_LOG_WARN("⚠️ Failed to parse event message");
+        return;
+    }
+
+    const char *path = NULL;
+    long version = -1;
+    json_object *data, *event, *metadata, *value;
+    if (json_object_object_get_ex(root, "data", &data) &&
+        json_object_object_get_ex(data, "event", &event) &&
+        json_object_object_get_ex(event, "metadata", &metadata)) {
+        if (json_object_object_get_ex(metadata, "path", &value)) {
+            path = json_object_get_string(value);
+        }
+        // current_version은 문자열로 전달됨
+        if (json_object_object_get_ex(metadata, "current_version", &value)) {
+            version = atol(json_object_get_string(value));
+        }
+    }
+
+    // 프리페치로 경로 캐시에 올라간 경로도 대상 (스트림 연결 중에는 폴링이 멈추므로)
+    int matched = path && strcmp(path, events->client->kv_path) == 0;
+    int cached = path && vault_path_cache_invalidate(&events->client->kv_paths, path, version) == 0;
+    if (matched) {
+        VAULT_LOG_INFO("📡 KV write event: %s (version %ld)", path, version);
+    } else if (cached) {
+        VAULT_LOG_INFO("📡 KV write event for cached path: %s (version %ld)", path, version);
+    } else {
+        VAULT_LOG_DEBUG("KV write event for other path ignored: %s", path ? path : "(none)");
+    }
+
+    pthread_mutex_lock(&events->lock);
+    events->stats.events++;
+    if (cached) events->stats.invalidated++;
+    if (matched || cached) {
+        if (matched) events->stats.matched++;
+        events->stats.last_version = version;
+        events->pending = 1;
+        pthread_cond_broadcast(&events->cond);
+    }
+    pthread_mutex_unlock(&events->lock);
+    json_object_put(root);
+}
+
+// 프레임 수신 루프 (연결이 끊기거나 종료 요청 시 반환)
+static void events_read_loop(vault_events_t *events, events_conn_t *conn) {
+    char *message = malloc(VAULT_EVENTS_MAX_MESSAGE + 1);
+    size_t message_len = 0;
+    if (!message) return;
+
+    while (!is_stopping(events)) {
+        vault_ws_frame_t frame = {0};
+        int header = vault_ws_decode_header(conn->buffer, conn->used, &frame);
+        // 헤더가 두 번의 수신에 걸쳐 도착하면 0 (frame.length는 아직 채워지지 않음)
+        if (header == 0) {
+            if (conn_recv(conn, EVENTS_POLL_MS) < 0) break;
+            continue;
+        }
+        if (header < 0 || frame.length > VAULT_EVENTS_MAX_MESSAGE) {
+            VAULT_LOG_WARN("⚠️ Invalid event stream frame");
+            break;
+        }
+
+        // 프레임 전체가 도착할 때까지 수신
+        if (conn->used < (size_t)header + frame.length) {
+            if (conn_recv(conn, EVENTS_POLL_MS) < 0) break;
+            continue;
+        }
+
+        uint8_t *payload = conn->buffer + header;
+        size_t length = (size_t)frame.length;
+        if (frame.masked) {
+            vault_ws_apply_mask(payload, length, frame.mask, 0);
+        }
+
+        int closed = 0;
+        switch (frame.opcode) {
+            case VAULT_WS_OP_TEXT:
+            case VAULT_WS_OP_BINARY:
+                message_len = 0;
+                /* fall through */
+            case VAULT_WS_OP_CONTINUATION:
+                if (message_len + length > VAULT_EVENTS_MAX_MESSAGE) {
+                    VAULT_LOG_WARN("⚠️ Event message too large");
+                    closed = 1;
+                    break;
+                }
+                memcpy(message + message_len, payload, length);
+                message_len += length;
+                if (frame.fin) {
+                    message[message_len] = '\0';
+                    handle_event(events, message);
+                    message_len = 0;
+                }
+                break;
+            case VAULT_WS_OP_PING:
+                if (send_frame(events, conn, VAULT_WS_OP_PONG, payload, length) != 0) closed = 1;
+                break;
+            case VAULT_WS_OP_CLOSE:
+                send_frame(events, conn, VAULT_WS_OP_CLOSE, payload, length);
+                closed = 1;
+                break;
+            default:
+                break;
+        }
+        if (closed) break;
+
+        size_t consumed = (size_t)header + length;
+        memmove(conn->buffer, conn->buffer + consumed, conn->used - consumed);
+        conn->used -= consumed;
+    }
+
+    if (is_stopping(events)) {
+        send_frame(events, conn, VAULT_WS_OP_CLOSE, (const uint8_t *)"\x03\xe8", 2);  // 1000 정상 종료
+    }
+    free(message);
+}
+
+static void *events_thread(void *arg) {
+    vault_events_t *events = (vault_events_t *)arg;
+    int backoff = 1;
+
+    while (!is_stopping(events)) {
+        events_conn_t conn;
+        memset(&conn, 0, sizeof(conn));
+        conn.fd = CURL_SOCKET_BAD;
+        conn.capacity = VAULT_EVENTS_MAX_MESSAGE + VAULT_WS_MAX_HEADER;
+        conn.buffer = malloc(conn.capacity + 1);
+
+        if (conn.buffer && events_connect(events, &conn) == 0) {
+            // 연결 직후 한 번 갱신하여 연결 전/끊긴 동안의 변경 반영
+            pthread_mutex_lock(&events->lock);
+            events->connected = 1;
+            events->pending = 1;
+            events->stats.connects++;
+            pthread_cond_broadcast(&events->cond);
+            pthread_mutex_unlock(&events->lock);
+            VAULT_LOG_INFO("📡 Event stream connected (%s), KV polling paused", VAULT_EVENTS_TYPE);
+            backoff = 1;
+
+            events_read_loop(events, &conn);
+
+            pthread_mutex_lock(&events->lock);
+            events->connected = 0;
+            if (!is_stopping(events)) events->stats.disconnects++;
+            pthread_mutex_unlock(&events->lock);
+            if (!is_stopping(events)) {
+                VAULT_LOG_WARN("⚠️ Event stream disconnected, falling back to KV polling");
+            }
+        } else {
+            pthread_mutex_lock(&events->lock);
+            events->stats.failures++;
+            pthread_mutex_unlock(&events->lock);
+        }
+
+        if (conn.curl) curl_easy_cleanup(conn.curl);
+        free(conn.buffer);
+
+        // 재연결 대기 (지수 백오프)
+        for (int waited = 0; waited < backoff * 1000 && !is_stopping(events); waited += EVENTS_POLL_MS) {
+            struct timespec ts = {0, EVENTS_POLL_MS * 1000000L};
+            nanosleep(&ts, NULL);
+        }
+        backoff = backoff * 2 > VAULT_EVENTS_MAX_BACKOFF ? VAULT_EVENTS_MAX_BACKOFF : backoff * 2;
+    }
+    return NULL;
+}
+
+void vault_events_init(vault_events_t *events) {
+    memset(events, 0, sizeof(*events));
+    events->stats.last_version = -1;
+    pthread_mutex_init(&events->lock, NULL);
+
+    // 시계 변경에 영향받지 않도록 단조 시계로 대기
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&events->cond, &attr);
+    pthread_condattr_destroy(&attr);
+}
+
+int vault_events_start(vault_events_t *events, vault_client_t *client) {
+    if (!events || !client || events->running || !client->kv_path[0]) return -1;
+
+    events->client = client;
+    __atomic_store_n(&events->stopping, 0, __ATOMIC_RELEASE);
+    if (pthread_create(&events->thread, NULL, events_thread, events) != 0) {
+        return -1;
+    }
+    events->running = 1;
+    return 0;
+}
+
+void vault_events_stop(vault_events_t *events) {
+    if (!events || !events->running) return;
+
+    __atomic_store_n(&events->stopping, 1, __ATOMIC_RELEASE);
+    pthread_join(events->thread, NULL);
+    events->running = 0;
+}
+
+void vault_events_destroy(vault_events_t *events) {
+    vault_events_stop(events);
+    pthread_cond_destroy(&events->cond);
+    pthread_mutex_destroy(&events->lock);
+}
+
+int vault_events_connected(vault_events_t *events) {
+    pthread_mutex_lock(&events->lock);
+    int connected = events->connected;
+    pthread_mutex_unlock(&events->lock);
+    return connected;
+}
+
+int vault_events_wait(vault_events_t *events, int timeout_ms) {
+    struct timespec deadline;
+    clock_gettime(CLOCK_MONOTONIC, &deadline);
+    deadline.tv_sec += timeout_ms / 1000;
+    deadline.tv_nsec += (long)(timeout_ms % 1000) * 1000000L;
+    if (deadline.tv_nsec >= 1000000000L) {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000L;
+    }
+
+    pthread_mutex_lock(&events->lock);
+    while (!events->pending) {
+        if (pthread_cond_timedwait(&events->cond, &events->lock, &deadline) == ETIMEDOUT) break;
+    }
+    int pending = events->pending;
+    events->pending = 0;
+    pthread_mutex_unlock(&events->lock);
+    return pending;
+}
+
+void vault_events_get_stats(vault_events_t *events, vault_events_stats_t *stats) {
+    pthread_mutex_lock(&events->lock);
+    *stats = events->stats;
+    pthread_mutex_unlock(&events->lock);
+}
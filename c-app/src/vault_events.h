@@ -0,0 +1,58 @@
+#ifndef VAULT_EVENTS_H
+#define VAULT_EVENTS_H
+
+#include <stdint.h>
+#include <pthread.h>
+#include "vault_client.h"
+
+// Vault 이벤트 구독 (sys/events/subscribe/kv-v2/data-write, WebSocket)
+// 백그라운드 스레드가 이벤트 스트림을 유지하며 클라이언트의 KV 경로에 대한
+// kv-v2/data-write 이벤트가 도착하면 대기 중인 KV 갱신 스레드를 깨웁니다.
+// 프리페치로 경로 캐시에 올라간 경로의 이벤트는 해당 항목을 만료시키고 같은 방식으로 깨웁니다.
+// 스트림이 연결되어 있는 동안 KV 갱신 스레드는 폴링하지 않고, 끊기면 폴링 간격으로
+// 돌아가며 재연결 후에는 끊긴 동안 놓친 변경을 반영하도록 한 번 갱신합니다.
+//
+// 전송은 libcurl(CONNECT_ONLY)로 TCP/TLS 연결만 맺고 업그레이드 요청과
+// 프레임 처리는 직접 수행합니다 (libcurl WebSocket 지원 여부와 무관).
+
+#define VAULT_EVENTS_TYPE "kv-v2/data-write"
+#define VAULT_EVENTS_MAX_MESSAGE 65536  // 이벤트 메시지 최대 크기 (초과 시 재연결)
+#define VAULT_EVENTS_MAX_BACKOFF 30     // 재연결 대기 최대 시간 (초)
+
+typedef struct {
+    uint64_t connects;     // 스트림 연결 성공
+    uint64_t failures;     // 연결/핸드셰이크 실패
+    uint64_t disconnects;  // 연결 후 끊김
+    uint64_t events;       // 수신한 이벤트
+    uint64_t matched;      // KV 경로가 일치한 이벤트 (갱신 요청)
+    uint64_t invalidated;  // 경로 캐시 항목을 만료시킨 이벤트 (갱신 요청)
+    long last_version;     // 마지막으로 수신한 이벤트의 current_version
+} vault_events_stats_t;
+
+typedef struct {
+    vault_client_t *client;
+    pthread_t thread;
+    int running;
+    int stopping;  // 종료 요청 (원자적 접근)
+
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    int connected;  // 스트림 연결 상태
+    int pending;    // KV 갱신 요청 (이벤트 수신 또는 재연결)
+    vault_events_stats_t stats;
+} vault_events_t;
+
+// 상태 초기화 (vault_events_start 전에 호출, 시작하지 않아도 vault_events_wait 사용 가능)
+void vault_events_init(vault_events_t *events);
+int vault_events_start(vault_events_t *events, vault_client_t *client);
+void vault_events_stop(vault_events_t *events);
+void vault_events_destroy(vault_events_t *events);
+
+int vault_events_connected(vault_events_t *events);
+
+// KV 갱신 요청 대기: 요청이 있으면 소비하고 1, timeout_ms 동안 없으면 0 반환
+int vault_events_wait(vault_events_t *events, int timeout_ms);
+
+void vault_events_get_stats(vault_events_t *events, vault_events_stats_t *stats);
+
+#endif
@@ -0,0 +1,184 @@
+#define _POSIX_C_SOURCE 200809L
+#include "vault_limit.h"
+#include "vault_metrics.h"
+#include <errno.h>
+#include <math.h>
+#include <string.h>
+#include <time.h>
+
+void vault_limiter_init(vault_limiter_t *limiter) {
+    memset(limiter, 0, sizeof(*limiter));
+    pthread_mutex_init(&limiter->lock, NULL);
+    // 시계 변경에 영향받지 않도록 단조 시계로 대기
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    for (int p = 0; p < VAULT_PRIORITY_COUNT; p++) {
+        pthread_cond_init(&limiter->ready[p], &attr);
+    }
+    pthread_condattr_destroy(&attr);
+}
+
+void vault_limiter_destroy(vault_limiter_t *limiter) {
+    for (int p = 0; p < VAULT_PRIORITY_COUNT; p++) {
+        pthread_cond_destroy(&limiter->ready[p]);
+    }
+    pthread_mutex_destroy(&limiter->lock);
+}
+
+void vault_limiter_configure(vault_limiter_t *limiter, int min_limit, int initial, int max_limit) {
+    if (min_limit < 1) min_limit = 1;
+    if (max_limit < min_limit) max_limit = min_limit;
+    if (initial < min_limit) initial = min_limit;
+    if (initial > max_limit) initial = max_limit;
+
+    pthread_mutex_lock(&limiter->lock);
+    limiter->min_limit = min_limit;
+    limiter->max_limit = max_limit;
+    limiter->limit = initial;
+    limiter->probe_at = vault_metrics_now_ns() + VAULT_LIMIT_PROBE_NS;
+    limiter->enabled = 1;
+    pthread_mutex_unlock(&limiter->lock);
+}
+
+// 우선순위별 최대 동시 요청 수 (잠금 안에서 호출)
+static int limiter_capacity(const vault_limiter_t *limiter, int priority) {
+    int limit = (int)limiter->limit;
+    if (priority == VAULT_PRIORITY_CRITICAL) return limit + VAULT_LIMIT_CRITICAL_RESERVE;
+    if (priority == VAULT_PRIORITY_BULK) return limit - limit / 4 > 0 ? limit - limit / 4 : 1;
+    return limit;
+}
+
+// 자리가 있고 상위 우선순위가 기다리지 않으면 시작 가능
+static int limiter_admit(const vault_limiter_t *limiter, int priority) {
+    for (int p = 0; p < priority; p++) {
+        if (limiter->stats.waiting[p] > 0) return 0;
+    }
+    return limiter->stats.in_flight < limiter_capacity(limiter, priority);
+}
+
+// 가장 높은 대기 우선순위를 깨움 (그 우선순위가 시작할 수 없으면 하위도 시작할 수 없음)
+static void limiter_wake(vault_limiter_t *limiter) {
+    for (int p = 0; p < VAULT_PRIORITY_COUNT; p++) {
+        if (limiter->stats.waiting[p] > 0) {
+            if (limiter->stats.in_flight < limiter_capacity(limiter, p)) {
+                pthread_cond_broadcast(&limiter->ready[p]);
+            }
+            return;
+        }
+    }
+}
+
+int vault_limiter_acquire(vault_limiter_t *limiter, vault_priority_t priority, int timeout_ms) {
+    // 활성화는 요청을 보내기 전에만 바뀌므로 잠금 없이 확인
+    if (!limiter || !limiter->enabled) return 0;
+
+    pthread_mutex_lock(&limiter->lock);
+    vault_limiter_stats_t *stats = &limiter->stats;
+    if (!limiter_admit(limiter, priority)) {
+        if (timeout_ms <= 0) {
+            pthread_mutex_unlock(&limiter->lock);
+            return -1;
+        }
+        struct timespec deadline;
+        clock_gettime(CLOCK_MONOTONIC, &deadline);
+        deadline.tv_sec += timeout_ms / 1000;
+        deadline.tv_nsec += (long)(timeout_ms % 1000) * 1000000L;
+        if (deadline.tv_nsec >= 1000000000L) {
+            deadline.tv_sec++;
+            deadline.tv_nsec -= 1000000000L;
+        }
+
+        uint64_t start = vault_metrics_now_ns();
+        stats->waiting[priority]++;
+        stats->delayed[priority]++;
+        int waiting = 0;
+        for (int p = 0; p < VAULT_PRIORITY_COUNT; p++) waiting += stats->waiting[p];
+        if (waiting > stats->peak_waiting) stats->peak_waiting = waiting;
+
+        int timed_out = 0;
+        while (!limiter_admit(limiter, priority)) {
+            if (pthread_cond_timedwait(&limiter->ready[priority], &limiter->lock, &deadline) == ETIMEDOUT &&
+                !limiter_admit(limiter, priority)) {
+                timed_out = 1;
+                break;
+            }
+        }
+        stats->waiting[priority]--;
+        double waited = (double)(vault_metrics_now_ns() - start) / 1e6;
+        if (waited > stats->max_wait_ms[priority]) stats->max_wait_ms[priority] = waited;
+        if (timed_out) {
+            stats->shed[priority]++;
+            limiter_wake(limiter);  // 하위 우선순위를 막고 있었을 수 있음
+            pthread_mutex_unlock(&limiter->lock);
+            return -1;
+        }
+    }
+    stats->in_flight++;
+    if (stats->in_flight > stats->peak_in_flight) stats->peak_in_flight = stats->in_flight;
+    stats->admitted[priority]++;
+    limiter_wake(limiter);
+    pthread_mutex_unlock(&limiter->lock);
+    return 0;
+}
+
+// 지연 시간 표본으로 한도 조정 (잠금 안에서 호출, in_flight는 이 요청을 포함한 값)
+static void limiter_update(vault_limiter_t *limiter, uint64_t rtt_ns, int in_flight) {
+    uint64_t now = vault_metrics_now_ns();
+    if (now >= limiter->probe_at) {
+        // 한도를 줄여 Vault 쪽 대기열을 비운 뒤 min_rtt를 다시 측정
+        limiter->probe_at = now + VAULT_LIMIT_PROBE_NS;
+        limiter->min_rtt_ns = 0;
+        limiter->rtt_ns = 0;
+        limiter->limit = limiter->limit / 2 > limiter->min_limit ? limiter->limit / 2 : limiter->min_limit;
+        limiter->stats.probes++;
+        return;
+    }
+
+    if (!limiter->min_rtt_ns || rtt_ns < limiter->min_rtt_ns) limiter->min_rtt_ns = rtt_ns;
+    limiter->rtt_ns = limiter->rtt_ns > 0 ? limiter->rtt_ns * 0.9 + (double)rtt_ns * 0.1 : (double)rtt_ns;
+
+    double gradient = VAULT_LIMIT_TOLERANCE * (double)limiter->min_rtt_ns / limiter->rtt_ns;
+    if (gradient > 1.0) gradient = 1.0;
+    if (gradient < 0.5) gradient = 0.5;
+    double target = limiter->limit * gradient + sqrt(limiter->limit);
+    // 한도의 절반도 쓰지 않는 동안에는 늘리지 않음 (부하가 없어 지연 시간이 한도를 검증하지 못함)
+    if (target > limiter->limit && in_flight * 2 < (int)limiter->limit) target = limiter->limit;
+
+    double limit = limiter->limit * (1.0 - VAULT_LIMIT_SMOOTHING) + target * VAULT_LIMIT_SMOOTHING;
+    if (limit < limiter->min_limit) limit = limiter->min_limit;
+    if (limit > limiter->max_limit) limit = limiter->max_limit;
+    limiter->limit = limit;
+}
+
+void vault_limiter_release(vault_limiter_t *limiter, uint64_t rtt_ns, vault_limit_outcome_t outcome) {
+    if (!limiter || !limiter->enabled) return;
+
+    pthread_mutex_lock(&limiter->lock);
+    int in_flight = limiter->stats.in_flight--;
+    if (outcome == VAULT_LIMIT_OVERLOAD) {
+        // 같은 과부하로 동시에 실패한 요청들이 한도를 연달아 줄이지 않도록 RTT 한 번에 한 번만
+        uint64_t now = vault_metrics_now_ns();
+        uint64_t window = limiter->rtt_ns > 0 ? (uint64_t)limiter->rtt_ns : rtt_ns;
+        if (!limiter->backoff_at || now - limiter->backoff_at >= window) {
+            limiter->backoff_at = now;
+            limiter->limit *= VAULT_LIMIT_BACKOFF;
+            if (limiter->limit < limiter->min_limit) limiter->limit = limiter->min_limit;
+            limiter->stats.overloads++;
+        }
+    } else if (outcome == VAULT_LIMIT_OK && rtt_ns > 0) {
+        limiter_update(limiter, rtt_ns, in_flight);
+    }
+    limiter_wake(limiter);
+    pthread_mutex_unlock(&limiter->lock);
+}
+
+void vault_limiter_get_stats(vault_limiter_t *limiter, vault_limiter_stats_t *stats) {
+    pthread_mutex_lock(&limiter->lock);
+    *stats = limiter->stats;
+    stats->enabled = limiter->enabled;
+    stats->limit = limiter->limit;
+    stats->min_rtt_ms = (double)limiter->min_rtt_ns / 1e6;
+    stats->rtt_ms = limiter->rtt_ns / 1e6;
+    pthread_mutex_unlock(&limiter->lock);
+}
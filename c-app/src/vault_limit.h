@@ -0,0 +1,81 @@
+#ifndef VAULT_LIMIT_H
+#define VAULT_LIMIT_H
+
+#include <stdint.h>
+#include <pthread.h>
+
+// Vault 동시 요청 수 적응형 제한 (공유 전송 계층)
+// 응답 지연 시간과 관측 최소 RTT의 비(gradient)로 한도를 조정합니다.
+//   gradient = clamp(1.5 * min_rtt / rtt, 0.5, 1.0), 새 한도 = 한도 * gradient + sqrt(한도)
+// Vault 안에서 요청이 줄을 서기 시작하면(rtt가 min_rtt의 1.5배 이상) 한도가 줄고, 여유가 있으면 sqrt(한도)씩 늘어납니다.
+// 429/503/타임아웃은 지연 시간과 무관하게 한도를 0.9배로 줄입니다 (RTT 한 번에 한 번만).
+// 30초마다 한도를 절반으로 줄이고 min_rtt를 다시 측정하여 Vault 기준 지연 시간이 바뀌어도 따라갑니다.
+//
+// 우선순위: critical(로그인, 토큰 갱신, lease 조회)은 한도 + 2까지 먼저 들어가고,
+// normal(시크릿 조회, Transit, PKI)은 한도까지, bulk(여러 경로 조회, prefetch)는 한도의 3/4까지이며
+// 상위 우선순위가 기다리는 동안에는 하위 우선순위를 시작하지 않습니다.
+
+#define VAULT_LIMIT_TOLERANCE 1.5          // 이 배수까지의 지연 시간 증가는 정상으로 봄
+#define VAULT_LIMIT_SMOOTHING 0.2          // 표본마다 새 한도를 반영하는 비율
+#define VAULT_LIMIT_BACKOFF 0.9            // 429/503/타임아웃 시 한도 배수
+#define VAULT_LIMIT_CRITICAL_RESERVE 2     // critical 요청만 쓸 수 있는 추가 자리
+#define VAULT_LIMIT_PROBE_NS (30ULL * 1000000000ULL)
+
+typedef enum {
+    VAULT_PRIORITY_CRITICAL,   // 로그인, 토큰 갱신, lease 조회
+    VAULT_PRIORITY_NORMAL,     // 단일 시크릿 조회, 쓰기 요청
+    VAULT_PRIORITY_BULK,       // vault_get_secrets, vault_prefetch_kv
+    VAULT_PRIORITY_COUNT
+} vault_priority_t;
+
+typedef enum {
+    VAULT_LIMIT_OK,            // 응답 수신 (4xx 포함, 지연 시간 표본으로 사용)
+    VAULT_LIMIT_OVERLOAD,      // 429/503/타임아웃 (한도 축소)
+    VAULT_LIMIT_IGNORE         // 연결 실패 등 지연 시간이 의미 없는 결과
+} vault_limit_outcome_t;
+
+typedef struct {
+    int enabled;
+    double limit;                              // 현재 한도
+    int in_flight;
+    int peak_in_flight;
+    double min_rtt_ms;
+    double rtt_ms;                             // 최근 지연 시간 (지수 이동 평균)
+    uint64_t admitted[VAULT_PRIORITY_COUNT];   // 시작한 요청
+    uint64_t delayed[VAULT_PRIORITY_COUNT];    // 한도 때문에 기다린 요청
+    uint64_t shed[VAULT_PRIORITY_COUNT];       // 기다리다 시간 초과로 보내지 않은 요청
+    double max_wait_ms[VAULT_PRIORITY_COUNT];
+    int waiting[VAULT_PRIORITY_COUNT];         // 현재 기다리는 요청
+    int peak_waiting;
+    uint64_t overloads;                        // 429/503/타임아웃으로 한도를 줄인 횟수
+    uint64_t probes;                           // min_rtt 재측정 횟수
+} vault_limiter_stats_t;
+
+typedef struct {
+    int enabled;               // vault_limiter_configure 전에는 모든 요청을 바로 통과
+    int min_limit;
+    int max_limit;
+    double limit;
+
+    pthread_mutex_t lock;
+    pthread_cond_t ready[VAULT_PRIORITY_COUNT];   // 우선순위별 대기 (단조 시계)
+    uint64_t min_rtt_ns;
+    double rtt_ns;
+    uint64_t probe_at;         // 다음 min_rtt 재측정 시각
+    uint64_t backoff_at;       // 마지막 과부하 축소 시각
+    vault_limiter_stats_t stats;
+} vault_limiter_t;
+
+void vault_limiter_init(vault_limiter_t *limiter);
+void vault_limiter_destroy(vault_limiter_t *limiter);
+// 적응형 한도 활성화 (요청을 보내기 전에 호출, initial은 [min_limit, max_limit]로 맞춤)
+void vault_limiter_configure(vault_limiter_t *limiter, int min_limit, int initial, int max_limit);
+
+// 자리 얻기 (0 성공, timeout_ms 안에 자리가 나지 않으면 -1, timeout_ms가 0이면 기다리지 않음)
+// 성공하면 요청이 끝난 뒤 vault_limiter_release로 반납해야 합니다.
+int vault_limiter_acquire(vault_limiter_t *limiter, vault_priority_t priority, int timeout_ms);
+void vault_limiter_release(vault_limiter_t *limiter, uint64_t rtt_ns, vault_limit_outcome_t outcome);
+
+void vault_limiter_get_stats(vault_limiter_t *limiter, vault_limiter_stats_t *stats);
+
+#endif
@@ -0,0 +1,526 @@
+#define _POSIX_C_SOURCE 200809L
+#include "vault_log.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <ctype.h>
+#include <time.h>
+#include <pthread.h>
+
+#define LOG_RING_SLOTS 256  // 2의 거듭제곱
+#define LOG_SLOT_SIZE 256
+#define LOG_ARGS_MAX (LOG_SLOT_SIZE - 20)
+#define LOG_LINE_MAX 1024
+#define LOG_IDLE_NS (5 * 1000 * 1000)
+
+// 링 슬롯 1개 = 로그 기록 1건 (인자는 포맷 순서대로 int64/double/문자열(len+bytes)로 직렬화)
+typedef struct {
+    uint64_t time_ns;
+    const char *format;
+    uint16_t args_len;
+    uint8_t level;
+    uint8_t truncated;
+    unsigned char args[LOG_ARGS_MAX];
+} log_slot_t;
+
+typedef char log_slot_size_check[sizeof(log_slot_t) == LOG_SLOT_SIZE ? 1 : -1];
+
+// 스레드별 SPSC 링
+// 기록 스레드만 head와 cached_tail을 쓰고, 출력 스레드만 tail을 씁니다.
+// 스레드가 종료되면 in_use를 내려 이후 생성되는 스레드가 링을 재사용합니다.
+typedef struct log_ring {
+    log_slot_t slots[LOG_RING_SLOTS];
+    uint64_t head;
+    uint64_t cached_tail;
+    char pad1[48];
+    uint64_t tail;
+    char pad2[56];
+    uint64_t dropped;
+    int in_use;
+    struct log_ring *next;
+} log_ring_t;
+
+int vault_log_threshold = VAULT_LOG_OFF;
+
+static const char *level_names[VAULT_LOG_OFF + 1] = {"debug", "info", "warn", "error", "off"};
+static const char *level_labels[VAULT_LOG_OFF] = {"DEBUG", "INFO ", "WARN ", "ERROR"};
+
+static log_ring_t *rings = NULL;
+static pthread_key_t ring_key;
+static pthread_once_t ring_key_once = PTHREAD_ONCE_INIT;
+static __thread log_ring_t *thread_ring = NULL;
+
+static pthread_t log_thread;
+static int log_running = 0;
+static FILE *log_out = NULL;
+static uint64_t log_written = 0;
+static uint64_t log_dropped_reported = 0;
+
+// ---- 기록 스레드 ----
+
+static void release_ring(void *ring) {
+    __atomic_store_n(&((log_ring_t *)ring)->in_use, 0, __ATOMIC_RELEASE);
+}
+
+static void create_ring_key(void) {
+    pthread_key_create(&ring_key, release_ring);
+}
+
+static log_ring_t *acquire_ring(void) {
+    if (thread_ring) return thread_ring;
+    pthread_once(&ring_key_once, create_ring_key);
+
+    // 종료된 스레드의 링 재사용
+    log_ring_t *ring;
+    for (ring = __atomic_load_n(&rings, __ATOMIC_ACQUIRE); ring; ring = ring->next) {
+        int expected = 0;
+        if (__atomic_compare_exchange_n(&ring->in_use, &expected, 1, 0, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+            break;
+        }
+    }
+
+    if (!ring) {
+        ring = calloc(1, sizeof(log_ring_t));
+        if (!ring) return NULL;
+        ring->in_use = 1;
+        ring->next = __atomic_load_n(&rings, __ATOMIC_RELAXED);
+        while (!__atomic_compare_exchange_n(&rings, &ring->next, ring, 1, __ATOMIC_RELEASE, __ATOMIC_RELAXED)) {
+        }
+    }
+
+    ring->cached_tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+    pthread_setspecific(ring_key, ring);
+    thread_ring = ring;
+    return ring;
+}
+
+// 민감한 이름 (password, secret_id, client_token, api_key 등)
+static int is_sensitive_name(const char *name, size_t len) {
+    char lower[64];
+    if (len == 0 || len >= sizeof(lower)) return 0;
+    for (size_t i = 0; i < len; i++) {
+        lower[i] = (char)tolower((unsigned char)name[i]);
+    }
+    lower[len] = '\0';
+
+    return strstr(lower, "password") || strstr(lower, "secret") || strstr(lower, "private_key") ||
+           strstr(lower, "api_key") || strstr(lower, "plaintext") ||
+           (len >= 5 && strcmp(lower + len - 5, "token") == 0);
+}
+
+// 포맷의 %s 직전 리터럴이 "<민감한 이름>: " 또는 "<민감한 이름>=" 형태인지 확인
+static int preceded_by_sensitive_name(const char *format, const char *percent) {
+    const char *p = percent;
+    while (p > format && p[-1] == ' ') p--;
+    if (p == format || (p[-1] != ':' && p[-1] != '=')) return 0;
+    p--;
+    while (p > format && p[-1] == ' ') p--;
+
+    const char *end = p;
+    while (p > format && (isalnum((unsigned char)p[-1]) || p[-1] == '_')) p--;
+    return is_sensitive_name(p, (size_t)(end - p));
+}
+
+// 문자열 인자 복사 (JSON 민감 필드의 문자열 값은 ***로 치환)
+static size_t copy_redacted(unsigned char *out, size_t cap, const char *src, int *complete) {
+    size_t n = 0;
+    const char *p = src;
+
+    while (*p && n < cap) {
+        if (*p != '"') {
+            out[n++] = (unsigned char)*p++;
+            continue;
+        }
+
+        // "key" 이후 : "value" 형태이고 key가 민감하면 value를 치환
+        const char *key = p + 1;
+        const char *key_end = strchr(key, '"');
+        if (!key_end) {
+            out[n++] = (unsigned char)*p++;
+            continue;
+        }
+        const char *q = key_end + 1;
+        while (*q == ' ') q++;
+        if (*q != ':') {
+            out[n++] = (unsigned char)*p++;
+            continue;
+        }
+        q++;
+        while (*q == ' ') q++;
+        if (*q != '"' || !is_sensitive_name(key, (size_t)(key_end - key))) {
+            out[n++] = (unsigned char)*p++;
+            continue;
+        }
+
+        // "key":" 까지 복사 후 값을 건너뜀
+        size_t prefix = (size_t)(q + 1 - p);
+        if (n + prefix + 4 > cap) break;
+        memcpy(out + n, p, prefix);
+        n += prefix;
+        memcpy(out + n, "***\"", 4);
+        n += 4;
+
+        const char *value = q + 1;
+        while (*value && *value != '"') {
+            if (*value == '\\' && value[1]) value++;
+            value++;
+        }
+        p = *value ? value + 1 : value;
+    }
+    *complete = *p == '\0';
+    return n;
+}
+
+// 변환 지정자 해석: 플래그/폭/정밀도를 건너뛰고 길이 수식어와 변환 문자를 반환
+static const char *parse_spec(const char *p, char *length, char *conversion) {
+    while (*p && strchr("-+ #0", *p)) p++;
+    while (isdigit((unsigned char)*p)) p++;
+    if (*p == '.') {
+        p++;
+        while (isdigit((unsigned char)*p)) p++;
+    }
+
+    *length = 0;
+    if (*p == 'h') {
+        *length = 'h';
+        p++;
+        if (*p == 'h') p++;
+    } else if (*p == 'l') {
+        *length = 'l';
+        p++;
+        if (*p == 'l') {
+            *length = 'L';
+            p++;
+        }
+    } else if (*p == 'z' || *p == 't') {
+        *length = 'l';  // size_t, ptrdiff_t
+        p++;
+    } else if (*p == 'j') {
+        *length = 'L';
+        p++;
+    }
+    *conversion = *p;
+    return *p ? p + 1 : p;
+}
+
+static size_t encode_args(log_slot_t *slot, const char *format, va_list ap) {
+    size_t n = 0;
+    const char *p = format;
+
+    while ((p = strchr(p, '%')) != NULL) {
+        const char *percent = p;
+        if (p[1] == '%') {
+            p += 2;
+            continue;
+        }
+
+        char length, conversion;
+        p = parse_spec(p + 1, &length, &conversion);
+
+        int64_t integer;
+        double real;
+        switch (conversion) {
+            case 'd': case 'i': case 'c':
+                integer = length == 'L' ? (int64_t)va_arg(ap, long long) :
+                          length == 'l' ? (int64_t)va_arg(ap, long) : (int64_t)va_arg(ap, int);
+                if (n + sizeof(integer) > LOG_ARGS_MAX) goto truncated;
+                memcpy(slot->args + n, &integer, sizeof(integer));
+                n += sizeof(integer);
+                break;
+            case 'u': case 'x': case 'X': case 'o':
+                integer = length == 'L' ? (int64_t)va_arg(ap, unsigned long long) :
+                          length == 'l' ? (int64_t)va_arg(ap, unsigned long) : (int64_t)va_arg(ap, unsigned int);
+                if (n + sizeof(integer) > LOG_ARGS_MAX) goto truncated;
+                memcpy(slot->args + n, &integer, sizeof(integer));
+                n += sizeof(integer);
+                break;
+            case 'p':
+                integer = (int64_t)(uintptr_t)va_arg(ap, void *);
+                if (n + sizeof(integer) > LOG_ARGS_MAX) goto truncated;
+                memcpy(slot->args + n, &integer, sizeof(integer));
+                n += sizeof(integer);
+                break;
+            case 'f': case 'e': case 'g': case 'E': case 'G':
+                real = va_arg(ap, double);
+                if (n + sizeof(real) > LOG_ARGS_MAX) goto truncated;
+                memcpy(slot->args + n, &real, sizeof(real));
+                n += sizeof(real);
+                break;
+            case 's': {
+                const char *text = va_arg(ap, const char *);
+                uint16_t len;
+                int complete;
+                if (n + sizeof(len) >= LOG_ARGS_MAX) goto truncated;
+                if (!text) {
+                    text = "(null)";
+                }
+                if (preceded_by_sensitive_name(format, percent)) {
+                    text = "***";
+                }
+                len = (uint16_t)copy_redacted(slot->args + n + sizeof(len), LOG_ARGS_MAX - n - sizeof(len), text, &complete);
+                memcpy(slot->args + n, &len, sizeof(len));
+                n += sizeof(len) + len;
+                if (!complete) slot->truncated = 1;
+                break;
+            }
+            default:
+                // 지원하지 않는 변환: 이후 인자 해석이 불가능하므로 중단
+                goto truncated;
+        }
+    }
+    return n;
+
+truncated:
+    slot->truncated = 1;
+    return n;
+}
+
+void vault_log_write(vault_log_level_t level, const char *format, ...) {
+    log_ring_t *ring = acquire_ring();
+    if (!ring) return;
+
+    uint64_t head = ring->head;
+    if (head - ring->cached_tail >= LOG_RING_SLOTS) {
+        ring->cached_tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+        if (head - ring->cached_tail >= LOG_RING_SLOTS) {
+            // 출력 스레드가 따라오지 못하면 기다리지 않고 버림
+            __atomic_add_fetch(&ring->dropped, 1, __ATOMIC_RELAXED);
+            return;
+        }
+    }
+
+    log_slot_t *slot = &ring->slots[head & (LOG_RING_SLOTS - 1)];
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    slot->time_ns = (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+    slot->format = format;
+    slot->level = (uint8_t)level;
+    slot->truncated = 0;
+
+    va_list ap;
+    va_start(ap, format);
+    slot->args_len = (uint16_t)encode_args(slot, format, ap);
+    va_end(ap);
+
+    __atomic_store_n(&ring->head, head + 1, __ATOMIC_RELEASE);
+}
+
+// ---- 출력 스레드 ----
+
+static size_t append(char *line, size_t n, const char *text, size_t len) {
+    if (n + len >= LOG_LINE_MAX) len = LOG_LINE_MAX - 1 - n;
+    memcpy(line + n, text, len);
+    return n + len;
+}
+
+static size_t format_slot(const log_slot_t *slot, char *line) {
+    struct tm tm;
+    time_t seconds = (time_t)(slot->time_ns / 1000000000ULL);
+    localtime_r(&seconds, &tm);
+    size_t n = strftime(line, LOG_LINE_MAX, "%Y-%m-%d %H:%M:%S", &tm);
+    n += (size_t)snprintf(line + n, LOG_LINE_MAX - n, ".%03u %s ",
+                          (unsigned)((slot->time_ns / 1000000ULL) % 1000), level_labels[slot->level]);
+
+    const char *p = slot->format;
+    size_t offset = 0;
+    while (*p && n < LOG_LINE_MAX - 1) {
+        const char *percent = strchr(p, '%');
+        if (!percent) {
+            n = append(line, n, p, strlen(p));
+            break;
+        }
+        n = append(line, n, p, (size_t)(percent - p));
+        if (percent[1] == '%') {
+            n = append(line, n, "%", 1);
+            p = percent + 2;
+            continue;
+        }
+
+        char length, conversion;
+        const char *next = parse_spec(percent + 1, &length, &conversion);
+
+        // 원래 지정자에서 길이 수식어를 빼고 저장된 타입에 맞는 수식어로 다시 구성
+        char spec[32];
+        size_t spec_len = 0;
+        for (const char *s = percent; s < next - 1 && spec_len < sizeof(spec) - 4; s++) {
+            if (!strchr("hlzjt", *s)) spec[spec_len++] = *s;
+        }
+
+        char text[LOG_ARGS_MAX + 1];
+        int64_t integer;
+        double real;
+        uint16_t len;
+        int written = 0;
+        size_t room = LOG_LINE_MAX - n;
+        switch (conversion) {
+            case 'd': case 'i': case 'u': case 'x': case 'X': case 'o': case 'c': case 'p':
+                if (offset + sizeof(integer) > slot->args_len) goto done;
+                memcpy(&integer, slot->args + offset, sizeof(integer));
+                offset += sizeof(integer);
+                if (conversion == 'c' || conversion == 'p') {
+                    spec[spec_len++] = conversion;
+                    spec[spec_len] = '\0';
+                    written = conversion == 'c' ? snprintf(line + n, room, spec, (int)integer) :
+                                                  snprintf(line + n, room, spec, (void *)(uintptr_t)integer);
+                } else {
+                    spec[spec_len++] = 'l';
+                    spec[spec_len++] = 'l';
+                    spec[spec_len++] = conversion;
+                    spec[spec_len] = '\0';
+                    written = (conversion == 'd' || conversion == 'i') ?
+                              snprintf(line + n, room, spec, (long long)integer) :
+                              snprintf(line + n, room, spec, (unsigned long long)integer);
+                }
+                break;
+            case 'f': case 'e': case 'g': case 'E': case 'G':
+                if (offset + sizeof(real) > slot->args_len) goto done;
+                memcpy(&real, slot->args + offset, sizeof(real));
+                offset += sizeof(real);
+                spec[spec_len++] = conversion;
+                spec[spec_len] = '\0';
+                written = snprintf(line + n, room, spec, real);
+                break;
+            case 's':
+                if (offset + sizeof(len) > slot->args_len) goto done;
+                memcpy(&len, slot->args + offset, sizeof(len));
+                offset += sizeof(len);
+                memcpy(text, slot->args + offset, len);
+                text[len] = '\0';
+                offset += len;
+                spec[spec_len++] = 's';
+                spec[spec_len] = '\0';
+                written = snprintf(line + n, room, spec, text);
+                break;
+            default:
+                goto done;
+        }
+        if (written > 0) {
+            n += (size_t)written < room ? (size_t)written : room - 1;
+        }
+        p = next;
+    }
+
+done:
+    if (slot->truncated) {
+        n = append(line, n, " ...", 4);
+    }
+    // 메시지 앞뒤 줄바꿈은 한 줄 형식에 맞게 제거
+    while (n > 0 && line[n - 1] == '\n') n--;
+    line[n++] = '\n';
+    return n;
+}
+
+// 모든 링의 기록을 시각 순으로 병합하여 출력, 출력한 기록 수 반환
+static size_t drain(void) {
+    char line[LOG_LINE_MAX + 1];
+    size_t count = 0;
+    uint64_t dropped = 0;
+
+    for (;;) {
+        log_ring_t *oldest = NULL;
+        uint64_t oldest_time = 0;
+        for (log_ring_t *ring = __atomic_load_n(&rings, __ATOMIC_ACQUIRE); ring; ring = ring->next) {
+            uint64_t tail = ring->tail;
+            if (tail == __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE)) continue;
+            uint64_t time_ns = ring->slots[tail & (LOG_RING_SLOTS - 1)].time_ns;
+            if (!oldest || time_ns < oldest_time) {
+                oldest = ring;
+                oldest_time = time_ns;
+            }
+        }
+        if (!oldest) break;
+
+        size_t n = format_slot(&oldest->slots[oldest->tail & (LOG_RING_SLOTS - 1)], line);
+        __atomic_store_n(&oldest->tail, oldest->tail + 1, __ATOMIC_RELEASE);
+        fwrite(line, 1, n, log_out);
+        count++;
+    }
+
+    for (log_ring_t *ring = __atomic_load_n(&rings, __ATOMIC_ACQUIRE); ring; ring = ring->next) {
+        dropped += __atomic_load_n(&ring->dropped, __ATOMIC_RELAXED);
+    }
+    if (dropped > log_dropped_reported) {
+        fprintf(log_out, "WARN  log: %llu messages dropped (ring full)\n",
+                (unsigned long long)(dropped - log_dropped_reported));
+        log_dropped_reported = dropped;
+    }
+
+    if (count > 0) {
+        fflush(log_out);
+        __atomic_add_fetch(&log_written, count, __ATOMIC_RELAXED);
+    }
+    return count;
+}
+
+static void *log_thread_main(void *arg) {
+    (void)arg;
+    struct timespec idle = {0, LOG_IDLE_NS};
+    while (__atomic_load_n(&log_running, __ATOMIC_ACQUIRE)) {
+        if (drain() == 0) {
+            nanosleep(&idle, NULL);
+        }
+    }
+    drain();
+    return NULL;
+}
+
+int vault_log_start(vault_log_level_t level, const char *output) {
+    if (__atomic_load_n(&log_running, __ATOMIC_ACQUIRE)) return 0;
+
+    log_out = stdout;
+    if (output && output[0]) {
+        log_out = fopen(output, "a");
+        if (!log_out) {
+            perror("Failed to open log output");
+            log_out = stdout;
+            return -1;
+        }
+    }
+
+    __atomic_store_n(&log_running, 1, __ATOMIC_RELEASE);
+    if (pthread_create(&log_thread, NULL, log_thread_main, NULL) != 0) {
+        __atomic_store_n(&log_running, 0, __ATOMIC_RELEASE);
+        return -1;
+    }
+    vault_log_set_level(level);
+    return 0;
+}
+
+void vault_log_stop(void) {
+    if (!__atomic_load_n(&log_running, __ATOMIC_ACQUIRE)) return;
+
+    vault_log_set_level(VAULT_LOG_OFF);
+    __atomic_store_n(&log_running, 0, __ATOMIC_RELEASE);
+    pthread_join(log_thread, NULL);
+    if (log_out && log_out != stdout) {
+        fclose(log_out);
+    }
+    log_out = NULL;
+}
+
+void vault_log_set_level(vault_log_level_t level) {
+    __atomic_store_n(&vault_log_threshold, (int)level, __ATOMIC_RELAXED);
+}
+
+int vault_log_parse_level(const char *name, vault_log_level_t *level) {
+    for (int i = 0; i <= VAULT_LOG_OFF; i++) {
+        if (strcmp(name, level_names[i]) == 0) {
+            *level = (vault_log_level_t)i;
+            return 0;
+        }
+    }
+    return -1;
+}
+
+const char *vault_log_level_name(vault_log_level_t level) {
+    return (unsigned)level <= VAULT_LOG_OFF ? level_names[level] : "unknown";
+}
+
+void vault_log_get_stats(vault_log_stats_t *stats) {
+    stats->written = __atomic_load_n(&log_written, __ATOMIC_RELAXED);
+    stats->dropped = 0;
+    for (log_ring_t *ring = __atomic_load_n(&rings, __ATOMIC_ACQUIRE); ring; ring = ring->next) {
+        stats->dropped += __atomic_load_n(&ring->dropped, __ATOMIC_RELAXED);
+    }
+}
@@ -0,0 +1,58 @@
+#ifndef VAULT_LOG_H
+#define VAULT_LOG_H
+
+#include <stdint.h>
+
+// 비동기 레벨 로거
+// 호출 스레드는 포맷 문자열 포인터와 인자를 스레드별 SPSC 링 버퍼에 바이너리로 기록만 하고,
+// 문자열 변환과 출력은 백그라운드 스레드가 모아서 처리합니다. 링이 가득 차면 기다리지 않고
+// 버린 뒤 개수만 집계합니다. 활성 레벨 미만의 호출은 레벨 비교 한 번으로 끝납니다.
+//
+// 비밀 값 보호: "password: %s", "token=%s"처럼 민감한 이름 바로 뒤의 %s 인자와
+// %s 인자 안의 JSON 민감 필드("password":"...", "client_token":"..." 등)는
+// 링에 복사하기 전에 "***"로 치환하므로 원문이 로거 메모리나 출력에 남지 않습니다.
+//
+// 포맷 문자열은 정적 문자열이어야 합니다 (포인터만 기록하고 나중에 해석).
+// 지원 변환: d i u x X o c (h, l, ll, z 길이 수식어), f e g, s, p, %%
+
+typedef enum {
+    VAULT_LOG_DEBUG,
+    VAULT_LOG_INFO,
+    VAULT_LOG_WARN,
+    VAULT_LOG_ERROR,
+    VAULT_LOG_OFF
+} vault_log_level_t;
+
+// 활성 레벨 (vault_log_start 전에는 VAULT_LOG_OFF)
+extern int vault_log_threshold;
+
+#define VAULT_LOG(level, ...) \
+    do { \
+        if ((int)(level) >= __atomic_load_n(&vault_log_threshold, __ATOMIC_RELAXED)) \
+            vault_log_write((level), __VA_ARGS__); \
+    } while (0)
+
+#define VAULT_LOG_DEBUG(...) VAULT_LOG(VAULT_LOG_DEBUG, __VA_ARGS__)
+#define VAULT_LOG_INFO(...) VAULT_LOG(VAULT_LOG_INFO, __VA_ARGS__)
+#define VAULT_LOG_WARN(...) VAULT_LOG(VAULT_LOG_WARN, __VA_ARGS__)
+#define VAULT_LOG_ERROR(...) VAULT_LOG(VAULT_LOG_ERROR, __VA_ARGS__)
+
+// 시작/종료 (output이 NULL 또는 빈 문자열이면 stdout, 종료 시 남은 기록을 모두 출력)
+int vault_log_start(vault_log_level_t level, const char *output);
+void vault_log_stop(void);
+void vault_log_set_level(vault_log_level_t level);
+int vault_log_parse_level(const char *name, vault_log_level_t *level);
+const char *vault_log_level_name(vault_log_level_t level);
+
+// 기록 (직접 호출하지 말고 VAULT_LOG_* 매크로 사용)
+void vault_log_write(vault_log_level_t level, const char *format, ...) __attribute__((format(printf, 2, 3)));
+
+// 통계
+typedef struct {
+    uint64_t written;  // 출력된 기록
+    uint64_t dropped;  // 링이 가득 차서 버린 기록
+} vault_log_stats_t;
+
+void vault_log_get_stats(vault_log_stats_t *stats);
+
+#endif
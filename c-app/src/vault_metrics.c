@@ -0,0 +1,431 @@
+#define _POSIX_C_SOURCE 200809L
+#include "vault_metrics.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+// 스레드별 메트릭 슬롯
+// 각 슬롯은 소유 스레드 하나만 기록하므로 증가 연산에 잠금이나 RMW 원자 연산이 필요 없고,
+// 스냅샷은 모든 슬롯을 relaxed 로드로 합산합니다.
+typedef struct vault_metrics_slot {
+    struct vault_metrics_slot *next;
+    int owned;  // 사용 중인 스레드가 있으면 1 (스레드 종료 시 0으로 반환되어 재사용)
+
+    uint64_t requests[VAULT_ENDPOINT_COUNT];
+    uint64_t errors[VAULT_ENDPOINT_COUNT];
+    uint64_t bytes[VAULT_ENDPOINT_COUNT];
+    uint64_t latency_sum_us[VAULT_ENDPOINT_COUNT];
+    uint64_t latency_max_us[VAULT_ENDPOINT_COUNT];
+    uint64_t buckets[VAULT_ENDPOINT_COUNT][VAULT_HIST_BUCKETS];
+    uint64_t cache[VAULT_CACHE_COUNT][VAULT_CACHE_RESULT_COUNT];
+    uint64_t refresh[VAULT_CACHE_COUNT][VAULT_REFRESH_RESULT_COUNT];
+} vault_metrics_slot_t;
+
+static vault_metrics_slot_t *slots_head = NULL;
+static __thread vault_metrics_slot_t *tls_slot = NULL;
+static pthread_key_t slot_key;
+static pthread_once_t slot_key_once = PTHREAD_ONCE_INIT;
+
+static const char *endpoint_names[VAULT_ENDPOINT_COUNT] = {
+    "login", "renew-self", "kv-data", "creds", "static-creds", "lease-lookup", "other", "transit", "pki"
+};
+static const char *cache_names[VAULT_CACHE_COUNT] = {"kv", "database-dynamic", "database-static"};
+static const char *cache_result_names[VAULT_CACHE_RESULT_COUNT] = {"hit", "miss", "stale"};
+static const char *refresh_result_names[VAULT_REFRESH_RESULT_COUNT] = {"updated", "unchanged", "failed"};
+
+// 스레드 종료 시 슬롯 반환 (누적 값은 유지되며 다음 스레드가 이어서 사용)
+static void release_slot(void *arg) {
+    vault_metrics_slot_t *slot = (vault_metrics_slot_t *)arg;
+    __atomic_store_n(&slot->owned, 0, __ATOMIC_RELEASE);
+}
+
+static void create_slot_key(void) {
+    pthread_key_create(&slot_key, release_slot);
+}
+
+// 현재 스레드의 슬롯 확보 (스레드당 최초 1회만 느린 경로)
+static vault_metrics_slot_t *claim_slot(void) {
+    pthread_once(&slot_key_once, create_slot_key);
+
+    // 반환된 슬롯 재사용
+    vault_metrics_slot_t *slot = __atomic_load_n(&slots_head, __ATOMIC_ACQUIRE);
+    for (; slot; slot = slot->next) {
+        int expected = 0;
+        if (__atomic_compare_exchange_n(&slot->owned, &expected, 1, 0, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+            break;
+        }
+    }
+
+    // 새 슬롯을 목록 앞에 추가 (CAS)
+    if (!slot) {
+        slot = calloc(1, sizeof(vault_metrics_slot_t));
+        if (!slot) return NULL;
+        slot->owned = 1;
+        slot->next = __atomic_load_n(&slots_head, __ATOMIC_RELAXED);
+        while (!__atomic_compare_exchange_n(&slots_head, &slot->next, slot, 1,
+                                            __ATOMIC_RELEASE, __ATOMIC_RELAXED)) {
+        }
+    }
+
+    pthread_setspecific(slot_key, slot);
+    tls_slot = slot;
+    return slot;
+}
+
+static inline vault_metrics_slot_t *current_slot(void) {
+    vault_metrics_slot_t *slot = tls_slot;
+    return slot ? slot : claim_slot();
+}
+
+// 단일 기록자 카운터 증가 (읽는 쪽과의 데이터 경합만 피하면 되므로 RMW 불필요)
+static inline void counter_add(uint64_t *counter, uint64_t value) {
+    __atomic_store_n(counter, __atomic_load_n(counter, __ATOMIC_RELAXED) + value, __ATOMIC_RELAXED);
+}
+
+static inline int bucket_index(uint64_t us) {
+    if (us < VAULT_HIST_SUB_BUCKETS) return (int)us;
+
+    int msb = 63 - __builtin_clzll(us);
+    int index = (msb - 3) * VAULT_HIST_SUB_BUCKETS + (int)((us >> (msb - 4)) & (VAULT_HIST_SUB_BUCKETS - 1));
+    return index < VAULT_HIST_BUCKETS ? index : VAULT_HIST_BUCKETS - 1;
+}
+
+// 구간에 들어가는 최댓값 (us)
+uint64_t vault_metrics_bucket_upper_us(int bucket) {
+    if (bucket < VAULT_HIST_SUB_BUCKETS) return (uint64_t)bucket;
+
+    int msb = bucket / VAULT_HIST_SUB_BUCKETS + 3;
+    uint64_t sub = (uint64_t)(bucket % VAULT_HIST_SUB_BUCKETS);
+    uint64_t width = 1ULL << (msb - 4);
+    return ((VAULT_HIST_SUB_BUCKETS + sub) << (msb - 4)) + width - 1;
+}
+
+uint64_t vault_metrics_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+void vault_metrics_record_request(vault_endpoint_t endpoint, uint64_t latency_ns, uint64_t bytes, int error) {
+    vault_metrics_slot_t *slot = current_slot();
+    if (!slot || endpoint >= VAULT_ENDPOINT_COUNT) return;
+
+    uint64_t us = latency_ns / 1000;
+    counter_add(&slot->requests[endpoint], 1);
+    counter_add(&slot->bytes[endpoint], bytes);
+    counter_add(&slot->latency_sum_us[endpoint], us);
+    counter_add(&slot->buckets[endpoint][bucket_index(us)], 1);
+    if (error) {
+        counter_add(&slot->errors[endpoint], 1);
+    }
+    if (us > __atomic_load_n(&slot->latency_max_us[endpoint], __ATOMIC_RELAXED)) {
+        __atomic_store_n(&slot->latency_max_us[endpoint], us, __ATOMIC_RELAXED);
+    }
+}
+
+void vault_metrics_record_cache(vault_cache_kind_t kind, vault_cache_result_t result) {
+    vault_metrics_slot_t *slot = current_slot();
+    if (slot && kind < VAULT_CACHE_COUNT && result < VAULT_CACHE_RESULT_COUNT) {
+        counter_add(&slot->cache[kind][result], 1);
+    }
+}
+
+void vault_metrics_record_refresh(vault_cache_kind_t kind, vault_refresh_result_t result) {
+    vault_metrics_slot_t *slot = current_slot();
+    if (slot && kind < VAULT_CACHE_COUNT && result < VAULT_REFRESH_RESULT_COUNT) {
+        counter_add(&slot->refresh[kind][result], 1);
+    }
+}
+
+static inline uint64_t load(const uint64_t *counter) {
+    return __atomic_load_n(counter, __ATOMIC_RELAXED);
+}
+
+// 히스토그램에서 분위수 계산 (구간 상한값 기준)
+static uint64_t percentile(const uint64_t *buckets, uint64_t total, double q) {
+    if (total == 0) return 0;
+
+    uint64_t rank = (uint64_t)(total * q);
+    if (rank >= total) rank = total - 1;
+
+    uint64_t seen = 0;
+    for (int i = 0; i < VAULT_HIST_BUCKETS; i++) {
+        seen += buckets[i];
+        if (seen > rank) return vault_metrics_bucket_upper_us(i);
+    }
+    return vault_metrics_bucket_upper_us(VAULT_HIST_BUCKETS - 1);
+}
+
+// 모든 스레드 슬롯을 합산한 스냅샷
+void vault_metrics_snapshot(vault_metrics_snapshot_t *snapshot) {
+    if (!snapshot) return;
+    memset(snapshot, 0, sizeof(*snapshot));
+
+    for (vault_metrics_slot_t *slot = __atomic_load_n(&slots_head, __ATOMIC_ACQUIRE); slot; slot = slot->next) {
+        for (int e = 0; e < VAULT_ENDPOINT_COUNT; e++) {
+            vault_endpoint_stats_t *stats = &snapshot->endpoints[e];
+            stats->requests += load(&slot->requests[e]);
+            stats->errors += load(&slot->errors[e]);
+            stats->bytes_received += load(&slot->bytes[e]);
+            stats->latency_sum_us += load(&slot->latency_sum_us[e]);
+            uint64_t max = load(&slot->latency_max_us[e]);
+            if (max > stats->latency_max_us) stats->latency_max_us = max;
+            for (int b = 0; b < VAULT_HIST_BUCKETS; b++) {
+                stats->buckets[b] += load(&slot->buckets[e][b]);
+            }
+        }
+        for (int k = 0; k < VAULT_CACHE_COUNT; k++) {
+            for (int r = 0; r < VAULT_CACHE_RESULT_COUNT; r++) {
+                snapshot->cache[k][r] += load(&slot->cache[k][r]);
+            }
+            for (int r = 0; r < VAULT_REFRESH_RESULT_COUNT; r++) {
+                snapshot->refresh[k][r] += load(&slot->refresh[k][r]);
+            }
+        }
+    }
+
+    for (int e = 0; e < VAULT_ENDPOINT_COUNT; e++) {
+        vault_endpoint_stats_t *stats = &snapshot->endpoints[e];
+        uint64_t total = 0;
+        for (int b = 0; b < VAULT_HIST_BUCKETS; b++) total += stats->buckets[b];
+        stats->p50_us = percentile(stats->buckets, total, 0.50);
+        stats->p90_us = percentile(stats->buckets, total, 0.90);
+        stats->p99_us = percentile(stats->buckets, total, 0.99);
+        stats->p999_us = percentile(stats->buckets, total, 0.999);
+        snapshot->bytes_received += stats->bytes_received;
+    }
+}
+
+const char *vault_metrics_endpoint_name(vault_endpoint_t endpoint) {
+    return endpoint < VAULT_ENDPOINT_COUNT ? endpoint_names[endpoint] : "unknown";
+}
+
+const char *vault_metrics_cache_name(vault_cache_kind_t kind) {
+    return kind < VAULT_CACHE_COUNT ? cache_names[kind] : "unknown";
+}
+
+// 가변 길이 텍스트 버퍼
+typedef struct {
+    char *data;
+    size_t length;
+    size_t capacity;
+} text_buffer_t;
+
+static void appendf(text_buffer_t *buffer, const char *format, ...) {
+    if (!buffer->data) return;
+
+    for (;;) {
+        va_list args;
+        va_start(args, format);
+        int n = vsnprintf(buffer->data + buffer->length, buffer->capacity - buffer->length, format, args);
+        va_end(args);
+        if (n < 0) return;
+        if (buffer->length + (size_t)n < buffer->capacity) {
+            buffer->length += (size_t)n;
+            return;
+        }
+
+        size_t capacity = buffer->capacity * 2 + (size_t)n;
+        char *grown = realloc(buffer->data, capacity);
+        if (!grown) {
+            free(buffer->data);
+            buffer->data = NULL;
+            return;
+        }
+        buffer->data = grown;
+        buffer->capacity = capacity;
+    }
+}
+
+// Prometheus 텍스트 형식 (호출자가 free)
+char *vault_metrics_format_prometheus(size_t *length) {
+    // 히스토그램 le 경계 (us) - HDR 구간을 누적하여 표준 Prometheus 히스토그램으로 노출
+    static const uint64_t le_us[] = {
+        100, 250, 500, 1000, 2500, 5000, 10000, 25000, 50000,
+        100000, 250000, 500000, 1000000, 2500000, 5000000, 10000000
+    };
+    const int le_count = (int)(sizeof(le_us) / sizeof(le_us[0]));
+
+    vault_metrics_snapshot_t *snapshot = malloc(sizeof(vault_metrics_snapshot_t));
+    if (!snapshot) return NULL;
+    vault_metrics_snapshot(snapshot);
+
+    text_buffer_t buffer = {malloc(16384), 0, 16384};
+
+    appendf(&buffer, "# HELP vault_client_requests_total Vault HTTP requests by endpoint.\n"
+                     "# TYPE vault_client_requests_total counter\n");
+    for (int e = 0; e < VAULT_ENDPOINT_COUNT; e++) {
+        appendf(&buffer, "vault_client_requests_total{endpoint=\"%s\"} %llu\n",
+                endpoint_names[e], (unsigned long long)snapshot->endpoints[e].requests);
+    }
+
+    appendf(&buffer, "# HELP vault_client_request_errors_total Failed Vault requests (transport error or HTTP 4xx/5xx).\n"
+                     "# TYPE vault_client_request_errors_total counter\n");
+    for (int e = 0; e < VAULT_ENDPOINT_COUNT; e++) {
+        appendf(&buffer, "vault_client_request_errors_total{endpoint=\"%s\"} %llu\n",
+                endpoint_names[e], (unsigned long long)snapshot->endpoints[e].errors);
+    }
+
+    appendf(&buffer, "# HELP vault_client_response_bytes_total Response body bytes received from Vault (compressed size on the wire).\n"
+                     "# TYPE vault_client_response_bytes_total counter\n");
+    for (int e = 0; e < VAULT_ENDPOINT_COUNT; e++) {
+        appendf(&buffer, "vault_client_response_bytes_total{endpoint=\"%s\"} %llu\n",
+                endpoint_names[e], (unsigned long long)snapshot->endpoints[e].bytes_received);
+    }
+
+    appendf(&buffer, "# HELP vault_client_request_duration_seconds Vault request latency.\n"
+                     "# TYPE vault_client_request_duration_seconds histogram\n");
+    for (int e = 0; e < VAULT_ENDPOINT_COUNT; e++) {
+        const vault_endpoint_stats_t *stats = &snapshot->endpoints[e];
+        uint64_t cumulative = 0;
+        int bucket = 0;
+        for (int l = 0; l < le_count; l++) {
+            while (bucket < VAULT_HIST_BUCKETS && vault_metrics_bucket_upper_us(bucket) <= le_us[l]) {
+                cumulative += stats->buckets[bucket++];
+            }
+            appendf(&buffer, "vault_client_request_duration_seconds_bucket{endpoint=\"%s\",le=\"%g\"} %llu\n",
+                    endpoint_names[e], le_us[l] / 1e6, (unsigned long long)cumulative);
+        }
+        appendf(&buffer, "vault_client_request_duration_seconds_bucket{endpoint=\"%s\",le=\"+Inf\"} %llu\n",
+                endpoint_names[e], (unsigned long long)stats->requests);
+        appendf(&buffer, "vault_client_request_duration_seconds_sum{endpoint=\"%s\"} %.6f\n",
+                endpoint_names[e], stats->latency_sum_us / 1e6);
+        appendf(&buffer, "vault_client_request_duration_seconds_count{endpoint=\"%s\"} %llu\n",
+                endpoint_names[e], (unsigned long long)stats->requests);
+    }
+
+    appendf(&buffer, "# HELP vault_client_cache_lookups_total Secret cache lookups by result.\n"
+                     "# TYPE vault_client_cache_lookups_total counter\n");
+    for (int k = 0; k < VAULT_CACHE_COUNT; k++) {
+        for (int r = 0; r < VAULT_CACHE_RESULT_COUNT; r++) {
+            appendf(&buffer, "vault_client_cache_lookups_total{cache=\"%s\",result=\"%s\"} %llu\n",
+                    cache_names[k], cache_result_names[r], (unsigned long long)snapshot->cache[k][r]);
+        }
+    }
+
+    appendf(&buffer, "# HELP vault_client_refresh_total Secret refresh outcomes.\n"
+                     "# TYPE vault_client_refresh_total counter\n");
+    for (int k = 0; k < VAULT_CACHE_COUNT; k++) {
+        for (int r = 0; r < VAULT_REFRESH_RESULT_COUNT; r++) {
+            appendf(&buffer, "vault_client_refresh_total{cache=\"%s\",result=\"%s\"} %llu\n",
+                    cache_names[k], refresh_result_names[r], (unsigned long long)snapshot->refresh[k][r]);
+        }
+    }
+
+    free(snapshot);
+    if (length) *length = buffer.data ? buffer.length : 0;
+    return buffer.data;
+}
+
+// Prometheus 엔드포인트 서버
+static int metrics_listen_fd = -1;
+static pthread_t metrics_thread;
+static volatile int metrics_stopping = 0;
+
+static void send_text(int fd, const char *status, const char *content_type, const char *body, size_t length) {
+    char header[256];
+    int n = snprintf(header, sizeof(header),
+                     "HTTP/1.1 %s\r\nContent-Type: %s\r\nContent-Length: %zu\r\nConnection: close\r\n\r\n",
+                     status, content_type, length);
+    if (write(fd, header, (size_t)n) != n) return;
+
+    while (length > 0) {
+        ssize_t written = write(fd, body, length);
+        if (written <= 0) return;
+        body += written;
+        length -= (size_t)written;
+    }
+}
+
+static void *metrics_server_thread(void *arg) {
+    (void)arg;
+
+    while (!metrics_stopping) {
+        int fd = accept(metrics_listen_fd, NULL, NULL);
+        if (fd < 0) {
+            if (metrics_stopping) break;
+            continue;
+        }
+
+        // 응답하지 않는 클라이언트가 스레드(및 종료 시 join)를 붙잡지 않도록 읽기/쓰기 제한
+        struct timeval timeout = { VAULT_METRICS_IO_TIMEOUT, 0 };
+        setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+        setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+        // 요청 라인만 확인 (GET /metrics)
+        char request[1024];
+        ssize_t n = read(fd, request, sizeof(request) - 1);
+        if (n > 0) {
+            request[n] = '\0';
+            if (strncmp(request, "GET /metrics", 12) == 0) {
+                size_t length = 0;
+                char *body = vault_metrics_format_prometheus(&length);
+                if (body) {
+                    send_text(fd, "200 OK", "text/plain; version=0.0.4", body, length);
+                    free(body);
+                } else {
+                    send_text(fd, "500 Internal Server Error", "text/plain", "", 0);
+                }
+            } else {
+                send_text(fd, "404 Not Found", "text/plain", "not found\n", 10);
+            }
+        }
+        close(fd);
+    }
+    return NULL;
+}
+
+int vault_metrics_server_start(const char *address, int port) {
+    if (port <= 0 || metrics_listen_fd >= 0) return -1;
+
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons((unsigned short)port);
+    if (!address || !address[0]) {
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    } else if (inet_pton(AF_INET, address, &addr.sin_addr) != 1) {
+        fprintf(stderr, "Invalid metrics bind address: %s\n", address);
+        return -1;
+    }
+
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) return -1;
+
+    int one = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+    if (bind(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0 || listen(fd, 16) != 0) {
+        perror("Failed to start metrics server");
+        close(fd);
+        return -1;
+    }
+
+    metrics_listen_fd = fd;
+    metrics_stopping = 0;
+    if (pthread_create(&metrics_thread, NULL, metrics_server_thread, NULL) != 0) {
+        close(fd);
+        metrics_listen_fd = -1;
+        return -1;
+    }
+    return 0;
+}
+
+void vault_metrics_server_stop(void) {
+    if (metrics_listen_fd < 0) return;
+
+    metrics_stopping = 1;
+    shutdown(metrics_listen_fd, SHUT_RDWR);
+    close(metrics_listen_fd);
+    pthread_join(metrics_thread, NULL);
+    metrics_listen_fd = -1;
+}
@@ -0,0 +1,89 @@
+#ifndef VAULT_METRICS_H
+#define VAULT_METRICS_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Vault 엔드포인트 구분 (지연 시간 히스토그램 단위)
+typedef enum {
+    VAULT_ENDPOINT_LOGIN,            // auth/approle/login
+    VAULT_ENDPOINT_RENEW_SELF,       // auth/token/renew-self
+    VAULT_ENDPOINT_KV_DATA,          // <entity>-kv/data/...
+    VAULT_ENDPOINT_DB_CREDS,         // <entity>-database/creds/...
+    VAULT_ENDPOINT_DB_STATIC_CREDS,  // <entity>-database/static-creds/...
+    VAULT_ENDPOINT_LEASE_LOOKUP,     // sys/leases/lookup
+    VAULT_ENDPOINT_OTHER,            // vault_get_secret 등 기타 경로
+    VAULT_ENDPOINT_TRANSIT,          // <entity>-transit/encrypt|decrypt/... (기록 파일 호환을 위해 끝에 추가)
+    VAULT_ENDPOINT_PKI,              // <entity>-pki/issue/...
+    VAULT_ENDPOINT_COUNT
+} vault_endpoint_t;
+
+// 캐시 종류
+typedef enum {
+    VAULT_CACHE_KV,
+    VAULT_CACHE_DB_DYNAMIC,
+    VAULT_CACHE_DB_STATIC,
+    VAULT_CACHE_COUNT
+} vault_cache_kind_t;
+
+// 캐시 조회 결과
+typedef enum {
+    VAULT_CACHE_HIT,    // 캐시가 유효하여 그대로 반환
+    VAULT_CACHE_MISS,   // 캐시 없음
+    VAULT_CACHE_STALE,  // 캐시가 오래되어 갱신 필요
+    VAULT_CACHE_RESULT_COUNT
+} vault_cache_result_t;
+
+// 시크릿 갱신 결과
+typedef enum {
+    VAULT_REFRESH_UPDATED,    // 새 값으로 교체
+    VAULT_REFRESH_UNCHANGED,  // 확인했으나 변경 없음
+    VAULT_REFRESH_FAILED,     // 갱신 실패
+    VAULT_REFRESH_RESULT_COUNT
+} vault_refresh_result_t;
+
+// 로그-선형(HDR 방식) 히스토그램: 2의 거듭제곱 구간마다 16개 선형 하위 구간 (상대 오차 약 6%)
+#define VAULT_HIST_SUB_BUCKETS 16
+#define VAULT_HIST_BUCKETS (VAULT_HIST_SUB_BUCKETS * 34)  // 최대 약 2^37 us (약 38시간)
+
+// 엔드포인트별 통계 스냅샷
+typedef struct {
+    uint64_t requests;        // 요청 수
+    uint64_t errors;          // 전송 실패 또는 HTTP 4xx/5xx
+    uint64_t bytes_received;  // 응답 본문 바이트
+    uint64_t latency_sum_us;  // 지연 시간 합 (us)
+    uint64_t latency_max_us;  // 최대 지연 시간 (us)
+    uint64_t p50_us;
+    uint64_t p90_us;
+    uint64_t p99_us;
+    uint64_t p999_us;
+    uint64_t buckets[VAULT_HIST_BUCKETS];  // 히스토그램 원본 (구간별 개수)
+} vault_endpoint_stats_t;
+
+// 전체 메트릭 스냅샷
+typedef struct {
+    vault_endpoint_stats_t endpoints[VAULT_ENDPOINT_COUNT];
+    uint64_t cache[VAULT_CACHE_COUNT][VAULT_CACHE_RESULT_COUNT];
+    uint64_t refresh[VAULT_CACHE_COUNT][VAULT_REFRESH_RESULT_COUNT];
+    uint64_t bytes_received;  // 전체 응답 바이트
+} vault_metrics_snapshot_t;
+
+// 기록 함수 (핫 패스 - 스레드별 슬롯에 잠금 없이 기록)
+uint64_t vault_metrics_now_ns(void);
+void vault_metrics_record_request(vault_endpoint_t endpoint, uint64_t latency_ns, uint64_t bytes, int error);
+void vault_metrics_record_cache(vault_cache_kind_t kind, vault_cache_result_t result);
+void vault_metrics_record_refresh(vault_cache_kind_t kind, vault_refresh_result_t result);
+
+// 조회 함수
+void vault_metrics_snapshot(vault_metrics_snapshot_t *snapshot);
+uint64_t vault_metrics_bucket_upper_us(int bucket);
+const char *vault_metrics_endpoint_name(vault_endpoint_t endpoint);
+const char *vault_metrics_cache_name(vault_cache_kind_t kind);
+char *vault_metrics_format_prometheus(size_t *length);
+
+// Prometheus 텍스트 엔드포인트 (GET /metrics)
+#define VAULT_METRICS_IO_TIMEOUT 2  // 스크레이프 연결의 읽기/쓰기 제한 (초)
+int vault_metrics_server_start(const char *address, int port);  // address: IPv4 (NULL이면 루프백)
+void vault_metrics_server_stop(void);
+
+#endif
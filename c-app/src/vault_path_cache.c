@@ -0,0 +1,151 @@
+#define _POSIX_C_SOURCE 200809L
+#include "vault_path_cache.h"
+#include "vault_schedule.h"
+#include <stdlib.h>
+#include <string.h>
+
+void vault_path_cache_init(vault_path_cache_t *cache) {
+    memset(cache->buckets, 0, sizeof(cache->buckets));
+    cache->count = 0;
+    pthread_rwlock_init(&cache->lock, NULL);
+}
+
+static void free_entry(vault_path_entry_t *entry) {
+    json_object_put(entry->data);
+    free(entry->path);
+    free(entry);
+}
+
+void vault_path_cache_clear(vault_path_cache_t *cache) {
+    // 목록만 떼어 내고 해제는 잠금 밖에서
+    vault_path_entry_t *detached[VAULT_PATH_CACHE_BUCKETS];
+    pthread_rwlock_wrlock(&cache->lock);
+    memcpy(detached, cache->buckets, sizeof(detached));
+    memset(cache->buckets, 0, sizeof(cache->buckets));
+    cache->count = 0;
+    pthread_rwlock_unlock(&cache->lock);
+
+    for (int i = 0; i < VAULT_PATH_CACHE_BUCKETS; i++) {
+        while (detached[i]) {
+            vault_path_entry_t *next = detached[i]->next;
+            free_entry(detached[i]);
+            detached[i] = next;
+        }
+    }
+}
+
+void vault_path_cache_destroy(vault_path_cache_t *cache) {
+    vault_path_cache_clear(cache);
+    pthread_rwlock_destroy(&cache->lock);
+}
+
+static vault_path_entry_t **find_slot(vault_path_cache_t *cache, const char *path) {
+    vault_path_entry_t **slot = &cache->buckets[vault_schedule_hash(path) % VAULT_PATH_CACHE_BUCKETS];
+    while (*slot && strcmp((*slot)->path, path) != 0) {
+        slot = &(*slot)->next;
+    }
+    return slot;
+}
+
+int vault_path_cache_get(vault_path_cache_t *cache, const char *path, int max_age, json_object **data) {
+    if (!cache || !path || !data) return -1;
+
+    int rc = -1;
+    time_t now = time(NULL);
+    pthread_rwlock_rdlock(&cache->lock);
+    vault_path_entry_t *entry = *find_slot(cache, path);
+    if (entry && now - entry->checked_at < max_age) {
+        *data = NULL;
+        rc = json_object_deep_copy(entry->data, data, NULL) == 0 ? 0 : -1;
+    }
+    pthread_rwlock_unlock(&cache->lock);
+    return rc;
+}
+
+int vault_path_cache_put(vault_path_cache_t *cache, const char *path, json_object *data, long version) {
+    if (!cache || !path || !data) {
+        json_object_put(data);
+        return -1;
+    }
+
+    json_object *old_data = NULL;
+    int rc = 0;
+    pthread_rwlock_wrlock(&cache->lock);
+    vault_path_entry_t **slot = find_slot(cache, path);
+    if (*slot) {
+        old_data = (*slot)->data;
+        (*slot)->data = data;
+        (*slot)->version = version;
+        (*slot)->checked_at = time(NULL);
+    } else if (cache->count < VAULT_PATH_CACHE_MAX_ENTRIES) {
+        vault_path_entry_t *entry = calloc(1, sizeof(vault_path_entry_t));
+        char *copy = strdup(path);
+        if (entry && copy) {
+            entry->path = copy;
+            entry->data = data;
+            entry->version = version;
+            entry->checked_at = time(NULL);
+            *slot = entry;
+            cache->count++;
+        } else {
+            free(entry);
+            free(copy);
+            old_data = data;
+            rc = -1;
+        }
+    } else {
+        old_data = data;
+        rc = -1;
+    }
+    pthread_rwlock_unlock(&cache->lock);
+
+    json_object_put(old_data);
+    return rc;
+}
+
+int vault_path_cache_version(vault_path_cache_t *cache, const char *path, long *version) {
+    if (!cache || !path) return -1;
+
+    pthread_rwlock_rdlock(&cache->lock);
+    vault_path_entry_t *entry = *find_slot(cache, path);
+    if (entry && version) *version = entry->version;
+    pthread_rwlock_unlock(&cache->lock);
+    return entry ? 0 : -1;
+}
+
+int vault_path_cache_touch(vault_path_cache_t *cache, const char *path, long version) {
+    if (!cache || !path) return -1;
+
+    int rc = -1;
+    pthread_rwlock_wrlock(&cache->lock);
+    vault_path_entry_t *entry = *find_slot(cache, path);
+    if (entry && entry->version == version) {
+        entry->checked_at = time(NULL);
+        rc = 0;
+    }
+    pthread_rwlock_unlock(&cache->lock);
+    return rc;
+}
+
+int vault_path_cache_invalidate(vault_path_cache_t *cache, const char *path, long version) {
+    if (!cache || !path) return -1;
+
+    int rc = -1;
+    pthread_rwlock_wrlock(&cache->lock);
+    vault_path_entry_t *entry = *find_slot(cache, path);
+    if (entry && (version < 0 || entry->version != version)) {
+        // 다음 조회는 캐시를 건너뛰고, 프리페치는 버전 불일치로 다시 읽음
+        entry->checked_at = 0;
+        entry->version = -1;
+        rc = 0;
+    }
+    pthread_rwlock_unlock(&cache->lock);
+    return rc;
+}
+
+size_t vault_path_cache_count(vault_path_cache_t *cache) {
+    pthread_rwlock_rdlock(&cache->lock);
+    size_t count = cache->count;
+    pthread_rwlock_unlock(&cache->lock);
+    return count;
+}
@@ -0,0 +1,53 @@
+#ifndef VAULT_PATH_CACHE_H
+#define VAULT_PATH_CACHE_H
+
+#include <json.h>
+#include <stddef.h>
+#include <time.h>
+#include <pthread.h>
+
+// 경로별 KV 문서 캐시
+// vault_get_secrets()와 vault_prefetch_kv()가 채우고, 확인 후 max_age초가 지나지 않은
+// 경로는 요청 없이 여기서 반환합니다. 항목은 KV v2 data.data 맵과 metadata.version을 보관합니다.
+// 조회는 읽기 잠금 아래에서 깊은 복사본을 만들어 반환하므로 어느 스레드에서든 해제할 수 있습니다.
+
+#define VAULT_PATH_CACHE_BUCKETS 256
+#define VAULT_PATH_CACHE_MAX_ENTRIES 4096  // 이를 넘는 경로는 캐시하지 않고 매번 조회
+
+typedef struct vault_path_entry {
+    char *path;
+    json_object *data;      // data.data
+    long version;           // metadata.version (없으면 0)
+    time_t checked_at;      // Vault에서 마지막으로 확인한 시각
+    struct vault_path_entry *next;
+} vault_path_entry_t;
+
+typedef struct {
+    vault_path_entry_t *buckets[VAULT_PATH_CACHE_BUCKETS];
+    size_t count;
+    pthread_rwlock_t lock;
+} vault_path_cache_t;
+
+void vault_path_cache_init(vault_path_cache_t *cache);
+void vault_path_cache_destroy(vault_path_cache_t *cache);
+void vault_path_cache_clear(vault_path_cache_t *cache);
+
+// max_age초 이내에 확인된 항목이면 복사본을 *data에 넣고 0 반환 (없거나 오래되면 -1)
+int vault_path_cache_get(vault_path_cache_t *cache, const char *path, int max_age, json_object **data);
+
+// 조회한 문서 저장 (data 참조는 캐시가 가져감, 가득 차면 해제하고 -1)
+int vault_path_cache_put(vault_path_cache_t *cache, const char *path, json_object *data, long version);
+
+// 캐시된 항목의 버전 (version이 NULL이면 존재 여부만, 없으면 -1)
+int vault_path_cache_version(vault_path_cache_t *cache, const char *path, long *version);
+
+// 버전이 그대로임을 확인한 경우 확인 시각만 갱신 (버전이 다르거나 없으면 -1)
+int vault_path_cache_touch(vault_path_cache_t *cache, const char *path, long version);
+
+// 경로가 바뀌었음을 알게 된 경우 (쓰기 이벤트) 항목을 만료 처리
+// 캐시에 있고 버전이 version과 다르면 0 (version < 0이면 항상), 없거나 이미 최신이면 -1
+int vault_path_cache_invalidate(vault_path_cache_t *cache, const char *path, long version);
+
+size_t vault_path_cache_count(vault_path_cache_t *cache);
+
+#endif
@@ -0,0 +1,496 @@
+#define _POSIX_C_SOURCE 200809L
+#include "vault_pki.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <openssl/pem.h>
+#include <openssl/x509.h>
+
+// 인증서 PEM에서 NotBefore/NotAfter 읽기 (현재 시각 기준 차이로 계산하여 시간대 변환 없이 time_t로)
+static int parse_validity(const char *pem, time_t *not_before, time_t *not_after) {
+    BIO *bio = BIO_new_mem_buf(pem, -1);
+    X509 *cert = bio ? PEM_read_bio_X509(bio, NULL, NULL, NULL) : NULL;
+    int rc = -1;
+    if (cert) {
+        time_t now = time(NULL);
+        int days, secs;
+        if (ASN1_TIME_diff(&days, &secs, NULL, X509_get0_notBefore(cert)) == 1) {
+            *not_before = now + (time_t)days * 86400 + secs;
+            if (ASN1_TIME_diff(&days, &secs, NULL, X509_get0_notAfter(cert)) == 1) {
+                *not_after = now + (time_t)days * 86400 + secs;
+                rc = 0;
+            }
+        }
+        X509_free(cert);
+    }
+    BIO_free(bio);
+    return rc;
+}
+
+// PEM을 칸에 복사하고 다음 위치 반환 (끝에 줄바꿈이 없으면 붙임)
+static char *copy_pem(char *dst, const char *pem) {
+    size_t len = strlen(pem);
+    memcpy(dst, pem, len);
+    if (len > 0 && pem[len - 1] != '\n') dst[len++] = '\n';
+    dst[len] = '\0';
+    return dst + len + 1;
+}
+
+static void cert_release(vault_pki_t *pki, vault_pki_cert_t *cert) {
+    if (!cert) return;
+    pthread_mutex_lock(&pki->lock);
+    int last = --cert->refs == 0;
+    pthread_mutex_unlock(&pki->lock);
+    if (last) {
+        vault_secure_free(&pki->arena, cert->slot);
+        free(cert);
+    }
+}
+
+// 발급 요청 후 인증서 구성 (잠금 밖에서 호출, 실패 시 NULL)
+static vault_pki_cert_t *pki_issue(vault_pki_t *pki) {
+    json_object *response = NULL;
+    uint64_t start = vault_metrics_now_ns();
+    int rc = vault_write_sensitive(pki->client, pki->path, pki->body, VAULT_ENDPOINT_PKI, &response);
+    double elapsed_ms = (double)(vault_metrics_now_ns() - start) / 1e6;
+
+    pthread_mutex_lock(&pki->lock);
+    pki->stats.last_issue_ms = elapsed_ms;
+    if (elapsed_ms > pki->stats.max_issue_ms) pki->stats.max_issue_ms = elapsed_ms;
+    pthread_mutex_unlock(&pki->lock);
+
+    json_object *data = NULL, *certificate = NULL, *private_key = NULL, *value;
+    if (rc != 0 || !json_object_object_get_ex(response, "data", &data) ||
+        !json_object_object_get_ex(data, "certificate", &certificate) ||
+        !json_object_object_get_ex(data, "private_key", &private_key)) {
+        VAULT_LOG_ERROR("PKI issue failed (%s)", pki->path);
+        json_object_put(response);
+        return NULL;
+    }
+
+    // 체인: ca_chain 전체, 없으면 issuing_ca
+    size_t chain_len = 0;
+    json_object *ca_chain = NULL, *issuing_ca = NULL;
+    if (json_object_object_get_ex(data, "ca_chain", &ca_chain) && json_object_is_type(ca_chain, json_type_array) &&
+        json_object_array_length(ca_chain) > 0) {
+        for (size_t i = 0; i < json_object_array_length(ca_chain); i++) {
+            chain_len += (size_t)json_object_get_string_len(json_object_array_get_idx(ca_chain, i)) + 1;
+        }
+    } else {
+        ca_chain = NULL;
+        if (json_object_object_get_ex(data, "issuing_ca", &issuing_ca)) {
+            chain_len = (size_t)json_object_get_string_len(issuing_ca) + 1;
+        }
+    }
+
+    const char *cert_pem = json_object_get_string(certificate);
+    const char *key_pem = json_object_get_string(private_key);
+    size_t total = strlen(cert_pem) + strlen(key_pem) + chain_len + 6;
+    vault_pki_cert_t *cert = NULL;
+    if (total > VAULT_PKI_MAX_BUNDLE) {
+        VAULT_LOG_ERROR("PKI bundle of %zu bytes exceeds the %d-byte key slot", total, VAULT_PKI_MAX_BUNDLE);
+    } else if ((cert = calloc(1, sizeof(vault_pki_cert_t))) != NULL &&
+               (cert->slot = vault_secure_alloc(&pki->arena)) == NULL) {
+        VAULT_LOG_ERROR("PKI key arena exhausted (%zu slots, certificates still held by vault_pki_acquire callers)",
+                        vault_secure_capacity(&pki->arena));
+    }
+    if (!cert || !cert->slot) {
+        free(cert);
+        vault_secure_zero((char *)key_pem, strlen(key_pem));
+        json_object_put(response);
+        return NULL;
+    }
+
+    char *p = (char *)cert->slot;
+    cert->certificate = p;
+    p = copy_pem(p, cert_pem);
+    cert->private_key = p;
+    p = copy_pem(p, key_pem);
+    cert->chain = p;
+    *p = '\0';
+    if (ca_chain) {
+        for (size_t i = 0; i < json_object_array_length(ca_chain); i++) {
+            p = copy_pem(p, json_object_get_string(json_object_array_get_idx(ca_chain, i))) - 1;  // 이어 붙임
+        }
+    } else if (issuing_ca) {
+        copy_pem(p, json_object_get_string(issuing_ca));
+    }
+    // 응답 안의 개인 키는 지움 (잠긴 칸에만 남김)
+    vault_secure_zero((char *)key_pem, strlen(key_pem));
+
+    if (json_object_object_get_ex(data, "serial_number", &value)) {
+        snprintf(cert->serial, sizeof(cert->serial), "%s", json_object_get_string(value));
+    }
+    if (parse_validity(cert->certificate, &cert->not_before, &cert->not_after) != 0) {
+        // 인증서를 읽을 수 없으면 응답의 expiration과 발급 시각 사용
+        cert->not_before = time(NULL);
+        cert->not_after = json_object_object_get_ex(data, "expiration", &value) ? (time_t)json_object_get_int64(value)
+                                                                                : 0;
+    }
+    json_object_put(response);
+
+    if (cert->not_after <= cert->not_before) {
+        VAULT_LOG_ERROR("PKI certificate has no usable validity period (serial: %s)", cert->serial);
+        vault_secure_free(&pki->arena, cert->slot);
+        free(cert);
+        return NULL;
+    }
+    cert->renew_at = cert->not_before + (cert->not_after - cert->not_before) * pki->renew_at / 100;
+    return cert;
+}
+
+// 임시 파일에 PEM들을 쓰고 fsync (rename은 호출자가 두 파일을 모두 쓴 뒤 수행)
+static int write_temp(const char *tmp, const char *const parts[], int count, mode_t mode) {
+    int fd = open(tmp, O_WRONLY | O_CREAT | O_TRUNC, mode);
+    if (fd < 0) return -1;
+    int rc = fchmod(fd, mode);  // 이미 있던 임시 파일의 권한도 맞춤
+    for (int i = 0; i < count && rc == 0; i++) {
+        const char *data = parts[i];
+        size_t len = strlen(data);
+        while (len > 0) {
+            ssize_t n = write(fd, data, len);
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) {
+                rc = -1;
+                break;
+            }
+            data += n;
+            len -= (size_t)n;
+        }
+    }
+    if (rc == 0) rc = fsync(fd);
+    int saved = errno;
+    if (close(fd) != 0) {
+        saved = rc == 0 ? errno : saved;
+        rc = -1;
+    }
+    if (rc != 0) {
+        unlink(tmp);
+        errno = saved;
+    }
+    return rc;
+}
+
+// 개인 키와 인증서(+체인) 파일 교체: 두 임시 파일을 모두 쓴 뒤 키, 인증서 순으로 rename
+// 인증서 rename이 실패하면 이전 키(.prev로 걸어 둔 하드 링크)를 되돌려 키와 인증서가 어긋나지 않게 합니다
+// (이전 키가 없었으면 새 키를 지움).
+static int write_files(vault_pki_t *pki, const vault_pki_cert_t *cert) {
+    char key_tmp[600], cert_tmp[600], key_prev[600];
+    snprintf(key_tmp, sizeof(key_tmp), "%s.tmp", pki->key_file);
+    snprintf(cert_tmp, sizeof(cert_tmp), "%s.tmp", pki->cert_file);
+    snprintf(key_prev, sizeof(key_prev), "%s.prev", pki->key_file);
+    const char *key_parts[] = { cert->private_key };
+    const char *cert_parts[] = { cert->certificate, cert->chain };
+
+    if (write_temp(key_tmp, key_parts, 1, 0600) != 0) return -1;
+    if (write_temp(cert_tmp, cert_parts, 2, 0644) != 0) {
+        int saved = errno;
+        unlink(key_tmp);
+        errno = saved;
+        return -1;
+    }
+    unlink(key_prev);  // 이전 실행에서 남았을 수 있음
+    int has_prev = link(pki->key_file, key_prev) == 0;
+    if (!has_prev && errno != ENOENT) {
+        int saved = errno;
+        unlink(key_tmp);
+        unlink(cert_tmp);
+        errno = saved;
+        return -1;
+    }
+    if (rename(key_tmp, pki->key_file) != 0) {
+        int saved = errno;
+        unlink(key_tmp);
+        unlink(cert_tmp);
+        if (has_prev) unlink(key_prev);
+        errno = saved;
+        return -1;
+    }
+    if (rename(cert_tmp, pki->cert_file) != 0) {
+        int saved = errno;
+        unlink(cert_tmp);
+        if (has_prev) rename(key_prev, pki->key_file);
+        else unlink(pki->key_file);
+        errno = saved;
+        return -1;
+    }
+    if (has_prev) unlink(key_prev);
+    return 0;
+}
+
+// 실패 후 재시도 시각 설정 후 간격 두 배 (잠금 상태에서 호출, 이번 대기 시간 반환)
+static int schedule_retry(vault_pki_t *pki, time_t now) {
+    // 현재 인증서가 만료되기 전에 몇 번 더 시도하도록 남은 유효 기간의 절반을 넘기지 않음
+    int delay = pki->retry_delay;
+    if (pki->current && pki->current->not_after > now) {
+        long half = (long)(pki->current->not_after - now) / 2;
+        if (half < VAULT_PKI_MIN_RETRY) half = VAULT_PKI_MIN_RETRY;
+        if (delay > half) delay = (int)half;
+    }
+    // 파일 재시도 중에 다음 발급 시각이 오면 발급부터 (pki_thread)
+    if (pki->current && pki->current->renew_at > now && now + delay > pki->current->renew_at) {
+        delay = (int)(pki->current->renew_at - now);
+    }
+    pki->next_attempt = now + delay;
+    pki->stats.renew_at = pki->next_attempt;
+    pki->retry_delay = pki->retry_delay * 2 > VAULT_PKI_MAX_RETRY ? VAULT_PKI_MAX_RETRY : pki->retry_delay * 2;
+    return delay;
+}
+
+// 발급, 파일 교체, 인증서 교체, 콜백 호출 후 다음 시도 시각 설정
+// 파일 교체만 실패하면 새 인증서는 그대로 쓰고 파일 쓰기를 재시도 간격으로 다시 시도
+static int pki_renew(vault_pki_t *pki) {
+    vault_pki_cert_t *fresh = pki_issue(pki);
+    time_t now = time(NULL);
+    if (!fresh) {
+        pthread_mutex_lock(&pki->lock);
+        pki->stats.failures++;
+        int delay = schedule_retry(pki, now);
+        pthread_mutex_unlock(&pki->lock);
+        VAULT_LOG_WARN("PKI issue retry in %d seconds", delay);
+        return -1;
+    }
+
+    int file_rc = 0, file_err = 0;
+    if (pki->cert_file[0]) {
+        file_rc = write_files(pki, fresh);
+        file_err = errno;
+    }
+
+    vault_pki_reload_t callbacks[VAULT_PKI_MAX_CALLBACKS];
+    void *callback_ctx[VAULT_PKI_MAX_CALLBACKS];
+    pthread_mutex_lock(&pki->lock);
+    vault_pki_cert_t *old = pki->current;
+    fresh->generation = ++pki->stats.generation;
+    fresh->refs = 2;  // 모듈 + 아래 콜백 호출
+    pki->current = fresh;
+    pki->stats.issued++;
+    pki->stats.not_after = fresh->not_after;
+    if (pki->cert_file[0]) {
+        if (file_rc == 0) pki->stats.file_writes++;
+        else pki->stats.file_failures++;
+    }
+    pki->files_pending = file_rc != 0;
+    if (file_rc != 0) {
+        schedule_retry(pki, now);
+    } else {
+        // 수명이 매우 짧아 이미 갱신 시각이 지났으면 최소 재시도 간격 뒤에
+        pki->next_attempt = fresh->renew_at > now ? fresh->renew_at : now + VAULT_PKI_MIN_RETRY;
+        pki->stats.renew_at = pki->next_attempt;
+        pki->retry_delay = VAULT_PKI_MIN_RETRY;
+    }
+    time_t next = pki->next_attempt;
+    int count = pki->callback_count;
+    memcpy(callbacks, pki->callbacks, sizeof(callbacks));
+    memcpy(callback_ctx, pki->callback_ctx, sizeof(callback_ctx));
+    pki->stats.callbacks += (uint64_t)count;
+    pthread_mutex_unlock(&pki->lock);
+
+    cert_release(pki, old);
+    if (file_rc != 0) {
+        VAULT_LOG_ERROR("Failed to write PKI files %s, %s: %s (retry in %ld seconds)",
+                        pki->cert_file, pki->key_file, strerror(file_err), (long)(next - now));
+        next = fresh->renew_at;
+    }
+    VAULT_LOG_INFO("📜 Certificate issued (serial: %s, expires in %ld seconds, next issue in %ld seconds)",
+                   fresh->serial, (long)(fresh->not_after - now), (long)(next - now));
+    for (int i = 0; i < count; i++) {
+        callbacks[i](fresh, callback_ctx[i]);
+    }
+    cert_release(pki, fresh);
+    return 0;
+}
+
+// 현재 인증서의 파일 교체만 다시 시도 (발급은 이미 성공)
+static int pki_retry_files(vault_pki_t *pki) {
+    pthread_mutex_lock(&pki->lock);
+    vault_pki_cert_t *cert = pki->current;
+    cert->refs++;
+    pthread_mutex_unlock(&pki->lock);
+
+    int rc = write_files(pki, cert);
+    int err = errno;
+    time_t now = time(NULL);
+
+    pthread_mutex_lock(&pki->lock);
+    int delay = 0;
+    if (rc == 0) {
+        pki->stats.file_writes++;
+        // 그사이 새 인증서로 교체되었으면 그 발급이 일정을 정함
+        if (pki->current == cert) {
+            pki->files_pending = 0;
+            pki->next_attempt = cert->renew_at > now ? cert->renew_at : now + VAULT_PKI_MIN_RETRY;
+            pki->stats.renew_at = pki->next_attempt;
+            pki->retry_delay = VAULT_PKI_MIN_RETRY;
+        }
+    } else {
+        pki->stats.file_failures++;
+        if (pki->current == cert) delay = schedule_retry(pki, now);
+    }
+    pthread_mutex_unlock(&pki->lock);
+
+    if (rc == 0) {
+        VAULT_LOG_INFO("📜 PKI files written (serial: %s)", cert->serial);
+    } else {
+        VAULT_LOG_ERROR("Failed to write PKI files %s, %s: %s (retry in %d seconds)",
+                        pki->cert_file, pki->key_file, strerror(err), delay);
+    }
+    cert_release(pki, cert);
+    return rc;
+}
+
+// 갱신 스레드: 다음 시도 시각까지 대기 후 발급
+static void *pki_thread(void *arg) {
+    vault_pki_t *pki = (vault_pki_t *)arg;
+    pthread_mutex_lock(&pki->lock);
+    while (!pki->stopping) {
+        time_t now = time(NULL);
+        if (now < pki->next_attempt) {
+            // 벽시계 변경에 대비하여 최대 60초마다 다시 계산
+            long wait = (long)(pki->next_attempt - now);
+            if (wait > 60) wait = 60;
+            struct timespec ts;
+            clock_gettime(CLOCK_MONOTONIC, &ts);
+            ts.tv_sec += wait;
+            pthread_cond_timedwait(&pki->wake, &pki->lock, &ts);
+            continue;
+        }
+        // 파일 쓰기만 실패한 인증서는 다음 발급 시각 전까지 파일 교체만 재시도
+        int files_only = pki->files_pending && pki->current && now < pki->current->renew_at;
+        pthread_mutex_unlock(&pki->lock);
+        if (files_only) pki_retry_files(pki);
+        else pki_renew(pki);
+        pthread_mutex_lock(&pki->lock);
+    }
+    pthread_mutex_unlock(&pki->lock);
+    vault_client_thread_cleanup();
+    return NULL;
+}
+
+int vault_pki_init(vault_pki_t *pki, vault_client_t *client) {
+    if (!pki || !client || !client->config) return -1;
+
+    memset(pki, 0, sizeof(*pki));
+    const app_config_t *config = client->config;
+    pki->client = client;
+    snprintf(pki->path, sizeof(pki->path), "%s-pki/issue/%s", config->entity, config->pki.role);
+    pki->renew_at = config->pki.renew_at < 1 ? 1 : config->pki.renew_at > 100 ? 100 : config->pki.renew_at;
+    snprintf(pki->cert_file, sizeof(pki->cert_file), "%s", config->pki.cert_file);
+    snprintf(pki->key_file, sizeof(pki->key_file), "%s", config->pki.key_file);
+    pki->retry_delay = VAULT_PKI_MIN_RETRY;
+
+    json_object *body = json_object_new_object();
+    json_object_object_add(body, "common_name", json_object_new_string(config->pki.common_name));
+    if (config->pki.alt_names[0]) {
+        json_object_object_add(body, "alt_names", json_object_new_string(config->pki.alt_names));
+    }
+    if (config->pki.ttl[0]) json_object_object_add(body, "ttl", json_object_new_string(config->pki.ttl));
+    json_object_object_add(body, "format", json_object_new_string("pem"));
+    snprintf(pki->body, sizeof(pki->body), "%s", json_object_to_json_string_ext(body, JSON_C_TO_STRING_PLAIN));
+    json_object_put(body);
+
+    // 현재 인증서, 교체 중인 새 인증서, 아직 반납되지 않은 이전 인증서 둘
+    // (호출자가 이전 인증서를 더 오래 잡고 있으면 영역이 늘어남)
+    if (vault_secure_arena_init(&pki->arena, VAULT_PKI_MAX_BUNDLE, 4) != 0) {
+        VAULT_LOG_ERROR("Failed to allocate PKI key arena");
+        return -1;
+    }
+    pki->stats.locked = pki->arena.locked;
+    pthread_mutex_init(&pki->lock, NULL);
+    // 시계 변경에 영향받지 않도록 단조 시계로 대기
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&pki->wake, &attr);
+    pthread_condattr_destroy(&attr);
+    return 0;
+}
+
+int vault_pki_start(vault_pki_t *pki) {
+    if (!pki || !pki->client || pki->running) return -1;
+
+    int rc = pki_renew(pki);
+    if (pthread_create(&pki->thread, NULL, pki_thread, pki) != 0) {
+        VAULT_LOG_ERROR("Failed to create PKI renewal thread");
+        return -1;
+    }
+    pki->running = 1;
+    return rc;
+}
+
+void vault_pki_stop(vault_pki_t *pki) {
+    if (!pki || !pki->running) return;
+    pthread_mutex_lock(&pki->lock);
+    pki->stopping = 1;
+    pthread_cond_broadcast(&pki->wake);
+    pthread_mutex_unlock(&pki->lock);
+    pthread_join(pki->thread, NULL);
+    pki->running = 0;
+}
+
+void vault_pki_destroy(vault_pki_t *pki) {
+    if (!pki || !pki->client) return;
+    vault_pki_stop(pki);
+    vault_pki_cert_t *current = pki->current;
+    pki->current = NULL;
+    cert_release(pki, current);
+    vault_secure_arena_destroy(&pki->arena);
+    pthread_cond_destroy(&pki->wake);
+    pthread_mutex_destroy(&pki->lock);
+    pki->client = NULL;
+}
+
+const vault_pki_cert_t *vault_pki_acquire(vault_pki_t *pki) {
+    pthread_mutex_lock(&pki->lock);
+    vault_pki_cert_t *cert = pki->current;
+    if (cert) cert->refs++;
+    pthread_mutex_unlock(&pki->lock);
+    return cert;
+}
+
+void vault_pki_release(vault_pki_t *pki, const vault_pki_cert_t *cert) {
+    cert_release(pki, (vault_pki_cert_t *)cert);
+}
+
+int vault_pki_on_reload(vault_pki_t *pki, vault_pki_reload_t callback, void *ctx) {
+    if (!pki || !callback) return -1;
+
+    pthread_mutex_lock(&pki->lock);
+    if (pki->callback_count >= VAULT_PKI_MAX_CALLBACKS) {
+        pthread_mutex_unlock(&pki->lock);
+        return -1;
+    }
+    pki->callbacks[pki->callback_count] = callback;
+    pki->callback_ctx[pki->callback_count] = ctx;
+    pki->callback_count++;
+    vault_pki_cert_t *cert = pki->current;
+    if (cert) {
+        cert->refs++;
+        pki->stats.callbacks++;
+    }
+    pthread_mutex_unlock(&pki->lock);
+
+    if (cert) {
+        callback(cert, ctx);
+        cert_release(pki, cert);
+    }
+    return 0;
+}
+
+void vault_pki_renew_now(vault_pki_t *pki) {
+    pthread_mutex_lock(&pki->lock);
+    pki->next_attempt = 0;
+    pki->files_pending = 0;  // 파일 재시도 중이어도 새로 발급
+    pthread_cond_signal(&pki->wake);
+    pthread_mutex_unlock(&pki->lock);
+}
+
+void vault_pki_get_stats(vault_pki_t *pki, vault_pki_stats_t *stats) {
+    pthread_mutex_lock(&pki->lock);
+    *stats = pki->stats;
+    pthread_mutex_unlock(&pki->lock);
+}
@@ -0,0 +1,100 @@
+#ifndef VAULT_PKI_H
+#define VAULT_PKI_H
+
+#include <stdint.h>
+#include <time.h>
+#include <pthread.h>
+#include "vault_client.h"
+#include "vault_secure.h"
+
+// PKI 인증서 발급 ({entity}-pki/issue/{role})
+// 기동 시 인증서를 한 번 발급하고, 백그라운드 스레드가 유효 기간의 renew_at% 시점에 다음 인증서를
+// 미리 발급합니다 (발급 중에도 기존 인증서를 계속 사용).
+// 인증서/개인 키/체인 PEM은 잠긴 메모리 영역에 두고, 새 인증서는 잠금 안에서 포인터 하나로 교체합니다.
+// cert_file/key_file이 설정되어 있으면 교체 전에 임시 파일에 쓰고 rename으로 바꾸며,
+// 교체 후 등록된 재적재 콜백(TLS 컨텍스트 등)을 호출합니다.
+// 발급이 실패하면 5초부터 두 배씩(최대 5분, 현재 인증서 남은 유효 기간의 절반 이하) 늘려 다시 시도합니다.
+// 파일 교체만 실패하면 새 인증서는 그대로 쓰고 같은 간격으로 파일 쓰기만 다시 시도합니다.
+
+#define VAULT_PKI_MAX_BUNDLE 32768   // 인증서 + 개인 키 + 체인 PEM 합계 최대 크기
+#define VAULT_PKI_MAX_CALLBACKS 8
+#define VAULT_PKI_MIN_RETRY 5
+#define VAULT_PKI_MAX_RETRY 300
+
+typedef struct vault_pki_cert {
+    const char *certificate;     // PEM
+    const char *private_key;     // PEM
+    const char *chain;           // ca_chain을 이어 붙인 PEM (없으면 issuing_ca)
+    char serial[128];
+    time_t not_before;
+    time_t not_after;
+    time_t renew_at;             // 다음 인증서 발급 시각
+    unsigned long generation;    // 발급 순번 (1부터)
+
+    int refs;                    // 모듈(현재 인증서) + vault_pki_acquire 호출자
+    unsigned char *slot;         // PEM이 들어 있는 arena 칸
+} vault_pki_cert_t;
+
+// 새 인증서로 교체된 뒤 호출 (갱신 스레드, 등록 시 인증서가 있으면 등록한 스레드에서 한 번)
+// cert는 콜백 안에서만 유효하며, 필요한 내용은 복사해야 합니다.
+typedef void (*vault_pki_reload_t)(const vault_pki_cert_t *cert, void *ctx);
+
+typedef struct {
+    uint64_t issued;             // 발급 성공
+    uint64_t failures;           // 발급 실패 (요청 실패, 응답 형식 오류, arena 부족)
+    uint64_t file_writes;        // PEM 파일 교체
+    uint64_t file_failures;
+    uint64_t callbacks;          // 재적재 콜백 호출
+    double last_issue_ms;        // 마지막 발급 요청 소요 시간
+    double max_issue_ms;
+    unsigned long generation;
+    time_t not_after;            // 현재 인증서 만료 시각 (없으면 0)
+    time_t renew_at;             // 다음 발급 시도 시각
+    int locked;                  // PEM 영역 mlock 여부
+} vault_pki_stats_t;
+
+typedef struct {
+    vault_client_t *client;
+    char path[512];              // {entity}-pki/issue/{role}
+    char body[1024];             // 발급 요청 본문
+    int renew_at;                // 유효 기간 대비 %
+    char cert_file[512];
+    char key_file[512];
+
+    vault_secure_arena_t arena;
+    pthread_mutex_t lock;        // 현재 인증서/콜백/통계 보호
+    pthread_cond_t wake;         // 갱신 스레드 깨우기 (단조 시계)
+    vault_pki_cert_t *current;
+    time_t next_attempt;         // 다음 발급 시도 시각
+    int retry_delay;             // 실패 후 재시도 간격 (초)
+    int files_pending;           // 현재 인증서의 파일 교체가 실패하여 다시 써야 함
+    vault_pki_reload_t callbacks[VAULT_PKI_MAX_CALLBACKS];
+    void *callback_ctx[VAULT_PKI_MAX_CALLBACKS];
+    int callback_count;
+
+    pthread_t thread;
+    int running;
+    int stopping;
+    vault_pki_stats_t stats;
+} vault_pki_t;
+
+// client->config->pki로 초기화 (요청은 보내지 않음)
+int vault_pki_init(vault_pki_t *pki, vault_client_t *client);
+// 첫 인증서를 발급하고 갱신 스레드 시작 (첫 발급이 실패해도 스레드는 시작하여 재시도, 실패 시 -1)
+int vault_pki_start(vault_pki_t *pki);
+void vault_pki_stop(vault_pki_t *pki);
+void vault_pki_destroy(vault_pki_t *pki);
+
+// 현재 인증서 참조 (없으면 NULL, vault_pki_release로 반납할 때까지 교체되어도 유효)
+const vault_pki_cert_t *vault_pki_acquire(vault_pki_t *pki);
+void vault_pki_release(vault_pki_t *pki, const vault_pki_cert_t *cert);
+
+// 재적재 콜백 등록 (현재 인증서가 있으면 바로 한 번 호출)
+int vault_pki_on_reload(vault_pki_t *pki, vault_pki_reload_t callback, void *ctx);
+
+// 다음 발급을 지금 시도하도록 갱신 스레드 깨우기 (키 유출 대응 등)
+void vault_pki_renew_now(vault_pki_t *pki);
+
+void vault_pki_get_stats(vault_pki_t *pki, vault_pki_stats_t *stats);
+
+#endif
@@ -0,0 +1,237 @@
+#define _POSIX_C_SOURCE 200809L
+#include "vault_record.h"
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+
+typedef char record_event_size_check[sizeof(vault_record_event_t) == 32 ? 1 : -1];
+
+static const char *call_names[VAULT_CALL_COUNT] = {
+    "login", "refresh_token", "get_kv", "get_db_dynamic", "get_db_static",
+    "refresh_kv", "refresh_db_dynamic", "refresh_db_static"
+};
+
+// 기록은 선택 기능이므로 파일 쓰기는 뮤텍스 하나로 직렬화합니다.
+// 기록 중이 아닐 때의 비용은 recording 플래그 로드 한 번입니다.
+static pthread_mutex_t record_mutex = PTHREAD_MUTEX_INITIALIZER;
+static FILE *record_file = NULL;
+static int recording = 0;
+static uint64_t record_start_ns = 0;
+static uint16_t next_thread = 0;
+static __thread uint16_t thread_id = 0;
+static __thread int call_depth = 0;
+
+static uint16_t current_thread(void) {
+    if (thread_id == 0) {
+        thread_id = __atomic_add_fetch(&next_thread, 1, __ATOMIC_RELAXED);
+    }
+    return thread_id;
+}
+
+int vault_record_open(const char *path) {
+    if (!path || !path[0]) return 0;
+
+    FILE *file = fopen(path, "wb");
+    if (!file) {
+        perror("Failed to open record file");
+        return -1;
+    }
+
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    vault_record_header_t header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, VAULT_RECORD_MAGIC, sizeof(header.magic));
+    header.version = VAULT_RECORD_VERSION;
+    header.start_unix_ns = (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+    if (fwrite(&header, sizeof(header), 1, file) != 1) {
+        fclose(file);
+        return -1;
+    }
+
+    pthread_mutex_lock(&record_mutex);
+    if (record_file) fclose(record_file);
+    record_file = file;
+    record_start_ns = vault_metrics_now_ns();
+    __atomic_store_n(&recording, 1, __ATOMIC_RELEASE);
+    pthread_mutex_unlock(&record_mutex);
+    return 0;
+}
+
+void vault_record_close(void) {
+    pthread_mutex_lock(&record_mutex);
+    __atomic_store_n(&recording, 0, __ATOMIC_RELEASE);
+    if (record_file) {
+        fclose(record_file);
+        record_file = NULL;
+    }
+    pthread_mutex_unlock(&record_mutex);
+}
+
+int vault_record_enabled(void) {
+    return __atomic_load_n(&recording, __ATOMIC_ACQUIRE);
+}
+
+// start_ns: 이벤트 시작 시각 (vault_metrics_now_ns 기준)
+static void write_event(vault_record_event_t *event, uint64_t start_ns, const char *path, const char *body) {
+    pthread_mutex_lock(&record_mutex);
+    if (record_file) {
+        event->offset_us = start_ns > record_start_ns ? (start_ns - record_start_ns) / 1000 : 0;
+        fwrite(event, sizeof(*event), 1, record_file);
+        if (event->path_len) fwrite(path, 1, event->path_len, record_file);
+        if (event->body_len) fwrite(body, 1, event->body_len, record_file);
+    }
+    pthread_mutex_unlock(&record_mutex);
+}
+
+static uint32_t clamp_us(uint64_t ns) {
+    uint64_t us = ns / 1000;
+    return us > UINT32_MAX ? UINT32_MAX : (uint32_t)us;
+}
+
+void vault_record_request(vault_endpoint_t endpoint, const char *path, int status, uint64_t duration_ns,
+                          const char *body, size_t size) {
+    if (!vault_record_enabled()) return;
+
+    vault_record_event_t event;
+    memset(&event, 0, sizeof(event));
+    event.type = VAULT_RECORD_REQUEST;
+    event.kind = (uint8_t)endpoint;
+    event.thread = current_thread();
+    event.status = status;
+    event.duration_us = clamp_us(duration_ns);
+    event.response_size = size > UINT32_MAX ? UINT32_MAX : (uint32_t)size;
+
+    size_t path_len = path ? strlen(path) : 0;
+    event.path_len = path_len >= VAULT_RECORD_PATH_MAX ? VAULT_RECORD_PATH_MAX - 1 : (uint16_t)path_len;
+
+    char *redacted = NULL;
+    if (body && size > 0) {
+        redacted = malloc(size + 1);
+        if (redacted) {
+            event.body_len = (uint32_t)vault_record_redact(body, size, redacted, size + 1);
+        }
+    }
+
+    write_event(&event, vault_metrics_now_ns() - duration_ns, path, redacted);
+    free(redacted);
+}
+
+vault_record_scope_t vault_record_call_begin(vault_call_t call) {
+    vault_record_scope_t scope = {call, 0, 0, 0};
+    if (!vault_record_enabled()) return scope;
+
+    scope.entered = 1;
+    scope.active = call_depth++ == 0;
+    scope.start_ns = vault_metrics_now_ns();
+    return scope;
+}
+
+void vault_record_call_end(const vault_record_scope_t *scope, int rc) {
+    if (!scope->entered) return;
+    call_depth--;
+    if (!scope->active || !vault_record_enabled()) return;
+
+    vault_record_event_t event;
+    memset(&event, 0, sizeof(event));
+    event.type = VAULT_RECORD_CALL;
+    event.kind = (uint8_t)scope->call;
+    event.thread = current_thread();
+    event.status = rc;
+    event.duration_us = clamp_us(vault_metrics_now_ns() - scope->start_ns);
+    write_event(&event, scope->start_ns, NULL, NULL);
+}
+
+// 문자열 끝(닫는 따옴표) 위치, 없으면 size
+static size_t string_end(const char *json, size_t size, size_t i) {
+    for (i = i + 1; i < size; i++) {
+        if (json[i] == '\\') {
+            i++;
+        } else if (json[i] == '"') {
+            return i;
+        }
+    }
+    return size;
+}
+
+size_t vault_record_redact(const char *json, size_t size, char *out, size_t out_size) {
+    size_t n = 0;
+    if (!out || out_size == 0) return 0;
+
+    for (size_t i = 0; i < size && n + 1 < out_size; i++) {
+        if (json[i] != '"') {
+            out[n++] = json[i];
+            continue;
+        }
+
+        size_t end = string_end(json, size, i);
+        size_t next = end + 1;
+        while (next < size && (json[next] == ' ' || json[next] == '\t' || json[next] == '\n' || json[next] == '\r')) {
+            next++;
+        }
+
+        if (next < size && json[next] == ':') {
+            // 객체 키는 그대로 유지
+            size_t len = (end < size ? end + 1 : size) - i;
+            if (n + len >= out_size) break;
+            memcpy(out + n, json + i, len);
+            n += len;
+        } else {
+            // 문자열 값은 빈 문자열로 치환
+            if (n + 2 >= out_size) break;
+            out[n++] = '"';
+            out[n++] = '"';
+        }
+        i = end;
+    }
+
+    out[n] = '\0';
+    return n;
+}
+
+int vault_record_reader_open(vault_record_reader_t *reader, const char *path) {
+    memset(reader, 0, sizeof(*reader));
+    reader->file = fopen(path, "rb");
+    if (!reader->file) return -1;
+
+    if (fread(&reader->header, sizeof(reader->header), 1, reader->file) != 1 ||
+        memcmp(reader->header.magic, VAULT_RECORD_MAGIC, sizeof(reader->header.magic)) != 0 ||
+        reader->header.version != VAULT_RECORD_VERSION) {
+        fclose(reader->file);
+        reader->file = NULL;
+        return -1;
+    }
+    return 0;
+}
+
+int vault_record_next(vault_record_reader_t *reader, vault_record_event_t *event) {
+    if (!reader->file) return -1;
+
+    size_t got = fread(event, 1, sizeof(*event), reader->file);
+    if (got == 0) return 0;
+    if (got != sizeof(*event) || event->path_len >= VAULT_RECORD_PATH_MAX) return -1;
+
+    if (fread(reader->path, 1, event->path_len, reader->file) != event->path_len) return -1;
+    reader->path[event->path_len] = '\0';
+
+    if (event->body_len + 1 > reader->body_capacity) {
+        char *grown = realloc(reader->body, event->body_len + 1);
+        if (!grown) return -1;
+        reader->body = grown;
+        reader->body_capacity = event->body_len + 1;
+    }
+    if (fread(reader->body, 1, event->body_len, reader->file) != event->body_len) return -1;
+    reader->body[event->body_len] = '\0';
+    return 1;
+}
+
+void vault_record_reader_close(vault_record_reader_t *reader) {
+    if (reader->file) fclose(reader->file);
+    free(reader->body);
+    memset(reader, 0, sizeof(*reader));
+}
+
+const char *vault_record_call_name(vault_call_t call) {
+    return (unsigned)call < VAULT_CALL_COUNT ? call_names[call] : "unknown";
+}
@@ -0,0 +1,95 @@
+#ifndef VAULT_RECORD_H
+#define VAULT_RECORD_H
+
+#include "vault_metrics.h"
+#include <stdio.h>
+#include <stdint.h>
+#include <stddef.h>
+
+// 트래픽 기록 (record & replay)
+// 실제 실행 중의 공개 API 호출(main 루프, 갱신 스레드)과 그로 인한 Vault 요청/응답을
+// 압축된 바이너리 파일에 순서대로 기록합니다. 응답 본문은 JSON 키와 숫자만 남기고
+// 모든 문자열 값을 비워(redact) 기록하므로 토큰과 자격증명은 파일에 남지 않습니다.
+// 기록 파일은 bench/replay로 대역 서버와 클라이언트에 재생할 수 있습니다.
+//
+// 파일 형식 (호스트 바이트 순서):
+//   헤더  vault_record_header_t
+//   이벤트 vault_record_event_t + path[path_len] + body[body_len] 반복
+
+#define VAULT_RECORD_MAGIC "VREC"
+#define VAULT_RECORD_VERSION 1
+#define VAULT_RECORD_PATH_MAX 256
+
+typedef enum {
+    VAULT_RECORD_REQUEST = 1,  // Vault HTTP 요청 1건
+    VAULT_RECORD_CALL = 2      // 공개 API 호출 1건 (중첩 호출 제외)
+} vault_record_type_t;
+
+// 기록 대상 공개 API
+typedef enum {
+    VAULT_CALL_LOGIN,
+    VAULT_CALL_REFRESH_TOKEN,
+    VAULT_CALL_GET_KV,
+    VAULT_CALL_GET_DB_DYNAMIC,
+    VAULT_CALL_GET_DB_STATIC,
+    VAULT_CALL_REFRESH_KV,
+    VAULT_CALL_REFRESH_DB_DYNAMIC,
+    VAULT_CALL_REFRESH_DB_STATIC,
+    VAULT_CALL_COUNT
+} vault_call_t;
+
+typedef struct {
+    char magic[4];
+    uint32_t version;
+    uint64_t start_unix_ns;  // 기록 시작 시각 (UNIX epoch ns)
+} vault_record_header_t;
+
+typedef struct {
+    uint8_t type;            // vault_record_type_t
+    uint8_t kind;            // REQUEST: vault_endpoint_t, CALL: vault_call_t
+    uint16_t thread;         // 기록 스레드 번호 (1부터, 스레드별 고정)
+    int32_t status;          // REQUEST: HTTP 상태 코드 (전송 실패 시 -CURLcode), CALL: 반환값
+    uint64_t offset_us;      // 기록 시작 기준 시작 시각 (us)
+    uint32_t duration_us;    // 소요 시간 (us)
+    uint32_t response_size;  // REQUEST: 원본 응답 본문 바이트
+    uint16_t path_len;
+    uint16_t reserved;
+    uint32_t body_len;       // 비식별화된 응답 본문 바이트
+} vault_record_event_t;
+
+// 공개 API 호출 범위 (vault_record_call_begin/end 사이)
+typedef struct {
+    vault_call_t call;
+    uint64_t start_ns;
+    int entered;  // 기록 중이라 중첩 깊이를 올린 경우
+    int active;   // 최상위 호출이라 기록 대상인 경우
+} vault_record_scope_t;
+
+// 기록 (path가 NULL 또는 빈 문자열이면 비활성화)
+int vault_record_open(const char *path);
+void vault_record_close(void);
+int vault_record_enabled(void);
+void vault_record_request(vault_endpoint_t endpoint, const char *path, int status, uint64_t duration_ns,
+                          const char *body, size_t size);
+vault_record_scope_t vault_record_call_begin(vault_call_t call);
+void vault_record_call_end(const vault_record_scope_t *scope, int rc);
+
+// JSON 문자열 값을 빈 문자열로 치환 (키, 숫자, 구조 유지, out_size >= size + 1)
+size_t vault_record_redact(const char *json, size_t size, char *out, size_t out_size);
+
+// 읽기
+typedef struct {
+    FILE *file;
+    vault_record_header_t header;
+    char path[VAULT_RECORD_PATH_MAX];
+    char *body;  // NUL 종료, 다음 호출 전까지 유효
+    size_t body_capacity;
+} vault_record_reader_t;
+
+int vault_record_reader_open(vault_record_reader_t *reader, const char *path);
+int vault_record_next(vault_record_reader_t *reader, vault_record_event_t *event);  // 1: 이벤트, 0: 끝, -1: 손상
+void vault_record_reader_close(vault_record_reader_t *reader);
+
+const char *vault_record_call_name(vault_call_t call);
+
+#endif
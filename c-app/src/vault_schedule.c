@@ -0,0 +1,143 @@
+#define _POSIX_C_SOURCE 200809L
+#include "vault_schedule.h"
+#include "vault_codec.h"
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+// FNV-1a 32비트 해시 (호스트 위상, 경로 캐시 버킷)
+uint32_t vault_schedule_hash(const char *str) {
+    return vault_fnv1a32(str);
+}
+
+// splitmix64 - 스레드 간 공유해도 안전하도록 상태를 원자적으로 증가
+static uint64_t next_random(vault_schedule_t *schedule) {
+    uint64_t z = __atomic_add_fetch(&schedule->rng_state, 0x9E3779B97F4A7C15ULL, __ATOMIC_RELAXED);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// 스케줄 정책 초기화 (현재 호스트명 사용)
+void vault_schedule_init(vault_schedule_t *schedule, const app_config_t *config) {
+    char host[256];
+    if (gethostname(host, sizeof(host)) != 0) {
+        host[0] = '\0';
+    }
+    host[sizeof(host) - 1] = '\0';
+
+    vault_schedule_init_with_host(schedule, config, host);
+}
+
+// 스케줄 정책 초기화 (호스트명 지정 - 시뮬레이션용)
+void vault_schedule_init_with_host(vault_schedule_t *schedule, const app_config_t *config, const char *host) {
+    if (!schedule || !config) return;
+
+    vault_schedule_update(schedule, config);
+
+    // 호스트명 + Entity 해시 (같은 호스트의 다른 앱과도 위상이 달라지도록)
+    char key[512];
+    snprintf(key, sizeof(key), "%s/%s", host ? host : "", config->entity);
+    schedule->host_hash = vault_schedule_hash(key);
+
+    // 난수 시드: 호스트 해시 + PID + 기동 시각
+    schedule->rng_state = ((uint64_t)schedule->host_hash << 32) ^
+                          (uint64_t)getpid() ^ (uint64_t)time(NULL);
+}
+
+// 정책 값 갱신 (설정 핫 리로드, 다른 스레드가 읽는 중에도 안전하도록 원자적으로 기록)
+// 호스트 해시와 난수 상태는 유지합니다.
+void vault_schedule_update(vault_schedule_t *schedule, const app_config_t *config) {
+    if (!schedule || !config) return;
+
+    int window_min = config->schedule.renew_window_min;
+    int window_max = config->schedule.renew_window_max;
+    int jitter = config->schedule.refresh_jitter;
+
+    // 잘못된 구간은 보정 (min <= max, 1~99%)
+    if (window_min < 1) window_min = 1;
+    if (window_max > 99) window_max = 99;
+    if (window_max < window_min) window_max = window_min;
+    if (jitter < 0) jitter = 0;
+    if (jitter > 50) jitter = 50;
+
+    __atomic_store_n(&schedule->renew_window_min, window_min, __ATOMIC_RELAXED);
+    __atomic_store_n(&schedule->renew_window_max, window_max, __ATOMIC_RELAXED);
+    __atomic_store_n(&schedule->refresh_jitter, jitter, __ATOMIC_RELAXED);
+    __atomic_store_n(&schedule->host_phase, config->schedule.host_phase, __ATOMIC_RELAXED);
+}
+
+// [0, 1) 구간 난수
+double vault_schedule_random(vault_schedule_t *schedule) {
+    return (double)(next_random(schedule) >> 11) / 9007199254740992.0;  // 2^53
+}
+
+// 토큰 발급 후 갱신까지의 시간 (TTL의 min~max% 구간에서 무작위 선택)
+time_t vault_schedule_renewal_offset(vault_schedule_t *schedule, time_t total_ttl) {
+    if (!schedule || total_ttl <= 0) return 0;
+
+    int window_min = __atomic_load_n(&schedule->renew_window_min, __ATOMIC_RELAXED);
+    int window_max = __atomic_load_n(&schedule->renew_window_max, __ATOMIC_RELAXED);
+    if (window_max < window_min) window_max = window_min;  // 갱신 도중 읽은 경우
+
+    double span = window_max - window_min;
+    double pct = window_min + vault_schedule_random(schedule) * span;
+    time_t offset = (time_t)(total_ttl * pct / 100.0);
+
+    return offset > 0 ? offset : 1;
+}
+
+// 주기 작업의 첫 실행 위상 (호스트 해시 + 작업 이름 기반, 0 ~ interval-1 초)
+int vault_schedule_phase_offset(const vault_schedule_t *schedule, const char *task, int interval) {
+    if (!schedule || !__atomic_load_n(&schedule->host_phase, __ATOMIC_RELAXED) || interval <= 1) return 0;
+
+    uint32_t hash = schedule->host_hash ^ vault_schedule_hash(task);
+    hash *= 2654435761u;  // 상위 비트 혼합
+    return (int)(hash % (uint32_t)interval);
+}
+
+// 다음 대기 간격 (interval ± refresh_jitter%)
+int vault_schedule_next_interval(vault_schedule_t *schedule, int interval) {
+    if (!schedule || interval <= 0) return interval;
+    int jitter = __atomic_load_n(&schedule->refresh_jitter, __ATOMIC_RELAXED);
+    if (jitter == 0) return interval;
+
+    double factor = (vault_schedule_random(schedule) * 2.0 - 1.0) * jitter / 100.0;
+    int next = (int)(interval * (1.0 + factor) + 0.5);
+
+    return next > 0 ? next : 1;
+}
+
+// 1970-01-01부터의 일 수 (그레고리력, timegm 대신 - 로컬 시간대 영향 없음)
+static long days_from_civil(int y, int m, int d) {
+    y -= m <= 2;
+    long era = (y >= 0 ? y : y - 399) / 400;
+    long yoe = y - era * 400;
+    long doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+    long doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + doe - 719468;
+}
+
+// RFC 3339 시각 (예: 2024-01-01T00:00:00.123456Z, 2024-01-01T09:00:00+09:00) -> epoch 초, 실패 시 0
+time_t vault_schedule_parse_time(const char *text) {
+    int y, mo, d, h, mi, s, n = 0;
+    if (!text || sscanf(text, "%4d-%2d-%2dT%2d:%2d:%2d%n", &y, &mo, &d, &h, &mi, &s, &n) != 6 || n == 0) return 0;
+    if (mo < 1 || mo > 12 || d < 1 || d > 31 || h > 23 || mi > 59 || s > 60) return 0;
+
+    const char *p = text + n;
+    if (*p == '.') {
+        p++;
+        while (*p >= '0' && *p <= '9') p++;  // 초 이하 버림
+    }
+
+    long offset = 0;
+    if (*p == '+' || *p == '-') {
+        int oh, om;
+        if (sscanf(p + 1, "%2d:%2d", &oh, &om) != 2) return 0;
+        offset = (oh * 3600L + om * 60L) * (*p == '-' ? -1 : 1);
+    } else if (*p != 'Z' && *p != 'z') {
+        return 0;
+    }
+
+    return (time_t)(days_from_civil(y, mo, d) * 86400L + h * 3600L + mi * 60L + s - offset);
+}
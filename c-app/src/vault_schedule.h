@@ -0,0 +1,32 @@
+#ifndef VAULT_SCHEDULE_H
+#define VAULT_SCHEDULE_H
+
+#include <stdint.h>
+#include <time.h>
+#include "config.h"
+
+// 주기 작업 분산(jitter) 정책
+// 다수의 Pod가 동시에 기동되어도 Vault 요청이 한 시점에 몰리지 않도록
+// 토큰 갱신 시점과 시크릿 폴링 주기를 무작위로 분산합니다.
+typedef struct {
+    // 정책 값은 설정 리로드 시 갱신되므로 원자적으로 접근
+    int renew_window_min;   // 토큰 갱신 구간 시작 (TTL 대비 %)
+    int renew_window_max;   // 토큰 갱신 구간 끝 (TTL 대비 %)
+    int refresh_jitter;     // 폴링 간격 변동폭 (± %)
+    int host_phase;         // 호스트 해시 기반 위상 오프셋 사용 여부
+    uint32_t host_hash;     // 호스트명 + Entity 해시
+    uint64_t rng_state;     // 난수 상태 (원자적으로 증가)
+} vault_schedule_t;
+
+// 함수 선언
+void vault_schedule_init(vault_schedule_t *schedule, const app_config_t *config);
+void vault_schedule_init_with_host(vault_schedule_t *schedule, const app_config_t *config, const char *host);
+void vault_schedule_update(vault_schedule_t *schedule, const app_config_t *config);
+uint32_t vault_schedule_hash(const char *str);
+double vault_schedule_random(vault_schedule_t *schedule);
+time_t vault_schedule_renewal_offset(vault_schedule_t *schedule, time_t total_ttl);
+int vault_schedule_phase_offset(const vault_schedule_t *schedule, const char *task, int interval);
+int vault_schedule_next_interval(vault_schedule_t *schedule, int interval);
+time_t vault_schedule_parse_time(const char *text);
+
+#endif
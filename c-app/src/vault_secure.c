@@ -0,0 +1,141 @@
+#define _POSIX_C_SOURCE 200809L
+#define _DEFAULT_SOURCE
+#include "vault_secure.h"
+#include "vault_log.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#ifndef MAP_ANONYMOUS
+#define MAP_ANONYMOUS MAP_ANON
+#endif
+
+void vault_secure_zero(void *ptr, size_t len) {
+    volatile unsigned char *p = ptr;
+    while (len--) *p++ = 0;
+}
+
+// 영역 하나 잡기 (잠금은 첫 영역에서만 초기화)
+static int arena_map(vault_secure_arena_t *arena, size_t slot_size, size_t slots) {
+    if (slot_size == 0 || slots == 0) return -1;
+    memset(arena, 0, sizeof(*arena));
+
+    // 칸은 16바이트 단위로 정렬하고 전체는 페이지 단위로 잡음
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    arena->slot_size = (slot_size + 15) & ~(size_t)15;
+    arena->slots = slots;
+    arena->map_size = (arena->slot_size * slots + page - 1) / page * page;
+
+    void *base = mmap(NULL, arena->map_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (base == MAP_FAILED) return -1;
+    arena->base = base;
+    arena->used = calloc(slots, 1);
+    if (!arena->used) {
+        munmap(base, arena->map_size);
+        arena->base = NULL;
+        return -1;
+    }
+
+    if (mlock(base, arena->map_size) == 0) {
+        arena->locked = 1;
+    } else {
+        VAULT_LOG_WARN("mlock failed for %zu-byte key arena, keys may be swapped (check RLIMIT_MEMLOCK)",
+                       arena->map_size);
+    }
+#ifdef MADV_DONTDUMP
+    madvise(base, arena->map_size, MADV_DONTDUMP);
+#endif
+    return 0;
+}
+
+int vault_secure_arena_init(vault_secure_arena_t *arena, size_t slot_size, size_t slots) {
+    if (!arena || arena_map(arena, slot_size, slots) != 0) return -1;
+    pthread_mutex_init(&arena->lock, NULL);
+    return 0;
+}
+
+static void arena_unmap(vault_secure_arena_t *arena) {
+    vault_secure_zero(arena->base, arena->map_size);
+    if (arena->locked) munlock(arena->base, arena->map_size);
+    munmap(arena->base, arena->map_size);
+    arena->base = NULL;
+    free(arena->used);
+    arena->used = NULL;
+}
+
+void vault_secure_arena_destroy(vault_secure_arena_t *arena) {
+    if (!arena || !arena->base) return;
+    while (arena->next) {
+        vault_secure_arena_t *next = arena->next;
+        arena->next = next->next;
+        arena_unmap(next);
+        free(next);
+    }
+    arena_unmap(arena);
+    pthread_mutex_destroy(&arena->lock);
+}
+
+// 영역 안의 빈 칸 (잠금 안에서 호출)
+static void *arena_take(vault_secure_arena_t *arena) {
+    for (size_t i = 0; i < arena->slots; i++) {
+        if (!arena->used[i]) {
+            arena->used[i] = 1;
+            arena->in_use++;
+            return arena->base + i * arena->slot_size;
+        }
+    }
+    return NULL;
+}
+
+void *vault_secure_alloc(vault_secure_arena_t *arena) {
+    void *ptr = NULL;
+    pthread_mutex_lock(&arena->lock);
+    size_t total = 0;
+    vault_secure_arena_t *last = arena;
+    for (vault_secure_arena_t *a = arena; a && !ptr; a = a->next) {
+        ptr = arena_take(a);
+        total += a->slots;
+        last = a;
+    }
+    if (!ptr) {
+        // 지금까지의 칸 수만큼 영역을 하나 더 잡음
+        vault_secure_arena_t *grown = calloc(1, sizeof(vault_secure_arena_t));
+        if (grown && arena_map(grown, arena->slot_size, total) == 0) {
+            last->next = grown;
+            ptr = arena_take(grown);
+            VAULT_LOG_INFO("Key arena grown to %zu slots of %zu bytes", total * 2, arena->slot_size);
+        } else {
+            free(grown);
+            VAULT_LOG_ERROR("Key arena exhausted (%zu slots of %zu bytes in use)", total, arena->slot_size);
+        }
+    }
+    pthread_mutex_unlock(&arena->lock);
+    return ptr;
+}
+
+void vault_secure_free(vault_secure_arena_t *arena, void *ptr) {
+    if (!ptr) return;
+    pthread_mutex_lock(&arena->lock);
+    for (vault_secure_arena_t *a = arena; a; a = a->next) {
+        if ((unsigned char *)ptr < a->base) continue;
+        size_t index = (size_t)((unsigned char *)ptr - a->base) / a->slot_size;
+        if (index >= a->slots) continue;
+        vault_secure_zero(ptr, a->slot_size);
+        if (a->used[index]) {
+            a->used[index] = 0;
+            a->in_use--;
+        }
+        break;
+    }
+    pthread_mutex_unlock(&arena->lock);
+}
+
+size_t vault_secure_capacity(vault_secure_arena_t *arena) {
+    size_t total = 0;
+    pthread_mutex_lock(&arena->lock);
+    for (vault_secure_arena_t *a = arena; a; a = a->next) total += a->slots;
+    pthread_mutex_unlock(&arena->lock);
+    return total;
+}
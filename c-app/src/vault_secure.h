@@ -0,0 +1,40 @@
+#ifndef VAULT_SECURE_H
+#define VAULT_SECURE_H
+
+#include <stddef.h>
+#include <pthread.h>
+
+// 평문 키 보관용 잠긴 메모리 영역
+// 같은 크기의 칸 slots개를 mmap으로 한 번에 잡고 mlock으로 스왑되지 않게 고정하며,
+// 코어 덤프에서도 제외합니다 (MADV_DONTDUMP를 지원하는 경우).
+// 칸을 반납하거나 영역을 해제할 때 내용을 지웁니다.
+// 칸이 모두 사용 중이면 지금까지의 칸 수만큼 영역을 하나 더 잡아 뒤에 이어 붙입니다
+// (참조를 오래 잡고 있는 호출자나 키가 많아져도 할당이 실패하지 않도록, 추가 영역은 해제할 때까지 유지).
+
+typedef struct vault_secure_arena {
+    unsigned char *base;
+    size_t map_size;
+    size_t slot_size;
+    size_t slots;
+    unsigned char *used;      // 칸별 사용 여부
+    size_t in_use;
+    int locked;               // mlock 성공 여부 (RLIMIT_MEMLOCK 부족 시 잠그지 않고 계속 사용)
+    pthread_mutex_t lock;     // 첫 영역의 잠금이 이어 붙인 영역까지 보호
+    struct vault_secure_arena *next;   // 이어 붙인 영역 (없으면 NULL)
+} vault_secure_arena_t;
+
+int vault_secure_arena_init(vault_secure_arena_t *arena, size_t slot_size, size_t slots);
+void vault_secure_arena_destroy(vault_secure_arena_t *arena);
+
+// 빈 칸 하나 (0으로 채워진 slot_size 바이트, 남은 칸이 없고 영역을 더 잡지 못하면 NULL)
+void *vault_secure_alloc(vault_secure_arena_t *arena);
+// 칸 내용을 지우고 반납
+void vault_secure_free(vault_secure_arena_t *arena, void *ptr);
+
+// 전체 칸 수 (이어 붙인 영역 포함)
+size_t vault_secure_capacity(vault_secure_arena_t *arena);
+
+// 컴파일러가 생략하지 않는 메모리 지우기
+void vault_secure_zero(void *ptr, size_t len);
+
+#endif
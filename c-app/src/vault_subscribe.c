@@ -0,0 +1,141 @@
+#include "vault_subscribe.h"
+#include <string.h>
+
+void vault_subscriptions_init(vault_subscriptions_t *subs) {
+    memset(subs->entries, 0, sizeof(subs->entries));
+    pthread_mutex_init(&subs->lock, NULL);
+}
+
+void vault_subscriptions_destroy(vault_subscriptions_t *subs) {
+    pthread_mutex_destroy(&subs->lock);
+}
+
+int vault_subscriptions_add(vault_subscriptions_t *subs, vault_cache_kind_t secret,
+                            vault_change_callback_t callback, void *ctx) {
+    if (!callback || secret >= VAULT_CACHE_COUNT) return -1;
+
+    int id = -1;
+    pthread_mutex_lock(&subs->lock);
+    for (int i = 0; i < VAULT_MAX_SUBSCRIPTIONS; i++) {
+        if (!subs->entries[i].active) {
+            subs->entries[i].secret = secret;
+            subs->entries[i].callback = callback;
+            subs->entries[i].ctx = ctx;
+            subs->entries[i].active = 1;
+            id = i;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&subs->lock);
+    return id;
+}
+
+int vault_subscriptions_remove(vault_subscriptions_t *subs, int id) {
+    if (id < 0 || id >= VAULT_MAX_SUBSCRIPTIONS) return -1;
+
+    pthread_mutex_lock(&subs->lock);
+    int was_active = subs->entries[id].active;
+    subs->entries[id].active = 0;
+    pthread_mutex_unlock(&subs->lock);
+    return was_active ? 0 : -1;
+}
+
+static int is_ignored(const char *field, const char *const *ignore) {
+    for (; ignore && *ignore; ignore++) {
+        if (strcmp(field, *ignore) == 0) return 1;
+    }
+    return 0;
+}
+
+static void add_change(vault_field_change_t *changes, size_t max_changes, size_t index, const char *field,
+                       vault_field_change_kind_t kind, const char *old_value, const char *new_value) {
+    if (index >= max_changes) return;
+    changes[index].field = field;
+    changes[index].kind = kind;
+    changes[index].old_value = old_value;
+    changes[index].new_value = new_value;
+}
+
+size_t vault_secret_diff(json_object *old_data, json_object *new_data, const char *const *ignore,
+                         vault_field_change_t *changes, size_t max_changes) {
+    size_t count = 0;
+    struct json_object_iterator it, end;
+
+    // 이전 필드: 삭제 또는 값 변경
+    if (old_data && json_object_is_type(old_data, json_type_object)) {
+        it = json_object_iter_begin(old_data);
+        end = json_object_iter_end(old_data);
+        for (; !json_object_iter_equal(&it, &end); json_object_iter_next(&it)) {
+            const char *field = json_object_iter_peek_name(&it);
+            if (is_ignored(field, ignore)) continue;
+
+            const char *old_value = json_object_get_string(json_object_iter_peek_value(&it));
+            json_object *new_value_obj = NULL;
+            if (!new_data || !json_object_object_get_ex(new_data, field, &new_value_obj)) {
+                add_change(changes, max_changes, count++, field, VAULT_FIELD_REMOVED, old_value, NULL);
+                continue;
+            }
+            const char *new_value = json_object_get_string(new_value_obj);
+            if (strcmp(old_value ? old_value : "", new_value ? new_value : "") != 0) {
+                add_change(changes, max_changes, count++, field, VAULT_FIELD_CHANGED, old_value, new_value);
+            }
+        }
+    }
+
+    // 새 필드: 추가
+    if (new_data && json_object_is_type(new_data, json_type_object)) {
+        it = json_object_iter_begin(new_data);
+        end = json_object_iter_end(new_data);
+        for (; !json_object_iter_equal(&it, &end); json_object_iter_next(&it)) {
+            const char *field = json_object_iter_peek_name(&it);
+            if (is_ignored(field, ignore)) continue;
+            if (old_data && json_object_object_get_ex(old_data, field, NULL)) continue;
+            add_change(changes, max_changes, count++, field, VAULT_FIELD_ADDED, NULL,
+                       json_object_get_string(json_object_iter_peek_value(&it)));
+        }
+    }
+    return count;
+}
+
+size_t vault_subscriptions_notify(vault_subscriptions_t *subs, vault_cache_kind_t secret,
+                                  json_object *old_data, json_object *new_data,
+                                  long old_version, long new_version, const char *const *ignore) {
+    vault_field_change_t changes[VAULT_DIFF_MAX_FIELDS];
+    size_t count = vault_secret_diff(old_data, new_data, ignore, changes, VAULT_DIFF_MAX_FIELDS);
+    if (count == 0 && old_version == new_version) return 0;
+
+    // 콜백 안에서 구독/해지할 수 있도록 목록을 복사한 뒤 잠금 밖에서 호출
+    vault_subscription_t targets[VAULT_MAX_SUBSCRIPTIONS];
+    int target_count = 0;
+    pthread_mutex_lock(&subs->lock);
+    for (int i = 0; i < VAULT_MAX_SUBSCRIPTIONS; i++) {
+        if (subs->entries[i].active && subs->entries[i].secret == secret) {
+            targets[target_count++] = subs->entries[i];
+        }
+    }
+    pthread_mutex_unlock(&subs->lock);
+
+    vault_secret_change_t change;
+    change.secret = secret;
+    change.secret_name = vault_metrics_cache_name(secret);
+    change.old_data = old_data;
+    change.new_data = new_data;
+    change.old_version = old_version;
+    change.new_version = new_version;
+    change.changes = changes;
+    change.change_count = count < VAULT_DIFF_MAX_FIELDS ? count : VAULT_DIFF_MAX_FIELDS;
+    for (int i = 0; i < target_count; i++) {
+        targets[i].callback(&change, targets[i].ctx);
+    }
+    return count;
+}
+
+int vault_secret_parse_name(const char *name, vault_cache_kind_t *secret) {
+    for (int k = 0; k < VAULT_CACHE_COUNT; k++) {
+        if (name && strcmp(name, vault_metrics_cache_name((vault_cache_kind_t)k)) == 0) {
+            *secret = (vault_cache_kind_t)k;
+            return 0;
+        }
+    }
+    return -1;
+}
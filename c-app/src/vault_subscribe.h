@@ -0,0 +1,79 @@
+#ifndef VAULT_SUBSCRIBE_H
+#define VAULT_SUBSCRIBE_H
+
+#include <json.h>
+#include <stddef.h>
+#include <pthread.h>
+#include "vault_metrics.h"
+
+// 시크릿 변경 구독
+// 갱신 스레드가 실제 변경(KV의 새 metadata.version, Database Static 비밀번호 교체,
+// Database Dynamic 새 lease)을 감지했을 때만 구독자 콜백을 한 번 호출합니다.
+// 콜백에는 이전/새 필드 스냅샷과 필드 단위 변경 목록이 전달됩니다.
+// 첫 조회(캐시가 비어 있던 경우)는 변경으로 보지 않습니다.
+//
+// 시크릿 이름: "kv", "database-dynamic", "database-static" (메트릭 캐시 이름과 동일)
+
+#define VAULT_MAX_SUBSCRIPTIONS 16
+#define VAULT_DIFF_MAX_FIELDS 32
+
+typedef enum {
+    VAULT_FIELD_ADDED,
+    VAULT_FIELD_REMOVED,
+    VAULT_FIELD_CHANGED
+} vault_field_change_kind_t;
+
+// 필드 1개의 변경 (문자열은 콜백 호출 동안만 유효)
+typedef struct {
+    const char *field;
+    vault_field_change_kind_t kind;
+    const char *old_value;  // ADDED이면 NULL
+    const char *new_value;  // REMOVED이면 NULL
+} vault_field_change_t;
+
+// 콜백에 전달되는 변경 내용 (모든 포인터는 콜백 호출 동안만 유효, 보관하려면 json_object_get)
+typedef struct {
+    vault_cache_kind_t secret;
+    const char *secret_name;
+    json_object *old_data;  // 이전 필드 맵 (KV: data.data, Database: username/password 등)
+    json_object *new_data;  // 새 필드 맵
+    long old_version;       // KV metadata.version (그 외 -1)
+    long new_version;
+    const vault_field_change_t *changes;
+    size_t change_count;
+} vault_secret_change_t;
+
+typedef void (*vault_change_callback_t)(const vault_secret_change_t *change, void *ctx);
+
+typedef struct {
+    vault_cache_kind_t secret;
+    vault_change_callback_t callback;
+    void *ctx;
+    int active;
+} vault_subscription_t;
+
+// 구독 목록 (구독/해지는 어느 스레드에서나 가능, 콜백은 잠금 밖에서 갱신 스레드가 호출)
+typedef struct {
+    vault_subscription_t entries[VAULT_MAX_SUBSCRIPTIONS];
+    pthread_mutex_t lock;
+} vault_subscriptions_t;
+
+void vault_subscriptions_init(vault_subscriptions_t *subs);
+void vault_subscriptions_destroy(vault_subscriptions_t *subs);
+int vault_subscriptions_add(vault_subscriptions_t *subs, vault_cache_kind_t secret,
+                            vault_change_callback_t callback, void *ctx);  // 구독 ID (실패 시 -1)
+int vault_subscriptions_remove(vault_subscriptions_t *subs, int id);
+
+// 이전/새 필드 맵 비교 후 변경이 있으면 구독자 호출, 변경된 필드 수 반환
+// ignore: 비교에서 제외할 필드 이름 목록 (NULL 종료, 예: Database Static의 ttl)
+size_t vault_subscriptions_notify(vault_subscriptions_t *subs, vault_cache_kind_t secret,
+                                  json_object *old_data, json_object *new_data,
+                                  long old_version, long new_version, const char *const *ignore);
+
+// 필드 단위 비교 (최대 max_changes개 기록, 전체 변경 수 반환)
+size_t vault_secret_diff(json_object *old_data, json_object *new_data, const char *const *ignore,
+                         vault_field_change_t *changes, size_t max_changes);
+
+int vault_secret_parse_name(const char *name, vault_cache_kind_t *secret);
+
+#endif
@@ -0,0 +1,322 @@
+#define _POSIX_C_SOURCE 200809L
+#include "vault_tenants.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+// 최소 힙 (실행 시각 순)
+static void heap_swap(vault_tenant_job_t *a, vault_tenant_job_t *b) {
+    vault_tenant_job_t t = *a;
+    *a = *b;
+    *b = t;
+}
+
+static void heap_push(vault_tenants_t *pool, vault_tenant_job_t job) {
+    size_t i = pool->heap_size++;
+    pool->heap[i] = job;
+    while (i > 0) {
+        size_t parent = (i - 1) / 2;
+        if (pool->heap[parent].due <= pool->heap[i].due) break;
+        heap_swap(&pool->heap[parent], &pool->heap[i]);
+        i = parent;
+    }
+}
+
+static vault_tenant_job_t heap_pop(vault_tenants_t *pool) {
+    vault_tenant_job_t top = pool->heap[0];
+    pool->heap[0] = pool->heap[--pool->heap_size];
+
+    size_t i = 0;
+    for (;;) {
+        size_t left = i * 2 + 1, right = left + 1, smallest = i;
+        if (left < pool->heap_size && pool->heap[left].due < pool->heap[smallest].due) smallest = left;
+        if (right < pool->heap_size && pool->heap[right].due < pool->heap[smallest].due) smallest = right;
+        if (smallest == i) break;
+        heap_swap(&pool->heap[i], &pool->heap[smallest]);
+        i = smallest;
+    }
+    return top;
+}
+
+static void schedule_job(vault_tenants_t *pool, size_t tenant, vault_tenant_task_t task, time_t due) {
+    vault_tenant_job_t job = { due, (uint32_t)tenant, (uint32_t)task };
+    pthread_mutex_lock(&pool->lock);
+    heap_push(pool, job);
+    pthread_cond_signal(&pool->cond);
+    pthread_mutex_unlock(&pool->lock);
+}
+
+static void count_stat(vault_tenants_t *pool, uint64_t *counter) {
+    pthread_mutex_lock(&pool->lock);
+    (*counter)++;
+    pthread_mutex_unlock(&pool->lock);
+}
+
+// 갱신 작업 간격 (± jitter, Database Static은 2배)
+static int task_interval(vault_tenant_t *tenant, vault_tenant_task_t task) {
+    int interval = tenant->config.secret_kv.refresh_interval;
+    if (task == VAULT_TENANT_TASK_DB_STATIC) interval *= 2;
+    return interval;
+}
+
+// 로그인 직후 활성화된 시크릿 갱신 작업 등록 (테넌트별 위상 분산)
+static void schedule_refresh_jobs(vault_tenants_t *pool, size_t index, time_t now) {
+    static const char *const task_names[VAULT_TENANT_TASK_COUNT] = {
+        "token", "kv", "database-dynamic", "database-static"
+    };
+    vault_tenant_t *tenant = &pool->tenants[index];
+    const int enabled[VAULT_TENANT_TASK_COUNT] = {
+        0,
+        tenant->config.secret_kv.enabled,
+        tenant->config.secret_database_dynamic.enabled,
+        tenant->config.secret_database_static.enabled,
+    };
+
+    for (int task = VAULT_TENANT_TASK_KV; task < VAULT_TENANT_TASK_COUNT; task++) {
+        if (!enabled[task]) continue;
+        int interval = task_interval(tenant, (vault_tenant_task_t)task);
+        schedule_job(pool, index, (vault_tenant_task_t)task,
+                     now + vault_schedule_phase_offset(&tenant->client.schedule, task_names[task], interval));
+    }
+    tenant->refresh_scheduled = 1;
+}
+
+// 로그인 실패 재시도 시각 (지수 백오프 + jitter, 여러 테넌트가 동시에 재시도하지 않도록)
+static time_t login_retry_at(vault_tenant_t *tenant, time_t now) {
+    int backoff = 1;
+    for (int i = 1; i < tenant->login_failures && backoff < VAULT_TENANTS_LOGIN_BACKOFF_MAX; i++) {
+        backoff *= 2;
+    }
+    if (backoff > VAULT_TENANTS_LOGIN_BACKOFF_MAX) backoff = VAULT_TENANTS_LOGIN_BACKOFF_MAX;
+    return now + vault_schedule_next_interval(&tenant->client.schedule, backoff);
+}
+
+// 토큰 작업: 로그인 전이면 로그인, 이후에는 갱신 예정 시각에 갱신 (실패 시 재로그인)
+// 반환값은 다음 실행 시각
+static time_t run_token_task(vault_tenants_t *pool, size_t index) {
+    vault_tenant_t *tenant = &pool->tenants[index];
+    vault_client_t *client = &tenant->client;
+    time_t now = time(NULL);
+
+    if (!vault_tenant_ready(tenant)) {
+        if (vault_login(client, tenant->config.vault_role_id, tenant->config.vault_secret_id) != 0) {
+            tenant->login_failures++;
+            count_stat(pool, &pool->stats.login_failures);
+            time_t retry = login_retry_at(tenant, now);
+            VAULT_LOG_WARN("⚠️ [%s] Login failed, retrying in %ld seconds", tenant->config.entity, retry - now);
+            return retry;
+        }
+        tenant->login_failures = 0;
+        __atomic_store_n(&tenant->ready, 1, __ATOMIC_RELEASE);
+        count_stat(pool, &pool->stats.logins);
+        if (!tenant->refresh_scheduled) {
+            schedule_refresh_jobs(pool, index, now);
+        }
+    } else {
+        vault_token_t *token = vault_token_acquire(client);
+        if (!token) {
+            __atomic_store_n(&tenant->ready, 0, __ATOMIC_RELEASE);
+            return now;
+        }
+        time_t renewal_at = token->renewal_at;
+        time_t expiry = token->expiry;
+        vault_token_release(token);
+        if (now < renewal_at) return renewal_at;
+
+        if (vault_refresh_token(client) != 0) {
+            count_stat(pool, &pool->stats.refresh_failures);
+            now = time(NULL);
+            if (now < expiry) {
+                // 기존 토큰이 아직 유효하므로 만료 전까지 재시도
+                return now + ((expiry - now) > 10 ? 5 : 1);
+            }
+            VAULT_LOG_ERROR("❌ [%s] Token expired and re-login failed", tenant->config.entity);
+            __atomic_store_n(&tenant->ready, 0, __ATOMIC_RELEASE);
+            tenant->login_failures = 1;
+            return login_retry_at(tenant, now);
+        }
+    }
+
+    vault_token_t *token = vault_token_acquire(client);
+    time_t next = token ? token->renewal_at : now + 1;
+    vault_token_release(token);
+    return next;
+}
+
+// 시크릿 갱신 작업 (로그인 전이면 건너뛰고 다음 주기에 다시 시도)
+static time_t run_refresh_task(vault_tenants_t *pool, size_t index, vault_tenant_task_t task) {
+    vault_tenant_t *tenant = &pool->tenants[index];
+    vault_client_t *client = &tenant->client;
+
+    if (vault_tenant_ready(tenant)) {
+        int rc = 0;
+        switch (task) {
+            case VAULT_TENANT_TASK_KV: rc = vault_refresh_kv_secret(client); break;
+            case VAULT_TENANT_TASK_DB_DYNAMIC: rc = vault_refresh_db_dynamic_secret(client); break;
+            case VAULT_TENANT_TASK_DB_STATIC: rc = vault_refresh_db_static_secret(client); break;
+            default: break;
+        }
+        if (rc != 0) count_stat(pool, &pool->stats.refresh_failures);
+    }
+    return time(NULL) + vault_schedule_next_interval(&client->schedule, task_interval(tenant, task));
+}
+
+static void *worker_thread(void *arg) {
+    vault_tenants_t *pool = (vault_tenants_t *)arg;
+
+    pthread_mutex_lock(&pool->lock);
+    while (!pool->stopping) {
+        if (pool->heap_size == 0) {
+            pthread_cond_wait(&pool->cond, &pool->lock);
+            continue;
+        }
+        time_t now = time(NULL);
+        if (pool->heap[0].due > now) {
+            struct timespec deadline = { pool->heap[0].due, 0 };
+            pthread_cond_timedwait(&pool->cond, &pool->lock, &deadline);
+            continue;
+        }
+
+        vault_tenant_job_t job = heap_pop(pool);
+        pool->stats.runs++;
+        if (now - job.due > pool->stats.max_lag) pool->stats.max_lag = now - job.due;
+        pthread_mutex_unlock(&pool->lock);
+
+        time_t next = job.task == VAULT_TENANT_TASK_TOKEN
+                          ? run_token_task(pool, job.tenant)
+                          : run_refresh_task(pool, job.tenant, (vault_tenant_task_t)job.task);
+
+        pthread_mutex_lock(&pool->lock);
+        job.due = next;
+        heap_push(pool, job);
+        pthread_cond_signal(&pool->cond);
+    }
+    pthread_mutex_unlock(&pool->lock);
+    return NULL;
+}
+
+int vault_tenants_init(vault_tenants_t *pool, const app_config_t *configs, size_t count,
+                       int workers, int shared_transport) {
+    if (!pool || !configs || count == 0 || workers < 1) return -1;
+
+    memset(pool, 0, sizeof(*pool));
+    pool->shared_transport = shared_transport;
+    if (shared_transport && vault_transport_init(&pool->transport) != 0) return -1;
+    if (shared_transport) vault_transport_configure(&pool->transport, &configs[0]);  // 테넌트 모두 [http] 공유
+
+    pool->tenants = calloc(count, sizeof(vault_tenant_t));
+    pool->heap = calloc(count * VAULT_TENANT_TASK_COUNT, sizeof(vault_tenant_job_t));
+    pool->workers = calloc((size_t)workers, sizeof(pthread_t));
+    if (!pool->tenants || !pool->heap || !pool->workers) {
+        free(pool->tenants);
+        free(pool->heap);
+        free(pool->workers);
+        if (shared_transport) vault_transport_destroy(&pool->transport);
+        return -1;
+    }
+    pool->worker_count = workers;
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->cond, NULL);
+
+    for (size_t i = 0; i < count; i++) {
+        vault_tenant_t *tenant = &pool->tenants[i];
+        tenant->config = configs[i];
+        if (vault_client_init(&tenant->client, &tenant->config) != 0) {
+            VAULT_LOG_ERROR("Failed to initialize client for tenant %s", tenant->config.entity);
+            pool->count = i;
+            vault_tenants_destroy(pool);
+            return -1;
+        }
+        if (shared_transport) {
+            vault_client_set_transport(&tenant->client, &pool->transport);
+        }
+    }
+    pool->count = count;
+    pool->stats.tenants = count;
+    return 0;
+}
+
+int vault_tenants_start(vault_tenants_t *pool) {
+    if (!pool || pool->started) return -1;
+
+    // 모든 테넌트 로그인 예약 (동시 로그인 수는 작업 스레드 수로 제한됨)
+    time_t now = time(NULL);
+    for (size_t i = 0; i < pool->count; i++) {
+        schedule_job(pool, i, VAULT_TENANT_TASK_TOKEN, now);
+    }
+
+    for (int i = 0; i < pool->worker_count; i++) {
+        if (pthread_create(&pool->workers[i], NULL, worker_thread, pool) != 0) {
+            VAULT_LOG_ERROR("Failed to create tenant worker thread");
+            pool->worker_count = i;
+            pool->started = 1;
+            vault_tenants_stop(pool);
+            return -1;
+        }
+    }
+    pool->started = 1;
+    return 0;
+}
+
+void vault_tenants_stop(vault_tenants_t *pool) {
+    if (!pool || !pool->started) return;
+
+    pthread_mutex_lock(&pool->lock);
+    pool->stopping = 1;
+    pthread_cond_broadcast(&pool->cond);
+    pthread_mutex_unlock(&pool->lock);
+
+    for (int i = 0; i < pool->worker_count; i++) {
+        pthread_join(pool->workers[i], NULL);
+    }
+    pool->started = 0;
+}
+
+void vault_tenants_destroy(vault_tenants_t *pool) {
+    if (!pool) return;
+
+    vault_tenants_stop(pool);
+    for (size_t i = 0; i < pool->count; i++) {
+        vault_client_cleanup(&pool->tenants[i].client);
+    }
+    if (pool->shared_transport) {
+        vault_transport_destroy(&pool->transport);
+    }
+    pthread_cond_destroy(&pool->cond);
+    pthread_mutex_destroy(&pool->lock);
+    free(pool->tenants);
+    free(pool->heap);
+    free(pool->workers);
+    memset(pool, 0, sizeof(*pool));
+}
+
+vault_tenant_t *vault_tenants_find(vault_tenants_t *pool, const char *entity, const char *ns) {
+    if (!pool || !entity) return NULL;
+
+    for (size_t i = 0; i < pool->count; i++) {
+        vault_tenant_t *tenant = &pool->tenants[i];
+        if (strcmp(tenant->config.entity, entity) == 0 &&
+            (!ns || strcmp(tenant->config.vault_namespace, ns) == 0)) {
+            return tenant;
+        }
+    }
+    return NULL;
+}
+
+int vault_tenant_ready(vault_tenant_t *tenant) {
+    return tenant && __atomic_load_n(&tenant->ready, __ATOMIC_ACQUIRE);
+}
+
+void vault_tenants_get_stats(vault_tenants_t *pool, vault_tenants_stats_t *stats) {
+    size_t ready = 0;
+    for (size_t i = 0; i < pool->count; i++) {
+        ready += (size_t)vault_tenant_ready(&pool->tenants[i]);
+    }
+
+    pthread_mutex_lock(&pool->lock);
+    *stats = pool->stats;
+    stats->queued = pool->heap_size;
+    pthread_mutex_unlock(&pool->lock);
+    stats->ready = ready;
+}
@@ -0,0 +1,82 @@
+#ifndef VAULT_TENANTS_H
+#define VAULT_TENANTS_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <pthread.h>
+#include "vault_client.h"
+
+// 멀티 테넌트 클라이언트 풀
+// 한 프로세스에서 여러 테넌트(Entity/네임스페이스/AppRole)를 운영합니다.
+// 테넌트마다 토큰 수명주기와 시크릿 캐시는 독립적이지만, 연결 풀(vault_transport_t)과
+// 주기 작업 스케줄러(작업 스레드 workers개 + 실행 시각 순 힙)는 모든 테넌트가 공유하므로
+// 테넌트 수가 늘어도 스레드와 연결 수는 늘지 않습니다.
+
+#define VAULT_TENANTS_LOGIN_BACKOFF_MAX 60  // 로그인 실패 재시도 최대 간격 (초)
+
+typedef enum {
+    VAULT_TENANT_TASK_TOKEN = 0,     // 로그인, 토큰 갱신/재로그인
+    VAULT_TENANT_TASK_KV,            // KV 갱신
+    VAULT_TENANT_TASK_DB_DYNAMIC,    // Database Dynamic 갱신
+    VAULT_TENANT_TASK_DB_STATIC,     // Database Static 갱신 (2배 간격)
+    VAULT_TENANT_TASK_COUNT
+} vault_tenant_task_t;
+
+typedef struct {
+    app_config_t config;      // 테넌트 설정 (client->config가 참조)
+    vault_client_t client;    // 테넌트 전용 토큰/캐시
+    int ready;                // 로그인 완료 (원자적 접근)
+    int login_failures;       // 연속 로그인 실패 횟수 (TOKEN 작업에서만 접근)
+    int refresh_scheduled;    // 시크릿 갱신 작업 등록 여부 (TOKEN 작업에서만 접근)
+} vault_tenant_t;
+
+// 예약된 작업 (실행 시각 순 최소 힙 원소)
+typedef struct {
+    time_t due;
+    uint32_t tenant;
+    uint32_t task;
+} vault_tenant_job_t;
+
+typedef struct {
+    size_t tenants;            // 테넌트 수
+    size_t ready;              // 로그인된 테넌트 수
+    size_t queued;             // 예약된 작업 수
+    uint64_t runs;             // 실행한 작업 수
+    uint64_t logins;           // 로그인 성공
+    uint64_t login_failures;   // 로그인 실패
+    uint64_t refresh_failures; // 토큰/시크릿 갱신 실패
+    long max_lag;              // 예약 시각 대비 최대 실행 지연 (초)
+} vault_tenants_stats_t;
+
+typedef struct {
+    vault_transport_t transport;
+    int shared_transport;      // 1이면 모든 테넌트가 연결 풀 공유
+    vault_tenant_t *tenants;
+    size_t count;
+
+    pthread_t *workers;
+    int worker_count;
+    int started;
+
+    pthread_mutex_t lock;      // 힙/통계 보호
+    pthread_cond_t cond;
+    vault_tenant_job_t *heap;  // 테넌트당 작업 종류별 최대 1개
+    size_t heap_size;
+    int stopping;
+    vault_tenants_stats_t stats;
+} vault_tenants_t;
+
+// configs는 복사되므로 호출 후 해제해도 됨
+int vault_tenants_init(vault_tenants_t *pool, const app_config_t *configs, size_t count,
+                       int workers, int shared_transport);
+int vault_tenants_start(vault_tenants_t *pool);
+void vault_tenants_stop(vault_tenants_t *pool);
+void vault_tenants_destroy(vault_tenants_t *pool);
+
+// Entity(필요 시 네임스페이스)로 테넌트 찾기 (namespace가 NULL이면 Entity만 비교)
+vault_tenant_t *vault_tenants_find(vault_tenants_t *pool, const char *entity, const char *ns);
+int vault_tenant_ready(vault_tenant_t *tenant);
+
+void vault_tenants_get_stats(vault_tenants_t *pool, vault_tenants_stats_t *stats);
+
+#endif
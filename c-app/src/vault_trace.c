@@ -0,0 +1,218 @@
+#define _POSIX_C_SOURCE 200809L
+#include "vault_trace.h"
+#include "vault_metrics.h"
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <signal.h>
+
+#define TRACE_WORDS (sizeof(vault_trace_record_t) / sizeof(uint64_t))
+
+// 링 버퍼 슬롯 (seqlock)
+// 기록자는 head를 fetch_add로 증가시켜 슬롯을 배정받고, 기록 중에는 version을 홀수로 둡니다.
+// 읽는 쪽은 version이 짝수이고 복사 전후로 같을 때만 기록을 채택하므로
+// 기록자가 읽는 쪽을 기다리는 일이 없습니다.
+typedef struct {
+    uint64_t version;
+    uint64_t words[TRACE_WORDS];
+} trace_slot_t;
+
+typedef char trace_record_size_check[(sizeof(vault_trace_record_t) % sizeof(uint64_t)) == 0 ? 1 : -1];
+
+static trace_slot_t ring[VAULT_TRACE_CAPACITY];
+static uint64_t ring_head = 0;
+static volatile sig_atomic_t dump_requested = 0;
+static uint64_t id_seed = 0;
+
+static uint64_t unix_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+void vault_trace_record(vault_trace_record_t *record) {
+    uint64_t seq = __atomic_add_fetch(&ring_head, 1, __ATOMIC_RELAXED);
+    trace_slot_t *slot = &ring[(seq - 1) & (VAULT_TRACE_CAPACITY - 1)];
+
+    record->seq = seq;
+    record->start_unix_ns = unix_now_ns() - (uint64_t)(record->total_us > 0 ? record->total_us : 0) * 1000ULL;
+
+    uint64_t words[TRACE_WORDS];
+    memcpy(words, record, sizeof(words));
+
+    // 홀수 version: 기록 중
+    __atomic_store_n(&slot->version, seq * 2 - 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    for (size_t i = 0; i < TRACE_WORDS; i++) {
+        __atomic_store_n(&slot->words[i], words[i], __ATOMIC_RELAXED);
+    }
+    __atomic_store_n(&slot->version, seq * 2, __ATOMIC_RELEASE);
+}
+
+// 슬롯 하나를 일관된 상태로 복사 (기록 중이거나 덮어써진 경우 0 반환)
+static int read_slot(const trace_slot_t *slot, uint64_t expected_seq, vault_trace_record_t *record) {
+    uint64_t words[TRACE_WORDS];
+    uint64_t before = __atomic_load_n(&slot->version, __ATOMIC_ACQUIRE);
+    if (before != expected_seq * 2) return 0;
+
+    for (size_t i = 0; i < TRACE_WORDS; i++) {
+        words[i] = __atomic_load_n(&slot->words[i], __ATOMIC_RELAXED);
+    }
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    if (__atomic_load_n(&slot->version, __ATOMIC_RELAXED) != before) return 0;
+
+    memcpy(record, words, sizeof(words));
+    return 1;
+}
+
+// 최근 기록을 오래된 순서로 복사
+size_t vault_trace_snapshot(vault_trace_record_t *records, size_t max_records) {
+    uint64_t head = __atomic_load_n(&ring_head, __ATOMIC_ACQUIRE);
+    uint64_t count = head < VAULT_TRACE_CAPACITY ? head : VAULT_TRACE_CAPACITY;
+    if (count > max_records) count = max_records;
+
+    size_t copied = 0;
+    for (uint64_t seq = head - count + 1; seq <= head; seq++) {
+        if (read_slot(&ring[(seq - 1) & (VAULT_TRACE_CAPACITY - 1)], seq, &records[copied])) {
+            copied++;
+        }
+    }
+    return copied;
+}
+
+int vault_trace_parse_format(const char *name, vault_trace_format_t *format) {
+    if (strcmp(name, "text") == 0) {
+        *format = VAULT_TRACE_TEXT;
+    } else if (strcmp(name, "otel") == 0) {
+        *format = VAULT_TRACE_OTEL;
+    } else {
+        return -1;
+    }
+    return 0;
+}
+
+static const char *endpoint_name(int32_t endpoint) {
+    if (endpoint < 0 || endpoint >= VAULT_ENDPOINT_COUNT) return "other";
+    return vault_metrics_endpoint_name((vault_endpoint_t)endpoint);
+}
+
+static void dump_text(FILE *out, const vault_trace_record_t *records, size_t count) {
+    fprintf(out, "=== Vault Request Trace (%zu requests) ===\n", count);
+    fprintf(out, "%8s %-13s %4s %9s %9s %9s %9s %9s %8s  %s\n", "seq", "endpoint", "code",
+            "dns_us", "conn_us", "tls_us", "ttfb_us", "total_us", "bytes", "path");
+    for (size_t i = 0; i < count; i++) {
+        const vault_trace_record_t *r = &records[i];
+        fprintf(out, "%8llu %-13s %4d %9lld %9lld %9lld %9lld %9lld %8llu  %s",
+                (unsigned long long)r->seq, endpoint_name(r->endpoint), r->http_code,
+                (long long)r->namelookup_us, (long long)r->connect_us, (long long)r->appconnect_us,
+                (long long)r->starttransfer_us, (long long)r->total_us,
+                (unsigned long long)r->bytes, r->path);
+        if (r->curl_code != 0) {
+            fprintf(out, "  (curl error %d)", r->curl_code);
+        }
+        fprintf(out, "\n");
+    }
+}
+
+// splitmix64 (trace/span ID 생성)
+static uint64_t mix64(uint64_t x) {
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+// JSON 문자열 출력 (따옴표 포함, 따옴표/역슬래시/제어 문자 이스케이프)
+static void put_json_string(FILE *out, const char *s) {
+    fputc('"', out);
+    for (; *s; s++) {
+        unsigned char c = (unsigned char)*s;
+        if (c == '"' || c == '\\') {
+            fputc('\\', out);
+            fputc(c, out);
+        } else if (c < 0x20) {
+            fprintf(out, "\\u%04x", c);
+        } else {
+            fputc(c, out);
+        }
+    }
+    fputc('"', out);
+}
+
+static void otel_event(FILE *out, int *first, const vault_trace_record_t *r, int64_t offset_us, const char *name) {
+    if (offset_us <= 0) return;
+    fprintf(out, "%s{\"timeUnixNano\":\"%llu\",\"name\":\"%s\"}", *first ? "" : ",",
+            (unsigned long long)(r->start_unix_ns + (uint64_t)offset_us * 1000ULL), name);
+    *first = 0;
+}
+
+// OTLP/JSON: 요청마다 독립된 CLIENT span, 단계별 완료 시점은 span event로 표현
+static void dump_otel(FILE *out, const vault_trace_record_t *records, size_t count, const char *service_name) {
+    if (id_seed == 0) {
+        id_seed = mix64(unix_now_ns() ^ ((uint64_t)getpid() << 32));
+    }
+
+    // 서비스 이름과 요청 경로는 설정/호출자 입력이므로 이스케이프
+    fprintf(out, "{\"resourceSpans\":[{\"resource\":{\"attributes\":["
+                 "{\"key\":\"service.name\",\"value\":{\"stringValue\":");
+    put_json_string(out, service_name ? service_name : "vault-c-client");
+    fprintf(out, "}}]},\"scopeSpans\":[{\"scope\":{\"name\":\"vault-c-client\"},\"spans\":[");
+    for (size_t i = 0; i < count; i++) {
+        const vault_trace_record_t *r = &records[i];
+        uint64_t trace_hi = mix64(id_seed ^ r->seq);
+        uint64_t trace_lo = mix64(trace_hi);
+        uint64_t span_id = mix64(trace_lo);
+        int error = r->curl_code != 0 || r->http_code >= 400;
+
+        fprintf(out, "%s{\"traceId\":\"%016llx%016llx\",\"spanId\":\"%016llx\","
+                     "\"name\":\"vault %s\",\"kind\":3,"
+                     "\"startTimeUnixNano\":\"%llu\",\"endTimeUnixNano\":\"%llu\",",
+                i ? "," : "", (unsigned long long)trace_hi, (unsigned long long)trace_lo,
+                (unsigned long long)span_id, endpoint_name(r->endpoint),
+                (unsigned long long)r->start_unix_ns,
+                (unsigned long long)(r->start_unix_ns + (uint64_t)r->total_us * 1000ULL));
+        fprintf(out, "\"attributes\":[{\"key\":\"url.path\",\"value\":{\"stringValue\":");
+        put_json_string(out, r->path);
+        fprintf(out, "}},"
+                     "{\"key\":\"http.response.status_code\",\"value\":{\"intValue\":\"%d\"}},"
+                     "{\"key\":\"http.response.body.size\",\"value\":{\"intValue\":\"%llu\"}},"
+                     "{\"key\":\"vault.endpoint\",\"value\":{\"stringValue\":\"%s\"}}],",
+                r->http_code, (unsigned long long)r->bytes, endpoint_name(r->endpoint));
+
+        int first = 1;
+        fprintf(out, "\"events\":[");
+        otel_event(out, &first, r, r->namelookup_us, "dns.done");
+        otel_event(out, &first, r, r->connect_us, "connect.done");
+        otel_event(out, &first, r, r->appconnect_us, "tls.done");
+        otel_event(out, &first, r, r->starttransfer_us, "first_byte");
+        fprintf(out, "],\"status\":{\"code\":%d}}", error ? 2 : 1);
+    }
+    fprintf(out, "]}]}]}\n");
+}
+
+int vault_trace_dump(FILE *out, vault_trace_format_t format, const char *service_name) {
+    vault_trace_record_t *records = malloc(sizeof(vault_trace_record_t) * VAULT_TRACE_CAPACITY);
+    if (!records) return -1;
+
+    size_t count = vault_trace_snapshot(records, VAULT_TRACE_CAPACITY);
+    if (format == VAULT_TRACE_OTEL) {
+        dump_otel(out, records, count, service_name);
+    } else {
+        dump_text(out, records, count);
+    }
+    fflush(out);
+    free(records);
+    return 0;
+}
+
+void vault_trace_request_dump(void) {
+    dump_requested = 1;
+}
+
+// 대기 중인 덤프 요청이 있으면 1을 반환하고 요청을 지움
+int vault_trace_take_dump_request(void) {
+    if (!dump_requested) return 0;
+    dump_requested = 0;
+    return 1;
+}
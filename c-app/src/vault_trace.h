@@ -0,0 +1,50 @@
+#ifndef VAULT_TRACE_H
+#define VAULT_TRACE_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stddef.h>
+
+// 요청 추적 링 버퍼
+// 모든 Vault 요청의 단계별 소요 시간(CURLINFO_*_TIME_T)을 고정 크기 링 버퍼에 기록합니다.
+// 기록은 잠금과 메모리 할당 없이 수행되며, 가장 오래된 기록부터 덮어씁니다.
+
+#define VAULT_TRACE_CAPACITY 1024  // 2의 거듭제곱
+#define VAULT_TRACE_PATH_MAX 64
+
+// 요청 1건의 추적 기록 (각 시간은 요청 시작 기준 누적 us)
+typedef struct {
+    uint64_t seq;              // 기록 순번 (1부터 증가)
+    uint64_t start_unix_ns;    // 요청 시작 시각 (UNIX epoch ns)
+    int64_t namelookup_us;     // DNS 조회 완료
+    int64_t connect_us;        // TCP 연결 완료
+    int64_t appconnect_us;     // TLS 핸드셰이크 완료 (평문 HTTP 또는 연결 재사용 시 0)
+    int64_t starttransfer_us;  // 첫 응답 바이트 수신 (서버 처리 시간 포함)
+    int64_t total_us;          // 응답 본문 수신 완료
+    uint64_t bytes;            // 응답 본문 바이트
+    int32_t http_code;         // HTTP 상태 코드 (전송 실패 시 0)
+    int32_t curl_code;         // CURLcode
+    int32_t endpoint;          // vault_endpoint_t
+    int32_t reserved;
+    char path[VAULT_TRACE_PATH_MAX];  // 요청 경로 (쿼리 제외, 길면 잘림)
+} vault_trace_record_t;
+
+// 덤프 형식
+typedef enum {
+    VAULT_TRACE_TEXT,  // 사람이 읽는 표
+    VAULT_TRACE_OTEL   // OpenTelemetry OTLP/JSON (ExportTraceServiceRequest)
+} vault_trace_format_t;
+
+// 기록 (핫 패스 - seq, start_unix_ns는 여기서 채움)
+void vault_trace_record(vault_trace_record_t *record);
+
+// 조회 및 덤프
+size_t vault_trace_snapshot(vault_trace_record_t *records, size_t max_records);
+int vault_trace_dump(FILE *out, vault_trace_format_t format, const char *service_name);
+int vault_trace_parse_format(const char *name, vault_trace_format_t *format);
+
+// 시그널 핸들러에서 덤프 요청 (async-signal-safe), 다른 스레드에서 요청을 확인 후 덤프
+void vault_trace_request_dump(void);
+int vault_trace_take_dump_request(void);
+
+#endif
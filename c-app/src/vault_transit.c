@@ -0,0 +1,349 @@
+#define _POSIX_C_SOURCE 200809L
+#include "vault_transit.h"
+#include "vault_codec.h"
+#include "vault_secure.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+// 호출 하나의 완료 상태 (호출자 스택에 두고 항목이 모두 끝나면 깨움)
+typedef struct {
+    pthread_cond_t done;
+    size_t remaining;
+    size_t failed;
+} vault_transit_call_t;
+
+struct vault_transit_item {
+    const char *input;              // 평문(암호화) 또는 암호문(복호화), 호출자 소유
+    char **output;                  // 결과를 기록할 호출자 배열 위치
+    vault_transit_call_t *call;
+    uint64_t enqueued_ns;
+    vault_transit_item_t *next;
+};
+
+// (작업, 키)별 대기열 (한 요청에는 같은 키의 같은 작업만 담을 수 있음, 종료 시까지 유지)
+struct vault_transit_queue {
+    vault_transit_op_t op;
+    char key[128];
+    vault_transit_item_t *head;
+    vault_transit_item_t *tail;
+    size_t count;
+    vault_transit_queue_t *next;
+};
+
+static char *base64_encode(const unsigned char *data, size_t len) {
+    char *out = malloc(VAULT_BASE64_LEN(len) + 1);
+    if (!out) return NULL;
+    vault_base64_encode(data, len, out);
+    return out;
+}
+
+// base64 -> NUL 종료 문자열 (잘못된 문자가 있으면 NULL)
+static char *base64_decode(const char *text) {
+    size_t len = strlen(text);
+    size_t size = len / 4 * 3 + 3;
+    char *out = malloc(size + 1);
+    if (!out) return NULL;
+
+    size_t n = 0;
+    if (vault_base64_decode(text, out, size, &n) != 0) {
+        vault_secure_zero(out, size);  // 일부 해독된 평문
+        free(out);
+        return NULL;
+    }
+    out[n] = '\0';
+    return out;
+}
+
+void vault_transit_free(char *value) {
+    if (!value) return;
+    volatile char *p = value;
+    while (*p) *p++ = '\0';
+    free(value);
+}
+
+// batch 요청 하나 전송 후 항목별 결과 기록 (요청 자체가 실패하면 -1, 모든 항목은 NULL로 남음)
+static int vault_transit_send(vault_transit_t *transit, const vault_transit_queue_t *queue,
+                              vault_transit_item_t *items, size_t count) {
+    int encrypt = queue->op == VAULT_TRANSIT_ENCRYPT;
+    json_object *root = json_object_new_object();
+    json_object *batch = json_object_new_array();
+    json_object_object_add(root, "batch_input", batch);
+    for (vault_transit_item_t *item = items; item; item = item->next) {
+        json_object *entry = json_object_new_object();
+        if (encrypt) {
+            char *encoded = base64_encode((const unsigned char *)item->input, strlen(item->input));
+            json_object_object_add(entry, "plaintext", json_object_new_string(encoded ? encoded : ""));
+            vault_transit_free(encoded);
+        } else {
+            json_object_object_add(entry, "ciphertext", json_object_new_string(item->input));
+        }
+        json_object_array_add(batch, entry);
+    }
+
+    char path[512];
+    snprintf(path, sizeof(path), "%s/%s/%s", transit->mount, encrypt ? "encrypt" : "decrypt", queue->key);
+    json_object *response = NULL;
+    vault_write(transit->client, path, json_object_to_json_string_ext(root, JSON_C_TO_STRING_PLAIN),
+                VAULT_ENDPOINT_TRANSIT, &response);
+    json_object_put(root);
+
+    // 일부 항목만 실패해도 4xx와 함께 항목별 결과가 오므로 상태 코드 대신 batch_results로 판단
+    json_object *data, *results;
+    if (!response || !json_object_object_get_ex(response, "data", &data) ||
+        !json_object_object_get_ex(data, "batch_results", &results) ||
+        !json_object_is_type(results, json_type_array) || json_object_array_length(results) != count) {
+        VAULT_LOG_ERROR("Transit %s batch of %zu items failed (key: %s)", encrypt ? "encrypt" : "decrypt", count,
+                        queue->key);
+        json_object_put(response);
+        return -1;
+    }
+
+    size_t i = 0;
+    for (vault_transit_item_t *item = items; item; item = item->next, i++) {
+        json_object *result = json_object_array_get_idx(results, i);
+        json_object *error, *value;
+        if (json_object_object_get_ex(result, "error", &error) && json_object_get_string_len(error) > 0) {
+            VAULT_LOG_DEBUG("Transit item %zu failed: %s", i, json_object_get_string(error));
+            continue;
+        }
+        if (encrypt) {
+            if (json_object_object_get_ex(result, "ciphertext", &value)) {
+                *item->output = strdup(json_object_get_string(value));
+            }
+        } else if (json_object_object_get_ex(result, "plaintext", &value)) {
+            *item->output = base64_decode(json_object_get_string(value));
+        }
+    }
+    json_object_put(response);
+    return 0;
+}
+
+static void deadline_from_ns(struct timespec *ts, uint64_t ns) {
+    ts->tv_sec = (time_t)(ns / 1000000000ULL);
+    ts->tv_nsec = (long)(ns % 1000000000ULL);
+}
+
+// 송신 스레드: 보낼 수 있는 대기열을 찾아 최대 batch_size개를 꺼내 전송
+static void *vault_transit_sender(void *arg) {
+    vault_transit_t *transit = (vault_transit_t *)arg;
+    uint64_t window_ns = (uint64_t)transit->batch_window_ms * 1000000ULL;
+
+    pthread_mutex_lock(&transit->lock);
+    for (;;) {
+        // 꽉 찬 대기열 우선, 없으면 대기 시간이 지난 대기열 (종료 중이면 남은 항목 모두)
+        vault_transit_queue_t *ready = NULL;
+        int full = 0;
+        uint64_t now = vault_metrics_now_ns();
+        uint64_t next_deadline = 0;
+        for (vault_transit_queue_t *queue = transit->queues; queue; queue = queue->next) {
+            if (queue->count == 0) continue;
+            if (queue->count >= (size_t)transit->batch_size) {
+                ready = queue;
+                full = 1;
+                break;
+            }
+            uint64_t deadline = queue->head->enqueued_ns + window_ns;
+            if (deadline <= now || transit->stopping) {
+                if (!ready) ready = queue;
+            } else if (next_deadline == 0 || deadline < next_deadline) {
+                next_deadline = deadline;
+            }
+        }
+
+        if (!ready) {
+            if (transit->stopping) break;  // 종료 중이고 남은 항목 없음
+            if (next_deadline) {
+                struct timespec ts;
+                deadline_from_ns(&ts, next_deadline);
+                pthread_cond_timedwait(&transit->wake, &transit->lock, &ts);
+            } else {
+                pthread_cond_wait(&transit->wake, &transit->lock);
+            }
+            continue;
+        }
+
+        // 앞에서부터 batch_size개 분리
+        vault_transit_item_t *batch = ready->head;
+        vault_transit_item_t *last = batch;
+        size_t count = 1;
+        while (count < (size_t)transit->batch_size && last->next) {
+            last = last->next;
+            count++;
+        }
+        ready->head = last->next;
+        if (!ready->head) ready->tail = NULL;
+        last->next = NULL;
+        ready->count -= count;
+        transit->pending -= count;
+
+        transit->in_flight++;
+        transit->stats.requests++;
+        if (full) transit->stats.size_flushes++;
+        else transit->stats.window_flushes++;
+        if (count > transit->stats.max_batch) transit->stats.max_batch = count;
+        if (transit->in_flight > transit->stats.max_in_flight) transit->stats.max_in_flight = transit->in_flight;
+
+        // 남은 항목은 다른 송신 스레드가 이어서 보냄
+        if (transit->pending > 0) pthread_cond_signal(&transit->wake);
+        pthread_mutex_unlock(&transit->lock);
+
+        int rc = vault_transit_send(transit, ready, batch, count);
+
+        pthread_mutex_lock(&transit->lock);
+        transit->in_flight--;
+        if (rc != 0) transit->stats.failed_requests++;
+        transit->stats.items += count;
+        // 항목 메모리는 호출자 소유이므로 잠금 안에서 완료 처리 (호출자는 잠금을 다시 잡은 뒤에 해제)
+        for (vault_transit_item_t *item = batch; item; item = item->next) {
+            vault_transit_call_t *call = item->call;
+            if (!*item->output) {
+                call->failed++;
+                transit->stats.failed_items++;
+            }
+            if (--call->remaining == 0) pthread_cond_signal(&call->done);
+        }
+    }
+    pthread_mutex_unlock(&transit->lock);
+    return NULL;
+}
+
+static vault_transit_queue_t *vault_transit_queue_find(vault_transit_t *transit, vault_transit_op_t op,
+                                                       const char *key) {
+    vault_transit_queue_t **slot = &transit->queues;
+    for (; *slot; slot = &(*slot)->next) {
+        if ((*slot)->op == op && strcmp((*slot)->key, key) == 0) return *slot;
+    }
+    vault_transit_queue_t *queue = calloc(1, sizeof(vault_transit_queue_t));
+    if (!queue) return NULL;
+    queue->op = op;
+    snprintf(queue->key, sizeof(queue->key), "%s", key);
+    *slot = queue;
+    return queue;
+}
+
+// 항목을 대기열에 넣고 모두 완료될 때까지 대기
+static int vault_transit_submit(vault_transit_t *transit, vault_transit_op_t op, const char *key,
+                                const char *const inputs[], size_t count, char *outputs[]) {
+    if (!transit || !key || !key[0] || strlen(key) >= sizeof(((vault_transit_queue_t *)0)->key)) return -1;
+    if (count == 0) return 0;
+    if (!inputs || !outputs) return -1;
+
+    vault_transit_item_t *items = calloc(count, sizeof(vault_transit_item_t));
+    if (!items) return -1;
+    vault_transit_call_t call = {.remaining = 0, .failed = 0};
+    pthread_cond_init(&call.done, NULL);
+
+    pthread_mutex_lock(&transit->lock);
+    transit->stats.calls++;
+    vault_transit_queue_t *queue = transit->stopping ? NULL : vault_transit_queue_find(transit, op, key);
+    uint64_t now = vault_metrics_now_ns();
+    for (size_t i = 0; i < count; i++) {
+        outputs[i] = NULL;
+        if (!queue || !inputs[i]) {
+            call.failed++;
+            transit->stats.failed_items++;
+            continue;
+        }
+        vault_transit_item_t *item = &items[i];
+        item->input = inputs[i];
+        item->output = &outputs[i];
+        item->call = &call;
+        item->enqueued_ns = now;
+        if (queue->tail) queue->tail->next = item;
+        else queue->head = item;
+        queue->tail = item;
+        queue->count++;
+        call.remaining++;
+    }
+    transit->pending += call.remaining;
+    if (call.remaining > 0) pthread_cond_signal(&transit->wake);
+
+    while (call.remaining > 0) {
+        pthread_cond_wait(&call.done, &transit->lock);
+    }
+    pthread_mutex_unlock(&transit->lock);
+
+    pthread_cond_destroy(&call.done);
+    free(items);
+    return (int)call.failed;
+}
+
+int vault_transit_encrypt_batch(vault_transit_t *transit, const char *key, const char *const plaintexts[],
+                                size_t count, char *ciphertexts[]) {
+    return vault_transit_submit(transit, VAULT_TRANSIT_ENCRYPT, key, plaintexts, count, ciphertexts);
+}
+
+int vault_transit_decrypt_batch(vault_transit_t *transit, const char *key, const char *const ciphertexts[],
+                                size_t count, char *plaintexts[]) {
+    return vault_transit_submit(transit, VAULT_TRANSIT_DECRYPT, key, ciphertexts, count, plaintexts);
+}
+
+int vault_transit_init(vault_transit_t *transit, vault_client_t *client) {
+    if (!transit || !client || !client->config) return -1;
+
+    memset(transit, 0, sizeof(*transit));
+    const app_config_t *config = client->config;
+    transit->client = client;
+    snprintf(transit->mount, sizeof(transit->mount), "%s-transit", config->entity);
+    transit->batch_size = config->transit.batch_size;
+    if (transit->batch_size < 1) transit->batch_size = 1;
+    if (transit->batch_size > VAULT_TRANSIT_MAX_BATCH) transit->batch_size = VAULT_TRANSIT_MAX_BATCH;
+    transit->batch_window_ms = config->transit.batch_window_ms > 0 ? config->transit.batch_window_ms : 0;
+    int pipeline = config->transit.pipeline;
+    if (pipeline < 1) pipeline = 1;
+    if (pipeline > VAULT_TRANSIT_MAX_PIPELINE) pipeline = VAULT_TRANSIT_MAX_PIPELINE;
+
+    pthread_mutex_init(&transit->lock, NULL);
+    // 시계 변경에 영향받지 않도록 단조 시계로 대기
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&transit->wake, &attr);
+    pthread_condattr_destroy(&attr);
+
+    transit->senders = calloc((size_t)pipeline, sizeof(pthread_t));
+    if (!transit->senders) {
+        vault_transit_destroy(transit);
+        return -1;
+    }
+    for (int i = 0; i < pipeline; i++) {
+        if (pthread_create(&transit->senders[i], NULL, vault_transit_sender, transit) != 0) {
+            VAULT_LOG_ERROR("Failed to create Transit sender thread");
+            vault_transit_destroy(transit);
+            return -1;
+        }
+        transit->sender_count++;
+    }
+    return 0;
+}
+
+void vault_transit_destroy(vault_transit_t *transit) {
+    if (!transit) return;
+
+    pthread_mutex_lock(&transit->lock);
+    transit->stopping = 1;
+    pthread_cond_broadcast(&transit->wake);
+    pthread_mutex_unlock(&transit->lock);
+    for (int i = 0; i < transit->sender_count; i++) {
+        pthread_join(transit->senders[i], NULL);
+    }
+    free(transit->senders);
+    transit->senders = NULL;
+    transit->sender_count = 0;
+
+    while (transit->queues) {
+        vault_transit_queue_t *next = transit->queues->next;
+        free(transit->queues);
+        transit->queues = next;
+    }
+    pthread_cond_destroy(&transit->wake);
+    pthread_mutex_destroy(&transit->lock);
+}
+
+void vault_transit_get_stats(vault_transit_t *transit, vault_transit_stats_t *stats) {
+    pthread_mutex_lock(&transit->lock);
+    *stats = transit->stats;
+    pthread_mutex_unlock(&transit->lock);
+}
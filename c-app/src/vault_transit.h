@@ -0,0 +1,75 @@
+#ifndef VAULT_TRANSIT_H
+#define VAULT_TRANSIT_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <pthread.h>
+#include "vault_client.h"
+
+// Transit 암호화/복호화 batch 처리
+// 여러 스레드의 호출을 (작업, 키)별 대기열에 모아 batch_input 요청 하나로 보냅니다.
+// 대기열에 batch_size개가 차거나 첫 항목이 batch_window_ms 동안 기다리면 송신 스레드가 꺼내 보내며,
+// 송신 스레드 pipeline개가 각자 요청을 보내므로 응답을 기다리는 동안 다음 batch가 모이고 함께 전송됩니다.
+// 호출자는 자기 항목이 모두 완료될 때까지 기다립니다 (호출마다 완료 조건 변수 하나).
+
+#define VAULT_TRANSIT_MAX_BATCH 1024
+#define VAULT_TRANSIT_MAX_PIPELINE 64
+
+typedef enum {
+    VAULT_TRANSIT_ENCRYPT,
+    VAULT_TRANSIT_DECRYPT
+} vault_transit_op_t;
+
+typedef struct vault_transit_item vault_transit_item_t;
+typedef struct vault_transit_queue vault_transit_queue_t;
+
+typedef struct {
+    uint64_t calls;           // encrypt/decrypt_batch 호출 수
+    uint64_t items;           // 처리한 항목 수
+    uint64_t failed_items;    // 실패한 항목 수 (요청 실패 또는 항목별 오류)
+    uint64_t requests;        // 보낸 batch 요청 수
+    uint64_t failed_requests; // 전송 실패 또는 응답에 항목별 결과가 없는 요청
+    uint64_t size_flushes;    // batch_size가 차서 보낸 요청
+    uint64_t window_flushes;  // 대기 시간이 지나서(또는 종료 시) 보낸 요청
+    size_t max_batch;         // 요청 하나에 담은 최대 항목 수
+    int max_in_flight;        // 동시에 보낸 최대 요청 수
+} vault_transit_stats_t;
+
+typedef struct {
+    vault_client_t *client;
+    char mount[192];              // <entity>-transit
+    int batch_size;
+    int batch_window_ms;
+
+    pthread_mutex_t lock;         // 대기열/통계 보호
+    pthread_cond_t wake;          // 송신 스레드 깨우기 (단조 시계)
+    vault_transit_queue_t *queues;
+    size_t pending;               // 대기열에 있는 항목 수
+    int in_flight;                // 전송 중인 요청 수
+    int stopping;
+
+    pthread_t *senders;
+    int sender_count;
+    vault_transit_stats_t stats;
+} vault_transit_t;
+
+// client->config->transit의 batch_size/batch_window_ms/pipeline으로 초기화하고 송신 스레드 시작
+int vault_transit_init(vault_transit_t *transit, vault_client_t *client);
+// 대기 중인 항목을 모두 보낸 뒤 송신 스레드 종료
+void vault_transit_destroy(vault_transit_t *transit);
+
+// count개 평문 암호화 (ciphertexts[i]는 "vault:v1:..." 문자열, 실패한 항목은 NULL)
+// 반환값: 실패한 항목 수 (인자 오류는 -1)
+int vault_transit_encrypt_batch(vault_transit_t *transit, const char *key, const char *const plaintexts[],
+                                size_t count, char *ciphertexts[]);
+
+// count개 암호문 복호화 (plaintexts[i]는 평문 문자열, 실패한 항목은 NULL)
+int vault_transit_decrypt_batch(vault_transit_t *transit, const char *key, const char *const ciphertexts[],
+                                size_t count, char *plaintexts[]);
+
+// 결과 해제 (평문이 메모리에 남지 않도록 지운 뒤 해제)
+void vault_transit_free(char *value);
+
+void vault_transit_get_stats(vault_transit_t *transit, vault_transit_stats_t *stats);
+
+#endif
@@ -0,0 +1,178 @@
+#define _POSIX_C_SOURCE 200809L
+#include "vault_ws.h"
+#include "vault_codec.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+static const char *WS_GUID = "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+
+// SHA-1 (Sec-WebSocket-Accept 계산 전용)
+static uint32_t rol32(uint32_t x, int n) {
+    return (x << n) | (x >> (32 - n));
+}
+
+static void sha1_block(uint32_t h[5], const uint8_t block[64]) {
+    uint32_t w[80];
+    for (int i = 0; i < 16; i++) {
+        w[i] = ((uint32_t)block[i * 4] << 24) | ((uint32_t)block[i * 4 + 1] << 16) |
+               ((uint32_t)block[i * 4 + 2] << 8) | (uint32_t)block[i * 4 + 3];
+    }
+    for (int i = 16; i < 80; i++) {
+        w[i] = rol32(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+    }
+
+    uint32_t a = h[0], b = h[1], c = h[2], d = h[3], e = h[4];
+    for (int i = 0; i < 80; i++) {
+        uint32_t f, k;
+        if (i < 20) {
+            f = (b & c) | (~b & d);
+            k = 0x5A827999;
+        } else if (i < 40) {
+            f = b ^ c ^ d;
+            k = 0x6ED9EBA1;
+        } else if (i < 60) {
+            f = (b & c) | (b & d) | (c & d);
+            k = 0x8F1BBCDC;
+        } else {
+            f = b ^ c ^ d;
+            k = 0xCA62C1D6;
+        }
+        uint32_t t = rol32(a, 5) + f + e + k + w[i];
+        e = d;
+        d = c;
+        c = rol32(b, 30);
+        b = a;
+        a = t;
+    }
+    h[0] += a;
+    h[1] += b;
+    h[2] += c;
+    h[3] += d;
+    h[4] += e;
+}
+
+static void sha1(const uint8_t *data, size_t len, uint8_t digest[20]) {
+    uint32_t h[5] = {0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0};
+    uint8_t block[64];
+    size_t i = 0;
+
+    for (; i + 64 <= len; i += 64) {
+        sha1_block(h, data + i);
+    }
+
+    // 마지막 블록 패딩 (0x80 + 0 ... + 비트 길이)
+    size_t rest = len - i;
+    memset(block, 0, sizeof(block));
+    memcpy(block, data + i, rest);
+    block[rest] = 0x80;
+    if (rest >= 56) {
+        sha1_block(h, block);
+        memset(block, 0, sizeof(block));
+    }
+    uint64_t bits = (uint64_t)len * 8;
+    for (int j = 0; j < 8; j++) {
+        block[63 - j] = (uint8_t)(bits >> (j * 8));
+    }
+    sha1_block(h, block);
+
+    for (int j = 0; j < 5; j++) {
+        digest[j * 4] = (uint8_t)(h[j] >> 24);
+        digest[j * 4 + 1] = (uint8_t)(h[j] >> 16);
+        digest[j * 4 + 2] = (uint8_t)(h[j] >> 8);
+        digest[j * 4 + 3] = (uint8_t)h[j];
+    }
+}
+
+void vault_ws_make_key(char key[VAULT_WS_KEY_SIZE]) {
+    uint8_t nonce[16];
+    FILE *random = fopen("/dev/urandom", "rb");
+    size_t got = random ? fread(nonce, 1, sizeof(nonce), random) : 0;
+    if (random) fclose(random);
+
+    // /dev/urandom을 쓸 수 없으면 시각과 PID로 채움 (키는 비밀 값이 아님)
+    if (got != sizeof(nonce)) {
+        struct timespec ts;
+        clock_gettime(CLOCK_REALTIME, &ts);
+        uint64_t x = ((uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec) ^ ((uint64_t)getpid() << 32);
+        for (size_t i = 0; i < sizeof(nonce); i++) {
+            x = x * 6364136223846793005ULL + 1442695040888963407ULL;
+            nonce[i] = (uint8_t)(x >> 56);
+        }
+    }
+    vault_base64_encode(nonce, sizeof(nonce), key);
+}
+
+void vault_ws_accept_key(const char *key, char accept[VAULT_WS_ACCEPT_SIZE]) {
+    char joined[128];
+    uint8_t digest[20];
+    int n = snprintf(joined, sizeof(joined), "%s%s", key, WS_GUID);
+    if (n < 0 || (size_t)n >= sizeof(joined)) n = (int)strlen(joined);
+    sha1((const uint8_t *)joined, (size_t)n, digest);
+    vault_base64_encode(digest, sizeof(digest), accept);
+}
+
+size_t vault_ws_encode_header(uint8_t out[VAULT_WS_MAX_HEADER], int opcode, uint64_t length, const uint8_t *mask) {
+    size_t n = 0;
+    out[n++] = (uint8_t)(0x80 | (opcode & 0x0F));  // FIN (분할 전송하지 않음)
+
+    uint8_t mask_bit = mask ? 0x80 : 0x00;
+    if (length < 126) {
+        out[n++] = (uint8_t)(mask_bit | length);
+    } else if (length <= 0xFFFF) {
+        out[n++] = (uint8_t)(mask_bit | 126);
+        out[n++] = (uint8_t)(length >> 8);
+        out[n++] = (uint8_t)length;
+    } else {
+        out[n++] = (uint8_t)(mask_bit | 127);
+        for (int i = 7; i >= 0; i--) {
+            out[n++] = (uint8_t)(length >> (i * 8));
+        }
+    }
+    if (mask) {
+        memcpy(out + n, mask, 4);
+        n += 4;
+    }
+    return n;
+}
+
+int vault_ws_decode_header(const uint8_t *data, size_t size, vault_ws_frame_t *frame) {
+    if (size < 2) return 0;
+
+    frame->fin = (data[0] & 0x80) != 0;
+    frame->opcode = data[0] & 0x0F;
+    frame->masked = (data[1] & 0x80) != 0;
+    if (data[0] & 0x70) return -1;  // 확장(RSV) 비트는 협상하지 않음
+
+    size_t n = 2;
+    uint64_t length = data[1] & 0x7F;
+    if (length == 126) {
+        if (size < n + 2) return 0;
+        length = ((uint64_t)data[2] << 8) | data[3];
+        n += 2;
+    } else if (length == 127) {
+        if (size < n + 8) return 0;
+        length = 0;
+        for (int i = 0; i < 8; i++) {
+            length = (length << 8) | data[n + i];
+        }
+        n += 8;
+    }
+    // 제어 프레임은 분할할 수 없고 125바이트 이하
+    if ((frame->opcode & 0x08) && (!frame->fin || length > 125)) return -1;
+
+    if (frame->masked) {
+        if (size < n + 4) return 0;
+        memcpy(frame->mask, data + n, 4);
+        n += 4;
+    }
+    frame->length = length;
+    return (int)n;
+}
+
+void vault_ws_apply_mask(uint8_t *data, size_t length, const uint8_t mask[4], size_t offset) {
+    for (size_t i = 0; i < length; i++) {
+        data[i] ^= mask[(offset + i) & 3];
+    }
+}
@@ -0,0 +1,45 @@
+#ifndef VAULT_WS_H
+#define VAULT_WS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// WebSocket(RFC 6455) 프레임 처리
+// 전송 계층(TCP/TLS)은 호출 측이 담당하고, 여기서는 핸드셰이크 키 계산과
+// 프레임 헤더 인코딩/디코딩, 마스킹만 처리합니다.
+// (이벤트 구독 클라이언트와 벤치마크용 대역 서버가 함께 사용)
+
+#define VAULT_WS_OP_CONTINUATION 0x0
+#define VAULT_WS_OP_TEXT 0x1
+#define VAULT_WS_OP_BINARY 0x2
+#define VAULT_WS_OP_CLOSE 0x8
+#define VAULT_WS_OP_PING 0x9
+#define VAULT_WS_OP_PONG 0xA
+
+#define VAULT_WS_MAX_HEADER 14
+#define VAULT_WS_KEY_SIZE 25     // base64(16바이트) + NUL
+#define VAULT_WS_ACCEPT_SIZE 29  // base64(SHA-1 20바이트) + NUL
+
+// 프레임 헤더
+typedef struct {
+    int fin;
+    int opcode;
+    int masked;
+    uint8_t mask[4];
+    uint64_t length;  // payload 길이
+} vault_ws_frame_t;
+
+// 핸드셰이크 (Sec-WebSocket-Key 생성, Sec-WebSocket-Accept 계산)
+void vault_ws_make_key(char key[VAULT_WS_KEY_SIZE]);
+void vault_ws_accept_key(const char *key, char accept[VAULT_WS_ACCEPT_SIZE]);
+
+// 프레임 헤더 인코딩 (mask가 NULL이면 마스킹하지 않음 - 서버 측), 헤더 길이 반환
+size_t vault_ws_encode_header(uint8_t out[VAULT_WS_MAX_HEADER], int opcode, uint64_t length, const uint8_t *mask);
+
+// 프레임 헤더 디코딩: 헤더 길이 반환, 데이터가 부족하면 0, 잘못된 프레임이면 -1
+int vault_ws_decode_header(const uint8_t *data, size_t size, vault_ws_frame_t *frame);
+
+// 마스킹/언마스킹 (offset: payload 내 시작 위치)
+void vault_ws_apply_mask(uint8_t *data, size_t length, const uint8_t mask[4], size_t offset);
+
+#endif
@@ -140,13 +140,22 @@ setup_approle() {
     APPROLE_ACCESSOR=$(vault read -field=accessor sys/auth/approle)
     echo "APPROLE_ACCESSOR=$APPROLE_ACCESSOR" >> .vault-setup.env
     
-    # AppRole 생성
-    vault write auth/approle/role/my-vault-app \
-        secret_id_ttl=1h \
-        token_ttl=0 \
-        token_max_ttl=0 \
-        period=1m \
-        orphan=true
+    # AppRole 생성 (TOKEN_TYPE=batch 이면 저장되지 않는 batch 토큰 발급)
+    if [ "${TOKEN_TYPE:-service}" = "batch" ]; then
+        vault write auth/approle/role/my-vault-app \
+            secret_id_ttl=1h \
+            token_type=batch \
+            token_ttl=1h \
+            token_max_ttl=1h
+        log_warning "batch 토큰 사용: c-app/config.ini 의 token_type = batch 로 설정하세요"
+    else
+        vault write auth/approle/role/my-vault-app \
+            secret_id_ttl=1h \
+            token_ttl=0 \
+            token_max_ttl=0 \
+            period=1m \
+            orphan=true
+    fi
     
     log_success "AppRole 설정 완료"
 